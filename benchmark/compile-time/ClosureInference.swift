@@ -0,0 +1,99 @@
+//===--- ClosureInference.swift -------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time corpus shard: closure-heavy collection pipelines.  Exercises
+// closure parameter and result type inference, shorthand arguments, and
+// overload resolution for the standard collection combinators.
+
+public func squaresOfEvens(_ values: [Int]) -> [Int] {
+  return values.filter { $0 % 2 == 0 }.map { $0 * $0 }
+}
+
+public func sumOfSquares(_ values: [Int]) -> Int {
+  return values.map { $0 * $0 }.reduce(0) { $0 + $1 }
+}
+
+public func normalized(_ values: [Double]) -> [Double] {
+  let total = values.reduce(0.0, +)
+  guard total != 0 else { return values }
+  return values.map { $0 / total }
+}
+
+public func wordLengths(_ words: [String]) -> [Int] {
+  return words.map { $0.count }.sorted { $0 < $1 }
+}
+
+public func longestWord(_ words: [String]) -> String? {
+  return words.max { $0.count < $1.count }
+}
+
+public func groupedByParity(_ values: [Int]) -> ([Int], [Int]) {
+  let evens = values.filter { $0 % 2 == 0 }
+  let odds = values.filter { $0 % 2 != 0 }
+  return (evens, odds)
+}
+
+public func pairwiseSums(_ lhs: [Int], _ rhs: [Int]) -> [Int] {
+  return zip(lhs, rhs).map { $0 + $1 }
+}
+
+public func flattenedRanges(_ bounds: [(Int, Int)]) -> [Int] {
+  return bounds.flatMap { pair in Array(pair.0..<pair.1) }
+}
+
+public func runningTotal(_ values: [Int]) -> [Int] {
+  var total = 0
+  return values.map { value -> Int in
+    total += value
+    return total
+  }
+}
+
+public func histogram(_ words: [String]) -> [Character: Int] {
+  var counts: [Character: Int] = [:]
+  words.flatMap { $0 }.forEach { counts[$0, default: 0] += 1 }
+  return counts
+}
+
+public func applyTwice(_ transform: (Int) -> Int, to value: Int) -> Int {
+  return transform(transform(value))
+}
+
+public func composed(_ first: @escaping (Int) -> Int,
+                     _ second: @escaping (Int) -> Int) -> (Int) -> Int {
+  return { second(first($0)) }
+}
+
+public func makeCounter(start: Int) -> () -> Int {
+  var current = start
+  return {
+    current += 1
+    return current
+  }
+}
+
+public func sortedByMultipleKeys(_ values: [(name: String, age: Int)])
+    -> [(name: String, age: Int)] {
+  return values.sorted {
+    if $0.age != $1.age {
+      return $0.age < $1.age
+    }
+    return $0.name < $1.name
+  }
+}
+
+public func nestedPipelines(_ matrix: [[Int]]) -> Int {
+  return matrix
+    .map { row in row.filter { $0 > 0 }.reduce(0, +) }
+    .filter { $0 % 3 != 0 }
+    .reduce(0) { $0 + $1 }
+}
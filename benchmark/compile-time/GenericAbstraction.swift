@@ -0,0 +1,138 @@
+//===--- GenericAbstraction.swift -----------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time corpus shard: protocol constraints, conditional extensions,
+// and generic nesting.  Exercises generic signature building, requirement
+// checking, and witness matching.
+
+public protocol Measurable {
+  associatedtype Unit: Comparable
+  var magnitude: Unit { get }
+}
+
+public protocol Combinable {
+  static func combine(_ lhs: Self, _ rhs: Self) -> Self
+}
+
+public struct Meters: Measurable, Combinable {
+  public var magnitude: Double
+
+  public init(_ magnitude: Double) {
+    self.magnitude = magnitude
+  }
+
+  public static func combine(_ lhs: Meters, _ rhs: Meters) -> Meters {
+    return Meters(lhs.magnitude + rhs.magnitude)
+  }
+}
+
+public struct Count: Measurable, Combinable {
+  public var magnitude: Int
+
+  public init(_ magnitude: Int) {
+    self.magnitude = magnitude
+  }
+
+  public static func combine(_ lhs: Count, _ rhs: Count) -> Count {
+    return Count(lhs.magnitude + rhs.magnitude)
+  }
+}
+
+public struct Pair<First, Second> {
+  public var first: First
+  public var second: Second
+
+  public init(_ first: First, _ second: Second) {
+    self.first = first
+    self.second = second
+  }
+
+  public func swapped() -> Pair<Second, First> {
+    return Pair<Second, First>(second, first)
+  }
+
+  public func mapFirst<T>(_ transform: (First) -> T) -> Pair<T, Second> {
+    return Pair<T, Second>(transform(first), second)
+  }
+}
+
+extension Pair where First: Combinable, Second: Combinable {
+  public static func combine(_ lhs: Pair, _ rhs: Pair) -> Pair {
+    return Pair(First.combine(lhs.first, rhs.first),
+                Second.combine(lhs.second, rhs.second))
+  }
+}
+
+public struct Stack<Element> {
+  private var storage: [Element] = []
+
+  public init() {}
+
+  public mutating func push(_ element: Element) {
+    storage.append(element)
+  }
+
+  public mutating func pop() -> Element? {
+    return storage.popLast()
+  }
+
+  public var top: Element? { return storage.last }
+  public var count: Int { return storage.count }
+}
+
+extension Stack where Element: Comparable {
+  public var maximum: Element? {
+    return storage.max()
+  }
+}
+
+public func largest<T: Measurable>(_ values: [T]) -> T? {
+  var best: T? = nil
+  for value in values {
+    if let current = best {
+      if value.magnitude > current.magnitude {
+        best = value
+      }
+    } else {
+      best = value
+    }
+  }
+  return best
+}
+
+public func combineAll<T: Combinable>(_ values: [T], into initial: T) -> T {
+  var result = initial
+  for value in values {
+    result = T.combine(result, value)
+  }
+  return result
+}
+
+public func zipPairs<A, B>(_ lhs: [A], _ rhs: [B]) -> [Pair<A, B>] {
+  var result: [Pair<A, B>] = []
+  var index = 0
+  while index < lhs.count && index < rhs.count {
+    result.append(Pair(lhs[index], rhs[index]))
+    index += 1
+  }
+  return result
+}
+
+public func totalDistance(_ legs: [Meters]) -> Meters {
+  return combineAll(legs, into: Meters(0))
+}
+
+public func deepNesting(_ value: Int) -> Pair<Pair<Int, Int>, Pair<Int, Int>> {
+  let inner = Pair(value, value * 2)
+  let outer = Pair(inner, inner.swapped())
+  return outer
+}
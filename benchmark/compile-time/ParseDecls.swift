@@ -0,0 +1,163 @@
+//===--- ParseDecls.swift -------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time corpus shard: a large number of small, simple declarations.
+// Exercises the parser, name binding, and per-decl validation with almost no
+// expression type checking.
+
+public enum Direction {
+  case north, south, east, west
+
+  public var opposite: Direction {
+    switch self {
+    case .north: return .south
+    case .south: return .north
+    case .east: return .west
+    case .west: return .east
+    }
+  }
+}
+
+public struct Point {
+  public var x: Double
+  public var y: Double
+
+  public init(x: Double, y: Double) {
+    self.x = x
+    self.y = y
+  }
+}
+
+public struct Size {
+  public var width: Double
+  public var height: Double
+
+  public init(width: Double, height: Double) {
+    self.width = width
+    self.height = height
+  }
+}
+
+public struct Rect {
+  public var origin: Point
+  public var size: Size
+
+  public init(origin: Point, size: Size) {
+    self.origin = origin
+    self.size = size
+  }
+
+  public var minX: Double { return origin.x }
+  public var minY: Double { return origin.y }
+  public var maxX: Double { return origin.x + size.width }
+  public var maxY: Double { return origin.y + size.height }
+  public var area: Double { return size.width * size.height }
+}
+
+public class Node {
+  public var value: Int
+  public var next: Node?
+
+  public init(value: Int) {
+    self.value = value
+    self.next = nil
+  }
+}
+
+public protocol Shape {
+  var boundingBox: Rect { get }
+  func contains(_ point: Point) -> Bool
+}
+
+public func degreesToRadians(_ degrees: Double) -> Double {
+  return degrees * .pi / 180
+}
+
+public func radiansToDegrees(_ radians: Double) -> Double {
+  return radians * 180 / .pi
+}
+
+public func clamp(_ value: Int, min lower: Int, max upper: Int) -> Int {
+  if value < lower { return lower }
+  if value > upper { return upper }
+  return value
+}
+
+public func lerp(_ a: Double, _ b: Double, _ t: Double) -> Double {
+  return a + (b - a) * t
+}
+
+public func midpoint(_ a: Point, _ b: Point) -> Point {
+  return Point(x: (a.x + b.x) / 2, y: (a.y + b.y) / 2)
+}
+
+public func manhattanDistance(_ a: Point, _ b: Point) -> Double {
+  let dx = a.x < b.x ? b.x - a.x : a.x - b.x
+  let dy = a.y < b.y ? b.y - a.y : a.y - b.y
+  return dx + dy
+}
+
+public func union(_ a: Rect, _ b: Rect) -> Rect {
+  let minX = a.minX < b.minX ? a.minX : b.minX
+  let minY = a.minY < b.minY ? a.minY : b.minY
+  let maxX = a.maxX > b.maxX ? a.maxX : b.maxX
+  let maxY = a.maxY > b.maxY ? a.maxY : b.maxY
+  return Rect(origin: Point(x: minX, y: minY),
+              size: Size(width: maxX - minX, height: maxY - minY))
+}
+
+public func listLength(_ head: Node?) -> Int {
+  var count = 0
+  var current = head
+  while let node = current {
+    count += 1
+    current = node.next
+  }
+  return count
+}
+
+public func reversedList(_ head: Node?) -> Node? {
+  var previous: Node? = nil
+  var current = head
+  while let node = current {
+    current = node.next
+    node.next = previous
+    previous = node
+  }
+  return previous
+}
+
+public func gcd(_ a: Int, _ b: Int) -> Int {
+  var (x, y) = (a, b)
+  while y != 0 {
+    (x, y) = (y, x % y)
+  }
+  return x
+}
+
+public func fibonacci(_ n: Int) -> Int {
+  var (a, b) = (0, 1)
+  for _ in 0..<n {
+    (a, b) = (b, a + b)
+  }
+  return a
+}
+
+public func isPrime(_ n: Int) -> Bool {
+  if n < 2 { return false }
+  var divisor = 2
+  while divisor * divisor <= n {
+    if n % divisor == 0 { return false }
+    divisor += 1
+  }
+  return true
+}
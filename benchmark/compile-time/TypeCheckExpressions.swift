@@ -0,0 +1,109 @@
+//===--- TypeCheckExpressions.swift ---------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time corpus shard: literal- and operator-heavy expressions.  The
+// mixed literals and arithmetic operators give the constraint solver real
+// work without tipping any single expression into exponential behavior.
+
+public func polynomialAt(_ x: Double) -> Double {
+  return 3.0 * x * x * x * x - 2.5 * x * x * x + 0.5 * x * x - 7.0 * x + 42.0
+}
+
+public func horner(_ x: Double) -> Double {
+  return (((3.0 * x - 2.5) * x + 0.5) * x - 7.0) * x + 42.0
+}
+
+public func mixedArithmetic(_ n: Int) -> Int {
+  let a = n * 2 + 1
+  let b = a * a - n * 3 + 7
+  let c = (b + a) * (b - a) + n % 5
+  let d = c / 3 + b / 2 - a / 7 + 11
+  return a + b + c + d
+}
+
+public func literalFolding() -> Int {
+  let a = 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10
+  let b = 1 * 2 * 3 * 4 * 5 + 6 * 7 * 8 * 9 * 10
+  let c = 100 - 99 + 98 - 97 + 96 - 95 + 94 - 93
+  let d = (a + b) * (c + 1) - (a - c) * (b % 7)
+  return a + b + c + d
+}
+
+public func comparisonChains(_ x: Int, _ y: Int) -> Bool {
+  let inRange = x > 0 && x < 100 && y > 0 && y < 100
+  let ordered = x < y || x == y || x - y < 10
+  let parity = x % 2 == 0 ? y % 2 == 1 : y % 2 == 0
+  return inRange && ordered && parity
+}
+
+public func doubleAndIntMix(_ n: Int) -> Double {
+  let scaled = Double(n) * 1.5 + 0.25
+  let shifted = scaled - Double(n / 2) + 3.75
+  let ratio = shifted / (Double(n) + 1.0)
+  return ratio * ratio + scaled / 2.0 - 1.125
+}
+
+public func stringConcatenation(_ name: String, _ count: Int) -> String {
+  let greeting = "Hello, " + name + "!"
+  let report = greeting + " You have " + String(count) + " new messages."
+  let footer = report + " (" + String(count * 2) + " total)"
+  return footer
+}
+
+public func interpolation(_ name: String, _ count: Int) -> String {
+  let summary = "\(name): \(count) of \(count * 2) (\(count % 7))"
+  return "[\(summary)] length \(summary.count)"
+}
+
+public func tupleShuffles(_ a: Int, _ b: Int) -> (Int, Int, Int) {
+  let pair = (a + b, a - b)
+  let triple = (pair.0 * 2, pair.1 * 3, pair.0 + pair.1)
+  return (triple.2, triple.0 - triple.1, triple.0 + triple.2)
+}
+
+public func arrayLiterals() -> [Int] {
+  let small = [1, 2, 3, 5, 8, 13, 21, 34, 55, 89]
+  let scaled = [small[0] * 2, small[1] * 2, small[2] * 2, small[3] * 2]
+  let combined = small + scaled + [144, 233, 377]
+  return combined
+}
+
+public func dictionaryLiterals() -> [String: Int] {
+  let base = ["one": 1, "two": 2, "three": 3, "four": 4, "five": 5]
+  let squares = ["one": 1, "two": 4, "three": 9, "four": 16, "five": 25]
+  var merged = base
+  for (key, value) in squares {
+    merged[key] = (merged[key] ?? 0) + value
+  }
+  return merged
+}
+
+public func optionalChains(_ values: [Int]?) -> Int {
+  let first = values?.first ?? 0
+  let last = values?.last ?? 0
+  let count = values?.count ?? 0
+  return first + last + count * 2 - (values?.reversed().first ?? 0)
+}
+
+public func ternaryCascade(_ score: Int) -> String {
+  return score > 90 ? "A" :
+         score > 80 ? "B" :
+         score > 70 ? "C" :
+         score > 60 ? "D" : "F"
+}
+
+public func bitManipulation(_ x: UInt32) -> UInt32 {
+  let spread = (x | (x << 8)) & 0x00FF00FF
+  let mixed = (spread | (spread << 4)) & 0x0F0F0F0F
+  let swapped = ((mixed & 0xAAAAAAAA) >> 1) | ((mixed & 0x55555555) << 1)
+  return swapped ^ (x >> 16) ^ (x << 16)
+}
@@ -27,6 +27,10 @@ struct BenchResults {
   var sd: UInt64 = 0
   var median: UInt64 = 0
 
+  /// Growth of the process's peak resident set size across the measurement,
+  /// in bytes.  Only reported when the harness runs with --memory.
+  var maxRSS: UInt64 = 0
+
   init() {}
 
   init(delim: String, sampleCount: UInt64, min: UInt64, max: UInt64, mean: UInt64, sd: UInt64, median: UInt64) {
@@ -130,6 +134,10 @@ struct TestConfig {
   /// Is verbose output enabled?
   var verbose: Bool = false
 
+  /// Should we report the change in the process's peak resident set size
+  /// for each test, as an extra MAX_RSS(B) column?
+  var logMemory: Bool = false
+
   /// After we run the tests, should the harness sleep to allow for utilities
   /// like leaks that require a PID to run on the test harness.
   var afterRunSleep: Int?
@@ -141,7 +149,7 @@ struct TestConfig {
     let validOptions = [
       "--iter-scale", "--num-samples", "--num-iters",
       "--verbose", "--delim", "--list", "--sleep",
-      "--tags", "--skip-tags"
+      "--tags", "--skip-tags", "--memory"
     ]
     let maybeBenchArgs: Arguments? = parseArgs(validOptions)
     if maybeBenchArgs == nil {
@@ -171,6 +179,10 @@ struct TestConfig {
       print("Verbose")
     }
 
+    if let _ = benchArgs.optionalArgsMap["--memory"] {
+      logMemory = true
+    }
+
     if let x = benchArgs.optionalArgsMap["--delim"] {
       if x.isEmpty { return .fail("--delim requires a value") }
       delim = x
@@ -310,6 +322,18 @@ func internalMedian(_ inputs: [UInt64]) -> UInt64 {
   return inputs.sorted()[inputs.count / 2]
 }
 
+/// Return the process's peak resident set size, in bytes.
+func getPeakResidentSetSize() -> UInt64 {
+  var usage = rusage()
+  getrusage(RUSAGE_SELF, &usage)
+#if os(Linux)
+  // ru_maxrss is reported in kilobytes on Linux.
+  return UInt64(usage.ru_maxrss) * 1024
+#else
+  return UInt64(usage.ru_maxrss)
+#endif
+}
+
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
 
 @_silgen_name("_swift_leaks_startTrackingObjects")
@@ -324,7 +348,10 @@ class Timer {
   typealias TimeT = timespec
   func getTime() -> TimeT {
     var ticks = timespec(tv_sec: 0, tv_nsec: 0)
-    clock_gettime(CLOCK_REALTIME, &ticks)
+    // Use the raw monotonic clock: CLOCK_REALTIME is subject to NTP
+    // adjustment and can even step backwards, which shows up as noise (or
+    // nonsense) in the sample deltas measured here.
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ticks)
     return ticks
   }
   func diffTimeInNanoSeconds(from start_ticks: TimeT, to end_ticks: TimeT) -> UInt64 {
@@ -386,6 +413,7 @@ func runBench(_ test: Test, _ c: TestConfig) -> BenchResults {
   }
 
   let sampler = SampleRunner()
+  let startMaxRSS = c.logMemory ? getPeakResidentSetSize() : 0
   for s in 0..<c.numSamples {
     let time_per_sample: UInt64 = 1_000_000_000 * UInt64(c.iterationScale)
 
@@ -430,9 +458,16 @@ func runBench(_ test: Test, _ c: TestConfig) -> BenchResults {
   let (mean, sd) = internalMeanSD(samples)
 
   // Return our benchmark results.
-  return BenchResults(delim: c.delim, sampleCount: UInt64(samples.count),
-                      min: samples.min()!, max: samples.max()!,
-                      mean: mean, sd: sd, median: internalMedian(samples))
+  var results = BenchResults(delim: c.delim, sampleCount: UInt64(samples.count),
+                             min: samples.min()!, max: samples.max()!,
+                             mean: mean, sd: sd,
+                             median: internalMedian(samples))
+  if c.logMemory {
+    // The peak only grows, so the delta attributes to this test whatever
+    // high-water mark it set beyond the tests that ran before it.
+    results.maxRSS = getPeakResidentSetSize() - startMaxRSS
+  }
+  return results
 }
 
 func printRunInfo(_ c: TestConfig) {
@@ -457,13 +492,15 @@ func printRunInfo(_ c: TestConfig) {
 
 func runBenchmarks(_ c: TestConfig) {
   let units = "us"
-  print("#\(c.delim)TEST\(c.delim)SAMPLES\(c.delim)MIN(\(units))\(c.delim)MAX(\(units))\(c.delim)MEAN(\(units))\(c.delim)SD(\(units))\(c.delim)MEDIAN(\(units))")
+  let memoryHeader = c.logMemory ? "\(c.delim)MAX_RSS(B)" : ""
+  print("#\(c.delim)TEST\(c.delim)SAMPLES\(c.delim)MIN(\(units))\(c.delim)MAX(\(units))\(c.delim)MEAN(\(units))\(c.delim)SD(\(units))\(c.delim)MEDIAN(\(units))\(memoryHeader)")
   var sumBenchResults = BenchResults()
   sumBenchResults.sampleCount = 0
 
   for t in c.tests {
     let results = runBench(t, c)
-    print("\(t.index)\(c.delim)\(t.name)\(c.delim)\(results.description)")
+    let memoryColumn = c.logMemory ? "\(c.delim)\(results.maxRSS)" : ""
+    print("\(t.index)\(c.delim)\(t.name)\(c.delim)\(results.description)\(memoryColumn)")
     fflush(stdout)
 
     sumBenchResults.min += results.min
@@ -57,6 +57,17 @@ function(handle_gyb_source_single dependency_out_var_name)
   endforeach()
   list(REMOVE_DUPLICATES gyb_expand_deps)
 
+  # Memoize expansions so that regenerating an unchanged template (on a
+  # clean rebuild, or for another architecture with the same bindings) is
+  # just a cache read.  Every declared dependency feeds the cache key, so
+  # the cache is exactly as trustworthy as the DEPENDS list above.
+  if(SWIFT_GYB_CACHE_PATH)
+    list(APPEND gyb_flags "--cache-dir" "${SWIFT_GYB_CACHE_PATH}")
+    foreach(dep ${GYB_SINGLE_DEPENDS} ${gyb_expand_deps})
+      list(APPEND gyb_flags "--cache-dep" "${dep}")
+    endforeach()
+  endif()
+
   add_custom_command_target(
       dependency_target
       COMMAND
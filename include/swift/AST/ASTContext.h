@@ -107,6 +107,10 @@ namespace swift {
 
   enum class KnownProtocolKind : uint8_t;
 
+namespace namelookup {
+  class ModuleScopeLookupCache;
+}
+
 /// \brief The arena in which a particular ASTContext allocation will go.
 enum class AllocationArena {
   /// \brief The permanent arena, which is tied to the lifetime of
@@ -509,6 +513,18 @@ public:
   void lookupInSwiftModule(StringRef name,
                            SmallVectorImpl<ValueDecl *> &results) const;
 
+  /// Retrieve the cache of module-scope lookups into modules without
+  /// source files, whose contents cannot change during this compilation.
+  namelookup::ModuleScopeLookupCache &getModuleScopeLookupCache() const;
+
+  /// Retrieve the cached USR string for the given declaration, if one has
+  /// been generated before.
+  Optional<StringRef> getUSR(const ValueDecl *VD) const;
+
+  /// Cache the USR string for the given declaration. The string is copied
+  /// into the ASTContext.
+  void setUSR(const ValueDecl *VD, StringRef USR);
+
   /// Retrieve a specific, known protocol.
   ProtocolDecl *getProtocol(KnownProtocolKind kind) const;
   
@@ -757,6 +773,14 @@ public:
                             SubstitutionList substitutions,
                             bool alreadyCheckedCollapsed = false);
 
+  /// Retrieve a uniqued copy of the given substitution list.
+  ///
+  /// Identical lists share storage, so two uniqued lists are equal exactly
+  /// when their data pointers are equal, and long-lived copies of the same
+  /// substitutions do not multiply in the arena. The storage is allocated
+  /// in the arena appropriate for the replacement types.
+  SubstitutionList getUniquedSubstitutionList(SubstitutionList subs);
+
   /// \brief Produce a specialized conformance, which takes a generic
   /// conformance and substitutions written in terms of the generic
   /// conformance's signature.
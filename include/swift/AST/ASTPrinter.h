@@ -226,11 +226,17 @@ public:
 
   void forceNewlines() {
     if (PendingNewlines > 0) {
-      llvm::SmallString<16> Str;
-      for (unsigned i = 0; i != PendingNewlines; ++i)
-        Str += '\n';
+      // Almost always one or two newlines; print them from a constant
+      // buffer rather than building a string per line.
+      static const char Newlines[] = "\n\n\n\n\n\n\n\n";
+      const unsigned MaxChunk = sizeof(Newlines) - 1;
+      unsigned N = PendingNewlines;
       PendingNewlines = 0;
-      printText(Str);
+      while (N > 0) {
+        unsigned Chunk = N < MaxChunk ? N : MaxChunk;
+        printText(StringRef(Newlines, Chunk));
+        N -= Chunk;
+      }
       printIndent();
     }
   }
@@ -81,6 +81,7 @@ namespace swift {
   
 namespace syntax {
   class SourceFileSyntax;
+  class SyntaxParsingCache;
   class SyntaxParsingContext;
   class SyntaxParsingContextRoot;
 }
@@ -899,6 +900,17 @@ public:
 
   void clearLookupCache();
 
+  /// Index declarations parsed into the file since the lookup cache was
+  /// built or last updated, rather than rebuilding the cache wholesale.
+  /// Has no effect if a cache has not been built yet.
+  void addParsedDeclsToLookupCache();
+
+  /// Unindex all but the first \p count declarations of the file, which the
+  /// caller is about to remove.  The REPL retracts declarations that it
+  /// inserted temporarily for code completion or that failed to compile;
+  /// unindexing them keeps the rest of the lookup cache usable.
+  void truncateDeclsInLookupCache(unsigned count);
+
   void cacheVisibleDecls(SmallVectorImpl<ValueDecl *> &&globals) const;
   const SmallVectorImpl<ValueDecl *> &getCachedVisibleDecls() const;
 
@@ -1085,12 +1097,24 @@ public:
   void setSyntaxRoot(syntax::SourceFileSyntax &&Root);
   bool hasSyntaxRoot() const;
 
+  /// The syntax tree of a previous parse of this file together with the
+  /// edits made since, from which unmodified subtrees may be reused when
+  /// rebuilding the syntax tree. Not owned; may be null.
+  syntax::SyntaxParsingCache *getSyntaxParsingCache() const {
+    return SyntaxCache;
+  }
+  void setSyntaxParsingCache(syntax::SyntaxParsingCache *Cache) {
+    SyntaxCache = Cache;
+  }
+
 private:
 
   /// If not None, the underlying vector should contain tokens of this source file.
   Optional<std::vector<Token>> AllCorrectedTokens;
 
   SourceFileSyntaxInfo &SyntaxInfo;
+
+  syntax::SyntaxParsingCache *SyntaxCache = nullptr;
 };
 
 
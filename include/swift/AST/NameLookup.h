@@ -17,8 +17,10 @@
 #ifndef SWIFT_AST_NAME_LOOKUP_H
 #define SWIFT_AST_NAME_LOOKUP_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/TinyPtrVector.h"
 #include "swift/AST/Identifier.h"
 #include "swift/AST/Module.h"
 #include "swift/Basic/SourceLoc.h"
@@ -308,6 +310,38 @@ enum class ResolutionKind {
   TypesOnly
 };
 
+/// A persistent cache of module-scope lookups into modules that contain no
+/// source files.
+///
+/// The contents of such modules cannot change during a compilation, so the
+/// result of walking their reexports for a given name can be reused across
+/// lookups instead of being recomputed each time.  One of these is owned by
+/// the ASTContext; lookupInModule consults and populates it.
+class ModuleScopeLookupCache {
+  /// Keyed by the module being searched, the module from which the lookup
+  /// is made (which affects access-control filtering), the name, and the
+  /// remaining aspects of the lookup packed into an unsigned.
+  using KeyTy = std::pair<std::pair<const ModuleDecl *, const ModuleDecl *>,
+                          std::pair<DeclName, unsigned>>;
+
+  llvm::DenseMap<KeyTy, TinyPtrVector<ValueDecl *>> Results;
+
+public:
+  const TinyPtrVector<ValueDecl *> *find(const ModuleDecl *module,
+                                         const ModuleDecl *scopeModule,
+                                         DeclName name, unsigned flags) const {
+    auto I = Results.find({{module, scopeModule}, {name, flags}});
+    return I == Results.end() ? nullptr : &I->second;
+  }
+
+  void insert(const ModuleDecl *module, const ModuleDecl *scopeModule,
+              DeclName name, unsigned flags, ArrayRef<ValueDecl *> decls) {
+    auto &entry = Results[{{module, scopeModule}, {name, flags}}];
+    entry.clear();
+    entry.insert(entry.end(), decls.begin(), decls.end());
+  }
+};
+
 /// Performs a lookup into the given module and, if necessary, its
 /// reexports, observing proper shadowing rules.
 ///
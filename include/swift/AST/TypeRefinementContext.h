@@ -244,11 +244,9 @@ public:
     return AvailabilityInfo;
   }
 
-  /// Adds a child refinement context.
-  void addChild(TypeRefinementContext *Child) {
-    assert(Child->getSourceRange().isValid());
-    Children.push_back(Child);
-  }
+  /// Adds a child refinement context, keeping the children ordered by the
+  /// start of their source ranges so that lookups can binary-search them.
+  void addChild(TypeRefinementContext *Child, SourceManager &SM);
 
   /// Returns the inner-most TypeRefinementContext descendant of this context
   /// for the given source location.
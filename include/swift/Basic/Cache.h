@@ -77,6 +77,17 @@ protected:
 
   static ImplTy create(llvm::StringRef Name, const CallBacks &CBs);
 
+  /// Sets a soft bound on the total cost of the cached values.
+  ///
+  /// \param Limit Total cost budget; zero means unbounded.
+  ///
+  /// When the total cost exceeds the limit, least recently used entries
+  /// are evicted until the cache is back under budget.  Implementations
+  /// that can react to real memory pressure (the Darwin libcache backend)
+  /// may ignore the limit and evict based on pressure notifications
+  /// instead.
+  void setCostLimit(size_t Limit);
+
   /// Sets value for key.
   ///
   /// \param Key Key to add.  Must not be nullptr.
@@ -192,6 +203,13 @@ public:
     removeAll();
   }
 
+  /// Set a soft bound on the total cost of cached values, evicting least
+  /// recently used entries when it is exceeded.  Zero (the default) means
+  /// unbounded.  \see CacheImpl::setCostLimit.
+  void setCostLimit(size_t Limit) {
+    CacheImpl::setCostLimit(Limit);
+  }
+
 private:
   static uintptr_t keyHash(void *Key, void *UserData) {
     return KeyInfoT::getHashValue(*static_cast<KeyT*>(Key));
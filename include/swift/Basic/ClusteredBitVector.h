@@ -380,6 +380,30 @@ public:
     appendReserved(numBits, chunks);
   }
 
+  /// Append bits from an array of chunks, lowest chunk first.  The
+  /// array must contain exactly enough chunks for numBits, and the bits
+  /// of the final chunk at and above numBits % 64 must be clear.
+  ///
+  /// This appends a whole chunk at a time, which is much cheaper than
+  /// growing the vector bit by bit.
+  void append(size_t numBits, ArrayRef<uint64_t> chunks) {
+    if (numBits == 0) return;
+    assert(chunks.size() == getNumChunksForBits(numBits));
+
+    // Special case: don't allocate space just to record zero bits.
+    if (isInlineAndAllClear() &&
+        std::all_of(chunks.begin(), chunks.end(),
+                    [](ChunkType chunk) { return chunk == 0; })) {
+      LengthInBits += numBits;
+      return;
+    }
+
+    static_assert(sizeof(uint64_t) == sizeof(ChunkType),
+                  "chunk arrays assume 64-bit chunks");
+    reserveExtra(numBits);
+    appendReserved(numBits, chunks.data());
+  }
+
   /// Append a number of clear bits to this vector.
   void appendClearBits(size_t numBits) {
     if (numBits == 0) return;
@@ -467,6 +491,25 @@ public:
     return *this;
   }
 
+  /// Clear every bit in this vector which is set in the other vector.
+  /// The vectors must be the same size.
+  ClusteredBitVector &andNot(const ClusteredBitVector &other) {
+    assert(size() == other.size());
+
+    // If either vector is all-clear, this is a no-op.
+    if (isInlineAndAllClear() || other.isInlineAndAllClear())
+      return *this;
+
+    // Otherwise, &= ~ the chunks pairwise.  The high bits of the last
+    // chunk stay clear because they're already clear in this vector.
+    auto chunks = getChunks();
+    auto oi = other.getChunksPtr();
+    for (auto i = chunks.begin(), e = chunks.end(); i != e; ++i, ++oi) {
+      *i &= ~*oi;
+    }
+    return *this;
+  }
+
   /// Set bit i.
   void setBit(size_t i) {
     assert(i < size());
@@ -523,6 +566,31 @@ public:
     return count;
   }
 
+  /// Count the number of set bits in the half-open range [begin, end).
+  size_t count(size_t begin, size_t end) const {
+    assert(begin <= end && end <= size());
+    if (begin == end || isInlineAndAllClear()) return 0;
+
+    auto chunks = getChunksPtr();
+    size_t firstChunk = begin / ChunkSizeInBits;
+    size_t lastChunk = (end - 1) / ChunkSizeInBits;
+
+    ChunkType headMask = ~ChunkType(0) << (begin % ChunkSizeInBits);
+    ChunkType tailMask =
+      (end % ChunkSizeInBits)
+        ? ((ChunkType(1) << (end % ChunkSizeInBits)) - 1)
+        : ~ChunkType(0);
+
+    if (firstChunk == lastChunk)
+      return llvm::countPopulation(chunks[firstChunk] & headMask & tailMask);
+
+    size_t result = llvm::countPopulation(chunks[firstChunk] & headMask);
+    for (size_t i = firstChunk + 1; i != lastChunk; ++i)
+      result += llvm::countPopulation(chunks[i]);
+    result += llvm::countPopulation(chunks[lastChunk] & tailMask);
+    return result;
+  }
+
   /// Determine if there are any bits set in this vector.
   bool any() const {
     if (isInlineAndAllClear()) return false;
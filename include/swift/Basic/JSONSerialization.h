@@ -21,6 +21,7 @@
 #define SWIFT_BASIC_JSONSERIALIZATION_H
 
 #include "swift/Basic/LLVM.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -306,16 +307,28 @@ class Output {
     ObjectOtherKey
   };
 
-  llvm::raw_ostream &Stream;
+  llvm::raw_ostream *Stream;
+  SmallVectorImpl<char> *OutBuffer;
   SmallVector<State, 8> StateStack;
   bool PrettyPrint;
   bool NeedBitValueComma;
   bool EnumerationMatchFound;
 
 public:
-  Output(llvm::raw_ostream &os, bool PrettyPrint = true) : Stream(os),
-      PrettyPrint(PrettyPrint), NeedBitValueComma(false),
+  Output(llvm::raw_ostream &os, bool PrettyPrint = true) : Stream(&os),
+      OutBuffer(nullptr), PrettyPrint(PrettyPrint), NeedBitValueComma(false),
       EnumerationMatchFound(false) {}
+
+  /// Emit directly into the caller-provided growable buffer.
+  ///
+  /// This appends to \p buffer without any per-write virtual dispatch,
+  /// which matters for large documents (stats output, parseable driver
+  /// output, api-digester dumps) where unbuffered streams dominate the
+  /// serialization time.  The buffer is not cleared first.
+  Output(SmallVectorImpl<char> &buffer, bool PrettyPrint = true)
+      : Stream(nullptr), OutBuffer(&buffer), PrettyPrint(PrettyPrint),
+        NeedBitValueComma(false), EnumerationMatchFound(false) {}
+
   virtual ~Output() = default;
 
   unsigned beginArray();
@@ -339,6 +352,14 @@ public:
 
   void scalarString(StringRef &, bool);
 
+  /// Fast paths for arithmetic scalars: these format into a stack buffer
+  /// and emit in one write, bypassing the temporary string and stream the
+  /// generic scalar path builds per node.
+  void scalarBool(bool Val);
+  void scalarInteger(int64_t Val);
+  void scalarInteger(uint64_t Val);
+  void scalarDouble(double Val);
+
   template <typename T>
   void enumCase(T &Val, const char* Str, const T ConstVal) {
     if (matchEnumScalar(Str, Val == ConstVal)) {
@@ -445,6 +466,19 @@ private:
 
 private:
   void indent();
+
+  void write(char C) {
+    if (OutBuffer)
+      OutBuffer->push_back(C);
+    else
+      *Stream << C;
+  }
+  void write(StringRef Str) {
+    if (OutBuffer)
+      OutBuffer->append(Str.begin(), Str.end());
+    else
+      *Stream << Str;
+  }
 };
 
 template <typename T> struct ArrayTraits<std::vector<T>> {
@@ -567,17 +601,61 @@ jsonize(Output &out, T &Val, bool) {
 
 
 template<typename T>
-typename std::enable_if<has_ScalarTraits<T>::value,void>::type
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                        !std::is_arithmetic<T>::value, void>::type
 jsonize(Output &out, T &Val, bool) {
   {
-    std::string Storage;
-    llvm::raw_string_ostream Buffer(Storage);
+    SmallString<64> Storage;
+    llvm::raw_svector_ostream Buffer(Storage);
     ScalarTraits<T>::output(Val, Buffer);
     StringRef Str = Buffer.str();
     out.scalarString(Str, ScalarTraits<T>::mustQuote(Str));
   }
 }
 
+// Arithmetic scalars skip the temporary stream entirely; their traits
+// never require quoting.
+template<typename T>
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                        std::is_same<T, bool>::value, void>::type
+jsonize(Output &out, T &Val, bool) {
+  out.scalarBool(Val);
+}
+
+template<typename T>
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                        std::is_integral<T>::value &&
+                        std::is_signed<T>::value, void>::type
+jsonize(Output &out, T &Val, bool) {
+  out.scalarInteger(static_cast<int64_t>(Val));
+}
+
+template<typename T>
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                        std::is_integral<T>::value &&
+                        std::is_unsigned<T>::value &&
+                        !std::is_same<T, bool>::value, void>::type
+jsonize(Output &out, T &Val, bool) {
+  out.scalarInteger(static_cast<uint64_t>(Val));
+}
+
+template<typename T>
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                        std::is_floating_point<T>::value, void>::type
+jsonize(Output &out, T &Val, bool) {
+  out.scalarDouble(Val);
+}
+
+// Strings need no intermediate formatting at all.
+inline void jsonize(Output &out, StringRef &Val, bool) {
+  out.scalarString(Val, ScalarTraits<StringRef>::mustQuote(Val));
+}
+
+inline void jsonize(Output &out, std::string &Val, bool) {
+  StringRef Str = Val;
+  out.scalarString(Str, ScalarTraits<std::string>::mustQuote(Str));
+}
+
 
 template<typename T>
 typename std::enable_if<validatedObjectTraits<T>::value, void>::type
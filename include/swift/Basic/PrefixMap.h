@@ -109,12 +109,16 @@ private:
     Node *Further = nullptr;
 
     KeyElementType Key[InlineKeyCapacity];
-    unsigned char KeyLength : 7;
+    unsigned char KeyLength : 6;
     unsigned char HasValue : 1;
-    static_assert(InlineKeyCapacity < (1 << 7),
+
+    // Whether this node lives in the map's bulk-loaded node array and
+    // therefore must not be deleted individually.
+    unsigned char InBulkArray : 1;
+    static_assert(InlineKeyCapacity < (1 << 6),
                   "can't store inline key length in bit-field");
 
-    NodeBase() : KeyLength(0), HasValue(false) {}
+    NodeBase() : KeyLength(0), HasValue(false), InBulkArray(false) {}
 
     KeyType getLocalKey() const { return { Key, KeyLength }; }
   };
@@ -126,6 +130,9 @@ private:
     // We split NodeBase out so that we can just delegate to something that
     // copies all the other fields.
     Node(const Node &other) : NodeBase(other) {
+      // Copies are always individually allocated, even if the original
+      // came from a bulk-loaded array.
+      this->InBulkArray = false;
       if (this->HasValue) {
         Value.initializeFrom(other.Value.Storage);
       }
@@ -301,7 +308,9 @@ private:
     return best;
   }
 
-  /// Delete all the nodes in a subtree.
+  /// Delete all the nodes in a subtree.  Nodes in the bulk-loaded array
+  /// are still traversed (later insertions may have hung individually
+  /// allocated nodes off of them) but are owned by the array.
   static void deleteTree(Node *root) {
     if (!root) return;
 
@@ -310,7 +319,8 @@ private:
       if (node->Left) stack.push_back(node->Left);
       if (node->Right) stack.push_back(node->Right);
       if (node->Further) stack.push_back(node->Further);
-      delete node;
+      if (!node->InBulkArray)
+        delete node;
     };
     pushChildrenAndDelete(root);
     while (!stack.empty()) {
@@ -338,29 +348,147 @@ private:
     return root;
   }
 
+  /// Build a weight-balanced subtree for a range of entries, which must
+  /// be sorted lexicographically by key and contain no duplicate keys.
+  /// All entries in the range share the first \p offset elements of their
+  /// keys with the path leading to this position.
+  ///
+  /// This runs in two passes over the same recursion: in the counting
+  /// pass, \p storage is null and only \p nextNode is advanced; in the
+  /// building pass, nodes are taken from \p storage in recursion order.
+  static Node *buildBalanced(ArrayRef<std::pair<KeyType, ValueType>> entries,
+                             size_t offset, Node *storage, size_t &nextNode) {
+    if (entries.empty()) return nullptr;
+
+    // A fully-consumed key can only be the first entry (a prefix sorts
+    // before its extensions); it becomes a node with an empty local key.
+    // This only arises for the empty key at the root.
+    if (entries.front().first.size() == offset) {
+      Node *node = (storage ? &storage[nextNode] : nullptr);
+      ++nextNode;
+      Node *further = buildBalanced(entries.drop_front(), offset,
+                                    storage, nextNode);
+      if (node) {
+        node->InBulkArray = true;
+        node->Further = further;
+        node->Value.initializeFrom(entries.front().second);
+        node->HasValue = true;
+      }
+      return node;
+    }
+
+    // Take the run of entries sharing the median entry's first unconsumed
+    // element; it becomes this node, and the runs on either side become
+    // weight-balanced sibling subtrees.
+    size_t mid = entries.size() / 2;
+    const KeyElementType &elem = entries[mid].first[offset];
+    size_t lo = mid, hi = mid + 1;
+    while (lo > 0 && entries[lo - 1].first[offset] == elem) --lo;
+    while (hi < entries.size() && entries[hi].first[offset] == elem) ++hi;
+    auto group = entries.slice(lo, hi - lo);
+
+    // The common prefix of a sorted range is the common prefix of its
+    // first and last entries.  The local key holds as much of it as fits;
+    // any remainder continues in a chained Further node.
+    KeyType firstKey = group.front().first;
+    KeyType lastKey = group.back().first;
+    size_t maxPrefix = std::min(firstKey.size(), lastKey.size()) - offset;
+    size_t prefix = 1;
+    while (prefix < maxPrefix &&
+           firstKey[offset + prefix] == lastKey[offset + prefix])
+      ++prefix;
+    size_t localLength = std::min(prefix, InlineKeyCapacity);
+    size_t newOffset = offset + localLength;
+
+    Node *node = (storage ? &storage[nextNode] : nullptr);
+    ++nextNode;
+
+    Node *left = buildBalanced(entries.slice(0, lo), offset,
+                               storage, nextNode);
+    Node *right = buildBalanced(entries.slice(hi), offset,
+                                storage, nextNode);
+
+    // An entry whose key ends exactly at the local key supplies this
+    // node's value; the rest continue along the Further link.
+    bool hasValue = (firstKey.size() == newOffset);
+    Node *further = buildBalanced(hasValue ? group.drop_front() : group,
+                                  newOffset, storage, nextNode);
+
+    if (node) {
+      node->InBulkArray = true;
+      node->Left = left;
+      node->Right = right;
+      node->Further = further;
+      node->KeyLength = localLength;
+      memcpy(node->Key, firstKey.data() + offset,
+             localLength * sizeof(KeyElementType));
+      if (hasValue) {
+        node->Value.initializeFrom(group.front().second);
+        node->HasValue = true;
+      }
+    }
+    return node;
+  }
+
   Node *Root = nullptr;
 
+  /// The contiguous node array of a bulk-loaded map, or null.
+  Node *BulkNodes = nullptr;
+
 public:
   PrefixMap() {}
 
+  /// Construct a map from entries sorted lexicographically by key, with
+  /// no duplicate keys.  The nodes are laid out in one contiguous array
+  /// in probe order and the sibling trees are weight-balanced, so this
+  /// both avoids the per-node allocation churn of repeated insertion and
+  /// probes with better locality.  The map remains fully mutable;
+  /// subsequent insertions allocate individual nodes as usual.
+  explicit PrefixMap(ArrayRef<std::pair<KeyType, ValueType>> sortedEntries) {
+    if (sortedEntries.empty()) return;
+    assert(std::is_sorted(sortedEntries.begin(), sortedEntries.end(),
+                          [](const std::pair<KeyType, ValueType> &lhs,
+                             const std::pair<KeyType, ValueType> &rhs) {
+                            return std::lexicographical_compare(
+                                lhs.first.begin(), lhs.first.end(),
+                                rhs.first.begin(), rhs.first.end());
+                          }) &&
+           "bulk-loaded entries must be sorted by key");
+
+    size_t numNodes = 0;
+    buildBalanced(sortedEntries, 0, nullptr, numNodes);
+    BulkNodes = new Node[numNodes];
+    size_t nextNode = 0;
+    Root = buildBalanced(sortedEntries, 0, BulkNodes, nextNode);
+    assert(nextNode == numNodes && "counting pass disagrees with build");
+  }
+
   PrefixMap(const PrefixMap &other) : Root(cloneTree(other.Root)) {}
-  PrefixMap(PrefixMap &&other) : Root(other.Root) {
+  PrefixMap(PrefixMap &&other) : Root(other.Root),
+                                 BulkNodes(other.BulkNodes) {
     other.Root = nullptr;
+    other.BulkNodes = nullptr;
   }
   PrefixMap &operator=(const PrefixMap &other) {
     deleteTree(Root);
+    delete[] BulkNodes;
+    BulkNodes = nullptr;
     Root = cloneTree(other.Root);
     return *this;
   }
   PrefixMap &operator=(PrefixMap &&other) {
     deleteTree(Root);
+    delete[] BulkNodes;
     Root = other.Root;
+    BulkNodes = other.BulkNodes;
     other.Root = nullptr;
+    other.BulkNodes = nullptr;
     return *this;
   }
 
   ~PrefixMap() {
     deleteTree(Root);
+    delete[] BulkNodes;
   }
 
   /// Are there any entries in this map?
@@ -575,7 +703,9 @@ public:
   /// Remove all entries in the map.
   void clear() {
     deleteTree(Root);
+    delete[] BulkNodes;
     Root = nullptr;
+    BulkNodes = nullptr;
   }
 
   /// Get or create an entry in the map.
@@ -0,0 +1,52 @@
+//===--- SamplingProfiler.h - In-process stack sampling ---------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A lightweight sampling profiler for the compiler's own execution, used to
+// produce flame graphs of slow invocations without external tooling.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_SAMPLINGPROFILER_H
+#define SWIFT_BASIC_SAMPLINGPROFILER_H
+
+#include "swift/Basic/LLVM.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+
+namespace swift {
+
+/// Samples the process's own stacks while an instance is alive.
+///
+/// The running thread's stack is captured roughly 100 times per second of
+/// CPU time from a SIGPROF handler into preallocated storage.  On
+/// destruction the samples are symbolized -- Swift frames through the
+/// in-tree demangler -- and written to the given path in the collapsed
+/// stack format that flame graph tools consume: one
+/// "frame;frame;...;frame count" line per unique stack.
+///
+/// At most one instance may exist at a time.  On platforms without
+/// backtrace(3) support, construction quietly does nothing.
+class SamplingProfiler {
+  std::string OutputPath;
+  bool Active;
+
+public:
+  explicit SamplingProfiler(StringRef outputPath);
+  ~SamplingProfiler();
+
+  SamplingProfiler(const SamplingProfiler &) = delete;
+  SamplingProfiler &operator=(const SamplingProfiler &) = delete;
+};
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_SAMPLINGPROFILER_H
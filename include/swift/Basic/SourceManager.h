@@ -14,10 +14,12 @@
 #define SWIFT_BASIC_SOURCEMANAGER_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <vector>
 
 namespace swift {
 
@@ -42,6 +44,12 @@ class SourceManager {
   std::map<const char *, VirtualFile> VirtualFiles;
   mutable std::pair<const char *, const VirtualFile*> CachedVFile = {nullptr, nullptr};
 
+  /// Lazily built per-buffer line tables: the byte offset of the start of
+  /// each line, in order.  Built with a single scan over the buffer on the
+  /// first line or column query against it, and shared by every subsequent
+  /// query (diagnostics, indexing, SourceKit) instead of rescanning.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsets;
+
 public:
   llvm::SourceMgr &getLLVMSourceMgr() {
     return LLVMSourceMgr;
@@ -183,9 +191,9 @@ public:
   getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const {
     assert(Loc.isValid());
     int LineOffset = getLineOffset(Loc);
-    int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc.Value, BufferID);
-    assert(LineOffset+l > 0 && "bogus line offset");
+    unsigned l, c;
+    std::tie(l, c) = findLineAndColumn(Loc, BufferID);
+    assert(LineOffset+(int)l > 0 && "bogus line offset");
     return { LineOffset + l, c };
   }
 
@@ -196,7 +204,7 @@ public:
   /// This does not respect #line directives.
   unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const {
     assert(Loc.isValid());
-    return LLVMSourceMgr.FindLineNumber(Loc.Value, BufferID);
+    return findLineAndColumn(Loc, BufferID).first;
   }
 
   StringRef getEntireTextForBuffer(unsigned BufferID) const;
@@ -222,9 +230,22 @@ public:
                                SourceLoc();
   }
 
+  /// Return the line table for the given buffer, building it on first use.
+  ///
+  /// The table holds the byte offset of the start of each line, including
+  /// the (possibly empty) line following the final newline.
+  ArrayRef<unsigned> getLineStartOffsets(unsigned BufferID) const;
+
 private:
   const VirtualFile *getVirtualFile(SourceLoc Loc) const;
 
+  /// Look up the 1-based line and byte column of \p Loc in its buffer's
+  /// line table.  If \p BufferID is zero, it is computed from \p Loc.
+  ///
+  /// This does not respect #line directives.
+  std::pair<unsigned, unsigned>
+  findLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const;
+
   int getLineOffset(SourceLoc Loc) const {
     if (auto VFile = getVirtualFile(Loc))
       return VFile->LineOffset;
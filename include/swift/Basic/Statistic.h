@@ -104,11 +104,28 @@ public:
     SourceRange SourceRange;
   };
 
+  /// A fixed-size record of one counter change, stored in the preallocated
+  /// ring used by the binary tracing mode.  Unlike the text trace, these
+  /// are cheap enough to record unconditionally in production builds: no
+  /// formatting and no growth, just a slot overwrite (the ring keeps the
+  /// most recent events when it wraps).
+  struct TraceRingEvent
+  {
+    uint64_t TimeUSec;
+    uint64_t LiveUSec;
+    StringRef EventName;
+    StringRef CounterName;
+    size_t CounterDelta;
+    size_t CounterValue;
+    bool IsEntry;
+  };
+
 private:
   bool currentProcessExitStatusSet;
   int currentProcessExitStatus;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> TraceRingFilename;
   llvm::TimeRecord StartedTime;
   std::unique_ptr<llvm::NamedRegionTimer> Timer;
   SourceManager *SourceMgr;
@@ -116,11 +133,15 @@ private:
   std::unique_ptr<AlwaysOnFrontendCounters> FrontendCounters;
   std::unique_ptr<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   std::vector<FrontendStatsEvent> FrontendStatsEvents;
+  std::vector<TraceRingEvent> TraceRing;
+  size_t NextTraceRingSlot;
+  bool TraceRingWrapped;
   std::unique_ptr<AlwaysOnFrontendRecursiveSharedTimers>
       FrontendRecursiveSharedTimers;
 
   void publishAlwaysOnStatsToLLVM();
   void printAlwaysOnStatsAndTimers(llvm::raw_ostream &OS);
+  void flushTraceEventRing();
 
   UnifiedStatsReporter(StringRef ProgramName,
                        StringRef AuxName,
@@ -147,6 +168,13 @@ public:
                                      SourceRange const &R);
   void saveAnyFrontendStatsEvents(FrontendStatsTracer const& T,
                                   bool IsEntry);
+
+  /// Enable binary event tracing into a preallocated ring of \p MaxEvents
+  /// records, flushed to a compact binary file at exit.  This also enables
+  /// the per-tracer counter deltas, but not the (much more expensive) text
+  /// event log.  Can be switched on from the environment by setting
+  /// SWIFT_STATS_TRACE_RING.
+  void enableTraceEventRing(size_t MaxEvents = 1 << 18);
 };
 
 }
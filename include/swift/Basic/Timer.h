@@ -20,6 +20,13 @@
 namespace swift {
   /// A convenience class for declaring a timer that's part of the Swift
   /// compilation timers group.
+  ///
+  /// Beyond the flat -debug-time-compilation report, SharedTimer scopes
+  /// nest dynamically: when phase tracing is enabled by setting
+  /// SWIFT_PHASE_TRACE in the environment to an output path, every scope
+  /// is recorded into a per-invocation phase tree and written out as
+  /// chrome://tracing JSON when the process exits, so regressions can be
+  /// localized below the level of the flat phase totals.
   class SharedTimer {
     enum class State {
       Initial,
@@ -30,12 +37,24 @@ namespace swift {
 
     Optional<llvm::NamedRegionTimer> Timer;
 
+    /// Index of this scope's node in the phase trace, or ~0U when phase
+    /// tracing is disabled.
+    unsigned PhaseIndex = ~0U;
+
+    void beginPhase(StringRef name);
+    void endPhase();
+
   public:
     explicit SharedTimer(StringRef name) {
       if (CompilationTimersEnabled == State::Enabled)
         Timer.emplace(name, name, "swift", "Swift compilation");
       else
         CompilationTimersEnabled = State::Skipped;
+      beginPhase(name);
+    }
+
+    ~SharedTimer() {
+      endPhase();
     }
 
     /// Must be called before any SharedTimers have been created.
@@ -29,9 +29,25 @@ class TreeScopedHashTable;
 template <typename K, typename V, typename AllocatorTy = llvm::MallocAllocator>
 class TreeScopedHashTableScope;
 
+template <typename K, typename V, typename AllocatorTy>
+class TreeScopedHashTableScopeImpl;
+
 template <typename K, typename V> class TreeScopedHashTableVal {
+  template <typename, typename, typename> friend class TreeScopedHashTable;
+  template <typename, typename, typename>
+  friend class TreeScopedHashTableScopeImpl;
+
   TreeScopedHashTableVal *NextInScope;
   TreeScopedHashTableVal *NextForKey;
+
+  /// The next live entry for the same key anywhere in the table, in no
+  /// particular scope order.  This chains together all entries reachable from
+  /// the hashtable bucket for the key, across all active scope branches.
+  TreeScopedHashTableVal *NextActiveForKey;
+
+  /// The ID of the scope this entry was inserted into.
+  unsigned ScopeID;
+
   K Key;
   V Val;
   TreeScopedHashTableVal(const K &Key, const V &Val) : Key(Key), Val(Val) {}
@@ -272,6 +288,11 @@ public:
 /// A detached scope takes ownership of the corresponding data in the
 /// hashtable.
 ///
+/// Lookup performs a single hash probe on the key, independent of how deeply
+/// the current scope is nested; shadowing between the (typically few) live
+/// bindings of the same key is resolved by chasing pointers along the scope
+/// chain.
+///
 /// All scopes should be destroyed before hashtable is destroyed.
 template <typename K, typename V, typename AllocatorTy>
 class TreeScopedHashTable {
@@ -283,9 +304,15 @@ public:
 
 private:
   typedef unsigned ScopeIDTy;
-  typedef std::pair<K, ScopeIDTy> KeyTy;
   typedef TreeScopedHashTableVal<K, V> ValTy;
-  llvm::DenseMap<KeyTy, ValTy *> TopLevelMap;
+
+  /// Maps a key to the chain of all its live entries, linked through
+  /// \c NextActiveForKey.  Keying the map on the key alone means a lookup
+  /// costs a single hash probe regardless of how deeply scopes are nested;
+  /// resolving which entry is visible from a given scope only chases
+  /// pointers.  Entries for keys that are not bound at all -- the common
+  /// case -- are rejected by that single probe.
+  llvm::DenseMap<K, ValTy *> TopLevelMap;
 
   AllocatorTy Allocator;
 
@@ -313,11 +340,15 @@ public:
   AllocatorCRefTy getAllocator() const { return Allocator; }
 
   bool count(const ScopeTy &S, const K &Key) const {
+    typename llvm::DenseMap<K, ValTy *>::const_iterator I =
+        TopLevelMap.find(Key);
+    if (I == TopLevelMap.end())
+      return false;
     const typename ScopeTy::ImplTy *CurrScope = S.getImpl();
     while (CurrScope) {
-      if (TopLevelMap.count(std::make_pair(Key, CurrScope->ID))) {
-        return true;
-      }
+      for (const ValTy *E = I->second; E; E = E->NextActiveForKey)
+        if (E->ScopeID == CurrScope->ID)
+          return true;
       CurrScope = CurrScope->ParentScope;
     }
     return false;
@@ -325,12 +356,18 @@ public:
 
 public:
   V lookup(const ScopeTy &S, const K &Key) {
+    typename llvm::DenseMap<K, ValTy *>::iterator I = TopLevelMap.find(Key);
+    if (I == TopLevelMap.end())
+      return V();
+    // The key is bound somewhere; find the innermost binding that is visible
+    // from \p S by walking up the scope chain and matching entries against
+    // each enclosing scope.  The per-key chain only contains live bindings of
+    // this one key, so it is short.
     const typename ScopeTy::ImplTy *CurrScope = S.getImpl();
     while (CurrScope) {
-      typename llvm::DenseMap<KeyTy, ValTy *>::iterator I =
-          TopLevelMap.find(std::make_pair(Key, CurrScope->ID));
-      if (I != TopLevelMap.end())
-        return I->second->getValue();
+      for (ValTy *E = I->second; E; E = E->NextActiveForKey)
+        if (E->ScopeID == CurrScope->ID)
+          return E->getValue();
       CurrScope = CurrScope->ParentScope;
     }
     return V();
@@ -341,11 +378,13 @@ public:
   iterator end() { return iterator(0); }
 
   iterator begin(ScopeTy &S, const K &Key) {
-    typename llvm::DenseMap<KeyTy, ValTy *>::iterator I =
-        TopLevelMap.find(std::make_pair(Key, S.getImpl()->ID));
+    typename llvm::DenseMap<K, ValTy *>::iterator I = TopLevelMap.find(Key);
     if (I == TopLevelMap.end())
       return end();
-    return iterator(I->second);
+    for (ValTy *E = I->second; E; E = E->NextActiveForKey)
+      if (E->ScopeID == S.getImpl()->ID)
+        return iterator(E);
+    return end();
   }
 
   /// This inserts the specified key/value at the specified
@@ -353,23 +392,28 @@ public:
   /// that isn't the current one, it isn't ok to insert *underneath* an existing
   /// value of the specified key.
   void insertIntoScope(ScopeTy &S, const K &Key, const V &Val) {
+    TreeScopedHashTableVal<K, V> *&KeyChain = TopLevelMap[Key];
+
+    // Find the innermost entry that the new value shadows, if any.
     TreeScopedHashTableVal<K, V> *PrevEntry = 0;
     const typename ScopeTy::ImplTy *CurrScope = S.getImpl();
-    while (CurrScope) {
-      typename llvm::DenseMap<KeyTy, ValTy *>::iterator I =
-          TopLevelMap.find(std::make_pair(Key, CurrScope->ID));
-      if (I != TopLevelMap.end()) {
-        PrevEntry = I->second;
-        break;
+    while (CurrScope && !PrevEntry) {
+      for (ValTy *E = KeyChain; E; E = E->NextActiveForKey) {
+        if (E->ScopeID == CurrScope->ID) {
+          PrevEntry = E;
+          break;
+        }
       }
       CurrScope = CurrScope->ParentScope;
     }
-    assert(TopLevelMap.find(std::make_pair(Key, S.getImpl()->ID)) == TopLevelMap.end());
+    assert((!PrevEntry || PrevEntry->ScopeID != S.getImpl()->ID) &&
+           "inserting duplicate key into the same scope");
 
-    TreeScopedHashTableVal<K, V> *&KeyEntry =
-        TopLevelMap[std::make_pair(Key, S.getImpl()->ID)];
-    KeyEntry =
+    ValTy *KeyEntry =
         ValTy::Create(S.getImpl()->LastValInScope, PrevEntry, Key, Val, Allocator);
+    KeyEntry->ScopeID = S.getImpl()->ID;
+    KeyEntry->NextActiveForKey = KeyChain;
+    KeyChain = KeyEntry;
     S.getImpl()->LastValInScope = KeyEntry;
   }
 };
@@ -381,11 +425,17 @@ TreeScopedHashTableScopeImpl<K, V, Allocator>::~TreeScopedHashTableScopeImpl() {
 
   // Pop and delete all values corresponding to this scope.
   while (TreeScopedHashTableVal<K, V> *ThisEntry = LastValInScope) {
-    // Pop this value out of the TopLevelMap.
-    assert(HT->TopLevelMap[std::make_pair(ThisEntry->getKey(), this->ID)] ==
-               ThisEntry &&
-           "Scope imbalance!");
-    HT->TopLevelMap.erase(std::make_pair(ThisEntry->getKey(), this->ID));
+    // Unlink this value from its key's chain of live entries, erasing the
+    // hashtable bucket if this was the last one.
+    typename llvm::DenseMap<K, TreeScopedHashTableVal<K, V> *>::iterator I =
+        HT->TopLevelMap.find(ThisEntry->getKey());
+    assert(I != HT->TopLevelMap.end() && "Scope imbalance!");
+    TreeScopedHashTableVal<K, V> **Link = &I->second;
+    while (*Link != ThisEntry)
+      Link = &(*Link)->NextActiveForKey;
+    *Link = ThisEntry->NextActiveForKey;
+    if (!I->second)
+      HT->TopLevelMap.erase(I);
 
     // Pop this value out of the scope.
     LastValInScope = ThisEntry->getNextInScope();
@@ -234,7 +234,31 @@ inline bool isMangledName(llvm::StringRef MangledName) {
 /// \param mangledName A null-terminated string containing a mangled name.
 bool isSwiftSymbol(const char *mangledName);
 
+/// Demangle a symbol through the print-only fast path.
+///
+/// Common plain-function symbols are printed directly from the mangled
+/// text into \p OutputBuffer, without building a node tree. For the
+/// symbol shapes it covers, the output is identical to
+/// demangleSymbolAsString with default options.
+///
+/// \param MangledName A null-terminated string containing a mangled name.
+///
+/// \returns The length of the demangled string, like strlcpy (excluding
+/// the terminating null and regardless of truncation), or 0 if the
+/// symbol's shape is not covered and the caller must fall back to the
+/// full demangler.
+size_t fastDemangleSymbolAsString(const char *MangledName,
+                                  char *OutputBuffer,
+                                  size_t OutputBufferLength);
+
 class Demangler;
+class SymbolDemangleCache;
+
+/// Hit statistics for the optional symbol demangling cache of a Context.
+struct DemangleCacheStats {
+  uint64_t Hits = 0;
+  uint64_t Misses = 0;
+};
 
 /// The demangler context.
 ///
@@ -255,6 +279,7 @@ class Demangler;
 ///
 class Context {
   Demangler *D;
+  SymbolDemangleCache *Cache = nullptr;
 
   friend class Node;
 
@@ -263,6 +288,20 @@ public:
 
   ~Context();
 
+  /// Enable caching of demangled symbol strings in this context.
+  ///
+  /// Symbolication workloads demangle a small set of hot symbols over and
+  /// over; with caching enabled, demangleSymbolAsString keeps up to
+  /// \p Capacity successfully demangled strings, keyed by the mangled
+  /// name, and evicts the least recently used entry beyond that. Because
+  /// results are keyed by the mangled name only, all calls on a caching
+  /// context must use the same DemangleOptions.
+  void enableSymbolCache(size_t Capacity = 1024);
+
+  /// Return hit statistics for the symbol cache. All-zero if the cache
+  /// was never enabled.
+  DemangleCacheStats getSymbolCacheStats() const;
+
   /// Demangle the given symbol and return the parse tree.
   ///
   /// \param MangledName The mangled symbol string, which start a mangling
@@ -422,6 +461,17 @@ void mangleIdentifier(const char *data, size_t length,
 /// This should always round-trip perfectly with demangleSymbolAsNode.
 std::string mangleNode(const NodePointer &root);
 
+class DemanglerPrinter;
+
+/// \brief Remangle a demangled parse tree into a caller-owned printer.
+///
+/// The mangling is appended to \p printer, so a caller which remangles in
+/// a loop can reuse one printer (calling resetSize() between iterations)
+/// instead of paying for a fresh allocation per call.
+///
+/// \returns the portion of the printer's buffer written by this call.
+llvm::StringRef mangleNode(const NodePointer &root, DemanglerPrinter &printer);
+
 /// Remangle in the old mangling scheme.
 ///
 /// This is only used for objc-runtime names and should be removed as soon as
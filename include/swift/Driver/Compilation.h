@@ -23,6 +23,7 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Statistic.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 
@@ -93,6 +94,11 @@ private:
   /// A list of input files and their associated types.
   InputFileList InputFilesWithTypes;
 
+  /// Modification times of the input files, gathered on worker threads up
+  /// front so that the incremental build decision path does not pay for one
+  /// blocking stat per input. Missing files map to TimePoint<>::max().
+  llvm::StringMap<llvm::sys::TimePoint<>> InputModTimeCache;
+
   /// When non-null, a temporary file containing all input .swift files.
   /// Used for large compilations to avoid overflowing argv.
   const char *AllSourceFilesPath = nullptr;
@@ -107,9 +113,22 @@ private:
   /// This is used for incremental builds.
   std::string CompilationRecordPath;
 
+  /// True if the compilation record should be written in the compact binary
+  /// format rather than YAML.
+  bool UseBinaryCompilationRecord = false;
+
   /// A hash representing all the arguments that could trigger a full rebuild.
   std::string ArgsHash;
 
+  /// The path to a directory used as a content-addressed cache of job
+  /// outputs, or empty if output caching is disabled.
+  std::string CompilationCachePath;
+
+  /// If non-empty, compile jobs are launched through this wrapper executable
+  /// (which receives the original command line as its arguments), allowing an
+  /// external tool to dispatch them to remote build workers.
+  std::string RemoteExecutionWrapper;
+
   /// When the build was started.
   ///
   /// This should be as close as possible to when the driver was invoked, since
@@ -213,6 +232,19 @@ public:
   const llvm::opt::DerivedArgList &getArgs() const { return *TranslatedArgs; }
   ArrayRef<InputPair> getInputFiles() const { return InputFilesWithTypes; }
 
+  /// Gathers the modification times of all source inputs, using several
+  /// threads when there are enough files for that to pay off.
+  void prefetchInputModTimes();
+
+  /// Returns the prefetched modification time for \p path, or None if the
+  /// path was not covered by \c prefetchInputModTimes().
+  Optional<llvm::sys::TimePoint<>> getCachedInputModTime(StringRef path) const {
+    auto iter = InputModTimeCache.find(path);
+    if (iter == InputModTimeCache.end())
+      return None;
+    return iter->second;
+  }
+
   unsigned getNumberOfParallelCommands() const {
     return NumberOfParallelCommands;
   }
@@ -248,6 +280,20 @@ public:
     LastBuildTime = time;
   }
 
+  void setUseBinaryCompilationRecord(bool value = true) {
+    UseBinaryCompilationRecord = value;
+  }
+
+  void setCompilationCachePath(StringRef path) {
+    assert(CompilationCachePath.empty() && "already set");
+    CompilationCachePath = path;
+  }
+
+  void setRemoteExecutionWrapper(StringRef path) {
+    assert(RemoteExecutionWrapper.empty() && "already set");
+    RemoteExecutionWrapper = path;
+  }
+
   /// Requests the path to a file containing all input source files. This can
   /// be shared across jobs.
   ///
@@ -133,6 +133,23 @@ private:
   /// \sa SourceFile::getInterfaceHash
   llvm::DenseMap<const void *, std::string> InterfaceHashes;
 
+  /// For each node, a hash of the source text of each non-private top-level
+  /// declaration it provides, keyed by the same name used for the node's
+  /// top-level "provides" entries.
+  ///
+  /// This is finer-grained than the interface hash: when a file is reloaded,
+  /// comparing these hashes tells us which declarations actually changed.
+  llvm::DenseMap<const void *, llvm::StringMap<std::string>> DeclHashes;
+
+  /// Top-level names whose declaration hash was provably unchanged the last
+  /// time the node's dependency file was reloaded. Names with no hash entry
+  /// at all (operator declarations and precedence groups, for example) never
+  /// count as unchanged, so their dependents always cascade.
+  ///
+  /// An entry is only present when the previous load recorded per-decl
+  /// hashes; it is consumed by the next markTransitive() for the node.
+  llvm::DenseMap<const void *, llvm::StringSet<>> CleanDeclNames;
+
   LoadResult loadFromBuffer(const void *node, llvm::MemoryBuffer &buffer);
 
   // FIXME: We should be able to use llvm::mapped_iterator for this, but
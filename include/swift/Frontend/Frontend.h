@@ -449,6 +449,17 @@ public:
   /// holding on.
   void freeContextAndSIL();
 
+  /// Returns this instance to its pre-setup() state so that it can be set
+  /// up again for another job.
+  ///
+  /// Frees the ASTContext and SILModule, forgets the inputs of the previous
+  /// job and clears the diagnostic error state.  Registered diagnostic
+  /// consumers and the dependency tracker are kept, so a long-lived worker
+  /// process can run many jobs through one instance instead of paying for a
+  /// fresh CompilerInstance per job.  Source buffers already handed to the
+  /// SourceManager stay alive until the instance itself is destroyed.
+  void reset();
+
 private:
   /// Load stdlib & return true if should continue, i.e. no error
   bool loadStdlib();
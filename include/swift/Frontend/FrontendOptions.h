@@ -260,6 +260,10 @@ public:
   /// The path to which we should output a TBD file.
   std::string TBDPath;
 
+  /// The path to which we should output a linker order file listing the
+  /// functions the profile marked as executed, hottest first.
+  std::string OrderFilePath;
+
   /// Arguments which should be passed in immediate mode.
   std::vector<std::string> ImmediateArgv;
 
@@ -366,11 +370,24 @@ public:
   /// Trace changes to stats to files in StatsOutputDir.
   bool TraceStats = false;
 
+  /// Build-session identifier received from the driver, recorded in the
+  /// stats output so files from one build can be joined back together.
+  std::string StatsBuildSession;
+
+  /// If non-empty, sample the compiler's own stacks during this invocation
+  /// and write a collapsed-stack profile to the given path.
+  std::string ProfileFrontendPath;
+
   /// If true, serialization encodes an extra lookup table for use in module-
   /// merging when emitting partial modules (the per-file modules in a non-WMO
   /// build).
   bool EnableSerializationNestedTypeLookupTable = true;
 
+  /// If true, serialization emits declaration-only SIL records for public
+  /// functions whose bodies are not serialized, carrying their effects and
+  /// semantics attributes for use by cross-module optimization.
+  bool SerializePublicSILDeclarations = false;
+
   /// Indicates whether or not an import statement can pick up a Swift source
   /// file (as opposed to a module file).
   bool EnableSourceImport = false;
@@ -24,6 +24,10 @@
 #include <string>
 #include <vector>
 
+namespace llvm {
+class MemoryBuffer;
+}
+
 namespace swift {
 class CodeCompletionCallbacksFactory;
 class Decl;
@@ -779,6 +783,12 @@ struct CodeCompletionResultSink {
   /// other sinks.
   std::vector<AllocatorPtr> ForeignAllocators;
 
+  /// Buffers that back strings of results deserialized from the completion
+  /// cache.  Such results reference the (possibly memory-mapped) buffer
+  /// directly rather than copying every string into the allocator, so the
+  /// strings materialize only when a result is actually scored or printed.
+  std::vector<std::shared_ptr<llvm::MemoryBuffer>> BackingBuffers;
+
   std::vector<CodeCompletionResult *> Results;
 
   /// A single-element cache for module names stored in Allocator, keyed by a
@@ -43,13 +43,22 @@ public:
     bool ForTestableLookup;
     bool CodeCompleteInitsInPostfixExpr;
 
+    /// An interface hash for sub-module result chunks, e.g. the results
+    /// contributed by a single source file of the current module.  When
+    /// non-empty, the entry is validated by this hash (which participates
+    /// in the key) instead of the module file's modification time, so
+    /// cached results stay usable as long as the interface is stable.
+    std::string InterfaceHash;
+
     friend bool operator==(const Key &LHS, const Key &RHS) {
       return LHS.ModuleFilename == RHS.ModuleFilename &&
         LHS.ModuleName == RHS.ModuleName &&
         LHS.AccessPath == RHS.AccessPath &&
         LHS.ResultsHaveLeadingDot == RHS.ResultsHaveLeadingDot &&
         LHS.ForTestableLookup == RHS.ForTestableLookup &&
-        LHS.CodeCompleteInitsInPostfixExpr == RHS.CodeCompleteInitsInPostfixExpr;
+        LHS.CodeCompleteInitsInPostfixExpr ==
+          RHS.CodeCompleteInitsInPostfixExpr &&
+        LHS.InterfaceHash == RHS.InterfaceHash;
     }
   };
 
@@ -105,10 +114,10 @@ template<>
 struct DenseMapInfo<swift::ide::CodeCompletionCache::Key> {
   using KeyTy = swift::ide::CodeCompletionCache::Key;
   static inline KeyTy getEmptyKey() {
-    return KeyTy{"", "", {}, false, false, false};
+    return KeyTy{"", "", {}, false, false, false, ""};
   }
   static inline KeyTy getTombstoneKey() {
-    return KeyTy{"", "", {}, true, false, false};
+    return KeyTy{"", "", {}, true, false, false, ""};
   }
   static unsigned getHashValue(const KeyTy &Val) {
     size_t H = 0;
@@ -118,6 +127,7 @@ struct DenseMapInfo<swift::ide::CodeCompletionCache::Key> {
       H ^= std::hash<std::string>()(Piece);
     H ^= std::hash<bool>()(Val.ResultsHaveLeadingDot);
     H ^= std::hash<bool>()(Val.ForTestableLookup);
+    H ^= std::hash<std::string>()(Val.InterfaceHash);
     return static_cast<unsigned>(H);
   }
   static bool isEqual(const KeyTy &LHS, const KeyTy &RHS) {
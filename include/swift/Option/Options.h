@@ -49,6 +49,15 @@ namespace options {
 
   std::unique_ptr<llvm::opt::OptTable> createSwiftOptTable();
 
+  /// Returns a process-wide shared instance of the Swift option table.
+  ///
+  /// The table is immutable once constructed and parsing through it is
+  /// const, so it can be shared freely between threads.  Clients which
+  /// parse argument lists repeatedly, like SourceKit building a
+  /// CompilerInvocation per request, should prefer this to constructing
+  /// a fresh table with createSwiftOptTable() each time.
+  const llvm::opt::OptTable &getSwiftOptTable();
+
 } // end namespace swift
 
 #endif
@@ -18,6 +18,7 @@
 #define SWIFT_PARSE_PERSISTENTPARSERSTATE_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "swift/Parse/Lexer.h"
 #include "swift/Parse/LocalContext.h"
 #include "swift/Parse/Scope.h"
 #include "llvm/ADT/DenseMap.h"
@@ -37,6 +38,10 @@ public:
 
   class FunctionBodyState {
     ParserPos BodyPos;
+    /// The lexer state for the start of the body, recorded when the body was
+    /// skipped so that demand-parsing can seek to it directly instead of
+    /// re-deriving it from the source location.
+    Lexer::State BodyStart;
     SavedScope Scope;
     friend class Parser;
 
@@ -46,13 +51,17 @@ public:
 
   public:
     FunctionBodyState(SourceRange BodyRange, SourceLoc PreviousLoc,
-                      SavedScope &&Scope)
-      : BodyPos{BodyRange.Start, PreviousLoc}, Scope(std::move(Scope))
+                      Lexer::State BodyStart, SavedScope &&Scope)
+      : BodyPos{BodyRange.Start, PreviousLoc}, BodyStart(BodyStart),
+        Scope(std::move(Scope))
     {}
   };
 
   class AccessorBodyState {
     ParserPos BodyPos;
+    /// The lexer state for the start of the body; see
+    /// FunctionBodyState::BodyStart.
+    Lexer::State BodyStart;
     SavedScope Scope;
     SourceLoc LBLoc;
     friend class Parser;
@@ -63,9 +72,10 @@ public:
 
   public:
     AccessorBodyState(SourceRange BodyRange, SourceLoc PreviousLoc,
-                      SavedScope &&Scope, SourceLoc LBLoc)
-        : BodyPos{BodyRange.Start, PreviousLoc}, Scope(std::move(Scope)),
-          LBLoc(LBLoc) {}
+                      Lexer::State BodyStart, SavedScope &&Scope,
+                      SourceLoc LBLoc)
+        : BodyPos{BodyRange.Start, PreviousLoc}, BodyStart(BodyStart),
+          Scope(std::move(Scope)), LBLoc(LBLoc) {}
   };
 
   enum class DelayedDeclKind {
@@ -126,7 +136,8 @@ public:
 
   void delayFunctionBodyParsing(AbstractFunctionDecl *AFD,
                                 SourceRange BodyRange,
-                                SourceLoc PreviousLoc);
+                                SourceLoc PreviousLoc,
+                                Lexer::State BodyStart);
   std::unique_ptr<FunctionBodyState>
   takeFunctionBodyState(AbstractFunctionDecl *AFD);
 
@@ -135,6 +146,7 @@ public:
   void delayAccessorBodyParsing(AbstractFunctionDecl *AFD,
                                 SourceRange BodyRange,
                                 SourceLoc PreviousLoc,
+                                Lexer::State BodyStart,
                                 SourceLoc LBLoc);
   std::unique_ptr<AccessorBodyState>
   takeAccessorBodyState(AbstractFunctionDecl *AFD);
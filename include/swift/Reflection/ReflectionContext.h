@@ -26,7 +26,11 @@
 #include "swift/Reflection/TypeRefBuilder.h"
 #include "swift/Runtime/Unreachable.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <memory>
 #include <set>
 #include <vector>
 #include <unordered_map>
@@ -37,6 +41,118 @@ namespace reflection {
 using swift::remote::MemoryReader;
 using swift::remote::RemoteAddress;
 
+/// A MemoryReader wrapper that caches remote memory in page-sized chunks.
+///
+/// Typeref decoding reads remote metadata a few bytes at a time; against a
+/// reader backed by a live remote process, each of those reads is a full
+/// round-trip. This wrapper instead fetches the pages a read touches with a
+/// single batched read and serves subsequent reads from an LRU cache of
+/// those pages. It assumes the target is stopped: cached pages are never
+/// invalidated.
+class PageCachingMemoryReader final : public MemoryReader {
+  static const uint64_t PageSize = 4096;
+  static const size_t MaxCachedPages = 64;
+
+  using Page = std::pair<uint64_t, std::vector<uint8_t>>;
+
+  std::shared_ptr<MemoryReader> Underlying;
+
+  /// Cached pages, most recently used first.
+  std::list<Page> Pages;
+  std::unordered_map<uint64_t, std::list<Page>::iterator> PageMap;
+
+public:
+  explicit PageCachingMemoryReader(std::shared_ptr<MemoryReader> underlying)
+    : Underlying(std::move(underlying)) {}
+
+  uint8_t getPointerSize() override {
+    return Underlying->getPointerSize();
+  }
+
+  uint8_t getSizeSize() override {
+    return Underlying->getSizeSize();
+  }
+
+  RemoteAddress getSymbolAddress(const std::string &name) override {
+    return Underlying->getSymbolAddress(name);
+  }
+
+  bool readString(RemoteAddress address, std::string &dest) override {
+    return Underlying->readString(address, dest);
+  }
+
+  bool readBytes(RemoteAddress address, uint8_t *dest,
+                 uint64_t size) override {
+    if (size == 0)
+      return true;
+
+    uint64_t start = address.getAddressData();
+    uint64_t firstPage = start & ~(PageSize - 1);
+    uint64_t lastPage = (start + size - 1) & ~(PageSize - 1);
+
+    // Ranges too big to fit in the cache bypass it.
+    if ((lastPage - firstPage) / PageSize + 1 > MaxCachedPages)
+      return Underlying->readBytes(address, dest, size);
+
+    // Fetch every page the range touches that isn't cached yet, in one
+    // batched read.
+    std::vector<uint64_t> missingPages;
+    for (uint64_t page = firstPage; ; page += PageSize) {
+      if (!PageMap.count(page))
+        missingPages.push_back(page);
+      if (page == lastPage)
+        break;
+    }
+    if (!missingPages.empty()) {
+      std::vector<std::vector<uint8_t>> buffers(missingPages.size());
+      std::vector<MemoryReader::ReadRange> ranges;
+      ranges.reserve(missingPages.size());
+      for (size_t i = 0; i != missingPages.size(); ++i) {
+        buffers[i].resize(PageSize);
+        ranges.emplace_back(RemoteAddress(missingPages[i]),
+                            buffers[i].data(), PageSize);
+      }
+      // A page the range touches may straddle the end of a mapping even
+      // though the requested bytes themselves are readable, so on any page
+      // failure fall back to an uncached read of the original range.
+      if (!Underlying->readRanges(ranges.data(), ranges.size()))
+        return Underlying->readBytes(address, dest, size);
+      for (size_t i = 0; i != missingPages.size(); ++i)
+        cachePage(missingPages[i], std::move(buffers[i]));
+    }
+
+    // Copy the requested bytes out of the cached pages, bumping each page
+    // to the front of the LRU list.
+    uint64_t copied = 0;
+    for (uint64_t page = firstPage; copied != size; page += PageSize) {
+      auto found = PageMap.find(page);
+      if (found == PageMap.end()) {
+        // The page was evicted by the insertions above; read the remainder
+        // directly.
+        return Underlying->readBytes(RemoteAddress(start + copied),
+                                     dest + copied, size - copied);
+      }
+      Pages.splice(Pages.begin(), Pages, found->second);
+      uint64_t offset = (start + copied) - page;
+      uint64_t chunk = std::min(size - copied, PageSize - offset);
+      std::memcpy(dest + copied, found->second->second.data() + offset,
+                  chunk);
+      copied += chunk;
+    }
+    return true;
+  }
+
+private:
+  void cachePage(uint64_t page, std::vector<uint8_t> &&bytes) {
+    Pages.emplace_front(page, std::move(bytes));
+    PageMap[page] = Pages.begin();
+    if (Pages.size() > MaxCachedPages) {
+      PageMap.erase(Pages.back().first);
+      Pages.pop_back();
+    }
+  }
+};
+
 template <typename Runtime>
 class ReflectionContext
        : public remote::MetadataReader<Runtime, TypeRefBuilder> {
@@ -55,7 +171,7 @@ public:
   using typename super::StoredPointer;
 
   explicit ReflectionContext(std::shared_ptr<MemoryReader> reader)
-    : super(std::move(reader)) {}
+    : super(std::make_shared<PageCachingMemoryReader>(std::move(reader))) {}
 
   ReflectionContext(const ReflectionContext &other) = delete;
   ReflectionContext &operator=(const ReflectionContext &other) = delete;
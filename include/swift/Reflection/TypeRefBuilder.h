@@ -144,6 +144,17 @@ private:
   std::unordered_map<TypeRefID, const TypeRef *,
                      TypeRefID::Hash, TypeRefID::Equal> AssociatedTypeCache;
 
+  /// Caches for field descriptor, builtin type descriptor and capture
+  /// descriptor lookups, so that repeated queries do not rescan the
+  /// reflection sections. Only successful lookups are cached, since a
+  /// failed one can start succeeding when another image's reflection info
+  /// is added.
+  std::unordered_map<std::string, const FieldDescriptor *> FieldTypeInfoCache;
+  std::unordered_map<std::string,
+                     const BuiltinTypeDescriptor *> BuiltinTypeInfoCache;
+  std::unordered_map<uintptr_t,
+                     const CaptureDescriptor *> CaptureDescriptorCache;
+
   TypeConverter TC;
   MetadataSourceBuilder MSB;
 
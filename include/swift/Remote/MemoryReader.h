@@ -20,6 +20,7 @@
 
 #include "swift/Remote/RemoteAddress.h"
 
+#include <cstddef>
 #include <string>
 
 namespace swift {
@@ -47,6 +48,35 @@ public:
   virtual bool readBytes(RemoteAddress address, uint8_t *dest,
                          uint64_t size) = 0;
 
+  /// A single range in a batched read. On return from readRanges, Success
+  /// indicates whether this particular range could be read.
+  struct ReadRange {
+    RemoteAddress Address;
+    uint8_t *Dest;
+    uint64_t Size;
+    bool Success;
+
+    ReadRange(RemoteAddress address, uint8_t *dest, uint64_t size)
+      : Address(address), Dest(dest), Size(size), Success(false) {}
+  };
+
+  /// Attempts to read several ranges from the remote process at once.
+  ///
+  /// Implementations backed by a high-latency transport should override
+  /// this to coalesce the ranges into a single round-trip. The default
+  /// implementation simply issues one readBytes call per range.
+  ///
+  /// Returns true only if every range was read successfully.
+  virtual bool readRanges(ReadRange *ranges, size_t numRanges) {
+    bool allSucceeded = true;
+    for (size_t i = 0; i != numRanges; ++i) {
+      ranges[i].Success =
+          readBytes(ranges[i].Address, ranges[i].Dest, ranges[i].Size);
+      allSucceeded &= ranges[i].Success;
+    }
+    return allSucceeded;
+  }
+
   /// Attempts to read a C string from the given address in the remote
   /// process.
   ///
@@ -23,10 +23,12 @@
 #include "swift/Remote/MemoryReader.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/ABI/MetadataValues.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 
 #include <memory>
+#include <vector>
 
 namespace swift {
 class ASTContext;
@@ -179,6 +181,27 @@ public:
   getTypeForRemoteTypeMetadata(remote::RemoteAddress address,
                                bool skipArtificial = false);
 
+  /// Resolve a batch of type metadata addresses in one call.  The results
+  /// are returned in the same order as the given addresses.
+  ///
+  /// Resolutions within a context are memoized, so metadata which has
+  /// already been resolved — by an earlier call or earlier in the same
+  /// batch — is not walked again.  Clients resolving many addresses at
+  /// once, like a debugger displaying an object graph, should prefer this
+  /// to issuing individual queries.
+  std::vector<Result<Type>>
+  getTypesForRemoteTypeMetadata(ArrayRef<remote::RemoteAddress> addresses,
+                                bool skipArtificial = false);
+
+  /// Clear the memoization caches of this context.
+  ///
+  /// Cached resolutions — including negative results for addresses which
+  /// could not be resolved — can become stale when the remote process
+  /// changes the set of loaded images.  A client which keeps a context
+  /// alive across such events should call this when an image is loaded
+  /// or unloaded.
+  void clearCaches();
+
   /// Given an address which is supposedly of type metadata, try to
   /// resolve it to a specific MetadataKind value for its backing type.
   Result<MetadataKind>
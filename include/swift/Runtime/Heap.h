@@ -19,4 +19,38 @@
 
 #include <llvm/Support/Compiler.h>
 
+#include "swift/Runtime/Config.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace swift {
+
+/// Aggregated allocation statistics for one (call site, size class) pair,
+/// as collected by the heap allocation sampling mode. The size class is the
+/// base-2 logarithm of the allocation size, rounded up.
+struct HeapAllocationSiteStats {
+  const void *Site;
+  uint32_t SizeClass;
+  uint64_t Count;
+};
+
+/// Set the sampling rate for heap allocation profiling. A rate of N records
+/// the return address and size class of every Nth swift_slowAlloc call per
+/// thread into a fixed-size aggregation table; a rate of 0 disables
+/// sampling. The fast path costs one relaxed load and a thread-local
+/// decrement per allocation. Return the old sampling rate.
+SWIFT_RUNTIME_EXPORT
+size_t _swift_setHeapAllocationSamplingRate(size_t rate);
+
+/// Copy up to maxEntries aggregated (site, size class, count) records into
+/// the provided buffer and return the number written. Samples that did not
+/// fit into the aggregation table are accumulated in a single record with a
+/// null Site.
+SWIFT_RUNTIME_EXPORT
+uint64_t _swift_getHeapAllocationSiteStats(HeapAllocationSiteStats *buffer,
+                                           uint64_t maxEntries);
+
+}
+
 #endif /* SWIFT_RUNTIME_HEAP_H */
@@ -333,6 +333,23 @@ SWIFT_RUNTIME_EXPORT
 void (*SWIFT_CC(RegisterPreservingCC)
                      _swift_release_n)(HeapObject *object, uint32_t n);
 
+/// Atomically increments the retain counts of two objects. The ARC
+/// contraction pass emits this in place of back-to-back retains of distinct
+/// objects. The two objects may dynamically be the same.
+SWIFT_RUNTIME_EXPORT
+void swift_retain_pair(HeapObject *object1, HeapObject *object2);
+
+SWIFT_RUNTIME_EXPORT
+void swift_nonatomic_retain_pair(HeapObject *object1, HeapObject *object2);
+
+/// Atomically decrements the retain counts of two objects, destroying any
+/// whose retain count reaches zero.
+SWIFT_RUNTIME_EXPORT
+void swift_release_pair(HeapObject *object1, HeapObject *object2);
+
+SWIFT_RUNTIME_EXPORT
+void swift_nonatomic_release_pair(HeapObject *object1, HeapObject *object2);
+
 /// Sets the RC_DEALLOCATING_FLAG flag. This is done non-atomically.
 /// The strong reference count of \p object must be 1 and no other thread may
 /// retain the object during executing this function.
@@ -480,6 +497,56 @@ void swift_deallocPartialClassInstance(HeapObject *object,
                                        size_t allocatedSize,
                                        size_t allocatedAlignMask);
 
+/// An allocation arena for heap objects with wholesale deallocation.
+///
+/// An arena carves object allocations out of large malloc'ed chunks and
+/// gives the memory back to the system all at once when the arena is
+/// destroyed, instead of paying for an individual free() per object. This
+/// is profitable for short-lived object graphs which are built up and then
+/// torn down as a unit.
+///
+/// An arena and all objects allocated in it may only be used from a single
+/// thread.
+struct SwiftArena;
+
+/// Creates a new allocation arena.
+///
+/// \param chunkSize - the granularity in which the arena requests memory
+///   from the system, or 0 to use a default size
+/// \return never null
+SWIFT_RUNTIME_EXPORT
+SwiftArena *swift_arenaCreate(size_t chunkSize);
+
+/// Destroys an arena and releases all of its memory wholesale.
+///
+/// All objects allocated in the arena must already have been deinitialized,
+/// i.e. the last strong reference to each of them must have been released.
+/// Their memory is only reclaimed here: releasing the last reference to an
+/// arena-allocated object runs its deinit as usual but leaves the memory to
+/// the arena.
+SWIFT_RUNTIME_EXPORT
+void swift_arenaDestroy(SwiftArena *arena);
+
+/// Allocates a new heap object in an arena.  The returned memory is
+/// uninitialized outside of the heap-object header, exactly as for
+/// swift_allocObject.
+///
+/// The object participates in normal reference counting and its deinit runs
+/// when the last strong reference is released, but its memory is not freed
+/// until the arena is destroyed.
+///
+/// \param arena - the arena to allocate in; never null
+/// \param requiredSize - the required size of the allocation,
+///   including the header
+/// \param requiredAlignmentMask - the required alignment of the allocation;
+///   always one less than a power of 2 that's at least alignof(void*)
+/// \return never null
+SWIFT_RUNTIME_EXPORT
+HeapObject *swift_allocObjectInArena(SwiftArena *arena,
+                                     HeapMetadata const *metadata,
+                                     size_t requiredSize,
+                                     size_t requiredAlignmentMask);
+
 /// Deallocate the given memory allocated by swift_allocBox; it was returned
 /// by swift_allocBox but is otherwise in an unknown state. The given Metadata
 /// pointer must be the same metadata pointer that was passed to swift_allocBox
@@ -3016,6 +3016,28 @@ SWIFT_CC(swift)
 SWIFT_RUNTIME_STDLIB_INTERFACE
 const Metadata *_swift_class_getSuperclass(const Metadata *theClass);
 
+/// Occupancy statistics for the runtime's metadata slab allocators,
+/// aggregated over all allocator instances.
+struct MetadataAllocatorStats {
+  /// The number of slabs allocated so far.
+  size_t NumSlabs;
+
+  /// The total capacity of those slabs in bytes.
+  size_t SlabBytesCapacity;
+
+  /// The number of slab bytes handed out to metadata allocations.
+  /// SlabBytesUsed / SlabBytesCapacity is the overall slab occupancy.
+  size_t SlabBytesUsed;
+
+  /// The number of bytes in oversized allocations that bypassed the
+  /// slabs and went directly to malloc.
+  size_t LargeAllocationBytes;
+};
+
+/// Read the current metadata slab allocator statistics.
+SWIFT_RUNTIME_EXPORT
+void _swift_getMetadataAllocatorStats(MetadataAllocatorStats *result);
+
 } // end namespace swift
 
 #pragma clang diagnostic pop
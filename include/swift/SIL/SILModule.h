@@ -127,6 +127,13 @@ private:
   /// Allocator that manages the memory of all the pieces of the SILModule.
   mutable llvm::BumpPtrAllocator BPA;
 
+  /// Free lists of recycled instruction chunks, bucketed by power-of-two
+  /// size class. allocateInst() carves fresh chunks out of \p BPA and
+  /// deallocateInst() threads dead ones here, so instruction memory stays
+  /// nearly contiguous within the allocator's slabs instead of being
+  /// scattered across individually malloc'ed blocks.
+  mutable void *InstFreeLists[8] = {};
+
   /// The swift Module associated with this SILModule.
   ModuleDecl *TheSwiftModule;
 
@@ -508,6 +515,11 @@ public:
   /// the declaration of a function.
   SILFunction *findFunction(StringRef Name, SILLinkage Linkage);
 
+  /// Attempt to deserialize the function with the given name and linkage,
+  /// including its body, from one of the imported serialized modules.
+  /// Returns the function already present in this module if there is one.
+  SILFunction *loadFunction(StringRef Name, SILLinkage Linkage);
+
   /// Check if a given function exists in any of the modules.
   /// i.e. it can be linked by linkFunction.
   bool hasFunction(StringRef Name);
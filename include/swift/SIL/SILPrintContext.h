@@ -24,6 +24,7 @@ class SILDebugScope;
 class SILInstruction;
 class SILFunction;
 class SILBasicBlock;
+struct PrintOptions;
 
 /// Used as context for the SIL print functions.
 class SILPrintContext {
@@ -56,6 +57,11 @@ protected:
 
   llvm::DenseMap<const SILDebugScope *, unsigned> ScopeToIDMap;
 
+  /// Cached textual forms of already-printed types. Textual SIL repeats the
+  /// same types constantly, and printing a type through the AST printer is
+  /// far more expensive than copying its cached text.
+  llvm::DenseMap<TypeBase *, std::string> TypeTextCache;
+
   /// Dump more information in the SIL output.
   bool Verbose;
   
@@ -94,6 +100,11 @@ public:
   /// Returns true if debug locations and scopes should be printed.
   bool printDebugInfo() const { return DebugInfo; }
 
+  /// Returns the textual form of \p Ty as printed with \p Options, caching
+  /// the text so repeated occurrences of the same type are not printed
+  /// through the AST printer again.
+  StringRef getTypeText(CanType Ty, const PrintOptions &Options);
+
   SILPrintContext::ID getID(const SILBasicBlock *Block);
 
   SILPrintContext::ID getID(const SILNode *node);
@@ -27,6 +27,7 @@
 #include "swift/SILOptimizer/Analysis/PostOrderAnalysis.h"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
 #include "swift/SILOptimizer/PassManager/PassManager.h"
+#include "llvm/ADT/Optional.h"
 
 namespace swift {
 
@@ -215,6 +216,12 @@ public:
 class EpilogueARCFunctionInfo {
   using ARCInstructions = llvm::SmallSetVector<SILInstruction *, 1>;
 
+  /// The function this summary describes.
+  SILFunction *F;
+
+  /// Current RC Identity analysis we are using.
+  RCIdentityAnalysis *RC;
+
   EpilogueARCContext Context;
 
   /// The epilogue retain cache.
@@ -223,17 +230,49 @@ class EpilogueARCFunctionInfo {
   /// The epilogue release cache.
   llvm::DenseMap<SILValue, ARCInstructions> EpilogueReleaseInstCache;
 
+  /// Stable storage for the conventions the cached matcher below is
+  /// constructed with; the matcher keeps an ArrayRef into this array.
+  const SILArgumentConvention OwnedArgConventions[1] = {
+      SILArgumentConvention::Direct_Owned};
+
+  /// Lazily built matcher from @owned function arguments to the epilogue
+  /// releases in the return block. Several passes used to rebuild this
+  /// per invocation; caching it here lets the pass manager's invalidation
+  /// mechanism keep a single copy up to date instead.
+  llvm::Optional<ConsumedArgToEpilogueReleaseMatcher>
+      OwnedArgToReturnReleaseMatcher;
+
+  /// Set when a deletion may have left stale instruction pointers in the
+  /// cached matcher; the next request recomputes it in place.
+  bool OwnedArgMatcherIsStale = false;
+
 public:
   void handleDeleteNotification(SILNode *node) {
     // Being conservative and clear everything for now.
     EpilogueRetainInstCache.clear();
     EpilogueReleaseInstCache.clear();
+    // The matcher may be referenced by the currently running pass, so keep
+    // its storage alive and recompute it lazily on the next request.
+    OwnedArgMatcherIsStale = true;
   }
 
   /// Constructor.
   EpilogueARCFunctionInfo(SILFunction *F, PostOrderAnalysis *PO,
                           AliasAnalysis *AA, RCIdentityAnalysis *RC)
-      : Context(F, PO, AA, RC) {}
+      : F(F), RC(RC), Context(F, PO, AA, RC) {}
+
+  /// Return the matcher mapping each @owned function argument to its
+  /// epilogue releases in the return block, computing it on first request
+  /// and recomputing only after a deletion invalidated the cached result.
+  ConsumedArgToEpilogueReleaseMatcher &getOwnedArgToReturnReleaseMatcher() {
+    if (!OwnedArgToReturnReleaseMatcher)
+      OwnedArgToReturnReleaseMatcher.emplace(RC->get(F), F,
+                                             OwnedArgConventions);
+    else if (OwnedArgMatcherIsStale)
+      OwnedArgToReturnReleaseMatcher->recompute();
+    OwnedArgMatcherIsStale = false;
+    return *OwnedArgToReturnReleaseMatcher;
+  }
 
   /// Find the epilogue ARC instruction based on the given \p Kind and given
   /// \p Arg.
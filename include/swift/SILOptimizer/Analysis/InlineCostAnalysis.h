@@ -0,0 +1,72 @@
+//===--- InlineCostAnalysis.h -----------------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This analysis caches the caller-independent part of the performance
+//  inliner's cost model: the summed instruction inline cost of a function
+//  body. The inliner consults this summary for every call site of a callee,
+//  so computing it once per function version instead of re-walking the body
+//  per call site saves a large amount of repeated work.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SILOPTIMIZER_ANALYSIS_INLINECOSTANALYSIS_H
+#define SWIFT_SILOPTIMIZER_ANALYSIS_INLINECOSTANALYSIS_H
+
+#include "swift/SILOptimizer/Analysis/Analysis.h"
+#include "llvm/ADT/Optional.h"
+
+namespace swift {
+
+class SILFunction;
+
+/// Lazily computed cost summary for a single function.
+class InlineCostFunctionInfo {
+  /// The function this summary describes.
+  SILFunction *F;
+
+  /// The sum of instructionInlineCost over the whole body. Computed on the
+  /// first request after each invalidation.
+  llvm::Optional<int> Cost;
+
+public:
+  InlineCostFunctionInfo(SILFunction *F) : F(F) {}
+
+  /// Return the total inlining cost of the function's body.
+  int getCost();
+};
+
+class InlineCostAnalysis
+    : public FunctionAnalysisBase<InlineCostFunctionInfo> {
+public:
+  InlineCostAnalysis(SILModule *)
+      : FunctionAnalysisBase<InlineCostFunctionInfo>(
+            AnalysisKind::InlineCost) {}
+
+  InlineCostAnalysis(const InlineCostAnalysis &) = delete;
+  InlineCostAnalysis &operator=(const InlineCostAnalysis &) = delete;
+
+  static bool classof(const SILAnalysis *S) {
+    return S->getKind() == AnalysisKind::InlineCost;
+  }
+
+  virtual InlineCostFunctionInfo *newFunctionAnalysis(SILFunction *F) override {
+    return new InlineCostFunctionInfo(F);
+  }
+
+  virtual bool shouldInvalidate(SILAnalysis::InvalidationKind K) override {
+    return K & InvalidationKind::Instructions;
+  }
+};
+
+} // end namespace swift
+
+#endif
@@ -15,6 +15,7 @@
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -93,6 +94,15 @@ class SILPassManager {
   /// Set to true when a pass invalidates an analysis.
   bool CurrentPassHasInvalidated = false;
 
+  /// The functions that were modified since they were last verified, as
+  /// reported through the analysis invalidation notifications. Used to
+  /// limit module verification to functions that actually changed.
+  llvm::SmallPtrSet<SILFunction *, 8> ModifiedFunctions;
+
+  /// Set to true by module-wide invalidations, after which the next module
+  /// verification has to look at every function again.
+  bool ModifiedAllFunctions = false;
+
   /// True if we need to stop running passes and restart again on the
   /// same function.
   bool RestartPipeline = false;
@@ -101,6 +111,10 @@ class SILPassManager {
   /// OptimizationMode::NoOptimization.
   bool isMandatoryPipeline = false;
 
+  /// Set to true once the pipeline named by -sil-resume-from-pipeline has
+  /// been reached. All pipelines before that point are skipped.
+  bool ReachedResumePipeline = false;
+
   /// The IRGen SIL passes. These have to be dynamically added by IRGen.
   llvm::DenseMap<unsigned, SILTransform *> IRGenPasses;
 
@@ -156,6 +170,7 @@ public:
         AP->invalidate();
 
     CurrentPassHasInvalidated = true;
+    ModifiedAllFunctions = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -174,6 +189,8 @@ public:
   void notifyAnalysisOfFunction(SILFunction *F) {
     for (auto AP : Analysis)
       AP->notifyAddFunction(F);
+
+    ModifiedFunctions.insert(F);
   }
 
   /// \brief Broadcast the invalidation of the function to all analysis.
@@ -183,8 +200,9 @@ public:
     for (auto AP : Analysis)
       if (!AP->isLocked())
         AP->invalidate(F, K);
-    
+
     CurrentPassHasInvalidated = true;
+    ModifiedFunctions.insert(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -198,6 +216,7 @@ public:
         AP->invalidateFunctionTables();
 
     CurrentPassHasInvalidated = true;
+    ModifiedAllFunctions = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -209,8 +228,9 @@ public:
     for (auto AP : Analysis)
       if (!AP->isLocked())
         AP->notifyDeleteFunction(F);
-    
+
     CurrentPassHasInvalidated = true;
+    ModifiedFunctions.erase(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -253,12 +273,15 @@ public:
 
   void executePassPipelinePlan(const SILPassPipelinePlan &Plan) {
     for (const SILPassPipeline &Pipeline : Plan.getPipelines()) {
+      if (shouldSkipPipelineBeforeResumePoint(Pipeline.Name))
+        continue;
       setStageName(Pipeline.Name);
       resetAndRemoveTransformations();
       for (PassKind Kind : Plan.getPipelinePasses(Pipeline)) {
         addPass(Kind);
       }
       execute();
+      checkpointAfterPipeline(Pipeline.Name);
     }
   }
 
@@ -282,6 +305,11 @@ private:
   /// Add a pass with a given name.
   void addPassForName(StringRef Name);
 
+  /// Verify the module after running a module pass. Unless a full sweep is
+  /// requested, this only re-verifies the functions that were modified
+  /// since they were last verified.
+  void verifyModule();
+
   /// Run the SIL module transform \p SMT over all the functions in
   /// the module.
   void runModulePass(SILModuleTransform *SMT);
@@ -298,6 +326,14 @@ private:
   /// options) whether we should continue running passes.
   bool continueTransforming();
 
+  /// Returns true if the pipeline \p PipelineName should be skipped because
+  /// the -sil-resume-from-pipeline point has not been reached yet.
+  bool shouldSkipPipelineBeforeResumePoint(StringRef PipelineName);
+
+  /// Serializes the module if \p PipelineName matches the
+  /// -sil-checkpoint-after-pipeline option.
+  void checkpointAfterPipeline(StringRef PipelineName);
+
   /// Return true if all analyses are unlocked.
   bool analysesUnlocked();
 
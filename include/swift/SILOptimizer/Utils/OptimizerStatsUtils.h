@@ -18,6 +18,12 @@ class SILModule;
 class SILTransform;
 class SILPassManager;
 
+/// Returns true if any of the sil-stats-* options that drive
+/// updateSILModuleStatsBeforeTransform/updateSILModuleStatsAfterTransform
+/// is enabled. Callers can use this to avoid collecting inputs (e.g. pass
+/// durations) that would be thrown away.
+bool optimizerStatsEnabled();
+
 /// Updates SILModule stats before executing the transform \p Transform.
 ///
 /// \param M SILModule to be processed
@@ -26,6 +26,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Bitcode/BitstreamReader.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
 
@@ -280,30 +281,83 @@ public:
     }
   };
 
+  /// An offset table that is decoded from the module file on first access.
+  ///
+  /// Until then the table is backed by the module's own memory buffer,
+  /// which is normally a read-only file mapping whose clean pages the OS
+  /// shares between every concurrent process loading the same module.
+  template <typename T>
+  class LazyOffsetTable {
+    /// The raw little-endian uint32 offsets, pointing into the module's
+    /// memory buffer.
+    StringRef RawData;
+
+    /// The decoded entries. Populated from \c RawData on first subscript.
+    std::vector<T> Table;
+
+    bool IsMaterialized = false;
+
+    void materialize() {
+      size_t count = RawData.size() / sizeof(uint32_t);
+      Table.reserve(count);
+      auto data = reinterpret_cast<const uint8_t *>(RawData.data());
+      while (count--)
+        Table.emplace_back(llvm::support::endian::readNext<
+            uint32_t, llvm::support::little, llvm::support::unaligned>(data));
+      IsMaterialized = true;
+    }
+
+  public:
+    void setRawData(StringRef rawData) {
+      assert(!IsMaterialized && "already materialized");
+      assert(rawData.size() % sizeof(uint32_t) == 0);
+      RawData = rawData;
+    }
+
+    size_t size() const {
+      return IsMaterialized ? Table.size() : RawData.size() / sizeof(uint32_t);
+    }
+
+    T &operator[](size_t i) {
+      if (!IsMaterialized)
+        materialize();
+      return Table[i];
+    }
+
+    /// Iteration only visits entries that have been materialized; an
+    /// untouched table has, by definition, nothing deserialized in it.
+    typename std::vector<T>::const_iterator begin() const {
+      return Table.begin();
+    }
+    typename std::vector<T>::const_iterator end() const {
+      return Table.end();
+    }
+  };
+
 private:
   /// Decls referenced by this module.
-  std::vector<Serialized<Decl*>> Decls;
+  LazyOffsetTable<Serialized<Decl*>> Decls;
 
   /// DeclContexts referenced by this module.
-  std::vector<Serialized<DeclContext*>> DeclContexts;
+  LazyOffsetTable<Serialized<DeclContext*>> DeclContexts;
 
   /// Local DeclContexts referenced by this module.
-  std::vector<Serialized<DeclContext*>> LocalDeclContexts;
+  LazyOffsetTable<Serialized<DeclContext*>> LocalDeclContexts;
 
   /// Normal protocol conformances referenced by this module.
-  std::vector<Serialized<NormalProtocolConformance *>> NormalConformances;
+  LazyOffsetTable<Serialized<NormalProtocolConformance *>> NormalConformances;
 
   /// SILLayouts referenced by this module.
-  std::vector<Serialized<SILLayout *>> SILLayouts;
+  LazyOffsetTable<Serialized<SILLayout *>> SILLayouts;
 
   /// Types referenced by this module.
-  std::vector<Serialized<Type>> Types;
+  LazyOffsetTable<Serialized<Type>> Types;
 
   /// Generic signatures referenced by this module.
-  std::vector<Serialized<GenericSignature *>> GenericSignatures;
+  LazyOffsetTable<Serialized<GenericSignature *>> GenericSignatures;
 
   /// Generic environments referenced by this module.
-  std::vector<Serialized<GenericEnvironment *>> GenericEnvironments;
+  LazyOffsetTable<Serialized<GenericEnvironment *>> GenericEnvironments;
 
   /// Represents an identifier that may or may not have been deserialized yet.
   ///
@@ -321,7 +375,7 @@ private:
   };
 
   /// Identifiers referenced by this module.
-  std::vector<SerializedIdentifier> Identifiers;
+  LazyOffsetTable<SerializedIdentifier> Identifiers;
 
   class DeclTableInfo;
   using SerializedDeclTable =
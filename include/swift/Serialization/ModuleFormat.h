@@ -54,7 +54,7 @@ const uint16_t VERSION_MAJOR = 0;
 /// in source control, you should also update the comment to briefly
 /// describe what change you made. The content of this comment isn't important;
 /// it just ensures a conflict if two people change the module format.
-const uint16_t VERSION_MINOR = 389; // Last change: don't serialize 'self'
+const uint16_t VERSION_MINOR = 393; // Last change: module content hash
 
 using DeclIDField = BCFixed<31>;
 
@@ -494,7 +494,8 @@ namespace control_block {
   enum {
     METADATA = 1,
     MODULE_NAME,
-    TARGET
+    TARGET,
+    CONTENT_HASH
   };
 
   using MetadataLayout = BCRecordLayout<
@@ -515,6 +516,11 @@ namespace control_block {
     TARGET,
     BCBlob // LLVM triple
   >;
+
+  using ContentHashLayout = BCRecordLayout<
+    CONTENT_HASH,
+    BCBlob // MD5 digest of everything serialized after this record
+  >;
 }
 
 /// The record types within the options block (a sub-block of the control
@@ -1329,7 +1335,7 @@ namespace decls_block {
   using SemanticsDeclAttrLayout = BCRecordLayout<
     Semantics_DECL_ATTR,
     BCFixed<1>, // implicit flag
-    BCBlob      // semantics value
+    IdentifierIDField // semantics value
   >;
 
   using EffectsDeclAttrLayout = BCRecordLayout<
@@ -1553,7 +1559,7 @@ namespace index_block {
 
   using OffsetsLayout = BCGenericRecordLayout<
     RecordIDField, // record ID
-    BCArray<BitOffsetField>
+    BCBlob // fixed-width little-endian offsets, referenced in place
   >;
 
   using DeclListLayout = BCGenericRecordLayout<
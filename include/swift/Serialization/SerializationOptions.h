@@ -38,6 +38,7 @@ namespace swift {
     bool AutolinkForceLoad = false;
     bool EnableNestedTypeLookupTable = false;
     bool SerializeAllSIL = false;
+    bool SerializePublicSILDeclarations = false;
     bool SerializeOptionsForDebugging = false;
     bool IsSIB = false;
   };
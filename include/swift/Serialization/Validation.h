@@ -71,6 +71,11 @@ struct ValidationInfo {
   StringRef name = {};
   StringRef targetTriple = {};
   StringRef shortVersion = {};
+  /// An MD5 digest of every byte serialized after the hash record itself,
+  /// or empty for module files predating the record. Two module files with
+  /// equal hashes are semantically interchangeable, no matter when or where
+  /// they were built.
+  StringRef contentHash = {};
   version::Version compatibilityVersion = {};
   size_t bytes = 0;
   Status status = Status::Malformed;
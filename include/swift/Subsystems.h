@@ -87,7 +87,12 @@ namespace swift {
   ///
   /// "Well-formed" here means following the invariants of the AST, not that the
   /// code written by the user makes sense.
-  void verify(SourceFile &SF);
+  ///
+  /// \param StartElem The index of the first top-level declaration to
+  /// verify. Callers that check a file incrementally (e.g. the REPL) pass
+  /// the number of declarations already verified in a previous pass so only
+  /// the new ones are walked again.
+  void verify(SourceFile &SF, unsigned StartElem = 0);
   void verify(Decl *D);
 
   /// @}
@@ -30,6 +30,7 @@
 #define SWIFT_SYNTAX_RAWSYNTAX_H
 
 #include "swift/Syntax/References.h"
+#include "swift/Syntax/SyntaxArena.h"
 #include "swift/Syntax/SyntaxKind.h"
 #include "swift/Syntax/Trivia.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
@@ -37,6 +38,8 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <atomic>
+#include <new>
 #include <vector>
 
 using llvm::cast;
@@ -193,10 +196,38 @@ struct SyntaxPrintOptions {
 /// RawSyntax - the strictly immutable, shared backing nodes for all syntax.
 ///
 /// This is implementation detail - do not expose it in public API.
-struct RawSyntax : public llvm::ThreadSafeRefCountedBase<RawSyntax> {
+struct RawSyntax {
 
   using LayoutList = std::vector<RC<RawSyntax>>;
 
+protected:
+  /// The number of outstanding references to this node when it is
+  /// individually heap-allocated; unused for arena-allocated nodes.
+  mutable std::atomic<int> RefCount{0};
+
+  /// The arena whose lifetime this node is tied to, or null if the node is
+  /// individually heap-allocated and reference counted.
+  SyntaxArena *Arena = nullptr;
+
+public:
+  /// Part of the IntrusiveRefCntPtr interface. Nodes inside a SyntaxArena
+  /// skip reference counting entirely; it is up to whoever created the
+  /// arena-backed tree to keep the arena alive for as long as any of its
+  /// nodes is referenced.
+  void Retain() const {
+    if (!Arena)
+      ++RefCount;
+  }
+
+  /// Part of the IntrusiveRefCntPtr interface; see Retain().
+  void Release() const {
+    if (!Arena && --RefCount == 0)
+      delete this;
+  }
+
+  /// Whether this node's memory is owned by a SyntaxArena.
+  bool isArenaAllocated() const { return Arena != nullptr; }
+
   /// The kind of syntax this node represents.
   const SyntaxKind Kind;
 
@@ -221,6 +252,18 @@ struct RawSyntax : public llvm::ThreadSafeRefCountedBase<RawSyntax> {
     return RC<RawSyntax>{new RawSyntax{Kind, Layout, Presence}};
   }
 
+  /// Returns a raw syntax node allocated in the given arena. Its lifetime is
+  /// tied to the arena, not to a reference count.
+  static RC<RawSyntax> make(const SyntaxKind Kind, const LayoutList Layout,
+                            const SourcePresence Presence,
+                            const RC<SyntaxArena> &Arena) {
+    void *Mem = Arena->allocate(sizeof(RawSyntax), alignof(RawSyntax));
+    auto *Node = new (Mem) RawSyntax{Kind, Layout, Presence};
+    Node->Arena = Arena.get();
+    Arena->registerNode(Node);
+    return RC<RawSyntax>{Node};
+  }
+
   /// Returns a raw syntax node of the given Kind, marked as missing.
   static RC<RawSyntax> missing(const SyntaxKind Kind) {
     return make(Kind, {}, SourcePresence::Missing);
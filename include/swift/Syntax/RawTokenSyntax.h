@@ -63,6 +63,22 @@ public:
     };
   }
 
+  /// Make a new token allocated in the given arena. Its lifetime is tied to
+  /// the arena, not to a reference count.
+  static RC<RawTokenSyntax> make(tok TokenKind, OwnedString Text,
+                                 const SourcePresence Presence,
+                                 const Trivia &LeadingTrivia,
+                                 const Trivia &TrailingTrivia,
+                                 const RC<SyntaxArena> &Arena) {
+    void *Mem = Arena->allocate(sizeof(RawTokenSyntax),
+                                alignof(RawTokenSyntax));
+    auto *Node = new (Mem) RawTokenSyntax{TokenKind, Text, Presence,
+                                          LeadingTrivia, TrailingTrivia};
+    Node->Arena = Arena.get();
+    Arena->registerNode(Node);
+    return RC<RawTokenSyntax>{Node};
+  }
+
   /// Return a token with the specified kind and text, but marked as missing.
   static RC<RawTokenSyntax> missingToken(const tok Kind, OwnedString Text) {
     return make(Kind, Text, SourcePresence::Missing, {}, {});
@@ -0,0 +1,67 @@
+//===--- SyntaxArena.h - Arena for RawSyntax nodes --------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SYNTAX_SYNTAXARENA_H
+#define SWIFT_SYNTAX_SYNTAXARENA_H
+
+#include "swift/Syntax/References.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/Support/Allocator.h"
+#include <vector>
+
+namespace swift {
+namespace syntax {
+
+struct RawSyntax;
+
+/// A memory region backing the RawSyntax nodes of a single tree.
+///
+/// Nodes allocated in an arena are not individually reference counted:
+/// Retain and Release on them are no-ops, and their memory is reclaimed all
+/// at once when the arena goes away. The arena itself is reference counted,
+/// so a client keeps exactly one count alive -- typically next to the
+/// reference to the tree root -- and interior structure sharing within the
+/// tree costs neither mallocs nor atomic reference count operations.
+class SyntaxArena : public llvm::ThreadSafeRefCountedBase<SyntaxArena> {
+  llvm::BumpPtrAllocator Allocator;
+
+  /// The nodes allocated in this arena. The allocator does not run
+  /// destructors, and nodes own out-of-line storage (layout vectors and
+  /// trivia), so the arena destructs them explicitly when it dies.
+  std::vector<const RawSyntax *> AllocatedNodes;
+
+  SyntaxArena(const SyntaxArena &) = delete;
+  void operator=(const SyntaxArena &) = delete;
+
+public:
+  SyntaxArena() = default;
+  ~SyntaxArena();
+
+  static RC<SyntaxArena> make() { return RC<SyntaxArena>{new SyntaxArena()}; }
+
+  /// Allocate memory for a node. Only for use by the RawSyntax creation
+  /// methods; every allocation must be followed by a registerNode() call.
+  void *allocate(size_t Bytes, size_t Alignment) {
+    return Allocator.Allocate(Bytes, Alignment);
+  }
+
+  /// Register a node constructed in this arena's memory so that its
+  /// destructor runs when the arena is freed.
+  void registerNode(const RawSyntax *Node) {
+    AllocatedNodes.push_back(Node);
+  }
+};
+
+} // end namespace syntax
+} // end namespace swift
+
+#endif // SWIFT_SYNTAX_SYNTAXARENA_H
@@ -0,0 +1,110 @@
+//===----------- SyntaxParsingCache.h -==============------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SYNTAX_PARSING_CACHE_H
+#define SWIFT_SYNTAX_PARSING_CACHE_H
+
+#include "swift/Syntax/SyntaxNodes.h"
+#include "llvm/ADT/Optional.h"
+#include <vector>
+
+namespace swift {
+namespace syntax {
+
+/// A textual edit to a source file, described in terms of the file contents
+/// *before* the edit was applied.
+struct SourceEdit {
+  /// The byte offset from which on the text was replaced.
+  size_t Start;
+
+  /// The byte offset to which on the text was replaced.
+  size_t End;
+
+  /// The length of the text that replaced the range described above.
+  size_t ReplacementLength;
+
+  /// The length of the range that has been replaced.
+  size_t originalLength() const { return End - Start; }
+
+  /// Check if the characters replaced by this edit fall into the given range
+  /// or are directly adjacent to it.
+  bool intersectsOrTouchesRange(size_t RangeStart, size_t RangeEnd) const {
+    return End >= RangeStart && Start <= RangeEnd;
+  }
+};
+
+/// Hands out unmodified RawSyntax subtrees of a previous parse of a source
+/// file so that a subsequent parse of the edited file can reuse them.
+/// RawSyntax nodes are immutable and shared by reference, so reusing a
+/// subtree is a matter of retaining the old node; no copying is involved.
+class SyntaxParsingCache {
+  /// The syntax tree prior to the edits.
+  SourceFileSyntax OldSyntaxTree;
+
+  /// The edits that were made between the source file the old syntax tree
+  /// was created from and the source file that is now being parsed, in the
+  /// order they were applied.
+  std::vector<SourceEdit> Edits;
+
+  /// The number of lookups that returned a reusable node.
+  unsigned ReuseHits = 0;
+
+  /// The number of lookups for which no node could be reused.
+  unsigned ReuseMisses = 0;
+
+public:
+  explicit SyntaxParsingCache(SourceFileSyntax OldSyntaxTree)
+      : OldSyntaxTree(OldSyntaxTree) {}
+
+  /// Record an edit of the source file this cache's tree was created from.
+  /// \p Start and \p End are offsets into the pre-edit file; \p
+  /// ReplacementLength is the length of the text the range was replaced
+  /// with. Edits must be added in the order they were applied.
+  void addEdit(size_t Start, size_t End, size_t ReplacementLength) {
+    Edits.push_back({Start, End, ReplacementLength});
+  }
+
+  /// Look up a node of the given kind that starts at the given byte offset
+  /// of the *edited* source file. Returns null if no node from the old tree
+  /// can be reused at that position, either because an edit damaged it or
+  /// because no node of that kind started there.
+  RC<RawSyntax> lookUp(size_t NewPosition, SyntaxKind Kind);
+
+  unsigned getReuseHits() const { return ReuseHits; }
+  unsigned getReuseMisses() const { return ReuseMisses; }
+
+  /// Returns the length, in bytes, of the text covered by the given node,
+  /// including its tokens' leading and trailing trivia.
+  static size_t getNodeTextLength(const RC<RawSyntax> &Node);
+
+private:
+  /// Translate a position in the edited file to the corresponding position
+  /// in the pre-edit file, or None if the position lies inside replaced
+  /// text.
+  llvm::Optional<size_t> translateToPreEditPosition(size_t Position) const;
+
+  /// Whether the node starting at \p NodeStart (a pre-edit offset) may be
+  /// reused for a node of \p Kind at the translated lookup position.
+  bool nodeCanBeReused(const RC<RawSyntax> &Node, size_t NodeStart,
+                       size_t Position, SyntaxKind Kind) const;
+
+  /// Descend through \p Node looking for a reusable node of \p Kind at the
+  /// pre-edit offset \p Position. \p NodeStart is the pre-edit offset at
+  /// which \p Node starts.
+  RC<RawSyntax> lookUpFrom(const RC<RawSyntax> &Node, size_t NodeStart,
+                           size_t Position, SyntaxKind Kind) const;
+};
+
+} // end namespace syntax
+} // end namespace swift
+
+#endif // SWIFT_SYNTAX_PARSING_CACHE_H
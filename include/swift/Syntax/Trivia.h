@@ -80,10 +80,9 @@
 #define SWIFT_SYNTAX_TRIVIA_H
 
 #include "swift/Basic/OwnedString.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/raw_ostream.h"
 
-#include <vector>
-
 namespace swift {
 namespace syntax {
 
@@ -204,7 +203,11 @@ struct TriviaPiece {
   }
 };
 
-using TriviaList = std::vector<TriviaPiece>;
+/// Most tokens carry no more than a couple of trivia pieces (for example,
+/// a newline and the following indentation as leading trivia, and a single
+/// space as trailing trivia), so keep that many inline to avoid a heap
+/// allocation on each side of every token.
+using TriviaList = llvm::SmallVector<TriviaPiece, 2>;
 
 /// A collection of leading or trailing trivia. This is the main data structure
 /// for thinking about trivia.
@@ -28,8 +28,11 @@ void enumeratePublicSymbols(FileUnit *module, llvm::StringSet<> &symbols,
 void enumeratePublicSymbols(ModuleDecl *module, llvm::StringSet<> &symbols,
                             bool hasMultipleIRGenThreads);
 
-void writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os,
-                  bool hasMultipleIRGenThreads,
+/// Emit a TBD file to \p os, populating \p symbols with the public symbols
+/// it lists so callers can reuse the set (e.g. for validation against IR)
+/// without walking the AST a second time.
+void writeTBDFile(ModuleDecl *M, llvm::StringSet<> &symbols,
+                  llvm::raw_ostream &os, bool hasMultipleIRGenThreads,
                   llvm::StringRef installName);
 
 } // end namespace swift
@@ -43,11 +43,13 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/Mutex.h"
 #include <algorithm>
 #include <memory>
 
@@ -91,6 +93,18 @@ namespace {
     Import = 1 << 0,
     Framework = 1 << 1
   };
+
+  /// A uniqued copy of a substitution list, kept in a per-arena folding set
+  /// so identical lists share one allocation.
+  struct UniquedSubstitutionList : public llvm::FoldingSetNode {
+    SubstitutionList Subs;
+
+    explicit UniquedSubstitutionList(SubstitutionList subs) : Subs(subs) {}
+
+    void Profile(llvm::FoldingSetNodeID &id) const {
+      profileSubstitutionList(id, Subs);
+    }
+  };
 } // end anonymous namespace
 
 using AssociativityCacheType =
@@ -114,7 +128,24 @@ struct ASTContext::Implementation {
   /// The last resolver.
   LazyResolver *Resolver = nullptr;
 
-  llvm::StringMap<char, llvm::BumpPtrAllocator&> IdentifierTable;
+  /// The number of shards the identifier table is split into.  Must be a
+  /// power of two.
+  enum { NumIdentifierShards = 8 };
+
+  /// One shard of the identifier table, with its own map, string storage,
+  /// and lock.  Identifier interning is sharded by string hash so that
+  /// phases which run on multiple threads (such as multi-threaded IRGen)
+  /// can intern names concurrently without funneling through a single
+  /// lock, while preserving the pointer-identity contract of Identifier:
+  /// a given string always lands in the same shard.  The locks are
+  /// SmartMutexes, so single-threaded compilations pay almost nothing.
+  struct IdentifierTableShard {
+    llvm::BumpPtrAllocator Allocator;
+    llvm::StringMap<char, llvm::BumpPtrAllocator &> Table;
+    llvm::sys::SmartMutex<true> Mutex;
+    IdentifierTableShard() : Table(Allocator) {}
+  };
+  IdentifierTableShard IdentifierTableShards[NumIdentifierShards];
 
   /// The declaration of Swift.AssignmentPrecedence.
   PrecedenceGroupDecl *AssignmentPrecedence = nullptr;
@@ -226,12 +257,18 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   /// \brief The module loader used to load Clang modules.
   ClangModuleLoader *TheClangModuleLoader = nullptr;
 
+  /// \brief Cached module-scope lookups into modules without source files.
+  namelookup::ModuleScopeLookupCache ModuleScopeLookups;
+
   /// \brief Map from Swift declarations to raw comments.
   llvm::DenseMap<const Decl *, RawComment> RawComments;
 
   /// \brief Map from Swift declarations to brief comments.
   llvm::DenseMap<const Decl *, StringRef> BriefComments;
 
+  /// \brief Map from Swift declarations to their generated USR strings.
+  llvm::DenseMap<const ValueDecl *, StringRef> USRs;
+
   /// \brief Map from local declarations to their discriminators.
   /// Missing entries implicitly have value 0.
   llvm::DenseMap<const ValueDecl *, unsigned> LocalDiscriminators;
@@ -318,6 +355,9 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
     /// The set of inherited protocol conformances.
     llvm::FoldingSet<InheritedProtocolConformance> InheritedConformances;
 
+    /// The set of uniqued substitution lists.
+    llvm::FoldingSet<UniquedSubstitutionList> SubstitutionLists;
+
     ~Arena() {
       for (auto &conformance : SpecializedConformances)
         conformance.~SpecializedProtocolConformance();
@@ -408,8 +448,7 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   llvm::FoldingSet<SILLayout> SILLayouts;
 };
 
-ASTContext::Implementation::Implementation()
- : IdentifierTable(Allocator) {}
+ASTContext::Implementation::Implementation() {}
 ASTContext::Implementation::~Implementation() {
   for (auto &cleanup : Cleanups)
     cleanup();
@@ -527,10 +566,18 @@ Identifier ASTContext::getIdentifier(StringRef Str) const {
   if (Str.data() == nullptr)
     return Identifier(nullptr);
 
-  auto I = Impl.IdentifierTable.insert(std::make_pair(Str, char())).first;
+  auto &Shard = Impl.IdentifierTableShards[
+      llvm::hash_value(Str) & (Implementation::NumIdentifierShards - 1)];
+  llvm::sys::SmartScopedLock<true> Lock(Shard.Mutex);
+  auto I = Shard.Table.insert(std::make_pair(Str, char())).first;
   return Identifier(I->getKeyData());
 }
 
+namelookup::ModuleScopeLookupCache &
+ASTContext::getModuleScopeLookupCache() const {
+  return Impl.ModuleScopeLookups;
+}
+
 void ASTContext::lookupInSwiftModule(
                    StringRef name,
                    SmallVectorImpl<ValueDecl *> &results) const {
@@ -1533,8 +1580,14 @@ GenericSignatureBuilder *ASTContext::getOrCreateGenericSignatureBuilder(
   // Check whether we already have a generic signature builder for this
   // signature and module.
   auto known = Impl.GenericSignatureBuilders.find(sig);
-  if (known != Impl.GenericSignatureBuilders.end())
+  if (known != Impl.GenericSignatureBuilders.end()) {
+    if (Stats)
+      Stats->getFrontendCounters().NumGenericSignatureBuilderHits++;
     return known->second.get();
+  }
+
+  if (Stats)
+    Stats->getFrontendCounters().NumGenericSignatureBuilderMisses++;
 
   // Create a new generic signature builder with the given signature.
   auto builder = new GenericSignatureBuilder(*this);
@@ -1834,6 +1887,18 @@ void ASTContext::setBriefComment(const Decl *D, StringRef Comment) {
   Impl.BriefComments[D] = Comment;
 }
 
+Optional<StringRef> ASTContext::getUSR(const ValueDecl *VD) const {
+  auto Known = Impl.USRs.find(VD);
+  if (Known == Impl.USRs.end())
+    return None;
+
+  return Known->second;
+}
+
+void ASTContext::setUSR(const ValueDecl *VD, StringRef USR) {
+  Impl.USRs[VD] = AllocateCopy(USR);
+}
+
 unsigned ValueDecl::getLocalDiscriminator() const {
   assert(getDeclContext()->isLocalContext());
   auto &discriminators = getASTContext().Impl.LocalDiscriminators;
@@ -1954,7 +2019,7 @@ ASTContext::getSpecializedConformance(Type type,
     return result;
 
   // Build a new specialized conformance.
-  substitutions = AllocateCopy(substitutions, arena);
+  substitutions = getUniquedSubstitutionList(substitutions);
   auto result
     = new (*this, arena) SpecializedProtocolConformance(type, generic,
                                                         substitutions);
@@ -1962,6 +2027,32 @@ ASTContext::getSpecializedConformance(Type type,
   return result;
 }
 
+SubstitutionList ASTContext::getUniquedSubstitutionList(SubstitutionList subs) {
+  if (subs.empty())
+    return subs;
+
+  llvm::FoldingSetNodeID id;
+  profileSubstitutionList(id, subs);
+
+  // Figure out which arena the storage should go into, based on the
+  // replacement types.
+  RecursiveTypeProperties properties;
+  for (const auto &sub : subs)
+    properties |= sub.getReplacement()->getRecursiveProperties();
+  AllocationArena arena = getArena(properties);
+
+  // Did we already record this substitution list?
+  void *insertPos;
+  auto &uniquedLists = Impl.getArena(arena).SubstitutionLists;
+  if (auto *existing = uniquedLists.FindNodeOrInsertPos(id, insertPos))
+    return existing->Subs;
+
+  auto *uniqued = new (*this, arena)
+      UniquedSubstitutionList(AllocateCopy(subs, arena));
+  uniquedLists.InsertNode(uniqued, insertPos);
+  return uniqued->Subs;
+}
+
 ProtocolConformance *
 ASTContext::getSpecializedConformance(Type type,
                                       ProtocolConformance *generic,
@@ -2110,6 +2201,9 @@ size_t ASTContext::getTotalMemory() const {
     Impl.OpenedExistentialArchetypes.getMemorySize() +
     Impl.Permanent.getTotalMemory();
 
+    for (const auto &Shard : Impl.IdentifierTableShards)
+      Size += Shard.Allocator.getTotalMemory();
+
     Size += getSolverMemory();
 
     return Size;
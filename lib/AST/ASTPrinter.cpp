@@ -129,11 +129,14 @@ ValueDecl* ASTPrinter::findConformancesWithDocComment(ValueDecl *VD) {
 void ASTPrinter::anchor() {}
 
 void ASTPrinter::printIndent() {
-  llvm::SmallString<16> Str;
-  for (unsigned i = 0; i != CurrentIndentation; ++i)
-    Str += ' ';
-
-  printText(Str);
+  // Print from a constant run of spaces instead of materializing a string
+  // for every line; interface generation prints one indent per line.
+  static const char Spaces[] = "                                ";
+  for (unsigned N = CurrentIndentation; N > 0;) {
+    unsigned Chunk = std::min(N, unsigned(sizeof(Spaces) - 1));
+    printText(StringRef(Spaces, Chunk));
+    N -= Chunk;
+  }
 }
 
 void ASTPrinter::printTextImpl(StringRef Text) {
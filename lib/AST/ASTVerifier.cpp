@@ -34,6 +34,7 @@
 #include "llvm/ADT/SmallBitVector.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/SaveAndRestore.h"
 #include "llvm/Support/raw_ostream.h"
 #include <functional>
 #include <type_traits>
@@ -3417,10 +3418,19 @@ public:
   };
 } // end anonymous namespace
 
-void swift::verify(SourceFile &SF) {
+void swift::verify(SourceFile &SF, unsigned StartElem) {
 #if !(defined(NDEBUG) || defined(SWIFT_DISABLE_AST_VERIFIER))
   Verifier verifier(SF, &SF);
-  SF.walk(verifier);
+  // Walk each top-level declaration separately rather than walking the
+  // whole file: the verifier carries no state from one to the next, which
+  // lets incremental callers skip the declarations a previous pass has
+  // already verified.
+  llvm::SaveAndRestore<ASTWalker::ParentTy> parent(verifier.Parent,
+                                                   SF.getParentModule());
+  for (Decl *D : llvm::makeArrayRef(SF.Decls).slice(StartElem)) {
+    PrettyStackTraceDecl debugStack("verifying decl", D);
+    D->walk(verifier);
+  }
 #endif
 }
 
@@ -542,6 +542,25 @@ void ConformanceLookupTable::expandImpliedConformances(NominalTypeDecl *nominal,
   }
 }
 
+bool ConformanceLookupTable::expansionMayIntroduce(NominalTypeDecl *nominal,
+                                                   ProtocolDecl *protocol) {
+  // An @objc enum that conforms to Error also picks up a conformance to a
+  // known protocol during expansion; don't try to predict that here.
+  if (isa<EnumDecl>(nominal) && nominal->isObjC())
+    return true;
+
+  // Otherwise, expansion only introduces conformances to protocols
+  // inherited (transitively) by the ones already recorded. The inherited
+  // sets are cached on the protocols themselves, so this is far cheaper
+  // than expanding entries for every protocol this type conforms to.
+  for (const auto &conformance : Conformances) {
+    for (auto *inherited : conformance.first->getAllProtocols())
+      if (inherited == protocol)
+        return true;
+  }
+  return false;
+}
+
 /// Determine whether the given conformance entry kind can be replaced.
 static bool isReplaceable(ConformanceEntryKind kind) {
   switch (kind) {
@@ -929,7 +948,14 @@ bool ConformanceLookupTable::lookupConformance(
   // Look for conformances to this protocol.
   auto known = Conformances.find(protocol);
   if (known == Conformances.end()) {
-    // If we didn't find anything, expand implied conformances.
+    // If we didn't find anything, expand implied conformances — but only
+    // if expansion could actually introduce an entry for this protocol.
+    // Negative queries are common, and answering them from the protocols'
+    // cached inheritance sets avoids eagerly expanding the type's entire
+    // conformance table.
+    if (!expansionMayIntroduce(nominal, protocol))
+      return false;
+
     updateLookupTable(nominal, ConformanceStage::ExpandedImplied, resolver);
     known = Conformances.find(protocol);
 
@@ -358,6 +358,15 @@ class ConformanceLookupTable {
   Ordering compareConformances(ConformanceEntry *lhs, ConformanceEntry *rhs,
                                bool &diagnoseSuperseded);
 
+  /// Determine whether expanding the implied conformances
+  /// (ConformanceStage::ExpandedImplied) could possibly introduce a
+  /// conformance to the given protocol that is not already recorded.
+  ///
+  /// This is used to answer negative lookupConformance() queries without
+  /// paying for expansion of every conformance of the type.
+  bool expansionMayIntroduce(NominalTypeDecl *nominal,
+                             ProtocolDecl *protocol);
+
   /// Resolve the set of conformances that will be generated for the
   /// given protocol.
   ///
@@ -675,6 +675,15 @@ void DiagnosticEngine::emitDiagnostic(const Diagnostic &diagnostic) {
   if (behavior == DiagnosticState::Behavior::Ignore)
     return;
 
+  // If nothing will receive the diagnostic, don't compute a location for
+  // it. That work can be substantial: for a diagnostic pointing at an
+  // imported declaration with no source location, it pretty-prints the
+  // declaration into a synthesized buffer. The behavior bookkeeping above
+  // (error counts, fatality) still happened, which is all a consumer-less
+  // engine is used for.
+  if (Consumers.empty())
+    return;
+
   // Figure out the source location.
   SourceLoc loc = diagnostic.getLoc();
   if (loc.isInvalid() && diagnostic.getDecl()) {
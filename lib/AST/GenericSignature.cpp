@@ -283,10 +283,18 @@ GenericSignature::getCanonicalSignature() const {
 
     // Record either the canonical signature or an indication that
     // this is the canonical signature.
-    if (canSig != this)
+    if (canSig != this) {
       CanonicalSignatureOrASTContext = canSig;
-    else
+
+      // The computed signature is canonical by construction. Record that on
+      // the signature itself, so that asking it for its canonical signature
+      // later does not re-canonicalize all of its requirements.
+      if (canSig->CanonicalSignatureOrASTContext.isNull())
+        canSig->CanonicalSignatureOrASTContext =
+            &canSig->getGenericParams()[0]->getASTContext();
+    } else {
       CanonicalSignatureOrASTContext = &getGenericParams()[0]->getASTContext();
+    }
 
     // Return the canonical signature.
     return canSig;
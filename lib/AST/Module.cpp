@@ -119,12 +119,26 @@ class SourceFile::LookupCache {
   class DeclMap {
     llvm::DenseMap<DeclName, TinyPtrVector<ValueDecl*>> Members;
 
+    void removeFromEntry(DeclName Name, ValueDecl *VD) {
+      auto I = Members.find(Name);
+      if (I == Members.end()) return;
+      auto &Vec = I->second;
+      Vec.erase(std::remove(Vec.begin(), Vec.end(), VD), Vec.end());
+    }
+
   public:
     void add(ValueDecl *VD) {
       if (!VD->hasName()) return;
       VD->getFullName().addToLookupTable(Members, VD);
     }
 
+    void remove(ValueDecl *VD) {
+      if (!VD->hasName()) return;
+      removeFromEntry(VD->getFullName(), VD);
+      if (!VD->getFullName().isSimpleName())
+        removeFromEntry(VD->getFullName().getBaseName(), VD);
+    }
+
     void clear() {
       Members.shrink_and_clear();
     }
@@ -140,9 +154,17 @@ class SourceFile::LookupCache {
   DeclMap ClassMembers;
   bool MemberCachePopulated = false;
 
+  /// The number of leading elements of SourceFile::Decls that have been
+  /// indexed, allowing newly parsed declarations to be added to the cache
+  /// without rebuilding it.
+  unsigned NumDeclsIndexed = 0;
+
   template<typename Range>
   void doPopulateCache(Range decls, bool onlyOperators);
+  template<typename Range>
+  void doUnpopulateCache(Range decls, bool onlyOperators);
   void addToMemberCache(DeclRange decls);
+  void removeFromMemberCache(DeclRange decls);
   void populateMemberCache(const SourceFile &SF);
 public:
   typedef ModuleDecl::AccessPathTy AccessPathTy;
@@ -151,7 +173,15 @@ public:
 
   /// Throw away as much memory as possible.
   void invalidate();
-  
+
+  /// Index declarations parsed into \p SF since the cache was built or last
+  /// updated.
+  void addNewDecls(const SourceFile &SF);
+
+  /// Unindex the trailing \p decls of the file, which the caller is about to
+  /// remove, leaving \p remainingDecls declarations indexed.
+  void removeDecls(ArrayRef<Decl *> decls, unsigned remainingDecls);
+
   void lookupValue(AccessPathTy AccessPath, DeclName Name,
                    NLKind LookupKind, SmallVectorImpl<ValueDecl*> &Result);
   
@@ -224,9 +254,100 @@ void SourceLookupCache::addToMemberCache(DeclRange decls) {
   }
 }
 
+template<typename Range>
+void SourceLookupCache::doUnpopulateCache(Range decls,
+                                          bool onlyOperators) {
+  for (Decl *D : decls) {
+    if (auto *VD = dyn_cast<ValueDecl>(D))
+      if (onlyOperators ? VD->isOperator() : VD->hasName())
+        TopLevelValues.remove(VD);
+    if (auto *NTD = dyn_cast<NominalTypeDecl>(D))
+      doUnpopulateCache(NTD->getMembers(), true);
+    if (auto *ED = dyn_cast<ExtensionDecl>(D))
+      doUnpopulateCache(ED->getMembers(), true);
+  }
+}
+
+void SourceLookupCache::removeFromMemberCache(DeclRange decls) {
+  for (Decl *D : decls) {
+    auto VD = dyn_cast<ValueDecl>(D);
+    if (!VD)
+      continue;
+
+    if (auto NTD = dyn_cast<NominalTypeDecl>(VD))
+      removeFromMemberCache(NTD->getMembers());
+    else if (VD->canBeAccessedByDynamicLookup())
+      ClassMembers.remove(VD);
+  }
+}
+
 /// Populate our cache on the first name lookup.
 SourceLookupCache::LookupCache(const SourceFile &SF) {
   doPopulateCache(llvm::makeArrayRef(SF.Decls), false);
+  NumDeclsIndexed = SF.Decls.size();
+}
+
+void SourceLookupCache::addNewDecls(const SourceFile &SF) {
+  auto decls = llvm::makeArrayRef(SF.Decls);
+  assert(NumDeclsIndexed <= decls.size() &&
+         "decls were removed without unindexing them");
+  if (NumDeclsIndexed == decls.size())
+    return;
+
+  auto newDecls = decls.slice(NumDeclsIndexed);
+  NumDeclsIndexed = decls.size();
+
+  doPopulateCache(newDecls, false);
+  if (MemberCachePopulated) {
+    for (const Decl *D : newDecls) {
+      if (const auto *NTD = dyn_cast<NominalTypeDecl>(D))
+        addToMemberCache(NTD->getMembers());
+      else if (const auto *ED = dyn_cast<ExtensionDecl>(D))
+        addToMemberCache(ED->getMembers());
+    }
+  }
+
+  // Anything other than expression code may introduce a new name, which
+  // changes what a lookup of everything visible in the file produces, so
+  // drop the cached snapshot of it.  Import changes are handled by
+  // SourceFile::addImports().
+  for (Decl *D : newDecls) {
+    if (!isa<TopLevelCodeDecl>(D)) {
+      AllVisibleValues.clear();
+      break;
+    }
+  }
+}
+
+void SourceLookupCache::removeDecls(ArrayRef<Decl *> decls,
+                                    unsigned remainingDecls) {
+  if (decls.empty())
+    return;
+
+  doUnpopulateCache(decls, false);
+  if (MemberCachePopulated) {
+    for (const Decl *D : decls) {
+      if (const auto *NTD = dyn_cast<NominalTypeDecl>(D))
+        removeFromMemberCache(NTD->getMembers());
+      else if (const auto *ED = dyn_cast<ExtensionDecl>(D))
+        removeFromMemberCache(ED->getMembers());
+    }
+  }
+
+  if (NumDeclsIndexed > remainingDecls)
+    NumDeclsIndexed = remainingDecls;
+
+  // If the snapshot of everything visible in the file was computed while the
+  // removed declarations were present, it has to be recomputed.
+  if (!AllVisibleValues.empty()) {
+    llvm::SmallPtrSet<const Decl *, 8> removed(decls.begin(), decls.end());
+    for (ValueDecl *VD : AllVisibleValues) {
+      if (removed.count(VD)) {
+        AllVisibleValues.clear();
+        break;
+      }
+    }
+  }
 }
 
 void SourceLookupCache::lookupValue(AccessPathTy AccessPath, DeclName Name,
@@ -1282,6 +1403,11 @@ void SourceFile::addImports(
   assert(iter == newBuf.end());
 
   Imports = newBuf;
+
+  // The imported modules change what an unqualified lookup of everything
+  // visible in this file produces; invalidate any cached snapshot of it.
+  if (Cache)
+    Cache->AllVisibleValues.clear();
 }
 
 bool SourceFile::hasTestableImport(const swift::ModuleDecl *module) const {
@@ -1302,6 +1428,20 @@ void SourceFile::clearLookupCache() {
   Cache.reset();
 }
 
+void SourceFile::addParsedDeclsToLookupCache() {
+  if (!Cache)
+    return;
+
+  Cache->addNewDecls(*this);
+}
+
+void SourceFile::truncateDeclsInLookupCache(unsigned count) {
+  if (!Cache || Decls.size() <= count)
+    return;
+
+  Cache->removeDecls(llvm::makeArrayRef(Decls).slice(count), count);
+}
+
 void
 SourceFile::cacheVisibleDecls(SmallVectorImpl<ValueDecl*> &&globals) const {
   SmallVectorImpl<ValueDecl*> &cached = getCache().AllVisibleValues;
@@ -138,8 +138,23 @@ static ResolutionKind recordImportDecls(LazyResolver *typeResolver,
   llvm_unreachable("bad ResolutionKind");
 }
 
+/// Returns true if the contents of \p module cannot change during this
+/// compilation, i.e. it has no source files currently being type-checked.
+static bool isImmutableForLookup(const ModuleDecl *module) {
+  for (const FileUnit *file : module->getFiles())
+    if (file->getKind() == FileUnitKind::Source)
+      return false;
+  return true;
+}
+
 /// Performs a qualified lookup into the given module and, if necessary, its
 /// reexports, observing proper shadowing rules.
+///
+/// If \p persistentCache is non-null, whole-module lookups into modules
+/// without source files are additionally cached there across calls, keyed
+/// by \p name and \p persistentKeyBase; such results cannot change during a
+/// compilation, so this avoids re-walking their reexport graphs on every
+/// lookup of the same name.
 template <typename OverloadSetTy, typename CallbackTy>
 static void lookupInModule(ModuleDecl *module, ModuleDecl::AccessPathTy accessPath,
                            SmallVectorImpl<ValueDecl *> &decls,
@@ -149,6 +164,8 @@ static void lookupInModule(ModuleDecl *module, ModuleDecl::AccessPathTy accessPa
                            const DeclContext *moduleScopeContext,
                            bool respectAccessControl,
                            ArrayRef<ModuleDecl::ImportedModule> extraImports,
+                           DeclName name, unsigned persistentKeyBase,
+                           ModuleScopeLookupCache *persistentCache,
                            CallbackTy callback) {
   assert(module);
   assert(std::none_of(extraImports.begin(), extraImports.end(),
@@ -164,6 +181,26 @@ static void lookupInModule(ModuleDecl *module, ModuleDecl::AccessPathTy accessPa
     return;
   }
 
+  // The access-control filtering below only depends on the module the lookup
+  // is being made from, so that's all the persistent cache needs to key on.
+  // The resolution kind folds into the key because it evolves as reexports
+  // are visited.
+  const ModuleDecl *scopeModule =
+      moduleScopeContext ? moduleScopeContext->getParentModule() : nullptr;
+  unsigned persistentKey =
+      persistentKeyBase | (static_cast<unsigned>(resolutionKind) << 2);
+  bool usePersistentCache = persistentCache && accessPath.empty() &&
+                            extraImports.empty() &&
+                            isImmutableForLookup(module);
+  if (usePersistentCache) {
+    if (const auto *cached =
+            persistentCache->find(module, scopeModule, name, persistentKey)) {
+      decls.append(cached->begin(), cached->end());
+      iter->second.insert(iter->second.end(), cached->begin(), cached->end());
+      return;
+    }
+  }
+
   size_t initialCount = decls.size();
 
   SmallVector<ValueDecl *, 4> localDecls;
@@ -223,7 +260,9 @@ static void lookupInModule(ModuleDecl *module, ModuleDecl::AccessPathTy accessPa
       lookupInModule<OverloadSetTy>(next.second, combinedAccessPath,
                                     resultSet, resolutionKind, canReturnEarly,
                                     typeResolver, cache, moduleScopeContext,
-                                    respectAccessControl, {}, callback);
+                                    respectAccessControl, {}, name,
+                                    persistentKeyBase, persistentCache,
+                                    callback);
     }
 
     // Add the results from scoped imports.
@@ -251,6 +290,10 @@ static void lookupInModule(ModuleDecl *module, ModuleDecl::AccessPathTy accessPa
   cachedValues.insert(cachedValues.end(),
                       decls.begin() + initialCount,
                       decls.end());
+
+  if (usePersistentCache)
+    persistentCache->insert(module, scopeModule, name, persistentKey,
+                            cachedValues);
 }
 
 void namelookup::lookupInModule(ModuleDecl *startModule,
@@ -264,12 +307,19 @@ void namelookup::lookupInModule(ModuleDecl *startModule,
                                 ArrayRef<ModuleDecl::ImportedModule> extraImports) {
   assert(moduleScopeContext && moduleScopeContext->isModuleScopeContext());
   ModuleLookupCache cache;
-  bool respectAccessControl = startModule->getASTContext().LangOpts
-                                .EnableAccessControl;
+  ASTContext &ctx = startModule->getASTContext();
+  bool respectAccessControl = ctx.LangOpts.EnableAccessControl;
+  // The persistent cache key reserves bit 0 for the presence of a type
+  // resolver (which affects which overloads are returned) and bit 1 for the
+  // lookup kind; the resolution kind occupies the bits above those.
+  unsigned persistentKeyBase = (typeResolver ? 1 : 0) |
+                               (static_cast<unsigned>(lookupKind) << 1);
   ::lookupInModule<CanTypeSet>(startModule, topAccessPath, decls,
                                resolutionKind, /*canReturnEarly=*/true,
                                typeResolver, cache, moduleScopeContext,
                                respectAccessControl, extraImports,
+                               name, persistentKeyBase,
+                               &ctx.getModuleScopeLookupCache(),
     [=](ModuleDecl *module, ModuleDecl::AccessPathTy path,
         SmallVectorImpl<ValueDecl *> &localDecls) {
       module->lookupValue(path, name, lookupKind, localDecls);
@@ -293,6 +343,8 @@ void namelookup::lookupVisibleDeclsInModule(
                                     resolutionKind, /*canReturnEarly=*/false,
                                     typeResolver, cache, moduleScopeContext,
                                     respectAccessControl, extraImports,
+                                    DeclName(), /*persistentKeyBase=*/0,
+                                    /*persistentCache=*/nullptr,
     [=](ModuleDecl *module, ModuleDecl::AccessPathTy path,
         SmallVectorImpl<ValueDecl *> &localDecls) {
       VectorDeclConsumer consumer(localDecls);
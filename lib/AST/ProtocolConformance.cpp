@@ -1317,10 +1317,12 @@ ProtocolConformance *ProtocolConformance::getCanonicalConformance() {
     auto specSubs = spec->getGenericSubstitutions();
     SmallVector<Substitution, 4> newSpecSubs;
     auto canSpecSubs = getCanonicalSubstitutionList(specSubs, newSpecSubs);
+    // getSpecializedConformance makes a uniqued copy of the substitutions,
+    // so passing the local storage is fine.
     return Ctx.getSpecializedConformance(
         getType()->getCanonicalType(),
         genericConformance->getCanonicalConformance(),
-        newSpecSubs.empty() ? canSpecSubs : Ctx.AllocateCopy(canSpecSubs));
+        canSpecSubs);
   }
   }
   llvm_unreachable("bad ProtocolConformanceKind");
@@ -146,7 +146,6 @@ RawComment Decl::getRawComment() const {
   if (auto *Unit =
           dyn_cast<FileUnit>(this->getDeclContext()->getModuleScopeContext())) {
     if (Optional<CommentInfo> C = Unit->getCommentForDecl(this)) {
-      swift::markup::MarkupContext MC;
       Context.setBriefComment(this, C->Brief);
       Context.setRawComment(this, C->Raw);
       return C->Raw;
@@ -206,6 +205,38 @@ Optional<unsigned> Decl::getSourceOrder() const {
   return None;
 }
 
+/// Returns true if \p Line contains only plain paragraph text, i.e. nothing
+/// the Markup parser would interpret or rewrite.  Such lines can be copied
+/// into a brief comment verbatim.
+static bool isPlainParagraphLine(StringRef Line) {
+  StringRef Trimmed = Line.ltrim(" \t\v\f");
+
+  // Block markup which introduces something other than a plain paragraph,
+  // including setext heading underlines for the preceding line.
+  switch (Trimmed.empty() ? '\0' : Trimmed.front()) {
+  case '-': case '+': case '*': case '#': case '>': case '=':
+    return false;
+  default:
+    break;
+  }
+
+  // An ordered list item: digits followed by '.' or ')'.
+  size_t FirstNonDigit = Trimmed.find_first_not_of("0123456789");
+  if (FirstNonDigit != 0 && FirstNonDigit != StringRef::npos &&
+      (Trimmed[FirstNonDigit] == '.' || Trimmed[FirstNonDigit] == ')'))
+    return false;
+
+  // Inline markup, HTML, entity references and backslash escapes.
+  if (Trimmed.find_first_of("*_`[]<&\\") != StringRef::npos)
+    return false;
+
+  // A hard line break (two trailing spaces) is rewritten by the parser.
+  if (Line.endswith("  "))
+    return false;
+
+  return true;
+}
+
 static StringRef extractBriefComment(ASTContext &Context, RawComment RC,
                                      const Decl *D) {
   PrettyStackTraceDecl StackTrace("extracting brief comment for", D);
@@ -214,6 +245,41 @@ static StringRef extractBriefComment(ASTContext &Context, RawComment RC,
     return StringRef();
 
   swift::markup::MarkupContext MC;
+
+  // Most doc comments start with a plain paragraph of text, for which the
+  // brief can be extracted directly from the raw comment lines.  This avoids
+  // building a full markup AST, which is wasted work for clients like the
+  // indexer that never display the documentation.
+  auto LL = MC.getLineList(RC);
+  ArrayRef<swift::markup::Line> Lines = LL.getLines();
+  while (!Lines.empty() && Lines.front().Text.trim().empty())
+    Lines = Lines.drop_front();
+
+  if (!Lines.empty()) {
+    SmallString<256> BriefStr;
+    bool IsPlainText = true;
+    for (const auto &Line : Lines) {
+      StringRef Trimmed = Line.Text.trim();
+      if (Trimmed.empty())
+        break; // End of the first paragraph.
+      if (!isPlainParagraphLine(Line.Text)) {
+        IsPlainText = false;
+        break;
+      }
+      // Paragraph lines are joined by soft line breaks, which print as a
+      // single space.
+      if (!BriefStr.empty())
+        BriefStr += ' ';
+      BriefStr += Trimmed;
+    }
+    if (IsPlainText) {
+      if (BriefStr.empty())
+        return StringRef();
+      return Context.AllocateCopy(StringRef(BriefStr));
+    }
+  }
+
+  // The comment starts with non-trivial markup; fall back to a full parse.
   auto DC = getCascadingDocComment(MC, D);
   if (!DC.hasValue())
     return StringRef();
@@ -33,6 +33,7 @@
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
@@ -41,6 +42,12 @@
 #include <iterator>
 using namespace swift;
 
+#define DEBUG_TYPE "Type"
+STATISTIC(NumCanonicalTypeCacheHits,
+          "# of canonical type requests answered from the inline cache");
+STATISTIC(NumCanonicalTypesComputed,
+          "# of canonical types computed structurally");
+
 Type QueryTypeSubstitutionMap::operator()(SubstitutableType *type) const {
   auto key = type->getCanonicalType()->castTo<SubstitutableType>();
   auto known = substitutions.find(key);
@@ -1052,10 +1059,13 @@ CanType TypeBase::getCanonicalType() {
   if (isCanonical())
     return CanType(this);
   // If the canonical type was already computed, just return what we have.
-  if (TypeBase *CT = CanonicalType.get<TypeBase*>())
+  if (TypeBase *CT = CanonicalType.get<TypeBase*>()) {
+    ++NumCanonicalTypeCacheHits;
     return CanType(CT);
+  }
 
   // Otherwise, compute and cache it.
+  ++NumCanonicalTypesComputed;
   TypeBase *Result = nullptr;
   switch (getKind()) {
 #define ALWAYS_CANONICAL_TYPE(id, parent) case TypeKind::id:
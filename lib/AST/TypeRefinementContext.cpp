@@ -21,6 +21,7 @@
 #include "swift/AST/Expr.h"
 #include "swift/AST/TypeRefinementContext.h"
 #include "swift/Basic/SourceManager.h"
+#include <algorithm>
 
 using namespace swift;
 
@@ -31,7 +32,7 @@ TypeRefinementContext::TypeRefinementContext(ASTContext &Ctx, IntroNode Node,
     : Node(Node), SrcRange(SrcRange), AvailabilityInfo(Info) {
   if (Parent) {
     assert(SrcRange.isValid());
-    Parent->addChild(this);
+    Parent->addChild(this, Ctx.SourceMgr);
     assert(Info.isContainedIn(Parent->getAvailabilityInfo()));
   }
   Ctx.addDestructorCleanup(Children);
@@ -145,10 +146,17 @@ TypeRefinementContext::findMostRefinedSubContext(SourceLoc Loc,
   if (SrcRange.isValid() && !SM.rangeContainsTokenLoc(SrcRange, Loc))
     return nullptr;
 
-  // For the moment, we perform a linear search here, but we can and should
-  // do something more efficient.
-  for (TypeRefinementContext *Child : Children) {
-    if (auto *Found = Child->findMostRefinedSubContext(Loc, SM)) {
+  // The children are disjoint and sorted by the start of their ranges, so
+  // the only child that can contain Loc is the last one whose range starts
+  // at or before it.
+  auto Candidate =
+      std::upper_bound(Children.begin(), Children.end(), Loc,
+                       [&SM](SourceLoc Loc, TypeRefinementContext *Child) {
+        return SM.isBeforeInBuffer(Loc, Child->getSourceRange().Start);
+      });
+  if (Candidate != Children.begin()) {
+    if (auto *Found = (*std::prev(Candidate))->findMostRefinedSubContext(Loc,
+                                                                         SM)) {
       return Found;
     }
   }
@@ -158,6 +166,31 @@ TypeRefinementContext::findMostRefinedSubContext(SourceLoc Loc,
   return this;
 }
 
+void TypeRefinementContext::addChild(TypeRefinementContext *Child,
+                                     SourceManager &SM) {
+  assert(Child->getSourceRange().isValid());
+
+  // Keep the children sorted by the start of their source ranges, which
+  // findMostRefinedSubContext() relies on to binary-search them. Children
+  // are almost always introduced in source order, so the common case is an
+  // append.
+  if (Children.empty() ||
+      SM.isBeforeInBuffer(Children.back()->getSourceRange().Start,
+                          Child->getSourceRange().Start)) {
+    Children.push_back(Child);
+    return;
+  }
+
+  auto InsertionPoint =
+      std::upper_bound(Children.begin(), Children.end(), Child,
+                       [&SM](TypeRefinementContext *LHS,
+                             TypeRefinementContext *RHS) {
+        return SM.isBeforeInBuffer(LHS->getSourceRange().Start,
+                                   RHS->getSourceRange().Start);
+      });
+  Children.insert(InsertionPoint, Child);
+}
+
 void TypeRefinementContext::dump(SourceManager &SrcMgr) const {
   dump(llvm::errs(), SrcMgr);
 }
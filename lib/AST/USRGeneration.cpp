@@ -15,6 +15,7 @@
 #include "swift/AST/USRGeneration.h"
 #include "swift/AST/ASTMangler.h"
 #include "swift/AST/SwiftNameTranslation.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/raw_ostream.h"
@@ -164,7 +165,7 @@ static bool shouldUseObjCUSR(const Decl *D) {
   return false;
 }
 
-bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
+static bool printUncachedDeclUSR(const ValueDecl *D, raw_ostream &OS) {
   if (!D->hasName() && !isa<ParamDecl>(D) &&
       (!isa<FuncDecl>(D) ||
        cast<FuncDecl>(D)->getAccessorKind() == AccessorKind::NotAccessor))
@@ -245,6 +246,34 @@ bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
   return false;
 }
 
+bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
+  auto &Ctx = D->getASTContext();
+
+  // USRs are requested repeatedly for the same declaration by the indexer,
+  // SourceKit, and the API digester, so generate each one once and answer
+  // later requests from the ASTContext cache.
+  if (auto Cached = Ctx.getUSR(D)) {
+    if (Ctx.Stats)
+      Ctx.Stats->getFrontendCounters().NumUSRCacheHits++;
+    OS << *Cached;
+    return false;
+  }
+
+  if (Ctx.Stats)
+    Ctx.Stats->getFrontendCounters().NumUSRCacheMisses++;
+
+  llvm::SmallString<128> Buf;
+  {
+    llvm::raw_svector_ostream BufOS(Buf);
+    if (printUncachedDeclUSR(D, BufOS))
+      return true;
+  }
+
+  Ctx.setUSR(D, Buf.str());
+  OS << Buf.str();
+  return false;
+}
+
 bool ide::printAccessorUSR(const AbstractStorageDecl *D, AccessorKind AccKind,
                            llvm::raw_ostream &OS) {
   // AccKind should always be either IsGetter or IsSetter here, based
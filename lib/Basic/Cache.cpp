@@ -14,12 +14,20 @@
 #include "Darwin/Cache-Mac.cpp"
 #else
 
-//  This file implements a default caching implementation that never evicts
-//  its entries.
+//  This file implements the default caching implementation: a sharded map
+//  with LRU ordering and reference-counted values, comparable to the
+//  Darwin libcache backend.  There is no system memory-pressure signal to
+//  react to on these platforms, so eviction is driven by the cost limit
+//  (see CacheImpl::setCostLimit): when the total cost of a shard exceeds
+//  its slice of the limit, least recently used entries are evicted.
 
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Mutex.h"
+#include "llvm/Support/Process.h"
+#include <list>
 
 using namespace swift::sys;
 using llvm::StringRef;
@@ -33,13 +41,15 @@ struct DefaultCacheKey {
   DefaultCacheKey(void *Key, CacheImpl::CallBacks *CBs) : Key(Key), CBs(CBs) {}
 };
 
-struct DefaultCache {
-  llvm::sys::Mutex Mux;
-  CacheImpl::CallBacks CBs;
-  llvm::DenseMap<DefaultCacheKey, void *> Entries;
-
-  explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
+struct DefaultCacheEntry {
+  DefaultCacheKey Key;
+  void *Value;
+  size_t Cost;
 };
+
+/// A pair of a key and a value that have been unlinked from a shard and
+/// whose callbacks still need to be run.
+typedef std::pair<void *, void *> UnlinkedEntry;
 } // end anonymous namespace
 
 namespace llvm {
@@ -67,74 +77,196 @@ template<> struct DenseMapInfo<DefaultCacheKey> {
 };
 } // namespace llvm
 
+namespace {
+/// One shard of the cache: a map from keys to entries, with the entries
+/// kept in most-recently-used-first order.
+struct CacheShard {
+  llvm::sys::Mutex Mux;
+  std::list<DefaultCacheEntry> Entries;
+  llvm::DenseMap<DefaultCacheKey, std::list<DefaultCacheEntry>::iterator>
+      EntryMap;
+  size_t TotalCost = 0;
+};
+
+struct DefaultCache {
+  enum { NumShards = 8 };
+
+  CacheImpl::CallBacks CBs;
+  CacheShard Shards[NumShards];
+
+  /// Soft bound on the total cost of all entries; zero means unbounded.
+  size_t CostLimit = 0;
+
+  /// Reference counts for stored values, shared by every entry and every
+  /// outstanding getAndRetain caller.  The value retain callback runs when
+  /// a value is first referenced and the release callback when the last
+  /// reference is dropped, so a value stored under several keys is shared
+  /// rather than duplicated (matching libcache).
+  llvm::sys::Mutex RefCountMux;
+  llvm::DenseMap<void *, unsigned> ValueRefCounts;
+
+  explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
+
+  CacheShard &getShard(const void *Key) {
+    uintptr_t Hash = CBs.keyHashCB(const_cast<void *>(Key), nullptr);
+    // DenseMap mixes the low bits; use different ones for sharding.
+    return Shards[(Hash >> 4) % NumShards];
+  }
+
+  void retainValueRef(void *Value) {
+    llvm::sys::ScopedLock L(RefCountMux);
+    if (ValueRefCounts[Value]++ == 0)
+      CBs.valueRetainCB(Value, nullptr);
+  }
+
+  void releaseValueRef(void *Value) {
+    bool Destroy = false;
+    {
+      llvm::sys::ScopedLock L(RefCountMux);
+      auto It = ValueRefCounts.find(Value);
+      assert(It != ValueRefCounts.end() && "release of unknown cache value");
+      if (--It->second == 0) {
+        ValueRefCounts.erase(It);
+        Destroy = true;
+      }
+    }
+    // Run the callback outside the lock; it may destroy the value.
+    if (Destroy)
+      CBs.valueReleaseCB(Value, nullptr);
+  }
+
+  /// Destroy the keys of unlinked entries and drop the cache's reference
+  /// to their values.  Must be called without any shard lock held.
+  void finishUnlinkedEntries(llvm::SmallVectorImpl<UnlinkedEntry> &Unlinked) {
+    for (auto &KV : Unlinked) {
+      CBs.keyDestroyCB(KV.first, nullptr);
+      releaseValueRef(KV.second);
+    }
+  }
+};
+} // end anonymous namespace
+
 CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
-  return new DefaultCache(CBs);
+  auto *DCache = new DefaultCache(CBs);
+  // Let long-running processes (e.g. SourceKit in CI) bound their caches
+  // without code changes.
+  if (auto LimitStr = llvm::sys::Process::GetEnv("SWIFT_CACHE_COST_LIMIT")) {
+    size_t Limit;
+    if (!StringRef(*LimitStr).getAsInteger(10, Limit))
+      DCache->CostLimit = Limit;
+  }
+  return DCache;
 }
 
-void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
+void CacheImpl::setCostLimit(size_t Limit) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  DCache.CostLimit = Limit;
+}
 
+void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  CacheShard &Shard = DCache.getShard(Key);
   DefaultCacheKey CKey(Key, &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    if (Entry->second == Value)
-      return;
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
-  }
 
-  DCache.CBs.valueRetainCB(Value, nullptr);
-  DCache.Entries[CKey] = Value;
+  // One reference for the cache's entry and one for the caller, who is
+  // expected to call releaseValue (mirroring the Darwin semantics).
+  DCache.retainValueRef(Value);
+  DCache.retainValueRef(Value);
+
+  llvm::SmallVector<UnlinkedEntry, 4> Unlinked;
+  {
+    llvm::sys::ScopedLock L(Shard.Mux);
+
+    // Unlink any entry this one replaces.
+    auto Entry = Shard.EntryMap.find(CKey);
+    if (Entry != Shard.EntryMap.end()) {
+      auto EntryIt = Entry->second;
+      Unlinked.push_back({EntryIt->Key.Key, EntryIt->Value});
+      Shard.TotalCost -= EntryIt->Cost;
+      Shard.EntryMap.erase(Entry);
+      Shard.Entries.erase(EntryIt);
+    }
 
-  // FIXME: Not thread-safe! It should avoid deleting the value until
-  // 'releaseValue is called on it.
+    Shard.Entries.push_front(DefaultCacheEntry{CKey, Value, Cost});
+    Shard.EntryMap[CKey] = Shard.Entries.begin();
+    Shard.TotalCost += Cost;
+
+    // Evict least recently used entries while the shard is over its slice
+    // of the cost budget.  The entry just added is never evicted, so a
+    // single over-budget value still caches.
+    if (size_t Limit = DCache.CostLimit) {
+      size_t ShardLimit = Limit / DefaultCache::NumShards;
+      while (Shard.TotalCost > ShardLimit && Shard.Entries.size() > 1) {
+        auto &Victim = Shard.Entries.back();
+        Unlinked.push_back({Victim.Key.Key, Victim.Value});
+        Shard.TotalCost -= Victim.Cost;
+        Shard.EntryMap.erase(Victim.Key);
+        Shard.Entries.pop_back();
+      }
+    }
+  }
+  DCache.finishUnlinkedEntries(Unlinked);
 }
 
 bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  CacheShard &Shard = DCache.getShard(Key);
+  llvm::sys::ScopedLock L(Shard.Mux);
 
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    // FIXME: Not thread-safe! It should avoid deleting the value until
-    // 'releaseValue is called on it.
-    *Value_out = Entry->second;
+  auto Entry = Shard.EntryMap.find(CKey);
+  if (Entry != Shard.EntryMap.end()) {
+    // Move the entry to the front of the use order, and retain the value
+    // on behalf of the caller so eviction cannot destroy it while the
+    // caller still uses it.
+    Shard.Entries.splice(Shard.Entries.begin(), Shard.Entries, Entry->second);
+    DCache.retainValueRef(Entry->second->Value);
+    *Value_out = Entry->second->Value;
     return true;
   }
   return false;
 }
 
 void CacheImpl::releaseValue(void *Value) {
-  // FIXME: Implementation.
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  DCache.releaseValueRef(Value);
 }
 
 bool CacheImpl::remove(const void *Key) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  CacheShard &Shard = DCache.getShard(Key);
 
-  DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
-    return true;
+  llvm::SmallVector<UnlinkedEntry, 1> Unlinked;
+  {
+    llvm::sys::ScopedLock L(Shard.Mux);
+
+    DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
+    auto Entry = Shard.EntryMap.find(CKey);
+    if (Entry == Shard.EntryMap.end())
+      return false;
+    auto EntryIt = Entry->second;
+    Unlinked.push_back({EntryIt->Key.Key, EntryIt->Value});
+    Shard.TotalCost -= EntryIt->Cost;
+    Shard.EntryMap.erase(Entry);
+    Shard.Entries.erase(EntryIt);
   }
-  return false;
+  DCache.finishUnlinkedEntries(Unlinked);
+  return true;
 }
 
 void CacheImpl::removeAll() {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
 
-  for (auto Entry : DCache.Entries) {
-    DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+  llvm::SmallVector<UnlinkedEntry, 8> Unlinked;
+  for (auto &Shard : DCache.Shards) {
+    llvm::sys::ScopedLock L(Shard.Mux);
+    for (auto &Entry : Shard.Entries)
+      Unlinked.push_back({Entry.Key.Key, Entry.Value});
+    Shard.Entries.clear();
+    Shard.EntryMap.clear();
+    Shard.TotalCost = 0;
   }
-  DCache.Entries.clear();
+  DCache.finishUnlinkedEntries(Unlinked);
 }
 
 void CacheImpl::destroy() {
@@ -22,15 +22,11 @@
 using namespace swift;
 
 ClusteredBitVector ClusteredBitVector::fromAPInt(const llvm::APInt &bits) {
-  // This is not a very efficient algorithm.
+  // APInt keeps the bits above the bit width clear, which is exactly the
+  // invariant the chunk-array append wants for its final chunk.
   ClusteredBitVector result;
-  for (unsigned i = 0, e = bits.getBitWidth(); i != e; ++i) {
-    if (bits[i]) {
-      result.appendSetBits(1);
-    } else {
-      result.appendClearBits(1);
-    }
-  }
+  result.append(bits.getBitWidth(),
+                llvm::makeArrayRef(bits.getRawData(), bits.getNumWords()));
   return result;
 }
 
@@ -42,6 +42,11 @@ CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
   return cache_out;
 }
 
+void CacheImpl::setCostLimit(size_t Limit) {
+  // libcache evicts in response to real memory pressure notifications, so
+  // an explicit cost budget is unnecessary here.
+}
+
 void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   cache_set_and_retain(static_cast<cache_t*>(Impl), Key, Value, Cost);
 }
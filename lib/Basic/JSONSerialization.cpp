@@ -14,14 +14,16 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Format.h"
 
+#include <cstdio>
+
 using namespace swift::json;
 using namespace swift;
 
 unsigned Output::beginArray() {
   StateStack.push_back(ArrayFirstValue);
-  Stream << '[';
+  write('[');
   if (PrettyPrint) {
-    Stream << '\n';
+    write('\n');
   }
   return 0;
 }
@@ -29,9 +31,9 @@ unsigned Output::beginArray() {
 bool Output::preflightElement(unsigned, void *&) {
   if (StateStack.back() != ArrayFirstValue) {
     assert(StateStack.back() == ArrayOtherValue && "We must be in a sequence!");
-    Stream << ',';
+    write(',');
     if (PrettyPrint)
-      Stream << '\n';
+      write('\n');
   }
   if (PrettyPrint)
     indent();
@@ -48,10 +50,10 @@ void Output::postflightElement(void*) {
 void Output::endArray() {
   StateStack.pop_back();
   if (PrettyPrint) {
-    Stream << '\n';
+    write('\n');
     indent();
   }
-  Stream << ']';
+  write(']');
 }
 
 bool Output::canElideEmptyArray() {
@@ -65,18 +67,18 @@ bool Output::canElideEmptyArray() {
 
 void Output::beginObject() {
   StateStack.push_back(ObjectFirstKey);
-  Stream << "{";
+  write('{');
   if (PrettyPrint)
-    Stream << '\n';
+    write('\n');
 }
 
 void Output::endObject() {
   StateStack.pop_back();
   if (PrettyPrint) {
-    Stream << '\n';
+    write('\n');
     indent();
   }
-  Stream << "}";
+  write('}');
 }
 
 bool Output::preflightKey(const char *Key, bool Required, bool SameAsDefault,
@@ -85,15 +87,17 @@ bool Output::preflightKey(const char *Key, bool Required, bool SameAsDefault,
   if (Required || !SameAsDefault) {
     if (StateStack.back() != ObjectFirstKey) {
       assert(StateStack.back() == ObjectOtherKey && "We must be in an object!");
-      Stream << ',';
+      write(',');
       if (PrettyPrint)
-        Stream << '\n';
+        write('\n');
     }
     if (PrettyPrint)
       indent();
-    Stream << '"' << Key << "\":";
+    write('"');
+    write(Key);
+    write("\":");
     if (PrettyPrint)
-      Stream << ' ';
+      write(' ');
     return true;
   }
   return false;
@@ -125,9 +129,9 @@ void Output::endEnumScalar() {
 }
 
 bool Output::beginBitSetScalar(bool &DoClear) {
-  Stream << '[';
+  write('[');
   if (PrettyPrint)
-    Stream << ' ';
+    write(' ');
   NeedBitValueComma = false;
   DoClear = false;
   return true;
@@ -136,9 +140,9 @@ bool Output::beginBitSetScalar(bool &DoClear) {
 bool Output::bitSetMatch(const char *Str, bool Matches) {
   if (Matches) {
     if (NeedBitValueComma) {
-      Stream << ',';
+      write(',');
       if (PrettyPrint)
-        Stream << ' ';
+        write(' ');
     }
     StringRef StrRef(Str);
     scalarString(StrRef, true);
@@ -148,82 +152,120 @@ bool Output::bitSetMatch(const char *Str, bool Matches) {
 
 void Output::endBitSetScalar() {
   if (PrettyPrint)
-    Stream << ' ';
-  Stream << ']';
+    write(' ');
+  write(']');
 }
 
 void Output::scalarString(StringRef &S, bool MustQuote) {
   if (MustQuote) {
-    Stream << '"';
-    for (unsigned char c : S) {
-      // According to the JSON standard, the following characters must be
-      // escaped:
-      //   - Quotation mark (U+0022)
-      //   - Reverse solidus (U+005C)
-      //   - Control characters (U+0000 to U+001F)
-      // We need to check for these and escape them if present.
-      //
-      // Since these are represented by a single byte in UTF8 (and will not be
-      // present in any multi-byte UTF8 representations), we can just switch on
-      // the value of the current byte.
-      //
-      // Any other bytes present in the string should therefore be emitted
-      // as-is, without any escaping.
+    write('"');
+    // According to the JSON standard, the following characters must be
+    // escaped:
+    //   - Quotation mark (U+0022)
+    //   - Reverse solidus (U+005C)
+    //   - Control characters (U+0000 to U+001F)
+    // We need to check for these and escape them if present.
+    //
+    // Since these are represented by a single byte in UTF8 (and will not be
+    // present in any multi-byte UTF8 representations), we can just switch on
+    // the value of the current byte.
+    //
+    // Any other bytes present in the string should therefore be emitted
+    // as-is, without any escaping; scan forward to the next byte needing an
+    // escape and emit each clean run in a single write.
+    const char *Start = S.begin();
+    const char *End = S.end();
+    const char *Cursor = Start;
+    while (Cursor != End) {
+      unsigned char c = *Cursor;
+      if (c > '\x1F' && c != '"' && c != '\\' && c != '/') {
+        ++Cursor;
+        continue;
+      }
+      write(StringRef(Start, Cursor - Start));
       switch (c) {
-      // First, check for characters for which JSON has custom escape sequences.
+      // First, check for characters for which JSON has custom escape
+      // sequences.
       case '"':
-        Stream << '\\' << '"';
+        write("\\\"");
         break;
       case '\\':
-        Stream << '\\' << '\\';
+        write("\\\\");
         break;
       case '/':
-        Stream << '\\' << '/';
+        write("\\/");
         break;
       case '\b':
-        Stream << '\\' << 'b';
+        write("\\b");
         break;
       case '\f':
-        Stream << '\\' << 'f';
+        write("\\f");
         break;
       case '\n':
-        Stream << '\\' << 'n';
+        write("\\n");
         break;
       case '\r':
-        Stream << '\\' << 'r';
+        write("\\r");
         break;
       case '\t':
-        Stream << '\\' << 't';
+        write("\\t");
         break;
       default:
-        // Otherwise, check to see if the current byte is a control character.
-        if (c <= '\x1F') {
-          // Since we have a control character, we need to escape it using
-          // JSON's only valid escape sequence: \uxxxx (where x is a hex digit).
-
-          // The upper two digits for control characters are always 00.
-          Stream << "\\u00";
-
-          // Convert the current character into hexadecimal digits.
-          Stream << llvm::hexdigit((c >> 4) & 0xF);
-          Stream << llvm::hexdigit((c >> 0) & 0xF);
-        } else {
-          // This isn't a control character, so we don't need to escape it.
-          // As a result, emit it directly; if it's part of a multi-byte UTF8
-          // representation, all bytes will be emitted in this fashion.
-          Stream << c;
-        }
+        // We have some other control character, so we need to escape it using
+        // JSON's only valid escape sequence: \uxxxx (where x is a hex digit).
+
+        // The upper two digits for control characters are always 00.
+        write("\\u00");
+
+        // Convert the current character into hexadecimal digits.
+        write(llvm::hexdigit((c >> 4) & 0xF));
+        write(llvm::hexdigit((c >> 0) & 0xF));
         break;
       }
+      Start = ++Cursor;
     }
-    Stream << '"';
+    write(StringRef(Start, Cursor - Start));
+    write('"');
   }
   else
-    Stream << S;
+    write(S);
+}
+
+void Output::scalarBool(bool Val) {
+  write(Val ? StringRef("true") : StringRef("false"));
+}
+
+void Output::scalarInteger(uint64_t Val) {
+  // Format backwards into a stack buffer and emit in one write.
+  char Buf[20];
+  char *End = Buf + sizeof(Buf);
+  char *Cur = End;
+  do {
+    *--Cur = '0' + char(Val % 10);
+    Val /= 10;
+  } while (Val);
+  write(StringRef(Cur, End - Cur));
+}
+
+void Output::scalarInteger(int64_t Val) {
+  if (Val < 0) {
+    write('-');
+    // Negate as unsigned so INT64_MIN is handled.
+    scalarInteger(~uint64_t(Val) + 1);
+  } else {
+    scalarInteger(uint64_t(Val));
+  }
+}
+
+void Output::scalarDouble(double Val) {
+  char Buf[32];
+  int Len = snprintf(Buf, sizeof(Buf), "%g", Val);
+  write(StringRef(Buf, Len));
 }
 
 void Output::indent() {
-  Stream.indent(StateStack.size() * 2);
+  for (size_t i = 0, e = StateStack.size(); i != e; ++i)
+    write("  ");
 }
 
 //===----------------------------------------------------------------------===//
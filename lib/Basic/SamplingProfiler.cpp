@@ -0,0 +1,209 @@
+//===--- SamplingProfiler.cpp - In-process stack sampling -----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/SamplingProfiler.h"
+#include "swift/Demangling/Demangle.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#if defined(__APPLE__) || defined(__GLIBC__)
+#define SWIFT_HAVE_SAMPLING_PROFILER 1
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+using namespace swift;
+
+#ifdef SWIFT_HAVE_SAMPLING_PROFILER
+
+namespace {
+
+/// Sampling interval: 100 samples per second of CPU time.
+constexpr unsigned SampleIntervalUSec = 10000;
+
+/// Maximum frames captured per sample.
+constexpr unsigned MaxFramesPerSample = 64;
+
+/// Caps on preallocated sample storage: the SIGPROF handler may only write
+/// into fixed buffers, so sampling stops silently once these fill.  Half a
+/// million frames covers several minutes of deep compiler stacks.
+constexpr unsigned MaxSamples = 1 << 16;
+constexpr unsigned MaxRecordedFrames = 1 << 19;
+
+// All state is file-static because a signal handler has to reach it.  Only
+// the handler writes while sampling is active; the main thread reads after
+// the timer and handler have been torn down.
+void **RecordedFrames = nullptr;
+uint8_t *SampleDepths = nullptr;
+volatile unsigned NumSamples = 0;
+volatile unsigned NumRecordedFrames = 0;
+
+struct sigaction SavedAction;
+
+void sampleHandler(int) {
+  if (NumSamples >= MaxSamples ||
+      NumRecordedFrames + MaxFramesPerSample > MaxRecordedFrames)
+    return;
+  int depth = ::backtrace(RecordedFrames + NumRecordedFrames,
+                          MaxFramesPerSample);
+  if (depth <= 0)
+    return;
+  SampleDepths[NumSamples] = static_cast<uint8_t>(depth);
+  NumRecordedFrames += depth;
+  ++NumSamples;
+}
+
+bool startSampling() {
+  RecordedFrames =
+      static_cast<void **>(std::calloc(MaxRecordedFrames, sizeof(void *)));
+  SampleDepths = static_cast<uint8_t *>(std::calloc(MaxSamples, 1));
+  if (!RecordedFrames || !SampleDepths)
+    return false;
+
+  // backtrace() may allocate on first use; take one sample now, outside the
+  // signal handler, to force that initialization.
+  void *scratch[2];
+  (void)::backtrace(scratch, 2);
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = sampleHandler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &SavedAction))
+    return false;
+
+  struct itimerval interval;
+  interval.it_interval.tv_sec = 0;
+  interval.it_interval.tv_usec = SampleIntervalUSec;
+  interval.it_value = interval.it_interval;
+  if (setitimer(ITIMER_PROF, &interval, nullptr)) {
+    sigaction(SIGPROF, &SavedAction, nullptr);
+    return false;
+  }
+  return true;
+}
+
+void stopSampling() {
+  struct itimerval disarm;
+  std::memset(&disarm, 0, sizeof(disarm));
+  setitimer(ITIMER_PROF, &disarm, nullptr);
+  sigaction(SIGPROF, &SavedAction, nullptr);
+}
+
+/// Return a human-readable name for the function containing \p addr,
+/// memoized in \p cache.
+StringRef symbolFor(void *addr,
+                    llvm::DenseMap<void *, std::string> &cache) {
+  auto known = cache.find(addr);
+  if (known != cache.end())
+    return known->second;
+
+  std::string &name = cache[addr];
+  Dl_info info;
+  if (dladdr(addr, &info) && info.dli_sname) {
+    StringRef mangled = info.dli_sname;
+    // The Swift demangler hands back the input unchanged for symbols it
+    // does not understand; fall back to the C++ demangler for those.
+    name = Demangle::demangleSymbolAsString(mangled);
+    if (name == mangled) {
+      int status = 0;
+      if (char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr,
+                                                nullptr, &status)) {
+        name = demangled;
+        std::free(demangled);
+      }
+    }
+  } else {
+    name = "<unknown>";
+  }
+  // Frame separators are structural in the collapsed format.
+  std::replace(name.begin(), name.end(), ';', ',');
+  return name;
+}
+
+void writeCollapsedStacks(StringRef outputPath) {
+  // The leaf-most frames of every sample are the handler and the signal
+  // trampoline; they carry no information about the profiled work.
+  constexpr unsigned LeadingJunkFrames = 2;
+
+  llvm::DenseMap<void *, std::string> symbolCache;
+  llvm::StringMap<unsigned> stacks;
+  unsigned frameIndex = 0;
+  for (unsigned i = 0; i != NumSamples; ++i) {
+    unsigned depth = SampleDepths[i];
+    std::string stack;
+    // backtrace() records leaf first; the collapsed format wants the root
+    // first.
+    for (unsigned frame = depth; frame > LeadingJunkFrames; --frame) {
+      if (!stack.empty())
+        stack += ';';
+      stack += symbolFor(RecordedFrames[frameIndex + frame - 1], symbolCache);
+    }
+    frameIndex += depth;
+    if (!stack.empty())
+      ++stacks[stack];
+  }
+
+  std::error_code EC;
+  llvm::raw_fd_ostream out(outputPath, EC, llvm::sys::fs::F_None);
+  if (EC) {
+    llvm::errs() << "warning: unable to write frontend profile to '"
+                 << outputPath << "': " << EC.message() << "\n";
+    return;
+  }
+  for (auto &entry : stacks)
+    out << entry.getKey() << " " << entry.getValue() << "\n";
+}
+
+void freeSampleStorage() {
+  std::free(RecordedFrames);
+  std::free(SampleDepths);
+  RecordedFrames = nullptr;
+  SampleDepths = nullptr;
+  NumSamples = 0;
+  NumRecordedFrames = 0;
+}
+
+} // end anonymous namespace
+
+SamplingProfiler::SamplingProfiler(StringRef outputPath)
+    : OutputPath(outputPath) {
+  assert(!RecordedFrames && "only one SamplingProfiler may exist at a time");
+  Active = startSampling();
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  if (Active) {
+    stopSampling();
+    writeCollapsedStacks(OutputPath);
+  }
+  freeSampleStorage();
+}
+
+#else // !SWIFT_HAVE_SAMPLING_PROFILER
+
+SamplingProfiler::SamplingProfiler(StringRef outputPath)
+    : OutputPath(outputPath), Active(false) {}
+
+SamplingProfiler::~SamplingProfiler() {}
+
+#endif
@@ -15,6 +15,8 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace swift;
 
@@ -189,6 +191,41 @@ StringRef SourceManager::extractText(CharSourceRange Range,
                        Range.getByteLength());
 }
 
+ArrayRef<unsigned> SourceManager::getLineStartOffsets(unsigned BufferID) const {
+  auto known = LineStartOffsets.find(BufferID);
+  if (known != LineStartOffsets.end())
+    return known->second;
+
+  // Build the table with a single scan of the buffer.  memchr gives us a
+  // vectorized newline search; this is the only full pass over the buffer
+  // line queries ever make.
+  StringRef Buffer = LLVMSourceMgr.getMemoryBuffer(BufferID)->getBuffer();
+  auto &offsets = LineStartOffsets[BufferID];
+  offsets.push_back(0);
+  const char *start = Buffer.begin();
+  const char *end = Buffer.end();
+  const char *ptr = start;
+  while ((ptr = static_cast<const char *>(memchr(ptr, '\n', end - ptr)))) {
+    ++ptr;
+    offsets.push_back(ptr - start);
+  }
+  return offsets;
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::findLineAndColumn(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  auto lineStarts = getLineStartOffsets(BufferID);
+  unsigned offset = getLocOffsetInBuffer(Loc, BufferID);
+
+  // The location's line begins at the last line start not after it.
+  auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset);
+  unsigned line = it - lineStarts.begin();
+  return { line, offset - lineStarts[line - 1] + 1 };
+}
+
 unsigned SourceManager::findBufferContainingLoc(SourceLoc Loc) const {
   assert(Loc.isValid());
   // Search the buffers back-to front, so later alias buffers are
@@ -298,29 +335,22 @@ llvm::Optional<unsigned> SourceManager::resolveFromLineCol(unsigned BufferId,
   if (Line == 0 || Col == 0) {
     return None;
   }
-  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
-  const char *Ptr = InputBuf->getBufferStart();
-  const char *End = InputBuf->getBufferEnd();
-  const char *LineStart = Ptr;
-  for (; Ptr < End; ++Ptr) {
-    if (*Ptr == '\n') {
-      --Line;
-      if (Line == 0)
-        break;
-      LineStart = Ptr+1;
-    }
-  }
-  if (Line != 0) {
+  auto LineStarts = getLineStartOffsets(BufferId);
+
+  // The requested line must be terminated by a newline; the line starting
+  // at LineStarts[Line] marks where it ended.
+  if (Line >= LineStarts.size()) {
     return None;
   }
-  Ptr = LineStart;
-  for (; Ptr < End; ++Ptr) {
-    --Col;
-    if (Col == 0)
-      return Ptr - InputBuf->getBufferStart();
-    if (*Ptr == '\n')
-      break;
+  unsigned LineStart = LineStarts[Line - 1];
+  unsigned LineEnd = LineStarts[Line] - 1;
+
+  // Columns count bytes from the line start; the terminating newline
+  // itself is addressable.
+  unsigned Offset = LineStart + (Col - 1);
+  if (Offset > LineEnd) {
+    return None;
   }
-  return None;
+  return Offset;
 }
 
@@ -12,6 +12,7 @@
 
 #include "swift/Basic/Statistic.h"
 #include "swift/Driver/DependencyGraph.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
@@ -70,6 +71,12 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeTraceRingFileName(StringRef ProgramName,
+                      StringRef AuxName) {
+  return makeFileName("trace", ProgramName, AuxName, "bin");
+}
+
 // LLVM's statistics-reporting machinery is sensitive to filenames containing
 // YAML-quote-requiring characters, which occur surprisingly often in the wild;
 // we only need a recognizable and likely-unique name for a target here, not an
@@ -147,18 +154,28 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    TraceRingFilename(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     Timer(make_unique<NamedRegionTimer>(AuxName,
                                         "Building Target",
                                         ProgramName, "Running Program")),
-    SourceMgr(SM)
+    SourceMgr(SM),
+    NextTraceRingSlot(0),
+    TraceRingWrapped(false)
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(TraceRingFilename, makeTraceRingFileName(ProgramName, AuxName));
   EnableStatistics(/*PrintOnExit=*/false);
   SharedTimer::enableCompilationTimers();
   if (TraceEvents)
     LastTracedFrontendCounters = make_unique<AlwaysOnFrontendCounters>();
+
+  // The binary trace ring is cheap enough for production builds, so it can
+  // be switched on from the environment without plumbing a new flag into
+  // every CI configuration.
+  if (Process::GetEnv("SWIFT_STATS_TRACE_RING"))
+    enableTraceEventRing();
 }
 
 UnifiedStatsReporter::AlwaysOnDriverCounters &
@@ -185,6 +202,16 @@ UnifiedStatsReporter::getFrontendRecursiveSharedTimers() {
   return *FrontendRecursiveSharedTimers;
 }
 
+void
+UnifiedStatsReporter::enableTraceEventRing(size_t MaxEvents) {
+  if (!TraceRing.empty())
+    return;
+  assert(MaxEvents != 0);
+  TraceRing.resize(MaxEvents);
+  if (!LastTracedFrontendCounters)
+    LastTracedFrontendCounters = make_unique<AlwaysOnFrontendCounters>();
+}
+
 void
 UnifiedStatsReporter::noteCurrentProcessExitStatus(int status) {
   assert(!currentProcessExitStatusSet);
@@ -317,21 +344,90 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
   auto NowUS = uint64_t(1000000.0 * Now.getProcessTime());
   auto LiveUS = IsEntry ? 0 : NowUS - StartUS;
   auto &C = getFrontendCounters();
+  bool UseRing = !TraceRing.empty();
 #define FRONTEND_STATISTIC(TY, NAME)                          \
   do {                                                        \
     auto delta = C.NAME - LastTracedFrontendCounters->NAME;   \
     static char const *name = #TY "." #NAME;                  \
     if (delta != 0) {                                         \
       LastTracedFrontendCounters->NAME = C.NAME;              \
-      FrontendStatsEvents.emplace_back(FrontendStatsEvent {   \
-          NowUS, LiveUS, IsEntry, T.Name, name,               \
-            delta, C.NAME, T.Range});                         \
+      if (UseRing) {                                          \
+        TraceRing[NextTraceRingSlot] = TraceRingEvent {       \
+          NowUS, LiveUS, T.Name, name, delta, C.NAME,         \
+            IsEntry};                                         \
+        if (++NextTraceRingSlot == TraceRing.size()) {        \
+          NextTraceRingSlot = 0;                              \
+          TraceRingWrapped = true;                            \
+        }                                                     \
+      } else {                                                \
+        FrontendStatsEvents.emplace_back(FrontendStatsEvent { \
+            NowUS, LiveUS, IsEntry, T.Name, name,             \
+              delta, C.NAME, T.Range});                       \
+      }                                                       \
     }                                                         \
   } while (0);
 #include "swift/Basic/Statistics.def"
 #undef FRONTEND_STATISTIC
 }
 
+// The binary trace format is, in order:
+//   - an 8-byte magic-and-version tag, "SWTRACE1"
+//   - the number of events, as a little-endian 64-bit count
+//   - that many 56-byte event records, oldest first, each of seven
+//     little-endian 64-bit fields: timestamp (usec), live time (usec),
+//     event-name string id, counter-name string id, entry flag,
+//     counter delta, counter value
+//   - a string table: a 64-bit string count, then each string as a
+//     64-bit length followed by its bytes
+void
+UnifiedStatsReporter::flushTraceEventRing() {
+  std::error_code EC;
+  raw_fd_ostream out(TraceRingFilename, EC, fs::F_None);
+  if (EC) {
+    llvm::errs() << "Error opening -stats-output-dir file '"
+                 << TraceRingFilename << "' for writing\n";
+    return;
+  }
+
+  auto writeU64 = [&out](uint64_t value) {
+    char bytes[8];
+    for (unsigned i = 0; i != 8; ++i)
+      bytes[i] = char((value >> (i * 8)) & 0xff);
+    out.write(bytes, 8);
+  };
+
+  // Intern the event and counter names in first-use order.
+  llvm::StringMap<uint64_t> stringIDs;
+  std::vector<StringRef> strings;
+  auto internString = [&](StringRef str) -> uint64_t {
+    auto inserted = stringIDs.insert({str, strings.size()});
+    if (inserted.second)
+      strings.push_back(str);
+    return inserted.first->second;
+  };
+
+  size_t numEvents = TraceRingWrapped ? TraceRing.size() : NextTraceRingSlot;
+  size_t oldest = TraceRingWrapped ? NextTraceRingSlot : 0;
+
+  out << "SWTRACE1";
+  writeU64(numEvents);
+  for (size_t i = 0; i != numEvents; ++i) {
+    auto &E = TraceRing[(oldest + i) % TraceRing.size()];
+    writeU64(E.TimeUSec);
+    writeU64(E.LiveUSec);
+    writeU64(internString(E.EventName));
+    writeU64(internString(E.CounterName));
+    writeU64(E.IsEntry ? 1 : 0);
+    writeU64(E.CounterDelta);
+    writeU64(E.CounterValue);
+  }
+  writeU64(strings.size());
+  for (auto str : strings) {
+    writeU64(str.size());
+    out << str;
+  }
+}
+
 UnifiedStatsReporter::AlwaysOnFrontendRecursiveSharedTimers::
     AlwaysOnFrontendRecursiveSharedTimers()
     :
@@ -431,6 +527,9 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
       tstream << '"' << '\n';
     }
   }
+
+  if (!TraceRing.empty())
+    flushTraceEventRing();
 }
 
 } // namespace swift
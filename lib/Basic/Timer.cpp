@@ -11,7 +11,130 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Basic/Timer.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 
 using namespace swift;
 
 SharedTimer::State SharedTimer::CompilationTimersEnabled = State::Initial;
+
+namespace {
+
+/// One SharedTimer scope recorded in the phase trace.
+struct Phase {
+  std::string Name;
+  uint64_t StartUSec;
+  uint64_t DurationUSec;
+
+  /// Index of the dynamically enclosing phase, or ~0U for roots.  Not
+  /// written to the trace file (the viewer reconstructs nesting from the
+  /// timestamps), but kept so the structure survives clock granularity.
+  unsigned Parent;
+};
+
+/// Process-wide phase tracing state, created on the first SharedTimer when
+/// SWIFT_PHASE_TRACE is set, and flushed to a chrome://tracing JSON file
+/// when the process exits.
+struct PhaseTraceState {
+  std::string OutputPath;
+  std::chrono::steady_clock::time_point StartTime;
+  std::vector<Phase> Phases;
+
+  /// Index of the innermost open phase, or ~0U at top level.
+  unsigned CurrentParent = ~0U;
+
+  explicit PhaseTraceState(std::string Path)
+      : OutputPath(std::move(Path)),
+        StartTime(std::chrono::steady_clock::now()) {
+    // Entering and exiting a scope should cost no more than a clock read
+    // and a vector append; reserve enough that typical invocations never
+    // reallocate.
+    Phases.reserve(4096);
+  }
+
+  ~PhaseTraceState() { flush(); }
+
+  uint64_t nowUSec() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - StartTime)
+        .count();
+  }
+
+  void flush();
+};
+
+} // end anonymous namespace
+
+static uint64_t getTracePID() {
+#ifdef HAVE_UNISTD_H
+  return ::getpid();
+#else
+  return 1;
+#endif
+}
+
+void PhaseTraceState::flush() {
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(OutputPath, EC, llvm::sys::fs::F_None);
+  if (EC)
+    return;
+  // Emit complete-duration events ("ph":"X") on a single thread; the trace
+  // viewer nests them by timestamp.  Durations of still-open phases are
+  // left at zero.
+  uint64_t PID = getTracePID();
+  OS << "{\"traceEvents\":[";
+  for (size_t i = 0, e = Phases.size(); i != e; ++i) {
+    const Phase &P = Phases[i];
+    if (i != 0)
+      OS << ",";
+    OS << "\n{\"name\":\"";
+    OS.write_escaped(P.Name);
+    OS << "\",\"cat\":\"swift\",\"ph\":\"X\""
+       << ",\"ts\":" << P.StartUSec
+       << ",\"dur\":" << P.DurationUSec
+       << ",\"pid\":" << PID
+       << ",\"tid\":1}";
+  }
+  OS << "\n]}\n";
+}
+
+static PhaseTraceState *getPhaseTraceState() {
+  static bool Checked = false;
+  static llvm::Optional<PhaseTraceState> State;
+  if (!Checked) {
+    Checked = true;
+    if (auto Path = llvm::sys::Process::GetEnv("SWIFT_PHASE_TRACE"))
+      State.emplace(std::move(*Path));
+  }
+  return State ? State.getPointer() : nullptr;
+}
+
+void SharedTimer::beginPhase(StringRef name) {
+  PhaseTraceState *State = getPhaseTraceState();
+  if (!State)
+    return;
+  PhaseIndex = State->Phases.size();
+  // Copy the name: some callers time per-file phases with locally formatted
+  // names that do not outlive the scope.
+  State->Phases.push_back({name.str(), State->nowUSec(), 0,
+                           State->CurrentParent});
+  State->CurrentParent = PhaseIndex;
+}
+
+void SharedTimer::endPhase() {
+  if (PhaseIndex == ~0U)
+    return;
+  PhaseTraceState *State = getPhaseTraceState();
+  Phase &P = State->Phases[PhaseIndex];
+  P.DurationUSec = State->nowUSec() - P.StartUSec;
+  State->CurrentParent = P.Parent;
+}
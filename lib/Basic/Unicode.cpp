@@ -14,6 +14,8 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ConvertUTF.h"
 
+#include <cstring>
+
 using namespace swift;
 
 // HACK: Allow support for many newer emoji by overriding behavior of ZWJ and
@@ -112,7 +114,30 @@ unsigned swift::unicode::extractFirstUnicodeScalar(StringRef S) {
   return Scalar;
 }
 
+/// Check whether every byte of the string is ASCII, a machine word at a
+/// time. String literals overwhelmingly are, and the transcoding fallback
+/// below allocates a buffer and walks the string byte by byte.
+static bool isAllASCII(StringRef Str) {
+  size_t i = 0, n = Str.size();
+  const char *p = Str.data();
+  while (i + sizeof(uintptr_t) <= n) {
+    uintptr_t chunk;
+    memcpy(&chunk, p + i, sizeof(uintptr_t));
+    if (chunk & (uintptr_t)0x8080808080808080ull)
+      return false;
+    i += sizeof(uintptr_t);
+  }
+  for (; i != n; ++i)
+    if ((unsigned char)p[i] >= 0x80)
+      return false;
+  return true;
+}
+
 uint64_t swift::unicode::getUTF16Length(StringRef Str) {
+  // ASCII transcodes one-to-one.
+  if (isAllASCII(Str))
+    return Str.size();
+
   uint64_t Length;
   // Transcode the string to UTF-16 to get its length.
   SmallVector<llvm::UTF16, 128> buffer(Str.size() + 1); // +1 for ending nulls.
@@ -29,6 +29,7 @@
 #include "swift/AST/Types.h"
 #include "swift/Basic/Platform.h"
 #include "swift/Basic/Range.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Basic/StringExtras.h"
 #include "swift/Basic/Version.h"
 #include "swift/ClangImporter/ClangImporterOptions.h"
@@ -3118,7 +3119,15 @@ void ClangImporter::Implementation::lookupValue(
   auto &clangCtx = getClangASTContext();
   auto clangTU = clangCtx.getTranslationUnitDecl();
 
-  for (auto entry : table.lookup(name.getBaseName(), clangTU)) {
+  auto entries = table.lookup(name.getBaseName(), clangTU);
+  if (SwiftContext.Stats) {
+    auto &counters = SwiftContext.Stats->getFrontendCounters();
+    if (entries.empty())
+      counters.NumLookupTableMisses++;
+    else
+      counters.NumLookupTableHits++;
+  }
+  for (auto entry : entries) {
     // If the entry is not visible, skip it.
     if (!isVisibleClangEntry(clangCtx, entry)) continue;
 
@@ -7674,14 +7674,28 @@ Decl *ClangImporter::Implementation::importDeclAndCacheImpl(
     return Known;
   }
 
+  if (FailedImportedDecls.count({Canon, version}))
+    return nullptr;
+
   bool TypedefIsSuperfluous = false;
   bool HadForwardDeclaration = false;
 
   ImportingEntityRAII ImportingEntity(*this);
   Decl *Result = importDeclImpl(ClangDecl, version, TypedefIsSuperfluous,
                                 HadForwardDeclaration);
-  if (!Result)
+  if (!Result) {
+    // As with importMirroredDecl below, a conversion failure that did not
+    // involve a forward declaration will repeat, so remember it rather than
+    // redoing the conversion on every request for this declaration.
+    if (!HadForwardDeclaration)
+      FailedImportedDecls.insert({Canon, version});
+    if (SwiftContext.Stats)
+      SwiftContext.Stats->getFrontendCounters().NumClangDeclImportsFailed++;
     return nullptr;
+  }
+
+  if (SwiftContext.Stats)
+    SwiftContext.Stats->getFrontendCounters().NumClangDeclsImported++;
 
   if (TypedefIsSuperfluous) {
     SuperfluousTypedefs.insert(Canon);
@@ -27,6 +27,7 @@
 #include "swift/AST/NameLookup.h"
 #include "swift/AST/Types.h"
 #include "swift/AST/TypeRepr.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Basic/StringExtras.h"
 #include "swift/ClangImporter/ClangImporterOptions.h"
 #include "swift/Parse/Parser.h"
@@ -1347,7 +1348,14 @@ ImportedName NameImporter::importNameImpl(const clang::NamedDecl *D,
                                    moduleIsInferImportAsMember(D, clangSema)) &&
              (isa<clang::VarDecl>(D) || isa<clang::FunctionDecl>(D)) &&
              dc->isTranslationUnit()) {
-    auto inference = IAMResult::infer(swiftCtx, clangSema, D);
+    // The inference is independent of the name version, so reuse the result
+    // computed for an earlier version of the same declaration.
+    auto cached = importAsMemberCache.find(D);
+    if (cached == importAsMemberCache.end())
+      cached = importAsMemberCache
+                   .insert({D, IAMResult::infer(swiftCtx, clangSema, D)})
+                   .first;
+    const IAMResult &inference = cached->second;
     if (inference.isImportAsMember()) {
       result.info.importAsMember = true;
       result.declName = inference.name;
@@ -1763,11 +1771,18 @@ ImportedName NameImporter::importName(const clang::NamedDecl *decl,
                                       ImportNameVersion version,
                                       clang::DeclarationName givenName) {
   CacheKeyType key(decl, version);
-  if (importNameCache.count(key) && !givenName) {
-    ++ImportNameNumCacheHits;
-    return importNameCache[key];
+  if (!givenName) {
+    auto known = importNameCache.find(key);
+    if (known != importNameCache.end()) {
+      ++ImportNameNumCacheHits;
+      if (swiftCtx.Stats)
+        swiftCtx.Stats->getFrontendCounters().NumImportNameCacheHits++;
+      return known->second;
+    }
   }
   ++ImportNameNumCacheMisses;
+  if (swiftCtx.Stats)
+    swiftCtx.Stats->getFrontendCounters().NumImportNameCacheMisses++;
   auto res = importNameImpl(decl, version, givenName);
   if (!givenName)
     importNameCache[key] = res;
@@ -17,6 +17,7 @@
 #ifndef SWIFT_IMPORT_NAME_H
 #define SWIFT_IMPORT_NAME_H
 
+#include "IAMInference.h"
 #include "ImportEnumInfo.h"
 #include "SwiftLookupTable.h"
 #include "swift/Basic/StringExtras.h"
@@ -293,6 +294,12 @@ class NameImporter {
   llvm::DenseMap<std::pair<const clang::ObjCInterfaceDecl *, char>,
                  std::unique_ptr<InheritedNameSet>> allProperties;
 
+  /// Import-as-member inference results for global C declarations.  The
+  /// inference does not depend on the name version, but importNameImpl runs
+  /// once per version, so without this cache the string matching and Clang
+  /// lookups it performs would repeat for every version of every global.
+  llvm::DenseMap<const clang::NamedDecl *, IAMResult> importAsMemberCache;
+
 public:
   NameImporter(ASTContext &ctx, const PlatformAvailability &avail,
                clang::Sema &cSema, bool inferIAM)
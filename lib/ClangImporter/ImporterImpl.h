@@ -358,6 +358,14 @@ public:
   /// \brief Mapping of already-imported declarations.
   llvm::DenseMap<std::pair<const clang::Decl *, Version>, Decl *> ImportedDecls;
 
+  /// \brief Declarations that a previous attempt failed to import under the
+  /// given name version, with no forward declaration involved.
+  ///
+  /// Such failures are deterministic unless they stem from an incomplete type
+  /// that a later-loaded module may complete, so repeated requests for these
+  /// declarations can skip the conversion entirely.
+  llvm::DenseSet<std::pair<const clang::Decl *, Version>> FailedImportedDecls;
+
   /// \brief The set of "special" typedef-name declarations, which are
   /// mapped to specific Swift types.
   ///
@@ -584,9 +584,13 @@ SwiftLookupTable::lookupGlobalsAsMembers(EffectiveClangContext context) {
 
 SmallVector<SwiftLookupTable::SingleEntry, 4>
 SwiftLookupTable::allGlobalsAsMembers() {
-  // If we have a reader, deserialize all of the globals-as-members data.
+  // If we have a reader, deserialize all of the globals-as-members data,
+  // enumerating the serialized table's contexts only once.
   if (Reader) {
-    for (auto context : Reader->getGlobalsAsMembersContexts()) {
+    if (!SerializedGlobalsAsMembersContexts)
+      SerializedGlobalsAsMembersContexts =
+        Reader->getGlobalsAsMembersContexts();
+    for (auto context : *SerializedGlobalsAsMembersContexts) {
       (void)lookupGlobalsAsMembers(context);
     }
   }
@@ -621,8 +625,13 @@ SwiftLookupTable::lookup(SerializedSwiftName baseName,
 }
 
 SmallVector<SerializedSwiftName, 4> SwiftLookupTable::allBaseNames() {
-  // If we have a reader, enumerate its base names.
-  if (Reader) return Reader->getBaseNames();
+  // If we have a reader, enumerate its base names.  The serialized table
+  // never changes, so only walk its buckets once.
+  if (Reader) {
+    if (!SerializedBaseNames)
+      SerializedBaseNames = Reader->getBaseNames();
+    return *SerializedBaseNames;
+  }
 
   // Otherwise, walk the lookup table.
   SmallVector<SerializedSwiftName, 4> result;
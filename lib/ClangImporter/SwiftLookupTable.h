@@ -396,6 +396,19 @@ private:
   /// The reader responsible for lazily loading the contents of this table.
   SwiftLookupTableReader *Reader;
 
+  /// All base names stored in the serialized table, enumerated once on
+  /// demand.
+  ///
+  /// Enumerating the keys of the on-disk hash table touches every bucket,
+  /// so operations that walk the whole table (visible-decl enumeration does
+  /// this once per query) should not repeat it.
+  llvm::Optional<SmallVector<SerializedSwiftName, 4>> SerializedBaseNames;
+
+  /// All globals-as-members contexts stored in the serialized table,
+  /// likewise enumerated once on demand.
+  llvm::Optional<SmallVector<StoredContext, 4>>
+    SerializedGlobalsAsMembersContexts;
+
   /// Entries whose effective contexts could not be resolved, and
   /// therefore will need to be added later.
   SmallVector<std::tuple<DeclName, SingleEntry, EffectiveClangContext>, 4>
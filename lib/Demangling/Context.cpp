@@ -17,9 +17,63 @@
 #include "swift/Demangling/Demangler.h"
 #include "swift/Demangling/ManglingMacros.h"
 
+#include <list>
+#include <unordered_map>
+
 namespace swift {
 namespace Demangle {
 
+//////////////////////////////////
+// Symbol demangling cache      //
+//////////////////////////////////
+
+/// An LRU cache of printed demanglings, keyed by the mangled name.
+class SymbolDemangleCache {
+  struct Entry {
+    std::string MangledName;
+    std::string Demangled;
+  };
+
+  size_t Capacity;
+
+  /// Entries in most-recently-used-first order.
+  std::list<Entry> Entries;
+
+  /// Indexes Entries by mangled name.
+  std::unordered_map<std::string, std::list<Entry>::iterator> EntryMap;
+
+  DemangleCacheStats Stats;
+
+public:
+  SymbolDemangleCache(size_t Capacity) : Capacity(Capacity) {}
+
+  DemangleCacheStats getStats() const { return Stats; }
+
+  /// Look up the demangling of \p MangledName, or null if it is not
+  /// cached. A hit moves the entry to the front of the LRU order.
+  const std::string *lookup(llvm::StringRef MangledName) {
+    auto It = EntryMap.find(MangledName.str());
+    if (It == EntryMap.end()) {
+      ++Stats.Misses;
+      return nullptr;
+    }
+    ++Stats.Hits;
+    Entries.splice(Entries.begin(), Entries, It->second);
+    return &It->second->Demangled;
+  }
+
+  /// Add the demangling of \p MangledName, evicting the least recently
+  /// used entry if the cache is full.
+  void insert(llvm::StringRef MangledName, const std::string &Demangled) {
+    Entries.push_front(Entry{MangledName.str(), Demangled});
+    EntryMap[Entries.front().MangledName] = Entries.begin();
+    if (Entries.size() > Capacity) {
+      EntryMap.erase(Entries.back().MangledName);
+      Entries.pop_back();
+    }
+  }
+};
+
 //////////////////////////////////
 // Context member functions     //
 //////////////////////////////////
@@ -28,13 +82,27 @@ Context::Context() : D(new Demangler) {
 }
 
 Context::~Context() {
+  delete Cache;
   delete D;
 }
 
 void Context::clear() {
+  // The symbol cache intentionally survives a clear(): it holds plain
+  // strings, not nodes owned by the demangler.
   D->clear();
 }
 
+void Context::enableSymbolCache(size_t Capacity) {
+  if (!Cache)
+    Cache = new SymbolDemangleCache(Capacity);
+}
+
+DemangleCacheStats Context::getSymbolCacheStats() const {
+  if (!Cache)
+    return DemangleCacheStats();
+  return Cache->getStats();
+}
+
 NodePointer Context::demangleSymbolAsNode(llvm::StringRef MangledName) {
   if (isMangledName(MangledName)) {
     return D->demangleSymbol(MangledName);
@@ -48,12 +116,22 @@ NodePointer Context::demangleTypeAsNode(llvm::StringRef MangledName) {
 
 std::string Context::demangleSymbolAsString(llvm::StringRef MangledName,
                                             const DemangleOptions &Options) {
+  if (Cache) {
+    if (const std::string *Cached = Cache->lookup(MangledName))
+      return *Cached;
+  }
+
   NodePointer root = demangleSymbolAsNode(MangledName);
   if (!root) return MangledName.str();
 
   std::string demangling = nodeToString(root, Options);
   if (demangling.empty())
     return MangledName.str();
+
+  // Only successful demanglings are cached; failures just echo the input
+  // and are not worth an entry.
+  if (Cache)
+    Cache->insert(MangledName, demangling);
   return demangling;
 }
 
@@ -136,6 +136,158 @@ bool swift::Demangle::isSwiftSymbol(const char *mangledName) {
   return getManglingPrefixLength(mangledName) != 0;
 }
 
+//////////////////////////////////
+// Print-only fast path         //
+//////////////////////////////////
+
+namespace {
+
+/// An output buffer with strlcpy semantics for the print-only fast path:
+/// characters beyond the capacity are counted but not stored, and the
+/// stored part is always null-terminated.
+class FastPrintBuffer {
+  char *Buffer;
+  size_t Capacity;
+  size_t Length = 0;
+
+public:
+  FastPrintBuffer(char *buffer, size_t capacity)
+      : Buffer(buffer), Capacity(capacity) {}
+
+  void append(StringRef Str) {
+    for (char c : Str) {
+      if (Length + 1 < Capacity)
+        Buffer[Length] = c;
+      ++Length;
+    }
+  }
+
+  /// Null-terminate the stored output and return the untruncated length.
+  size_t finish() {
+    if (Capacity > 0)
+      Buffer[std::min(Length, Capacity - 1)] = 0;
+    return Length;
+  }
+};
+
+/// A scanner over the mangled text for the print-only fast path. It
+/// accepts a small subset of the mangling grammar which can be printed
+/// directly from the mangled text; everything else makes the caller fall
+/// back to the full demangler.
+class SimpleSymbolScanner {
+  const char *Ptr;
+  const char *End;
+
+public:
+  SimpleSymbolScanner(StringRef Text)
+      : Ptr(Text.begin()), End(Text.end()) {}
+
+  bool atEnd() const { return Ptr == End; }
+
+  bool nextIf(char c) {
+    if (Ptr == End || *Ptr != c)
+      return false;
+    ++Ptr;
+    return true;
+  }
+
+  /// Scan a length-prefixed identifier consisting of plain identifier
+  /// characters. Punycoded identifiers (leading '0') are left to the
+  /// full demangler.
+  bool scanIdentifier(StringRef &Text) {
+    if (Ptr == End || *Ptr < '1' || *Ptr > '9')
+      return false;
+    size_t Length = 0;
+    while (Ptr != End && isDigit(*Ptr)) {
+      Length = Length * 10 + (size_t)(*Ptr - '0');
+      if (Length > (size_t)(End - Ptr))
+        return false;
+      ++Ptr;
+    }
+    if (Length == 0 || (size_t)(End - Ptr) < Length)
+      return false;
+    Text = StringRef(Ptr, Length);
+    for (char c : Text) {
+      if (!isLetter(c) && !isDigit(c) && c != '_')
+        return false;
+    }
+    Ptr += Length;
+    return true;
+  }
+
+  /// Scan a type which the fast path knows how to print: the empty list
+  /// or a standard substitution for a non-generic standard library type.
+  /// Generic standard types (Array, Optional, ...) are excluded because
+  /// their printing depends on the sugaring options. On success, \p
+  /// Printed is the printed form, empty for the empty list.
+  bool scanSimpleType(StringRef &Printed) {
+    if (nextIf('y')) {
+      Printed = StringRef();
+      return true;
+    }
+    if (!nextIf('S'))
+      return false;
+    if (Ptr == End)
+      return false;
+    switch (*Ptr) {
+      case 'b': Printed = "Swift.Bool"; break;
+      case 'c': Printed = "Swift.UnicodeScalar"; break;
+      case 'd': Printed = "Swift.Double"; break;
+      case 'f': Printed = "Swift.Float"; break;
+      case 'i': Printed = "Swift.Int"; break;
+      case 'V': Printed = "Swift.UnsafeRawPointer"; break;
+      case 'v': Printed = "Swift.UnsafeMutableRawPointer"; break;
+      case 'P': Printed = "Swift.UnsafePointer"; break;
+      case 'p': Printed = "Swift.UnsafeMutablePointer"; break;
+      case 'R': Printed = "Swift.UnsafeBufferPointer"; break;
+      case 'r': Printed = "Swift.UnsafeMutableBufferPointer"; break;
+      case 'S': Printed = "Swift.String"; break;
+      case 'u': Printed = "Swift.UInt"; break;
+      default: return false;
+    }
+    ++Ptr;
+    return true;
+  }
+};
+
+} // anonymous namespace
+
+size_t swift::Demangle::fastDemangleSymbolAsString(const char *MangledName,
+                                                   char *OutputBuffer,
+                                                   size_t OutputBufferLength) {
+  int PrefixLength = getManglingPrefixLength(MangledName);
+  if (PrefixLength == 0)
+    return 0;
+
+  // The supported shape is a plain function in a module, with an empty
+  // parameter list or a single unlabeled parameter, and result and
+  // parameter types restricted to what scanSimpleType accepts:
+  //
+  //   <prefix> <module> <name> <result-type> <params-type> 'F'
+  //
+  // This covers a large share of symbolication traffic without building
+  // a node tree. The symbol must be consumed entirely; any unparsed
+  // suffix (generic signatures, labels, throws, thunk markers, ...)
+  // means the full demangler has to run.
+  SimpleSymbolScanner Scanner(StringRef(MangledName).substr(PrefixLength));
+  StringRef Module, Name, ResultType, ParamsType;
+  if (!Scanner.scanIdentifier(Module) || !Scanner.scanIdentifier(Name) ||
+      !Scanner.scanSimpleType(ResultType) ||
+      !Scanner.scanSimpleType(ParamsType) ||
+      !Scanner.nextIf('F') || !Scanner.atEnd())
+    return 0;
+
+  FastPrintBuffer Printer(OutputBuffer, OutputBufferLength);
+  Printer.append(Module);
+  Printer.append(".");
+  Printer.append(Name);
+  Printer.append("(");
+  Printer.append(ParamsType);
+  Printer.append(") -> ");
+  Printer.append(ResultType.empty() ? StringRef("()") : ResultType);
+  return Printer.finish();
+}
+
 namespace swift {
 namespace Demangle {
 
@@ -46,10 +46,23 @@ class SubstitutionEntry {
   bool treatAsIdentifier = false;
 
 public:
-  void setNode(Node *node, bool treatAsIdentifier) {
+  /// Memoizes the deep hash of a subtree by node identity. Demangled trees
+  /// share subtrees (substitutions in the input produce the same Node
+  /// pointer), so without memoization every trySubstitution re-traverses
+  /// shared subtrees, which is quadratic on deeply generic symbols.
+  using NodeHashes = std::unordered_map<Node *, size_t>;
+
+  void setNode(Node *node, bool treatAsIdentifier,
+               NodeHashes *hashCache = nullptr) {
     this->treatAsIdentifier = treatAsIdentifier;
     TheNode = node;
-    deepHash(node);
+    if (treatAsIdentifier) {
+      StoredHash = 0;
+      combineHash(StoredHash, (size_t) Node::Kind::Identifier);
+      combineHash(StoredHash, node->getText());
+      return;
+    }
+    StoredHash = deepHash(node, hashCache);
   }
 
   struct Hasher {
@@ -70,31 +83,35 @@ private:
     return lhs.deepEquals(lhs.TheNode, rhs.TheNode);
   }
 
-  void combineHash(size_t newValue) {
-    StoredHash = 33 * StoredHash + newValue;
+  static void combineHash(size_t &hash, size_t newValue) {
+    hash = 33 * hash + newValue;
   }
 
-  void combineHash(StringRef Text) {
+  static void combineHash(size_t &hash, StringRef Text) {
     for (char c : Text) {
-      combineHash((unsigned char) c);
+      combineHash(hash, (unsigned char) c);
     }
   }
 
-  void deepHash(Node *node) {
-    if (treatAsIdentifier) {
-      combineHash((size_t) Node::Kind::Identifier);
-      combineHash(node->getText());
-      return;
+  static size_t deepHash(Node *node, NodeHashes *hashCache) {
+    if (hashCache) {
+      auto cached = hashCache->find(node);
+      if (cached != hashCache->end())
+        return cached->second;
     }
-    combineHash((size_t) node->getKind());
+    size_t hash = 0;
+    combineHash(hash, (size_t) node->getKind());
     if (node->hasIndex()) {
-      combineHash(node->getIndex());
+      combineHash(hash, node->getIndex());
     } else if (node->hasText()) {
-      combineHash(node->getText());
+      combineHash(hash, node->getText());
     }
     for (Node *child : *node) {
-      deepHash(child);
+      combineHash(hash, deepHash(child, hashCache));
     }
+    if (hashCache)
+      (*hashCache)[node] = hash;
+    return hash;
   }
 
   bool deepEquals(Node *lhs, Node *rhs) const;
@@ -146,6 +163,9 @@ class Remangler {
   std::unordered_map<SubstitutionEntry, unsigned,
                      SubstitutionEntry::Hasher> Substitutions;
 
+  /// Deep hashes of already-visited subtrees, keyed by node identity.
+  SubstitutionEntry::NodeHashes DeepHashes;
+
   SubstitutionMerging SubstMerging;
 
   // We have to cons up temporary nodes sometimes when remangling
@@ -301,7 +321,7 @@ bool Remangler::trySubstitution(Node *node, SubstitutionEntry &entry,
     return true;
 
   // Go ahead and initialize the substitution entry.
-  entry.setNode(node, treatAsIdentifier);
+  entry.setNode(node, treatAsIdentifier, &DeepHashes);
 
   auto it = Substitutions.find(entry);
   if (it == Substitutions.end())
@@ -1855,14 +1875,19 @@ void Remangler::mangleAssocTypePath(Node *node) {
 
 /// The top-level interface to the remangler.
 std::string Demangle::mangleNode(const NodePointer &node) {
-  if (!node) return "";
-
   DemanglerPrinter printer;
-  Remangler(printer).mangle(node);
-
+  mangleNode(node, printer);
   return std::move(printer).str();
 }
 
+llvm::StringRef Demangle::mangleNode(const NodePointer &node,
+                                     DemanglerPrinter &printer) {
+  size_t StartPos = printer.getStringRef().size();
+  if (node)
+    Remangler(printer).mangle(node);
+  return printer.getStringRef().substr(StartPos);
+}
+
 bool Demangle::isSpecialized(Node *node) {
   switch (node->getKind()) {
     case Node::Kind::BoundGenericStructure:
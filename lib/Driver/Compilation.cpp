@@ -32,14 +32,22 @@
 #include "llvm/Option/ArgList.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/YAMLParser.h"
 
+#include "CompilationCache.h"
 #include "CompilationRecord.h"
 
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+
 using namespace swift;
 using namespace swift::sys;
 using namespace swift::driver;
@@ -109,6 +117,43 @@ Compilation::Compilation(DiagnosticEngine &Diags, OutputLevel Level,
 
 static bool writeFilelistIfNecessary(const Job *job, DiagnosticEngine &diags);
 
+/// Reads a per-file compile-time history file, a sidecar of the compilation
+/// record with one "path": seconds entry per line.
+static void loadTimingsRecord(StringRef path,
+                              llvm::StringMap<double> &timings) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return;
+
+  SmallVector<StringRef, 32> lines;
+  (*buffer)->getBuffer().split(lines, '\n', /*MaxSplit=*/-1,
+                               /*KeepEmpty=*/false);
+  for (StringRef line : lines) {
+    StringRef key, value;
+    std::tie(key, value) = line.rsplit(':');
+    key = key.trim().trim('"');
+    if (key.empty())
+      continue;
+    SmallString<16> valueScratch(value.trim());
+    char *parseEnd = nullptr;
+    double seconds = std::strtod(valueScratch.c_str(), &parseEnd);
+    if (parseEnd == valueScratch.c_str())
+      continue;
+    timings[key] = seconds;
+  }
+}
+
+static void writeTimingsRecord(StringRef path,
+                               const llvm::StringMap<double> &timings) {
+  std::error_code error;
+  llvm::raw_fd_ostream out(path, error, llvm::sys::fs::F_None);
+  if (out.has_error() || error)
+    return;
+
+  for (const auto &entry : timings)
+    out << "\"" << entry.getKey() << "\": " << entry.getValue() << "\n";
+}
+
 using CommandSet = llvm::SmallPtrSet<const Job *, 16>;
 
 
@@ -162,6 +207,39 @@ namespace driver {
     /// TaskQueue for execution.
     std::unique_ptr<TaskQueue> TQ;
 
+    /// Content-addressed cache of job outputs, if enabled.
+    Optional<CompilationCache> OutputCache;
+
+    /// Cache keys computed for scheduled jobs that missed the cache, so
+    /// their outputs can be stored once they finish successfully.
+    llvm::SmallDenseMap<const Job *, std::string, 16> JobCacheKeys;
+
+    /// Per-file compile durations (in seconds) recorded by the previous
+    /// build, keyed by primary input path. Used to schedule long-running
+    /// files first so a long pole is not left for the end of the build.
+    llvm::StringMap<double> HistoricalDurations;
+
+    /// When each job started, for computing this build's durations.
+    llvm::SmallDenseMap<const Job *, std::chrono::steady_clock::time_point, 16>
+        JobStartTimes;
+
+    /// Per-file compile durations measured during this build.
+    llvm::StringMap<double> MeasuredDurations;
+
+    /// Argument vectors built for jobs launched through the remote execution
+    /// wrapper. The TaskQueue keeps a reference to its arguments, so these
+    /// must live until the queue has drained.
+    llvm::SmallDenseMap<const Job *, std::vector<const char *>, 16>
+        WrappedJobArgs;
+
+    /// Returns the key under which \p Cmd's duration is recorded, or an empty
+    /// string if the job's timing is not tracked.
+    StringRef getTimingKey(const Job *Cmd) const {
+      if (!isa<CompileJobAction>(Cmd->getSource()))
+        return StringRef();
+      return Cmd->getOutput().getBaseInput(0);
+    }
+
     /// Cumulative result of PerformJobs(), accumulated from subprocesses.
     int Result = EXIT_SUCCESS;
 
@@ -221,8 +299,50 @@ namespace driver {
       assert(Cmd->getExtraEnvironment().empty() &&
              "not implemented for compilations with multiple jobs");
       ScheduledCommands.insert(Cmd);
+
+      if (OutputCache && isa<CompileJobAction>(Cmd->getSource())) {
+        if (auto Key = OutputCache->computeKey(*Cmd, Comp.getInputFiles())) {
+          if (OutputCache->restoreOutputs(*Key, *Cmd)) {
+            if (Comp.ShowJobLifecycle)
+              llvm::outs() << "Restored from cache: " << LogJob(Cmd) << "\n";
+
+            // The restored outputs include the job's .swiftdeps file, so
+            // treat this exactly like a successful run of the job.
+            SmallVector<const Job *, 16> Dependents;
+            if (Comp.getIncrementalBuildEnabled())
+              reloadAndRemarkDeps(Cmd, EXIT_SUCCESS, Dependents);
+            markFinished(Cmd);
+            for (const Job *Dependent : Dependents) {
+              DeferredCommands.erase(Dependent);
+              noteBuilding(Dependent,
+                           "because of dependencies discovered later");
+              scheduleCommandIfNecessaryAndPossible(Dependent);
+            }
+            return;
+          }
+          JobCacheKeys[Cmd] = *Key;
+        }
+      }
+
       if (Comp.ShowJobLifecycle)
         llvm::outs() << "Added to TaskQueue: " << LogJob(Cmd) << "\n";
+
+      // When a remote execution wrapper is configured, launch compile jobs
+      // through it; the wrapper receives the original command line and may
+      // run it on a remote worker. Other jobs (merge-module, link) depend on
+      // local outputs and always run locally.
+      if (!Comp.RemoteExecutionWrapper.empty() &&
+          isa<CompileJobAction>(Cmd->getSource())) {
+        auto &WrappedArgs = WrappedJobArgs[Cmd];
+        WrappedArgs.reserve(Cmd->getArguments().size() + 1);
+        WrappedArgs.push_back(Cmd->getExecutable());
+        WrappedArgs.insert(WrappedArgs.end(), Cmd->getArguments().begin(),
+                           Cmd->getArguments().end());
+        TQ->addTask(Comp.RemoteExecutionWrapper.c_str(), WrappedArgs,
+                    llvm::None, (void *)Cmd);
+        return;
+      }
+
       TQ->addTask(Cmd->getExecutable(), Cmd->getArguments(), llvm::None,
                   (void *)Cmd);
     }
@@ -261,6 +381,9 @@ namespace driver {
       // TODO: properly handle task began.
       const Job *BeganCmd = (const Job *)Context;
 
+      if (!getTimingKey(BeganCmd).empty())
+        JobStartTimes[BeganCmd] = std::chrono::steady_clock::now();
+
       if (Comp.ShowDriverTimeCompilation) {
         llvm::SmallString<128> TimerName;
         llvm::raw_svector_ostream OS(TimerName);
@@ -384,6 +507,13 @@ namespace driver {
         DriverTimers[FinishedCmd]->stopTimer();
       }
 
+      auto StartIter = JobStartTimes.find(FinishedCmd);
+      if (StartIter != JobStartTimes.end()) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - StartIter->second;
+        MeasuredDurations[getTimingKey(FinishedCmd)] = elapsed.count();
+      }
+
       if (Comp.Level == OutputLevel::Parseable) {
         // Parseable output was requested.
         parseable_output::emitFinishedMessage(llvm::errs(), *FinishedCmd, Pid,
@@ -424,6 +554,12 @@ namespace driver {
           TaskFinishedResponse::StopExecution;
       }
 
+      if (OutputCache) {
+        auto KeyIter = JobCacheKeys.find(FinishedCmd);
+        if (KeyIter != JobCacheKeys.end())
+          OutputCache->storeOutputs(KeyIter->second, *FinishedCmd);
+      }
+
       // When a task finishes, we need to reevaluate the other commands that
       // might have been blocked.
       markFinished(FinishedCmd);
@@ -488,11 +624,42 @@ namespace driver {
         TQ.reset(new TaskQueue(Comp.NumberOfParallelCommands));
       if (Comp.ShowIncrementalBuildDecisions || Comp.Stats)
         IncrementalTracer = &ActualIncrementalTracer;
+      if (!Comp.CompilationCachePath.empty() &&
+          !llvm::sys::fs::create_directories(Comp.CompilationCachePath)) {
+        OutputCache.emplace(Comp.CompilationCachePath);
+      }
+      if (!Comp.CompilationRecordPath.empty())
+        loadTimingsRecord(Comp.CompilationRecordPath + "~timings",
+                          HistoricalDurations);
     }
 
     /// Schedule all jobs we can from the initial list provided by Compilation.
     void scheduleInitialJobs() {
-      for (const Job *Cmd : Comp.getJobs()) {
+      // Visit compile jobs in descending order of their last recorded
+      // duration, so that the task queue starts the long poles first and the
+      // tail of the build is not dominated by one slow file. Files with no
+      // recorded history sort first, since their cost is unknown. Other jobs
+      // keep their relative order; they are typically blocked on the compiles
+      // anyway.
+      SmallVector<const Job *, 32> SortedJobs(Comp.getJobs().begin(),
+                                              Comp.getJobs().end());
+      if (!HistoricalDurations.empty()) {
+        auto getDuration = [this](const Job *Cmd) -> double {
+          StringRef Key = getTimingKey(Cmd);
+          if (Key.empty())
+            return -1;
+          auto iter = HistoricalDurations.find(Key);
+          if (iter == HistoricalDurations.end())
+            return std::numeric_limits<double>::infinity();
+          return iter->second;
+        };
+        std::stable_sort(SortedJobs.begin(), SortedJobs.end(),
+                         [&getDuration](const Job *LHS, const Job *RHS) {
+                           return getDuration(LHS) > getDuration(RHS);
+                         });
+      }
+
+      for (const Job *Cmd : SortedJobs) {
         if (!Comp.getIncrementalBuildEnabled()) {
           scheduleCommandIfNecessaryAndPossible(Cmd);
           continue;
@@ -688,6 +855,16 @@ namespace driver {
                            });
     }
 
+    /// Merges this build's measured compile times into the history and
+    /// writes it back out for the next build to use.
+    void writeTimings(StringRef path) {
+      if (MeasuredDurations.empty())
+        return;
+      for (const auto &entry : MeasuredDurations)
+        HistoricalDurations[entry.getKey()] = entry.getValue();
+      writeTimingsRecord(path, HistoricalDurations);
+    }
+
     int getResult() {
       if (Result == 0)
         Result = Comp.Diags.hadAnyError();
@@ -709,6 +886,51 @@ Job *Compilation::addJob(std::unique_ptr<Job> J) {
   return result;
 }
 
+void Compilation::prefetchInputModTimes() {
+  SmallVector<StringRef, 32> paths;
+  for (const InputPair &input : InputFilesWithTypes) {
+    if (types::isPartOfSwiftCompilation(input.first))
+      paths.push_back(input.second->getValue());
+  }
+  if (paths.empty())
+    return;
+
+  std::vector<llvm::sys::TimePoint<>> modTimes(
+      paths.size(), llvm::sys::TimePoint<>::max());
+
+  auto statRange = [&](size_t index) {
+    llvm::sys::fs::file_status status;
+    if (!llvm::sys::fs::status(paths[index], status))
+      modTimes[index] = status.getLastModificationTime();
+  };
+
+  // Spinning up threads is only worthwhile when there are enough files to
+  // amortize it; small modules just stat serially.
+  const size_t MinFilesPerThread = 64;
+  size_t numThreads =
+      std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                       paths.size() / MinFilesPerThread);
+  if (numThreads <= 1) {
+    for (size_t i = 0, e = paths.size(); i != e; ++i)
+      statRange(i);
+  } else {
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&] {
+      size_t i;
+      while ((i = nextIndex.fetch_add(1)) < paths.size())
+        statRange(i);
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i != numThreads; ++i)
+      threads.emplace_back(worker);
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+
+  for (size_t i = 0, e = paths.size(); i != e; ++i)
+    InputModTimeCache[paths[i]] = modTimes[i];
+}
+
 static void checkForOutOfDateInputs(DiagnosticEngine &diags,
                                     const InputInfoMap &inputs) {
   for (const auto &inputPair : inputs) {
@@ -732,9 +954,47 @@ static void checkForOutOfDateInputs(DiagnosticEngine &diags,
   }
 }
 
+/// Writes the compilation record in the compact binary format: the magic
+/// number, then the version, options hash, and build time, then one
+/// (status, mtime, path) entry per input. Strings are length-prefixed;
+/// integers are fixed-width little-endian.
+static void writeBinaryCompilationRecord(llvm::raw_ostream &out,
+                                         StringRef argsHash,
+                                         llvm::sys::TimePoint<> buildTime,
+                                         const InputInfoMap &inputs) {
+  namespace endian = llvm::support::endian;
+  endian::Writer<llvm::support::little> writer(out);
+
+  auto writeString = [&](StringRef str) {
+    writer.write<uint32_t>(str.size());
+    out << str;
+  };
+  auto writeTimeValue = [&](llvm::sys::TimePoint<> time) {
+    using namespace std::chrono;
+    auto secs = time_point_cast<seconds>(time);
+    time -= secs.time_since_epoch(); // remainder in nanoseconds
+    writer.write<int64_t>(secs.time_since_epoch().count());
+    writer.write<int64_t>(time.time_since_epoch().count());
+  };
+
+  out << compilation_record::BinaryRecordMagic;
+  writeString(version::getSwiftFullVersion(
+      swift::version::Version::getCurrentLanguageVersion()));
+  writeString(argsHash);
+  writeTimeValue(buildTime);
+  writer.write<uint32_t>(inputs.size());
+
+  for (auto &entry : inputs) {
+    writer.write<uint8_t>(entry.second.status);
+    writeTimeValue(entry.second.previousModTime);
+    writeString(entry.first->getValue());
+  }
+}
+
 static void writeCompilationRecord(StringRef path, StringRef argsHash,
                                    llvm::sys::TimePoint<> buildTime,
-                                   const InputInfoMap &inputs) {
+                                   const InputInfoMap &inputs,
+                                   bool useBinaryFormat) {
   // Before writing to the dependencies file path, preserve any previous file
   // that may have been there. No error handling -- this is just a nicety, it
   // doesn't matter if it fails.
@@ -748,6 +1008,9 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
     return;
   }
 
+  if (useBinaryFormat)
+    return writeBinaryCompilationRecord(out, argsHash, buildTime, inputs);
+
   auto writeTimeValue = [](llvm::raw_ostream &out,
                            llvm::sys::TimePoint<> time) {
     using namespace std::chrono;
@@ -836,7 +1099,8 @@ int Compilation::performJobsImpl(bool &abnormalExit) {
     State.populateInputInfoMap(InputInfo);
     checkForOutOfDateInputs(Diags, InputInfo);
     writeCompilationRecord(CompilationRecordPath, ArgsHash, BuildStartTime,
-                           InputInfo);
+                           InputInfo, UseBinaryCompilationRecord);
+    State.writeTimings(CompilationRecordPath + "~timings");
   }
 
   abnormalExit = State.hadAnyAbnormalExit();
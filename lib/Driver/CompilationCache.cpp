@@ -0,0 +1,121 @@
+//===--- CompilationCache.cpp - Content-addressed job output cache --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "CompilationCache.h"
+
+#include "swift/Basic/Version.h"
+#include "swift/Driver/Job.h"
+#include "llvm/Option/Arg.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+using namespace swift;
+using namespace swift::driver;
+
+Optional<std::string>
+CompilationCache::computeKey(const Job &Cmd,
+                             ArrayRef<InputPair> inputs) const {
+  llvm::MD5 hash;
+
+  // The compiler itself is an input: a different compiler may produce
+  // different outputs for the same command line.
+  hash.update(version::getSwiftFullVersion());
+  hash.update(Cmd.getExecutable());
+  for (const char *arg : Cmd.getArguments())
+    hash.update(arg);
+
+  // Hash the contents of every input file of the compilation, not just the
+  // job's primaries; non-primary files are parsed too and can affect the
+  // produced outputs.
+  for (const InputPair &input : inputs) {
+    auto buffer = llvm::MemoryBuffer::getFile(input.second->getValue());
+    if (!buffer)
+      return None;
+    hash.update((*buffer)->getBuffer());
+  }
+
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  SmallString<32> keyString;
+  llvm::MD5::stringifyResult(result, keyString);
+  return keyString.str().str();
+}
+
+/// Returns the path of the cached copy of \p output within \p entryDir.
+///
+/// Primary outputs are disambiguated by index since a multi-threaded compile
+/// job can have several of them.
+static void getCachedOutputPath(SmallVectorImpl<char> &result,
+                                StringRef entryDir, StringRef kind,
+                                unsigned index) {
+  result.assign(entryDir.begin(), entryDir.end());
+  llvm::sys::path::append(result, kind + "." + Twine(index).str());
+}
+
+template <typename Callback>
+static bool forEachOutput(const Job &Cmd, StringRef entryDir,
+                          Callback callback) {
+  const CommandOutput &output = Cmd.getOutput();
+  SmallString<128> cachedPath;
+
+  unsigned index = 0;
+  for (const std::string &outputFile : output.getPrimaryOutputFilenames()) {
+    getCachedOutputPath(cachedPath, entryDir, "primary", index++);
+    if (!callback(cachedPath.str(), outputFile))
+      return false;
+  }
+
+  index = 0;
+  for (const auto &additional : output.getAdditionalOutputsMap()) {
+    getCachedOutputPath(cachedPath, entryDir,
+                        types::getTypeName(additional.first), index++);
+    if (!callback(cachedPath.str(), additional.second))
+      return false;
+  }
+
+  return true;
+}
+
+bool CompilationCache::restoreOutputs(StringRef key, const Job &Cmd) const {
+  SmallString<128> entryDir(Path);
+  llvm::sys::path::append(entryDir, key);
+  if (!llvm::sys::fs::is_directory(entryDir))
+    return false;
+
+  return forEachOutput(Cmd, entryDir,
+                       [](StringRef cachedPath, StringRef outputFile) {
+    return !llvm::sys::fs::copy_file(cachedPath, outputFile);
+  });
+}
+
+void CompilationCache::storeOutputs(StringRef key, const Job &Cmd) const {
+  // Populate a temporary directory first and rename it into place, so that a
+  // concurrent build never observes a partially-written entry.
+  SmallString<128> tempDir(Path);
+  llvm::sys::path::append(tempDir, Twine(key) + ".tmp-%%%%%%");
+  if (llvm::sys::fs::createUniqueDirectory(tempDir, tempDir))
+    return;
+
+  bool complete = forEachOutput(Cmd, tempDir,
+                                [](StringRef cachedPath, StringRef outputFile) {
+    if (!llvm::sys::fs::exists(outputFile))
+      return true;
+    return !llvm::sys::fs::copy_file(outputFile, cachedPath);
+  });
+
+  SmallString<128> entryDir(Path);
+  llvm::sys::path::append(entryDir, key);
+  if (!complete || llvm::sys::fs::rename(tempDir, entryDir))
+    llvm::sys::fs::remove_directories(tempDir);
+}
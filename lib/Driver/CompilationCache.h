@@ -0,0 +1,63 @@
+//===--- CompilationCache.h -------------------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_DRIVER_COMPILATIONCACHE_H
+#define SWIFT_DRIVER_COMPILATIONCACHE_H
+
+#include "swift/Basic/LLVM.h"
+#include "swift/Driver/Util.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+
+namespace swift {
+namespace driver {
+
+class Job;
+
+/// A content-addressed, on-disk cache of job outputs.
+///
+/// Outputs are keyed by a digest of the job's command line and the contents
+/// of the compilation's input files, so two builds that would run a frontend
+/// job with identical inputs can share its .o/.swiftmodule/etc. outputs
+/// instead of re-running the job.
+class CompilationCache {
+  /// The directory holding cached outputs. One subdirectory is created per
+  /// cache key; each output file is stored under it, named by output type.
+  std::string Path;
+
+public:
+  explicit CompilationCache(StringRef path) : Path(path) {}
+
+  /// Computes the cache key for \p Cmd, given the compilation's input files.
+  ///
+  /// Returns None if any input could not be read, in which case the job
+  /// must not be cached.
+  Optional<std::string> computeKey(const Job &Cmd,
+                                   ArrayRef<InputPair> inputs) const;
+
+  /// If an entry for \p key exists, copies all of the job's outputs from the
+  /// cache into their expected locations and returns true.
+  bool restoreOutputs(StringRef key, const Job &Cmd) const;
+
+  /// Records all of the outputs produced by \p Cmd under \p key.
+  ///
+  /// Failure to populate the cache is not an error; the entry is discarded
+  /// and the next build simply re-runs the job.
+  void storeOutputs(StringRef key, const Job &Cmd) const;
+};
+
+} // end namespace driver
+} // end namespace swift
+
+#endif
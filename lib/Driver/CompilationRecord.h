@@ -14,11 +14,16 @@
 #define SWIFT_DRIVER_COMPILATIONRECORD_H
 
 #include "swift/Driver/Action.h"
+#include "llvm/ADT/StringRef.h"
 
 namespace swift {
 namespace driver {
 namespace compilation_record {
 
+/// The magic number prefixed to compilation records written in the compact
+/// binary format. Records without this prefix are parsed as YAML.
+const llvm::StringLiteral BinaryRecordMagic = llvm::StringLiteral("SWCR\x01");
+
 /// Compilation record files (.swiftdeps files) are YAML files composed of these
 /// top-level keys.
 enum class TopLevelKey {
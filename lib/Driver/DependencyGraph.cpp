@@ -50,12 +50,14 @@ using LoadResult = DependencyGraphImpl::LoadResult;
 using DependencyKind = DependencyGraphImpl::DependencyKind;
 using DependencyCallbackTy = LoadResult(StringRef, DependencyKind, bool);
 using InterfaceHashCallbackTy = LoadResult(StringRef);
+using DeclHashCallbackTy = LoadResult(StringRef, StringRef);
 
 static LoadResult
 parseDependencyFile(llvm::MemoryBuffer &buffer,
                     llvm::function_ref<DependencyCallbackTy> providesCallback,
                     llvm::function_ref<DependencyCallbackTy> dependsCallback,
-                    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback) {
+                    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback,
+                    llvm::function_ref<DeclHashCallbackTy> declHashCallback) {
   namespace yaml = llvm::yaml;
 
   // FIXME: Switch to a format other than YAML.
@@ -107,6 +109,36 @@ parseDependencyFile(llvm::MemoryBuffer &buffer,
       StringRef valueString = value->getValue(scratch);
       UPDATE_RESULT(interfaceHashCallback(valueString));
 
+    } else if (keyString == "provides-decl-hashes") {
+      // Entries come in the form ["declName", "hash"].
+      auto *entries = dyn_cast<yaml::SequenceNode>(i->getValue());
+      if (!entries)
+        return LoadResult::HadError;
+
+      for (yaml::Node &rawEntry : *entries) {
+        auto *entry = dyn_cast<yaml::SequenceNode>(&rawEntry);
+        if (!entry)
+          return LoadResult::HadError;
+
+        auto iter = entry->begin();
+        auto *name = dyn_cast<yaml::ScalarNode>(&*iter);
+        if (!name)
+          return LoadResult::HadError;
+        ++iter;
+
+        auto *hash = dyn_cast<yaml::ScalarNode>(&*iter);
+        if (!hash)
+          return LoadResult::HadError;
+        ++iter;
+
+        // FIXME: LLVM's YAML support doesn't implement == correctly for end
+        // iterators.
+        assert(!(iter != entry->end()));
+
+        SmallString<64> hashScratch;
+        UPDATE_RESULT(declHashCallback(name->getValue(scratch),
+                                       hash->getValue(hashScratch)));
+      }
     } else {
       enum class DependencyDirection : bool {
         Depends,
@@ -225,6 +257,10 @@ LoadResult DependencyGraphImpl::loadFromBuffer(const void *node,
                                                llvm::MemoryBuffer &buffer) {
   auto &provides = Provides[node];
 
+  auto &declHashes = DeclHashes[node];
+  llvm::StringMap<std::string> oldDeclHashes;
+  std::swap(oldDeclHashes, declHashes);
+
   auto dependsCallback = [this, node](StringRef name, DependencyKind kind,
                                       bool isCascading) -> LoadResult {
     if (kind == DependencyKind::ExternalFile)
@@ -287,8 +323,37 @@ LoadResult DependencyGraphImpl::loadFromBuffer(const void *node,
     return LoadResult::UpToDate;
   };
 
-  return parseDependencyFile(buffer, providesCallback, dependsCallback,
-                             interfaceHashCallback);
+  auto declHashCallback = [&declHashes](StringRef name,
+                                        StringRef hash) -> LoadResult {
+    // Concatenate rather than overwrite, so several entries for the same
+    // name (overloads) all contribute to the recorded value; the old and
+    // new maps are compared below once the whole file has been parsed.
+    declHashes[name] += hash.str();
+    return LoadResult::UpToDate;
+  };
+
+  LoadResult result = parseDependencyFile(buffer, providesCallback,
+                                          dependsCallback,
+                                          interfaceHashCallback,
+                                          declHashCallback);
+
+  // If this is a reload and the previous load recorded per-decl hashes,
+  // compute the set of declarations that provably did not change.
+  // markTransitive() uses this to avoid cascading through them. A name with
+  // no hash entry in either load is never treated as unchanged: declarations
+  // that receive no hashes (operators, precedence groups) must always
+  // cascade.
+  if (result != LoadResult::HadError && !oldDeclHashes.empty()) {
+    auto &clean = CleanDeclNames[node];
+    clean.clear();
+    for (const auto &entry : declHashes) {
+      auto old = oldDeclHashes.find(entry.getKey());
+      if (old != oldDeclHashes.end() && old->getValue() == entry.getValue())
+        clean.insert(entry.getKey());
+    }
+  }
+
+  return result;
 }
 
 void DependencyGraphImpl::markExternal(SmallVectorImpl<const void *> &visited,
@@ -323,6 +388,18 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
   SmallVector<WorklistEntry, 16> worklist;
   SmallPtrSet<const void *, 16> visitedSet;
 
+  // If the last reload of this node's dependency file recorded which
+  // declarations were left unchanged, skip the initial cascade through those
+  // names; an unchanged declaration cannot affect its dependents. The set is
+  // consumed here so that a later mark for an unrelated reason (e.g. an
+  // external dependency) cascades in full.
+  Optional<llvm::StringSet<>> cleanDeclNames;
+  auto cleanIter = CleanDeclNames.find(node);
+  if (cleanIter != CleanDeclNames.end()) {
+    cleanDeclNames.emplace(std::move(cleanIter->second));
+    CleanDeclNames.erase(cleanIter);
+  }
+
   auto addDependentsToWorklist = [&](const void *next,
                                      ArrayRef<MarkTracerImpl::Entry> reason) {
     auto allProvided = Provides.find(next);
@@ -330,6 +407,15 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
       return;
 
     for (const auto &provided : allProvided->second) {
+      // Only pure top-level names can be filtered by decl hash; nominal and
+      // member entries use mangled keys that the hash map does not cover.
+      if (next == node && cleanDeclNames &&
+          provided.kindMask.toRaw() ==
+              DependencyMaskTy(DependencyKind::TopLevelName).toRaw() &&
+          cleanDeclNames->count(provided.name)) {
+        continue;
+      }
+
       auto allDependents = Dependencies.find(provided.name);
       if (allDependents == Dependencies.end())
         continue;
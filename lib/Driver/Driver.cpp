@@ -51,11 +51,15 @@
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "CompilationRecord.h"
 
+#include "llvm/Support/Endian.h"
+
 #include <memory>
+#include <thread>
 
 using namespace swift;
 using namespace swift::driver;
@@ -281,6 +285,102 @@ static bool failedToReadOutOfDateMap(bool ShowIncrementalBuildDecisions,
   return true;
 }
 
+static bool finishOutOfDateMap(
+    InputInfoMap &map, const InputFileList &inputs,
+    bool ShowIncrementalBuildDecisions, bool versionValid,
+    StringRef recordedVersion, bool optionsMatch,
+    const llvm::StringMap<CompileJobAction::InputInfo> &previousInputs);
+
+/// Reads a compilation record written in the compact binary format.
+///
+/// \sa writeBinaryCompilationRecord
+static bool populateOutOfDateMapFromBinaryRecord(
+    InputInfoMap &map, StringRef argsHashStr, const InputFileList &inputs,
+    llvm::MemoryBuffer &buffer, StringRef buildRecordPath,
+    bool ShowIncrementalBuildDecisions) {
+  using InputInfo = CompileJobAction::InputInfo;
+
+  StringRef data = buffer.getBuffer();
+  data = data.drop_front(compilation_record::BinaryRecordMagic.size());
+
+  auto readUInt32 = [&data](uint32_t &value) -> bool {
+    if (data.size() < sizeof(uint32_t))
+      return true;
+    value = llvm::support::endian::read32le(data.data());
+    data = data.drop_front(sizeof(uint32_t));
+    return false;
+  };
+  auto readInt64 = [&data](int64_t &value) -> bool {
+    if (data.size() < sizeof(int64_t))
+      return true;
+    value = llvm::support::endian::read64le(data.data());
+    data = data.drop_front(sizeof(int64_t));
+    return false;
+  };
+  auto readString = [&](StringRef &value) -> bool {
+    uint32_t length;
+    if (readUInt32(length) || data.size() < length)
+      return true;
+    value = data.take_front(length);
+    data = data.drop_front(length);
+    return false;
+  };
+  auto readTimeValue = [&](llvm::sys::TimePoint<> &timeValue) -> bool {
+    int64_t seconds, nanoseconds;
+    if (readInt64(seconds) || readInt64(nanoseconds))
+      return true;
+    timeValue = llvm::sys::TimePoint<>(
+        std::chrono::seconds(static_cast<std::time_t>(seconds)));
+    timeValue += std::chrono::nanoseconds(nanoseconds);
+    return false;
+  };
+
+  StringRef recordedVersion, recordedArgsHash;
+  llvm::sys::TimePoint<> buildTime;
+  uint32_t numInputs;
+  if (readString(recordedVersion) || readString(recordedArgsHash) ||
+      readTimeValue(buildTime) || readUInt32(numInputs)) {
+    return failedToReadOutOfDateMap(ShowIncrementalBuildDecisions,
+                                    buildRecordPath);
+  }
+
+  map[nullptr] = { InputInfo::NeedsCascadingBuild, buildTime };
+
+  llvm::StringMap<InputInfo> previousInputs;
+  for (uint32_t i = 0; i != numInputs; ++i) {
+    if (data.empty())
+      return failedToReadOutOfDateMap(ShowIncrementalBuildDecisions,
+                                      buildRecordPath);
+    auto rawStatus = static_cast<uint8_t>(data.front());
+    data = data.drop_front(1);
+    if (rawStatus > InputInfo::NewlyAdded)
+      return failedToReadOutOfDateMap(ShowIncrementalBuildDecisions,
+                                      buildRecordPath);
+    auto status = static_cast<InputInfo::Status>(rawStatus);
+    // Like the YAML reader, treat a newly-added input from the previous
+    // build as needing a cascading build.
+    if (status == InputInfo::NewlyAdded)
+      status = InputInfo::NeedsCascadingBuild;
+
+    llvm::sys::TimePoint<> timeValue;
+    StringRef path;
+    if (readTimeValue(timeValue) || readString(path))
+      return failedToReadOutOfDateMap(ShowIncrementalBuildDecisions,
+                                      buildRecordPath);
+    previousInputs[path] = { status, timeValue };
+  }
+
+  bool versionValid =
+      (recordedVersion ==
+       version::getSwiftFullVersion(
+           version::Version::getCurrentLanguageVersion()));
+  bool optionsMatch = (argsHashStr == recordedArgsHash);
+
+  return finishOutOfDateMap(map, inputs, ShowIncrementalBuildDecisions,
+                            versionValid, recordedVersion, optionsMatch,
+                            previousInputs);
+}
+
 static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
                                  const InputFileList &inputs,
                                  StringRef buildRecordPath,
@@ -290,6 +390,15 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
   if (!buffer)
     return false;
 
+  // Records written by -driver-binary-compilation-record carry a magic
+  // number; anything else is the YAML format.
+  if (buffer.get()->getBuffer().startswith(
+          compilation_record::BinaryRecordMagic)) {
+    return populateOutOfDateMapFromBinaryRecord(map, argsHashStr, inputs,
+                                                *buffer.get(), buildRecordPath,
+                                                ShowIncrementalBuildDecisions);
+  }
+
   namespace yaml = llvm::yaml;
   using InputInfo = CompileJobAction::InputInfo;
 
@@ -429,6 +538,21 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
     }
   }
 
+  return finishOutOfDateMap(map, inputs, ShowIncrementalBuildDecisions,
+                            versionValid, CompilationRecordSwiftVersion,
+                            optionsMatch, previousInputs);
+}
+
+/// Shared tail of the compilation record readers: validates the recorded
+/// compiler version and options hash, then matches the recorded inputs
+/// against the current input list.
+static bool finishOutOfDateMap(
+    InputInfoMap &map, const InputFileList &inputs,
+    bool ShowIncrementalBuildDecisions, bool versionValid,
+    StringRef recordedVersion, bool optionsMatch,
+    const llvm::StringMap<CompileJobAction::InputInfo> &previousInputs) {
+  using InputInfo = CompileJobAction::InputInfo;
+
   if (!versionValid) {
     if (ShowIncrementalBuildDecisions) {
       auto v = version::getSwiftFullVersion(
@@ -436,8 +560,7 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
       llvm::outs() << "Incremental compilation has been disabled, due to a "
                    << "compiler version mismatch.\n"
                    << "\tCompiling with: " << v << "\n"
-                   << "\tPreviously compiled with: "
-                   << CompilationRecordSwiftVersion << "\n";
+                   << "\tPreviously compiled with: " << recordedVersion << "\n";
     }
     return true;
   }
@@ -491,6 +614,40 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
   }
 }
 
+/// Returns true if every source input is recorded as up to date, has not
+/// been modified since it was recorded, and still has its object file on
+/// disk, i.e. a build would have nothing to do.
+static bool allInputsUpToDate(ArrayRef<InputPair> inputs,
+                              const InputInfoMap &map,
+                              const OutputFileMap &OFM) {
+  using InputInfo = CompileJobAction::InputInfo;
+
+  for (const InputPair &input : inputs) {
+    if (!types::isPartOfSwiftCompilation(input.first))
+      return false;
+
+    auto iter = map.find(input.second);
+    if (iter == map.end() || iter->second.status != InputInfo::UpToDate)
+      return false;
+
+    llvm::sys::fs::file_status inputStatus;
+    if (llvm::sys::fs::status(input.second->getValue(), inputStatus))
+      return false;
+    if (inputStatus.getLastModificationTime() != iter->second.previousModTime)
+      return false;
+
+    const TypeToPathMap *outputMap =
+        OFM.getOutputMapForInput(input.second->getValue());
+    if (!outputMap)
+      return false;
+    std::string objectPath = outputMap->lookup(types::TY_Object);
+    if (objectPath.empty() || !llvm::sys::fs::exists(objectPath))
+      return false;
+  }
+
+  return !inputs.empty();
+}
+
 // warn if -embed-bitcode is set and the output type is not an object
 static void validateEmbedBitcode(DerivedArgList &Args, OutputInfo &OI,
                                  DiagnosticEngine &Diags) {
@@ -534,6 +691,14 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
     }
     Incremental = false;
   }
+  if (ArgList->hasArg(options::OPT_driver_parallel_frontend_jobs)) {
+    if (Incremental && ShowIncrementalBuildDecisions) {
+      llvm::outs() << "Incremental compilation has been disabled, because it "
+                   << "is not compatible with -driver-parallel-frontend-jobs, "
+                   << "which compiles the whole module at once.";
+    }
+    Incremental = false;
+  }
   if (ArgList->hasArg(options::OPT_embed_bitcode)) {
     if (Incremental && ShowIncrementalBuildDecisions) {
       llvm::outs() << "Incremental compilation has been disabled, because it "
@@ -605,6 +770,17 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
                                                             OutputType,
                                                             OptType,
                                                             A->getValue());
+
+    // Generate a session identifier shared by the driver and every frontend
+    // job it spawns, so the stats files those processes write can be joined
+    // back into a single record of this build.
+    size_t SessionID = size_t(
+        uint64_t(std::chrono::system_clock::now().time_since_epoch().count()) ^
+        (uint64_t(llvm::sys::Process::GetRandomNumber()) << 32));
+    StatsReporter->getDriverCounters().BuildSessionId = SessionID;
+    TranslatedArgList->AddSeparateArg(
+        nullptr, Opts->getOption(options::OPT_stats_build_session),
+        std::to_string(SessionID));
   }
 
   assert(OI.CompilerOutputType != types::ID::TY_INVALID &&
@@ -697,6 +873,20 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
                                                  SaveTemps,
                                                  ShowDriverTimeCompilation,
                                                  std::move(StatsReporter)));
+
+  // Null-build fast path: if the previous build left every input up to date
+  // and nothing has been touched since, skip Action and Job construction
+  // entirely. The existing build record is left in place, so the next
+  // incremental build still has full information.
+  if (C->getArgs().hasArg(options::OPT_driver_null_build_fast_path) &&
+      Incremental && !rebuildEverything && !OI.shouldLink() &&
+      OI.CompilerMode == OutputInfo::Mode::StandardCompile && OFM &&
+      allInputsUpToDate(C->getInputFiles(), outOfDateMap, *OFM)) {
+    if (ShowIncrementalBuildDecisions)
+      llvm::outs() << "Skipping job construction: all inputs up to date\n";
+    return C;
+  }
+
   // Construct the graph of Actions.
   SmallVector<const Action *, 8> TopLevelActions;
   buildActions(TopLevelActions, *TC, OI, OFM.get(),
@@ -723,6 +913,17 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
   if (ShowJobLifecycle)
     C->setShowJobLifecycle();
 
+  if (const Arg *A =
+          C->getArgs().getLastArg(options::OPT_driver_compilation_cache_path))
+    C->setCompilationCachePath(A->getValue());
+
+  if (C->getArgs().hasArg(options::OPT_driver_binary_compilation_record))
+    C->setUseBinaryCompilationRecord();
+
+  if (const Arg *A = C->getArgs().getLastArg(
+          options::OPT_driver_remote_execution_wrapper))
+    C->setRemoteExecutionWrapper(A->getValue());
+
   // This has to happen after building jobs, because otherwise we won't even
   // emit .swiftdeps files for the next build.
   if (rebuildEverything)
@@ -1075,6 +1276,17 @@ void Driver::buildOutputInfo(const ToolChain &TC, const DerivedArgList &Args,
     }
   }
 
+  if (Args.hasArg(options::OPT_driver_parallel_frontend_jobs) &&
+      OI.CompilerMode == OutputInfo::Mode::StandardCompile) {
+    // Rather than spawning one frontend per primary file (each of which
+    // re-parses the whole module), run a single frontend over all inputs and
+    // let it fan work out across threads sharing one AST. This piggybacks on
+    // the multithreaded code generation path, so make sure it is enabled.
+    OI.CompilerMode = OutputInfo::Mode::SingleCompile;
+    if (OI.numThreads == 0)
+      OI.numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
   const Arg *const OutputModeArg = Args.getLastArg(options::OPT_modes_Group);
 
   if (!OutputModeArg) {
@@ -1455,6 +1667,7 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
       case types::TY_TBD:
       case types::TY_ModuleTrace:
       case types::TY_OptRecord:
+      case types::TY_OrderFile:
         // We could in theory handle assembly or LLVM input, but let's not.
         // FIXME: What about LTO?
         Diags.diagnose(SourceLoc(), diag::error_unexpected_input_file,
@@ -1678,6 +1891,11 @@ void Driver::buildJobs(ArrayRef<const Action *> TopLevelActions,
   const DerivedArgList &Args = C.getArgs();
   JobCacheMap JobCache;
 
+  // Gather input modification times up front (in parallel for large
+  // modules), so that computing each compile job's condition below does not
+  // perform a blocking stat per input.
+  C.prefetchInputModTimes();
+
   if (Args.hasArg(options::OPT_o) && !OI.shouldLink() &&
       !OI.ShouldTreatModuleAsTopLevelOutput) {
     bool ShouldComplain;
@@ -1947,17 +2165,26 @@ static void addDiagFileOutputForPersistentPCHAction(Compilation &C,
 /// mtime has not changed), adjust the Job's condition accordingly.
 static void
 handleCompileJobCondition(Job *J, CompileJobAction::InputInfo inputInfo,
-                          StringRef input, bool alwaysRebuildDependents) {
+                          StringRef input, const Compilation &C,
+                          bool alwaysRebuildDependents) {
   if (inputInfo.status == CompileJobAction::InputInfo::NewlyAdded) {
     J->setCondition(Job::Condition::NewlyAdded);
     return;
   }
 
   bool hasValidModTime = false;
-  llvm::sys::fs::file_status inputStatus;
-  if (!llvm::sys::fs::status(input, inputStatus)) {
-    J->setInputModTime(inputStatus.getLastModificationTime());
-    hasValidModTime = true;
+  if (auto cachedModTime = C.getCachedInputModTime(input)) {
+    if (*cachedModTime != llvm::sys::TimePoint<>::max()) {
+      J->setInputModTime(*cachedModTime);
+      hasValidModTime = true;
+    }
+  } else {
+    // The input was not prefetched; fall back to a direct stat.
+    llvm::sys::fs::file_status inputStatus;
+    if (!llvm::sys::fs::status(input, inputStatus)) {
+      J->setInputModTime(inputStatus.getLastModificationTime());
+      hasValidModTime = true;
+    }
   }
 
   Job::Condition condition;
@@ -2259,6 +2486,19 @@ Job *Driver::buildJobsForAction(Compilation &C, const JobAction *JA,
       Diags.diagnose({}, diag::warn_opt_remark_disabled);
   }
 
+  if (C.getArgs().hasArg(options::OPT_emit_order_file,
+                         options::OPT_emit_order_file_path)) {
+    if (OI.CompilerMode == OutputInfo::Mode::SingleCompile) {
+      auto filename = *getOutputFilenameFromPathArgOrAsTopLevel(
+          OI, C.getArgs(), options::OPT_emit_order_file_path,
+          types::TY_OrderFile, /*TreatAsTopLevelOutput=*/true, "order", Buf);
+
+      Output->setAdditionalOutputForType(types::TY_OrderFile, filename);
+    } else
+      // FIXME: We should use the OutputMap in this case.
+      Diags.diagnose({}, diag::warn_order_file_disabled);
+  }
+
   // Choose the Objective-C header output path.
   if ((isa<MergeModuleJobAction>(JA) ||
        (isa<CompileJobAction>(JA) &&
@@ -2299,7 +2539,7 @@ Job *Driver::buildJobsForAction(Compilation &C, const JobAction *JA,
       auto compileJob = cast<CompileJobAction>(JA);
       bool alwaysRebuildDependents =
           C.getArgs().hasArg(options::OPT_driver_always_rebuild_dependents);
-      handleCompileJobCondition(J, compileJob->getInputInfo(), BaseInput,
+      handleCompileJobCondition(J, compileJob->getInputInfo(), BaseInput, C,
                                 alwaysRebuildDependents);
     }
   }
@@ -16,6 +16,7 @@
 #include "swift/Driver/Action.h"
 #include "swift/Driver/Job.h"
 #include "swift/Driver/Types.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -172,16 +173,40 @@ public:
   }
 };
 
+/// The maximum number of bytes of captured task output to embed in a single
+/// parseable-output message. A misbehaving subtask can produce an arbitrary
+/// amount of output; without a cap, a parallel build would hold all of it in
+/// memory at once while serializing messages. Output beyond the cap is
+/// dropped, with a marker noting how much was elided.
+static const size_t MaxTaskOutputSize = 2 << 20;
+
 class TaskOutputMessage : public TaskBasedMessage {
-  std::string Output;
+  /// The task's captured output. This deliberately refers to the buffer owned
+  /// by the TaskQueue rather than copying it; messages are serialized before
+  /// the task's buffers are released.
+  StringRef Output;
+
+  /// A truncation marker, which doubles as storage keeping \c Output valid
+  /// when the captured output exceeds MaxTaskOutputSize.
+  std::string TruncatedOutput;
 public:
   TaskOutputMessage(StringRef Kind, const Job &Cmd, ProcessId Pid,
                     StringRef Output) : TaskBasedMessage(Kind, Cmd, Pid),
-                                        Output(Output) {}
+                                        Output(Output) {
+    if (this->Output.size() > MaxTaskOutputSize) {
+      TruncatedOutput = this->Output.take_front(MaxTaskOutputSize).str();
+      llvm::raw_string_ostream marker(TruncatedOutput);
+      marker << "\n[output truncated: "
+             << (this->Output.size() - MaxTaskOutputSize)
+             << " bytes elided]\n";
+      marker.flush();
+      this->Output = TruncatedOutput;
+    }
+  }
 
   void provideMapping(swift::json::Output &out) override {
     TaskBasedMessage::provideMapping(out);
-    out.mapOptional("output", Output, std::string());
+    out.mapOptional("output", Output, StringRef());
   }
 };
 
@@ -237,12 +262,14 @@ struct ObjectTraits<Message> {
 } // namespace swift
 
 static void emitMessage(raw_ostream &os, Message &msg) {
-  std::string JSONString;
-  llvm::raw_string_ostream BufferStream(JSONString);
+  // The message has to be buffered once, since its length is emitted before
+  // its contents, but use a stack-friendly buffer and avoid the extra copy a
+  // raw_string_ostream would make on flush.
+  SmallString<256> JSONString;
+  llvm::raw_svector_ostream BufferStream(JSONString);
   json::Output yout(BufferStream);
   yout << msg;
-  BufferStream.flush();
-  os << JSONString.length() << '\n';
+  os << JSONString.size() << '\n';
   os << JSONString << '\n';
 }
 
@@ -164,6 +164,7 @@ static void addCommonFrontendArgs(const ToolChain &TC,
   inputArgs.AddLastArg(arguments, options::OPT_enforce_exclusivity_EQ);
   inputArgs.AddLastArg(arguments, options::OPT_stats_output_dir);
   inputArgs.AddLastArg(arguments, options::OPT_trace_stats_events);
+  inputArgs.AddLastArg(arguments, options::OPT_stats_build_session);
   inputArgs.AddLastArg(arguments,
                        options::OPT_solver_shrink_unsolved_threshold);
   inputArgs.AddLastArg(arguments, options::OPT_O_Group);
@@ -457,6 +458,13 @@ ToolChain::constructInvocation(const CompileJobAction &job,
     Arguments.push_back(OptRecordPath.c_str());
   }
 
+  const std::string &OrderFilePath =
+      context.Output.getAdditionalOutputForType(types::TY_OrderFile);
+  if (!OrderFilePath.empty()) {
+    Arguments.push_back("-emit-order-file-path");
+    Arguments.push_back(OrderFilePath.c_str());
+  }
+
   if (context.Args.hasArg(options::OPT_migrate_keep_objc_visibility)) {
     Arguments.push_back("-migrate-keep-objc-visibility");
   }
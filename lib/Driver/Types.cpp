@@ -78,6 +78,7 @@ bool types::isTextual(ID Id) {
   case types::TY_TBD:
   case types::TY_ModuleTrace:
   case types::TY_OptRecord:
+  case types::TY_OrderFile:
     return true;
   case types::TY_Image:
   case types::TY_Object:
@@ -133,6 +134,7 @@ bool types::isAfterLLVM(ID Id) {
   case types::TY_IndexData:
   case types::TY_ModuleTrace:
   case types::TY_OptRecord:
+  case types::TY_OrderFile:
     return false;
   case types::TY_INVALID:
     llvm_unreachable("Invalid type ID.");
@@ -172,6 +174,7 @@ bool types::isPartOfSwiftCompilation(ID Id) {
   case types::TY_IndexData:
   case types::TY_ModuleTrace:
   case types::TY_OptRecord:
+  case types::TY_OrderFile:
     return false;
   case types::TY_INVALID:
     llvm_unreachable("Invalid type ID.");
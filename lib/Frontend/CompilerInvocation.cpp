@@ -154,6 +154,13 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
     if (Args.getLastArg(OPT_trace_stats_events)) {
       Opts.TraceStats = true;
     }
+    if (const Arg *SessionA = Args.getLastArg(OPT_stats_build_session)) {
+      Opts.StatsBuildSession = SessionA->getValue();
+    }
+  }
+
+  if (const Arg *A = Args.getLastArg(OPT_profile_frontend)) {
+    Opts.ProfileFrontendPath = A->getValue();
   }
 
   if (const Arg *A = Args.getLastArg(OPT_validate_tbd_against_ir_EQ)) {
@@ -538,6 +545,11 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   determineOutputFilename(Opts.TBDPath, OPT_emit_tbd, OPT_emit_tbd_path, "tbd",
                           false);
 
+  determineOutputFilename(Opts.OrderFilePath,
+                          OPT_emit_order_file,
+                          OPT_emit_order_file_path,
+                          "order", false);
+
   if (const Arg *A = Args.getLastArg(OPT_emit_fixits_path)) {
     Opts.FixitsOutputPath = A->getValue();
   }
@@ -707,6 +719,8 @@ static bool ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.ImportUnderlyingModule |= Args.hasArg(OPT_import_underlying_module);
   Opts.EnableSerializationNestedTypeLookupTable &=
       !Args.hasArg(OPT_disable_serialization_nested_type_lookup_table);
+  Opts.SerializePublicSILDeclarations |=
+      Args.hasArg(OPT_serialize_public_sil_declarations);
 
   if (const Arg *A = Args.getLastArgNoClaim(OPT_import_objc_header)) {
     Opts.ImplicitObjCHeaderPath = A->getValue();
@@ -1445,6 +1459,9 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
   Opts.DisableLLVMOptzns |= Args.hasArg(OPT_disable_llvm_optzns);
   Opts.DisableLLVMARCOpts |= Args.hasArg(OPT_disable_llvm_arc_opts);
   Opts.DisableLLVMSLPVectorizer |= Args.hasArg(OPT_disable_llvm_slp_vectorizer);
+
+  // With -num-threads the program is compiled into multiple LLVM modules.
+  Opts.MultiThreadedCompilation |= SILOpts.NumThreads > 0;
   if (Args.hasArg(OPT_disable_llvm_verify))
     Opts.Verify = false;
 
@@ -1620,9 +1637,9 @@ bool CompilerInvocation::parseArgs(ArrayRef<const char *> Args,
   // Parse frontend command line options using Swift's option table.
   unsigned MissingIndex;
   unsigned MissingCount;
-  std::unique_ptr<llvm::opt::OptTable> Table = createSwiftOptTable();
+  const llvm::opt::OptTable &Table = getSwiftOptTable();
   llvm::opt::InputArgList ParsedArgs =
-      Table->ParseArgs(Args, MissingIndex, MissingCount, FrontendOption);
+      Table.ParseArgs(Args, MissingIndex, MissingCount, FrontendOption);
   if (MissingCount) {
     Diags.diagnose(SourceLoc(), diag::error_missing_arg_value,
                    ParsedArgs.getArgString(MissingIndex), MissingCount);
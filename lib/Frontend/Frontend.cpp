@@ -460,7 +460,13 @@ void CompilerInstance::parseAndCheckTypes(
   // In addition, the main file has parsing and type-checking
   // interwined.
   if (MainBufferID != NO_SUCH_BUFFER) {
-    parseAndTypeCheckMainFile(PersistentState, PrimaryDelayedCB.get(),
+    // If the main file is not the primary file, treat it like any other
+    // non-primary file and skip function bodies until they are demanded.
+    bool mainIsPrimary =
+        (isWholeModuleCompilation() || MainBufferID == PrimaryBufferID);
+    parseAndTypeCheckMainFile(PersistentState,
+                              mainIsPrimary ? PrimaryDelayedCB.get()
+                                            : SecondaryDelayedCB.get(),
                               TypeCheckOptions);
   }
 
@@ -491,6 +497,12 @@ void CompilerInstance::parseLibraryFile(
     DelayedParsingCallbacks *PrimaryDelayedCB,
     DelayedParsingCallbacks *SecondaryDelayedCB) {
   SharedTimer timer("performSema-parseLibraryFile");
+  // Give each input its own timer entry as well, so that
+  // -debug-time-compilation shows which files dominate the parse.
+  llvm::SmallString<128> perFileTimerName("performSema-parseLibraryFile-");
+  perFileTimerName +=
+      llvm::sys::path::filename(SourceMgr.getIdentifierForBuffer(BufferID));
+  SharedTimer perFileTimer(perFileTimerName);
 
   auto *NextInput = new (*Context) SourceFile(
       *MainModule, SourceFileKind::Library, BufferID, implicitImports.kind,
@@ -726,6 +738,20 @@ void CompilerInstance::freeContextAndSIL() {
   PrimarySourceFile = nullptr;
 }
 
+void CompilerInstance::reset() {
+  freeContextAndSIL();
+
+  // Forget the inputs of the previous job.  The buffers themselves stay in
+  // the SourceManager, which has no way of dropping them, but they become
+  // unreachable for subsequent jobs.
+  InputSourceCodeBufferIDs.clear();
+  PartialModules.clear();
+  MainBufferID = NO_SUCH_BUFFER;
+  PrimaryBufferID = NO_SUCH_BUFFER;
+
+  Diagnostics.resetHadAnyError();
+}
+
 bool CompilerInstance::setupForFileAt(unsigned i) {
   bool MainMode = (Invocation.getInputKind() == InputFileKind::IFK_Swift);
   bool SILMode = (Invocation.getInputKind() == InputFileKind::IFK_SIL);
@@ -734,16 +760,25 @@ bool CompilerInstance::setupForFileAt(unsigned i) {
 
   // FIXME: Working with filenames is fragile, maybe use the real path
   // or have some kind of FileManager.
+  //
+  // Only buffers registered by the current setup() may replace the contents
+  // of an input filename; a buffer left over from an earlier job of a reused
+  // instance must not shadow the file on disk.
   using namespace llvm::sys::path;
   if (Optional<unsigned> ExistingBufferID =
           SourceMgr.getIDForBufferIdentifier(File)) {
-    if (SILMode || (MainMode && filename(File) == "main.swift"))
-      MainBufferID = ExistingBufferID.getValue();
+    if (std::find(InputSourceCodeBufferIDs.begin(),
+                  InputSourceCodeBufferIDs.end(),
+                  ExistingBufferID.getValue()) !=
+        InputSourceCodeBufferIDs.end()) {
+      if (SILMode || (MainMode && filename(File) == "main.swift"))
+        MainBufferID = ExistingBufferID.getValue();
 
-    if (Invocation.getFrontendOptions().Inputs.isPrimaryInputAFileAt(i))
-      PrimaryBufferID = ExistingBufferID.getValue();
+      if (Invocation.getFrontendOptions().Inputs.isPrimaryInputAFileAt(i))
+        PrimaryBufferID = ExistingBufferID.getValue();
 
-    return false; // replaced by a memory buffer.
+      return false; // replaced by a memory buffer.
+    }
   }
 
   // Open the input file.
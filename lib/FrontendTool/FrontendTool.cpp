@@ -41,6 +41,7 @@
 #include "swift/Basic/FileSystem.h"
 #include "swift/Basic/JSONSerialization.h"
 #include "swift/Basic/LLVMContext.h"
+#include "swift/Basic/SamplingProfiler.h"
 #include "swift/Basic/SourceManager.h"
 #include "swift/Basic/Statistic.h"
 #include "swift/Basic/Timer.h"
@@ -234,6 +235,47 @@ static bool emitLoadedModuleTrace(ASTContext &ctxt,
 }
 
 
+/// Writes a linker order file to \p opts.OrderFilePath listing the symbols
+/// of the functions the profile marked as executed, hottest first, so the
+/// linker can cluster startup-hot code together instead of paging it in at
+/// random.  Entry counts come from -profile-use profile data; without it
+/// every function is cold and the file comes out empty.
+static bool emitOrderFile(ASTContext &ctxt, SILModule &SM,
+                          const FrontendOptions &opts) {
+  std::error_code EC;
+  llvm::raw_fd_ostream out(opts.OrderFilePath, EC, llvm::sys::fs::F_None);
+  if (EC) {
+    ctxt.Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                        opts.OrderFilePath, EC.message());
+    return true;
+  }
+
+  using OrderEntry = std::pair<uint64_t, StringRef>;
+  std::vector<OrderEntry> entries;
+  for (SILFunction &F : SM) {
+    if (!F.isDefinition())
+      continue;
+    ProfileCounter count = F.getEntryCount();
+    if (count.hasValue() && count.getValue() > 0)
+      entries.push_back({count.getValue(), F.getName()});
+  }
+
+  // Hottest first; ties broken by name so the output is deterministic.
+  std::sort(entries.begin(), entries.end(),
+            [](const OrderEntry &lhs, const OrderEntry &rhs) {
+    if (lhs.first != rhs.first)
+      return lhs.first > rhs.first;
+    return lhs.second < rhs.second;
+  });
+
+  // The order file must name symbols the way the linker sees them, which on
+  // Mach-O includes the leading underscore.
+  StringRef prefix = ctxt.LangOpts.Target.isOSBinFormatMachO() ? "_" : "";
+  for (auto &entry : entries)
+    out << prefix << entry.second << "\n";
+  return false;
+}
+
 /// Gets an output stream for the provided output filename, or diagnoses to the
 /// provided AST Context and returns null if there was an error getting the
 /// stream.
@@ -753,13 +795,17 @@ static bool performCompile(CompilerInstance &Instance,
   }
 
   const auto &SILOpts = Invocation.getSILOptions();
+  // The symbol set computed for -emit-tbd, kept so that TBD validation below
+  // can reuse it instead of walking the whole AST a second time.
+  llvm::Optional<llvm::StringSet<>> TBDSymbols;
   if (!opts.TBDPath.empty()) {
     auto hasMultipleIRGenThreads = SILOpts.NumThreads > 1;
     auto installName = opts.TBDInstallName.empty()
                            ? "lib" + Invocation.getModuleName().str() + ".dylib"
                            : opts.TBDInstallName;
 
-    if (writeTBD(Instance.getMainModule(), hasMultipleIRGenThreads,
+    TBDSymbols.emplace();
+    if (writeTBD(Instance.getMainModule(), *TBDSymbols, hasMultipleIRGenThreads,
                  opts.TBDPath, installName))
       return true;
   }
@@ -887,6 +933,8 @@ static bool performCompile(CompilerInstance &Instance,
             Invocation.getClangImporterOptions().ExtraArgs;
         serializationOpts.EnableNestedTypeLookupTable =
             opts.EnableSerializationNestedTypeLookupTable;
+        serializationOpts.SerializePublicSILDeclarations =
+            opts.SerializePublicSILDeclarations;
         if (!IRGenOpts.ForceLoadSymbolName.empty())
           serializationOpts.AutolinkForceLoad = true;
 
@@ -1002,6 +1050,9 @@ static bool performCompile(CompilerInstance &Instance,
   if (Context.hadError())
     return true;
 
+  if (!opts.OrderFilePath.empty())
+    (void)emitOrderFile(Context, *SM, opts);
+
   // Convert SIL to a lowered form suitable for IRGen.
   runSILLoweringPasses(*SM);
 
@@ -1075,6 +1126,9 @@ static bool performCompile(CompilerInstance &Instance,
     if (PrimarySourceFile)
       error = validateTBD(PrimarySourceFile, *IRModule, hasMultipleIRGenThreads,
                           allSymbols);
+    else if (TBDSymbols)
+      error = validateTBD(Instance.getMainModule(), *IRModule,
+                          std::move(*TBDSymbols), allSymbols);
     else
       error = validateTBD(Instance.getMainModule(), *IRModule,
                           hasMultipleIRGenThreads,
@@ -1366,6 +1420,15 @@ int swift::performFrontend(ArrayRef<const char *> Args,
     llvm::EnableStatistics();
   }
 
+  // Started as early as possible so the profile covers the whole invocation;
+  // destroyed (writing the collapsed-stack file) when this frame unwinds.
+  std::unique_ptr<SamplingProfiler> SelfProfiler;
+  const std::string &ProfileFrontendPath =
+      Invocation.getFrontendOptions().ProfileFrontendPath;
+  if (!ProfileFrontendPath.empty()) {
+    SelfProfiler = llvm::make_unique<SamplingProfiler>(ProfileFrontendPath);
+  }
+
   const std::string &StatsOutputDir =
       Invocation.getFrontendOptions().StatsOutputDir;
   std::unique_ptr<UnifiedStatsReporter> StatsReporter;
@@ -1389,6 +1452,13 @@ int swift::performFrontend(ArrayRef<const char *> Args,
                                                             StatsOutputDir,
                                                             &SM,
                                                             Trace);
+    // Record the driver-provided session identifier, so this frontend's
+    // stats file can be joined with those of its sibling jobs.
+    if (!FEOpts.StatsBuildSession.empty()) {
+      size_t SessionID = 0;
+      if (!StringRef(FEOpts.StatsBuildSession).getAsInteger(10, SessionID))
+        StatsReporter->getFrontendCounters().BuildSessionId = SessionID;
+    }
   }
 
   const DiagnosticOptions &diagOpts = Invocation.getDiagnosticOptions();
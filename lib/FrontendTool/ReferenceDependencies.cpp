@@ -24,10 +24,12 @@
 #include "swift/AST/Types.h"
 #include "swift/Frontend/FrontendOptions.h"
 #include "swift/Basic/LLVM.h"
+#include "swift/Parse/Lexer.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/YAMLParser.h"
 
 using namespace swift;
@@ -420,6 +422,53 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags,
     out << "- \"" << llvm::yaml::escape(entry) << "\"\n";
   }
 
+  // Emit a hash of the source text of each non-private top-level declaration
+  // so that the driver can tell *which* declarations changed when the file's
+  // interface hash changes, and only cascade to their dependents.
+  //
+  // Overloads (and operator functions of the same name) share a base name,
+  // and the driver keys its hash comparison by that name, so all same-named
+  // declarations are combined into a single hash: an edit to any one of them
+  // must change the recorded entry.
+  out << "provides-decl-hashes:\n";
+  llvm::MapVector<DeclBaseName, llvm::MD5> declHashes;
+  for (const Decl *D : SF->Decls) {
+    auto *VD = dyn_cast<ValueDecl>(D);
+    if (!VD || !VD->hasName())
+      continue;
+    if (VD->hasAccess() &&
+        VD->getFormalAccess() <= AccessLevel::FilePrivate) {
+      continue;
+    }
+
+    SourceRange range = VD->getSourceRange();
+    if (range.isInvalid())
+      continue;
+
+    // A function body cannot affect the declaration's dependents, so hash
+    // only the tokens up to the body. Edits confined to a body then leave
+    // the hash stable and dependents are not rebuilt at all.
+    if (auto *AFD = dyn_cast<AbstractFunctionDecl>(VD)) {
+      SourceRange bodyRange = AFD->getBodySourceRange();
+      if (bodyRange.isValid())
+        range = SourceRange(range.Start, bodyRange.Start);
+    }
+    CharSourceRange charRange =
+        Lexer::getCharSourceRangeFromSourceRange(SF->getASTContext().SourceMgr,
+                                                 range);
+    declHashes[VD->getBaseName()].update(
+        SF->getASTContext().SourceMgr.extractText(charRange));
+  }
+  for (auto &entry : declHashes) {
+    llvm::MD5::MD5Result result;
+    entry.second.final(result);
+    SmallString<32> hashString;
+    llvm::MD5::stringifyResult(result, hashString);
+
+    out << "- [\"" << escape(entry.first) << "\", \"" << hashString
+        << "\"]\n";
+  }
+
   llvm::SmallString<32> interfaceHash;
   SF->getInterfaceHash(interfaceHash);
   out << "interface-hash: \"" << interfaceHash << "\"\n";
@@ -38,8 +38,8 @@ static std::vector<StringRef> sortSymbols(llvm::StringSet<> &symbols) {
   return sorted;
 }
 
-bool swift::writeTBD(ModuleDecl *M, bool hasMultipleIRGenThreads,
-                     StringRef OutputFilename,
+bool swift::writeTBD(ModuleDecl *M, llvm::StringSet<> &symbols,
+                     bool hasMultipleIRGenThreads, StringRef OutputFilename,
                      StringRef installName) {
   std::error_code EC;
   llvm::raw_fd_ostream OS(OutputFilename, EC, llvm::sys::fs::F_None);
@@ -49,7 +49,7 @@ bool swift::writeTBD(ModuleDecl *M, bool hasMultipleIRGenThreads,
     return true;
   }
 
-  writeTBDFile(M, OS, hasMultipleIRGenThreads, installName);
+  writeTBDFile(M, symbols, OS, hasMultipleIRGenThreads, installName);
 
   return false;
 }
@@ -127,6 +127,13 @@ bool swift::validateTBD(ModuleDecl *M, llvm::Module &IRModule,
                            diagnoseExtraSymbolsInTBD);
 }
 
+bool swift::validateTBD(ModuleDecl *M, llvm::Module &IRModule,
+                        llvm::StringSet<> symbols,
+                        bool diagnoseExtraSymbolsInTBD) {
+  return validateSymbolSet(M->getASTContext().Diags, std::move(symbols),
+                           IRModule, diagnoseExtraSymbolsInTBD);
+}
+
 bool swift::validateTBD(FileUnit *file, llvm::Module &IRModule,
                         bool hasMultipleIRGenThreads,
                         bool diagnoseExtraSymbolsInTBD) {
@@ -14,6 +14,7 @@
 #define SWIFT_FRONTENDTOOL_TBD_H
 
 #include "swift/Frontend/FrontendOptions.h"
+#include "llvm/ADT/StringSet.h"
 
 namespace llvm {
 class StringRef;
@@ -24,13 +25,17 @@ class ModuleDecl;
 class FileUnit;
 class FrontendOptions;
 
-bool writeTBD(ModuleDecl *M, bool hasMultipleIRGenThreads,
-              llvm::StringRef OutputFilename,
+bool writeTBD(ModuleDecl *M, llvm::StringSet<> &symbols,
+              bool hasMultipleIRGenThreads, llvm::StringRef OutputFilename,
               llvm::StringRef installName);
 bool inputFileKindCanHaveTBDValidated(InputFileKind kind);
 bool validateTBD(ModuleDecl *M, llvm::Module &IRModule,
                  bool hasMultipleIRGenThreads,
                  bool diagnoseExtraSymbolsInTBD);
+/// Validate a symbol set that was already computed for \p M (by -emit-tbd)
+/// against the IR, without walking the AST again.
+bool validateTBD(ModuleDecl *M, llvm::Module &IRModule,
+                 llvm::StringSet<> symbols, bool diagnoseExtraSymbolsInTBD);
 bool validateTBD(FileUnit *M, llvm::Module &IRModule,
                  bool hasMultipleIRGenThreads,
                  bool diagnoseExtraSymbolsInTBD);
@@ -5433,7 +5433,8 @@ void CodeCompletionCallbacksImpl::doneParsing() {
         CodeCompletionCache::Key K{ModuleFilename, TheModule->getName().str(),
                                    AccessPath, Request.NeedLeadingDot,
                                    SF.hasTestableImport(TheModule),
-                                   Ctx.LangOpts.CodeCompleteInitsInPostfixExpr};
+                                   Ctx.LangOpts.CodeCompleteInitsInPostfixExpr,
+                                   /*InterfaceHash=*/""};
 
         using PairType = llvm::DenseSet<swift::ide::CodeCompletionCache::Key,
             llvm::DenseMapInfo<CodeCompletionCache::Key>>::iterator;
@@ -5555,6 +5556,10 @@ void swift::ide::copyCodeCompletionResults(CodeCompletionResultSink &targetSink,
   // TargetSink should have an owning pointer to the allocator that keeps the
   // results alive.
   targetSink.ForeignAllocators.push_back(sourceSink.Allocator);
+  // Likewise for any buffers that back deserialized results.
+  targetSink.BackingBuffers.insert(targetSink.BackingBuffers.end(),
+                                   sourceSink.BackingBuffers.begin(),
+                                   sourceSink.BackingBuffers.end());
 
   if (onlyTypes) {
     std::copy_if(sourceSink.Results.begin(), sourceSink.Results.end(),
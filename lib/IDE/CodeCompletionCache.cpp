@@ -54,14 +54,18 @@ CodeCompletionCache::get(const Key &K) {
   auto &TheCache = Impl->TheCache;
   llvm::Optional<ValueRefCntPtr> V = TheCache.get(K);
   if (V) {
-    // Check whether V is up to date.
-    llvm::sys::fs::file_status ModuleStatus;
-    if (llvm::sys::fs::status(K.ModuleFilename, ModuleStatus) ||
-        V.getValue()->ModuleModificationTime !=
-        ModuleStatus.getLastModificationTime()) {
-      // Cache is stale.
-      V = None;
-      TheCache.remove(K);
+    // An entry keyed by an interface hash is valid by construction: a
+    // changed interface produces a different key.  Otherwise check whether
+    // V is up to date against the module file.
+    if (K.InterfaceHash.empty()) {
+      llvm::sys::fs::file_status ModuleStatus;
+      if (llvm::sys::fs::status(K.ModuleFilename, ModuleStatus) ||
+          V.getValue()->ModuleModificationTime !=
+          ModuleStatus.getLastModificationTime()) {
+        // Cache is stale.
+        V = None;
+        TheCache.remove(K);
+      }
     }
   } else if (nextCache && (V = nextCache->get(K))) {
     // Hit the chained cache. Update our own cache to match.
@@ -102,12 +106,6 @@ CodeCompletionCache::~CodeCompletionCache() {}
 /// cached results. This isn't expected to change very often.
 static constexpr uint32_t onDiskCompletionCacheVersion = 1;
 
-static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
-  char *Mem = Allocator.Allocate<char>(Str.size());
-  std::copy(Str.begin(), Str.end(), Mem);
-  return StringRef(Mem, Str.size());
-}
-
 static ArrayRef<StringRef> copyStringArray(llvm::BumpPtrAllocator &Allocator,
                                            ArrayRef<StringRef> Arr) {
   StringRef *Buff = Allocator.Allocate<StringRef>(Arr.size());
@@ -125,13 +123,19 @@ static ArrayRef<std::pair<StringRef, StringRef>> copyStringPairArray(
 }
 
 /// Deserializes CodeCompletionResults from \p in and stores them in \p V.
+///
+/// Strings are not copied into the sink's allocator: the results reference
+/// \p in directly, and ownership of the buffer is shared into
+/// V.Sink.BackingBuffers so the (possibly memory-mapped) pages materialize
+/// only when a result's strings are actually read.
 /// \see writeCacheModule.
-static bool readCachedModule(llvm::MemoryBuffer *in,
+static bool readCachedModule(std::shared_ptr<llvm::MemoryBuffer> in,
                              const CodeCompletionCache::Key &K,
                              CodeCompletionCache::Value &V,
                              bool allowOutOfDate = false) {
   const char *cursor = in->getBufferStart();
   const char *end = in->getBufferEnd();
+  V.Sink.BackingBuffers.push_back(std::move(in));
 
   auto read32le = [end](const char *&cursor) {
     auto result = llvm::support::endian::read32le(cursor);
@@ -149,8 +153,9 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     auto mtime = llvm::support::endian::read64le(cursor);
     cursor += sizeof(mtime);
 
-    // Check the module file's last modification time.
-    if (!allowOutOfDate) {
+    // Check the module file's last modification time.  Hash-keyed entries
+    // are validated by their name instead: a stale file is never opened.
+    if (!allowOutOfDate && K.InterfaceHash.empty()) {
       llvm::sys::fs::file_status status;
       if (llvm::sys::fs::status(K.ModuleFilename, status) ||
           status.getLastModificationTime().time_since_epoch().count() !=
@@ -180,7 +185,7 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 
     const char *p = strings + index;
     auto size = read32le(p);
-    return copyString(*V.Sink.Allocator, StringRef(p, size));
+    return StringRef(p, size);
   };
 
   // CHUNKS
@@ -312,6 +317,7 @@ static void writeCachedModule(llvm::raw_ostream &out,
     OSSLE.write(K.ResultsHaveLeadingDot);
     OSSLE.write(K.ForTestableLookup);
     OSSLE.write(K.CodeCompleteInitsInPostfixExpr);
+    OSS << K.InterfaceHash << "\0";
     LE.write(static_cast<uint32_t>(OSS.tell()));   // Size of debug info
     out.write(OSS.str().data(), OSS.str().size()); // Debug info blob
   }
@@ -428,6 +434,10 @@ static std::string getName(StringRef cacheDirectory,
   for (StringRef component : K.AccessPath)
     OSS << "-" << component;
 
+  // name[-interface-hash] for sub-module result chunks
+  if (!K.InterfaceHash.empty())
+    OSS << "-" << K.InterfaceHash;
+
   // name-<hash of module filename>
   auto hash = llvm::hash_value(K.ModuleFilename);
   SmallString<16> hashStr;
@@ -444,9 +454,11 @@ OnDiskCodeCompletionCache::get(const Key &K) {
   if (!bufferOrErr)
     return None;
 
-  // Read the cached results, failing if they are out of date.
+  // Read the cached results, failing if they are out of date.  The buffer
+  // is shared into the value so result strings can reference it directly.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V))
+  std::shared_ptr<llvm::MemoryBuffer> buffer = std::move(bufferOrErr.get());
+  if (!readCachedModule(std::move(buffer), K, *V))
     return None;
 
   return V;
@@ -487,11 +499,13 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
     return None;
 
   // Make up a key for readCachedModule.
-  CodeCompletionCache::Key K{filename, "<module-name>", {}, false, false, false};
+  CodeCompletionCache::Key K{filename, "<module-name>", {}, false, false,
+                             false, ""};
 
   // Read the cached results.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V,
+  std::shared_ptr<llvm::MemoryBuffer> buffer = std::move(bufferOrErr.get());
+  if (!readCachedModule(std::move(buffer), K, *V,
                         /*allowOutOfDate*/ true))
     return None;
 
@@ -41,6 +41,63 @@ struct TokenInfo {
 
 typedef llvm::SmallString<64> StringBuilder;
 
+/// Variants of the swift::ide line helpers defined at the end of this file
+/// that resolve line starts through the SourceManager's cached line table
+/// instead of rescanning \p Text from the beginning on every query.  The
+/// formatter makes several line queries per reformat request, so routing them
+/// through the table keeps each request proportional to the line rather than
+/// the file.  Out-of-range lines resolve to offset zero, matching the
+/// scanning variants.
+static size_t getCachedOffsetOfLine(unsigned LineIndex, StringRef Text,
+                                    SourceManager &SM, unsigned BufferID) {
+  if (LineIndex == 0)
+    return 0;
+  auto LineStarts = SM.getLineStartOffsets(BufferID);
+  if (LineIndex > LineStarts.size())
+    return 0;
+  return LineStarts[LineIndex - 1];
+}
+
+static size_t getCachedOffsetOfLine(unsigned LineIndex, StringRef Text,
+                                    SourceManager &SM, unsigned BufferID,
+                                    bool Trim) {
+  size_t LineOffset = getCachedOffsetOfLine(LineIndex, Text, SM, BufferID);
+  if (!Trim)
+    return LineOffset;
+  // Skip leading whitespace.
+  size_t FirstNonWSOnLine = Text.find_first_not_of(" \t\v\f", LineOffset);
+  if (FirstNonWSOnLine != std::string::npos)
+    LineOffset = FirstNonWSOnLine;
+  return LineOffset;
+}
+
+static StringRef getCachedTextForLine(unsigned LineIndex, StringRef Text,
+                                      SourceManager &SM, unsigned BufferID,
+                                      bool Trim) {
+  size_t LineOffset = getCachedOffsetOfLine(LineIndex, Text, SM, BufferID,
+                                            Trim);
+  size_t LineEnd = Text.find_first_of("\r\n", LineOffset);
+  return Text.slice(LineOffset, LineEnd);
+}
+
+static size_t getCachedExpandedIndentForLine(unsigned LineIndex,
+                                             CodeFormatOptions Options,
+                                             StringRef Text, SourceManager &SM,
+                                             unsigned BufferID) {
+  size_t LineOffset = getCachedOffsetOfLine(LineIndex, Text, SM, BufferID);
+
+  // Tab-expand all leading whitespace
+  size_t FirstNonWSOnLine = Text.find_first_not_of(" \t\v\f", LineOffset);
+  size_t Indent = 0;
+  while (LineOffset < Text.size() && LineOffset < FirstNonWSOnLine) {
+    if (Text[LineOffset++] == '\t')
+      Indent += Options.TabWidth;
+    else
+      Indent += 1;
+  }
+  return Indent;
+}
+
 static SourceLoc getVarDeclInitEnd(VarDecl *VD) {
   return VD->getBracesRange().isValid()
       ? VD->getBracesRange().End
@@ -94,12 +151,13 @@ public:
     return InStringLiteral;
   }
 
-  bool isSwitchControlStmt(unsigned LineIndex, StringRef Text) {
+  bool isSwitchControlStmt(StringRef TrimmedLineText) {
     if (!isSwitchContext())
       return false;
-    StringRef LineText = swift::ide::getTextForLine(LineIndex, Text, /*Trim*/true);
-    return LineText.startswith("break") || LineText.startswith("continue") ||
-      LineText.startswith("return") || LineText.startswith("fallthrough");
+    return TrimmedLineText.startswith("break") ||
+      TrimmedLineText.startswith("continue") ||
+      TrimmedLineText.startswith("return") ||
+      TrimmedLineText.startswith("fallthrough");
   }
 
   void padToSiblingColumn(StringBuilder &Builder,
@@ -805,10 +863,13 @@ public:
 };
 
 class CodeFormatter {
+  SourceManager &SM;
+  unsigned BufferID;
   CodeFormatOptions &FmtOptions;
 public:
-  CodeFormatter(CodeFormatOptions &Options)
-    :FmtOptions(Options) { }
+  CodeFormatter(SourceManager &SM, unsigned BufferID,
+                CodeFormatOptions &Options)
+    :SM(SM), BufferID(BufferID), FmtOptions(Options) { }
 
   std::pair<LineRange, std::string> indent(unsigned LineIndex,
                                            FormatContext &FC,
@@ -816,7 +877,8 @@ public:
 
     // If having sibling locs to align with, respect siblings.
     if (FC.HasSibling()) {
-      StringRef Line = swift::ide::getTextForLine(LineIndex, Text, /*Trim*/true);
+      StringRef Line = getCachedTextForLine(LineIndex, Text, SM, BufferID,
+                                            /*Trim*/true);
       StringBuilder Builder;
       FC.padToSiblingColumn(Builder, FmtOptions);
       if (FC.needExtraIndentationForSibling()) {
@@ -831,14 +893,15 @@ public:
 
     if (FC.IsInStringLiteral()) {
       return std::make_pair(LineRange(LineIndex, 1),
-        swift::ide::getTextForLine(LineIndex, Text, /*Trim*/false));
+        getCachedTextForLine(LineIndex, Text, SM, BufferID, /*Trim*/false));
     }
 
     // Take the current indent position of the outer context, then add another
     // indent level if expected.
     auto LineAndColumn = FC.indentLineAndColumn();
-    size_t ExpandedIndent = swift::ide::getExpandedIndentForLine(LineAndColumn.first,
-                                                                 FmtOptions, Text);
+    size_t ExpandedIndent = getCachedExpandedIndentForLine(LineAndColumn.first,
+                                                           FmtOptions, Text,
+                                                           SM, BufferID);
     auto AddIndentFunc = [&] () {
       auto Width = FmtOptions.UseTabs ? FmtOptions.TabWidth
                                       : FmtOptions.IndentWidth;
@@ -857,7 +920,9 @@ public:
     // switch ... {
     //   case xyz:
     //     break <-- Extra indent level here.
-    if (FmtOptions.IndentSwitchCase && FC.isSwitchControlStmt(LineIndex, Text))
+    if (FmtOptions.IndentSwitchCase &&
+        FC.isSwitchControlStmt(getCachedTextForLine(LineIndex, Text, SM,
+                                                    BufferID, /*Trim*/true)))
       AddIndentFunc();
 
     if (FC.IsInDocCommentBlock()) {
@@ -870,7 +935,8 @@ public:
     }
 
     // Reformat the specified line with the calculated indent.
-    StringRef Line = swift::ide::getTextForLine(LineIndex, Text, /*Trim*/true);
+    StringRef Line = getCachedTextForLine(LineIndex, Text, SM, BufferID,
+                                          /*Trim*/true);
     std::string IndentedLine;
     if (FmtOptions.UseTabs)
       IndentedLine.assign(ExpandedIndent / FmtOptions.TabWidth, '\t');
@@ -922,9 +988,9 @@ public:
 } //anonymous namespace
 
 size_t swift::ide::getOffsetOfLine(unsigned LineIndex, StringRef Text) {
-  //  SourceLoc start = SourceLoc(llvm::SMLoc::getFromPointer(Text.begin()));
-  // FIXME: We should have a cached line map in EditableTextBuffer, for now
-  // we just do the slow naive thing here.
+  // The reformat path above resolves lines through the SourceManager's cached
+  // line table; this scanning variant remains for callers that only have the
+  // text.
   size_t LineOffset = 0;
   unsigned CurrentLine = 0;
   while (LineOffset < Text.size() && ++CurrentLine < LineIndex) {
@@ -985,11 +1051,12 @@ std::pair<LineRange, std::string> swift::ide::reformat(LineRange Range,
   auto SourceBufferID = SF.getBufferID().getValue();
   StringRef Text = SM.getLLVMSourceMgr()
     .getMemoryBuffer(SourceBufferID)->getBuffer();
-  size_t Offset = getOffsetOfLine(Range.startLine(), Text, /*Trim*/true);
+  size_t Offset = getCachedOffsetOfLine(Range.startLine(), Text, SM,
+                                        SourceBufferID, /*Trim*/true);
   SourceLoc Loc = SM.getLocForBufferStart(SourceBufferID)
     .getAdvancedLoc(Offset);
   FormatContext FC = walker.walkToLocation(Loc);
-  CodeFormatter CF(Options);
+  CodeFormatter CF(SM, SourceBufferID, Options);
   unsigned Line = Range.startLine();
   return CF.indent(Line, FC, Text, TokenInfoCollector(SM, walker.getTokens(),
                                                       Line).collect());
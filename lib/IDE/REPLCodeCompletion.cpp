@@ -222,7 +222,9 @@ doCodeCompletion(SourceFile &SF, StringRef EnteredCode, unsigned *BufferID,
   performDelayedParsing(&SF, PersistentState, CompletionCallbacksFactory);
 
   // Now we are done with code completion.  Remove the declarations we
-  // temporarily inserted.
+  // temporarily inserted, unindexing them so that the lookup cache (and its
+  // visible-decl snapshot) stays usable for the next completion.
+  SF.truncateDeclsInLookupCache(OriginalDeclCount);
   SF.Decls.resize(OriginalDeclCount);
 
   // Add the diagnostic consumers back.
@@ -30,6 +30,7 @@
 
 #include "llvm/Support/MemoryBuffer.h"
 
+#include <algorithm>
 #include <numeric>
 
 using namespace swift;
@@ -122,7 +123,32 @@ ResolvedCursorInfo CursorInfoResolver::resolve(SourceLoc Loc) {
   assert(Loc.isValid());
   LocToResolve = Loc;
   CursorInfo.Loc = Loc;
-  walk(SrcFile);
+
+  // The top-level declarations are stored in source order, so binary search
+  // for the ones containing the cursor instead of walking the whole file and
+  // letting walkToDeclPre filter out each preceding declaration by range.
+  auto &SM = getSourceMgr();
+  SmallVector<Decl *, 64> TopDecls;
+  for (Decl *D : SrcFile.Decls) {
+    if (D->getStartLoc().isValid())
+      TopDecls.push_back(D);
+  }
+  auto AfterLoc = std::upper_bound(
+      TopDecls.begin(), TopDecls.end(), Loc,
+      [&](SourceLoc L, const Decl *D) {
+        return SM.isBeforeInBuffer(L, D->getStartLoc());
+      });
+  // Top-level ranges don't overlap, so normally only the last declaration
+  // starting at or before the cursor can contain it; walking back while the
+  // ranges still contain the cursor guards against declarations that share a
+  // start location.
+  auto First = AfterLoc;
+  while (First != TopDecls.begin() &&
+         rangeContainsLoc((*(First - 1))->getSourceRange()))
+    --First;
+  for (auto It = First; It != AfterLoc && !isDone(); ++It)
+    walk(*It);
+
   return CursorInfo;
 }
 
@@ -92,6 +92,30 @@ static llvm::Constant *emitConstantValue(IRGenModule &IGM, SILValue operand) {
   }
 }
 
+bool irgen::isConstantValue(IRGenModule &IGM, SILValue value) {
+  if (auto *SI = dyn_cast<StructInst>(value)) {
+    for (SILValue elt : SI->getElements())
+      if (!isConstantValue(IGM, elt))
+        return false;
+    return true;
+  }
+  if (auto *TI = dyn_cast<TupleInst>(value)) {
+    for (SILValue elt : TI->getElements())
+      if (!isConstantValue(IGM, elt))
+        return false;
+    return true;
+  }
+  if (isa<IntegerLiteralInst>(value) || isa<FloatLiteralInst>(value))
+    return true;
+  if (auto *SLI = dyn_cast<StringLiteralInst>(value))
+    return SLI->getEncoding() != StringLiteralInst::Encoding::ObjCSelector;
+  if (auto *BI = dyn_cast<BuiltinInst>(value))
+    return IGM.getSILModule().getBuiltinInfo(BI->getName()).ID ==
+             BuiltinValueKind::PtrToInt &&
+           isConstantValue(IGM, BI->getArguments()[0]);
+  return false;
+}
+
 namespace {
 
 /// Fill in the missing values for padding.
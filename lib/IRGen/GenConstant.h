@@ -34,6 +34,11 @@ llvm::Constant *emitConstantFP(IRGenModule &IGM, FloatLiteralInst *FLI);
 llvm::Constant *emitAddrOfConstantString(IRGenModule &IGM,
                                          StringLiteralInst *SLI);
 
+/// Returns true if \p value is an aggregate built entirely of literals,
+/// i.e. if emitConstantStruct or emitConstantTuple can lower it to an LLVM
+/// constant.
+bool isConstantValue(IRGenModule &IGM, SILValue value);
+
 /// Construct a struct literal from a StructInst containing constant values.
 llvm::Constant *emitConstantStruct(IRGenModule &IGM, StructInst *SI);
 
@@ -108,6 +108,7 @@
 #include "swift/AST/Expr.h"
 #include "swift/AST/IRGenOptions.h"
 #include "swift/SIL/SILModule.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalVariable.h"
 #include "llvm/Analysis/CFG.h"
@@ -5181,22 +5182,30 @@ namespace {
   };
 } // end anonymous namespace
 
-std::unique_ptr<EnumImplStrategy>
-EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
-  unsigned numElements = 0;
-  TypeInfoKind tik = Loadable;
-  IsFixedSize_t alwaysFixedSize = IsFixedSize;
-  bool allowFixedLayoutOptimizations = true;
-  std::vector<Element> elementsWithPayload;
-  std::vector<Element> elementsWithNoPayload;
+/// Compute (or fetch from the IRGenModule's cache) the instantiation-
+/// independent part of the implementation strategy selection for \p theEnum.
+static const EnumDeclClassification &
+getEnumDeclClassification(TypeConverter &TC, EnumDecl *theEnum) {
+  auto found = TC.IGM.EnumDeclClassifications.find(theEnum);
+  if (found != TC.IGM.EnumDeclClassifications.end())
+    return *found->second;
+
+  using ElementKind = EnumDeclClassification::ElementKind;
+  auto classification = llvm::make_unique<EnumDeclClassification>();
 
   // Resilient enums are manipulated as opaque values, except we still
   // make the following assumptions:
   // 1) Physical case indices won't change
   // 2) The indirect-ness of cases won't change
   // 3) Payload types won't change in a non-resilient way
-  bool isResilient = TC.IGM.isResilient(theEnum, ResilienceExpansion::Maximal);
-  
+  classification->IsResilient =
+      TC.IGM.isResilient(theEnum, ResilienceExpansion::Maximal);
+
+  // Resilient tag numbering decreases for payload tags, so payload tags
+  // must be reversed if this enum is resilient from any context.
+  classification->ReversePayloadOrder =
+      TC.IGM.isResilient(theEnum, ResilienceExpansion::Minimal);
+
   // The most general resilience scope where the enum type is visible.
   // Case numbering must not depend on any information that is not static
   // in this resilience scope.
@@ -5210,8 +5219,6 @@ EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
       TC.IGM.getResilienceExpansionForLayout(theEnum);
 
   for (auto elt : theEnum->getAllElements()) {
-    numElements++;
-
     // Compute whether this gives us an apparent payload or dynamic layout.
     // Note that we do *not* apply substitutions from a bound generic instance
     // yet. We want all instances of a generic enum to share an implementation
@@ -5220,15 +5227,16 @@ EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
     // optimizations we perform to things that are reproducible by the runtime.
     Type origArgType = elt->getArgumentInterfaceType();
     if (origArgType.isNull()) {
-      elementsWithNoPayload.push_back({elt, nullptr, nullptr});
+      classification->Elements.push_back(
+          {elt, nullptr, ElementKind::NoPayload, false});
       continue;
     }
 
     // If the payload is indirect, we can use the NativeObject type metadata
     // without recurring. The box won't affect loadability or fixed-ness.
     if (elt->isIndirect() || theEnum->isIndirect()) {
-      auto *nativeTI = &TC.getNativeObjectTypeInfo();
-      elementsWithPayload.push_back({elt, nativeTI, nativeTI});
+      classification->Elements.push_back(
+          {elt, nullptr, ElementKind::IndirectPayload, false});
       continue;
     }
 
@@ -5241,25 +5249,66 @@ EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
 
     // If the unsubstituted argument contains a generic parameter type, or
     // is not fixed-size in all resilience domains that have knowledge of
-    // this enum's layout, we need to constrain our layout optimizations to
+    // this enum's layout, layout optimizations must be constrained to
     // what the runtime can reproduce.
-    if (!isResilient &&
-        !origArgTI->isFixedSize(layoutScope))
-      allowFixedLayoutOptimizations = false;
+    bool notFixedSizeForLayout = !origArgTI->isFixedSize(layoutScope);
 
     // If the payload is empty, turn the case into a no-payload case, but
     // only if case numbering remains unchanged from all resilience domains
     // that can see the enum.
-    if (origArgTI->isKnownEmpty(accessScope)) {
-      elementsWithNoPayload.push_back({elt, nullptr, nullptr});
-    } else {
-      // *Now* apply the substitutions and get the type info for the instance's
-      // payload type, since we know this case carries an apparent payload in
-      // the generic case.
-      SILType fieldTy = type.getEnumElementType(elt, TC.IGM.getSILModule());
+    auto kind = origArgTI->isKnownEmpty(accessScope) ? ElementKind::NoPayload
+                                                     : ElementKind::Payload;
+    classification->Elements.push_back(
+        {elt, origArgTI, kind, notFixedSizeForLayout});
+  }
+
+  auto &slot = TC.IGM.EnumDeclClassifications[theEnum];
+  slot = std::move(classification);
+  return *slot;
+}
+
+std::unique_ptr<EnumImplStrategy>
+EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
+  const EnumDeclClassification &classification =
+      getEnumDeclClassification(TC, theEnum);
+  using ElementKind = EnumDeclClassification::ElementKind;
+
+  unsigned numElements = classification.Elements.size();
+  TypeInfoKind tik = Loadable;
+  IsFixedSize_t alwaysFixedSize = IsFixedSize;
+  bool allowFixedLayoutOptimizations = true;
+  std::vector<Element> elementsWithPayload;
+  std::vector<Element> elementsWithNoPayload;
+
+  bool isResilient = classification.IsResilient;
+  ResilienceExpansion layoutScope =
+      TC.IGM.getResilienceExpansionForLayout(theEnum);
+
+  for (const auto &info : classification.Elements) {
+    if (!isResilient && info.OrigPayloadNotFixedSizeForLayout)
+      allowFixedLayoutOptimizations = false;
+
+    switch (info.Kind) {
+    case ElementKind::NoPayload:
+      elementsWithNoPayload.push_back({info.Element, nullptr, nullptr});
+      break;
+
+    case ElementKind::IndirectPayload: {
+      auto *nativeTI = &TC.getNativeObjectTypeInfo();
+      elementsWithPayload.push_back({info.Element, nativeTI, nativeTI});
+      break;
+    }
+
+    case ElementKind::Payload: {
+      // Apply the substitutions and get the type info for the instance's
+      // payload type, since we know this case carries an apparent payload
+      // in the generic case.
+      SILType fieldTy = type.getEnumElementType(info.Element,
+                                                TC.IGM.getSILModule());
       auto *substArgTI = &TC.IGM.getTypeInfo(fieldTy);
 
-      elementsWithPayload.push_back({elt, substArgTI, origArgTI});
+      elementsWithPayload.push_back(
+          {info.Element, substArgTI, info.OrigPayloadTI});
 
       if (!isResilient) {
         if (!substArgTI->isFixedSize(ResilienceExpansion::Maximal))
@@ -5276,13 +5325,14 @@ EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
           allowFixedLayoutOptimizations = false;
         }
       }
+      break;
+    }
     }
   }
 
-
   // Resilient tag numbering decreases for payload tags, so reverse the
   // payload tags if this enum is resilient from any context.
-  if (TC.IGM.isResilient(theEnum, ResilienceExpansion::Minimal))
+  if (classification.ReversePayloadOrder)
     std::reverse(elementsWithPayload.begin(), elementsWithPayload.end());
 
   assert(numElements == elementsWithPayload.size()
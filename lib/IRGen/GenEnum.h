@@ -112,6 +112,38 @@ llvm::Value *emitScatterSpareBits(IRGenFunction &IGF,
                                   llvm::Value *packedBits,
                                   unsigned packedLowBit);
   
+/// The instantiation-independent part of an enum's implementation strategy
+/// selection: the per-element classification and the resilience properties
+/// of the declaration. It is computed once per declaration and cached in
+/// the IRGenModule, so that the generic instances of a heavily used enum
+/// (e.g. Optional) don't redo this work in EnumImplStrategy::get.
+struct EnumDeclClassification {
+  enum class ElementKind : uint8_t {
+    /// The element carries no (or a known-empty) payload.
+    NoPayload,
+    /// The element's payload is stored indirectly in a box.
+    IndirectPayload,
+    /// The element carries a payload.
+    Payload,
+  };
+
+  struct ElementInfo {
+    EnumElementDecl *Element;
+    /// The type info of the unsubstituted payload type, or null if the
+    /// element carries no direct payload.
+    const TypeInfo *OrigPayloadTI;
+    ElementKind Kind;
+    /// True if the unsubstituted payload type is not fixed-size in all
+    /// resilience domains which know the enum's layout.
+    bool OrigPayloadNotFixedSizeForLayout;
+  };
+
+  SmallVector<ElementInfo, 4> Elements;
+  bool IsResilient;
+  /// True if payload tags must be numbered in reverse declaration order.
+  bool ReversePayloadOrder;
+};
+
 /// An implementation strategy for an enum, which handles how the enum is
 /// laid out and how to perform TypeInfo operations on values of the enum.
 class EnumImplStrategy {
@@ -967,7 +967,11 @@ static bool isResilientConformance(const NormalProtocolConformance *conformance)
 /// tables to be dependently-generated?
 static bool isDependentConformance(IRGenModule &IGM,
                              const NormalProtocolConformance *conformance,
-                                   ResilienceExpansion expansion) {
+                                   ResilienceExpansion expansion);
+
+static bool isDependentConformanceImpl(IRGenModule &IGM,
+                             const NormalProtocolConformance *conformance,
+                                       ResilienceExpansion expansion) {
   // If the conformance is resilient, this is always true.
   if (isResilientConformance(conformance))
     return true;
@@ -1002,6 +1006,20 @@ static bool isDependentConformance(IRGenModule &IGM,
       conformance, [](unsigned, CanType, ProtocolDecl *) { return true; });
 }
 
+static bool isDependentConformance(IRGenModule &IGM,
+                             const NormalProtocolConformance *conformance,
+                                   ResilienceExpansion expansion) {
+  // The answer is queried for every witness table reference and recomputing
+  // it walks the inherited-conformance tree, so cache it per conformance.
+  auto cached = IGM.DependentConformances.find(conformance);
+  if (cached != IGM.DependentConformances.end())
+    return cached->second;
+
+  bool result = isDependentConformanceImpl(IGM, conformance, expansion);
+  IGM.DependentConformances.insert({conformance, result});
+  return result;
+}
+
 /// Detail about how an object conforms to a protocol.
 class irgen::ConformanceInfo {
   friend ProtocolInfo;
@@ -1983,7 +2001,7 @@ ProtocolInfo::getConformance(IRGenModule &IGM, ProtocolDecl *protocol,
   auto checkCache =
       [&](const ProtocolConformance *conf) -> Optional<ConformanceInfo *> {
     // Check whether we've already cached this.
-    auto it = Conformances.find(conformance);
+    auto it = Conformances.find(conf);
     if (it != Conformances.end())
       return it->second;
 
@@ -1060,6 +1060,64 @@ static void addValueWitnessesForAbstractType(IRGenModule &IGM,
                     concreteLoweredType, concreteTI);
 }
 
+/// Return a reference to a value witness table which the runtime exports and
+/// which matches the layout of \p abstractType, or null if there is none.
+///
+/// The witnesses of a non-enum type only depend on its size, alignment,
+/// extra inhabitants and the reference counting of its contents, so e.g. a
+/// trivial 4-byte struct can use the table of Builtin.Int32 and a
+/// single-class-field struct can use the table of Builtin.NativeObject.
+/// Sharing the runtime's table avoids emitting a new one per type.
+static llvm::Constant *getCommonValueWitnessTable(IRGenModule &IGM,
+                                                  CanType abstractType) {
+  // Enums carry additional enum value witnesses which the common tables
+  // don't provide.
+  if (abstractType.getEnumOrBoundGenericEnum())
+    return nullptr;
+
+  auto &C = IGM.Context;
+  auto &concreteTI =
+      IGM.getTypeInfoForUnlowered(getFormalTypeInContext(abstractType));
+  auto *fixedTI = dyn_cast<FixedTypeInfo>(&concreteTI);
+  if (!fixedTI)
+    return nullptr;
+
+  // A single Swift-refcounted reference has exactly the witnesses of
+  // Builtin.NativeObject (including the extra inhabitants).
+  ReferenceCounting refCounting;
+  if (fixedTI->isSingleRetainablePointer(ResilienceExpansion::Maximal,
+                                         &refCounting) &&
+      refCounting == ReferenceCounting::Native) {
+    auto &nativeObjectTI = cast<FixedTypeInfo>(
+        IGM.getTypeInfoForUnlowered(C.TheNativeObjectType));
+    if (fixedTI->getFixedExtraInhabitantCount(IGM) ==
+          nativeObjectTI.getFixedExtraInhabitantCount(IGM))
+      return IGM.getAddrOfValueWitnessTable(C.TheNativeObjectType);
+    return nullptr;
+  }
+
+  // The same criteria as for the common type layouts in emitFixedTypeLayout.
+  if (!fixedTI->isPOD(ResilienceExpansion::Maximal) ||
+      !fixedTI->isBitwiseTakable(ResilienceExpansion::Maximal) ||
+      fixedTI->getFixedExtraInhabitantCount(IGM) != 0)
+    return nullptr;
+
+  unsigned size = fixedTI->getFixedSize().getValue();
+  unsigned align = fixedTI->getFixedAlignment().getValue();
+  if (size == 0)
+    return IGM.getAddrOfValueWitnessTable(C.TheEmptyTupleType);
+  if (   (size ==  1 && align ==  1)
+      || (size ==  2 && align ==  2)
+      || (size ==  4 && align ==  4)
+      || (size ==  8 && align ==  8)
+      || (size == 16 && align == 16)
+      || (size == 32 && align == 32))
+    return IGM.getAddrOfValueWitnessTable(
+        BuiltinIntegerType::get(size * 8, C)->getCanonicalType());
+
+  return nullptr;
+}
+
 /// Emit a value-witness table for the given type, which is assumed to
 /// be non-dependent.
 llvm::Constant *irgen::emitValueWitnessTable(IRGenModule &IGM,
@@ -1068,6 +1126,11 @@ llvm::Constant *irgen::emitValueWitnessTable(IRGenModule &IGM,
   assert(!isa<BoundGenericType>(abstractType) &&
          "emitting VWT for generic instance");
 
+  // If a table exported by the runtime matches the layout, reference it
+  // instead of emitting a new one.
+  if (auto *common = getCommonValueWitnessTable(IGM, abstractType))
+    return llvm::ConstantExpr::getBitCast(common, IGM.WitnessTablePtrTy);
+
   ConstantInitBuilder builder(IGM);
   auto witnesses = builder.beginArray(IGM.Int8PtrTy);
 
@@ -103,8 +103,12 @@ static void addSwiftContractPass(const PassManagerBuilder &Builder,
 
 static void addSwiftMergeFunctionsPass(const PassManagerBuilder &Builder,
                                        PassManagerBase &PM) {
-  if (Builder.OptLevel > 0)
-    PM.add(createSwiftMergeFunctionsPass());
+  if (Builder.OptLevel > 0) {
+    const PassManagerBuilderWrapper &BuilderWrapper =
+        static_cast<const PassManagerBuilderWrapper &>(Builder);
+    PM.add(createSwiftMergeFunctionsPass(
+        BuilderWrapper.IRGOpts.MultiThreadedCompilation));
+  }
 }
 
 static void addAddressSanitizerPasses(const PassManagerBuilder &Builder,
@@ -414,6 +418,13 @@ bool swift::performLLVM(IRGenOptions &Opts, DiagnosticEngine *Diags,
         !Opts.PrintInlineTree &&
         !needsRecompile(OutputFilename, HashData, HashGlobal, DiagMutex)) {
       // The llvm IR did not change. We don't need to re-create the object file.
+      if (Stats) {
+        if (DiagMutex)
+          DiagMutex->lock();
+        Stats->getFrontendCounters().NumLLVMModulesReused++;
+        if (DiagMutex)
+          DiagMutex->unlock();
+      }
       return false;
     }
 
@@ -1002,10 +1013,50 @@ static void performParallelIRGeneration(IRGenOptions &Opts,
     }
   }
 
+  // Deduplicate ODR-equivalent definitions which got emitted into more than
+  // one module. The linker would fold them at the end anyway; replacing the
+  // copies with declarations here shrinks the object files and doesn't waste
+  // LLVM compile time on definitions which are thrown away later. The first
+  // module in deterministic creation order keeps the definition.
+  llvm::StringMap<llvm::GlobalValue *> firstDefinition;
+  for (IRGenModule *IGM : irgen.getQueue()) {
+    llvm::Module *M = IGM->getModule();
+    auto deduplicate = [&](llvm::GlobalValue &G) {
+      if (G.isDeclaration())
+        return;
+      if (G.getLinkage() != GlobalValue::LinkOnceODRLinkage)
+        return;
+      auto iter = firstDefinition.try_emplace(G.getName(), &G).first;
+      llvm::GlobalValue *First = iter->second;
+      if (First == &G)
+        return;
+      // The definition which we keep must not be discarded if it's
+      // unreferenced in its own module: this module references it through
+      // the declaration we create below.
+      First->setLinkage(GlobalValue::WeakODRLinkage);
+      // Turn the duplicate definition into an external declaration.
+      if (auto *F = dyn_cast<llvm::Function>(&G)) {
+        F->deleteBody();
+        F->setComdat(nullptr);
+      } else if (auto *GV = dyn_cast<llvm::GlobalVariable>(&G)) {
+        GV->setInitializer(nullptr);
+        GV->setComdat(nullptr);
+      }
+      G.setLinkage(GlobalValue::ExternalLinkage);
+    };
+    for (llvm::GlobalVariable &G : M->getGlobalList()) {
+      deduplicate(G);
+    }
+    for (llvm::Function &F : M->getFunctionList()) {
+      deduplicate(F);
+    }
+    // Aliases cannot be turned into declarations, so we leave them alone.
+  }
+
   for (auto it = irgen.begin(); it != irgen.end(); ++it) {
     IRGenModule *IGM = it->second;
     llvm::Module *M = IGM->getModule();
-    
+
     // Update the linkage of shared functions/globals.
     // If a shared function/global is referenced from another file it must have
     // weak instead of linkonce linkage. Otherwise LLVM would remove the
@@ -1036,6 +1087,13 @@ static void performParallelIRGeneration(IRGenOptions &Opts,
   // Bail out if there are any errors.
   if (Ctx.hadError()) return;
 
+  // The threads pull modules from the queue dynamically, but the static
+  // fetch order still matters: a large module fetched last keeps a single
+  // thread busy after all others have drained the queue. Start with the
+  // largest modules to balance the load. This only affects scheduling; each
+  // module is still compiled to its own output file.
+  irgen.sortQueueByModuleSize();
+
   SharedTimer timer("LLVM pipeline");
 
   std::vector<std::thread> Threads;
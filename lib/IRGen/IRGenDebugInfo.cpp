@@ -113,6 +113,9 @@ class IRGenDebugInfoImpl : public IRGenDebugInfo {
 
   SILLocation::DebugLoc LastDebugLoc; /// The last location that was emitted.
   const SILDebugScope *LastScope;     /// The scope of that last location.
+  /// The IR location constructed for (LastScope, LastDebugLoc), so runs of
+  /// instructions with the same source location skip the scope/file lookups.
+  llvm::DebugLoc LastBuiltDebugLoc;
 
   /// Used by pushLoc.
   SmallVector<std::pair<SILLocation::DebugLoc, const SILDebugScope *>, 8>
@@ -1564,9 +1567,6 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
                                        const SILDebugScope *DS,
                                        Optional<SILLocation> Loc) {
   assert(DS && "empty scope");
-  auto *Scope = getOrCreateScope(DS);
-  if (!Scope)
-    return;
 
   SILFunction *Fn = DS->getInlinedFunction();
   SILLocation::DebugLoc L;
@@ -1584,6 +1584,19 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
     L = getDebugLocation(Loc);
   }
 
+  // Runs of consecutive instructions usually share one source location.
+  // If neither the scope nor the location changed, reuse the IR location
+  // built last time instead of redoing the scope, file, and inlined-at
+  // lookups.
+  if (DS == LastScope && L == LastDebugLoc && LastBuiltDebugLoc) {
+    Builder.SetCurrentDebugLocation(LastBuiltDebugLoc);
+    return;
+  }
+
+  auto *Scope = getOrCreateScope(DS);
+  if (!Scope)
+    return;
+
   auto *File = getOrCreateFile(L.Filename);
   if (File->getFilename() != Scope->getFilename()) {
     // We changed files in the middle of a scope. This happens, for
@@ -1604,12 +1617,14 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
   assert(((!InlinedAt) || (InlinedAt && Scope)) && "inlined w/o scope");
   assert(parentScopesAreSane(DS) && "parent scope sanity check failed");
   auto DL = llvm::DebugLoc::get(L.Line, L.Column, Scope, InlinedAt);
+  LastBuiltDebugLoc = DL;
   Builder.SetCurrentDebugLocation(DL);
 }
 
 void IRGenDebugInfoImpl::clearLoc(IRBuilder &Builder) {
   LastDebugLoc = {};
   LastScope = nullptr;
+  LastBuiltDebugLoc = llvm::DebugLoc();
   Builder.SetCurrentDebugLocation(llvm::DebugLoc());
 }
 
@@ -1619,11 +1634,14 @@ void IRGenDebugInfoImpl::pushLoc() {
   LocationStack.push_back(std::make_pair(LastDebugLoc, LastScope));
   LastDebugLoc = {};
   LastScope = nullptr;
+  LastBuiltDebugLoc = llvm::DebugLoc();
 }
 
 /// Restore the current debug location from the stack.
 void IRGenDebugInfoImpl::popLoc() {
   std::tie(LastDebugLoc, LastScope) = LocationStack.pop_back_val();
+  // The cached IR location may belong to the scope we are leaving.
+  LastBuiltDebugLoc = llvm::DebugLoc();
 }
 
 void IRGenDebugInfoImpl::setEntryPointLoc(IRBuilder &Builder) {
@@ -1185,6 +1185,35 @@ void IRGenerator::addGenModule(SourceFile *SF, IRGenModule *IGM) {
   Queue.push_back(IGM);
 }
 
+/// Returns an estimate for the compilation time of the LLVM module of \p IGM.
+///
+/// The exact cost of the LLVM pipeline is not predictable, but it correlates
+/// well enough with the IR size to be usable for scheduling decisions.
+static unsigned getEstimatedModuleSize(IRGenModule *IGM) {
+  unsigned Size = 0;
+  llvm::Module *M = IGM->getModule();
+  for (llvm::Function &F : M->getFunctionList()) {
+    for (llvm::BasicBlock &BB : F)
+      Size += BB.size();
+  }
+  Size += M->getGlobalList().size();
+  return Size;
+}
+
+void IRGenerator::sortQueueByModuleSize() {
+  llvm::DenseMap<IRGenModule *, unsigned> Sizes;
+  for (IRGenModule *IGM : Queue)
+    Sizes[IGM] = getEstimatedModuleSize(IGM);
+
+  // A stable sort keeps the creation order for equally sized modules, which
+  // keeps the schedule (and with it e.g. the order of diagnostics)
+  // reproducible.
+  std::stable_sort(Queue.begin(), Queue.end(),
+                   [&](IRGenModule *LHS, IRGenModule *RHS) {
+                     return Sizes[LHS] > Sizes[RHS];
+                   });
+}
+
 IRGenModule *IRGenerator::getGenModule(DeclContext *ctxt) {
   if (GenModules.size() == 1 || !ctxt) {
     return getPrimaryIGM();
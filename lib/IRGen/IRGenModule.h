@@ -82,6 +82,7 @@ namespace swift {
   class ASTContext;
   class BraceStmt;
   class CanType;
+  class EnumDecl;
   class LinkLibrary;
   class SILFunction;
   class IRGenOptions;
@@ -106,6 +107,7 @@ namespace irgen {
   class ClangTypeConverter;
   class ClassMetadataLayout;
   class DebugTypeInfo;
+  struct EnumDeclClassification;
   class EnumImplStrategy;
   class EnumMetadataLayout;
   class ExplosionSchema;
@@ -345,6 +347,15 @@ public:
     return it->second;
   }
   
+  /// Returns the IRGenModules in deterministic creation order.
+  ArrayRef<IRGenModule *> getQueue() const { return Queue; }
+
+  /// In multi-threaded compilation, reorder the queue so that the largest
+  /// modules are fetched first. As the queue is consumed greedily by the
+  /// threads, a large module at the end of the queue would serialize the
+  /// tail of the compilation.
+  void sortQueueByModuleSize();
+
   /// In multi-threaded compilation fetch the next IRGenModule from the queue.
   IRGenModule *fetchFromQueue() {
     int idx = QueueIndex++;
@@ -846,6 +857,17 @@ private:
   llvm::DenseMap<SILGlobalVariable *, std::unique_ptr<StructLayout>>
     StaticObjectLayouts;
 
+  /// A cache for the instantiation-independent part of enum implementation
+  /// strategy selection. See EnumImplStrategy::get.
+  llvm::DenseMap<EnumDecl *, std::unique_ptr<EnumDeclClassification>>
+    EnumDeclClassifications;
+
+  /// A cache of whether a conformance's witness table must be instantiated
+  /// at runtime. The answer depends only on the conformance, and computing
+  /// it walks the whole inherited-conformance tree.
+  llvm::DenseMap<const NormalProtocolConformance *, bool>
+    DependentConformances;
+
   /// A mapping from order numbers to the LLVM functions which we
   /// created for the SIL functions with those orders.
   SuccessorMap<unsigned, llvm::Function*> EmittedFunctionsByOrder;
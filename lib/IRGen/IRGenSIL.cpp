@@ -32,6 +32,7 @@
 #include "swift/Basic/ExternalUnion.h"
 #include "swift/Basic/Range.h"
 #include "swift/Basic/STLExtras.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/AST/ASTContext.h"
 #include "swift/AST/IRGenOptions.h"
 #include "swift/AST/Pattern.h"
@@ -51,6 +52,7 @@
 
 #include "CallEmission.h"
 #include "Explosion.h"
+#include "FixedTypeInfo.h"
 #include "GenArchetype.h"
 #include "GenBuiltin.h"
 #include "GenCall.h"
@@ -1479,7 +1481,24 @@ void IRGenModule::emitSILFunction(SILFunction *f) {
     return;
 
   PrettyStackTraceSILFunction stackTrace("emitting IR", f);
-  IRGenSILFunction(*this, f).emitSILFunction();
+
+  UnifiedStatsReporter::FrontendStatsTracer Tracer;
+  if (Context.Stats && f->hasLocation())
+    Tracer = Context.Stats->getStatsTracer("emit-SIL-function",
+                                           f->getLocation().getSourceRange());
+
+  IRGenSILFunction IGF(*this, f);
+  IGF.emitSILFunction();
+
+  // Count the IR this function lowered to while the tracer is still open,
+  // so the per-function deltas land in the stats-events trace.
+  if (auto *Stats = Context.Stats) {
+    auto &C = Stats->getFrontendCounters();
+    for (auto const &BB : *IGF.CurFn) {
+      C.NumIRBasicBlocksEmitted++;
+      C.NumIRInstsEmitted += BB.size();
+    }
+  }
 }
 
 void IRGenSILFunction::emitSILFunction() {
@@ -3403,7 +3422,70 @@ void IRGenSILFunction::visitLoadInst(swift::LoadInst *i) {
   setLoweredExplosion(i, lowered);
 }
 
+/// Minimum fixed size in bytes for which a store of a constant aggregate
+/// is emitted as a copy from a constant global instead of per-element
+/// scalar stores.
+static const unsigned MinimumConstantAggregateStoreSize = 64;
+
+/// Try to emit the store \p i of a large, statically known aggregate as a
+/// copy from a constant global. Generated code (e.g. big literal tables)
+/// would otherwise drown LLVM in thousands of scalar stores.
+static bool tryEmitConstantAggregateStore(IRGenSILFunction &IGF,
+                                          swift::StoreInst *i) {
+  SILValue src = i->getSrc();
+  SILType objType = src->getType().getObjectType();
+  auto &typeInfo = IGF.getTypeInfo(objType);
+
+  // Only POD values can be initialized (and assigned) with a plain copy.
+  if (!typeInfo.isPOD(ResilienceExpansion::Maximal))
+    return false;
+  auto *fixedTI = dyn_cast<FixedTypeInfo>(&typeInfo);
+  if (!fixedTI)
+    return false;
+  Size size = fixedTI->getFixedSize();
+  if (size.getValue() < MinimumConstantAggregateStoreSize)
+    return false;
+  // The constant emission expects the storage type of an aggregate.
+  if (!isa<llvm::StructType>(typeInfo.getStorageType()))
+    return false;
+
+  llvm::Constant *init = nullptr;
+  if (auto *SI = dyn_cast<StructInst>(src)) {
+    if (!isConstantValue(IGF.IGM, src))
+      return false;
+    init = emitConstantStruct(IGF.IGM, SI);
+  } else if (auto *TI = dyn_cast<TupleInst>(src)) {
+    if (!isConstantValue(IGF.IGM, src))
+      return false;
+    init = emitConstantTuple(IGF.IGM, TI);
+  } else {
+    return false;
+  }
+
+  auto *global = new llvm::GlobalVariable(IGF.IGM.Module, init->getType(),
+                                          /*isConstant*/ true,
+                                          llvm::GlobalValue::PrivateLinkage,
+                                          init);
+  global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+  global->setAlignment(fixedTI->getFixedAlignment().getValue());
+
+  Address dest = IGF.getLoweredAddress(i->getDest());
+  IGF.Builder.CreateMemCpy(
+      IGF.Builder.CreateBitOrPointerCast(dest.getAddress(), IGF.IGM.Int8PtrTy),
+      llvm::ConstantExpr::getBitCast(global, IGF.IGM.Int8PtrTy),
+      size.getValue(),
+      std::min(dest.getAlignment(), fixedTI->getFixedAlignment()).getValue());
+
+  if (auto *Stats = IGF.IGM.Context.Stats)
+    Stats->getFrontendCounters().NumIRConstantAggregateBytes +=
+        size.getValue();
+  return true;
+}
+
 void IRGenSILFunction::visitStoreInst(swift::StoreInst *i) {
+  if (tryEmitConstantAggregateStore(*this, i))
+    return;
+
   Explosion source = getLoweredExplosion(i->getSrc());
   Address dest = getLoweredAddress(i->getDest());
   SILType objType = i->getSrc()->getType().getObjectType();
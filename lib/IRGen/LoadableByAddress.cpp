@@ -17,6 +17,7 @@
 //===----------------------------------------------------------------------===//
 
 #define DEBUG_TYPE "loadable-address"
+#include "Explosion.h"
 #include "FixedTypeInfo.h"
 #include "IRGenMangler.h"
 #include "IRGenModule.h"
@@ -24,6 +25,7 @@
 #include "swift/AST/GenericEnvironment.h"
 #include "swift/IRGen/IRGenSILPasses.h"
 #include "swift/SIL/DebugUtils.h"
+#include "swift/SIL/OptimizationRemark.h"
 #include "swift/SIL/SILArgument.h"
 #include "swift/SIL/SILBuilder.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
@@ -37,6 +39,17 @@
 using namespace swift;
 using namespace swift::irgen;
 
+/// Some loadable types fit the native calling convention without indirection
+/// but still explode into enough scalars to flood the register allocator at
+/// every call site. Treat a type as large when its explosion schema exceeds
+/// this many components. Since the rewritten function signatures are ABI, the
+/// limit must be identical in every compilation that can see a given function
+/// type; this option is a debugging knob, not a per-project tuning setting.
+static llvm::cl::opt<unsigned> LargeLoadableMaxScalars(
+    "sil-large-loadable-max-scalars", llvm::cl::init(16),
+    llvm::cl::desc("Pass a loadable type indirectly if its explosion schema "
+                   "has more than this many components"));
+
 static GenericEnvironment *getGenericEnvironment(SILModule &Mod,
                                                  CanSILFunctionType loweredTy) {
   return loweredTy->getGenericSignature()->createGenericEnvironment();
@@ -60,7 +73,12 @@ static bool isLargeLoadableType(GenericEnvironment *GenericEnv, SILType t,
     assert(!canType->hasTypeParameter());
     const TypeInfo &TI = Mod.getTypeInfoForLowered(canType);
     auto &nativeSchemaOrigParam = TI.nativeParameterValueSchema(Mod);
-    return nativeSchemaOrigParam.requiresIndirect();
+    if (nativeSchemaOrigParam.requiresIndirect())
+      return true;
+    // Types that the native convention passes directly can still be
+    // expensive: each component of the explosion occupies a register for
+    // the whole call sequence. Spill oversized explosions to memory too.
+    return TI.getSchema().size() > LargeLoadableMaxScalars;
   }
   return false;
 }
@@ -2088,6 +2106,33 @@ static bool rewriteFunctionReturn(StructLoweringState &pass) {
   return false;
 }
 
+/// Report which large loadable types forced a signature rewrite, so that
+/// users chasing call overhead or code size can find the offending types.
+static void emitLargeTypeRemarks(StructLoweringState &pass,
+                                 bool rewrittenReturn) {
+  if (pass.F->empty())
+    return;
+  OptRemark::Emitter ORE(DEBUG_TYPE, pass.F->getModule());
+  SILInstruction &anchor = pass.F->front().front();
+  for (SILValue arg : pass.largeLoadableArgs) {
+    ORE.emit([&]() {
+      using namespace OptRemark;
+      return RemarkPassed("LargeArgument", anchor)
+             << "argument of type '"
+             << NV("Type", arg->getType().getSwiftRValueType()->getString())
+             << "' is passed indirectly to reduce register pressure";
+    });
+  }
+  if (rewrittenReturn) {
+    ORE.emit([&]() {
+      using namespace OptRemark;
+      return RemarkPassed("LargeReturn", anchor)
+             << "result of " << NV("Function", pass.F)
+             << " is returned indirectly to reduce register pressure";
+    });
+  }
+}
+
 void LoadableByAddress::runOnFunction(SILFunction *F) {
   CanSILFunctionType funcType = F->getLoweredFunctionType();
   IRGenModule *currIRMod = getIRGenModule()->IRGen.getGenModule(F);
@@ -2133,6 +2178,7 @@ void LoadableByAddress::runOnFunction(SILFunction *F) {
       (rewrittenReturn || !pass.largeLoadableArgs.empty() ||
        !pass.funcSigArgs.empty())) {
     modFuncs.insert(F);
+    emitLargeTypeRemarks(pass, rewrittenReturn);
   }
   // If we modified any applies - add them to the global list for recreation
   if (!pass.applies.empty()) {
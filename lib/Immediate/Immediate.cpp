@@ -26,18 +26,40 @@
 #include "swift/AST/Module.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/LLVMContext.h"
+#include "swift/Basic/Version.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/Config/config.h"
 #include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/LambdaResolver.h"
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Mangler.h"
 #include "llvm/Linker/Linker.h"
+#include "llvm/Object/ObjectFile.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <set>
 
 #if defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN
@@ -50,6 +72,19 @@
 using namespace swift;
 using namespace swift::immediate;
 
+static llvm::cl::opt<bool>
+UseObjectCache("swift-immediate-object-cache", llvm::cl::init(true),
+               llvm::cl::Hidden,
+               llvm::cl::desc("Reuse compiled scripts from the user cache "
+                              "directory in immediate mode"));
+
+static llvm::cl::opt<bool>
+UseLazyCompilation("swift-immediate-lazy-compile", llvm::cl::init(true),
+                   llvm::cl::Hidden,
+                   llvm::cl::desc("Compile each function on its first call "
+                                  "instead of compiling the whole script "
+                                  "before it starts running"));
+
 static void *loadRuntimeLib(StringRef runtimeLibPathWithName) {
 #if defined(_WIN32)
   return LoadLibraryA(runtimeLibPathWithName.str().c_str());
@@ -293,6 +328,282 @@ bool swift::immediate::IRGenImportedModules(
   return hadError;
 }
 
+namespace {
+/// An object cache which persists compiled code in the user's cache
+/// directory, so that re-running an unchanged script skips code generation
+/// and starts up like a native binary.  The eager path compiles the whole
+/// script as one module; the lazy path compiles one extracted module per
+/// function, and each gets its own entry.
+///
+/// An entry is keyed by a hash of the module's IR together with the
+/// compiler version and the options which influence code generation, so a
+/// stale hit is impossible: editing the script, updating the compiler or
+/// changing the invocation all select a different entry.  Any filesystem
+/// failure simply degrades to a cache miss and we JIT as before.
+class ImmediateObjectCache : public llvm::ObjectCache {
+  /// The directory holding cache entries, or empty if caching is disabled
+  /// or no user cache directory is available.
+  llvm::SmallString<128> CacheDir;
+
+  /// Everything other than the IR itself that determines the generated
+  /// code; folded into every entry's key.
+  std::string BaseKey;
+
+public:
+  ImmediateObjectCache(IRGenOptions &Opts, StringRef CPU,
+                       ArrayRef<std::string> Features) {
+    if (!UseObjectCache)
+      return;
+    llvm::SmallString<128> Path;
+    if (!llvm::sys::path::cache_directory(Path))
+      return;
+    llvm::sys::path::append(Path, "swift-immediate");
+    CacheDir = Path;
+
+    llvm::raw_string_ostream OS(BaseKey);
+    OS << version::getSwiftFullVersion();
+    OS << Opts.getLLVMCodeGenOptionsHash();
+    OS << CPU;
+    for (const std::string &Feature : Features)
+      OS << Feature;
+    OS.flush();
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer>
+  getObject(const llvm::Module *M) override {
+    auto EntryPath = entryPathFor(M);
+    if (EntryPath.empty())
+      return nullptr;
+    auto Buffer = llvm::MemoryBuffer::getFile(EntryPath, /*FileSize=*/-1,
+                                              /*RequiresNullTerminator=*/false);
+    if (!Buffer)
+      return nullptr;
+    DEBUG(llvm::dbgs() << "Reusing compiled object from " << EntryPath << '\n');
+    return std::move(*Buffer);
+  }
+
+  void notifyObjectCompiled(const llvm::Module *M,
+                            llvm::MemoryBufferRef Obj) override {
+    auto EntryPath = entryPathFor(M);
+    if (EntryPath.empty())
+      return;
+    if (llvm::sys::fs::create_directories(CacheDir))
+      return;
+    // Write to a temporary file and rename it into place, so a concurrent
+    // run of the same script never observes a half-written object.
+    llvm::SmallString<128> TempPath;
+    int TempFD;
+    if (llvm::sys::fs::createUniqueFile(EntryPath + ".tmp-%%%%%%",
+                                        TempFD, TempPath))
+      return;
+    {
+      llvm::raw_fd_ostream OS(TempFD, /*shouldClose=*/true);
+      OS << Obj.getBuffer();
+    }
+    if (llvm::sys::fs::rename(TempPath, EntryPath))
+      llvm::sys::fs::remove(TempPath);
+  }
+
+private:
+  /// Computes the path of the cache entry for \p M, hashing its IR the
+  /// same way incremental compilation fingerprints its object files.
+  /// Returns an empty path when caching is unavailable.
+  llvm::SmallString<128> entryPathFor(const llvm::Module *M) const {
+    llvm::SmallString<128> Path;
+    if (CacheDir.empty())
+      return Path;
+
+    llvm::SmallString<0> Ingredients;
+    {
+      llvm::raw_svector_ostream OS(Ingredients);
+      llvm::WriteBitcodeToFile(M, OS);
+      OS << BaseKey;
+    }
+    llvm::MD5 Hash;
+    Hash.update(Ingredients);
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    llvm::SmallString<32> Key;
+    llvm::MD5::stringifyResult(Result, Key);
+
+    Path = CacheDir;
+    llvm::sys::path::append(Path, Key + ".o");
+    return Path;
+  }
+};
+
+/// A compile functor for the lazy path's IRCompileLayer which consults the
+/// object cache around the ordinary compiler, so that on repeat runs of an
+/// unchanged script each function called skips code generation.
+class CachingCompiler {
+  llvm::orc::SimpleCompiler Compile;
+  ImmediateObjectCache &Cache;
+
+public:
+  CachingCompiler(llvm::TargetMachine &TM, ImmediateObjectCache &Cache)
+      : Compile(TM), Cache(Cache) {}
+
+  llvm::object::OwningBinary<llvm::object::ObjectFile>
+  operator()(llvm::Module &M) {
+    if (auto Buffer = Cache.getObject(&M)) {
+      auto Obj =
+          llvm::object::ObjectFile::createObjectFile(Buffer->getMemBufferRef());
+      if (Obj)
+        return {std::move(*Obj), std::move(Buffer)};
+      llvm::consumeError(Obj.takeError());
+    }
+    auto Result = Compile(M);
+    if (Result.getBinary())
+      Cache.notifyObjectCompiled(&M,
+                                 Result.getBinary()->getMemoryBufferRef());
+    return Result;
+  }
+};
+} // end anonymous namespace
+
+/// Runs \p ModuleOwner by compiling each function on its first call through
+/// an ORC JIT stub, rather than compiling the whole script before it starts
+/// running.  A script with a large, rarely-exercised helper surface only
+/// ever pays for the code it actually executes, and \p ObjectCache persists
+/// each compiled function so a repeat run of an unchanged script does not
+/// even pay that.
+///
+/// Returns None when the target has no stub support, in which case the
+/// module is left untouched and the caller should fall back to eager
+/// compilation.
+static Optional<int> runLazily(std::unique_ptr<llvm::Module> &ModuleOwner,
+                               ImmediateObjectCache &ObjectCache,
+                               const llvm::TargetOptions &TargetOpt,
+                               StringRef CPU,
+                               const std::vector<std::string> &Features,
+                               ArrayRef<llvm::Function *> InitFns,
+                               const ProcessCmdLine &CmdLine) {
+  llvm::Triple ModuleTriple(ModuleOwner->getTargetTriple());
+
+  // Lazy compilation routes every call through a stub which the callback
+  // manager patches when the callee is first reached; not every target can
+  // make one.
+  auto CallbackManager =
+      llvm::orc::createLocalCompileCallbackManager(ModuleTriple, 0);
+  if (!CallbackManager)
+    return None;
+
+  llvm::EngineBuilder TMBuilder;
+  TMBuilder.setRelocationModel(llvm::Reloc::PIC_);
+  TMBuilder.setTargetOptions(TargetOpt);
+  SmallVector<std::string, 8> FeatureVec(Features.begin(), Features.end());
+  std::unique_ptr<llvm::TargetMachine> TM(
+      TMBuilder.selectTarget(ModuleTriple, /*MArch=*/"", CPU, FeatureVec));
+  if (!TM)
+    return None;
+
+  llvm::DataLayout DL = TM->createDataLayout();
+  ModuleOwner->setDataLayout(DL);
+
+  llvm::orc::RTDyldObjectLinkingLayer ObjectLayer(
+      []() { return std::make_shared<llvm::SectionMemoryManager>(); });
+  llvm::orc::IRCompileLayer<decltype(ObjectLayer), CachingCompiler>
+      CompileLayer(ObjectLayer, CachingCompiler(*TM, ObjectCache));
+  llvm::orc::CompileOnDemandLayer<decltype(CompileLayer)> CODLayer(
+      CompileLayer,
+      [](llvm::Function &F) { return std::set<llvm::Function *>({&F}); },
+      *CallbackManager,
+      llvm::orc::createLocalIndirectStubsManagerBuilder(ModuleTriple));
+
+  auto mangle = [&DL](StringRef Name) {
+    llvm::SmallString<32> Mangled;
+    llvm::Mangler::getNameWithPrefix(Mangled, Name, DL);
+    return Mangled.str().str();
+  };
+
+  // Anything the JIT cannot resolve internally lives in the swift runtime
+  // or an autolinked library, all of which are already loaded into this
+  // process.
+  auto Resolver = llvm::orc::createLambdaResolver(
+      [&CODLayer](const std::string &Name) -> llvm::JITSymbol {
+        if (auto Sym = CODLayer.findSymbol(Name, false))
+          return Sym;
+        return nullptr;
+      },
+      [](const std::string &Name) -> llvm::JITSymbol {
+        if (auto Addr =
+                llvm::RTDyldMemoryManager::getSymbolAddressInProcess(Name))
+          return llvm::JITSymbol(Addr, llvm::JITSymbolFlags::Exported);
+        return nullptr;
+      });
+
+  // Remember the constructors and entry points before the module moves into
+  // the JIT.
+  std::vector<std::string> CtorNames;
+  for (auto Ctor : llvm::orc::getConstructors(*ModuleOwner))
+    CtorNames.push_back(mangle(Ctor.Func->getName()));
+  std::vector<std::string> EntryNames;
+  for (llvm::Function *InitFn : InitFns)
+    EntryNames.push_back(mangle(InitFn->getName()));
+  EntryNames.push_back(mangle("main"));
+
+  std::shared_ptr<llvm::Module> M = std::move(ModuleOwner);
+  if (auto Err =
+          CODLayer.addModule(std::move(M), std::move(Resolver)).takeError()) {
+    llvm::logAllUnhandledErrors(std::move(Err), llvm::errs(),
+                                "Error loading lazy JIT: ");
+    return -1;
+  }
+
+  SmallVector<const char *, 32> Argv;
+  for (const std::string &Arg : CmdLine)
+    Argv.push_back(Arg.c_str());
+  Argv.push_back(nullptr);
+
+  // Materializes \p Name and runs it as a main function, returning its exit
+  // code, or None on a JIT failure (which has already been reported).
+  auto callAsMain = [&](const std::string &Name) -> Optional<int> {
+    auto Sym = CODLayer.findSymbol(Name, false);
+    if (!Sym) {
+      llvm::errs() << "Error loading lazy JIT: missing symbol " << Name << '\n';
+      return None;
+    }
+    auto Addr = Sym.getAddress();
+    if (!Addr) {
+      llvm::logAllUnhandledErrors(Addr.takeError(), llvm::errs(),
+                                  "Error materializing " + Name + ": ");
+      return None;
+    }
+    auto *Fn =
+        reinterpret_cast<int (*)(int, char **)>(static_cast<uintptr_t>(*Addr));
+    return Fn(static_cast<int>(CmdLine.size()),
+              const_cast<char **>(Argv.data()));
+  };
+
+  // Run the generated program, in the same order the eager path does:
+  // initializers for imported source modules, static constructors, main.
+  for (unsigned i = 0, e = EntryNames.size() - 1; i != e; ++i) {
+    DEBUG(llvm::dbgs() << "Running initialization function "
+                       << EntryNames[i] << '\n');
+    if (!callAsMain(EntryNames[i]))
+      return -1;
+  }
+
+  DEBUG(llvm::dbgs() << "Running static constructors\n");
+  for (const std::string &Name : CtorNames) {
+    auto Sym = CODLayer.findSymbol(Name, false);
+    if (!Sym)
+      continue;
+    auto Addr = Sym.getAddress();
+    if (!Addr) {
+      llvm::logAllUnhandledErrors(Addr.takeError(), llvm::errs(),
+                                  "Error materializing " + Name + ": ");
+      return -1;
+    }
+    reinterpret_cast<void (*)()>(static_cast<uintptr_t>(*Addr))();
+  }
+
+  DEBUG(llvm::dbgs() << "Running main\n");
+  if (auto Result = callAsMain(EntryNames.back()))
+    return *Result;
+  return -1;
+}
+
 int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
                           IRGenOptions &IRGenOpts, const SILOptions &SILOpts) {
   ASTContext &Context = CI.getASTContext();
@@ -354,14 +665,30 @@ int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
   PMBuilder.OptLevel = 2;
   PMBuilder.Inliner = llvm::createFunctionInliningPass(200);
 
-  // Build the ExecutionEngine.
-  llvm::EngineBuilder builder(std::move(ModuleOwner));
-  std::string ErrorMsg;
   llvm::TargetOptions TargetOpt;
   std::string CPU;
   std::vector<std::string> Features;
   std::tie(TargetOpt, CPU, Features)
     = getIRTargetOptions(IRGenOpts, swiftModule->getASTContext());
+
+  // Both paths below check for previously compiled objects, so that repeated
+  // runs of an unchanged script skip code generation.
+  ImmediateObjectCache ObjectCache(IRGenOpts, CPU, Features);
+
+  // Prefer compiling each function when it is first called, so that a script
+  // starts running after generating only the code on its startup path.  On
+  // targets without stub support this leaves the module untouched and we
+  // compile everything eagerly below.
+  if (UseLazyCompilation) {
+    if (auto Result = runLazily(ModuleOwner, ObjectCache, TargetOpt, CPU,
+                                Features, InitFns, CmdLine))
+      return *Result;
+  }
+
+  // Build the ExecutionEngine.
+  llvm::EngineBuilder builder(std::move(ModuleOwner));
+  std::string ErrorMsg;
+
   builder.setRelocationModel(llvm::Reloc::PIC_);
   builder.setTargetOptions(TargetOpt);
   builder.setMCPU(CPU);
@@ -373,6 +700,7 @@ int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
     llvm::errs() << "Error loading JIT: " << ErrorMsg;
     return -1;
   }
+  EE->setObjectCache(&ObjectCache);
 
   DEBUG(llvm::dbgs() << "Module to be executed:\n";
         Module->dump());
@@ -843,6 +843,7 @@ private:
         return false;
 
       CI.getASTContext().Diags.resetHadAnyError();
+      REPLInputFile.truncateDeclsInLookupCache(RC.CurElem);
       while (REPLInputFile.Decls.size() > RC.CurElem)
         REPLInputFile.Decls.pop_back();
       
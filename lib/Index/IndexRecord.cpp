@@ -23,6 +23,7 @@
 #include "swift/AST/ModuleLoader.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/Index/Index.h"
+#include "swift/Basic/StringExtras.h"
 #include "swift/Strings.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -31,6 +32,8 @@
 #include "clang/Index/IndexUnitWriter.h"
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/Support/Path.h"
+#include <atomic>
+#include <thread>
 
 using namespace swift;
 using namespace swift::index;
@@ -44,6 +47,11 @@ using clang::index::SymbolRoleSet;
 //===----------------------------------------------------------------------===//
 
 namespace {
+/// Accumulates the symbols and occurrences of a single record file.
+///
+/// The tracker owns copies of the symbol strings, so it stays valid after the
+/// AST walk that produced it finishes and can be handed to another thread to
+/// be written out.
 class SymbolTracker {
 public:
   struct SymbolRelation {
@@ -108,9 +116,9 @@ public:
     auto pair = USRToSymbol.insert(std::make_pair(indexSym.USR.data(),
                                                   symbols.size()));
     if (pair.second) {
-      Symbol symbol{indexSym.name,
-                    indexSym.USR,
-                    indexSym.group,
+      Symbol symbol{stringStorage.copyString(indexSym.name),
+                    stringStorage.copyString(indexSym.USR),
+                    stringStorage.copyString(indexSym.group),
                     indexSym.symInfo,
                     0};
       recordHash = llvm::hash_combine(recordHash, symbol.hash());
@@ -143,6 +151,7 @@ private:
   llvm::DenseMap<const char *, size_t> USRToSymbol;
   std::vector<Symbol> symbols;
   std::vector<SymbolOccurrence> occurrences;
+  swift::StringScratchSpace stringStorage;
   bool sorted = false;
   llvm::hash_code recordHash = 0;
 };
@@ -271,8 +280,13 @@ StringRef StdlibGroupsIndexRecordingConsumer::findGroupForSymbol(const IndexSymb
   llvm_unreachable("did not find group name for reference");
 }
 
+/// Writes \p record to the index store. This touches no AST state, so it is
+/// safe to call concurrently for different records; diagnosing any returned
+/// \p error is left to the caller.
+///
+/// \returns true if an error occurred.
 static bool writeRecord(SymbolTracker &record, std::string Filename,
-                        std::string indexStorePath, DiagnosticEngine *diags,
+                        std::string indexStorePath, std::string &error,
                         std::string &outRecordFile) {
   if (record.getOccurrences().empty()) {
     outRecordFile = std::string();
@@ -280,12 +294,10 @@ static bool writeRecord(SymbolTracker &record, std::string Filename,
   }
 
   IndexRecordWriter recordWriter(indexStorePath);
-  std::string error;
   auto result = recordWriter.beginRecord(
       Filename, record.hashRecord(), error, &outRecordFile);
   switch (result) {
   case IndexRecordWriter::Result::Failure:
-    diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
     return true;
   case IndexRecordWriter::Result::AlreadyExists:
     return false;
@@ -316,10 +328,8 @@ static bool writeRecord(SymbolTracker &record, std::string Filename,
     return result;
   });
 
-  if (result == IndexRecordWriter::Result::Failure) {
-    diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
+  if (result == IndexRecordWriter::Result::Failure)
     return true;
-  }
 
   return false;
 }
@@ -330,25 +340,14 @@ makeRecordingConsumer(std::string Filename, std::string indexStorePath,
                       std::string *outRecordFile,
                       bool *outFailed) {
   return llvm::make_unique<IndexRecordingConsumer>([=](SymbolTracker &record) {
-    *outFailed = writeRecord(record, Filename, indexStorePath, diags,
+    std::string error;
+    *outFailed = writeRecord(record, Filename, indexStorePath, error,
                              *outRecordFile);
+    if (*outFailed)
+      diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
   });
 }
 
-static bool
-recordSourceFile(SourceFile *SF, StringRef indexStorePath,
-                 DiagnosticEngine &diags,
-                 llvm::function_ref<void(StringRef, StringRef)> callback) {
-  std::string recordFile;
-  bool failed = false;
-  auto consumer = makeRecordingConsumer(SF->getFilename(), indexStorePath,
-                                        &diags, &recordFile, &failed);
-  indexSourceFile(SF, /*Hash=*/"", *consumer);
-
-  if (!failed && !recordFile.empty())
-    callback(recordFile, SF->getFilename());
-  return failed;
-}
 
 //===----------------------------------------------------------------------===//
 // Index unit file writing
@@ -532,7 +531,12 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
       appendGroupNameForFilename(groupName, fileNameWithGroup);
 
       std::string outRecordFile;
-      failed = failed || writeRecord(tracker, fileNameWithGroup.str(), indexStorePath, &diags, outRecordFile);
+      std::string error;
+      bool writeFailed = writeRecord(tracker, fileNameWithGroup.str(),
+                                     indexStorePath, error, outRecordFile);
+      if (writeFailed)
+        diags.diagnose(SourceLoc(), diag::error_write_index_record, error);
+      failed = failed || writeFailed;
       if (failed)
         return false;
       records.emplace_back(outRecordFile, moduleName.str());
@@ -583,13 +587,19 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
   return false;
 }
 
+/// Writes the unit file for \p primarySourceFile, referencing the
+/// already-written record file \p recordFile (empty if the file produced no
+/// occurrences).
+///
+/// \returns true if an error occurred.
 static bool
-recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
-                     StringRef indexStorePath, bool indexSystemModules,
-                     bool isDebugCompilation, StringRef targetTriple,
-                     ArrayRef<const clang::FileEntry *> fileDependencies,
-                     const clang::CompilerInstance &clangCI,
-                     DiagnosticEngine &diags) {
+writeSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
+                    StringRef indexStorePath, bool indexSystemModules,
+                    bool isDebugCompilation, StringRef targetTriple,
+                    ArrayRef<const clang::FileEntry *> fileDependencies,
+                    StringRef recordFile,
+                    const clang::CompilerInstance &clangCI,
+                    DiagnosticEngine &diags) {
   auto &fileMgr = clangCI.getFileManager();
   auto *module = primarySourceFile->getParentModule();
   bool isSystem = module->isSystemModule();
@@ -614,11 +624,9 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
   for (auto *F : fileDependencies)
     unitWriter.addFileDependency(F, /*FIXME:isSystem=*/false, /*Module=*/nullptr);
 
-  recordSourceFile(primarySourceFile, indexStorePath, diags,
-                   [&](StringRef recordFile, StringRef filename) {
-    unitWriter.addRecordFile(recordFile, fileMgr.getFile(filename),
-                             module->isSystemModule(), /*Module=*/nullptr);
-  });
+  if (!recordFile.empty())
+    unitWriter.addRecordFile(recordFile, mainFile, module->isSystemModule(),
+                             /*Module=*/nullptr);
 
   std::string error;
   if (unitWriter.write(error)) {
@@ -629,6 +637,28 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
   return false;
 }
 
+static bool
+recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
+                     StringRef indexStorePath, bool indexSystemModules,
+                     bool isDebugCompilation, StringRef targetTriple,
+                     ArrayRef<const clang::FileEntry *> fileDependencies,
+                     const clang::CompilerInstance &clangCI,
+                     DiagnosticEngine &diags) {
+  std::string recordFile;
+  bool failed = false;
+  auto consumer = makeRecordingConsumer(primarySourceFile->getFilename(),
+                                        indexStorePath, &diags, &recordFile,
+                                        &failed);
+  indexSourceFile(primarySourceFile, /*Hash=*/"", *consumer);
+  if (failed)
+    return true;
+
+  return writeSourceFileUnit(primarySourceFile, indexUnitToken, indexStorePath,
+                             indexSystemModules, isDebugCompilation,
+                             targetTriple, fileDependencies, recordFile,
+                             clangCI, diags);
+}
+
 // Not currently used, see related comments in the call sites.
 #if 0
 static void
@@ -721,22 +751,75 @@ bool index::indexAndRecord(ModuleDecl *module,
   collectFileDependencies(fileDependencies, dependencyTracker, module, fileMgr);
 #endif
 
-  // Write a unit for each source file.
-  unsigned unitIndex = 0;
+  // Collect the source files to index.
+  std::vector<SourceFile *> sourceFiles;
   for (auto *F : module->getFiles()) {
     if (auto *SF = dyn_cast<SourceFile>(F)) {
-      if (unitIndex == indexUnitTokens.size()) {
+      if (sourceFiles.size() == indexUnitTokens.size()) {
         diags.diagnose(SourceLoc(), diag::error_index_inputs_more_than_outputs);
         return true;
       }
-      if (recordSourceFileUnit(SF, indexUnitTokens[unitIndex],
-                               indexStorePath, indexSystemModules,
-                               isDebugCompilation, targetTriple,
-                               fileDependencies.getArrayRef(),
-                               clangCI, diags))
-        return true;
-      unitIndex += 1;
+      sourceFiles.push_back(SF);
+    }
+  }
+
+  // Walk each file's AST on the main thread, stashing its symbols in a
+  // per-file tracker. The walks cannot run concurrently because they trigger
+  // lazy member loading, which mutates the AST.
+  struct FileRecordState {
+    SymbolTracker record;
+    std::string recordFile;
+    std::string error;
+    bool failed = false;
+  };
+  std::vector<FileRecordState> recordStates(sourceFiles.size());
+  for (unsigned i = 0, e = sourceFiles.size(); i != e; ++i) {
+    auto *state = &recordStates[i];
+    IndexRecordingConsumer consumer([state](SymbolTracker &record) {
+      state->record = std::move(record);
+    });
+    indexSourceFile(sourceFiles[i], /*Hash=*/"", consumer);
+  }
+
+  // The trackers own their strings, so writing the record files touches no
+  // AST state; farm it out to worker threads that pull files from the queue.
+  // Each thread writes only its own entries, and any errors are diagnosed
+  // after the join.
+  unsigned numThreads = std::max(1u, std::min(
+      std::thread::hardware_concurrency(),
+      static_cast<unsigned>(recordStates.size())));
+  std::atomic<unsigned> nextFileIndex(0);
+  auto writeRecords = [&] {
+    while (true) {
+      unsigned i = nextFileIndex.fetch_add(1);
+      if (i >= recordStates.size())
+        break;
+      auto &state = recordStates[i];
+      state.failed = writeRecord(state.record, sourceFiles[i]->getFilename(),
+                                 indexStorePath, state.error,
+                                 state.recordFile);
     }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; ++i)
+    threads.push_back(std::thread(writeRecords));
+  writeRecords();
+  for (std::thread &thread : threads)
+    thread.join();
+
+  // Write a unit for each source file.
+  for (unsigned i = 0, e = sourceFiles.size(); i != e; ++i) {
+    auto &state = recordStates[i];
+    if (state.failed) {
+      diags.diagnose(SourceLoc(), diag::error_write_index_record, state.error);
+      return true;
+    }
+    if (writeSourceFileUnit(sourceFiles[i], indexUnitTokens[i],
+                            indexStorePath, indexSystemModules,
+                            isDebugCompilation, targetTriple,
+                            fileDependencies.getArrayRef(),
+                            state.recordFile, clangCI, diags))
+      return true;
   }
 
   // In the case where inputs are swift modules, like in the merge-module step,
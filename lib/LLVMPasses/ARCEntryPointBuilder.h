@@ -59,6 +59,8 @@ class ARCEntryPointBuilder {
   NullablePtr<Constant> CheckUnowned;
   NullablePtr<Constant> RetainN;
   NullablePtr<Constant> ReleaseN;
+  NullablePtr<Constant> RetainPair;
+  NullablePtr<Constant> ReleasePair;
   NullablePtr<Constant> UnknownRetainN;
   NullablePtr<Constant> UnknownReleaseN;
   NullablePtr<Constant> BridgeRetainN;
@@ -179,6 +181,24 @@ public:
     return CI;
   }
 
+  CallInst *createRetainPair(Value *V1, Value *V2, CallInst *OrigI) {
+    // Cast just to make sure that we have the right object type.
+    V1 = B.CreatePointerCast(V1, getObjectPtrTy());
+    V2 = B.CreatePointerCast(V2, getObjectPtrTy());
+    CallInst *CI = CreateCall(getRetainPair(OrigI), {V1, V2});
+    CI->setTailCall(true);
+    return CI;
+  }
+
+  CallInst *createReleasePair(Value *V1, Value *V2, CallInst *OrigI) {
+    // Cast just to make sure we have the right object type.
+    V1 = B.CreatePointerCast(V1, getObjectPtrTy());
+    V2 = B.CreatePointerCast(V2, getObjectPtrTy());
+    CallInst *CI = CreateCall(getReleasePair(OrigI), {V1, V2});
+    CI->setTailCall(true);
+    return CI;
+  }
+
   CallInst *createUnknownRetainN(Value *V, uint32_t n, CallInst *OrigI) {
     // Cast just to make sure that we have the right object type.
     V = B.CreatePointerCast(V, getObjectPtrTy());
@@ -319,6 +339,42 @@ private:
     return ReleaseN.get();
   }
 
+  /// Return a callable function for swift_retain_pair.
+  Constant *getRetainPair(CallInst *OrigI) {
+    if (RetainPair)
+      return RetainPair.get();
+    auto *ObjectPtrTy = getObjectPtrTy();
+    auto *VoidTy = Type::getVoidTy(getModule().getContext());
+
+    llvm::Constant *cache = nullptr;
+    RetainPair =
+        getRuntimeFn(getModule(), cache,
+                     isNonAtomic(OrigI) ? "swift_nonatomic_retain_pair"
+                                        : "swift_retain_pair",
+                     DefaultCC, {VoidTy}, {ObjectPtrTy, ObjectPtrTy},
+                     {NoUnwind});
+
+    return RetainPair.get();
+  }
+
+  /// Return a callable function for swift_release_pair.
+  Constant *getReleasePair(CallInst *OrigI) {
+    if (ReleasePair)
+      return ReleasePair.get();
+    auto *ObjectPtrTy = getObjectPtrTy();
+    auto *VoidTy = Type::getVoidTy(getModule().getContext());
+
+    llvm::Constant *cache = nullptr;
+    ReleasePair =
+        getRuntimeFn(getModule(), cache,
+                     isNonAtomic(OrigI) ? "swift_nonatomic_release_pair"
+                                        : "swift_release_pair",
+                     DefaultCC, {VoidTy}, {ObjectPtrTy, ObjectPtrTy},
+                     {NoUnwind});
+
+    return ReleasePair.get();
+  }
+
   /// getUnknownRetainN - Return a callable function for swift_unknownRetain_n.
   Constant *getUnknownRetainN(CallInst *OrigI) {
     if (UnknownRetainN)
@@ -34,6 +34,9 @@ STATISTIC(NumUnknownRetainReleasesEliminatedByMergingIntoRetainReleaseN,
 STATISTIC(NumBridgeRetainReleasesEliminatedByMergingIntoRetainReleaseN,
           "Number of bridge retain/release eliminated by merging into "
           "bridgeRetain_n/bridgeRelease_n");
+STATISTIC(NumRetainReleasesEliminatedByMergingIntoRetainReleasePair,
+          "Number of retain/release on distinct objects eliminated by merging "
+          "into retain_pair/release_pair");
 
 /// Pimpl implementation of SwiftARCContractPass.
 namespace {
@@ -84,6 +87,12 @@ private:
   /// call.
   void
   performRRNOptimization(DenseMap<Value *, LocalState> &PtrToLocalStateMap);
+
+  /// Merge neighbouring retains or releases of two *distinct* objects into a
+  /// single call to the pair entry points. This runs after the per-object
+  /// merging, so it only sees operations that could not be combined into a
+  /// retain_n/release_n call.
+  void performPairMerging(BasicBlock &BB);
 };
 
 } // end anonymous namespace
@@ -253,6 +262,104 @@ performRRNOptimization(DenseMap<Value *, LocalState> &PtrToLocalStateMap) {
 }
 
 
+void SwiftARCContractImpl::performPairMerging(BasicBlock &BB) {
+  // A retain or release we have seen but not yet paired up. The same
+  // windowing discipline as the per-object merging applies: an unknown call
+  // (or load/store) ends both windows, so no operation ever moves across
+  // something that could observe a reference count. A retain additionally
+  // may not move past any flavor of release, since the two pointers may
+  // dynamically alias and sinking the retain could drop the count to zero
+  // early. Releases only ever move later, which merely delays destruction.
+  CallInst *PendingRetain = nullptr;
+  CallInst *PendingRelease = nullptr;
+
+  for (auto II = BB.begin(), IE = BB.end(); II != IE; ) {
+    // Preincrement iterator to avoid iteration issues in the loop.
+    Instruction &Inst = *II++;
+
+    switch (classifyInstruction(Inst)) {
+    case RT_Retain: {
+      auto *CI = cast<CallInst>(&Inst);
+      auto *Root = RC->getSwiftRCIdentityRoot(CI->getArgOperand(0));
+      if (PendingRetain && B.isAtomic(CI) == B.isAtomic(PendingRetain) &&
+          Root != RC->getSwiftRCIdentityRoot(PendingRetain->getArgOperand(0))) {
+        // Sink the pending retain down to this one: both operands are
+        // defined by this point, and nothing in between observes a
+        // reference count.
+        B.setInsertPoint(CI);
+        B.createRetainPair(
+            RC->getSwiftRCIdentityRoot(PendingRetain->getArgOperand(0)), Root,
+            CI);
+        PendingRetain->eraseFromParent();
+        CI->eraseFromParent();
+        PendingRetain = nullptr;
+        ++NumRetainReleasesEliminatedByMergingIntoRetainReleasePair;
+        Changed = true;
+        continue;
+      }
+      PendingRetain = CI;
+      continue;
+    }
+    case RT_Release: {
+      auto *CI = cast<CallInst>(&Inst);
+      auto *Root = RC->getSwiftRCIdentityRoot(CI->getArgOperand(0));
+      if (PendingRelease && B.isAtomic(CI) == B.isAtomic(PendingRelease) &&
+          Root !=
+              RC->getSwiftRCIdentityRoot(PendingRelease->getArgOperand(0))) {
+        // Delay the pending release down to this one.
+        B.setInsertPoint(CI);
+        B.createReleasePair(
+            RC->getSwiftRCIdentityRoot(PendingRelease->getArgOperand(0)), Root,
+            CI);
+        PendingRelease->eraseFromParent();
+        CI->eraseFromParent();
+        // The merged release still ends the retain window; see above.
+        PendingRetain = nullptr;
+        PendingRelease = nullptr;
+        ++NumRetainReleasesEliminatedByMergingIntoRetainReleasePair;
+        Changed = true;
+        continue;
+      }
+      // A release ends the retain window; see above.
+      PendingRetain = nullptr;
+      PendingRelease = CI;
+      continue;
+    }
+    case RT_ReleaseN:
+    case RT_UnknownRelease:
+    case RT_UnknownReleaseN:
+    case RT_BridgeRelease:
+    case RT_BridgeReleaseN:
+    case RT_ReleasePair:
+      // Another flavor of release may decrement an aliasing count; only a
+      // pending retain has to stop here, a pending release is merely delayed
+      // a little further.
+      PendingRetain = nullptr;
+      continue;
+    case RT_NoMemoryAccessed:
+    case RT_AllocObject:
+    case RT_RetainN:
+    case RT_RetainPair:
+    case RT_UnknownRetain:
+    case RT_UnknownRetainN:
+    case RT_BridgeRetain:
+    case RT_BridgeRetainN:
+    case RT_FixLifetime:
+    case RT_EndBorrow:
+      // These cannot observe a reference count.
+      continue;
+    case RT_RetainUnowned:
+    case RT_CheckUnowned:
+    case RT_ObjCRetain:
+    case RT_ObjCRelease:
+    case RT_Unknown:
+      PendingRetain = nullptr;
+      PendingRelease = nullptr;
+      continue;
+    }
+  }
+}
+
 bool SwiftARCContractImpl::run() {
   // intra-BB retain/release merging.
   DenseMap<Value *, LocalState> PtrToLocalStateMap;
@@ -271,6 +378,8 @@ bool SwiftARCContractImpl::run() {
       case RT_ReleaseN:
       case RT_UnknownReleaseN:
       case RT_BridgeReleaseN:
+      case RT_RetainPair:
+      case RT_ReleasePair:
         llvm_unreachable("These are only created by LLVMARCContract !");
       // Delete all fix lifetime and end borrow instructions. After llvm-ir they
       // have no use and show up as calls in the final binary.
@@ -367,6 +476,10 @@ bool SwiftARCContractImpl::run() {
     // Perform the RRNOptimization.
     performRRNOptimization(PtrToLocalStateMap);
     PtrToLocalStateMap.clear();
+
+    // With the per-object sequences merged, batch neighbouring operations on
+    // distinct objects into the pair entry points.
+    performPairMerging(BB);
   }
 
   return Changed;
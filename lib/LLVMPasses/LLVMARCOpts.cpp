@@ -96,6 +96,8 @@ static bool canonicalizeInputFunction(Function &F, ARCEntryPointBuilder &B,
       case RT_ReleaseN:
       case RT_UnknownReleaseN:
       case RT_BridgeReleaseN:
+      case RT_RetainPair:
+      case RT_ReleasePair:
         llvm_unreachable("These are only created by LLVMARCContract !");
       case RT_Unknown:
       case RT_BridgeRelease:
@@ -282,6 +284,8 @@ static bool performLocalReleaseMotion(CallInst &Release, BasicBlock &BB,
     case RT_UnknownReleaseN:
     case RT_BridgeReleaseN:
     case RT_ReleaseN:
+    case RT_RetainPair:
+    case RT_ReleasePair:
         llvm_unreachable("These are only created by LLVMARCContract !");
     case RT_NoMemoryAccessed:
       // Skip over random instructions that don't touch memory.  They don't need
@@ -433,6 +437,8 @@ static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
     case RT_ReleaseN:
     case RT_UnknownReleaseN:
     case RT_BridgeReleaseN:
+    case RT_RetainPair:
+    case RT_ReleasePair:
         llvm_unreachable("These are only created by LLVMARCContract !");
     case RT_NoMemoryAccessed:
     case RT_AllocObject:
@@ -588,6 +594,8 @@ static DtorKind analyzeDestructor(Value *P) {
       case RT_ReleaseN:
       case RT_UnknownReleaseN:
       case RT_BridgeReleaseN:
+      case RT_RetainPair:
+      case RT_ReleasePair:
         llvm_unreachable("These are only created by LLVMARCContract !");
       case RT_NoMemoryAccessed:
       case RT_AllocObject:
@@ -704,6 +712,8 @@ static bool performStoreOnlyObjectElimination(CallInst &Allocation,
     case RT_ReleaseN:
     case RT_UnknownReleaseN:
     case RT_BridgeReleaseN:
+    case RT_RetainPair:
+    case RT_ReleasePair:
       llvm_unreachable("These are only created by LLVMARCContract !");
     case RT_AllocObject:
       // If this is a different swift_allocObject than we started with, then
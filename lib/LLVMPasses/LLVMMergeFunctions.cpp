@@ -35,6 +35,7 @@
 #include "llvm/ADT/FoldingSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/IR/Attributes.h"
@@ -53,6 +54,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_ostream.h"
 #include <vector>
 
@@ -63,6 +65,8 @@ using namespace swift;
 
 STATISTIC(NumSwiftFunctionsMerged, "Number of functions merged");
 STATISTIC(NumSwiftThunksWritten, "Number of thunks generated");
+STATISTIC(NumSwiftInstructionsSaved,
+          "Number of instructions eliminated by merging functions");
 
 static cl::opt<unsigned> NumFunctionsForSanityCheck(
     "swiftmergefunc-sanity",
@@ -77,6 +81,14 @@ static cl::opt<unsigned> FunctionMergeThreshold(
              "'0' disables function merging at all."),
     cl::init(30), cl::Hidden);
 
+static cl::opt<bool> EnableCrossModuleMerging(
+    "swiftmergefunc-cross-module",
+    cl::desc("Give merged functions content-derived names and "
+             "linker-deduplicatable linkage, so that identical merged "
+             "functions created in different LLVM modules are folded at "
+             "link time."),
+    cl::init(false), cl::Hidden);
+
 namespace {
 
 /// FunctionComparator - Compares two functions to determine whether or not
@@ -217,8 +229,9 @@ namespace {
 class SwiftMergeFunctions : public ModulePass {
 public:
   static char ID;
-  SwiftMergeFunctions()
-    : ModulePass(ID), FnTree(FunctionNodeCmp(&GlobalNumbers)) {
+  SwiftMergeFunctions(bool CrossModule = false)
+    : ModulePass(ID), CrossModule(CrossModule),
+      FnTree(FunctionNodeCmp(&GlobalNumbers)) {
   }
 
   bool runOnModule(Module &M) override;
@@ -363,6 +376,12 @@ private:
 
   typedef SmallVector<ParamInfo, maxAddedParams> ParamInfos;
 
+  /// True if the program is split into multiple LLVM modules (multi-threaded
+  /// compilation). In this mode merged functions get content-derived names
+  /// and linker-deduplicatable linkage, so that identical merged functions
+  /// produced in different modules can be folded at link time.
+  bool CrossModule;
+
   GlobalNumberState GlobalNumbers;
 
   /// A work queue of functions that may have been modified and should be
@@ -409,6 +428,8 @@ private:
 
   void mergeWithParams(const FunctionInfos &FInfos, ParamInfos &Params);
 
+  void makeLinkerDeduplicatable(Function *NewFunction);
+
   void removeEquivalenceClassFromTree(FunctionEntry *FE);
 
   void writeThunk(Function *ToFunc, Function *Thunk,
@@ -430,9 +451,9 @@ INITIALIZE_PASS_END(SwiftMergeFunctions,
                     "swift-merge-functions", "Swift merge function pass",
                     false, false)
 
-llvm::ModulePass *swift::createSwiftMergeFunctionsPass() {
+llvm::ModulePass *swift::createSwiftMergeFunctionsPass(bool CrossModule) {
   initializeSwiftMergeFunctionsPass(*llvm::PassRegistry::getPassRegistry());
-  return new SwiftMergeFunctions();
+  return new SwiftMergeFunctions(CrossModule);
 }
 
 bool SwiftMergeFunctions::doSanityCheck(std::vector<WeakTrackingVH> &Worklist) {
@@ -839,6 +860,48 @@ bool SwiftMergeFunctions::tryMapToParameter(FunctionInfos &FInfos,
   return true;
 }
 
+/// Returns the number of instructions of function \p F.
+static unsigned getFunctionSize(const Function *F) {
+  unsigned NumInsts = 0;
+  for (const BasicBlock &BB : *F)
+    NumInsts += BB.size();
+  return NumInsts;
+}
+
+/// Returns true if function \p F references a symbol with local linkage.
+///
+/// The textual IR of two such functions can be identical in two modules and
+/// still refer to different definitions, so they must not be folded by name.
+static bool referencesLocalSymbol(const Function *F) {
+  SmallVector<const Constant *, 8> Worklist;
+  SmallPtrSet<const Constant *, 16> Visited;
+  for (const BasicBlock &BB : *F) {
+    for (const Instruction &I : BB) {
+      for (const Value *Op : I.operands()) {
+        if (const auto *C = dyn_cast<Constant>(Op)) {
+          if (Visited.insert(C).second)
+            Worklist.push_back(C);
+        }
+      }
+    }
+  }
+  while (!Worklist.empty()) {
+    const Constant *C = Worklist.pop_back_val();
+    if (const auto *GV = dyn_cast<GlobalValue>(C)) {
+      if (GV->hasLocalLinkage())
+        return true;
+      continue;
+    }
+    for (const Value *Op : C->operands()) {
+      if (const auto *OpC = dyn_cast<Constant>(Op)) {
+        if (Visited.insert(OpC).second)
+          Worklist.push_back(OpC);
+      }
+    }
+  }
+  return false;
+}
+
 /// Merge all functions in \p FInfos by creating thunks which call the single
 /// merged function with additional parameters.
 void SwiftMergeFunctions::mergeWithParams(const FunctionInfos &FInfos,
@@ -846,6 +909,13 @@ void SwiftMergeFunctions::mergeWithParams(const FunctionInfos &FInfos,
   // We reuse the body of the first function for the new merged function.
   Function *FirstF = FInfos.front().F;
 
+  // Remember the sizes of the original functions so that we can account for
+  // the instructions which merging eliminates. FirstF donates its body to the
+  // merged function, so it does not count as saved.
+  SmallVector<unsigned, 8> OrigSizes;
+  for (const FunctionInfo &FI : FInfos)
+    OrigSizes.push_back(getFunctionSize(FI.F));
+
   // Build the type for the merged function. This will be the type of the
   // original function (FirstF) but with the additional parameter which are
   // needed to parameterize the merged function.
@@ -904,6 +974,9 @@ void SwiftMergeFunctions::mergeWithParams(const FunctionInfos &FInfos,
     }
   }
 
+  if (CrossModule || EnableCrossModuleMerging)
+    makeLinkerDeduplicatable(NewFunction);
+
   for (unsigned FIdx = 0, NumFuncs = FInfos.size(); FIdx < NumFuncs; ++FIdx) {
     Function *OrigFunc = FInfos[FIdx].F;
     // Don't try to replace all callers of functions which are used as
@@ -919,14 +992,53 @@ void SwiftMergeFunctions::mergeWithParams(const FunctionInfos &FInfos,
       FuncEntries.erase(Iter);
       DEBUG(dbgs() << "    Erase " << OrigFunc->getName() << '\n');
       OrigFunc->eraseFromParent();
+      if (FIdx != 0)
+        NumSwiftInstructionsSaved += OrigSizes[FIdx];
     } else {
       // Otherwise we need a thunk which calls the merged function.
       writeThunk(NewFunction, OrigFunc, Params, FIdx);
+      unsigned ThunkSize = getFunctionSize(OrigFunc);
+      if (FIdx != 0 && OrigSizes[FIdx] > ThunkSize)
+        NumSwiftInstructionsSaved += OrigSizes[FIdx] - ThunkSize;
     }
     ++NumSwiftFunctionsMerged;
   }
 }
 
+/// Renames the merged function \p NewFunction after a hash of its body and
+/// makes it foldable by the linker.
+///
+/// Multithreaded IRGen splits the program into multiple LLVM modules, so
+/// identical specializations in different modules are never seen by a single
+/// run of this pass. Deriving the name of a merged function from its content
+/// and emitting it with linkonce_odr linkage lets the linker fold such copies
+/// across module boundaries.
+void SwiftMergeFunctions::makeLinkerDeduplicatable(Function *NewFunction) {
+  // A reference to a local symbol would make equally-named functions in
+  // different modules non-interchangeable.
+  if (referencesLocalSymbol(NewFunction))
+    return;
+
+  // Print the function under a fixed placeholder name, so that the name
+  // itself does not influence the hash.
+  NewFunction->setName("__swift_merged");
+  std::string Body;
+  {
+    raw_string_ostream OS(Body);
+    NewFunction->print(OS);
+  }
+  MD5 Hash;
+  Hash.update(Body);
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> HashStr;
+  MD5::stringifyResult(Result, HashStr);
+  NewFunction->setName(Twine("__swift_merged_") + HashStr);
+  NewFunction->setLinkage(GlobalValue::LinkOnceODRLinkage);
+  NewFunction->setVisibility(GlobalValue::HiddenVisibility);
+  NewFunction->setUnnamedAddr(GlobalValue::UnnamedAddr::Global);
+}
+
 /// Remove all functions of \p FE's equivalence class from FnTree. Add them to
 /// Deferred so that we'll look at them in the next round.
 void SwiftMergeFunctions::removeEquivalenceClassFromTree(FunctionEntry *FE) {
@@ -227,8 +227,17 @@ struct APIDiffMigratorPass : public ASTMigratorPass, public SourceEntityWalker {
 
   APIDiffItemStore DiffStore;
 
-  std::vector<APIDiffItem*> getRelatedDiffItems(ValueDecl *VD) {
-    std::vector<APIDiffItem*> results;
+  /// Diff items previously collected for a declaration.  Computing them
+  /// involves USR mangling and walking the override and protocol-requirement
+  /// graph, and the walk below asks for the same declaration once per
+  /// reference, so the results are cached for the lifetime of the pass.
+  llvm::DenseMap<ValueDecl*, std::vector<APIDiffItem*>> RelatedDiffItems;
+
+  ArrayRef<APIDiffItem*> getRelatedDiffItems(ValueDecl *VD) {
+    auto Known = RelatedDiffItems.find(VD);
+    if (Known != RelatedDiffItems.end())
+      return Known->second;
+    auto &results = RelatedDiffItems[VD];
     auto addDiffItems = [&](ValueDecl *VD) {
       llvm::SmallString<64> Buffer;
       llvm::raw_svector_ostream OS(Buffer);
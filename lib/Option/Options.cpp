@@ -15,6 +15,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Option/OptTable.h"
 #include "llvm/Option/Option.h"
+#include "llvm/Support/ManagedStatic.h"
 
 using namespace swift::options;
 using namespace llvm::opt;
@@ -44,3 +45,12 @@ public:
 std::unique_ptr<OptTable> swift::createSwiftOptTable() {
   return std::unique_ptr<OptTable>(new SwiftOptTable());
 }
+
+static llvm::ManagedStatic<SwiftOptTable> SharedSwiftOptTable;
+
+const OptTable &swift::getSwiftOptTable() {
+  // Constructing an OptTable derives the searchable index and the set of
+  // option prefixes from the option info table, so the result is reused for
+  // all argument lists parsed in this process.
+  return *SharedSwiftOptTable;
+}
@@ -351,6 +351,11 @@ void Lexer::skipUpToEndOfLine() {
 
 void Lexer::skipToEndOfLine() {
   while (1) {
+    // Fast path: scan ahead over runs of plain ASCII characters, none of
+    // which can end the line, embed a nul, or require UTF-8 validation.
+    while ((signed char)*CurPtr > 0 && *CurPtr != '\n' && *CurPtr != '\r')
+      ++CurPtr;
+
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -402,8 +407,15 @@ void Lexer::skipSlashStarComment() {
   
   // /**/ comments can be nested, keep track of how deep we've gone.
   unsigned Depth = 1;
-  
+
   while (1) {
+    // Fast path: scan ahead over runs of plain ASCII characters that cannot
+    // open or close a comment, end a line, embed a nul, or require UTF-8
+    // validation.
+    while ((signed char)*CurPtr > 0 && *CurPtr != '*' && *CurPtr != '/' &&
+           *CurPtr != '\n' && *CurPtr != '\r')
+      ++CurPtr;
+
     switch (*CurPtr++) {
     case '*':
       // Check for a '*/'
@@ -531,8 +543,23 @@ static bool isValidIdentifierStartCodePoint(uint32_t c) {
   return true;
 }
 
-static bool advanceIf(char const *&ptr, char const *end,
-                      bool (*predicate)(uint32_t)) {
+/// Advance \p ptr over the next code point if \p predicate holds for it.
+/// The predicate is a template argument so that these per-character checks
+/// inline into the lexing loops instead of going through an indirect call,
+/// and plain ASCII bytes skip the UTF-8 decoder entirely.
+template <bool (*predicate)(uint32_t)>
+static bool advanceIf(char const *&ptr, char const *end) {
+  if (ptr >= end)
+    return false;
+  unsigned char ascii = *ptr;
+  if (ascii < 0x80) {
+    if (predicate(ascii)) {
+      ++ptr;
+      return true;
+    }
+    return false;
+  }
+
   char const *next = ptr;
   uint32_t c = validateUTF8CharacterAndAdvance(next, end);
   if (c == ~0U)
@@ -542,27 +569,26 @@ static bool advanceIf(char const *&ptr, char const *end,
     return true;
   }
   return false;
-
 }
 
 static bool advanceIfValidStartOfIdentifier(char const *&ptr,
                                             char const *end) {
-  return advanceIf(ptr, end, isValidIdentifierStartCodePoint);
+  return advanceIf<isValidIdentifierStartCodePoint>(ptr, end);
 }
 
 static bool advanceIfValidContinuationOfIdentifier(char const *&ptr,
                                                    char const *end) {
-  return advanceIf(ptr, end, isValidIdentifierContinuationCodePoint);
+  return advanceIf<isValidIdentifierContinuationCodePoint>(ptr, end);
 }
 
 static bool advanceIfValidStartOfOperator(char const *&ptr,
                                           char const *end) {
-  return advanceIf(ptr, end, Identifier::isOperatorStartCodePoint);
+  return advanceIf<Identifier::isOperatorStartCodePoint>(ptr, end);
 }
 
 static bool advanceIfValidContinuationOfOperator(char const *&ptr,
                                                  char const *end) {
-  return advanceIf(ptr, end, Identifier::isOperatorContinuationCodePoint);
+  return advanceIf<Identifier::isOperatorContinuationCodePoint>(ptr, end);
 }
 
 bool Lexer::isIdentifier(StringRef string) {
@@ -616,7 +642,18 @@ void Lexer::lexIdentifier() {
   (void) didStart;
 
   // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  while (true) {
+    // Fast path: scan over runs of plain ASCII identifier characters a byte
+    // at a time, without paying for UTF-8 validation on each one. Bytes with
+    // the high bit set fail clang::isIdentifierBody and drop to the
+    // code-point-aware path below.
+    while (CurPtr != BufferEnd &&
+           clang::isIdentifierBody(*CurPtr, /*dollar*/true))
+      ++CurPtr;
+
+    if (!advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd))
+      break;
+  }
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart), InSILMode);
   return formToken(Kind, TokStart);
@@ -747,6 +784,17 @@ void Lexer::lexOperatorIdentifier() {
   (void) didStart;
   
   do {
+    // Fast path: scan over runs of plain ASCII operator characters that can
+    // never terminate the token. '.', '!', '?', and '<' (the latter because
+    // it may begin an editor placeholder) are excluded since they need the
+    // checks below; everything else falls to the code-point-aware path.
+    while (CurPtr != BufferEnd) {
+      static const char SimpleOpChars[] = "/=-+*%>&|^~";
+      if (!memchr(SimpleOpChars, *CurPtr, sizeof(SimpleOpChars) - 1))
+        break;
+      ++CurPtr;
+    }
+
     if (CurPtr != BufferEnd && InSILBody &&
         (*CurPtr == '!' || *CurPtr == '?'))
       // When parsing SIL body, '!' and '?' are special token and can't be
@@ -2353,17 +2401,20 @@ Optional<syntax::TriviaPiece> Lexer::lexWhitespace(bool StopAtFirstNewline) {
         Length,
         OwnedString(Start, Length),
       };
+    // Spaces and tabs are fully described by their kind and count, so don't
+    // keep a reference into the source buffer for them.  Newlines keep their
+    // text so that '\r' and '\r\n' sequences reprint exactly as written.
     case ' ':
       return syntax::TriviaPiece {
         syntax::TriviaKind::Space,
         Length,
-        OwnedString(Start, Length),
+        OwnedString{},
       };
     case '\t':
       return syntax::TriviaPiece {
         syntax::TriviaKind::Tab,
         Length,
-        OwnedString(Start, Length),
+        OwnedString{},
       };
     default:
       return None;
@@ -3611,6 +3611,7 @@ static unsigned skipBracedBlock(Parser &P) {
 void Parser::consumeGetSetBody(AbstractFunctionDecl *AFD,
                                SourceLoc LBLoc) {
   SourceLoc SavedPreviousLoc = PreviousLoc;
+  Lexer::State BodyStart = L->getStateForBeginningOfToken(Tok);
 
   SourceRange BodyRange;
   BodyRange.Start = Tok.getLoc();
@@ -3626,7 +3627,8 @@ void Parser::consumeGetSetBody(AbstractFunctionDecl *AFD,
 
   if (DelayedParseCB->shouldDelayFunctionBodyParsing(
           *this, AFD, AFD->getAttrs(), BodyRange)) {
-    State->delayAccessorBodyParsing(AFD, BodyRange, SavedPreviousLoc, LBLoc);
+    State->delayAccessorBodyParsing(AFD, BodyRange, SavedPreviousLoc,
+                                    BodyStart, LBLoc);
     AFD->setBodyDelayed(BodyRange);
   } else {
     AFD->setBodySkipped(BodyRange);
@@ -4024,7 +4026,11 @@ void Parser::parseAccessorBodyDelayed(AbstractFunctionDecl *AFD) {
   auto AccessorParserState = State->takeAccessorBodyState(AFD);
   assert(AccessorParserState.get() && "should have a valid state");
 
-  auto BeginParserPosition = getParserPosition(AccessorParserState->BodyPos);
+  // Seek the lexer directly to the state recorded when the body was skipped,
+  // rather than re-deriving it by scanning from the start of the line.
+  auto BeginParserPosition =
+      ParserPosition(AccessorParserState->BodyStart,
+                     AccessorParserState->BodyPos.PrevLoc);
   auto EndLexerState = L->getStateForEndOfTokenLoc(AFD->getEndLoc());
 
   // ParserPositionRAII needs a primed parser to restore to.
@@ -4762,7 +4768,8 @@ void Parser::consumeAbstractFunctionBody(AbstractFunctionDecl *AFD,
   if (DelayedParseCB->shouldDelayFunctionBodyParsing(*this, AFD, Attrs,
                                                      BodyRange)) {
     State->delayFunctionBodyParsing(AFD, BodyRange,
-                                    BeginParserPosition.PreviousLoc);
+                                    BeginParserPosition.PreviousLoc,
+                                    BeginParserPosition.LS);
     AFD->setBodyDelayed(BodyRange);
   } else {
     AFD->setBodySkipped(BodyRange);
@@ -5021,7 +5028,11 @@ bool Parser::parseAbstractFunctionBodyDelayed(AbstractFunctionDecl *AFD) {
   auto FunctionParserState = State->takeFunctionBodyState(AFD);
   assert(FunctionParserState.get() && "should have a valid state");
 
-  auto BeginParserPosition = getParserPosition(FunctionParserState->BodyPos);
+  // Seek the lexer directly to the state recorded when the body was skipped,
+  // rather than re-deriving it by scanning from the start of the line.
+  auto BeginParserPosition =
+      ParserPosition(FunctionParserState->BodyStart,
+                     FunctionParserState->BodyPos.PrevLoc);
   auto EndLexerState = L->getStateForEndOfTokenLoc(AFD->getEndLoc());
 
   // ParserPositionRAII needs a primed parser to restore to.
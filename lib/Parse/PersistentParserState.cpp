@@ -22,9 +22,10 @@ using namespace swift;
 
 void PersistentParserState::delayFunctionBodyParsing(AbstractFunctionDecl *AFD,
                                                      SourceRange BodyRange,
-                                                     SourceLoc PreviousLoc) {
+                                                     SourceLoc PreviousLoc,
+                                                     Lexer::State BodyStart) {
   std::unique_ptr<FunctionBodyState> State;
-  State.reset(new FunctionBodyState(BodyRange, PreviousLoc,
+  State.reset(new FunctionBodyState(BodyRange, PreviousLoc, BodyStart,
                                     ScopeInfo.saveCurrentScope()));
   assert(DelayedFunctionBodies.find(AFD) == DelayedFunctionBodies.end() &&
          "Already recorded state for this body");
@@ -48,9 +49,10 @@ bool PersistentParserState::hasFunctionBodyState(AbstractFunctionDecl *AFD) {
 void PersistentParserState::delayAccessorBodyParsing(AbstractFunctionDecl *AFD,
                                                      SourceRange BodyRange,
                                                      SourceLoc PreviousLoc,
+                                                     Lexer::State BodyStart,
                                                      SourceLoc LBLoc) {
   std::unique_ptr<AccessorBodyState> State;
-  State.reset(new AccessorBodyState(BodyRange, PreviousLoc,
+  State.reset(new AccessorBodyState(BodyRange, PreviousLoc, BodyStart,
                                     ScopeInfo.saveCurrentScope(), LBLoc));
   assert(DelayedAccessorBodies.find(AFD) == DelayedAccessorBodies.end() &&
          "Already recorded state for this body");
@@ -2556,10 +2556,26 @@ public:
   void writeImports(raw_ostream &out) {
     out << "#if __has_feature(modules)\n";
 
+    // Sort alphabetically by name so the block does not depend on the order
+    // in which references to each module were discovered.  Incremental builds
+    // compare the regenerated header against the previous one byte-for-byte,
+    // so any spurious reordering recompiles every file that includes it.
+    SmallVector<ImportModuleTy, 8> sortedImports{imports.begin(),
+                                                 imports.end()};
+    auto getImportName = [](ImportModuleTy import) -> StringRef {
+      if (auto *swiftModule = import.dyn_cast<ModuleDecl *>())
+        return swiftModule->getName().str();
+      return import.get<const clang::Module *>()->Name;
+    };
+    std::sort(sortedImports.begin(), sortedImports.end(),
+              [&](ImportModuleTy lhs, ImportModuleTy rhs) {
+      return getImportName(lhs) < getImportName(rhs);
+    });
+
     // Track printed names to handle overlay modules.
     llvm::SmallPtrSet<Identifier, 8> seenImports;
     bool includeUnderlying = false;
-    for (auto import : imports) {
+    for (auto import : sortedImports) {
       if (auto *swiftModule = import.dyn_cast<ModuleDecl *>()) {
         auto Name = swiftModule->getName();
         if (isUnderlyingModule(swiftModule)) {
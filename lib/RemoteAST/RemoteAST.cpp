@@ -720,6 +720,20 @@ public:
   getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) = 0;
   virtual Result<MetadataKind>
   getKindForRemoteTypeMetadata(RemoteAddress metadata) = 0;
+  virtual void clearCaches() = 0;
+
+  /// Resolve a batch of metadata addresses.  The individual resolutions
+  /// share the reader's memoization caches, so metadata reachable from
+  /// several addresses in the batch is only walked once.
+  std::vector<Result<Type>>
+  getTypesForRemoteTypeMetadata(ArrayRef<RemoteAddress> addresses,
+                                bool skipArtificial) {
+    std::vector<Result<Type>> results;
+    results.reserve(addresses.size());
+    for (RemoteAddress address : addresses)
+      results.push_back(getTypeForRemoteTypeMetadata(address, skipArtificial));
+    return results;
+  }
   virtual Result<NominalTypeDecl*>
   getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) = 0;
   virtual Result<RemoteAddress>
@@ -1032,6 +1046,10 @@ public:
     return getFailure<Type>();
   }
 
+  void clearCaches() override {
+    Reader.clear();
+  }
+
   Result<MetadataKind>
   getKindForRemoteTypeMetadata(RemoteAddress metadata) override {
     auto result = Reader.readKindFromMetadata(metadata.getAddressData());
@@ -1113,6 +1131,17 @@ RemoteASTContext::getTypeForRemoteTypeMetadata(RemoteAddress address,
   return asImpl(Impl)->getTypeForRemoteTypeMetadata(address, skipArtificial);
 }
 
+std::vector<Result<Type>>
+RemoteASTContext::getTypesForRemoteTypeMetadata(ArrayRef<RemoteAddress> addresses,
+                                                bool skipArtificial) {
+  return asImpl(Impl)->getTypesForRemoteTypeMetadata(addresses,
+                                                     skipArtificial);
+}
+
+void RemoteASTContext::clearCaches() {
+  asImpl(Impl)->clearCaches();
+}
+
 Result<MetadataKind>
 RemoteASTContext::getKindForRemoteTypeMetadata(remote::RemoteAddress address) {
   return asImpl(Impl)->getKindForRemoteTypeMetadata(address);
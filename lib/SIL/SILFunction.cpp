@@ -170,10 +170,24 @@ ASTContext &SILFunction::getASTContext() const {
   return getModule().getASTContext();
 }
 
+/// A profile entry count at or below this value marks a function as cold
+/// when profile data is available.
+static llvm::cl::opt<unsigned long long> SILColdFunctionEntryThreshold(
+    "sil-cold-function-entry-threshold", llvm::cl::init(0),
+    llvm::cl::desc("Treat functions with a profile entry count at or below "
+                   "this value as optimize-for-size"));
+
 OptimizationMode SILFunction::getEffectiveOptimizationMode() const {
   if (OptMode != OptimizationMode::NotSet)
     return OptMode;
 
+  // When profile data says this function is cold, tier it down to the
+  // size-optimizing heuristics instead of the full speed pipeline.
+  if (getModule().getOptions().OptMode == OptimizationMode::ForSpeed &&
+      EntryCount.hasValue() &&
+      EntryCount.getValue() <= SILColdFunctionEntryThreshold)
+    return OptimizationMode::ForSize;
+
   return getModule().getOptions().OptMode;
 }
 
@@ -23,6 +23,7 @@
 #include "swift/SIL/SILVisitor.h"
 #include "swift/SIL/SILValue.h"
 #include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Statistic.h"
@@ -113,12 +114,77 @@ void *SILModule::allocate(unsigned Size, unsigned Align) const {
   return BPA.Allocate(Size, Align);
 }
 
+namespace {
+/// allocateInst() prepends one of these to every instruction so that
+/// deallocateInst() can find the chunk's base and size class without
+/// knowing the instruction's dynamic size.
+struct InstChunkHeader {
+  /// Index into SILModule::InstFreeLists, or NotRecycled if the chunk was
+  /// handed out by AlignedAlloc.
+  uint32_t SizeClass;
+  /// Distance in bytes from the base of the chunk to the instruction.
+  uint32_t Offset;
+
+  enum : uint32_t { NotRecycled = ~0U };
+};
+} // end anonymous namespace
+
+/// The smallest recycled chunk size; together with its header this covers
+/// the smallest instructions. Larger size classes double in size.
+static const size_t MinInstChunkSize = 64;
+
 void *SILModule::allocateInst(unsigned Size, unsigned Align) const {
-  return AlignedAlloc(Size, Align);
+  // Keep the instruction aligned by making the header a multiple of its
+  // alignment.
+  unsigned Header = Align < sizeof(InstChunkHeader)
+                        ? unsigned(sizeof(InstChunkHeader)) : Align;
+  size_t Bytes = Size + Header;
+
+  // Find the smallest size class that can hold the chunk.
+  unsigned SizeClass = 0;
+  size_t ChunkSize = MinInstChunkSize;
+  while (ChunkSize < Bytes) {
+    ChunkSize <<= 1;
+    ++SizeClass;
+  }
+
+  char *Base;
+  if (SizeClass >= llvm::array_lengthof(InstFreeLists) || Align > 16 ||
+      getASTContext().LangOpts.UseMalloc) {
+    // Unusually large or aligned chunks are not worth recycling, and with
+    // UseMalloc every chunk gets its own allocation so that tools like
+    // guard malloc can catch use-after-free of instructions.
+    Base = static_cast<char *>(AlignedAlloc(Bytes, Align));
+    SizeClass = InstChunkHeader::NotRecycled;
+  } else if (void *Recycled = InstFreeLists[SizeClass]) {
+    InstFreeLists[SizeClass] = *reinterpret_cast<void **>(Recycled);
+    Base = static_cast<char *>(Recycled);
+  } else {
+    // Chunk bases are 16-byte aligned, so any header computed above keeps
+    // the instruction itself sufficiently aligned, including after the
+    // chunk is recycled for an instruction with different alignment.
+    Base = static_cast<char *>(BPA.Allocate(ChunkSize, 16));
+  }
+
+  char *Inst = Base + Header;
+  auto *H = reinterpret_cast<InstChunkHeader *>(Inst) - 1;
+  H->SizeClass = SizeClass;
+  H->Offset = Header;
+  return Inst;
 }
 
 void SILModule::deallocateInst(SILInstruction *I) {
-  AlignedFree(I);
+  auto *H = reinterpret_cast<InstChunkHeader *>(I) - 1;
+  char *Base = reinterpret_cast<char *>(I) - H->Offset;
+  if (H->SizeClass == InstChunkHeader::NotRecycled) {
+    AlignedFree(Base);
+    return;
+  }
+
+  // Thread the chunk onto its size class' free list; the link is stored in
+  // the dead chunk itself.
+  *reinterpret_cast<void **>(Base) = InstFreeLists[H->SizeClass];
+  InstFreeLists[H->SizeClass] = Base;
 }
 
 SILWitnessTable *
@@ -534,6 +600,13 @@ SILFunction *SILModule::findFunction(StringRef Name, SILLinkage Linkage) {
   return F;
 }
 
+SILFunction *SILModule::loadFunction(StringRef Name, SILLinkage Linkage) {
+  if (SILFunction *F = lookUpFunction(Name))
+    return F;
+  return getSILLoader()->lookupSILFunction(Name, /*declarationOnly*/ false,
+                                           Linkage);
+}
+
 bool SILModule::hasFunction(StringRef Name) {
   if (lookUpFunction(Name))
     return true;
@@ -493,7 +493,13 @@ class SILPrinter : public SILInstructionVisitor<SILPrinter> {
   
   SILPrinter &operator<<(SILType t) {
     printSILTypeColorAndSigil(PrintState.OS, t);
-    t.getSwiftRValueType().print(PrintState.OS, PrintState.ASTOptions);
+    // Alternative type names are function-specific, so the cached text in
+    // the print context cannot be used with them.
+    if (PrintState.ASTOptions.AlternativeTypeNames)
+      t.getSwiftRValueType().print(PrintState.OS, PrintState.ASTOptions);
+    else
+      PrintState.OS << Ctx.getTypeText(t.getSwiftRValueType(),
+                                       PrintState.ASTOptions);
     return *this;
   }
   
@@ -2938,6 +2944,15 @@ SILPrintContext::~SILPrintContext() {
 void SILPrintContext::printInstructionCallBack(const SILInstruction *I) {
 }
 
+StringRef SILPrintContext::getTypeText(CanType Ty, const PrintOptions &Options) {
+  std::string &text = TypeTextCache[Ty.getPointer()];
+  if (text.empty()) {
+    llvm::raw_string_ostream os(text);
+    Ty.print(os, Options);
+  }
+  return text;
+}
+
 void SILPrintContext::initBlockIDs(ArrayRef<const SILBasicBlock *> Blocks) {
   if (Blocks.empty())
     return;
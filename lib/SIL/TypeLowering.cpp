@@ -23,6 +23,7 @@
 #include "swift/AST/NameLookup.h"
 #include "swift/AST/Pattern.h"
 #include "swift/AST/Types.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/SIL/SILArgument.h"
 #include "swift/SIL/SILBuilder.h"
@@ -1405,10 +1406,15 @@ const TypeLowering *TypeConverter::find(TypeKey k) {
   }
 
   auto found = types->find(ck);
-  if (found == types->end())
+  if (found == types->end()) {
+    if (auto *Stats = M.getASTContext().Stats)
+      Stats->getFrontendCounters().NumTypeLoweringsComputed++;
     return nullptr;
+  }
 
   assert(found->second && "type recursion not caught in Sema");
+  if (auto *Stats = M.getASTContext().Stats)
+    Stats->getFrontendCounters().NumTypeLoweringCacheHits++;
   return found->second;
 }
 
@@ -102,6 +102,13 @@ public:
   /// The most recent declaration we considered for emission.
   SILDeclRef lastEmittedFunction;
 
+  /// Memoized reabstraction thunk declarations, keyed by the thunk, source
+  /// and destination types their mangled name is derived from. The same
+  /// abstraction difference is commonly bridged many times in a module, and
+  /// caching the declaration avoids re-running the mangler on each request.
+  llvm::DenseMap<std::pair<TypeBase *, std::pair<TypeBase *, TypeBase *>>,
+                 SILFunction *> ReabstractionThunks;
+
   /// Set of used conformances for which witness tables need to be emitted.
   llvm::DenseSet<NormalProtocolConformance *> usedConformances;
 
@@ -376,6 +383,12 @@ public:
 
   /// Emit a global initialization.
   void emitGlobalInitialization(PatternBindingDecl *initializer, unsigned elt);
+
+  /// Try to emit the initializer of a global variable directly as a static
+  /// initializer of its sil_global. Returns true on success, in which case
+  /// the global needs no lazy initialization.
+  bool tryEmitGlobalVariableStaticInitializer(PatternBindingDecl *pd,
+                                              unsigned pbdEntry);
   
   /// Known functions for bridging.
   SILDeclRef getStringToNSStringFn();
@@ -14,6 +14,7 @@
 #include "ManagedValue.h"
 #include "Scope.h"
 #include "swift/AST/ASTMangler.h"
+#include "swift/AST/Expr.h"
 #include "swift/AST/GenericSignature.h"
 #include "swift/SIL/FormalLinkage.h"
 
@@ -190,6 +191,101 @@ struct GenGlobalAccessors : public PatternVisitor<GenGlobalAccessors>
 
 } // end anonymous namespace
 
+/// Match the initializer of a global variable against the form Sema
+/// produces for integer and boolean literals of standard library types:
+/// a call to the _ExpressibleByBuiltin*Literal initializer with the raw
+/// literal as its only argument. Returns the literal on a match.
+static LiteralExpr *getStaticallyEmittableLiteral(Expr *init) {
+  auto *call = dyn_cast<CallExpr>(init->getSemanticsProvidingExpr());
+  if (!call)
+    return nullptr;
+
+  auto *ctorRefCall = dyn_cast<ConstructorRefCallExpr>(call->getSemanticFn());
+  if (!ctorRefCall)
+    return nullptr;
+  auto *ctorRef =
+      dyn_cast<OtherConstructorDeclRefExpr>(ctorRefCall->getSemanticFn());
+  if (!ctorRef)
+    return nullptr;
+
+  // Only the builtin literal initializers of standard library types have
+  // known value semantics; a user-defined init(integerLiteral:) can run
+  // arbitrary code.
+  auto *ctor = ctorRef->getDecl();
+  if (!ctor->getModuleContext()->isStdlibModule())
+    return nullptr;
+  auto argNames = ctor->getFullName().getArgumentNames();
+  if (argNames.size() != 1)
+    return nullptr;
+
+  Expr *arg = call->getArg()->getSemanticsProvidingExpr();
+  if (auto *tuple = dyn_cast<TupleExpr>(arg)) {
+    if (tuple->getNumElements() != 1)
+      return nullptr;
+    arg = tuple->getElement(0)->getSemanticsProvidingExpr();
+  }
+
+  if (argNames[0].str() == "_builtinIntegerLiteral")
+    return dyn_cast<IntegerLiteralExpr>(arg);
+  if (argNames[0].str() == "_builtinBooleanLiteral")
+    return dyn_cast<BooleanLiteralExpr>(arg);
+  return nullptr;
+}
+
+bool SILGenModule::tryEmitGlobalVariableStaticInitializer(
+    PatternBindingDecl *pd, unsigned pbdEntry) {
+  Pattern *pattern = pd->getPattern(pbdEntry);
+  VarDecl *var = pattern->getSingleVar();
+  if (!var || !var->isLet())
+    return false;
+
+  Expr *init = pd->getInit(pbdEntry);
+  if (!init)
+    return false;
+  LiteralExpr *literal = getStaticallyEmittableLiteral(init);
+  if (!literal)
+    return false;
+
+  // The global must lower to a struct wrapping a single builtin integer
+  // field wide enough for the literal.
+  SILType silTy = M.Types.getLoweredTypeOfGlobal(var);
+  StructDecl *structDecl = silTy.getStructOrBoundGenericStruct();
+  if (!structDecl)
+    return false;
+  auto props = structDecl->getStoredProperties();
+  auto propIt = props.begin();
+  if (propIt == props.end())
+    return false;
+  VarDecl *field = *propIt;
+  if (++propIt != props.end())
+    return false;
+
+  SILType fieldTy = silTy.getFieldType(field, M);
+  auto fieldIntTy = fieldTy.getAs<BuiltinIntegerType>();
+  if (!fieldIntTy || !fieldIntTy->isFixedWidth())
+    return false;
+
+  APInt value;
+  if (auto *intLiteral = dyn_cast<IntegerLiteralExpr>(literal)) {
+    value = intLiteral->getValue();
+    // Literals that need the checked truncation in the stdlib initializer
+    // are left to the lazy path, so they still diagnose overflow.
+    if (value.getMinSignedBits() > fieldIntTy->getFixedWidth())
+      return false;
+    value = value.sextOrTrunc(fieldIntTy->getFixedWidth());
+  } else {
+    if (!fieldIntTy->isFixedWidth(1))
+      return false;
+    value = APInt(1, cast<BooleanLiteralExpr>(literal)->getValue() ? 1 : 0);
+  }
+
+  auto *silG = getSILGlobalVariable(var, ForDefinition);
+  SILBuilder B(silG);
+  auto *lit = B.createIntegerLiteral(RegularLocation(var), fieldTy, value);
+  B.createStruct(RegularLocation(var), silTy, {lit});
+  return true;
+}
+
 /// Emit a global initialization.
 void SILGenModule::emitGlobalInitialization(PatternBindingDecl *pd,
                                             unsigned pbdEntry) {
@@ -201,6 +297,16 @@ void SILGenModule::emitGlobalInitialization(PatternBindingDecl *pd,
                 ->areAllParamsConcrete());
   }
 
+  // If the initialization expression is a compile-time literal, emit it
+  // directly as a static initializer of the sil_global and skip the
+  // Builtin.once token and lazy initialization function entirely. The
+  // accessors then simply hand out the global's address.
+  if (tryEmitGlobalVariableStaticInitializer(pd, pbdEntry)) {
+    GenGlobalAccessors(*this, /*OnceToken=*/nullptr, /*OnceFunc=*/nullptr)
+        .visit(pd->getPattern(pbdEntry));
+    return;
+  }
+
   // Emit the lazy initialization token for the initialization expression.
   auto counter = anonymousSymbolCounter++;
 
@@ -281,7 +387,10 @@ static void emitOnceCall(SILGenFunction &SGF, VarDecl *global,
 void SILGenFunction::emitGlobalAccessor(VarDecl *global,
                                         SILGlobalVariable *onceToken,
                                         SILFunction *onceFunc) {
-  emitOnceCall(*this, global, onceToken, onceFunc);
+  // Statically initialized globals have no once token and need no lazy
+  // initialization.
+  if (onceToken)
+    emitOnceCall(*this, global, onceToken, onceFunc);
 
   // Return the address of the global variable.
   // FIXME: It'd be nice to be able to return a SIL address directly.
@@ -299,7 +408,8 @@ void SILGenFunction::emitGlobalAccessor(VarDecl *global,
 void SILGenFunction::emitGlobalGetter(VarDecl *global,
                                       SILGlobalVariable *onceToken,
                                       SILFunction *onceFunc) {
-  emitOnceCall(*this, global, onceToken, onceFunc);
+  if (onceToken)
+    emitOnceCall(*this, global, onceToken, onceFunc);
 
   auto *silG = SGM.getSILGlobalVariable(global, NotForDefinition);
   SILValue addr = B.createGlobalAddr(global, silG);
@@ -361,6 +361,15 @@ getOrCreateReabstractionThunk(CanSILFunctionType thunkType,
                               CanSILFunctionType fromType,
                               CanSILFunctionType toType,
                               IsSerialized_t Serialized) {
+  // The same thunk tends to be requested over and over within a module;
+  // answer from the cache before deriving the mangled name again.
+  auto cacheKey = std::make_pair(
+      thunkType.getPointer(),
+      std::make_pair(fromType.getPointer(), toType.getPointer()));
+  auto existing = ReabstractionThunks.find(cacheKey);
+  if (existing != ReabstractionThunks.end())
+    return existing->second;
+
   // The reference to the thunk is likely @noescape, but declarations are always
   // escaping.
   auto thunkDeclType =
@@ -380,7 +389,10 @@ getOrCreateReabstractionThunk(CanSILFunctionType thunkType,
   
   auto loc = RegularLocation::getAutoGeneratedLocation();
 
-  return M.getOrCreateSharedFunction(loc, name, thunkDeclType, IsBare,
-                                     IsTransparent, IsSerializable,
-                                     ProfileCounter(), IsReabstractionThunk);
+  auto *thunk = M.getOrCreateSharedFunction(loc, name, thunkDeclType, IsBare,
+                                            IsTransparent, IsSerializable,
+                                            ProfileCounter(),
+                                            IsReabstractionThunk);
+  ReabstractionThunks[cacheKey] = thunk;
+  return thunk;
 }
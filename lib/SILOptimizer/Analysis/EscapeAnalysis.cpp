@@ -19,11 +19,18 @@
 #include "swift/SILOptimizer/Utils/Local.h"
 #include "swift/SIL/SILArgument.h"
 #include "swift/SIL/DebugUtils.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/GraphWriter.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
 
+STATISTIC(NumRecomputedGraphs,
+          "Number of recomputed connection graphs");
+STATISTIC(NumAbsorbedDeletions,
+          "Number of instruction deletions patched into existing connection "
+          "graphs without a recomputation");
+
 static bool isExtractOfArrayUninitializedPointer(TupleExtractInst *TEI) {
   if (TEI->getFieldNo() == 1) {
     if (auto apply = dyn_cast<ApplyInst>(TEI->getOperand()))
@@ -1724,6 +1731,7 @@ void EscapeAnalysis::recompute(FunctionInfo *Initial) {
 
   for (FunctionInfo *FInfo : BottomUpOrder) {
     if (BottomUpOrder.wasRecomputedWithCurrentUpdateID(FInfo)) {
+      NumRecomputedGraphs++;
       FInfo->Graph.computeUsePoints();
       FInfo->Graph.verify();
       FInfo->SummaryGraph.verify();
@@ -2019,6 +2027,12 @@ void EscapeAnalysis::handleDeleteNotification(SILNode *node) {
     SILFunction *F = Parent->getParent();
     if (FunctionInfo *FInfo = Function2Info.lookup(F)) {
       if (FInfo->isValid()) {
+        // Deletions can be patched into the existing graphs: removing an
+        // instruction only removes behavior, so the graphs stay a sound
+        // over-approximation. Insertions cannot be handled this way, because
+        // nodes for values unknown to a computed graph are created lazily
+        // without any connections, which would under-approximate new escapes.
+        NumAbsorbedDeletions++;
         FInfo->Graph.removeFromGraph(value);
         FInfo->SummaryGraph.removeFromGraph(value);
       }
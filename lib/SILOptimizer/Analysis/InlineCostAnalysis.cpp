@@ -0,0 +1,35 @@
+//===--- InlineCostAnalysis.cpp - Cached function inline cost -------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/SILOptimizer/Analysis/InlineCostAnalysis.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SILOptimizer/Utils/SILInliner.h"
+
+using namespace swift;
+
+int InlineCostFunctionInfo::getCost() {
+  if (Cost)
+    return *Cost;
+
+  int Total = 0;
+  for (SILBasicBlock &BB : *F) {
+    for (SILInstruction &I : BB) {
+      Total += (int)instructionInlineCost(I);
+    }
+  }
+  Cost = Total;
+  return Total;
+}
+
+SILAnalysis *swift::createInlineCostAnalysis(SILModule *M) {
+  return new InlineCostAnalysis(M);
+}
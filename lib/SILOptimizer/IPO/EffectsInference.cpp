@@ -0,0 +1,108 @@
+//===--- EffectsInference.cpp - Infer @effects attributes -----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Attaches @effects(readnone) and @effects(readonly) attributes to functions
+// for which side-effect analysis can prove them.
+//
+// The attribute is the effect information which survives across module
+// boundaries: it is part of the serialized SIL function record, and
+// SideEffectAnalysis::getDefinedEffects consumes it for external
+// declarations whose bodies are unavailable. Running this inference at the
+// end of the optimizer pipeline therefore lets clients of a (pre)built
+// module see precise effects for its serialized functions without
+// deserializing their bodies, instead of treating every such call as a
+// may-have-any-effect barrier for CSE and code motion.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "effects-inference"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+using namespace swift;
+
+STATISTIC(NumReadNoneInferred, "Number of @effects(readnone) inferred");
+STATISTIC(NumReadOnlyInferred, "Number of @effects(readonly) inferred");
+
+/// Returns the strongest @effects attribute kind justified by the computed
+/// effects \p FE of \p F, or EffectsKind::Unspecified if the effects exceed
+/// what the attribute lattice can express.
+static EffectsKind classifyEffects(
+    const SideEffectAnalysis::FunctionEffects &FE, SILFunction *F) {
+  if (FE.mayAllocObjects() || FE.mayTrap() || FE.mayReadRC())
+    return EffectsKind::Unspecified;
+
+  bool Reads = false;
+  auto isReadOnly = [&](const SideEffectAnalysis::Effects &E) -> bool {
+    if (E.mayWrite() || E.mayRetain() || E.mayRelease())
+      return false;
+    Reads |= E.mayRead();
+    return true;
+  };
+  if (!isReadOnly(FE.getGlobalEffects()))
+    return EffectsKind::Unspecified;
+  for (const SideEffectAnalysis::Effects &PE : FE.getParameterEffects()) {
+    if (!isReadOnly(PE))
+      return EffectsKind::Unspecified;
+  }
+
+  // With owned parameters the attribute is worthless (and dangerous if a
+  // call site were removed): releasing the argument is the caller-visible
+  // obligation of the callee. See getDefinedEffects.
+  if (F->hasOwnedParameters())
+    return EffectsKind::Unspecified;
+
+  return Reads ? EffectsKind::ReadOnly : EffectsKind::ReadNone;
+}
+
+namespace {
+
+class EffectsInference : public SILModuleTransform {
+
+  void run() override {
+    auto *SEA = PM->getAnalysis<SideEffectAnalysis>();
+
+    for (SILFunction &F : *getModule()) {
+      // Don't override attributes written by the user (or the parser).
+      if (!F.isDefinition() || F.hasEffectsKind())
+        continue;
+      if (!F.shouldOptimize())
+        continue;
+
+      EffectsKind Kind = classifyEffects(SEA->getEffects(&F), &F);
+      if (Kind == EffectsKind::Unspecified)
+        continue;
+
+      DEBUG(llvm::dbgs() << "Infer @effects("
+                         << (Kind == EffectsKind::ReadNone ? "readnone"
+                                                           : "readonly")
+                         << ") for " << F.getName() << '\n');
+      F.setEffectsKind(Kind);
+      if (Kind == EffectsKind::ReadNone)
+        NumReadNoneInferred++;
+      else
+        NumReadOnlyInferred++;
+    }
+    // The attributes only refine what the analysis already proved, so no
+    // analysis results become stale.
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createEffectsInference() {
+  return new EffectsInference();
+}
@@ -0,0 +1,299 @@
+//===--- IPConstantPropagation.cpp - Propagate constant arguments ---------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Interprocedural constant propagation: if every call site of a module-private
+// function passes the same literal for an argument, the literal is
+// materialized in the callee and the argument's uses are replaced with it.
+// This lets feature-flag-guarded code fold away in the callee via the regular
+// constant folding and simplify-cfg passes which run afterwards, and turns
+// the argument into a dead argument for FunctionSignatureOpts to remove.
+//
+// Only arguments of trivial type built from literals are propagated, so no
+// ownership fixups are needed. A function is only a candidate if all of its
+// call sites are known: it must not be visible externally and must not be
+// referenced from vtables, witness tables, key paths or any non-apply use of
+// a function_ref.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "ip-constant-propagation"
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+using namespace swift;
+
+STATISTIC(NumPropagatedArgs, "Number of constant arguments propagated");
+
+/// Returns the defining instruction if \p V is a propagatable constant: a
+/// literal or a struct built entirely from literals. Such values are always
+/// trivial, so replacing an argument with a copy of one needs no ownership
+/// fixups.
+static SingleValueInstruction *getConstant(SILValue V) {
+  if (auto *LI = dyn_cast<LiteralInst>(V))
+    return LI;
+  if (auto *SI = dyn_cast<StructInst>(V)) {
+    for (SILValue Elt : SI->getElements()) {
+      if (!getConstant(Elt))
+        return nullptr;
+    }
+    return SI;
+  }
+  return nullptr;
+}
+
+/// Returns true if the two constants (in the sense of getConstant) have the
+/// same type and value.
+static bool isSameConstant(SingleValueInstruction *A,
+                           SingleValueInstruction *B) {
+  if (A == B)
+    return true;
+  if (A->getKind() != B->getKind() || A->getType() != B->getType())
+    return false;
+
+  if (auto *IA = dyn_cast<IntegerLiteralInst>(A))
+    return IA->getValue() == cast<IntegerLiteralInst>(B)->getValue();
+  if (auto *FA = dyn_cast<FloatLiteralInst>(A))
+    return FA->getBits() == cast<FloatLiteralInst>(B)->getBits();
+  if (auto *SA = dyn_cast<StringLiteralInst>(A)) {
+    auto *SB = cast<StringLiteralInst>(B);
+    return SA->getEncoding() == SB->getEncoding() &&
+           SA->getValue() == SB->getValue();
+  }
+
+  auto *StA = cast<StructInst>(A);
+  auto *StB = cast<StructInst>(B);
+  if (StA->getNumOperands() != StB->getNumOperands())
+    return false;
+  for (unsigned Idx = 0, End = StA->getNumOperands(); Idx < End; ++Idx) {
+    if (!isSameConstant(getConstant(StA->getOperand(Idx)),
+                        getConstant(StB->getOperand(Idx))))
+      return false;
+  }
+  return true;
+}
+
+/// Rebuilds the constant \p C with \p B, which is positioned in another
+/// function.
+static SILValue cloneConstant(SingleValueInstruction *C, SILBuilder &B,
+                              SILLocation Loc) {
+  if (auto *IL = dyn_cast<IntegerLiteralInst>(C))
+    return B.createIntegerLiteral(Loc, IL->getType(), IL->getValue());
+  if (auto *FL = dyn_cast<FloatLiteralInst>(C))
+    return B.createFloatLiteral(Loc, FL->getType(), FL->getBits());
+  if (auto *SL = dyn_cast<StringLiteralInst>(C))
+    return B.createStringLiteral(Loc, SL->getValue(), SL->getEncoding());
+
+  auto *SI = cast<StructInst>(C);
+  SmallVector<SILValue, 4> Elements;
+  for (SILValue Elt : SI->getElements())
+    Elements.push_back(cloneConstant(getConstant(Elt), B, Loc));
+  return B.createStruct(Loc, SI->getType(), Elements);
+}
+
+namespace {
+
+class IPConstantPropagation : public SILModuleTransform {
+
+  /// All full apply sites of each function whose uses are all known.
+  llvm::DenseMap<SILFunction *, SmallVector<FullApplySite, 8>> ApplySites;
+
+  /// Functions referenced from something other than the callee position of a
+  /// full apply site. Their argument values cannot be enumerated.
+  llvm::SmallPtrSet<SILFunction *, 16> HasUnknownUses;
+
+  void run() override {
+    ApplySites.clear();
+    HasUnknownUses.clear();
+
+    collectCallSites();
+
+    bool Changed = false;
+    for (auto &Pair : ApplySites) {
+      SILFunction *Callee = Pair.first;
+      if (HasUnknownUses.count(Callee))
+        continue;
+      if (propagateConstantArgs(Callee, Pair.second)) {
+        invalidateAnalysis(Callee,
+                           SILAnalysis::InvalidationKind::Instructions);
+        Changed = true;
+      }
+    }
+
+    if (Changed)
+      DEBUG(llvm::dbgs() << "IPConstProp: changed the module\n");
+  }
+
+  /// Finds all references to functions in the module and records for each
+  /// callee either its full apply sites or the fact that not all of its uses
+  /// are apply sites.
+  void collectCallSites() {
+    SILModule *M = getModule();
+
+    for (SILFunction &F : *M) {
+      for (SILBasicBlock &BB : F) {
+        for (SILInstruction &I : BB) {
+          if (auto *FRI = dyn_cast<FunctionRefInst>(&I)) {
+            SILFunction *Callee = FRI->getReferencedFunction();
+            for (Operand *Use : FRI->getUses()) {
+              FullApplySite FAS = FullApplySite::isa(Use->getUser());
+              if (FAS && FAS.getCallee() == SILValue(FRI)) {
+                ApplySites[Callee].push_back(FAS);
+              } else {
+                // Stored, partially applied or converted: the function can
+                // be called with arbitrary arguments.
+                HasUnknownUses.insert(Callee);
+              }
+            }
+          } else if (auto *KPI = dyn_cast<KeyPathInst>(&I)) {
+            markKeyPathFunctions(KPI->getPattern());
+          }
+        }
+      }
+    }
+
+    // Functions referenced from vtables or witness tables can be called
+    // through class or witness method dispatch.
+    for (SILVTable &VT : M->getVTableList()) {
+      for (const SILVTable::Entry &Entry : VT.getEntries())
+        HasUnknownUses.insert(Entry.Implementation);
+    }
+    for (SILWitnessTable &WT : M->getWitnessTableList()) {
+      for (const SILWitnessTable::Entry &Entry : WT.getEntries()) {
+        if (Entry.getKind() != SILWitnessTable::Method)
+          continue;
+        if (SILFunction *Witness = Entry.getMethodWitness().Witness)
+          HasUnknownUses.insert(Witness);
+      }
+    }
+    for (SILDefaultWitnessTable &WT : M->getDefaultWitnessTableList()) {
+      for (const SILDefaultWitnessTable::Entry &Entry : WT.getEntries()) {
+        if (Entry.isValid())
+          HasUnknownUses.insert(Entry.getWitness());
+      }
+    }
+  }
+
+  /// Key path patterns reference their accessors directly; those functions
+  /// are invoked by the key path runtime with arbitrary arguments.
+  void markKeyPathFunctions(KeyPathPattern *KP) {
+    for (auto &Component : KP->getComponents()) {
+      switch (Component.getKind()) {
+      case KeyPathPatternComponent::Kind::SettableProperty:
+        HasUnknownUses.insert(Component.getComputedPropertySetter());
+        LLVM_FALLTHROUGH;
+      case KeyPathPatternComponent::Kind::GettableProperty: {
+        HasUnknownUses.insert(Component.getComputedPropertyGetter());
+        auto Id = Component.getComputedPropertyId();
+        if (Id.getKind() ==
+              KeyPathPatternComponent::ComputedPropertyId::Function)
+          HasUnknownUses.insert(Id.getFunction());
+        if (auto *Equals = Component.getComputedPropertyIndexEquals())
+          HasUnknownUses.insert(Equals);
+        if (auto *Hash = Component.getComputedPropertyIndexHash())
+          HasUnknownUses.insert(Hash);
+        break;
+      }
+      case KeyPathPatternComponent::Kind::StoredProperty:
+      case KeyPathPatternComponent::Kind::OptionalChain:
+      case KeyPathPatternComponent::Kind::OptionalForce:
+      case KeyPathPatternComponent::Kind::OptionalWrap:
+        break;
+      }
+    }
+  }
+
+  /// Returns true if it is safe to rewrite the body of \p F based on the
+  /// recorded apply sites.
+  bool isEligible(SILFunction *F) {
+    if (!F->isDefinition())
+      return false;
+
+    // All call sites must be visible to this pass.
+    if (F->isPossiblyUsedExternally())
+      return false;
+
+    // ObjC methods can be called through the runtime.
+    if (F->getRepresentation() == SILFunctionTypeRepresentation::ObjCMethod)
+      return false;
+
+    // Functions kept for external users get public linkage later.
+    if (F->isKeepAsPublic())
+      return false;
+
+    return true;
+  }
+
+  /// Replaces every argument of \p F for which all \p Sites pass the same
+  /// constant with a copy of that constant. Returns true if anything changed.
+  bool propagateConstantArgs(SILFunction *F,
+                             ArrayRef<FullApplySite> Sites) {
+    if (!isEligible(F))
+      return false;
+
+    bool Changed = false;
+    auto Args = F->getArguments();
+    for (unsigned ArgIdx = 0, NumArgs = Args.size(); ArgIdx < NumArgs;
+         ++ArgIdx) {
+      SILArgument *Arg = Args[ArgIdx];
+      if (!Arg->getType().isObject() || Arg->use_empty())
+        continue;
+
+      // Check that all call sites agree on a constant for this argument.
+      SingleValueInstruction *Constant = nullptr;
+      bool AllSame = true;
+      for (FullApplySite FAS : Sites) {
+        assert(FAS.getNumArguments() == NumArgs &&
+               "full apply site out of sync with callee");
+        auto *SiteConstant = getConstant(FAS.getArgument(ArgIdx));
+        if (!SiteConstant ||
+            (Constant && !isSameConstant(Constant, SiteConstant))) {
+          AllSame = false;
+          break;
+        }
+        Constant = SiteConstant;
+      }
+      if (!AllSame || !Constant)
+        continue;
+
+      // The callee argument type can differ from the call site's type for
+      // generic callees; only propagate on an exact match.
+      if (Arg->getType() != Constant->getType())
+        continue;
+
+      DEBUG(llvm::dbgs() << "IPConstProp: propagate " << *Constant
+                         << "  into argument " << ArgIdx << " of "
+                         << F->getName() << '\n');
+
+      SILBuilder B(&*F->begin()->begin());
+      SILValue Cloned =
+          cloneConstant(Constant, B, RegularLocation::getAutoGeneratedLocation());
+      Arg->replaceAllUsesWith(Cloned);
+      NumPropagatedArgs++;
+      Changed = true;
+    }
+    return Changed;
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createIPConstantPropagation() {
+  return new IPConstantPropagation();
+}
@@ -0,0 +1,125 @@
+//===--- ArrayLayoutOpt.cpp - Array-of-struct loop layout analysis --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Finds loops which read only a strict subset of the fields of the struct
+// elements of an array through array.get_element semantic calls. Such loops
+// would profit from a struct-of-arrays layout: the unused fields pollute the
+// cache lines the loop streams through and defeat vectorization.
+//
+// Actually rewriting Array<Struct> into per-field arrays would require
+// synthesizing new stdlib Array types and initializer calls, which a SIL
+// pass cannot do safely for the COW representation. Instead this pass emits
+// optimization remarks identifying the candidates, so the kernels can be
+// restructured at the source level and the findings can be measured. It is
+// inactive unless -sil-array-layout-opt is passed.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "array-layout-opt"
+#include "swift/AST/Decl.h"
+#include "swift/SIL/DebugUtils.h"
+#include "swift/SIL/OptimizationRemark.h"
+#include "swift/SILOptimizer/Analysis/ArraySemantic.h"
+#include "swift/SILOptimizer/Analysis/LoopAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+llvm::cl::opt<bool> EnableArrayLayoutOpt(
+    "sil-array-layout-opt", llvm::cl::init(false),
+    llvm::cl::desc("Analyze array-of-struct loops for struct-of-arrays "
+                   "conversion candidates"));
+
+namespace {
+
+class ArrayLayoutOpt : public SILFunctionTransform {
+
+  void run() override {
+    if (!EnableArrayLayoutOpt)
+      return;
+
+    SILFunction *F = getFunction();
+    SILLoopInfo *LI = PM->getAnalysis<SILLoopAnalysis>()->get(F);
+    if (LI->empty())
+      return;
+
+    OptRemark::Emitter ORE(DEBUG_TYPE, F->getModule());
+
+    for (SILBasicBlock &BB : *F) {
+      if (!LI->getLoopFor(&BB))
+        continue;
+      for (SILInstruction &I : BB) {
+        auto *Apply = dyn_cast<ApplyInst>(&I);
+        if (!Apply)
+          continue;
+        analyzeGetElement(Apply, ORE);
+      }
+    }
+  }
+
+  /// If \p Apply is an array.get_element call whose result is only consumed
+  /// by extractions of a strict subset of the element's stored properties,
+  /// report it as a struct-of-arrays candidate.
+  void analyzeGetElement(ApplyInst *Apply, OptRemark::Emitter &ORE) {
+    ArraySemanticsCall SemCall(Apply);
+    if (SemCall.getKind() != ArrayCallKind::kGetElement ||
+        !SemCall.hasGetElementDirectResult())
+      return;
+
+    StructDecl *ElemDecl = Apply->getType().getStructOrBoundGenericStruct();
+    if (!ElemDecl)
+      return;
+
+    unsigned NumFields = 0;
+    for (VarDecl *Property : ElemDecl->getStoredProperties()) {
+      (void)Property;
+      NumFields++;
+    }
+    if (NumFields < 2)
+      return;
+
+    // Collect the fields the loop actually reads. Any use other than a
+    // struct_extract consumes the whole element and disqualifies the call.
+    llvm::SmallPtrSet<VarDecl *, 4> UsedFields;
+    for (Operand *Op : getNonDebugUses(Apply)) {
+      auto *SEI = dyn_cast<StructExtractInst>(Op->getUser());
+      if (!SEI)
+        return;
+      UsedFields.insert(SEI->getField());
+    }
+    if (UsedFields.empty() || UsedFields.size() >= NumFields)
+      return;
+
+    DEBUG(llvm::dbgs() << "AoS candidate in " << Apply->getFunction()->getName()
+                       << ": " << *Apply);
+
+    ORE.emit([&]() {
+      using namespace OptRemark;
+      return RemarkMissed("ArrayOfStructLoop", *Apply)
+             << "loop reads " << NV("UsedFields", UsedFields.size())
+             << " of " << NV("TotalFields", NumFields) << " fields of "
+             << NV("ElementType", ElemDecl->getName().str())
+             << " array elements; a struct-of-arrays layout would improve "
+                "locality";
+    });
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createArrayLayoutOpt() {
+  return new ArrayLayoutOpt();
+}
@@ -92,10 +92,24 @@ llvm::cl::opt<bool> SILVerifyWithoutInvalidation(
     "sil-verify-without-invalidation", llvm::cl::init(false),
     llvm::cl::desc("Verify after passes even if the pass has not invalidated"));
 
+llvm::cl::opt<bool> SILVerifyFullModule(
+    "sil-verify-full-module", llvm::cl::init(false),
+    llvm::cl::desc("Verify the whole module after module passes instead of "
+                   "only the functions modified since the last verification"));
+
 llvm::cl::opt<bool> SILDisableSkippingPasses(
     "sil-disable-skipping-passes", llvm::cl::init(false),
     llvm::cl::desc("Do not skip passes even if nothing was changed"));
 
+llvm::cl::opt<std::string> SILCheckpointAfterPipeline(
+    "sil-checkpoint-after-pipeline", llvm::cl::init(""),
+    llvm::cl::desc("Serialize the module right after the pipeline with this "
+                   "name has run"));
+
+llvm::cl::opt<std::string> SILResumeFromPipeline(
+    "sil-resume-from-pipeline", llvm::cl::init(""),
+    llvm::cl::desc("Skip all pipelines before the pipeline with this name"));
+
 static llvm::ManagedStatic<std::vector<unsigned>> DebugPassNumbers;
 
 namespace {
@@ -335,7 +349,12 @@ void SILPassManager::runPassOnFunction(SILFunctionTransform *SFT,
     F->dump(getOptions().EmitVerboseSIL);
   }
 
-  llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
+  // Only read the clock if someone is going to look at the result; with
+  // pass timing and optimizer stats disabled it is pure per-pass overhead.
+  const bool TimePass = SILPrintPassTime || optimizerStatsEnabled();
+  llvm::sys::TimePoint<> StartTime;
+  if (TimePass)
+    StartTime = std::chrono::system_clock::now();
   Mod->registerDeleteNotificationHandler(SFT);
   if (breakBeforeRunning(F->getName(), SFT))
     LLVM_BUILTIN_DEBUGTRAP;
@@ -343,7 +362,9 @@ void SILPassManager::runPassOnFunction(SILFunctionTransform *SFT,
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->removeDeleteNotificationHandler(SFT);
 
-  auto Delta = (std::chrono::system_clock::now() - StartTime).count();
+  long long Delta = 0;
+  if (TimePass)
+    Delta = (std::chrono::system_clock::now() - StartTime).count();
   if (SILPrintPassTime) {
     llvm::dbgs() << Delta << " (" << SFT->getName() << "," << F->getName()
                  << ")\n";
@@ -368,6 +389,7 @@ void SILPassManager::runPassOnFunction(SILFunctionTransform *SFT,
       (CurrentPassHasInvalidated || SILVerifyWithoutInvalidation)) {
     F->verify();
     verifyAnalyses(F);
+    ModifiedFunctions.erase(F);
   }
 
   ++NumPassesRun;
@@ -463,14 +485,19 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
     printModule(Mod, Options.EmitVerboseSIL);
   }
 
-  llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
+  const bool TimePass = SILPrintPassTime || optimizerStatsEnabled();
+  llvm::sys::TimePoint<> StartTime;
+  if (TimePass)
+    StartTime = std::chrono::system_clock::now();
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->registerDeleteNotificationHandler(SMT);
   SMT->run();
   Mod->removeDeleteNotificationHandler(SMT);
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
 
-  auto Delta = (std::chrono::system_clock::now() - StartTime).count();
+  long long Delta = 0;
+  if (TimePass)
+    Delta = (std::chrono::system_clock::now() - StartTime).count();
   if (SILPrintPassTime) {
     llvm::dbgs() << Delta << " (" << SMT->getName() << ",Module)\n";
   }
@@ -488,11 +515,24 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
 
   if (Options.VerifyAll &&
       (CurrentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify();
+    verifyModule();
     verifyAnalyses();
   }
 }
 
+void SILPassManager::verifyModule() {
+  // Module-wide invalidations may have touched anything, including the
+  // vtables and witness tables, so fall back to the full sweep for them.
+  if (SILVerifyFullModule || ModifiedAllFunctions) {
+    Mod->verify();
+    ModifiedAllFunctions = false;
+  } else {
+    for (SILFunction *F : ModifiedFunctions)
+      F->verify();
+  }
+  ModifiedFunctions.clear();
+}
+
 void SILPassManager::runOneIteration() {
   const SILOptions &Options = getOptions();
 
@@ -624,6 +664,37 @@ StringRef SILPassManager::getStageName() const {
   return StageName;
 }
 
+bool SILPassManager::shouldSkipPipelineBeforeResumePoint(
+    StringRef PipelineName) {
+  if (SILResumeFromPipeline.empty() || ReachedResumePipeline)
+    return false;
+  if (PipelineName == SILResumeFromPipeline) {
+    ReachedResumePipeline = true;
+    return false;
+  }
+  return true;
+}
+
+void SILPassManager::checkpointAfterPipeline(StringRef PipelineName) {
+  if (SILCheckpointAfterPipeline.empty() ||
+      PipelineName != SILCheckpointAfterPipeline)
+    return;
+
+  // The checkpoint was already taken, e.g. by a pipeline with the same name.
+  if (Mod->isSerialized())
+    return;
+
+  // Without an installed serialization action (e.g. in sil-opt) we cannot
+  // snapshot the module here.
+  if (!Mod->getSerializeSILAction()) {
+    llvm::errs() << "*** Cannot checkpoint after pipeline '" << PipelineName
+                 << "': no serialization action installed\n";
+    return;
+  }
+
+  Mod->serialize();
+}
+
 const SILOptions &SILPassManager::getOptions() const {
   return Mod->getOptions();
 }
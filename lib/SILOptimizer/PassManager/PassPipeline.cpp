@@ -165,6 +165,9 @@ void addHighLevelLoopOptPasses(SILPassPipelinePlan &P) {
   P.addLowerAggregateInstrs();
   P.addSILCombine();
   P.addSROA();
+  // Report array-of-struct loops which would profit from a
+  // struct-of-arrays layout (only active with -sil-array-layout-opt).
+  P.addArrayLayoutOpt();
   P.addMem2Reg();
   P.addDCE();
   P.addSILCombine();
@@ -343,6 +346,10 @@ static void addMidModulePassesStackPromotePassPipeline(SILPassPipelinePlan &P) {
   P.addDeadObjectElimination();
   P.addGlobalPropertyOpt();
 
+  // Propagate constant arguments into module-private functions whose call
+  // sites are all known.
+  P.addIPConstantPropagation();
+
   // Do the first stack promotion on high-level SIL.
   P.addStackPromotion();
 }
@@ -429,12 +436,26 @@ static void addLateLoopOptPassPipeline(SILPassPipelinePlan &P) {
   P.addSILCombine();
   P.addSimplifyCFG();
 
+  // Move cold noreturn regions (error construction followed by a trap) out
+  // of the hot code. This runs after the last inliner so the outlined
+  // functions stay outlined.
+  P.addColdRegionOutliner();
+
   // Try to hoist all releases, including epilogue releases. This should be
   // after FSO.
   P.addLateReleaseHoisting();
 
+  // Make RC operations on provably thread-confined objects non-atomic. This
+  // should run late, after the inliners and release hoisting, so that escape
+  // analysis sees the final shape of the object lifetimes.
+  P.addNonAtomicRC();
+
   // Has only an effect if the -assume-single-thread option is specified.
   P.addAssumeSingleThreaded();
+
+  // Annotate functions with provable @effects attributes, so that clients
+  // of this module see precise effects for them without their bodies.
+  P.addEffectsInference();
 }
 
 static void addSILDebugInfoGeneratorPipeline(SILPassPipelinePlan &P) {
@@ -24,6 +24,15 @@
 /// can be very beneficial, use an optimistic global data flow to achieve
 /// optimality.
 ///
+/// The data flow is a partial redundancy elimination for reference count
+/// operations: because all critical edges are split first, a 1-to-0 bit
+/// transition on an edge places a compensating retain or release on exactly
+/// the paths which still need it, and paths which do not need the operation
+/// lose it entirely. Placement is driven by necessity — a path either needs
+/// its retain/release or it does not — so the number of operations executed
+/// on any single path is never increased and block frequency information
+/// cannot improve the chosen fixed point, only the static code size.
+///
 /// Proof of Correctness:
 /// -------------------
 ///
@@ -73,6 +82,7 @@
 #include "swift/SIL/SILBuilder.h"
 #include "swift/SILOptimizer/Analysis/AliasAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ARCAnalysis.h"
+#include "swift/SILOptimizer/Analysis/EpilogueARCAnalysis.h"
 #include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
 #include "swift/SILOptimizer/Analysis/PostOrderAnalysis.h"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
@@ -91,6 +101,8 @@ using namespace swift;
 
 STATISTIC(NumRetainsSunk, "Number of retains sunk");
 STATISTIC(NumReleasesHoisted, "Number of releases hoisted");
+STATISTIC(NumRetainsInserted, "Number of retains inserted at sink points");
+STATISTIC(NumReleasesInserted, "Number of releases inserted at hoist points");
 
 llvm::cl::opt<bool> DisableARCCodeMotion("disable-arc-cm", llvm::cl::init(false));
 
@@ -482,6 +494,7 @@ bool RetainCodeMotionContext::performCodeMotion() {
         continue;
       }
       createIncrementBefore(Iter->first, IP);
+      ++NumRetainsInserted;
       Changed = true;
     }
   }
@@ -892,6 +905,7 @@ bool ReleaseCodeMotionContext::performCodeMotion() {
         continue;
       }
       createDecrementBefore(Iter->first, IP);
+      ++NumReleasesInserted;
       Changed = true;
     }
   }
@@ -1084,10 +1098,10 @@ public:
     if (Kind == Release) {
       // TODO: we should consider Throw block as well, or better we should
       // abstract the Return block or Throw block away in the matcher.
-      SILArgumentConvention Conv[] = {SILArgumentConvention::Direct_Owned};
-      ConsumedArgToEpilogueReleaseMatcher ERM(RCFI, F,
-            Conv,
-            ConsumedArgToEpilogueReleaseMatcher::ExitKind::Return);
+      ConsumedArgToEpilogueReleaseMatcher &ERM =
+          PM->getAnalysis<EpilogueARCAnalysis>()
+              ->get(F)
+              ->getOwnedArgToReturnReleaseMatcher();
 
       ReleaseCodeMotionContext RelCM(BPA, F, PO, AA, RCFI, 
                                      FreezeEpilogueReleases, ERM); 
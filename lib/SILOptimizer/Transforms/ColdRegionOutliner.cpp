@@ -0,0 +1,338 @@
+//===--- ColdRegionOutliner.cpp - Outline cold noreturn regions -----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Moves cold, non-returning regions - typically error message construction
+// followed by a trap - out of their function into separate noinline
+// functions. This shrinks the instruction footprint of the hot code
+// surrounding the region, which matters for functions whose loops would
+// otherwise stream inline error paths through the instruction cache.
+//
+// A candidate region is a set of blocks with a single entry which is
+// classified as cold by ColdBlockInfo, where every path through the region
+// ends in an unreachable terminator. Because the region never returns, the
+// call to the outlined function needs no result plumbing and the caller side
+// degenerates to an apply followed by unreachable. Only regions whose
+// incoming values are object types without archetypes are outlined, so the
+// outlined function's signature is always trivially expressible.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "cold-region-outliner"
+#include "swift/SIL/SILArgument.h"
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SIL/SILUndef.h"
+#include "swift/SILOptimizer/Analysis/ColdBlockInfo.h"
+#include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SILOptimizer/Utils/CFG.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+STATISTIC(NumColdRegionsOutlined, "Number of cold noreturn regions outlined");
+
+llvm::cl::opt<bool> EnableColdRegionOutlining(
+    "sil-cold-region-outlining", llvm::cl::init(true),
+    llvm::cl::desc("Outline cold noreturn regions into separate functions"));
+
+/// The minimum number of instructions a region must contain to be worth a
+/// call; smaller regions are already moved out of the fall-through path by
+/// LLVM's block placement.
+static llvm::cl::opt<int> MinColdRegionSize(
+    "sil-cold-region-min-size", llvm::cl::init(10),
+    llvm::cl::desc("Minimum instruction count of an outlined cold region"));
+
+namespace {
+
+class ColdRegionOutliner : public SILFunctionTransform {
+
+  using BlockSet = llvm::SmallPtrSet<SILBasicBlock *, 8>;
+
+  void run() override {
+    if (!EnableColdRegionOutlining)
+      return;
+
+    SILFunction *F = getFunction();
+    if (!F->shouldOptimize())
+      return;
+
+    // A serialized function cannot reference the private outlined function.
+    if (F->isSerialized())
+      return;
+
+    // Outlined signatures cannot bind the function's archetypes.
+    if (F->getGenericEnvironment())
+      return;
+
+    DominanceAnalysis *DA = PM->getAnalysis<DominanceAnalysis>();
+    DominanceInfo *DT = DA->get(F);
+    ColdBlockInfo ColdBlocks(DA);
+
+    // Collect the region entries up front; outlining invalidates iterators
+    // and dominance.
+    SmallVector<std::pair<SILBasicBlock *, BlockSet>, 4> Regions;
+    BlockSet BlocksInRegions;
+    for (SILBasicBlock &BB : *F) {
+      if (&BB == &*F->begin() || BlocksInRegions.count(&BB))
+        continue;
+      if (!ColdBlocks.isCold(&BB))
+        continue;
+
+      BlockSet Region;
+      if (!computeRegion(&BB, DT, Region))
+        continue;
+
+      // Only regions entered from outside are outlined; inner cold blocks
+      // are covered by their enclosing region. A region which overlaps an
+      // already collected one is skipped; the remainder is picked up by a
+      // later run of the pass.
+      bool IsEntry = true;
+      for (SILBasicBlock *Pred : BB.getPredecessorBlocks()) {
+        if (Region.count(Pred)) {
+          IsEntry = false;
+          break;
+        }
+      }
+      bool Overlaps = false;
+      for (SILBasicBlock *Member : Region) {
+        if (BlocksInRegions.count(Member)) {
+          Overlaps = true;
+          break;
+        }
+      }
+      if (!IsEntry || Overlaps)
+        continue;
+
+      BlocksInRegions.insert(Region.begin(), Region.end());
+      Regions.push_back({&BB, std::move(Region)});
+    }
+
+    bool Changed = false;
+    for (auto &Entry : Regions)
+      Changed |= outlineRegion(Entry.first, Entry.second);
+
+    if (Changed)
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Everything);
+  }
+
+  /// Computes the set of blocks reachable from \p R. Returns false if the
+  /// region is not single-entry (a member is not dominated by \p R), can
+  /// leave the function through anything but an unreachable, or is too small
+  /// to be worth a call.
+  bool computeRegion(SILBasicBlock *R, DominanceInfo *DT, BlockSet &Region) {
+    SmallVector<SILBasicBlock *, 8> Worklist;
+    Worklist.push_back(R);
+    Region.insert(R);
+
+    int NumInstructions = 0;
+    while (!Worklist.empty()) {
+      SILBasicBlock *BB = Worklist.pop_back_val();
+      if (!DT->dominates(R, BB))
+        return false;
+
+      TermInst *TI = BB->getTerminator();
+      if (isa<ReturnInst>(TI) || isa<ThrowInst>(TI) || isa<YieldInst>(TI) ||
+          isa<UnwindInst>(TI))
+        return false;
+
+      NumInstructions += std::distance(BB->begin(), BB->end());
+      for (SILBasicBlock *Succ : TI->getSuccessorBlocks()) {
+        if (Region.insert(Succ).second)
+          Worklist.push_back(Succ);
+      }
+    }
+    return NumInstructions >= MinColdRegionSize;
+  }
+
+  /// Returns true if \p V is defined outside of \p Region. SILUndef has no
+  /// defining block and is usable from any function.
+  static bool isDefinedOutside(SILValue V, const BlockSet &Region) {
+    if (isa<SILUndef>(V))
+      return false;
+    if (auto *A = dyn_cast<SILArgument>(V))
+      return !Region.count(A->getParent());
+    return !Region.count(cast<SILInstruction>(V)->getParent());
+  }
+
+  /// Returns true if \p Ty can cross the outlining boundary as a plain
+  /// direct parameter.
+  static bool isSupportedArgumentType(SILType Ty) {
+    return Ty.isObject() && !Ty.getSwiftRValueType()->hasArchetype();
+  }
+
+  /// Collects the values defined outside \p Region but used inside it.
+  /// Returns false if any of them cannot become a parameter of the outlined
+  /// function.
+  bool collectLiveIns(const BlockSet &Region,
+                      llvm::SmallSetVector<SILValue, 8> &LiveIns) {
+    for (SILBasicBlock *BB : Region) {
+      for (SILInstruction &I : *BB) {
+        // An opened archetype defined outside the region cannot be rebound
+        // in the outlined function.
+        for (const Operand &Op : I.getTypeDependentOperands()) {
+          if (isDefinedOutside(Op.get(), Region))
+            return false;
+        }
+        for (const Operand &Op : I.getAllOperands()) {
+          SILValue V = Op.get();
+          if (!isDefinedOutside(V, Region))
+            continue;
+          if (!isSupportedArgumentType(V->getType()))
+            return false;
+          LiveIns.insert(V);
+        }
+      }
+    }
+    return true;
+  }
+
+  /// Picks a name for the function outlined from \p F which is unused in
+  /// the module.
+  static std::string getOutlinedName(SILFunction *F, SILModule &M) {
+    for (unsigned Idx = 0;; ++Idx) {
+      std::string Name = (F->getName() + ".cold." + llvm::Twine(Idx)).str();
+      if (!M.lookUpFunction(Name))
+        return Name;
+    }
+  }
+
+  /// Moves the region entered at \p R into a new noinline function and
+  /// replaces it with an apply of that function followed by unreachable.
+  /// Returns true if the region was outlined.
+  bool outlineRegion(SILBasicBlock *R, const BlockSet &Region) {
+    SILFunction *F = getFunction();
+    SILModule &M = F->getModule();
+
+    for (SILArgument *A : R->getArguments()) {
+      if (!isSupportedArgumentType(A->getType()))
+        return false;
+    }
+
+    llvm::SmallSetVector<SILValue, 8> LiveIns;
+    if (!collectLiveIns(Region, LiveIns))
+      return false;
+
+    DEBUG(llvm::dbgs() << "Outlining cold region of " << Region.size()
+                       << " blocks from " << F->getName() << "\n");
+
+    // The outlined function takes the region entry's block arguments
+    // followed by the live-in values; it never returns.
+    SmallVector<SILParameterInfo, 8> Parameters;
+    for (SILArgument *A : R->getArguments())
+      Parameters.push_back(SILParameterInfo(A->getType().getSwiftRValueType(),
+                                            ParameterConvention::Direct_Unowned));
+    for (SILValue V : LiveIns)
+      Parameters.push_back(SILParameterInfo(V->getType().getSwiftRValueType(),
+                                            ParameterConvention::Direct_Unowned));
+    auto ExtInfo =
+        SILFunctionType::ExtInfo(SILFunctionType::Representation::Thin,
+                                 /*pseudogeneric*/ false, /*noescape*/ false);
+    auto FunctionType = SILFunctionType::get(
+        nullptr, ExtInfo, SILCoroutineKind::None,
+        ParameterConvention::Direct_Unowned, Parameters, /*yields*/ {},
+        /*results*/ {}, None, M.getASTContext());
+
+    SILLocation Loc = R->getTerminator()->getLoc();
+    auto *Fun = M.getOrCreateFunction(Loc, getOutlinedName(F, M),
+                                      SILLinkage::Private, FunctionType,
+                                      IsNotBare, IsNotTransparent,
+                                      IsNotSerialized);
+    assert(Fun->empty() && "outlined function name is not unique");
+    if (F->hasUnqualifiedOwnership())
+      Fun->setUnqualifiedOwnership();
+    Fun->setInlineStrategy(NoInline);
+
+    // In the caller, replace the region with a block which forwards the
+    // region entry's arguments and the live-ins into a call of the outlined
+    // function.
+    SILBasicBlock *CallBB = F->createBasicBlock();
+    for (SILArgument *A : R->getArguments())
+      CallBB->createPHIArgument(A->getType(), A->getOwnershipKind());
+
+    SmallVector<SILBasicBlock *, 4> OutsidePreds;
+    for (SILBasicBlock *Pred : R->getPredecessorBlocks()) {
+      if (!Region.count(Pred))
+        OutsidePreds.push_back(Pred);
+    }
+    for (SILBasicBlock *Pred : OutsidePreds)
+      replaceBranchTarget(Pred->getTerminator(), R, CallBB,
+                          /*PreserveArgs*/ true);
+
+    {
+      SILBuilder Builder(CallBB);
+      SmallVector<SILValue, 8> Args;
+      for (SILArgument *A : CallBB->getArguments())
+        Args.push_back(A);
+      for (SILValue V : LiveIns)
+        Args.push_back(V);
+      SILValue FunRef(Builder.createFunctionRef(Loc, Fun));
+      Builder.createApply(Loc, FunRef, Args, false);
+      Builder.createUnreachable(Loc);
+    }
+
+    // Move the region's blocks into the outlined function, entry first.
+    auto &FromBlockList = F->getBlocks();
+    Fun->getBlocks().splice(Fun->end(), FromBlockList, R);
+    for (SILBasicBlock *BB : Region) {
+      if (BB != R)
+        Fun->getBlocks().splice(Fun->end(), FromBlockList, BB);
+    }
+
+    // Create an entry block holding the function arguments, which branches
+    // to the old region entry to feed its block arguments.
+    SILBasicBlock *EntryBB = Fun->createBasicBlock();
+    Fun->getBlocks().splice(Fun->begin(), Fun->getBlocks(), EntryBB);
+    for (SILParameterInfo Param : Parameters)
+      EntryBB->createFunctionArgument(
+          SILType::getPrimitiveObjectType(Param.getType()));
+
+    unsigned NumEntryArgs = R->getNumArguments();
+    {
+      SILBuilder Builder(EntryBB);
+      SmallVector<SILValue, 4> BranchArgs;
+      for (unsigned Idx = 0; Idx < NumEntryArgs; ++Idx)
+        BranchArgs.push_back(EntryBB->getArgument(Idx));
+      Builder.createBranch(Loc, R, BranchArgs);
+    }
+
+    // Rewire the region's uses of the live-ins to the matching function
+    // arguments.
+    for (unsigned Idx = 0, End = LiveIns.size(); Idx < End; ++Idx) {
+      SILValue V = LiveIns[Idx];
+      SILArgument *Arg = EntryBB->getArgument(NumEntryArgs + Idx);
+      SmallVector<Operand *, 8> Uses(V->use_begin(), V->use_end());
+      for (Operand *Use : Uses) {
+        if (Region.count(Use->getUser()->getParent()))
+          Use->set(Arg);
+      }
+    }
+
+    NumColdRegionsOutlined++;
+    notifyAddFunction(Fun, nullptr);
+    return true;
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createColdRegionOutliner() {
+  return new ColdRegionOutliner();
+}
@@ -1045,8 +1045,8 @@ bool FunctionSignatureTransform::ArgumentExplosionAnalyzeParameters() {
   // Did we decide we should optimize any parameter?
   bool SignatureOptimize = false;
   auto Args = F->begin()->getFunctionArguments();
-  ConsumedArgToEpilogueReleaseMatcher ArgToReturnReleaseMap(
-    RCIA->get(F), F, {SILArgumentConvention::Direct_Owned});
+  ConsumedArgToEpilogueReleaseMatcher &ArgToReturnReleaseMap =
+      EA->get(F)->getOwnedArgToReturnReleaseMatcher();
 
   // Analyze the argument information.
   for (unsigned i = 0, e = Args.size(); i != e; ++i) {
@@ -0,0 +1,124 @@
+//===--- NonAtomicRC.cpp - Non-atomic RC for thread-confined objects ------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Converts reference counting operations on provably thread-confined objects
+// into non-atomic ones.
+//
+// An object allocated by an alloc_ref whose connection graph node does not
+// escape the allocating function can only ever be referenced from the thread
+// which allocated it: no other thread can obtain a reference, so there can be
+// no concurrent reference counting operations on the object. Such operations
+// are lowered to the swift_nonatomic_* runtime entry points, which avoid the
+// atomic read-modify-write on the object header.
+//
+// Mixing atomic operations (e.g. performed by a non-escaping callee or the
+// deallocating destroyer) with non-atomic ones is safe here because all of
+// them execute sequentially on the allocating thread.
+//
+// Unlike AssumeSingleThreaded, which unconditionally rewrites every reference
+// counting operation in the module based on a user promise, this pass is
+// verified: it relies solely on escape analysis and is therefore always
+// enabled.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
+#include "swift/SIL/InstructionUtils.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Statistic.h"
+
+#define DEBUG_TYPE "non-atomic-rc"
+
+STATISTIC(NumNonAtomicRC, "Number of RC operations made non-atomic");
+
+using namespace swift;
+
+namespace {
+
+/// Converts reference counting operations on non-escaping alloc_ref objects
+/// into non-atomic ones.
+class NonAtomicRC : public SILFunctionTransform {
+
+  /// The entry point to the transformation.
+  void run() override {
+    SILFunction *F = getFunction();
+
+    // With -assume-single-threaded all RC operations are rewritten anyway.
+    if (getOptions().AssumeSingleThreaded)
+      return;
+
+    DEBUG(llvm::dbgs() << "** NonAtomicRC in " << F->getName() << " **\n");
+
+    auto *EA = PM->getAnalysis<EscapeAnalysis>();
+    auto *ConGraph = EA->getConnectionGraph(F);
+
+    // Caches the escape-analysis verdict per allocation, because an object is
+    // typically the target of several RC operations.
+    llvm::SmallDenseMap<AllocRefInst *, bool, 8> ConfinedAllocs;
+
+    bool Changed = false;
+    for (SILBasicBlock &BB : *F) {
+      for (SILInstruction &I : BB) {
+        if (auto *RCI = dyn_cast<RefCountingInst>(&I)) {
+          if (!RCI->isNonAtomic() && isThreadConfined(RCI->getOperand(0), EA,
+                                                      ConGraph,
+                                                      ConfinedAllocs)) {
+            RCI->setNonAtomic();
+            NumNonAtomicRC++;
+            Changed = true;
+          }
+        } else if (auto *SPI = dyn_cast<StrongPinInst>(&I)) {
+          if (!SPI->isNonAtomic() && isThreadConfined(SPI->getOperand(), EA,
+                                                      ConGraph,
+                                                      ConfinedAllocs)) {
+            SPI->setNonAtomic();
+            NumNonAtomicRC++;
+            Changed = true;
+          }
+        }
+      }
+    }
+    if (Changed)
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
+  }
+
+  /// Returns true if \p Ref provably refers to an object which never leaves
+  /// the allocating thread.
+  bool isThreadConfined(SILValue Ref, EscapeAnalysis *EA,
+                        EscapeAnalysis::ConnectionGraph *ConGraph,
+                        llvm::SmallDenseMap<AllocRefInst *, bool, 8> &Cache) {
+    // Only objects whose allocation we can see are known to be confined;
+    // references passed in from the outside may be shared between threads.
+    auto *ARI = dyn_cast<AllocRefInst>(getUnderlyingObject(Ref));
+    if (!ARI || ARI->isObjC())
+      return false;
+
+    auto CacheIter = Cache.find(ARI);
+    if (CacheIter != Cache.end())
+      return CacheIter->second;
+
+    auto *Node = ConGraph->getNodeOrNull(ARI, EA);
+    bool Confined = Node && !Node->escapes();
+    Cache[ARI] = Confined;
+    return Confined;
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createNonAtomicRC() {
+  return new NonAtomicRC();
+}
@@ -12,6 +12,7 @@
 
 #define DEBUG_TYPE "sil-inliner"
 #include "swift/SIL/OptimizationRemark.h"
+#include "swift/SILOptimizer/Analysis/InlineCostAnalysis.h"
 #include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
@@ -51,6 +52,7 @@ class SILPerformanceInliner {
   DominanceAnalysis *DA;
   SILLoopAnalysis *LA;
   SideEffectAnalysis *SEA;
+  InlineCostAnalysis *ICA;
 
   // For keys of SILFunction and SILLoop.
   llvm::DenseMap<SILFunction *, ShortestPathAnalysis *> SPAs;
@@ -161,9 +163,10 @@ class SILPerformanceInliner {
 public:
   SILPerformanceInliner(InlineSelection WhatToInline, DominanceAnalysis *DA,
                         SILLoopAnalysis *LA, SideEffectAnalysis *SEA,
-                        OptimizationMode OptMode, OptRemark::Emitter &ORE)
-      : WhatToInline(WhatToInline), DA(DA), LA(LA), SEA(SEA), CBI(DA), ORE(ORE),
-        OptMode(OptMode) {}
+                        InlineCostAnalysis *ICA, OptimizationMode OptMode,
+                        OptRemark::Emitter &ORE)
+      : WhatToInline(WhatToInline), DA(DA), LA(LA), SEA(SEA), ICA(ICA),
+        CBI(DA), ORE(ORE), OptMode(OptMode) {}
 
   bool inlineCallsIntoFunction(SILFunction *F);
 };
@@ -273,6 +276,21 @@ bool SILPerformanceInliner::isProfitableToInline(
     return false;
   }
 
+  // Only trivial callees get inlined into thunks. If the cached summary of
+  // the whole body is already under the threshold, the decision is clear
+  // without the caller-context walk below. The walk still runs for larger
+  // callees, because caller-side constant propagation may prune the cost
+  // under the threshold.
+  if (AI.getFunction()->isThunk() &&
+      ICA->get(Callee)->getCost() <= TrivialFunctionThreshold) {
+    DEBUG(
+      dumpCaller(AI.getFunction());
+      llvm::dbgs() << "    decision {trivial into thunk} " <<
+          Callee->getName() << '\n';
+    );
+    return true;
+  }
+
   SILLoopInfo *LI = LA->get(Callee);
   ShortestPathAnalysis *SPA = getSPA(Callee, LI);
   assert(SPA->isValid());
@@ -555,15 +573,12 @@ bool SILPerformanceInliner::decideInColdBlock(FullApplySite AI,
     return true;
   }
 
-  int CalleeCost = 0;
+  // The summary is cached across call sites and pass invocations, so this
+  // is a table lookup for all but the first query of a function version.
+  int CalleeCost = ICA->get(Callee)->getCost();
+  if (CalleeCost > TrivialFunctionThreshold)
+    return false;
 
-  for (SILBasicBlock &Block : *Callee) {
-    for (SILInstruction &I : Block) {
-      CalleeCost += int(instructionInlineCost(I));
-      if (CalleeCost > TrivialFunctionThreshold)
-        return false;
-    }
-  }
   DEBUG(
     dumpCaller(AI.getFunction());
     llvm::dbgs() << "    cold decision {" << CalleeCost << "} " <<
@@ -895,6 +910,7 @@ public:
     DominanceAnalysis *DA = PM->getAnalysis<DominanceAnalysis>();
     SILLoopAnalysis *LA = PM->getAnalysis<SILLoopAnalysis>();
     SideEffectAnalysis *SEA = PM->getAnalysis<SideEffectAnalysis>();
+    InlineCostAnalysis *ICA = PM->getAnalysis<InlineCostAnalysis>();
     OptRemark::Emitter ORE(DEBUG_TYPE, getFunction()->getModule());
 
     if (getOptions().InlineThreshold == 0) {
@@ -903,7 +919,8 @@ public:
 
     auto OptMode = getFunction()->getEffectiveOptimizationMode();
 
-    SILPerformanceInliner Inliner(WhatToInline, DA, LA, SEA, OptMode, ORE);
+    SILPerformanceInliner Inliner(WhatToInline, DA, LA, SEA, ICA, OptMode,
+                                  ORE);
 
     assert(getFunction()->isDefinition() &&
            "Expected only functions with bodies!");
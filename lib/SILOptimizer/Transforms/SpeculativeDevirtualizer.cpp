@@ -42,7 +42,10 @@ using namespace swift;
 
 // This is the limit for the number of subclasses (jump targets) that the
 // speculative devirtualizer will try to predict.
-static const int MaxNumSpeculativeTargets = 6;
+static llvm::cl::opt<int> MaxNumSpeculativeTargets(
+    "sil-spec-devirt-max-targets", llvm::cl::init(6),
+    llvm::cl::desc("The maximum number of speculative devirtualization "
+                   "targets per call site"));
 
 STATISTIC(NumTargetsPredicted, "Number of monomorphic functions predicted");
 
@@ -320,6 +323,55 @@ static bool isDefaultCaseKnown(ClassHierarchyAnalysis *CHA,
   return true;
 }
 
+/// Returns the SILType of the class (or metatype) which \p CMI would
+/// dispatch on if the dynamic type of the instance were exactly \p S.
+static SILType getExactDynamicType(ClassDecl *S, SILType SubType) {
+  CanType CanClassType = S->getDeclaredType()->getCanonicalType();
+  SILType ClassType = SILType::getPrimitiveObjectType(CanClassType);
+  if (!ClassType.getClassOrBoundGenericClass())
+    return SILType();
+
+  if (auto EMT = SubType.getAs<AnyMetatypeType>()) {
+    auto InstTy = ClassType.getSwiftRValueType();
+    auto *MetaTy = MetatypeType::get(InstTy, EMT->getRepresentation());
+    return SILType::getPrimitiveObjectType(CanMetatypeType(MetaTy));
+  }
+  return ClassType;
+}
+
+/// Sort \p Subs so that subclasses whose method implementations have higher
+/// PGO entry counts are checked first. The entry count of the override a
+/// subclass dispatches to approximates how often that receiver class was
+/// observed in the profiled run. Subclasses without profile data compare
+/// equal, so without PGO the breadth-first order is kept unchanged.
+static void orderSubclassesByProfile(SmallVectorImpl<ClassDecl *> &Subs,
+                                     SILType SubType, ClassMethodInst *CMI,
+                                     SILModule &M) {
+  auto getMethodEntryCount = [&](ClassDecl *S) -> uint64_t {
+    SILType ClassOrMetatypeType = getExactDynamicType(S, SubType);
+    if (!ClassOrMetatypeType)
+      return 0;
+    SILFunction *Target = getTargetClassMethod(M, ClassOrMetatypeType, CMI);
+    if (!Target)
+      return 0;
+    ProfileCounter Count = Target->getEntryCount();
+    return Count ? Count.getValue() : 0;
+  };
+
+  SmallVector<std::pair<uint64_t, ClassDecl *>, 8> CountedSubs;
+  for (ClassDecl *S : Subs)
+    CountedSubs.push_back({getMethodEntryCount(S), S});
+
+  std::stable_sort(CountedSubs.begin(), CountedSubs.end(),
+                   [](const std::pair<uint64_t, ClassDecl *> &LHS,
+                      const std::pair<uint64_t, ClassDecl *> &RHS) {
+                     return LHS.first > RHS.first;
+                   });
+
+  for (unsigned Idx = 0, End = Subs.size(); Idx < End; ++Idx)
+    Subs[Idx] = CountedSubs[Idx].second;
+}
+
 /// \brief Try to speculate the call target for the call \p AI. This function
 /// returns true if a change was made.
 static bool tryToSpeculateTarget(FullApplySite AI,
@@ -411,6 +463,11 @@ static bool tryToSpeculateTarget(FullApplySite AI,
     Subs.erase(RemovedIt, Subs.end());
   }
 
+  // With PGO data, check the most frequently executed overrides first, so
+  // that the hot receiver classes are found by the earliest checks and the
+  // per-call-site cap keeps the hot targets when it truncates the list.
+  orderSubclassesByProfile(Subs, SubType, CMI, M);
+
   // Number of subclasses which cannot be handled by checked_cast_br checks.
   int NotHandledSubsNum = 0;
   if (Subs.size() > MaxNumSpeculativeTargets) {
@@ -477,30 +534,21 @@ static bool tryToSpeculateTarget(FullApplySite AI,
   // in the future, if we start using PGO for ordering of checked_cast_br
   // checks.
 
-  // TODO: The ordering of checks may benefit from using a PGO, because
-  // the most probable alternatives could be checked first.
+  // When PGO data is available, orderSubclassesByProfile has already moved
+  // the most probable alternatives to the front so they are checked first.
 
   for (auto S : Subs) {
     DEBUG(llvm::dbgs() << "Inserting a speculative call for class "
           << CD->getName() << " and subclass " << S->getName() << "\n");
 
-    CanType CanClassType = S->getDeclaredType()->getCanonicalType();
-    SILType ClassType = SILType::getPrimitiveObjectType(CanClassType);
-    if (!ClassType.getClassOrBoundGenericClass()) {
+    SILType ClassOrMetatypeType = getExactDynamicType(S, SubType);
+    if (!ClassOrMetatypeType) {
       // This subclass cannot be handled. This happens e.g. if it is
       // a generic class.
       NotHandledSubsNum++;
       continue;
     }
 
-    auto ClassOrMetatypeType = ClassType;
-    if (auto EMT = SubType.getAs<AnyMetatypeType>()) {
-      auto InstTy = ClassType.getSwiftRValueType();
-      auto *MetaTy = MetatypeType::get(InstTy, EMT->getRepresentation());
-      auto CanMetaTy = CanMetatypeType(MetaTy);
-      ClassOrMetatypeType = SILType::getPrimitiveObjectType(CanMetaTy);
-    }
-
     // Pass the metatype of the subclass.
     auto NewAI = speculateMonomorphicTarget(AI, ClassOrMetatypeType, LastCCBI);
     if (!NewAI) {
@@ -24,6 +24,7 @@
 #include "swift/SILOptimizer/Analysis/AliasAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ARCAnalysis.h"
 #include "swift/SILOptimizer/Analysis/Analysis.h"
+#include "swift/SILOptimizer/Analysis/EpilogueARCAnalysis.h"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 
@@ -41,6 +42,7 @@ class SILEpilogueRetainReleaseMatcherDumper : public SILModuleTransform {
   void run() override {
     auto *AA = PM->getAnalysis<AliasAnalysis>();
     auto *RCIA = getAnalysis<RCIdentityAnalysis>();
+    auto *EA = PM->getAnalysis<EpilogueARCAnalysis>();
     for (auto &Fn: *getModule()) {
       // Function is not definition.
       if (!Fn.isDefinition())
@@ -54,7 +56,8 @@ class SILEpilogueRetainReleaseMatcherDumper : public SILModuleTransform {
         llvm::outs() << *RI;
 
       // Handle @owned function arguments.
-      ConsumedArgToEpilogueReleaseMatcher RelMap(RCIA->get(&Fn), &Fn); 
+      ConsumedArgToEpilogueReleaseMatcher &RelMap =
+          EA->get(&Fn)->getOwnedArgToReturnReleaseMatcher();
       // Iterate over arguments and dump their epilogue releases.
       for (auto Arg : Fn.getArguments()) {
         llvm::outs() << *Arg;
@@ -1827,6 +1827,26 @@ SILFunction *GenericFuncSpecializer::lookupSpecialization() {
                        << "\n");
     return SpecializedF;
   }
+
+  // Try to deserialize an identically mangled specialization from one of the
+  // imported serialized modules. The mangled name encodes the generic
+  // function and the substitutions, so a name match guarantees the same,
+  // already optimized body - much cheaper to reuse than re-running the
+  // cloner and re-optimizing the clone.
+  // A shared function may only be referenced together with its body, so the
+  // deserialized copy is usable only if it is a definition.
+  if (SILFunction *SpecializedF =
+          M.loadFunction(ClonedName, SILLinkage::Shared)) {
+    if (SpecializedF->isDefinition()) {
+      assert(ReInfo.getSpecializedType() ==
+                 SpecializedF->getLoweredFunctionType() &&
+             "Deserialized specialization does not match expected type.");
+      DEBUG(llvm::dbgs() << "Deserialized an existing specialization for: "
+                         << ClonedName << "\n");
+      return SpecializedF;
+    }
+  }
+
   DEBUG(llvm::dbgs() << "Could not find an existing specialization for: "
                      << ClonedName << "\n");
   return nullptr;
@@ -51,11 +51,11 @@
 ///
 /// For counter updates it looks like this:
 ///  Kind, CounterName, StageName, TransformName, TransformPassNumber,
-///  DeltaValue, OldCounterValue, NewCounterValue, Duration, Symbol
+///  DeltaValue, OldCounterValue, NewCounterValue, Duration, Symbol, Session
 ///
 /// For counter updates it looks like this:
 ///  Kind, CounterName, StageName, TransformName, TransformPassNumber,
-///  CounterValue, Duration, Symbol
+///  CounterValue, Duration, Symbol, Session
 ///
 /// where Kind is one of "function", "module", "function_history",
 ///       CounterName is one of "block", "inst", "function", "memory",
@@ -63,11 +63,16 @@
 ///       StageName and TransformName are the names of the current optimizer
 ///       pipeline stage and current transform.
 ///       Duration is the duration of the transformation.
+///       Session is the build-session identifier assigned by the driver,
+///       shared with the files written by -stats-output-dir (zero when the
+///       frontend was invoked without a driver).
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Process.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/SIL/SILValue.h"
 #include "swift/SIL/SILVisitor.h"
 #include "swift/SILOptimizer/Analysis/Analysis.h"
@@ -574,6 +579,15 @@ llvm::raw_ostream &stats_os() {
   return *stats_output_stream.get();
 }
 
+/// The driver-assigned build session this frontend belongs to, as recorded
+/// by the unified stats reporter; zero when the frontend runs standalone.
+/// Emitted as the last column of each line so the optimizer counters can be
+/// joined with the rest of the stats written during the same build.
+size_t getBuildSession(TransformationContext &Ctx) {
+  auto *Stats = Ctx.getModule().getASTContext().Stats;
+  return Stats ? Stats->getFrontendCounters().BuildSessionId : 0;
+}
+
 /// A helper function to dump the counter value.
 void printCounterValue(StringRef Kind, StringRef CounterName, int CounterValue,
                        StringRef Symbol, TransformationContext &Ctx) {
@@ -599,6 +613,9 @@ void printCounterValue(StringRef Kind, StringRef CounterName, int CounterValue,
   stats_os() << ", ";
 
   stats_os() << Symbol;
+  stats_os() << ", ";
+
+  stats_os() << getBuildSession(Ctx);
   stats_os() << "\n";
 }
 
@@ -634,6 +651,9 @@ void printCounterChange(StringRef Kind, StringRef CounterName, double Delta,
   stats_os() << ", ";
 
   stats_os() << Symbol;
+  stats_os() << ", ";
+
+  stats_os() << getBuildSession(Ctx);
   stats_os() << "\n";
 }
 
@@ -948,6 +968,10 @@ FunctionStat::FunctionStat(SILFunction *F) {
 
 } // end anonymous namespace
 
+bool swift::optimizerStatsEnabled() {
+  return SILStatsModules || SILStatsFunctions || SILStatsDumpAll;
+}
+
 /// Updates SILModule stats after finishing executing the
 /// transform \p Transform.
 ///
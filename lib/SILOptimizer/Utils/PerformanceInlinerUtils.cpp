@@ -696,17 +696,25 @@ SILFunction *swift::getEligibleFunction(FullApplySite AI,
     }
   }
 
-  // We can't inline external declarations.
-  if (Callee->empty() || Callee->isExternalDeclaration()) {
+  // Explicitly disabled inlining. The inline strategy is known from the
+  // declaration alone, so reject before deserializing the body below.
+  if (Callee->getInlineStrategy() == NoInline) {
     return nullptr;
   }
 
-  // Explicitly disabled inlining.
-  if (Callee->getInlineStrategy() == NoInline) {
+  if (!Callee->shouldOptimize()) {
     return nullptr;
   }
 
-  if (!Callee->shouldOptimize()) {
+  // If the callee's body lives in a serialized module, pull it in on demand
+  // now that the cheap attribute-based rejections are out of the way. This
+  // catches references that became visible only after the last eager linker
+  // run, e.g. from devirtualization or specialization.
+  if (Callee->isExternalDeclaration())
+    AI.getModule().linkFunction(Callee, SILModule::LinkingMode::LinkAll);
+
+  // We can't inline external declarations.
+  if (Callee->empty() || Callee->isExternalDeclaration()) {
     return nullptr;
   }
 
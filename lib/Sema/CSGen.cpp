@@ -805,6 +805,86 @@ namespace {
     }
   }
   
+  /// Disable operator overload choices whose parameter count cannot match
+  /// the application's arity, so the solver never attempts them. Swift
+  /// operators are exactly unary or binary, which makes the arity check a
+  /// safe syntactic pre-filter even before any types are resolved.
+  void pruneOperatorOverloadsByArity(ApplyExpr *expr, ConstraintSystem &CS,
+                                     unsigned arity) {
+    // Find the type variable associated with the function, if any.
+    auto tyvarType = CS.getType(expr->getFn())->getAs<TypeVariableType>();
+    if (!tyvarType)
+      return;
+
+    auto &CG = CS.getConstraintGraph();
+    SmallVector<Constraint *, 4> constraints;
+    CG.gatherConstraints(tyvarType, constraints,
+                         ConstraintGraph::GatheringKind::EquivalenceClass);
+
+    // Compute the number of operands an overload takes, or None if that
+    // cannot be determined syntactically.
+    auto getArity = [](ValueDecl *value) -> Optional<unsigned> {
+      auto valueTy = value->getInterfaceType();
+      if (!valueTy)
+        return None;
+
+      auto fnTy = valueTy->getAs<AnyFunctionType>();
+      if (!fnTy)
+        return None;
+
+      // Skip the 'self' level of a static member operator.
+      if (value->getDeclContext()->isTypeContext())
+        fnTy = fnTy->getResult()->getAs<AnyFunctionType>();
+      if (!fnTy)
+        return None;
+
+      // A parenthesized single parameter is one operand no matter what it
+      // wraps; getAs<> would look through the ParenType sugar and treat a
+      // tuple-typed parameter as multiple operands.
+      if (isa<ParenType>(fnTy->getInput().getPointer()))
+        return 1;
+      if (auto tupleTy = fnTy->getInput()->getAs<TupleType>())
+        return tupleTy->getNumElements();
+      return 1;
+    };
+
+    // Look for the disjunction that binds the overload set.
+    for (auto constraint : constraints) {
+      if (constraint->getKind() != ConstraintKind::Disjunction)
+        continue;
+
+      auto choices = constraint->getNestedConstraints();
+      if (choices[0]->getKind() != ConstraintKind::BindOverload)
+        continue;
+
+      SmallVector<Constraint *, 8> mismatched;
+      bool anyViable = false;
+      for (auto choice : choices) {
+        if (choice->isDisabled())
+          continue;
+        if (choice->getKind() != ConstraintKind::BindOverload ||
+            !choice->getOverloadChoice().isDecl()) {
+          anyViable = true;
+          continue;
+        }
+
+        auto declArity = getArity(choice->getOverloadChoice().getDecl());
+        if (!declArity || *declArity == arity)
+          anyViable = true;
+        else
+          mismatched.push_back(choice);
+      }
+
+      // Prune only while at least one viable choice remains, so failure
+      // diagnostics still see the full overload set.
+      if (anyViable) {
+        for (auto choice : mismatched)
+          choice->setDisabled();
+      }
+      break;
+    }
+  }
+
   /// Favor binary operator constraints where we have exact matches
   /// for the operands and contextual type.
   void favorMatchingBinaryOperators(ApplyExpr *expr,
@@ -907,8 +987,10 @@ namespace {
       if (auto applyExpr = dyn_cast<ApplyExpr>(expr)) {
         if (isa<PrefixUnaryExpr>(applyExpr) ||
             isa<PostfixUnaryExpr>(applyExpr)) {
+          pruneOperatorOverloadsByArity(applyExpr, CS, /*arity=*/1);
           favorMatchingUnaryOperators(applyExpr, CS);
         } else if (isa<BinaryExpr>(applyExpr)) {
+          pruneOperatorOverloadsByArity(applyExpr, CS, /*arity=*/2);
           favorMatchingBinaryOperators(applyExpr, CS);
         } else {
           favorMatchingOverloadExprs(applyExpr, CS);
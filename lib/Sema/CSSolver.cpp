@@ -17,10 +17,12 @@
 #include "ConstraintGraph.h"
 #include "swift/AST/ParameterList.h"
 #include "swift/AST/TypeWalker.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include <algorithm>
 #include <memory>
 #include <tuple>
 
@@ -416,6 +418,43 @@ void truncate(SmallVectorImpl<T> &vec, unsigned newSize) {
 
 } // end anonymous namespace
 
+/// Compute a fingerprint summarizing the shape of the given expression: its
+/// tree of expression kinds together with the names and declarations it
+/// references, independent of source locations. Structurally identical
+/// expressions in different primary files produce the same fingerprint
+/// within a single frontend instance.
+static uint64_t computeExprShapeFingerprint(Expr *expr, ConstraintSystem &cs) {
+  class ShapeWalker : public ASTWalker {
+  public:
+    llvm::hash_code Hash = llvm::hash_value(0u);
+
+    std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
+      Hash = llvm::hash_combine(Hash, unsigned(E->getKind()));
+      if (auto *declRef = dyn_cast<DeclRefExpr>(E)) {
+        Hash = llvm::hash_combine(Hash, declRef->getDecl());
+      } else if (auto *unresolved = dyn_cast<UnresolvedDeclRefExpr>(E)) {
+        Hash = llvm::hash_combine(Hash,
+                                  unresolved->getName().getOpaqueValue());
+      } else if (auto *dot = dyn_cast<UnresolvedDotExpr>(E)) {
+        Hash = llvm::hash_combine(Hash, dot->getName().getOpaqueValue());
+      } else if (auto *overloaded = dyn_cast<OverloadedDeclRefExpr>(E)) {
+        for (auto *decl : overloaded->getDecls())
+          Hash = llvm::hash_combine(Hash, decl);
+      }
+      return { true, E };
+    }
+  };
+
+  ShapeWalker walker;
+  expr->walk(walker);
+
+  auto hash = walker.Hash;
+  if (auto contextualType = cs.getContextualType())
+    hash = llvm::hash_combine(hash,
+                              contextualType->getCanonicalType().getPointer());
+  return hash;
+}
+
 ConstraintSystem::SolverState::SolverState(Expr *const expr,
                                            ConstraintSystem &cs)
     : CS(cs) {
@@ -423,9 +462,19 @@ ConstraintSystem::SolverState::SolverState(Expr *const expr,
          "Constraint system should not already have solver state!");
   CS.solverState = this;
 
-  if (expr)
+  if (expr) {
     ExprWeights = expr->getDepthMap();
 
+    // If an expression with the same shape has been solved (or partially
+    // solved) before, prime disjunction exploration with the overload
+    // choices it used. This covers both the primary solve and the salvage
+    // pass, which sets up its own solver state for the same expression.
+    ShapeFingerprint = computeExprShapeFingerprint(expr, CS);
+    auto known = CS.TC.SolvedShapeOverloads.find(*ShapeFingerprint);
+    if (known != CS.TC.SolvedShapeOverloads.end())
+      OverloadChoiceHints.insert(known->second.begin(), known->second.end());
+  }
+
   ++NumSolutionAttempts;
   SolutionAttempt = NumSolutionAttempts;
 
@@ -1413,7 +1462,23 @@ bool ConstraintSystem::solve(Expr *const expr,
     filterSolutions(solutions, state.ExprWeights);
 
   // We fail if there is no solution.
-  return solutions.empty();
+  if (solutions.empty())
+    return true;
+
+  // Record the overload choices of the best solution so that later solves
+  // of the same shape explore them first. Even a solution set that the
+  // caller goes on to reject as too complex or ambiguous is a useful
+  // starting point when the same expression is retried, e.g. by the
+  // diagnostic salvage pass.
+  if (state.ShapeFingerprint && !solutions.empty()) {
+    auto &recorded = TC.SolvedShapeOverloads[*state.ShapeFingerprint];
+    recorded.clear();
+    for (const auto &entry : solutions.front().overloadChoices) {
+      if (entry.second.choice.isDecl())
+        recorded.push_back(entry.second.choice.getDecl());
+    }
+  }
+  return false;
 }
 
 bool ConstraintSystem::solveRec(SmallVectorImpl<Solution> &solutions,
@@ -1907,8 +1972,39 @@ bool ConstraintSystem::solveSimplified(
 
   ++solverState->NumDisjunctions;
   auto constraints = disjunction->getNestedConstraints();
+
+  // Wide disjunctions are the pathological case for search time, since each
+  // extra choice multiplies the space below it. Order the exploration so
+  // that the choices most likely to produce a cheap solution come first:
+  // overloads recorded from an identically-shaped expression, then favored
+  // choices. Generic operator overloads go last, so that a non-generic
+  // solution is usually in hand by the time shouldSkipDisjunctionChoice()
+  // can use it to prune them.
+  SmallVector<unsigned, 8> exploreOrder;
+  for (auto index : indices(constraints))
+    exploreOrder.push_back(index);
+  auto &choiceHints = solverState->OverloadChoiceHints;
+  auto rankChoice = [&](unsigned index) -> unsigned {
+    auto *constraint = constraints[index];
+    if (constraint->getKind() == ConstraintKind::BindOverload) {
+      auto choice = constraint->getOverloadChoice();
+      if (choice.isDecl() && choiceHints.count(choice.getDecl()))
+        return 0;
+    }
+    if (constraint->isFavored())
+      return 1;
+    if (DisjunctionChoice(this, disjunction, constraint)
+            .isGenericOperatorOrUnavailable())
+      return 3;
+    return 2;
+  };
+  std::stable_sort(exploreOrder.begin(), exploreOrder.end(),
+                   [&](unsigned lhs, unsigned rhs) {
+    return rankChoice(lhs) < rankChoice(rhs);
+  });
+
   // Try each of the constraints within the disjunction.
-  for (auto index : indices(constraints)) {
+  for (auto index : exploreOrder) {
     auto currentChoice =
         DisjunctionChoice(this, disjunction, constraints[index]);
     if (shouldSkipDisjunctionChoice(*this, currentChoice, bestNonGenericScore))
@@ -61,6 +61,7 @@ ConstraintGraph::lookupNode(TypeVariableType *typeVar) {
 
   // Record this type variable.
   TypeVariables.push_back(typeVar);
+  markTopologyChanged();
 
   // Record the change, if there are active scopes.
   if (ActiveScope)
@@ -303,6 +304,7 @@ void ConstraintGraph::Change::undo(ConstraintGraph &cg) {
     node.EquivalenceClass.erase(
       node.EquivalenceClass.begin() + EquivClass.PrevSize,
       node.EquivalenceClass.end());
+    cg.markTopologyChanged();
     break;
    }
 
@@ -326,6 +328,7 @@ void ConstraintGraph::removeNode(TypeVariableType *typeVar) {
   if (index < lastIndex)
     TypeVariables[index] = TypeVariables[lastIndex];
   TypeVariables.pop_back();
+  markTopologyChanged();
 }
 
 void ConstraintGraph::addConstraint(Constraint *constraint) {
@@ -355,6 +358,8 @@ void ConstraintGraph::addConstraint(Constraint *constraint) {
     OrphanedConstraints.push_back(constraint);
   }
 
+  markTopologyChanged();
+
   // Record the change, if there are active scopes.
   if (ActiveScope)
     Changes.push_back(Change::addedConstraint(constraint));
@@ -391,6 +396,8 @@ void ConstraintGraph::removeConstraint(Constraint *constraint) {
     OrphanedConstraints.pop_back();
   }
 
+  markTopologyChanged();
+
   // Record the change, if there are active scopes.
   if (ActiveScope)
     Changes.push_back(Change::removedConstraint(constraint));
@@ -419,6 +426,7 @@ void ConstraintGraph::mergeNodes(TypeVariableType *typeVar1,
   // Merge equivalence class from the non-representative type variable.
   auto &nonRepNode = (*this)[typeVarNonRep];
   repNode.addToEquivalenceClass(nonRepNode.getEquivalenceClassUnsafe());
+  markTopologyChanged();
 }
 
 void ConstraintGraph::bindTypeVariable(TypeVariableType *typeVar, Type fixed) {
@@ -438,6 +446,7 @@ void ConstraintGraph::bindTypeVariable(TypeVariableType *typeVar, Type fixed) {
       node.addFixedBinding(otherTypeVar);
     }
   }
+  markTopologyChanged();
 
   // Record the change, if there are active scopes.
   // Note: If we ever use this to undo the actual variable binding,
@@ -461,6 +470,7 @@ void ConstraintGraph::unbindTypeVariable(TypeVariableType *typeVar, Type fixed){
       node.removeFixedBinding(otherTypeVar);
     }
   }
+  markTopologyChanged();
 }
 
 void ConstraintGraph::gatherConstraints(
@@ -564,28 +574,45 @@ unsigned ConstraintGraph::computeConnectedComponents(
   // Initialize the components with component == # of type variables,
   // a sentinel value indicating
   unsigned numTypeVariables = TypeVariables.size();
-  components.assign(numTypeVariables, numTypeVariables);
-
-  // Perform a depth-first search from each type variable to identify
-  // what component it is in.
   unsigned numComponents = 0;
-  for (unsigned i = 0; i != numTypeVariables; ++i) {
-    auto typeVar = TypeVariables[i];
 
-    // Look up the node for this type variable.
-    auto nodeAndIndex = lookupNode(typeVar);
+  // If the graph's topology has not changed since the last time the
+  // component assignment was computed, reuse it rather than repeating the
+  // depth-first search. The filtering below still runs, since it depends on
+  // which type variables currently have fixed types.
+  if (CachedComponentsGeneration == TopologyGeneration &&
+      CachedComponents.size() == numTypeVariables) {
+    components.assign(CachedComponents.begin(), CachedComponents.end());
+    numComponents = CachedNumComponents;
+    if (CS.solverState)
+      ++CS.solverState->NumComponentRecomputationsAvoided;
+  } else {
+    components.assign(numTypeVariables, numTypeVariables);
 
-    // If we're already assigned a component for this node, skip it.
-    unsigned &curComponent = components[nodeAndIndex.second];
-    if (curComponent != numTypeVariables)
-      continue;
+    // Perform a depth-first search from each type variable to identify
+    // what component it is in.
+    for (unsigned i = 0; i != numTypeVariables; ++i) {
+      auto typeVar = TypeVariables[i];
 
-    // Record this component.
-    unsigned component = numComponents++;
+      // Look up the node for this type variable.
+      auto nodeAndIndex = lookupNode(typeVar);
+
+      // If we're already assigned a component for this node, skip it.
+      unsigned &curComponent = components[nodeAndIndex.second];
+      if (curComponent != numTypeVariables)
+        continue;
+
+      // Record this component.
+      unsigned component = numComponents++;
+
+      // Note that this node is part of this component, then visit it.
+      curComponent = component;
+      connectedComponentsDFS(*this, nodeAndIndex.first, component, components);
+    }
 
-    // Note that this node is part of this component, then visit it.
-    curComponent = component;
-    connectedComponentsDFS(*this, nodeAndIndex.first, component, components);
+    CachedComponents.assign(components.begin(), components.end());
+    CachedNumComponents = numComponents;
+    CachedComponentsGeneration = TopologyGeneration;
   }
 
   // Figure out which components have unbound type variables; these
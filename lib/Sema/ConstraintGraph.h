@@ -332,6 +332,26 @@ private:
   /// Constraints that are "orphaned" because they contain no type variables.
   SmallVector<Constraint *, 4> OrphanedConstraints;
 
+  /// A generation count bumped by every mutation that can affect the
+  /// graph's connected components. Used to decide whether the cached
+  /// component assignment may be reused by computeConnectedComponents().
+  unsigned TopologyGeneration = 1;
+
+  /// The topology generation at which \c CachedComponents was computed, or
+  /// zero if no assignment has been cached yet.
+  unsigned CachedComponentsGeneration = 0;
+
+  /// The cached component number for each entry of \c TypeVariables, before
+  /// filtering out components without unbound type variables.
+  SmallVector<unsigned, 16> CachedComponents;
+
+  /// The number of components described by \c CachedComponents.
+  unsigned CachedNumComponents = 0;
+
+  /// Note that the graph's topology has changed, invalidating the cached
+  /// connected-component assignment.
+  void markTopologyChanged() { ++TopologyGeneration; }
+
   /// The kind of change made to the graph.
   enum class ChangeKind {
     /// Added a type variable.
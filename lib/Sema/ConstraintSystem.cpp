@@ -68,13 +68,16 @@ ExpressionTimer::~ExpressionTimer() {
 ConstraintSystem::ConstraintSystem(TypeChecker &tc, DeclContext *dc,
                                    ConstraintSystemOptions options)
   : TC(tc), DC(dc), Options(options),
+    Allocator(tc.getSolverMemory()),
     Arena(tc.Context, Allocator),
     CG(*new ConstraintGraph(*this))
 {
   assert(DC && "context required");
+  TC.incrementActiveConstraintSystems();
 }
 
 ConstraintSystem::~ConstraintSystem() {
+  TC.decrementActiveConstraintSystems();
   delete &CG;
 }
 
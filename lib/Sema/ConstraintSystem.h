@@ -906,7 +906,12 @@ public:
 private:
 
   /// \brief Allocator used for all of the related constraint systems.
-  llvm::BumpPtrAllocator Allocator;
+  ///
+  /// This refers to the type checker's shared solver memory, so the slabs
+  /// backing constraint and locator allocations are reused across the
+  /// expressions of a function body rather than freed per expression.
+  /// \sa TypeChecker::getSolverMemory()
+  llvm::BumpPtrAllocator &Allocator;
 
   /// \brief Arena used for memory management of constraint-checker-related
   /// allocations.
@@ -1126,6 +1131,15 @@ private:
      /// The best solution computed so far.
     Optional<Score> BestScore;
 
+    /// The shape fingerprint of the expression being solved, if any.
+    /// \sa TypeChecker::SolvedShapeOverloads
+    Optional<uint64_t> ShapeFingerprint;
+
+    /// Overload choices recorded the last time an expression with the same
+    /// shape fingerprint was solved, used to order disjunction exploration.
+    /// \sa TypeChecker::SolvedShapeOverloads
+    llvm::SmallPtrSet<ValueDecl *, 16> OverloadChoiceHints;
+
     /// The number of the solution attempt we're looking at.
     unsigned SolutionAttempt;
 
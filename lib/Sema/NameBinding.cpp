@@ -317,9 +317,11 @@ void swift::performNameBinding(SourceFile &SF, unsigned StartElem) {
     return;
   }
 
-  // Reset the name lookup cache so we find new decls.
-  // FIXME: This is inefficient.
-  SF.clearLookupCache();
+  // Add any newly parsed decls to the name lookup cache in place of
+  // rebuilding it.  The cached visible-decl snapshot survives lines that do
+  // not introduce new names; addImports() below invalidates it when the
+  // import set changes.
+  SF.addParsedDeclsToLookupCache();
 
   NameBinder Binder(SF);
 
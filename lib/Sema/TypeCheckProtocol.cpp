@@ -5554,20 +5554,9 @@ void ConformanceChecker::checkConformance(MissingWitnessDiagnosisKind Kind) {
   // Ensure the associated type conformances are used.
   addUsedConformances(Conformance);
 
-  // Check non-type requirements.
-  for (auto member : Proto->getMembers()) {
-    auto requirement = dyn_cast<ValueDecl>(member);
-    if (!requirement)
-      continue;
-
-    // Associated type requirements handled above.
-    if (isa<TypeDecl>(requirement))
-      continue;
-
-    // Type aliases don't have requirements themselves.
-    if (!requirement->isProtocolRequirement())
-      continue;
-
+  // Check non-type requirements. The filtered requirement list is computed
+  // once per protocol and shared by all of its conformances.
+  for (auto *requirement : TC.getProtocolValueRequirements(Proto)) {
     /// Local function to finalize the witness.
     auto finalizeWitness = [&] {
       // Find the witness.
@@ -5676,11 +5665,6 @@ void ConformanceChecker::checkConformance(MissingWitnessDiagnosisKind Kind) {
       continue;
     }
 
-    // If this is a getter/setter for a funcdecl, ignore it.
-    if (auto *FD = dyn_cast<FuncDecl>(requirement))
-      if (FD->isAccessor())
-        continue;
-    
     // Try to resolve the witness via explicit definitions.
     switch (resolveWitnessViaLookup(requirement)) {
     case ResolveWitnessResult::Success:
@@ -6226,6 +6210,39 @@ void TypeChecker::checkConformance(NormalProtocolConformance *conformance) {
   checker.checkAllConformances();
 }
 
+ArrayRef<ValueDecl *>
+TypeChecker::getProtocolValueRequirements(ProtocolDecl *proto) {
+  auto known = ProtocolValueRequirements.find(proto);
+  if (known != ProtocolValueRequirements.end())
+    return known->second;
+
+  std::vector<ValueDecl *> requirements;
+  for (auto member : proto->getMembers()) {
+    auto requirement = dyn_cast<ValueDecl>(member);
+    if (!requirement)
+      continue;
+
+    // Type witnesses are resolved separately.
+    if (isa<TypeDecl>(requirement))
+      continue;
+
+    // Type aliases don't have requirements themselves.
+    if (!requirement->isProtocolRequirement())
+      continue;
+
+    // Accessors are checked as part of their storage.
+    if (auto *FD = dyn_cast<FuncDecl>(requirement))
+      if (FD->isAccessor())
+        continue;
+
+    requirements.push_back(requirement);
+  }
+
+  auto &entry = ProtocolValueRequirements[proto];
+  entry = std::move(requirements);
+  return entry;
+}
+
 /// Determine the score when trying to match two identifiers together.
 static unsigned scoreIdentifiers(Identifier lhs, Identifier rhs,
                                  unsigned limit) {
@@ -428,7 +428,10 @@ void REPLChecker::processREPLTopLevelPatternBinding(PatternBindingDecl *PBD) {
 /// pattern bindings the are evaluated.
 void TypeChecker::processREPLTopLevel(SourceFile &SF, TopLevelContext &TLC,
                                       unsigned FirstDecl) {
-  // Move new declarations out.
+  // Move new declarations out.  Unindex them from the lookup cache first;
+  // they are added back below, interleaved with any synthesized printing
+  // code, and reindexed at the end.
+  SF.truncateDeclsInLookupCache(FirstDecl);
   std::vector<Decl *> NewDecls(SF.Decls.begin()+FirstDecl, SF.Decls.end());
   SF.Decls.resize(FirstDecl);
 
@@ -454,5 +457,7 @@ void TypeChecker::processREPLTopLevel(SourceFile &SF, TopLevelContext &TLC,
   }
 
   contextualizeTopLevelCode(TLC, llvm::makeArrayRef(SF.Decls).slice(FirstDecl));
+
+  SF.addParsedDeclsToLookupCache();
 }
 
@@ -658,8 +658,9 @@ void swift::performTypeChecking(SourceFile &SF, TopLevelContext &TLC,
 
   {
     SharedTimer timer("AST verification");
-    // Verify the SourceFile.
-    verify(SF);
+    // Verify the SourceFile. Declarations before StartElem were verified
+    // when they were originally type checked.
+    verify(SF, StartElem);
 
     // Verify imported modules.
 #ifndef NDEBUG
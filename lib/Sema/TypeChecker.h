@@ -32,8 +32,16 @@
 #include "swift/Config.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/TinyPtrVector.h"
+#include "llvm/Support/Allocator.h"
 #include <functional>
 
+/// Define this to 1 to release recycled constraint-solver memory back to
+/// the system instead of reusing the slabs. Stale pointers into solver
+/// memory then point at freed storage, which AddressSanitizer (or malloc
+/// scribbling) will flag, instead of at plausible-looking recycled
+/// allocations.
+#define SWIFT_POISON_SOLVER_MEMORY 0
+
 namespace swift {
 
 class GenericSignatureBuilder;
@@ -779,6 +787,15 @@ public:
   /// computed.
   llvm::DenseMap<AnyFunctionRef, std::vector<Expr*>> LocalCFunctionPointers;
 
+  /// Overload choices recorded the last time an expression with a given
+  /// shape fingerprint was solved. Trivial operator expressions repeat with
+  /// identical shapes throughout a module; when such an expression recurs,
+  /// the constraint solver uses the recorded choices to order its
+  /// disjunction exploration so the previously successful overloads are
+  /// attempted first. This only affects exploration order, never the set of
+  /// solutions found. See ConstraintSystem::solve().
+  llvm::DenseMap<uint64_t, std::vector<ValueDecl *>> SolvedShapeOverloads;
+
 private:
   /// Return statements with functions as return values.
   llvm::DenseMap<AbstractFunctionDecl *, llvm::DenseSet<ReturnStmt *>>
@@ -791,7 +808,48 @@ private:
   /// The # of times we have performed typo correction.
   unsigned NumTypoCorrections = 0;
 
+  /// The non-type value requirements of each protocol, filtered once and
+  /// then reused while checking every conformance to that protocol.
+  llvm::DenseMap<ProtocolDecl *, std::vector<ValueDecl *>>
+    ProtocolValueRequirements;
+
+  /// Slab storage shared by the constraint systems created while checking a
+  /// single function body. Constraint, locator, and temporary type
+  /// allocations are bump-allocated here; the slabs are reused across the
+  /// expressions of a body instead of being freed after each one.
+  llvm::BumpPtrAllocator SolverMemory;
+
+  /// The number of constraint systems currently alive, used to determine
+  /// when \c SolverMemory may safely be reset.
+  unsigned NumActiveConstraintSystems = 0;
+
 public:
+  /// Retrieve the slab storage shared by all constraint systems.
+  llvm::BumpPtrAllocator &getSolverMemory() { return SolverMemory; }
+
+  /// Note that a constraint system drawing from the shared solver memory
+  /// has been created or destroyed.
+  void incrementActiveConstraintSystems() { ++NumActiveConstraintSystems; }
+  void decrementActiveConstraintSystems() {
+    assert(NumActiveConstraintSystems > 0 && "unbalanced constraint systems");
+    --NumActiveConstraintSystems;
+  }
+
+  /// Recycle the shared solver memory so the next function body can reuse
+  /// it. Has no effect while any constraint system is alive.
+  void resetSolverMemoryIfIdle() {
+    if (NumActiveConstraintSystems == 0) {
+#if SWIFT_POISON_SOLVER_MEMORY
+      // Hand every slab back rather than recycling, so escapes from the
+      // solver arena are catchable as uses of freed memory. Note that
+      // BumpPtrAllocator::Reset() already ASan-poisons the retained slab,
+      // so plain asan builds catch most escapes without this.
+      SolverMemory = llvm::BumpPtrAllocator();
+#else
+      SolverMemory.Reset();
+#endif
+    }
+  }
   /// Record an occurrence of a function that captures inout values as an
   /// argument.
   ///
@@ -2042,6 +2100,11 @@ public:
   /// Completely check the given conformance.
   void checkConformance(NormalProtocolConformance *conformance);
 
+  /// Retrieve the non-type value requirements of the given protocol,
+  /// excluding accessors. The result is computed once per protocol and
+  /// shared by all of its conformances.
+  ArrayRef<ValueDecl *> getProtocolValueRequirements(ProtocolDecl *proto);
+
   /// Check all of the conformances in the given context.
   void checkConformancesInContext(DeclContext *dc,
                                   IterableDeclContext *idc);
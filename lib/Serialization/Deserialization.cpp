@@ -2322,9 +2322,11 @@ ModuleFile::getDeclCheckedImpl(DeclID DID, Optional<DeclContext *> ForcedContext
 
       case decls_block::Semantics_DECL_ATTR: {
         bool isImplicit;
+        IdentifierID valueID;
         serialization::decls_block::SemanticsDeclAttrLayout::readRecord(
-            scratch, isImplicit);
-        Attr = new (ctx) SemanticsAttr(blobData, isImplicit);
+            scratch, isImplicit, valueID);
+        Attr = new (ctx) SemanticsAttr(getIdentifier(valueID).str(),
+                                       isImplicit);
         break;
       }
 
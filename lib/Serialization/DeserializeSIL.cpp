@@ -26,6 +26,7 @@
 
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/OnDiskHashTable.h"
 
@@ -37,6 +38,17 @@ using namespace swift::serialization::sil_block;
 using namespace llvm::support;
 
 STATISTIC(NumDeserializedFunc, "Number of deserialized SIL functions");
+STATISTIC(NumSkippedFuncBodies,
+          "Number of SIL function bodies skipped due to the body limit");
+
+/// If non-zero, bodies of available-externally functions larger than this
+/// many instructions are deserialized as declarations. The external copy of
+/// such a function is used anyway, so this only limits what the optimizer
+/// can see. Experimental; off by default.
+static llvm::cl::opt<unsigned> SILDeserializeBodyLimit(
+    "sil-deserialize-body-limit", llvm::cl::init(0),
+    llvm::cl::desc("If non-zero, do not deserialize available-externally "
+                   "function bodies with more instructions than this limit"));
 
 static Optional<StringLiteralInst::Encoding>
 fromStableStringEncoding(unsigned value) {
@@ -408,12 +420,13 @@ SILFunction *SILDeserializer::readSILFunction(DeclID FID,
   GenericEnvironmentID genericEnvID;
   unsigned rawLinkage, isTransparent, isSerialized, isThunk, isGlobal,
       inlineStrategy, optimizationMode, effect, numSpecAttrs,
-      hasQualifiedOwnership;
+      hasQualifiedOwnership, numInstructions;
   ArrayRef<uint64_t> SemanticsIDs;
   SILFunctionLayout::readRecord(scratch, rawLinkage, isTransparent, isSerialized,
                                 isThunk, isGlobal, inlineStrategy,
                                 optimizationMode, effect,
-                                numSpecAttrs, hasQualifiedOwnership, funcTyID,
+                                numSpecAttrs, hasQualifiedOwnership,
+                                numInstructions, funcTyID,
                                 genericEnvID, clangNodeOwnerID, SemanticsIDs);
 
   if (funcTyID == 0) {
@@ -489,6 +502,19 @@ SILFunction *SILDeserializer::readSILFunction(DeclID FID,
   assert(fn->empty() &&
          "SILFunction to be deserialized starts being empty.");
 
+  // If a body limit is in effect, treat oversized bodies as declarations.
+  // This is only legal for available-externally functions, whose external
+  // copy is referenced anyway; transparent functions must be inlined and
+  // generic bodies may still be needed by the specializer, so both keep
+  // their bodies. The cache entry is not marked fully deserialized, so a
+  // later explicit request can still read the body.
+  if (SILDeserializeBodyLimit != 0 && !declarationOnly &&
+      fn->isAvailableExternally() && !isTransparent && !fn->isTransparent() &&
+      genericEnvID == 0 && numInstructions > SILDeserializeBodyLimit) {
+    NumSkippedFuncBodies++;
+    declarationOnly = true;
+  }
+
   fn->setBare(IsBare);
   const SILDebugScope *DS = fn->getDebugScope();
   if (!DS) {
@@ -2377,12 +2403,13 @@ bool SILDeserializer::hasSILFunction(StringRef Name,
   GenericEnvironmentID genericEnvID;
   unsigned rawLinkage, isTransparent, isSerialized, isThunk, isGlobal,
     inlineStrategy, optimizationMode, effect, numSpecAttrs,
-    hasQualifiedOwnership;
+    hasQualifiedOwnership, numInstructions;
   ArrayRef<uint64_t> SemanticsIDs;
   SILFunctionLayout::readRecord(scratch, rawLinkage, isTransparent, isSerialized,
                                 isThunk, isGlobal, inlineStrategy,
                                 optimizationMode, effect,
-                                numSpecAttrs, hasQualifiedOwnership, funcTyID,
+                                numSpecAttrs, hasQualifiedOwnership,
+                                numInstructions, funcTyID,
                                 genericEnvID, clangOwnerID, SemanticsIDs);
   auto linkage = fromStableSILLinkage(rawLinkage);
   if (!linkage) {
@@ -222,6 +222,9 @@ validateControlBlock(llvm::BitstreamCursor &cursor,
     case control_block::TARGET:
       result.targetTriple = blobData;
       break;
+    case control_block::CONTENT_HASH:
+      result.contentHash = blobData;
+      break;
     default:
       // Unknown metadata record, possibly for use by a future version of the
       // module format.
@@ -790,20 +793,16 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
 
       switch (kind) {
       case index_block::DECL_OFFSETS:
-        assert(blobData.empty());
-        Decls.assign(scratch.begin(), scratch.end());
+        Decls.setRawData(blobData);
         break;
       case index_block::DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        DeclContexts.assign(scratch.begin(), scratch.end());
+        DeclContexts.setRawData(blobData);
         break;
       case index_block::TYPE_OFFSETS:
-        assert(blobData.empty());
-        Types.assign(scratch.begin(), scratch.end());
+        Types.setRawData(blobData);
         break;
       case index_block::IDENTIFIER_OFFSETS:
-        assert(blobData.empty());
-        Identifiers.assign(scratch.begin(), scratch.end());
+        Identifiers.setRawData(blobData);
         break;
       case index_block::TOP_LEVEL_DECLS:
         TopLevelDecls = readDeclTable(scratch, blobData);
@@ -840,24 +839,19 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
         DeclMemberNames = readDeclMemberNamesTable(scratch, blobData);
         break;
       case index_block::LOCAL_DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        LocalDeclContexts.assign(scratch.begin(), scratch.end());
+        LocalDeclContexts.setRawData(blobData);
         break;
       case index_block::GENERIC_SIGNATURE_OFFSETS:
-        assert(blobData.empty());
-        GenericSignatures.assign(scratch.begin(), scratch.end());
+        GenericSignatures.setRawData(blobData);
         break;
       case index_block::GENERIC_ENVIRONMENT_OFFSETS:
-        assert(blobData.empty());
-        GenericEnvironments.assign(scratch.begin(), scratch.end());
+        GenericEnvironments.setRawData(blobData);
         break;
       case index_block::NORMAL_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        NormalConformances.assign(scratch.begin(), scratch.end());
+        NormalConformances.setRawData(blobData);
         break;
       case index_block::SIL_LAYOUT_OFFSETS:
-        assert(blobData.empty());
-        SILLayouts.assign(scratch.begin(), scratch.end());
+        SILLayouts.setRawData(blobData);
         break;
 
       default:
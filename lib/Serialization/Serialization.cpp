@@ -50,6 +50,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
 #include "llvm/Support/Path.h"
@@ -737,6 +738,7 @@ void Serializer::writeBlockInfoBlock() {
   BLOCK_RECORD(control_block, METADATA);
   BLOCK_RECORD(control_block, MODULE_NAME);
   BLOCK_RECORD(control_block, TARGET);
+  BLOCK_RECORD(control_block, CONTENT_HASH);
 
   BLOCK(OPTIONS_BLOCK);
   BLOCK_RECORD(options_block, SDK_PATH);
@@ -902,6 +904,18 @@ void Serializer::writeHeader(const SerializationOptions &options) {
 
     Target.emit(ScratchRecord, M->getASTContext().LangOpts.Target.str());
 
+    // Emit a zero-filled placeholder for the content hash; the real digest
+    // isn't known until every other record has been written, at which point
+    // patchContentHash() overwrites these bytes in place. Blobs are
+    // byte-aligned, so the placeholder occupies the last bytes of the
+    // buffer once the record is emitted.
+    {
+      control_block::ContentHashLayout ContentHash(Out);
+      char zeroes[sizeof(llvm::MD5::MD5Result)] = {};
+      ContentHash.emit(ScratchRecord, StringRef(zeroes, sizeof(zeroes)));
+      ContentHashOffset = Buffer.size() - sizeof(zeroes);
+    }
+
     {
       llvm::BCBlockRAII restoreBlock(Out, OPTIONS_BLOCK_ID, 4);
 
@@ -2217,9 +2231,13 @@ void Serializer::writeDeclAttribute(const DeclAttribute *DA) {
   case DAK_Semantics: {
     auto *theAttr = cast<SemanticsAttr>(DA);
     auto abbrCode = DeclTypeAbbrCodes[SemanticsDeclAttrLayout::Code];
+    // Route the value through the identifier table; the same semantics
+    // string is commonly attached to many decls, and this stores it once.
+    auto valueID = addDeclBaseNameRef(
+        M->getASTContext().getIdentifier(theAttr->Value));
     SemanticsDeclAttrLayout::emitRecord(Out, ScratchRecord, abbrCode,
                                       theAttr->isImplicit(),
-                                      theAttr->Value);
+                                      valueID);
     return;
   }
 
@@ -4034,7 +4052,18 @@ void Serializer::writeAllIdentifiers() {
 
 void Serializer::writeOffsets(const index_block::OffsetsLayout &Offsets,
                               const std::vector<BitOffset> &values) {
-  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), values);
+  // Store the offsets as fixed-width little-endian values in a blob rather
+  // than as record elements, so the reader can populate its offset vectors
+  // with a straight copy out of the mmapped buffer instead of decoding one
+  // scalar at a time.
+  llvm::SmallString<2048> blob;
+  {
+    llvm::raw_svector_ostream blobStream(blob);
+    endian::Writer<little> writer(blobStream);
+    for (auto offset : values)
+      writer.write<uint32_t>(static_cast<uint32_t>(offset));
+  }
+  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), blob.str());
 }
 
 /// Writes an in-memory decl table to an on-disk representation, using the
@@ -4866,6 +4895,18 @@ void Serializer::writeToStream(raw_ostream &os) {
   os.flush();
 }
 
+void Serializer::patchContentHash() {
+  assert(ContentHashOffset != 0 && "writeHeader was never called");
+  llvm::MD5 hash;
+  auto hashedBegin = ContentHashOffset + sizeof(llvm::MD5::MD5Result);
+  hash.update(StringRef(Buffer.data() + hashedBegin,
+                        Buffer.size() - hashedBegin));
+  llvm::MD5::MD5Result digest;
+  hash.final(digest);
+  std::copy(digest.Bytes.begin(), digest.Bytes.end(),
+            Buffer.begin() + ContentHashOffset);
+}
+
 template <size_t N>
 Serializer::Serializer(const unsigned char (&signature)[N],
                        ModuleOrSourceFile DC) {
@@ -4889,10 +4930,12 @@ void Serializer::writeToStream(raw_ostream &os, ModuleOrSourceFile DC,
     BCBlockRAII moduleBlock(S.Out, MODULE_BLOCK_ID, 2);
     S.writeHeader(options);
     S.writeInputBlock(options);
-    S.writeSIL(SILMod, options.SerializeAllSIL);
+    S.writeSIL(SILMod, options.SerializeAllSIL,
+               options.SerializePublicSILDeclarations);
     S.writeAST(DC, options.EnableNestedTypeLookupTable);
   }
 
+  S.patchContentHash();
   S.writeToStream(os);
 }
 
@@ -4920,6 +4963,18 @@ void Serializer::writeDocToStream(raw_ostream &os, ModuleOrSourceFile DC,
   S.writeToStream(os);
 }
 
+/// Returns true if \p contents matches the file at \p outputPath byte for
+/// byte, in which case the output need not be rewritten at all. Leaving the
+/// file untouched preserves its modification time, so dependency-driven
+/// build systems can skip downstream jobs such as merging modules.
+static bool existingOutputMatches(StringRef outputPath, StringRef contents) {
+  auto existing = llvm::MemoryBuffer::getFile(outputPath, /*FileSize=*/-1,
+                                              /*RequiresNullTerminator=*/false);
+  if (!existing)
+    return false;
+  return (*existing)->getBuffer() == contents;
+}
+
 static inline bool
 withOutputFile(ASTContext &ctx, StringRef outputPath,
                llvm::function_ref<void(raw_ostream &)> action){
@@ -4975,20 +5030,39 @@ void swift::serialize(ModuleOrSourceFile DC,
     return;
   }
 
-  bool hadError = withOutputFile(getContext(DC), options.OutputPath,
-                                 [&](raw_ostream &out) {
+  // Serialize into memory first so that an unchanged module file can be left
+  // untouched without paying for a temporary file write. This is the common
+  // case for incremental rebuilds that do not change a file's interface.
+  llvm::SmallString<0> moduleContents;
+  {
     SharedTimer timer("Serialization, swiftmodule");
-    Serializer::writeToStream(out, DC, M, options);
-  });
-  if (hadError)
-    return;
+    llvm::raw_svector_ostream stream(moduleContents);
+    Serializer::writeToStream(stream, DC, M, options);
+  }
+
+  if (!existingOutputMatches(options.OutputPath, moduleContents)) {
+    bool hadError = withOutputFile(getContext(DC), options.OutputPath,
+                                   [&](raw_ostream &out) {
+      out << moduleContents;
+    });
+    if (hadError)
+      return;
+  }
 
   if (options.DocOutputPath && options.DocOutputPath[0] != '\0') {
-    (void)withOutputFile(getContext(DC), options.DocOutputPath,
-                         [&](raw_ostream &out) {
+    llvm::SmallString<0> docContents;
+    {
       SharedTimer timer("Serialization, swiftdoc");
-      Serializer::writeDocToStream(out, DC, options.GroupInfoPath,
+      llvm::raw_svector_ostream stream(docContents);
+      Serializer::writeDocToStream(stream, DC, options.GroupInfoPath,
                                    getContext(DC));
-    });
+    }
+
+    if (!existingOutputMatches(options.DocOutputPath, docContents)) {
+      (void)withOutputFile(getContext(DC), options.DocOutputPath,
+                           [&](raw_ostream &out) {
+        out << docContents;
+      });
+    }
   }
 }
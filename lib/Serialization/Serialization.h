@@ -41,6 +41,10 @@ class Serializer {
   /// A reusable buffer for emitting records.
   SmallVector<uint64_t, 64> ScratchRecord;
 
+  /// The byte offset of the zero-filled content hash blob in \c Buffer, to
+  /// be patched with the real digest once every record has been written.
+  uint64_t ContentHashOffset = 0;
+
   /// The module currently being serialized.
   const ModuleDecl *M = nullptr;
 
@@ -403,7 +407,8 @@ private:
                     const std::vector<BitOffset> &values);
 
   /// Serializes all transparent SIL functions in the SILModule.
-  void writeSIL(const SILModule *M, bool serializeAllSIL);
+  void writeSIL(const SILModule *M, bool serializeAllSIL,
+                bool serializePublicDecls);
 
   /// Top-level entry point for serializing a module.
   void writeAST(ModuleOrSourceFile DC,
@@ -411,6 +416,10 @@ private:
 
   void writeToStream(raw_ostream &os);
 
+  /// Overwrites the zero-filled content hash emitted by \c writeHeader with
+  /// a digest of every byte serialized after it.
+  void patchContentHash();
+
   template <size_t N>
   Serializer(const unsigned char (&signature)[N], ModuleOrSourceFile DC);
 
@@ -205,6 +205,11 @@ namespace {
 
     bool ShouldSerializeAll;
 
+    /// Emit declaration-only records for public functions whose bodies are
+    /// not serialized, so clients can see their effects and semantics
+    /// attributes across the module boundary.
+    bool SerializePublicDeclarations;
+
     void addMandatorySILFunction(const SILFunction *F,
                                  bool emitDeclarationsForOnoneSupport);
     void addReferencedSILFunction(const SILFunction *F,
@@ -249,8 +254,10 @@ namespace {
 
   public:
     SILSerializer(Serializer &S, ASTContext &Ctx,
-                  llvm::BitstreamWriter &Out, bool serializeAll)
-      : S(S), Ctx(Ctx), Out(Out), ShouldSerializeAll(serializeAll) {}
+                  llvm::BitstreamWriter &Out, bool serializeAll,
+                  bool serializePublicDecls)
+      : S(S), Ctx(Ctx), Out(Out), ShouldSerializeAll(serializeAll),
+        SerializePublicDeclarations(serializePublicDecls) {}
 
     void writeSILModule(const SILModule *SILMod);
   };
@@ -385,14 +392,22 @@ void SILSerializer::writeSILFunction(const SILFunction &F, bool DeclOnly) {
     clangNodeOwnerID = S.addDeclRef(F.getClangNodeOwner());
 
   unsigned numSpecAttrs = NoBody ? 0 : F.getSpecializeAttrs().size();
+
+  // Record the size of the body up front so that clients can decide whether
+  // a function is worth deserializing without decoding its instructions.
+  unsigned numInstructions = 0;
+  if (!NoBody)
+    for (const SILBasicBlock &BB : F)
+      numInstructions += std::distance(BB.begin(), BB.end());
+
   SILFunctionLayout::emitRecord(
       Out, ScratchRecord, abbrCode, toStableSILLinkage(Linkage),
       (unsigned)F.isTransparent(), (unsigned)F.isSerialized(),
       (unsigned)F.isThunk(), (unsigned)F.isGlobalInit(),
       (unsigned)F.getInlineStrategy(), (unsigned)F.getOptimizationMode(),
       (unsigned)F.getEffectsKind(),
-      (unsigned)numSpecAttrs, (unsigned)F.hasQualifiedOwnership(), FnID,
-      genericEnvID, clangNodeOwnerID, SemanticsIDs);
+      (unsigned)numSpecAttrs, (unsigned)F.hasQualifiedOwnership(),
+      numInstructions, FnID, genericEnvID, clangNodeOwnerID, SemanticsIDs);
 
   if (NoBody)
     return;
@@ -2396,6 +2411,22 @@ void SILSerializer::writeSILBlock(const SILModule *SILMod) {
     }
   }
 
+  // If requested, also emit declarations for the remaining public functions.
+  // Their records carry no body but do carry the effects kind, semantics
+  // attributes, and inlining strategy, which gives the optimizer
+  // interprocedural facts about calls into this module without shipping
+  // the SIL itself.
+  if (SerializePublicDeclarations && !emitDeclarationsForOnoneSupport) {
+    for (const SILFunction &F : *SILMod) {
+      if (FuncsToEmit.count(&F) || F.isExternalDeclaration() ||
+          F.isAvailableExternally())
+        continue;
+      if (!hasPublicVisibility(F.getLinkage()))
+        continue;
+      writeSILFunction(F, /*DeclOnly*/ true);
+    }
+  }
+
   assert(Worklist.empty() && "Did not emit everything in worklist");
 }
 
@@ -2404,10 +2435,12 @@ void SILSerializer::writeSILModule(const SILModule *SILMod) {
   writeIndexTables();
 }
 
-void Serializer::writeSIL(const SILModule *SILMod, bool serializeAllSIL) {
+void Serializer::writeSIL(const SILModule *SILMod, bool serializeAllSIL,
+                          bool serializePublicDecls) {
   if (!SILMod)
     return;
 
-  SILSerializer SILSer(*this, M->getASTContext(), Out, serializeAllSIL);
+  SILSerializer SILSer(*this, M->getASTContext(), Out, serializeAllSIL,
+                       serializePublicDecls);
   SILSer.writeSILModule(SILMod);
 }
@@ -57,8 +57,14 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
                                  llvm::sys::fs::AccessMode::Exist);
   }
 
+  // The bitstream reader works off a sized buffer, so opt out of the null
+  // terminator; requiring one forces a full read of any module whose size
+  // is a multiple of the page size, while without it the file can always
+  // be mmapped and cold imports only fault in the pages they touch.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleOrErr =
-  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()));
+  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()),
+                              /*FileSize=*/-1,
+                              /*RequiresNullTerminator=*/false);
   if (!ModuleOrErr)
     return ModuleOrErr.getError();
 
@@ -67,7 +73,9 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
   Scratch.clear();
   llvm::sys::path::append(Scratch, DirName, ModuleDocFilename);
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleDocOrErr =
-  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()));
+  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()),
+                              /*FileSize=*/-1,
+                              /*RequiresNullTerminator=*/false);
   if (!ModuleDocOrErr &&
       ModuleDocOrErr.getError() != std::errc::no_such_file_or_directory) {
     return ModuleDocOrErr.getError();
@@ -109,6 +117,41 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
   llvm::SmallString<128> scratch;
   llvm::SmallString<128> currPath;
   isFramework = false;
+
+  // Candidates are probed by reading just their control block before any
+  // ModuleFile is constructed. A candidate built for another target or
+  // format version is set aside and the search continues, in case a later
+  // search path holds a compatible copy; if none does, the first
+  // incompatible candidate is surfaced so the normal loading path can
+  // diagnose it.
+  std::unique_ptr<llvm::MemoryBuffer> incompatibleModuleBuffer;
+  std::unique_ptr<llvm::MemoryBuffer> incompatibleModuleDocBuffer;
+  bool incompatibleIsFramework = false;
+  auto acceptCandidate = [&]() -> bool {
+    // An existence-only probe has nothing to validate.
+    if (!moduleBuffer || !*moduleBuffer)
+      return true;
+
+    switch (serialization::validateSerializedAST(
+                (*moduleBuffer)->getBuffer()).status) {
+    case serialization::Status::FormatTooOld:
+    case serialization::Status::FormatTooNew:
+    case serialization::Status::TargetIncompatible:
+    case serialization::Status::TargetTooNew:
+      if (!incompatibleModuleBuffer) {
+        incompatibleModuleBuffer = std::move(*moduleBuffer);
+        incompatibleModuleDocBuffer = std::move(*moduleDocBuffer);
+        incompatibleIsFramework = isFramework;
+      }
+      moduleBuffer->reset();
+      moduleDocBuffer->reset();
+      return false;
+    default:
+      // Valid, or a problem that full loading will diagnose in context.
+      return true;
+    }
+  };
+
   for (auto path : ctx.SearchPathOpts.ImportSearchPaths) {
     auto err = openModuleFiles(path,
                                moduleFilename.str(), moduleDocFilename.str(),
@@ -122,7 +165,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
                             moduleBuffer, moduleDocBuffer,
                             scratch);
     }
-    if (!err)
+    if (!err && acceptCandidate())
       return true;
   }
 
@@ -139,7 +182,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
                                  archFile.str(), archDocFile.str(),
                                  moduleBuffer, moduleDocBuffer,
                                  scratch);
-      return !err;
+      return !err && acceptCandidate();
     };
 
     for (const auto &framepath : ctx.SearchPathOpts.FrameworkSearchPaths) {
@@ -162,15 +205,27 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
     }
   }
 
-  // If we're not allowed to look in the runtime library import path, stop.
-  if (ctx.SearchPathOpts.SkipRuntimeLibraryImportPath)
-    return false;
+  // If we're allowed to look in the runtime library import path, do so.
+  if (!ctx.SearchPathOpts.SkipRuntimeLibraryImportPath) {
+    isFramework = false;
+    auto err = openModuleFiles(ctx.SearchPathOpts.RuntimeLibraryImportPath,
+                               moduleFilename.str(), moduleDocFilename.str(),
+                               moduleBuffer, moduleDocBuffer, scratch);
+    if (!err && acceptCandidate())
+      return true;
+  }
 
-  // Search the runtime import path.
-  isFramework = false;
-  return !openModuleFiles(ctx.SearchPathOpts.RuntimeLibraryImportPath,
-                          moduleFilename.str(), moduleDocFilename.str(),
-                          moduleBuffer, moduleDocBuffer, scratch);
+  // No compatible module anywhere. If some candidate was set aside as
+  // incompatible, hand it back so loading can diagnose why.
+  if (incompatibleModuleBuffer) {
+    if (moduleBuffer) {
+      *moduleBuffer = std::move(incompatibleModuleBuffer);
+      *moduleDocBuffer = std::move(incompatibleModuleDocBuffer);
+    }
+    isFramework = incompatibleIsFramework;
+    return true;
+  }
+  return false;
 }
 
 FileUnit *SerializedModuleLoader::loadAST(
@@ -43,6 +43,13 @@ static size_t swift_demangle_getDemangledName_Options(const char *MangledName,
 size_t swift_demangle_getDemangledName(const char *MangledName,
                                        char *OutputBuffer,
                                        size_t Length) {
+  // Common symbol shapes can be printed without building a node tree,
+  // which matters for high-volume symbolication. The fast path produces
+  // output identical to the options used below, or bows out.
+  if (size_t FastLength = swift::Demangle::fastDemangleSymbolAsString(
+          MangledName, OutputBuffer, Length))
+    return FastLength;
+
   swift::Demangle::DemangleOptions DemangleOptions;
   DemangleOptions.SynthesizeSugarOnTypes = true;
   return swift_demangle_getDemangledName_Options(MangledName, OutputBuffer,
@@ -0,0 +1,24 @@
+//===--- SyntaxArena.cpp - Arena for RawSyntax nodes ----------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Syntax/SyntaxArena.h"
+#include "swift/Syntax/RawSyntax.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+SyntaxArena::~SyntaxArena() {
+  // Run the destructors of all nodes in the arena; their memory is released
+  // with the allocator.
+  for (auto *Node : AllocatedNodes)
+    Node->~RawSyntax();
+}
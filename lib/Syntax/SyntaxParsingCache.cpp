@@ -0,0 +1,107 @@
+//===--- SyntaxParsingCache.cpp - Incremental syntax tree reuse -----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Syntax/SyntaxParsingCache.h"
+#include "swift/Syntax/RawSyntax.h"
+#include "swift/Syntax/RawTokenSyntax.h"
+
+using namespace swift;
+using namespace swift::syntax;
+using llvm::cast;
+
+/// Accumulate the full text extent of \p Node -- trivia included -- onto
+/// \p Pos.
+static void accumulateTextLength(const RC<RawSyntax> &Node,
+                                 AbsolutePosition &Pos) {
+  if (Node->isToken()) {
+    auto Tok = cast<RawTokenSyntax>(Node);
+    for (auto &Leader : Tok->LeadingTrivia)
+      Leader.accumulateAbsolutePosition(Pos);
+    Pos.addText(Tok->getText());
+    for (auto &Trailer : Tok->TrailingTrivia)
+      Trailer.accumulateAbsolutePosition(Pos);
+    return;
+  }
+  for (auto &Child : Node->Layout)
+    accumulateTextLength(Child, Pos);
+}
+
+size_t SyntaxParsingCache::getNodeTextLength(const RC<RawSyntax> &Node) {
+  AbsolutePosition Pos;
+  accumulateTextLength(Node, Pos);
+  return Pos.getOffset();
+}
+
+llvm::Optional<size_t>
+SyntaxParsingCache::translateToPreEditPosition(size_t Position) const {
+  for (auto &Edit : Edits) {
+    if (Edit.Start > Position)
+      break;
+    if (Position < Edit.Start + Edit.ReplacementLength)
+      // The position lies within text introduced by an edit; there is no
+      // corresponding pre-edit position.
+      return llvm::None;
+    Position += Edit.originalLength() - Edit.ReplacementLength;
+  }
+  return Position;
+}
+
+bool SyntaxParsingCache::nodeCanBeReused(const RC<RawSyntax> &Node,
+                                         size_t NodeStart, size_t Position,
+                                         SyntaxKind Kind) const {
+  if (NodeStart != Position)
+    return false;
+  if (Node->Kind != Kind)
+    return false;
+
+  // Node must not overlap any edited region. The extent is extended by one
+  // byte on either side because the parser may have looked at the character
+  // next to the node to determine where it ends.
+  size_t NodeEnd = NodeStart + getNodeTextLength(Node);
+  for (auto &Edit : Edits) {
+    if (Edit.intersectsOrTouchesRange(NodeStart, NodeEnd + 1))
+      return false;
+  }
+  return true;
+}
+
+RC<RawSyntax> SyntaxParsingCache::lookUpFrom(const RC<RawSyntax> &Node,
+                                             size_t NodeStart, size_t Position,
+                                             SyntaxKind Kind) const {
+  if (nodeCanBeReused(Node, NodeStart, Position, Kind))
+    return Node;
+
+  size_t ChildStart = NodeStart;
+  for (auto &Child : Node->Layout) {
+    size_t ChildEnd = ChildStart + getNodeTextLength(Child);
+    if (ChildStart <= Position && Position < ChildEnd)
+      return lookUpFrom(Child, ChildStart, Position, Kind);
+    ChildStart = ChildEnd;
+  }
+  return nullptr;
+}
+
+RC<RawSyntax> SyntaxParsingCache::lookUp(size_t NewPosition, SyntaxKind Kind) {
+  auto OldPosition = translateToPreEditPosition(NewPosition);
+  if (!OldPosition.hasValue()) {
+    ++ReuseMisses;
+    return nullptr;
+  }
+
+  auto Node = lookUpFrom(OldSyntaxTree.getRaw(), /*NodeStart=*/0,
+                         OldPosition.getValue(), Kind);
+  if (Node)
+    ++ReuseHits;
+  else
+    ++ReuseMisses;
+  return Node;
+}
@@ -120,7 +120,12 @@ void TriviaPiece::print(llvm::raw_ostream &OS) const {
     printRepeated(OS, '\f', Count);
     break;
   case TriviaKind::Newline:
-    printRepeated(OS, '\n', Count);
+    // Newlines lexed from source keep their text so that '\r' and '\r\n'
+    // sequences reprint exactly as written; synthesized newlines are '\n'.
+    if (!Text.empty())
+      OS << Text.str();
+    else
+      printRepeated(OS, '\n', Count);
     break;
   case TriviaKind::LineComment:
   case TriviaKind::BlockComment:
@@ -379,10 +379,9 @@ void swift::enumeratePublicSymbols(ModuleDecl *M, StringSet &symbols,
   enumeratePublicSymbolsAndWrite(M, nullptr, symbols, hasMultipleIRGenThreads,
                                  nullptr, StringRef());
 }
-void swift::writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os,
-                         bool hasMultipleIRGenThreads,
+void swift::writeTBDFile(ModuleDecl *M, StringSet &symbols,
+                         llvm::raw_ostream &os, bool hasMultipleIRGenThreads,
                          StringRef installName) {
-  StringSet symbols;
   enumeratePublicSymbolsAndWrite(M, nullptr, symbols, hasMultipleIRGenThreads,
                                  &os, installName);
 }
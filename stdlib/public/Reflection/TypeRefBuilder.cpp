@@ -97,6 +97,10 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
   else
     return {};
 
+  auto Found = FieldTypeInfoCache.find(MangledName);
+  if (Found != FieldTypeInfoCache.end())
+    return Found->second;
+
   std::vector<std::pair<std::string, const TypeRef *>> Fields;
   for (auto Info : ReflectionInfos) {
     for (auto &FD : Info.fieldmd) {
@@ -105,6 +109,7 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
       auto CandidateMangledName = FD.getMangledTypeName();
       if (MangledName.compare(CandidateMangledName) != 0)
         continue;
+      FieldTypeInfoCache.insert(std::make_pair(MangledName, &FD));
       return &FD;
     }
   }
@@ -159,6 +164,10 @@ TypeRefBuilder::getBuiltinTypeInfo(const TypeRef *TR) {
   else
     return nullptr;
 
+  auto Found = BuiltinTypeInfoCache.find(MangledName);
+  if (Found != BuiltinTypeInfoCache.end())
+    return Found->second;
+
   for (auto Info : ReflectionInfos) {
     for (auto &BuiltinTypeDescriptor : Info.builtin) {
       assert(BuiltinTypeDescriptor.Size > 0);
@@ -169,6 +178,8 @@ TypeRefBuilder::getBuiltinTypeInfo(const TypeRef *TR) {
       auto CandidateMangledName = BuiltinTypeDescriptor.getMangledTypeName();
       if (MangledName.compare(CandidateMangledName) != 0)
         continue;
+      BuiltinTypeInfoCache.insert(
+          std::make_pair(MangledName, &BuiltinTypeDescriptor));
       return &BuiltinTypeDescriptor;
     }
   }
@@ -178,13 +189,19 @@ TypeRefBuilder::getBuiltinTypeInfo(const TypeRef *TR) {
 
 const CaptureDescriptor *
 TypeRefBuilder::getCaptureDescriptor(uintptr_t RemoteAddress) {
+  auto Found = CaptureDescriptorCache.find(RemoteAddress);
+  if (Found != CaptureDescriptorCache.end())
+    return Found->second;
+
   for (auto Info : ReflectionInfos) {
     for (auto &CD : Info.capture) {
       auto OtherAddr = ((uintptr_t) &CD -
                         Info.LocalStartAddress +
                         Info.RemoteStartAddress);
-      if (OtherAddr == RemoteAddress)
+      if (OtherAddr == RemoteAddress) {
+        CaptureDescriptorCache.insert(std::make_pair(RemoteAddress, &CD));
         return &CD;
+      }
     }
   }
 
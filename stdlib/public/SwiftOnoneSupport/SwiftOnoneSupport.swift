@@ -154,6 +154,95 @@ struct _Prespecialize {
     _createArrayUserWithoutSorting("a")
   }
 
+  // Create specializations for the dictionary type combinations which
+  // specialization-demand profiles of debug builds show are instantiated
+  // most often. To cover another combination, add a _createDictionaryUser
+  // call at the end of this function.
+  static internal func _specializeDictionaries() {
+    func _createDictionaryUser<Key : Hashable, Value>(
+      _ sampleKey: Key, _ sampleValue: Value
+    ) {
+      // Initializers.
+      var d = [Key: Value](minimumCapacity: 4)
+
+      // Set, read and update values.
+      d[sampleKey] = sampleValue
+      let _ = d[sampleKey]
+      d.updateValue(sampleValue, forKey: sampleKey)
+
+      // Get count and emptiness.
+      let _ = d.count
+      let _ = d.isEmpty
+
+      // Iterate over the dictionary, its keys and its values.
+      for (k, v) in d {
+        print(k)
+        print("Value: \(v)")
+      }
+      for k in d.keys {
+        print(k)
+      }
+      for v in d.values {
+        print(v)
+      }
+
+      // Remove values.
+      d.removeValue(forKey: sampleKey)
+      d.removeAll()
+    }
+
+    // Heterogeneous payloads, e.g. decoded JSON objects.
+    _createDictionaryUser("a" as String, 1 as Any)
+
+    // Homogeneous combinations of the most popular key and value types.
+    _createDictionaryUser("a" as String, "a" as String)
+    _createDictionaryUser("a" as String, 1 as Int)
+    _createDictionaryUser(1 as Int, "a" as String)
+    _createDictionaryUser(1 as Int, 1 as Int)
+  }
+
+  // Create specializations for slicing and the slice operations of the
+  // most popular array element types.  The plain array operations are
+  // covered by _specializeArrays above.
+  static internal func _specializeArraySlices() {
+    func _createArraySliceUser<Element>(_ sampleValue: Element) {
+      var a = [Element](repeating: sampleValue, count: 4)
+
+      // Slice the array from the start and to the end.
+      var s = a[1..<a.count]
+      let _ = a[0..<2]
+
+      // Read and write slice elements.
+      let _ = s[s.startIndex]
+      s[s.startIndex] = sampleValue
+
+      // Get count and emptiness.
+      let _ = s.count
+      let _ = s.isEmpty
+
+      // Iterate over the slice.
+      for e in s {
+        print(e)
+        print("Value: \(e)")
+      }
+
+      // Convert back to an array and append a slice.
+      let _ = Array(s)
+      a.append(contentsOf: s)
+
+      // Drop and take elements at either end.
+      let _ = a.dropFirst()
+      let _ = a.dropLast()
+      let _ = a.prefix(2)
+      let _ = a.suffix(2)
+    }
+
+    _createArraySliceUser(1 as UInt8)
+    _createArraySliceUser(1 as Int)
+    _createArraySliceUser(1.5 as Double)
+    _createArraySliceUser("a" as String)
+  }
+
   // Force pre-specialization of Range<Int>
   @discardableResult
   static internal func _specializeRanges() -> Int {
@@ -176,5 +265,7 @@ struct _Prespecialize {
 @_optimize(none)
 internal func _swift_forcePrespecializations() {
   _Prespecialize._specializeArrays()
+  _Prespecialize._specializeDictionaries()
+  _Prespecialize._specializeArraySlices()
   _Prespecialize._specializeRanges()
 }
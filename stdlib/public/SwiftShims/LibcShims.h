@@ -70,6 +70,12 @@ SWIFT_READONLY
 SWIFT_RUNTIME_STDLIB_INTERFACE
 int _swift_stdlib_memcmp(const void *s1, const void *s2, __swift_size_t n);
 
+// Vectorized ASCII scan. Returns the length of the longest prefix of the
+// buffer whose bytes all have their high bit clear, which is n if and only
+// if the whole buffer is ASCII.
+SWIFT_READONLY SWIFT_RUNTIME_STDLIB_INTERFACE __swift_size_t
+_swift_stdlib_asciiPrefixLength(const void *s, __swift_size_t n);
+
 // <unistd.h>
 SWIFT_RUNTIME_STDLIB_INTERFACE
 __swift_ssize_t _swift_stdlib_read(int fd, void *buf, __swift_size_t nbyte);
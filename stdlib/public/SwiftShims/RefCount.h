@@ -1305,6 +1305,12 @@ class HeapObjectSideTableEntry {
     : object(newObject), refCounts()
   { }
 
+  // Side table entries are allocated and freed at a high rate in code that
+  // leans on weak references, so they are pooled per thread instead of
+  // going to malloc every time. Defined in RefCount.cpp.
+  void *operator new(size_t size);
+  void operator delete(void *p);
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winvalid-offsetof"
   static ptrdiff_t refCountsOffset() {
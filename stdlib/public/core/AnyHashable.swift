@@ -37,6 +37,29 @@ public protocol _HasCustomAnyHashableRepresentation {
   func _toCustomAnyHashable() -> AnyHashable?
 }
 
+/// Type tags for the closed set of common standard library types whose
+/// `AnyHashable` equality and hashing bypass the box's witness-table
+/// dispatch. The tag is assigned from the boxed value's static type when the
+/// box is created, so a given boxed type always carries the same tag.
+@_versioned // FIXME(sil-serialize-all)
+internal enum _AnyHashableTypeTag {
+  @_inlineable // FIXME(sil-serialize-all)
+  @_versioned // FIXME(sil-serialize-all)
+  internal static var other: UInt8 { return 0 }
+
+  @_inlineable // FIXME(sil-serialize-all)
+  @_versioned // FIXME(sil-serialize-all)
+  internal static var int: UInt8 { return 1 }
+
+  @_inlineable // FIXME(sil-serialize-all)
+  @_versioned // FIXME(sil-serialize-all)
+  internal static var string: UInt8 { return 2 }
+
+  @_inlineable // FIXME(sil-serialize-all)
+  @_versioned // FIXME(sil-serialize-all)
+  internal static var bool: UInt8 { return 3 }
+}
+
 @_versioned // FIXME(sil-serialize-all)
 internal protocol _AnyHashableBox {
   var _typeID: ObjectIdentifier { get }
@@ -146,6 +169,17 @@ internal func _getBridgedCustomAnyHashable<T>(_ value: T) -> AnyHashable? {
 public struct AnyHashable {
   @_versioned // FIXME(sil-serialize-all)
   internal var _box: _AnyHashableBox
+  /// Inline copies of the boxed value for the tagged common types, so that
+  /// `==` and `hashValue` need not go through the box. Only the field
+  /// selected by `_typeTag` is meaningful; `Bool` is stored in
+  /// `_fastIntValue` as 0 or 1.
+  @_versioned // FIXME(sil-serialize-all)
+  internal var _fastIntValue: Int
+  @_versioned // FIXME(sil-serialize-all)
+  internal var _fastStringValue: String?
+  /// One of the `_AnyHashableTypeTag` values.
+  @_versioned // FIXME(sil-serialize-all)
+  internal var _typeTag: UInt8
   @_versioned // FIXME(sil-serialize-all)
   internal var _usedCustomRepresentation: Bool
 
@@ -177,6 +211,9 @@ public struct AnyHashable {
     }
 
     self._box = _ConcreteHashableBox(0 as Int)
+    self._fastIntValue = 0
+    self._fastStringValue = nil
+    self._typeTag = _AnyHashableTypeTag.other
     self._usedCustomRepresentation = false
     _makeAnyHashableUpcastingToHashableBaseType(
       base,
@@ -187,7 +224,23 @@ public struct AnyHashable {
   @_versioned // FIXME(sil-serialize-all)
   internal init<H : Hashable>(_usingDefaultRepresentationOf base: H) {
     self._box = _ConcreteHashableBox(base)
+    self._fastIntValue = 0
+    self._fastStringValue = nil
+    self._typeTag = _AnyHashableTypeTag.other
     self._usedCustomRepresentation = false
+    // Tag the closed set of common types and copy their payload inline,
+    // so that `==` and `hashValue` can skip the box. The metatype checks
+    // fold away when this initializer is specialized.
+    if H.self == Int.self {
+      self._typeTag = _AnyHashableTypeTag.int
+      self._fastIntValue = unsafeBitCast(base, to: Int.self)
+    } else if H.self == String.self {
+      self._typeTag = _AnyHashableTypeTag.string
+      self._fastStringValue = unsafeBitCast(base, to: String.self)
+    } else if H.self == Bool.self {
+      self._typeTag = _AnyHashableTypeTag.bool
+      self._fastIntValue = unsafeBitCast(base, to: Bool.self) ? 1 : 0
+    }
   }
 
   /// The value wrapped by this instance.
@@ -259,6 +312,24 @@ extension AnyHashable : Equatable {
   ///   - rhs: Another type-erased hashable value.
   @_inlineable // FIXME(sil-serialize-all)
   public static func == (lhs: AnyHashable, rhs: AnyHashable) -> Bool {
+    // Compare the tagged common types directly, without going through the
+    // boxes. Tags are assigned from the boxed value's static type, so two
+    // values with the same tag box the same type, and two values with
+    // different tags from the closed set box different types and can never
+    // compare equal, not even through the bridged representations below.
+    let lhsTag = lhs._typeTag
+    let rhsTag = rhs._typeTag
+    if lhsTag != _AnyHashableTypeTag.other {
+      if lhsTag == rhsTag {
+        if lhsTag == _AnyHashableTypeTag.string {
+          return lhs._fastStringValue! == rhs._fastStringValue!
+        }
+        // Int and Bool both live in _fastIntValue.
+        return lhs._fastIntValue == rhs._fastIntValue
+      }
+      if rhsTag != _AnyHashableTypeTag.other { return false }
+    }
+
     // If they're equal, we're done.
     if let result = lhs._box._isEqual(to: rhs._box) { return result }
 
@@ -293,7 +364,18 @@ extension AnyHashable : Equatable {
 extension AnyHashable : Hashable {
   @_inlineable // FIXME(sil-serialize-all)
   public var hashValue: Int {
-    return _box._hashValue
+    // Hash the tagged common types directly; the results match what the
+    // boxed value's own hashValue would produce.
+    switch _typeTag {
+    case _AnyHashableTypeTag.int:
+      return _fastIntValue.hashValue
+    case _AnyHashableTypeTag.string:
+      return _fastStringValue!.hashValue
+    case _AnyHashableTypeTag.bool:
+      return (_fastIntValue != 0).hashValue
+    default:
+      return _box._hashValue
+    }
   }
 }
 
@@ -194,6 +194,18 @@ internal func _decodeCString<Encoding : _UnicodeEncoding>(
   repairingInvalidCodeUnits isRepairing: Bool = true)
 -> (result: String, repairsMade: Bool)? {
 
+  // Fast path: an all-ASCII UTF-8 string needs neither validation nor
+  // transcoding, so the bytes can be copied straight into a one-byte-per-
+  // element buffer. The ASCII scan is vectorized in the runtime.
+  if Encoding.self == UTF8.self,
+    Int(_swift_stdlib_asciiPrefixLength(cString, __swift_size_t(length)))
+      == length {
+    let stringBuffer = _StringBuffer(
+      capacity: length, initialSize: length, elementWidth: 1)
+    stringBuffer.start.copyBytes(from: cString, count: length)
+    return (result: String(_storage: stringBuffer), repairsMade: false)
+  }
+
   let buffer = UnsafeBufferPointer<Encoding.CodeUnit>(
     start: cString, count: length)
 
@@ -0,0 +1,215 @@
+//===--- Arena.cpp - Bulk allocation arena for heap objects ---------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Implementation of swift_arenaCreate, swift_allocObjectInArena and
+// swift_arenaDestroy.
+//
+// An arena bump-allocates objects out of large malloc'ed chunks. Objects
+// allocated in an arena are reference counted and deinitialized exactly like
+// ordinary heap objects; only the reclamation of their memory is deferred:
+// swift_slowDealloc recognizes arena-owned memory and leaves it alone, and
+// the chunks are given back to the system wholesale in swift_arenaDestroy.
+//
+// An arena and all objects allocated in it are confined to a single thread,
+// so the arena itself needs no locking. The global registry of live arenas,
+// which swift_slowDealloc consults, is shared between threads and is guarded
+// by a mutex; a lock-free counter of live arenas keeps the common case of a
+// process without arenas down to a single load and branch.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/Lazy.h"
+#include "swift/Runtime/Config.h"
+#include "swift/Runtime/Debug.h"
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/Mutex.h"
+#include "Private.h"
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+using namespace swift;
+
+namespace {
+
+/// The default granularity in which an arena requests memory from malloc.
+/// Large enough to amortize the malloc calls over hundreds of typical
+/// objects, small enough not to waste much memory on mostly-empty arenas.
+static const size_t DefaultChunkSize = 64 * 1024;
+
+/// A contiguous block of arena memory. The chunk header is followed
+/// immediately by the allocatable space.
+struct ArenaChunk {
+  ArenaChunk *Next;
+  size_t Size;
+
+  char *begin() { return reinterpret_cast<char *>(this + 1); }
+  char *end() { return reinterpret_cast<char *>(this) + Size; }
+
+  bool contains(const void *p) const {
+    return p >= this && p < reinterpret_cast<const char *>(this) + Size;
+  }
+};
+
+} // end anonymous namespace
+
+namespace swift {
+
+/// See the comment in HeapObject.h.
+struct SwiftArena {
+  /// Singly-linked list of chunks; the head is the chunk currently being
+  /// allocated from.
+  ArenaChunk *Chunks = nullptr;
+
+  /// The bump pointer and limit within the head chunk.
+  char *CurPtr = nullptr;
+  char *CurEnd = nullptr;
+
+  /// The granularity of system allocations for this arena.
+  size_t ChunkSize = DefaultChunkSize;
+
+  /// All objects ever allocated in this arena, used to verify at destruction
+  /// time that none of them is still alive.
+  std::vector<HeapObject *> Objects;
+
+  /// The next live arena in the global registry.
+  SwiftArena *NextArena = nullptr;
+
+  bool contains(const void *p) const {
+    for (ArenaChunk *chunk = Chunks; chunk; chunk = chunk->Next) {
+      if (chunk->contains(p))
+        return true;
+    }
+    return false;
+  }
+};
+
+} // end namespace swift
+
+/// The number of live arenas in the process. This is the only state
+/// swift_slowDealloc has to inspect as long as no arenas are in use.
+std::atomic<size_t> swift::_swift_numLiveArenas(0);
+
+namespace {
+
+/// The global registry of live arenas, consulted by swift_slowDealloc to
+/// decide whether a pointer is arena-owned.
+struct ArenaRegistry {
+  Mutex RegistryLock;
+  SwiftArena *Arenas = nullptr;
+};
+
+} // end anonymous namespace
+
+static Lazy<ArenaRegistry> Registry;
+
+bool swift::_swift_arenaContains(const void *p) {
+  auto &R = Registry.get();
+  bool found = false;
+  R.RegistryLock.withLock([&] {
+    for (SwiftArena *arena = R.Arenas; arena; arena = arena->NextArena) {
+      if (arena->contains(p)) {
+        found = true;
+        return;
+      }
+    }
+  });
+  return found;
+}
+
+SwiftArena *swift::swift_arenaCreate(size_t chunkSize) {
+  auto *arena = new SwiftArena();
+  if (chunkSize != 0)
+    arena->ChunkSize = std::max(chunkSize, sizeof(ArenaChunk) + alignof(HeapObject));
+
+  auto &R = Registry.get();
+  R.RegistryLock.withLock([&] {
+    arena->NextArena = R.Arenas;
+    R.Arenas = arena;
+  });
+  _swift_numLiveArenas.fetch_add(1, std::memory_order_relaxed);
+  return arena;
+}
+
+/// Starts a new chunk big enough for an allocation of \p size bytes.
+static void startNewChunk(SwiftArena *arena, size_t size) {
+  size_t chunkSize = std::max(arena->ChunkSize, sizeof(ArenaChunk) + size +
+                                                    alignof(HeapObject));
+  auto *chunk = reinterpret_cast<ArenaChunk *>(malloc(chunkSize));
+  if (!chunk)
+    crash("Could not allocate memory.");
+  chunk->Size = chunkSize;
+
+  // Registering the chunk must happen before any object in it can be
+  // deallocated, i.e. before the chunk is handed out to allocations.
+  auto &R = Registry.get();
+  R.RegistryLock.withLock([&] {
+    chunk->Next = arena->Chunks;
+    arena->Chunks = chunk;
+  });
+  arena->CurPtr = chunk->begin();
+  arena->CurEnd = chunk->end();
+}
+
+HeapObject *swift::swift_allocObjectInArena(SwiftArena *arena,
+                                            HeapMetadata const *metadata,
+                                            size_t requiredSize,
+                                            size_t requiredAlignmentMask) {
+  assert(isAlignmentMask(requiredAlignmentMask));
+
+  // Bump-allocate, starting a new chunk if the current one is exhausted.
+  uintptr_t addr = reinterpret_cast<uintptr_t>(arena->CurPtr);
+  addr = (addr + requiredAlignmentMask) & ~uintptr_t(requiredAlignmentMask);
+  if (addr + requiredSize > reinterpret_cast<uintptr_t>(arena->CurEnd)) {
+    startNewChunk(arena, requiredSize + requiredAlignmentMask);
+    addr = reinterpret_cast<uintptr_t>(arena->CurPtr);
+    addr = (addr + requiredAlignmentMask) & ~uintptr_t(requiredAlignmentMask);
+  }
+  arena->CurPtr = reinterpret_cast<char *>(addr + requiredSize);
+
+  auto object = reinterpret_cast<HeapObject *>(addr);
+  object->metadata = metadata;
+  object->refCounts.init();
+
+  arena->Objects.push_back(object);
+  return object;
+}
+
+void swift::swift_arenaDestroy(SwiftArena *arena) {
+  // All objects must have been deinitialized by now; otherwise references
+  // into the arena would dangle once the chunks are freed.
+  for (HeapObject *object : arena->Objects) {
+    if (!object->refCounts.isDeiniting())
+      fatalError(0, "swift_arenaDestroy: object %p in arena %p is still "
+                    "alive\n", object, arena);
+  }
+
+  // Unregister the arena so that swift_slowDealloc stops considering its
+  // chunks.
+  auto &R = Registry.get();
+  R.RegistryLock.withLock([&] {
+    SwiftArena **prev = &R.Arenas;
+    while (*prev != arena)
+      prev = &(*prev)->NextArena;
+    *prev = arena->NextArena;
+  });
+  _swift_numLiveArenas.fetch_sub(1, std::memory_order_relaxed);
+
+  // Free the memory of all objects wholesale.
+  ArenaChunk *chunk = arena->Chunks;
+  while (chunk) {
+    ArenaChunk *next = chunk->Next;
+    free(chunk);
+    chunk = next;
+  }
+  delete arena;
+}
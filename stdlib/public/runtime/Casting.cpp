@@ -31,6 +31,7 @@
 #include "ErrorObject.h"
 #include "ExistentialMetadataImpl.h"
 #include "Private.h"
+#include "RuntimeInvocationsTracking.h"
 #include "SwiftHashableSupport.h"
 #include "../SwiftShims/RuntimeShims.h"
 #include "stddef.h"
@@ -253,18 +254,72 @@ static bool _succeed(OpaqueValue *dest, OpaqueValue *src,
 
 /// Dynamically cast a class metatype to a Swift class metatype.
 static const ClassMetadata *
-_dynamicCastClassMetatype(const ClassMetadata *sourceType,
-                          const ClassMetadata *targetType) {
+_dynamicCastClassMetatypeUncached(const ClassMetadata *sourceType,
+                                  const ClassMetadata *targetType) {
   do {
     if (sourceType == targetType) {
       return sourceType;
     }
     sourceType = sourceType->SuperClass;
   } while (sourceType);
-  
+
   return nullptr;
 }
 
+// A small per-thread cache of (source, target) class metatype pairs and their
+// cast results. Workloads like serializers perform millions of identical
+// class casts; caching turns the superclass chain walk into a single probe.
+// Class hierarchies are immutable once the classes are instantiated, so cached
+// entries (including negative ones) never have to be invalidated. The cache is
+// per-thread so that lookups and insertions need no synchronization.
+//
+// Use the cache only if the compiler claims to support thread_local; platforms
+// without it simply walk the superclass chain every time.
+#if !defined(__clang__) || __has_feature(cxx_thread_local)
+#define SWIFT_HAS_CLASS_CAST_CACHE 1
+#else
+#define SWIFT_HAS_CLASS_CAST_CACHE 0
+#endif
+
+#if SWIFT_HAS_CLASS_CAST_CACHE
+namespace {
+struct ClassCastCacheEntry {
+  const ClassMetadata *Source;
+  const ClassMetadata *Target;
+  const ClassMetadata *Result;
+};
+} // end anonymous namespace
+
+/// Direct-mapped cache; must be a power of two.
+static const uintptr_t ClassCastCacheSize = 64;
+static thread_local ClassCastCacheEntry ClassCastCache[ClassCastCacheSize];
+#endif
+
+/// Dynamically cast a class metatype to a Swift class metatype, using the
+/// per-thread cache.
+static const ClassMetadata *
+_dynamicCastClassMetatype(const ClassMetadata *sourceType,
+                          const ClassMetadata *targetType) {
+#if SWIFT_HAS_CLASS_CAST_CACHE
+  // Mix both pointers into the index; the shifts discard the always-zero
+  // alignment bits and keep pairs with a common source or target from
+  // clustering in the same slot.
+  uintptr_t hash = (reinterpret_cast<uintptr_t>(sourceType) >> 4) ^
+                   (reinterpret_cast<uintptr_t>(targetType) >> 9);
+  auto &entry = ClassCastCache[hash & (ClassCastCacheSize - 1)];
+  if (entry.Source == sourceType && entry.Target == targetType) {
+    SWIFT_RT_TRACK_INVOCATION(nullptr, swift_dynamicCastClassCacheHit);
+    return entry.Result;
+  }
+  SWIFT_RT_TRACK_INVOCATION(nullptr, swift_dynamicCastClassCacheMiss);
+  auto result = _dynamicCastClassMetatypeUncached(sourceType, targetType);
+  entry = {sourceType, targetType, result};
+  return result;
+#else
+  return _dynamicCastClassMetatypeUncached(sourceType, targetType);
+#endif
+}
+
 /// Dynamically cast a class instance to a Swift class type.
 const void *swift::swift_dynamicCastClass(const void *object,
                                           const ClassMetadata *targetType)
@@ -2989,8 +3044,24 @@ id _swift_bridgeAnythingNonVerbatimToObjectiveC(OpaqueValue *src,
 
 extern "C" const _ObjectiveCBridgeableWitnessTable BRIDGING_CONFORMANCE_SYM;
 
+#if SWIFT_HAS_CLASS_CAST_CACHE
+namespace {
+struct BridgeWitnessCacheEntry {
+  const Metadata *Type;
+  const _ObjectiveCBridgeableWitnessTable *Witness;
+};
+} // end anonymous namespace
+
+/// Direct-mapped cache; must be a power of two. Only successful lookups are
+/// cached: a conformance can be registered after a failed lookup (e.g. by
+/// loading another image), so negative results are not stable.
+static const uintptr_t BridgeWitnessCacheSize = 64;
+static thread_local BridgeWitnessCacheEntry
+    BridgeWitnessCache[BridgeWitnessCacheSize];
+#endif
+
 static const _ObjectiveCBridgeableWitnessTable *
-findBridgeWitness(const Metadata *T) {
+findBridgeWitnessUncached(const Metadata *T) {
   auto w = swift_conformsToProtocol(T,
                                 &PROTOCOL_DESCR_SYM(s21_ObjectiveCBridgeable));
   if (LLVM_LIKELY(w))
@@ -3031,6 +3102,29 @@ findBridgeWitness(const Metadata *T) {
   return nullptr;
 }
 
+/// Find the witness table for T's _ObjectiveCBridgeable conformance, using
+/// the per-thread cache. Bridging-heavy code looks up the same handful of
+/// types over and over, so this saves the conformance cache's hash lookup
+/// on the hot path.
+static const _ObjectiveCBridgeableWitnessTable *
+findBridgeWitness(const Metadata *T) {
+#if SWIFT_HAS_CLASS_CAST_CACHE
+  uintptr_t hash = reinterpret_cast<uintptr_t>(T) >> 4;
+  auto &entry = BridgeWitnessCache[hash & (BridgeWitnessCacheSize - 1)];
+  if (entry.Type == T) {
+    SWIFT_RT_TRACK_INVOCATION(nullptr, swift_bridgeWitnessCacheHit);
+    return entry.Witness;
+  }
+  SWIFT_RT_TRACK_INVOCATION(nullptr, swift_bridgeWitnessCacheMiss);
+  auto witness = findBridgeWitnessUncached(T);
+  if (witness)
+    entry = {T, witness};
+  return witness;
+#else
+  return findBridgeWitnessUncached(T);
+#endif
+}
+
 SWIFT_CC(swift) SWIFT_RUNTIME_STDLIB_INTERFACE
 const Metadata *_swift_getBridgedNonVerbatimObjectiveCType(
   const Metadata *value, const Metadata *T
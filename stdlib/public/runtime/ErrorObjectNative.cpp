@@ -22,12 +22,70 @@
 #if !SWIFT_OBJC_INTEROP
 
 #include <stdio.h>
+#include <cstddef>
+#include <cstring>
 #include "swift/Runtime/Debug.h"
 #include "ErrorObject.h"
 #include "Private.h"
+#include "RuntimeInvocationsTracking.h"
 
 using namespace swift;
 
+// Pick whether the per-thread error box pool is available; without
+// thread_local support every throw goes through swift_allocObject.
+#if defined(__clang__) && !__has_feature(cxx_thread_local)
+#define SWIFT_HAS_ERROR_BOX_POOL 0
+#else
+#define SWIFT_HAS_ERROR_BOX_POOL 1
+#endif
+
+#if SWIFT_HAS_ERROR_BOX_POOL
+/// The fixed capacity of a pooled error box. Boxes whose payload needs more
+/// space or stricter alignment than malloc provides are allocated exactly
+/// and never pooled.
+static const size_t PooledErrorBoxSize = 128;
+static const size_t PooledErrorBoxAlignMask = alignof(std::max_align_t) - 1;
+
+/// Whether a box with the given size and alignment can be served from the
+/// pool. Eligible boxes are always allocated at PooledErrorBoxSize, so any
+/// pooled block can satisfy any eligible request.
+static bool isErrorBoxPoolable(const std::pair<size_t, size_t> &sizeAndAlign) {
+  return sizeAndAlign.first <= PooledErrorBoxSize &&
+         sizeAndAlign.second <= PooledErrorBoxAlignMask;
+}
+
+namespace {
+
+/// A per-thread free list of recycled error boxes.
+///
+/// Code that throws and catches in a hot loop allocates and frees an error
+/// box per iteration; recycling the boxes within a thread takes the
+/// allocator out of that loop. The pool is capped so a burst of throws
+/// doesn't permanently pin memory to one thread.
+struct ErrorBoxPool {
+  struct Node {
+    Node *Next;
+  };
+
+  Node *Head = nullptr;
+  unsigned Count = 0;
+
+  enum : unsigned { MaxCount = 16 };
+
+  ~ErrorBoxPool() {
+    while (Head) {
+      Node *next = Head->Next;
+      swift_slowDealloc(Head, PooledErrorBoxSize, PooledErrorBoxAlignMask);
+      Head = next;
+    }
+  }
+};
+
+} // end anonymous namespace
+
+static thread_local ErrorBoxPool TheErrorBoxPool;
+#endif
+
 /// Determine the size and alignment of an Error box containing the given
 /// type.
 static std::pair<size_t, size_t>
@@ -45,17 +103,42 @@ _getErrorAllocatedSizeAndAlignmentMask(const Metadata *type) {
   return {size, alignMask};
 }
 
+/// Free an Error box whose value has already been destroyed (or was never
+/// initialized), recycling it into the pool when possible.
+static void _deallocErrorBox(HeapObject *obj,
+                             std::pair<size_t, size_t> sizeAndAlign) {
+#if SWIFT_HAS_ERROR_BOX_POOL
+  if (isErrorBoxPoolable(sizeAndAlign)) {
+    auto &pool = TheErrorBoxPool;
+    if (pool.Count < ErrorBoxPool::MaxCount && obj->refCounts.canBeFreedNow()) {
+#ifndef NDEBUG
+      // Poison the recycled box so a stale reference trips quickly.
+      memset(obj, 0x55, PooledErrorBoxSize);
+#endif
+      auto node = reinterpret_cast<ErrorBoxPool::Node *>(obj);
+      node->Next = pool.Head;
+      pool.Head = node;
+      pool.Count++;
+      return;
+    }
+    // Eligible boxes were allocated at the fixed pooled capacity.
+    swift_deallocObject(obj, PooledErrorBoxSize, PooledErrorBoxAlignMask);
+    return;
+  }
+#endif
+  swift_deallocObject(obj, sizeAndAlign.first, sizeAndAlign.second);
+}
+
 /// Destructor for an Error box.
 static SWIFT_CC(swift) void _destroyErrorObject(SWIFT_CONTEXT HeapObject *obj) {
   auto error = static_cast<SwiftError *>(obj);
-  
+
   // Destroy the value inside.
   auto type = error->type;
   type->vw_destroy(error->getValue());
-  
+
   // Deallocate the buffer.
-  auto sizeAndAlign = _getErrorAllocatedSizeAndAlignmentMask(type);
-  swift_deallocObject(obj, sizeAndAlign.first, sizeAndAlign.second);
+  _deallocErrorBox(obj, _getErrorAllocatedSizeAndAlignmentMask(type));
 }
 
 /// Heap metadata for Error boxes.
@@ -70,10 +153,31 @@ swift::swift_allocError(const swift::Metadata *type,
                         OpaqueValue *initialValue,
                         bool isTake) {
   auto sizeAndAlign = _getErrorAllocatedSizeAndAlignmentMask(type);
-  
-  auto allocated = swift_allocObject(&ErrorMetadata,
-                                     sizeAndAlign.first, sizeAndAlign.second);
-  
+
+  HeapObject *allocated;
+#if SWIFT_HAS_ERROR_BOX_POOL
+  if (isErrorBoxPoolable(sizeAndAlign)) {
+    auto &pool = TheErrorBoxPool;
+    if (auto node = pool.Head) {
+      pool.Head = node->Next;
+      pool.Count--;
+      SWIFT_RT_TRACK_INVOCATION(nullptr, swift_errorBoxPoolHit);
+      allocated = reinterpret_cast<HeapObject *>(node);
+      allocated->metadata = &ErrorMetadata;
+      allocated->refCounts.init();
+    } else {
+      SWIFT_RT_TRACK_INVOCATION(nullptr, swift_errorBoxPoolMiss);
+      // Allocate at the fixed pooled capacity so the box can be recycled.
+      allocated = swift_allocObject(&ErrorMetadata, PooledErrorBoxSize,
+                                    PooledErrorBoxAlignMask);
+    }
+  } else
+#endif
+  {
+    allocated = swift_allocObject(&ErrorMetadata,
+                                  sizeAndAlign.first, sizeAndAlign.second);
+  }
+
   auto error = reinterpret_cast<SwiftError*>(allocated);
   
   error->type = type;
@@ -93,8 +197,7 @@ swift::swift_allocError(const swift::Metadata *type,
 
 void
 swift::swift_deallocError(SwiftError *error, const Metadata *type) {
-  auto sizeAndAlign = _getErrorAllocatedSizeAndAlignmentMask(type);
-  swift_deallocObject(error, sizeAndAlign.first, sizeAndAlign.second);
+  _deallocErrorBox(error, _getErrorAllocatedSizeAndAlignmentMask(type));
 }
 
 void
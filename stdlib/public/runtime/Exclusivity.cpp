@@ -18,6 +18,7 @@
 #include "swift/Runtime/Debug.h"
 #include "swift/Runtime/Exclusivity.h"
 #include "swift/Runtime/Metadata.h"
+#include <cstdlib>
 #include <memory>
 #include <stdio.h>
 
@@ -182,43 +183,176 @@ static_assert(sizeof(Access) <= sizeof(ValueBuffer) &&
               alignof(Access) <= alignof(ValueBuffer),
               "Access doesn't fit in a value buffer!");
 
-/// A set of accesses that we're tracking.  Just a singly-linked list.
+/// A set of accesses that we're tracking, keyed by the accessed pointer.
+///
+/// The accesses to one pointer are chained through their value buffers, and
+/// the chains are indexed by the pointer: a four-entry inline array backed
+/// by a small open-addressed overflow table. Beginning or ending an access
+/// therefore probes a handful of slots instead of walking every access the
+/// thread currently has underway, and the common no-conflict case is a few
+/// pointer compares ending in one well-predicted "slot is empty" branch.
 class AccessSet {
-  Access *Head = nullptr;
+  /// The chain of accesses to a single pointer.
+  struct Entry {
+    void *Pointer;
+    Access *Head;
+  };
+
+  enum : unsigned { NumInlineEntries = 4 };
+
+  /// Marks an overflow slot whose chain has been emptied. Lookups must
+  /// probe past it; insertions may reuse it.
+  static void *tombstone() {
+    return reinterpret_cast<void *>(uintptr_t(-1));
+  }
+
+  /// Accesses to at most this many distinct pointers are tracked without
+  /// touching the overflow table at all.
+  Entry InlineEntries[NumInlineEntries] = {};
+
+  /// The open-addressed overflow table, allocated on first use and freed
+  /// again once it holds no chains, so that the set stays trivially
+  /// destructible for the thread-local storage implementations.
+  Entry *Table = nullptr;
+  unsigned TableCapacity = 0; ///< Always a power of two (or zero).
+  unsigned TableLive = 0;     ///< Slots with a non-empty chain.
+  unsigned TableUsed = 0;     ///< Live slots plus tombstones.
+
+  static size_t hash(void *pointer) {
+    // Accessed addresses are at least word-aligned; discard the dead bits.
+    return reinterpret_cast<uintptr_t>(pointer) >> 3;
+  }
+
+  /// Finds the entry for \p pointer, or returns null.
+  Entry *find(void *pointer) {
+    for (auto &entry : InlineEntries)
+      if (entry.Pointer == pointer)
+        return &entry;
+    if (!Table)
+      return nullptr;
+    size_t mask = TableCapacity - 1;
+    for (size_t i = hash(pointer) & mask; true; i = (i + 1) & mask) {
+      if (Table[i].Pointer == pointer)
+        return &Table[i];
+      if (Table[i].Pointer == nullptr)
+        return nullptr;
+      // Skip tombstones and chains for other pointers.
+    }
+  }
+
+  bool isInlineEntry(Entry *entry) const {
+    return entry >= &InlineEntries[0] &&
+           entry < &InlineEntries[NumInlineEntries];
+  }
+
+  /// Doubles the overflow table, dropping accumulated tombstones.
+  void growTable() {
+    unsigned newCapacity = TableCapacity ? TableCapacity * 2 : 16;
+    auto newTable = static_cast<Entry *>(calloc(newCapacity, sizeof(Entry)));
+    if (!newTable)
+      fatalError(0, "couldn't allocate exclusivity access table\n");
+    size_t mask = newCapacity - 1;
+    for (unsigned i = 0; i != TableCapacity; ++i) {
+      Entry &entry = Table[i];
+      if (entry.Pointer == nullptr || entry.Pointer == tombstone())
+        continue;
+      size_t j = hash(entry.Pointer) & mask;
+      while (newTable[j].Pointer != nullptr)
+        j = (j + 1) & mask;
+      newTable[j] = entry;
+    }
+    free(Table);
+    Table = newTable;
+    TableCapacity = newCapacity;
+    TableUsed = TableLive;
+  }
+
+  /// Starts a new chain for \p pointer, headed by \p access.
+  void addEntry(void *pointer, Access *access) {
+    for (auto &entry : InlineEntries) {
+      if (entry.Pointer == nullptr) {
+        entry.Pointer = pointer;
+        entry.Head = access;
+        return;
+      }
+    }
+
+    // Keep the table at most 3/4 full so that probe sequences stay short
+    // and always hit an empty slot.
+    if ((TableUsed + 1) * 4 > TableCapacity * 3)
+      growTable();
+
+    size_t mask = TableCapacity - 1;
+    size_t i = hash(pointer) & mask;
+    while (Table[i].Pointer != nullptr && Table[i].Pointer != tombstone())
+      i = (i + 1) & mask;
+    if (Table[i].Pointer == nullptr)
+      TableUsed++;
+    Table[i].Pointer = pointer;
+    Table[i].Head = access;
+    TableLive++;
+  }
+
+  /// Releases the (emptied) chain slot \p entry.
+  void removeEntry(Entry *entry) {
+    if (isInlineEntry(entry)) {
+      entry->Pointer = nullptr;
+      return;
+    }
+    entry->Pointer = tombstone();
+    if (--TableLive == 0) {
+      free(Table);
+      Table = nullptr;
+      TableCapacity = 0;
+      TableUsed = 0;
+    }
+  }
+
 public:
   constexpr AccessSet() {}
 
   void insert(Access *access, void *pc, void *pointer, ExclusivityFlags flags) {
     auto action = getAccessAction(flags);
 
-    for (Access *cur = Head; cur != nullptr; cur = cur->getNext()) {
-      // Ignore accesses to different values.
-      if (cur->Pointer != pointer)
-        continue;
-
-      // If both accesses are reads, it's not a conflict.
-      if (action == ExclusivityFlags::Read &&
-          action == cur->getAccessAction())
-        continue;
-
-      // Otherwise, it's a conflict.
-      reportExclusivityConflict(cur->getAccessAction(), cur->PC,
-                                flags, pc, pointer);
+    Entry *entry = find(pointer);
+    if (LLVM_UNLIKELY(entry != nullptr)) {
+      // Another access to the same pointer is underway; every access in
+      // its chain is a candidate conflict.
+      for (Access *cur = entry->Head; cur != nullptr; cur = cur->getNext()) {
+        // If both accesses are reads, it's not a conflict.
+        if (action == ExclusivityFlags::Read &&
+            action == cur->getAccessAction())
+          continue;
+
+        // Otherwise, it's a conflict.
+        reportExclusivityConflict(cur->getAccessAction(), cur->PC,
+                                  flags, pc, pointer);
+
+        // If we're only warning, don't report multiple conflicts.
+        break;
+      }
 
-      // If we're only warning, don't report multiple conflicts.
-      break;
+      // Insert to the front of the chain so that remove tends to find it
+      // faster.
+      access->initialize(pc, pointer, entry->Head, action);
+      entry->Head = access;
+      return;
     }
 
-    // Insert to the front of the array so that remove tends to find it faster.
-    access->initialize(pc, pointer, Head, action);
-    Head = access;
+    access->initialize(pc, pointer, nullptr, action);
+    addEntry(pointer, access);
   }
 
   void remove(Access *access) {
-    auto cur = Head;
+    Entry *entry = find(access->Pointer);
+    if (!entry)
+      swift_runtime_unreachable("access not found in set");
+
+    auto cur = entry->Head;
     // Fast path: stack discipline.
     if (cur == access) {
-      Head = cur->getNext();
+      if ((entry->Head = cur->getNext()) == nullptr)
+        removeEntry(entry);
       return;
     }
 
@@ -18,12 +18,136 @@
 #include "swift/Runtime/Heap.h"
 #include "Private.h"
 #include "swift/Runtime/Debug.h"
+#include <atomic>
 #include <stdlib.h>
 
 using namespace swift;
 
+// Pick whether a per-thread sampling countdown is available; without
+// thread_local support all threads share one atomic countdown.
+#if defined(__clang__) && !__has_feature(cxx_thread_local)
+#define SWIFT_HAS_ALLOC_SAMPLING_TLS 0
+#else
+#define SWIFT_HAS_ALLOC_SAMPLING_TLS 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SWIFT_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define SWIFT_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+/// The current allocation sampling rate. A non-zero rate N means every Nth
+/// swift_slowAlloc call per thread is recorded; zero means sampling is off.
+static std::atomic<size_t> AllocSamplingRate(0);
+
+#if SWIFT_HAS_ALLOC_SAMPLING_TLS
+/// Allocations remaining until the next sample is taken on this thread.
+static LLVM_THREAD_LOCAL size_t AllocSamplingCountdown = 0;
+#else
+static std::atomic<size_t> AllocSamplingCountdown(0);
+#endif
+
+namespace {
+
+/// One slot of the aggregation table. The key packs the sampled return
+/// address and the size class into a single word so a slot can be claimed
+/// with one compare-and-swap; zero means the slot is empty.
+struct AllocSiteEntry {
+  std::atomic<uint64_t> Key;
+  std::atomic<uint64_t> Count;
+};
+
+} // end anonymous namespace
+
+/// Fixed-size open-addressed aggregation table; must be a power of two.
+/// Samples that fail to claim a slot are counted in AllocSamplesOverflowed
+/// so the reader can tell how much volume went unattributed.
+static const size_t AllocSiteTableSize = 1024;
+static AllocSiteEntry AllocSiteTable[AllocSiteTableSize];
+static std::atomic<uint64_t> AllocSamplesOverflowed(0);
+
+static uint64_t makeAllocSiteKey(void *site, uint32_t sizeClass) {
+  return ((uint64_t)(uintptr_t)site << 6) | sizeClass;
+}
+
+/// Record one sampled allocation into the aggregation table.
+static void sampleAllocation(void *site, size_t size) {
+  // Size class is the base-2 logarithm of the size, rounded up.
+  uint32_t sizeClass = 0;
+  while (((size_t)1 << sizeClass) < size && sizeClass < 63)
+    ++sizeClass;
+
+  uint64_t key = makeAllocSiteKey(site, sizeClass);
+  size_t index = ((uintptr_t)site >> 2) ^ ((uintptr_t)site >> 14) ^ sizeClass;
+  for (unsigned probes = 0; probes != 16; ++probes) {
+    auto &entry = AllocSiteTable[(index + probes) & (AllocSiteTableSize - 1)];
+    uint64_t entryKey = entry.Key.load(std::memory_order_acquire);
+    if (entryKey == 0) {
+      // Try to claim the empty slot; on a race, reexamine it.
+      if (!entry.Key.compare_exchange_strong(entryKey, key,
+                                             std::memory_order_acq_rel))
+        entryKey = entry.Key.load(std::memory_order_acquire);
+      else
+        entryKey = key;
+    }
+    if (entryKey == key) {
+      entry.Count.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  AllocSamplesOverflowed.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t swift::_swift_setHeapAllocationSamplingRate(size_t rate) {
+  return AllocSamplingRate.exchange(rate, std::memory_order_relaxed);
+}
+
+uint64_t swift::_swift_getHeapAllocationSiteStats(
+    HeapAllocationSiteStats *buffer, uint64_t maxEntries) {
+  uint64_t numWritten = 0;
+  auto overflowed = AllocSamplesOverflowed.load(std::memory_order_relaxed);
+  if (overflowed && numWritten < maxEntries)
+    buffer[numWritten++] = {nullptr, 0, overflowed};
+  for (size_t i = 0; i != AllocSiteTableSize && numWritten < maxEntries; ++i) {
+    auto &entry = AllocSiteTable[i];
+    uint64_t key = entry.Key.load(std::memory_order_acquire);
+    if (key == 0)
+      continue;
+    buffer[numWritten++] = {(const void *)(uintptr_t)(key >> 6),
+                            (uint32_t)(key & 63),
+                            entry.Count.load(std::memory_order_relaxed)};
+  }
+  return numWritten;
+}
+
+/// Decide whether this allocation is the Nth on its thread and should be
+/// sampled. The caller has already checked that sampling is enabled.
+static bool shouldSampleAllocation(size_t rate) {
+#if SWIFT_HAS_ALLOC_SAMPLING_TLS
+  if (AllocSamplingCountdown == 0)
+    AllocSamplingCountdown = rate;
+  if (--AllocSamplingCountdown != 0)
+    return false;
+  AllocSamplingCountdown = rate;
+  return true;
+#else
+  size_t countdown =
+      AllocSamplingCountdown.fetch_sub(1, std::memory_order_relaxed);
+  if (countdown > 1)
+    return false;
+  AllocSamplingCountdown.store(rate, std::memory_order_relaxed);
+  return true;
+#endif
+}
+
 void *swift::swift_slowAlloc(size_t size, size_t alignMask)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
+  size_t samplingRate = AllocSamplingRate.load(std::memory_order_relaxed);
+  if (LLVM_UNLIKELY(samplingRate != 0) && shouldSampleAllocation(samplingRate))
+    sampleAllocation(SWIFT_RETURN_ADDRESS(), size);
+
   // FIXME: use posix_memalign if alignMask is larger than the system guarantee.
   void *p = malloc(size);
   if (!p) swift::crash("Could not allocate memory.");
@@ -32,5 +156,10 @@ void *swift::swift_slowAlloc(size_t size, size_t alignMask)
 
 void swift::swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
+  // Memory owned by an allocation arena is not freed individually; it is
+  // released wholesale when the arena is destroyed.
+  if (LLVM_UNLIKELY(_swift_numLiveArenas.load(std::memory_order_relaxed) != 0)
+      && _swift_arenaContains(ptr))
+    return;
   free(ptr);
 }
@@ -390,6 +390,28 @@ void SWIFT_RT_ENTRY_IMPL(swift_release_n)(HeapObject *object, uint32_t n)
     object->refCounts.decrementAndMaybeDeinit(n);
 }
 
+void swift::swift_retain_pair(HeapObject *object1, HeapObject *object2) {
+  SWIFT_RT_ENTRY_REF(swift_retain)(object1);
+  SWIFT_RT_ENTRY_REF(swift_retain)(object2);
+}
+
+void swift::swift_nonatomic_retain_pair(HeapObject *object1,
+                                        HeapObject *object2) {
+  SWIFT_RT_ENTRY_REF(swift_nonatomic_retain)(object1);
+  SWIFT_RT_ENTRY_REF(swift_nonatomic_retain)(object2);
+}
+
+void swift::swift_release_pair(HeapObject *object1, HeapObject *object2) {
+  SWIFT_RT_ENTRY_REF(swift_release)(object1);
+  SWIFT_RT_ENTRY_REF(swift_release)(object2);
+}
+
+void swift::swift_nonatomic_release_pair(HeapObject *object1,
+                                         HeapObject *object2) {
+  SWIFT_RT_ENTRY_REF(swift_nonatomic_release)(object1);
+  SWIFT_RT_ENTRY_REF(swift_nonatomic_release)(object2);
+}
+
 void swift::swift_setDeallocating(HeapObject *object) {
   SWIFT_RT_TRACK_INVOCATION(object, swift_setDeallocating);
   object->refCounts.decrementFromOneNonAtomic();
@@ -22,9 +22,10 @@
 
 #include "ImageInspection.h"
 #include "swift/Runtime/Debug.h"
+#include <atomic>
+#include <cstdlib>
 #include <dlfcn.h>
-#include <elf.h>
-#include <link.h>
+#include <new>
 #include <string.h>
 
 #if defined(__ANDROID__) || defined(__FreeBSD__)
@@ -42,28 +43,54 @@ static const char ProtocolConformancesSymbol[] =
 static const char TypeMetadataRecordsSymbol[] =
   ".swift2_type_metadata_start";
 
-/// Context arguments passed down from dl_iterate_phdr to its callback.
+/// Context for one type of metadata section to look up.
 struct InspectArgs {
   /// Symbol name to look up.
   const char *symbolName;
   /// Callback function to invoke with the metadata block.
   void (*addBlock)(const void *start, uintptr_t size);
   /// Set to true when initialize*Lookup() is called.
-  bool didInitializeLookup;
+  std::atomic<bool> didInitializeLookup;
+  /// The index of this consumer's claim flag in RegisteredImage::processed.
+  unsigned registryIndex;
 };
 
 static InspectArgs ProtocolConformanceArgs = {
   ProtocolConformancesSymbol,
   addImageProtocolConformanceBlockCallback,
-  false
+  {false},
+  0
 };
 
 static InspectArgs TypeMetadataRecordArgs = {
   TypeMetadataRecordsSymbol,
   addImageTypeMetadataRecordBlockCallback,
-  false
+  {false},
+  1
 };
 
+/// An image which carries Swift metadata sections, published by the
+/// constructor the compiler prepends to every such image (see
+/// ImageInspectionInit.cpp).  The registry deliberately only contains those
+/// images: images without Swift sections are never probed, no matter how
+/// many of them the process loads.
+struct RegisteredImage {
+  /// An address inside the image, usable with dladdr().
+  const void *addr;
+  /// The next (older) entry in the registry.
+  RegisteredImage *next;
+  /// One claim flag per InspectArgs; the consumer which wins the exchange
+  /// hands the image's block to its callback.
+  std::atomic<bool> processed[2];
+};
+
+/// The newest-first list of images carrying Swift sections.  Entries are
+/// pushed lock-free so that registration from an image constructor, which
+/// runs under the loader's lock, can never deadlock against a consumer.
+/// Entries are never removed: the registry also serves as the permanent
+/// record of which images are worth probing.
+static std::atomic<RegisteredImage *> RegisteredImages(nullptr);
+
 
 // Extract the section information for a named section in an image. imageName
 // can be nullptr to specify the main executable.
@@ -98,32 +125,6 @@ static SectionInfo getSectionInfo(const char *imageName,
   return sectionInfo;
 }
 
-static int iteratePHDRCallback(struct dl_phdr_info *info,
-                               size_t size, void *data) {
-  InspectArgs *inspectArgs = reinterpret_cast<InspectArgs *>(data);
-  const char *fname = info->dlpi_name;
-
-  // While dl_iterate_phdr() is in progress it holds a lock to prevent other
-  // images being loaded. The initialize flag is set here inside the callback so
-  // that addNewDSOImage() sees a consistent state. If it was set outside the
-  // dl_iterate_phdr() call then it could result in images being missed or
-  // added twice.
-  inspectArgs->didInitializeLookup = true;
-
-  if (fname == nullptr || fname[0] == '\0') {
-    // The filename may be null for both the dynamic loader and main executable.
-    // So ignore null image name here and explicitly add the main executable
-    // in initialize*Lookup() to avoid adding the data twice.
-    return 0;
-  }
-
-  SectionInfo block = getSectionInfo(fname, inspectArgs->symbolName);
-  if (block.size > 0) {
-    inspectArgs->addBlock(block.data, block.size);
-  }
-  return 0;
-}
-
 // Add the section information in an image specified by an address in that
 // image.
 static void addBlockInImage(const InspectArgs *inspectArgs, const void *addr) {
@@ -141,13 +142,33 @@ static void addBlockInImage(const InspectArgs *inspectArgs, const void *addr) {
   }
 }
 
+/// Hand every not-yet-claimed registered image to \p inspectArgs' callback.
+/// The claim flags make each image visit each consumer exactly once, even
+/// when several threads drain the registry concurrently.
+static void processRegisteredImages(InspectArgs *inspectArgs) {
+  for (RegisteredImage *image = RegisteredImages.load();
+       image != nullptr; image = image->next) {
+    if (!image->processed[inspectArgs->registryIndex].exchange(true))
+      addBlockInImage(inspectArgs, image->addr);
+  }
+}
+
 static void initializeSectionLookup(InspectArgs *inspectArgs) {
-  // Add section data in the main executable.
+  // Add section data in the main executable.  An executable built by the
+  // Swift driver also registers itself through its prepended constructor;
+  // the section registration callbacks reject the resulting duplicate.
   addBlockInImage(inspectArgs, nullptr);
-  // Search the loaded dls. This only searches the already
-  // loaded ones. Any images loaded after this are processed by
-  // addNewDSOImage() below.
-  dl_iterate_phdr(iteratePHDRCallback, reinterpret_cast<void *>(inspectArgs));
+
+  // Publish that lookups of this kind have started.  The flag is written
+  // before the registry is drained so that, together with the
+  // sequentially consistent accesses in swift_addNewDSOImage(), every
+  // image is seen either here or by its registering thread.
+  inspectArgs->didInitializeLookup.store(true);
+
+  // Drain the images registered so far.  This only probes images which
+  // actually carry Swift sections; any image loaded after this is
+  // processed by swift_addNewDSOImage() below.
+  processRegisteredImages(inspectArgs);
 }
 
 void swift::initializeProtocolConformanceLookup() {
@@ -164,13 +185,27 @@ void swift::initializeTypeMetadataRecordLookup() {
 // function has been called.
 SWIFT_RUNTIME_EXPORT
 void swift_addNewDSOImage(const void *addr) {
-  if (ProtocolConformanceArgs.didInitializeLookup) {
-    addBlockInImage(&ProtocolConformanceArgs, addr);
+  // Always enter the image into the registry first.  Before the first
+  // lookup of a section type this is all that happens at image-load time;
+  // the sections are found when the corresponding initialize*Lookup()
+  // drains the registry, which keeps dlopen()/dlsym() probing off the
+  // process launch path.
+  auto *image = static_cast<RegisteredImage *>(malloc(sizeof(RegisteredImage)));
+  image->addr = addr;
+  new (&image->processed[0]) std::atomic<bool>(false);
+  new (&image->processed[1]) std::atomic<bool>(false);
+  image->next = RegisteredImages.load();
+  while (!RegisteredImages.compare_exchange_weak(image->next, image)) {
   }
 
-  if (TypeMetadataRecordArgs.didInitializeLookup) {
-    addBlockInImage(&TypeMetadataRecordArgs, addr);
-  }
+  // Hand the image to any consumer which has already started lookups.
+  // Draining the whole registry instead of just this image also picks up
+  // entries racing with initializeSectionLookup().
+  if (ProtocolConformanceArgs.didInitializeLookup.load())
+    processRegisteredImages(&ProtocolConformanceArgs);
+
+  if (TypeMetadataRecordArgs.didInitializeLookup.load())
+    processRegisteredImages(&TypeMetadataRecordArgs);
 }
 
 int swift::lookupSymbol(const void *address, SymbolInfo *info) {
@@ -106,6 +106,12 @@ namespace {
   };
 } // end anonymous namespace
 
+#ifndef NDEBUG
+// Metadata cache probe statistics; see MetadataCache.h.
+std::atomic<uint64_t> swift::_swift_metadataCacheLookupCount;
+std::atomic<uint64_t> swift::_swift_metadataCacheProbeCount;
+#endif
+
 using GenericMetadataCache = MetadataCache<GenericCacheEntry>;
 using LazyGenericMetadataCache = Lazy<GenericMetadataCache>;
 
@@ -2824,67 +2830,93 @@ uint64_t swift::RelativeDirectPointerNullPtr = 0;
 /*** Allocator implementation **********************************************/
 /***************************************************************************/
 
-namespace {
-  struct PoolRange {
-    static constexpr uintptr_t PageSize = 16 * 1024;
-    static constexpr uintptr_t MaxPoolAllocationSize = PageSize / 2;
-
-    /// The start of the allocation.
-    char *Begin;
-
-    /// The number of bytes remaining.
-    size_t Remaining;
-  };
-} // end anonymous namespace
+using PoolRange = MetadataAllocator::PoolRange;
 
 // A statically-allocated pool.  It's zero-initialized, so this
-// doesn't cost us anything in binary size.
+// doesn't cost us anything in binary size.  The first allocator instance
+// that needs a slab claims it instead of calling out to malloc.
 LLVM_ALIGNAS(alignof(void*)) static char InitialAllocationPool[64*1024];
-static std::atomic<PoolRange>
-AllocationPool{PoolRange{InitialAllocationPool,
-                         sizeof(InitialAllocationPool)}};
+static std::atomic<bool> InitialPoolClaimed{false};
+
+/// Slab occupancy counters, aggregated over all allocator instances.
+/// Slabs are allocated rarely enough that the relaxed increments here are
+/// noise next to the page allocation itself.
+static std::atomic<size_t> MetadataNumSlabs(0);
+static std::atomic<size_t> MetadataSlabBytesCapacity(0);
+static std::atomic<size_t> MetadataSlabBytesUsed(0);
+static std::atomic<size_t> MetadataLargeAllocationBytes(0);
+
+void swift::_swift_getMetadataAllocatorStats(MetadataAllocatorStats *result) {
+  result->NumSlabs = MetadataNumSlabs.load(std::memory_order_relaxed);
+  result->SlabBytesCapacity =
+      MetadataSlabBytesCapacity.load(std::memory_order_relaxed);
+  result->SlabBytesUsed = MetadataSlabBytesUsed.load(std::memory_order_relaxed);
+  result->LargeAllocationBytes =
+      MetadataLargeAllocationBytes.load(std::memory_order_relaxed);
+}
 
 void *MetadataAllocator::Allocate(size_t size, size_t alignment) {
   assert(alignment <= alignof(void*));
   assert(size % alignof(void*) == 0);
 
   // If the size is larger than the maximum, just use malloc.
-  if (size > PoolRange::MaxPoolAllocationSize)
+  if (size > PoolRange::MaxPoolAllocationSize) {
+    MetadataLargeAllocationBytes.fetch_add(size, std::memory_order_relaxed);
     return malloc(size);
+  }
 
-  // Allocate out of the pool.
-  PoolRange curState = AllocationPool.load(std::memory_order_relaxed);
+  // Allocate out of this allocator's slab.
+  PoolRange curState = Pool.load(std::memory_order_relaxed);
   while (true) {
     char *allocation;
     PoolRange newState;
-    bool allocatedNewPage;
+    char *newSlab = nullptr;
+    size_t newSlabSize = 0;
+    bool claimedInitialPool = false;
 
-    // Try to allocate out of the current page.
+    // Try to allocate out of the current slab.
     if (size <= curState.Remaining) {
-      allocatedNewPage = false;
       allocation = curState.Begin;
       newState = PoolRange{curState.Begin + size, curState.Remaining - size};
+    } else if (!InitialPoolClaimed.exchange(true,
+                                            std::memory_order_relaxed)) {
+      claimedInitialPool = true;
+      newSlab = InitialAllocationPool;
+      newSlabSize = sizeof(InitialAllocationPool);
+      allocation = newSlab;
+      newState = PoolRange{newSlab + size, newSlabSize - size};
     } else {
-      allocatedNewPage = true;
-      allocation = new char[PoolRange::PageSize];
-      newState = PoolRange{allocation + size, PoolRange::PageSize - size};
-      __asan_poison_memory_region(allocation, PoolRange::PageSize);
+      newSlab = new char[PoolRange::PageSize];
+      newSlabSize = PoolRange::PageSize;
+      allocation = newSlab;
+      newState = PoolRange{newSlab + size, newSlabSize - size};
+      __asan_poison_memory_region(newSlab, newSlabSize);
     }
 
     // Swap in the new state.
-    if (std::atomic_compare_exchange_weak_explicit(&AllocationPool,
+    if (std::atomic_compare_exchange_weak_explicit(&Pool,
                                                    &curState, newState,
                                               std::memory_order_relaxed,
                                               std::memory_order_relaxed)) {
       // If that succeeded, we've successfully allocated.
       __msan_allocated_memory(allocation, size);
       __asan_unpoison_memory_region(allocation, size);
+      if (newSlab) {
+        MetadataNumSlabs.fetch_add(1, std::memory_order_relaxed);
+        MetadataSlabBytesCapacity.fetch_add(newSlabSize,
+                                            std::memory_order_relaxed);
+      }
+      MetadataSlabBytesUsed.fetch_add(size, std::memory_order_relaxed);
       return allocation;
     }
 
     // If it failed, go back to a neutral state and try again.
-    if (allocatedNewPage) {
-      delete[] allocation;
+    if (claimedInitialPool) {
+      // We were the exclusive claimant, so the claim can simply be
+      // released for the next allocator that needs a slab.
+      InitialPoolClaimed.store(false, std::memory_order_relaxed);
+    } else if (newSlab) {
+      delete[] newSlab;
     }
   }
 }
@@ -2893,13 +2925,14 @@ void MetadataAllocator::Deallocate(const void *allocation, size_t size) {
   __asan_poison_memory_region(allocation, size);
 
   if (size > PoolRange::MaxPoolAllocationSize) {
+    MetadataLargeAllocationBytes.fetch_sub(size, std::memory_order_relaxed);
     free(const_cast<void*>(allocation));
     return;
   }
 
-  // Check whether the allocation pool is still in the state it was in
+  // Check whether this allocator's slab is still in the state it was in
   // immediately after the given allocation.
-  PoolRange curState = AllocationPool.load(std::memory_order_relaxed);
+  PoolRange curState = Pool.load(std::memory_order_relaxed);
   if (reinterpret_cast<const char*>(allocation) + size != curState.Begin) {
     return;
   }
@@ -2908,10 +2941,10 @@ void MetadataAllocator::Deallocate(const void *allocation, size_t size) {
   // don't bother trying again; we'll just leak the allocation.
   PoolRange newState = { reinterpret_cast<char*>(const_cast<void*>(allocation)),
                          curState.Remaining + size };
-  (void)
-    std::atomic_compare_exchange_strong_explicit(&AllocationPool,
-                                                 &curState, newState,
-                                                 std::memory_order_relaxed,
-                                                 std::memory_order_relaxed);
+  if (std::atomic_compare_exchange_strong_explicit(&Pool,
+                                                   &curState, newState,
+                                                   std::memory_order_relaxed,
+                                                   std::memory_order_relaxed))
+    MetadataSlabBytesUsed.fetch_sub(size, std::memory_order_relaxed);
 }
 
@@ -17,6 +17,8 @@
 #include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Metadata.h"
 #include "swift/Runtime/Mutex.h"
+#include <atomic>
+#include <cassert>
 #include <condition_variable>
 #include <thread>
 
@@ -28,6 +30,21 @@ namespace swift {
 
 class MetadataAllocator : public llvm::AllocatorBase<MetadataAllocator> {
 public:
+  /// The bounds of a slab: where the next allocation goes and how much of
+  /// the slab is left.
+  struct PoolRange {
+    static constexpr uintptr_t PageSize = 16 * 1024;
+    static constexpr uintptr_t MaxPoolAllocationSize = PageSize / 2;
+
+    /// The start of the allocation.
+    char *Begin;
+
+    /// The number of bytes remaining.
+    size_t Remaining;
+  };
+
+  constexpr MetadataAllocator() : Pool(PoolRange{nullptr, 0}) {}
+
   void Reset() {}
 
   LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t size, size_t alignment);
@@ -37,6 +54,15 @@ public:
   using AllocatorBase<MetadataAllocator>::Deallocate;
 
   void PrintStats() const {}
+
+private:
+  /// This allocator's current slab. Every allocator instance carves out
+  /// of its own slabs, so allocations that go through the same allocator
+  /// — in particular, instantiations of the same generic pattern, whose
+  /// cache owns one allocator — end up packed into the same pages instead
+  /// of interleaving with every other cache's metadata. All-zero is a
+  /// valid empty state (see MetadataCache).
+  std::atomic<PoolRange> Pool;
 };
 
 /// A typedef for simple global caches.
@@ -174,6 +200,15 @@ public:
   }
 };
 
+#ifndef NDEBUG
+/// Global counters describing metadata cache lookups and open-addressing
+/// probe lengths. Like the counters in RuntimeInvocationsTracking.h, these
+/// are only maintained in asserts builds; the average probe length is
+/// ProbeCount / LookupCount.
+SWIFT_RUNTIME_EXPORT std::atomic<uint64_t> _swift_metadataCacheLookupCount;
+SWIFT_RUNTIME_EXPORT std::atomic<uint64_t> _swift_metadataCacheProbeCount;
+#endif
+
 /// The implementation of a metadata cache.  Note that all-zero must
 /// be a valid state for the cache.
 template <class ValueTy> class MetadataCache {
@@ -228,6 +263,10 @@ template <class ValueTy> class MetadataCache {
       return Hash;
     }
 
+    size_t getKeyHash() const {
+      return Hash;
+    }
+
     static size_t getExtraAllocationSize(const Key &key) {
       return key.KeyData.size() * sizeof(void*);
     }
@@ -257,17 +296,172 @@ template <class ValueTy> class MetadataCache {
     }
   };
 
-  /// The concurrent map.
-  ConcurrentMap<Entry, /*Destructor*/ false, MetadataAllocator> Map;
+  /// An open-addressing index of the entries in the cache, probed with
+  /// linear probing. Once published, a table only ever changes by slots
+  /// going from null to a valid entry, and entries are never removed, so
+  /// readers can probe it without any locking: the first null slot on the
+  /// probe sequence terminates the search. Insertions and growth happen
+  /// under the cache's lock. A table that has been replaced by a grown
+  /// copy is intentionally kept alive because concurrent readers may
+  /// still be probing it; the total waste is bounded by the size of the
+  /// final table, and the metadata allocator never frees anyway.
+  struct HashTable {
+    /// The number of slots. Always a power of two.
+    size_t Capacity;
+
+    /// The number of occupied slots. Only updated under the lock.
+    std::atomic<size_t> NumEntries;
+
+    std::atomic<Entry *> *getSlots() {
+      return reinterpret_cast<std::atomic<Entry *> *>(this + 1);
+    }
 
+    static HashTable *allocate(MetadataAllocator &allocator,
+                               size_t capacity) {
+      assert((capacity & (capacity - 1)) == 0 && "not a power of two");
+      void *buffer = allocator.Allocate(
+          sizeof(HashTable) + capacity * sizeof(std::atomic<Entry *>),
+          alignof(HashTable));
+      auto table = new (buffer) HashTable();
+      table->Capacity = capacity;
+      table->NumEntries.store(0, std::memory_order_relaxed);
+      for (size_t i = 0; i != capacity; ++i)
+        new (&table->getSlots()[i]) std::atomic<Entry *>(nullptr);
+      return table;
+    }
+  };
+
+  enum : size_t { InitialTableCapacity = 16 };
+
+  /// The published table. Null until the first insertion, which keeps
+  /// all-zero a valid state. Only replaced under the lock.
+  std::atomic<HashTable *> Table;
+
+  /// The allocator for entries, tables, and the metadata itself.
+  MetadataAllocator Allocator;
+
+  /// The lock and wait queues of the cache.
+  ///
+  /// Insertions and table growth are serialized by a single lock, but
+  /// threads waiting for another thread to finish initializing an entry
+  /// sleep on one of several wait queues selected by the entry's hash.
+  /// This keeps a storm of threads instantiating *different* metadata from
+  /// convoying on one condition variable: publishing a value only wakes
+  /// the threads whose entry hashes to the same queue, instead of every
+  /// waiter of the cache.
   struct ConcurrencyControl {
+    /// Serializes insertions and table growth.
     Mutex Lock;
-    ConditionVariable Queue;
+
+    /// Must be a power of two.
+    static const size_t NumWaitQueues = 16;
+
+    struct WaitQueue {
+      Mutex Lock;
+      ConditionVariable Queue;
+    };
+    WaitQueue WaitQueues[NumWaitQueues];
+
+    WaitQueue &getWaitQueue(const Entry *entry) {
+      return WaitQueues[entry->getKeyHash() & (NumWaitQueues - 1)];
+    }
   };
   std::unique_ptr<ConcurrencyControl> Concurrency;
 
+  /// Probe \p table for an entry matching \p key. Safe to call from any
+  /// thread without holding the lock.
+  static Entry *find(HashTable *table, const Key &key) {
+    if (!table)
+      return nullptr;
+    auto slots = table->getSlots();
+    size_t mask = table->Capacity - 1;
+#ifndef NDEBUG
+    size_t numProbes = 0;
+#endif
+    for (size_t i = key.Hash & mask; true; i = (i + 1) & mask) {
+#ifndef NDEBUG
+      ++numProbes;
+#endif
+      Entry *entry = slots[i].load(std::memory_order_acquire);
+      if (!entry || entry->compareWithKey(key) == 0) {
+#ifndef NDEBUG
+        _swift_metadataCacheLookupCount.fetch_add(
+            1, std::memory_order_relaxed);
+        _swift_metadataCacheProbeCount.fetch_add(
+            numProbes, std::memory_order_relaxed);
+#endif
+        return entry;
+      }
+    }
+  }
+
+  /// Add \p entry to \p table. Must be called with the lock held, and the
+  /// table must have a free slot.
+  static void insertIntoTable(HashTable *table, Entry *entry) {
+    auto slots = table->getSlots();
+    size_t mask = table->Capacity - 1;
+    size_t i = entry->getKeyHash() & mask;
+    while (slots[i].load(std::memory_order_relaxed))
+      i = (i + 1) & mask;
+    // Publish with a release so that a reader who finds the pointer also
+    // sees the entry's key data.
+    slots[i].store(entry, std::memory_order_release);
+    table->NumEntries.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Return a table with room for one more entry, growing and publishing
+  /// a replacement if the current one is at its load limit. Must be
+  /// called with the lock held.
+  HashTable *getTableWithSpace() {
+    auto table = Table.load(std::memory_order_relaxed);
+    // Grow at 3/4 load to keep linear-probe sequences short.
+    if (table &&
+        (table->NumEntries.load(std::memory_order_relaxed) + 1) * 4 <=
+            table->Capacity * 3)
+      return table;
+
+    size_t newCapacity = table ? table->Capacity * 2
+                               : size_t(InitialTableCapacity);
+    auto newTable = HashTable::allocate(Allocator, newCapacity);
+    if (table) {
+      auto slots = table->getSlots();
+      for (size_t i = 0; i != table->Capacity; ++i)
+        if (Entry *entry = slots[i].load(std::memory_order_relaxed))
+          insertIntoTable(newTable, entry);
+    }
+    Table.store(newTable, std::memory_order_release);
+    return newTable;
+  }
+
+  /// Block until another thread publishes \p entry's value. Sleeps on the
+  /// wait queue assigned to the entry, so only the publication of this
+  /// entry's value (or of another entry hashing to the same queue) wakes
+  /// this thread.
+  const ValueTy *awaitValue(Entry *entry) {
+    ValueTy *value = nullptr;
+    auto &waitQueue = Concurrency->getWaitQueue(entry);
+    waitQueue.Lock.withLockOrWait(waitQueue.Queue, [&, this] {
+      if ((value = entry->getValue())) {
+        return true; // found a value, done waiting
+      }
+
+      // As a QoI safe-guard against the simplest form of cyclic
+      // dependency, check whether this thread is the one responsible
+      // for initializing the metadata.
+      if (entry->isBeingInitializedByCurrentThread()) {
+        fprintf(stderr,
+                "%s(%p): cyclic metadata dependency detected, aborting\n",
+                ValueTy::getName(), (void*) this);
+        abort();
+      }
+
+      return false; // don't have a value, continue waiting
+    });
+    return value;
+  }
+
 public:
-  MetadataCache() : Concurrency(new ConcurrencyControl()) {}
+  MetadataCache() : Table(nullptr), Concurrency(new ConcurrencyControl()) {}
   ~MetadataCache() = default;
 
   /// Caches are not copyable.
@@ -277,7 +471,7 @@ public:
   /// Get the allocator for metadata in this cache.
   /// The allocator can only be safely used while the cache is locked during
   /// an addMetadataEntry call.
-  MetadataAllocator &getAllocator() { return Map.getAllocator(); }
+  MetadataAllocator &getAllocator() { return Allocator; }
 
   /// Look up a cached metadata entry. If a cache match exists, return it.
   /// Otherwise, call entryBuilder() and add that to the cache.
@@ -299,43 +493,43 @@ public:
            ValueTy::getName(), this, key.Hash);
 #endif
 
-    // Ensure the existence of a map entry.
-    auto insertResult = Map.getOrInsert(key);
-    Entry *entry = insertResult.first;
+    // Fast path: probe the published table without taking any lock. For an
+    // already-instantiated metadata this is one acquire-load of the table
+    // pointer, a (usually single-probe) scan of the table, and one
+    // acquire-load of the entry's HasValue flag.
+    if (Entry *entry = find(Table.load(std::memory_order_acquire), key)) {
+      // If the entry is already initialized, great.
+      if (auto value = entry->getValue()) {
+        return value;
+      }
+      // Otherwise, wait for the initializing thread to publish the value.
+      return awaitValue(entry);
+    }
+
+    // Slow path: take the lock and insert an entry, unless a racing
+    // thread inserted one since we probed.
+    auto concurrency = Concurrency.get();
+    Entry *entry = nullptr;
+    bool inserted = false;
+    concurrency->Lock.withLock([&, this] {
+      if ((entry = find(Table.load(std::memory_order_relaxed), key)))
+        return;
+
+      auto table = getTableWithSpace();
+      void *buffer = Allocator.Allocate(
+          sizeof(Entry) + Entry::getExtraAllocationSize(key), alignof(Entry));
+      entry = new (buffer) Entry(key);
+      insertIntoTable(table, entry);
+      inserted = true;
+    });
 
     // If we didn't insert the entry, then we just need to get the
     // initialized value from the entry.
-    if (!insertResult.second) {
-
-      // If the entry is already initialized, great.
-      auto value = entry->getValue();
-      if (value) {
+    if (!inserted) {
+      if (auto value = entry->getValue()) {
         return value;
       }
-
-      // Otherwise, we have to grab the lock and wait for the value to
-      // appear there.  Note that we have to check again immediately
-      // after acquiring the lock to prevent a race.
-      auto concurrency = Concurrency.get();
-      concurrency->Lock.withLockOrWait(concurrency->Queue, [&, this] {
-        if ((value = entry->getValue())) {
-          return true; // found a value, done waiting
-        }
-
-        // As a QoI safe-guard against the simplest form of cyclic
-        // dependency, check whether this thread is the one responsible
-        // for initializing the metadata.
-        if (entry->isBeingInitializedByCurrentThread()) {
-          fprintf(stderr,
-                  "%s(%p): cyclic metadata dependency detected, aborting\n",
-                  ValueTy::getName(), (void*) this);
-          abort();
-        }
-
-        return false; // don't have a value, continue waiting
-      });
-
-      return value;
+      return awaitValue(entry);
     }
 
     // Otherwise, we created the entry and are responsible for
@@ -347,10 +541,11 @@ public:
                ValueTy::getName(), (void*) this, value);
 #endif
 
-    // Acquire the lock, set the value, and notify any waiters.
-    auto concurrency = Concurrency.get();
-    concurrency->Lock.withLockThenNotifyAll(
-        concurrency->Queue, [&entry, &value] { entry->setValue(value); });
+    // Acquire the entry's wait queue lock, set the value, and notify any
+    // waiters sleeping on that queue.
+    auto &waitQueue = concurrency->getWaitQueue(entry);
+    waitQueue.Lock.withLockThenNotifyAll(
+        waitQueue.Queue, [&entry, &value] { entry->setValue(value); });
 
     return value;
   }
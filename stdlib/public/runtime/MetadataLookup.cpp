@@ -21,12 +21,14 @@
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
 #include "swift/Runtime/Mutex.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/PointerIntPair.h"
 #include "llvm/ADT/StringExtras.h"
 #include "Private.h"
 #include "ImageInspection.h"
+#include <algorithm>
 
 using namespace swift;
 using namespace Demangle;
@@ -75,16 +77,109 @@ namespace {
   };
 } // end anonymous namespace
 
+/// Returns the mangled name of the type referenced by \p record, or an
+/// empty string if the name cannot be determined without instantiating
+/// metadata. Records without a determinable name are kept in a separate
+/// overflow list and matched by the original linear scan.
+static llvm::StringRef getRecordTypeName(const TypeMetadataRecord &record) {
+  const NominalTypeDescriptor *ntd = nullptr;
+  switch (record.getTypeKind()) {
+  case TypeMetadataRecordKind::UniqueNominalTypeDescriptor:
+    ntd = record.getNominalTypeDescriptor();
+    break;
+
+  case TypeMetadataRecordKind::UniqueDirectType:
+  case TypeMetadataRecordKind::NonuniqueDirectType:
+  case TypeMetadataRecordKind::UniqueDirectClass:
+    // Read the descriptor off the statically emitted metadata. For a
+    // nonunique foreign type this is not the canonical metadata, but the
+    // descriptor (and thus the name) is shared with the canonical one.
+    if (auto *metadata = record.getDirectType())
+      ntd = metadata->getNominalTypeDescriptor();
+    break;
+
+  default:
+    break;
+  }
+
+  if (ntd == nullptr)
+    return llvm::StringRef();
+  return ntd->Name.get();
+}
+
 struct TypeMetadataState {
   ConcurrentMap<TypeMetadataCacheEntry> Cache;
   std::vector<TypeMetadataSection> SectionsToScan;
   Mutex SectionsToScanLock;
 
-  TypeMetadataState() {
+  /// An index of all records of the sections indexed so far, sorted by
+  /// mangled type name so that a lookup is a binary search instead of a
+  /// linear scan over every record of every image. Lazily extended under
+  /// SectionsToScanLock when a lookup misses the cache.
+  std::vector<std::pair<llvm::StringRef, const TypeMetadataRecord *>>
+      NameIndex;
+
+  /// Records whose name could not be determined while indexing; these are
+  /// matched by the original linear scan.
+  std::vector<const TypeMetadataRecord *> UnindexedRecords;
+
+  /// The number of sections already merged into NameIndex.
+  unsigned NumIndexedSections;
+
+  TypeMetadataState() : NumIndexedSections(0) {
     SectionsToScan.reserve(16);
     initializeTypeMetadataRecordLookup();
   }
 
+  /// Merge any newly registered sections into the name index. Must be
+  /// called with SectionsToScanLock held.
+  void updateNameIndex() {
+    unsigned numSections = SectionsToScan.size();
+    if (NumIndexedSections == numSections)
+      return;
+
+    for (unsigned i = NumIndexedSections; i != numSections; ++i) {
+      for (const auto &record : SectionsToScan[i]) {
+        auto name = getRecordTypeName(record);
+        if (name.empty())
+          UnindexedRecords.push_back(&record);
+        else
+          NameIndex.push_back({name, &record});
+      }
+    }
+    NumIndexedSections = numSections;
+
+    std::stable_sort(NameIndex.begin(), NameIndex.end(),
+                     [](const std::pair<llvm::StringRef,
+                                        const TypeMetadataRecord *> &lhs,
+                        const std::pair<llvm::StringRef,
+                                        const TypeMetadataRecord *> &rhs) {
+                       return lhs.first < rhs.first;
+                     });
+  }
+
+  /// Returns the indexed records whose type name is \p typeName. Must be
+  /// called with SectionsToScanLock held, after updateNameIndex().
+  llvm::ArrayRef<std::pair<llvm::StringRef, const TypeMetadataRecord *>>
+  getRecordsForName(llvm::StringRef typeName) const {
+    struct NameIndexComparator {
+      bool operator()(const std::pair<llvm::StringRef,
+                                      const TypeMetadataRecord *> &lhs,
+                      llvm::StringRef rhs) const {
+        return lhs.first < rhs;
+      }
+      bool operator()(llvm::StringRef lhs,
+                      const std::pair<llvm::StringRef,
+                                      const TypeMetadataRecord *> &rhs) const {
+        return lhs < rhs.first;
+      }
+    };
+    auto range = std::equal_range(NameIndex.begin(), NameIndex.end(),
+                                  typeName, NameIndexComparator());
+    if (range.first == range.second)
+      return {};
+    return {&*range.first, size_t(range.second - range.first)};
+  }
 };
 
 static Lazy<TypeMetadataState> TypeMetadataRecords;
@@ -94,6 +189,14 @@ _registerTypeMetadataRecords(TypeMetadataState &T,
                              const TypeMetadataRecord *begin,
                              const TypeMetadataRecord *end) {
   ScopedLock guard(T.SectionsToScanLock);
+
+  // The same section can be registered twice, e.g. for a main executable
+  // which is both probed directly by the image inspection code and
+  // registered by its prepended constructor.
+  for (const auto &section : T.SectionsToScan)
+    if (section.Begin == begin)
+      return;
+
   T.SectionsToScan.push_back(TypeMetadataSection{begin, end});
 }
 
@@ -169,25 +272,40 @@ swift::_matchMetadataByMangledTypeName(const llvm::StringRef typeName,
   return metadata;
 }
 
+// Matches a single type metadata record against typeName, canonicalizing
+// its metadata if necessary.
+static const Metadata *
+_matchTypeMetadataRecord(const TypeMetadataRecord &record,
+                         const llvm::StringRef typeName) {
+  if (auto metadata = record.getCanonicalTypeMetadata())
+    return _matchMetadataByMangledTypeName(typeName, metadata, nullptr);
+  if (record.getTypeKind() ==
+        TypeMetadataRecordKind::UniqueNominalTypeDescriptor) {
+    if (auto ntd = record.getNominalTypeDescriptor())
+      return _matchMetadataByMangledTypeName(typeName, nullptr, ntd);
+  }
+  return nullptr;
+}
+
 // returns the type metadata for the type named by typeName
 static const Metadata *
-_searchTypeMetadataRecords(const TypeMetadataState &T,
+_searchTypeMetadataRecords(TypeMetadataState &T,
                            const llvm::StringRef typeName) {
-  unsigned sectionIdx = 0;
-  unsigned endSectionIdx = T.SectionsToScan.size();
-  const Metadata *foundMetadata = nullptr;
-
-  for (; sectionIdx < endSectionIdx; ++sectionIdx) {
-    auto &section = T.SectionsToScan[sectionIdx];
-    for (const auto &record : section) {
-      if (auto metadata = record.getCanonicalTypeMetadata())
-        foundMetadata = _matchMetadataByMangledTypeName(typeName, metadata, nullptr);
-      else if (auto ntd = record.getNominalTypeDescriptor())
-        foundMetadata = _matchMetadataByMangledTypeName(typeName, nullptr, ntd);
+  T.updateNameIndex();
+
+  // Binary-search the name index; only the records actually carrying this
+  // name are examined (and possibly canonicalized).
+  for (const auto &indexEntry : T.getRecordsForName(typeName)) {
+    if (auto foundMetadata = _matchTypeMetadataRecord(*indexEntry.second,
+                                                      typeName))
+      return foundMetadata;
+  }
 
-      if (foundMetadata != nullptr)
-        return foundMetadata;
-    }
+  // Fall back to scanning the few records whose name could not be
+  // determined while indexing.
+  for (const TypeMetadataRecord *record : T.UnindexedRecords) {
+    if (auto foundMetadata = _matchTypeMetadataRecord(*record, typeName))
+      return foundMetadata;
   }
 
   return nullptr;
@@ -22,6 +22,8 @@
 #include "swift/Runtime/Metadata.h"
 #include "llvm/Support/Compiler.h"
 
+#include <atomic>
+
 // Opaque ISAs need to use object_getClass which is in runtime.h
 #if SWIFT_HAS_OPAQUE_ISAS
 #include <objc/runtime.h>
@@ -185,6 +187,15 @@ namespace swift {
                      void (*function)(void *));
 #endif
 
+  /// The number of live allocation arenas in the process (see Arena.cpp).
+  /// swift_slowDealloc only has to consider arenas when this is non-zero.
+  extern std::atomic<size_t> _swift_numLiveArenas;
+
+  /// Returns true if \p p points into a chunk owned by a live allocation
+  /// arena. Such memory must not be freed individually; it is released
+  /// wholesale by swift_arenaDestroy.
+  bool _swift_arenaContains(const void *p);
+
   static inline const Metadata *getMetadataForClass(const ClassMetadata *c) {
 #if SWIFT_OBJC_INTEROP
     return swift_getObjCClassMetadata(c);
@@ -24,6 +24,8 @@
 #include "ImageInspection.h"
 #include "Private.h"
 
+#include <algorithm>
+
 #include <vector>
 
 using namespace swift;
@@ -225,13 +227,68 @@ namespace {
 struct ConformanceState {
   ConcurrentMap<ConformanceCacheEntry> Cache;
   std::vector<ConformanceSection> SectionsToScan;
+
+  /// Every record in SectionsToScan[0..NumIndexedSections), sorted by the
+  /// protocol it conforms to, so that a cache miss for one protocol only
+  /// has to look at that protocol's slice of the records instead of
+  /// rescanning every section. Guarded by SectionsToScanLock.
+  std::vector<std::pair<const ProtocolDescriptor *,
+                        const ProtocolConformanceRecord *>> ProtocolIndex;
+  size_t NumIndexedSections;
+
   Mutex SectionsToScanLock;
-  
-  ConformanceState() {
+
+  ConformanceState() : NumIndexedSections(0) {
     SectionsToScan.reserve(16);
     initializeProtocolConformanceLookup();
   }
 
+  /// Pull any newly registered sections into ProtocolIndex. Must be called
+  /// with SectionsToScanLock held.
+  void updateProtocolIndex() {
+    if (NumIndexedSections == SectionsToScan.size())
+      return;
+
+    for (size_t i = NumIndexedSections, e = SectionsToScan.size(); i != e; ++i)
+      for (const auto &record : SectionsToScan[i])
+        ProtocolIndex.push_back({record.getProtocol(), &record});
+    NumIndexedSections = SectionsToScan.size();
+
+    // Sort stably by protocol so that records within one protocol keep
+    // their registration order.
+    std::stable_sort(ProtocolIndex.begin(), ProtocolIndex.end(),
+                     [](const decltype(ProtocolIndex)::value_type &lhs,
+                        const decltype(ProtocolIndex)::value_type &rhs) {
+      return uintptr_t(lhs.first) < uintptr_t(rhs.first);
+    });
+  }
+
+  /// Return the slice of ProtocolIndex covering \p protocol. Must be called
+  /// with SectionsToScanLock held, after updateProtocolIndex().
+  ArrayRef<std::pair<const ProtocolDescriptor *,
+                     const ProtocolConformanceRecord *>>
+  getRecordsForProtocol(const ProtocolDescriptor *protocol) const {
+    auto range = std::equal_range(
+        ProtocolIndex.begin(), ProtocolIndex.end(), protocol,
+        ProtocolIndexComparator());
+    if (range.first == range.second)
+      return {};
+    return {&*range.first, size_t(range.second - range.first)};
+  }
+
+  struct ProtocolIndexComparator {
+    using IndexEntry = std::pair<const ProtocolDescriptor *,
+                                 const ProtocolConformanceRecord *>;
+    bool operator()(const IndexEntry &entry,
+                    const ProtocolDescriptor *proto) const {
+      return uintptr_t(entry.first) < uintptr_t(proto);
+    }
+    bool operator()(const ProtocolDescriptor *proto,
+                    const IndexEntry &entry) const {
+      return uintptr_t(proto) < uintptr_t(entry.first);
+    }
+  };
+
   void cacheSuccess(const void *type, const ProtocolDescriptor *proto,
                     const WitnessTable *witness) {
     auto result = Cache.getOrInsert(ConformanceCacheKey(type, proto),
@@ -268,6 +325,14 @@ _registerProtocolConformances(ConformanceState &C,
                               const ProtocolConformanceRecord *begin,
                               const ProtocolConformanceRecord *end) {
   ScopedLock guard(C.SectionsToScanLock);
+
+  // The same section can be registered twice, e.g. for a main executable
+  // which is both probed directly by the image inspection code and
+  // registered by its prepended constructor.
+  for (const auto &section : C.SectionsToScan)
+    if (section.Begin == begin)
+      return;
+
   C.SectionsToScan.push_back(ConformanceSection{begin, end});
 }
 
@@ -491,79 +556,66 @@ swift::swift_conformsToProtocol(const Metadata * const type,
   // We are now caught up after acquiring the lock.
   // Prepare to scan conformance records.
 
-  // Scan only sections that were not scanned yet.
-  // If we found an out-of-date negative cache entry,
-  // we need not to re-scan the sections that it covers.
+  // If we found an out-of-date negative cache entry and no new sections
+  // were registered since it was cached, we can cache failure and give up
+  // now; nothing it has not already seen could have appeared.
   unsigned startSectionIdx =
     failureEntry ? failureEntry->getFailureGeneration() : 0;
 
   unsigned endSectionIdx = C.SectionsToScan.size();
 
-  // If there are no unscanned sections outstanding
-  // then we can cache failure and give up now.
   if (startSectionIdx == endSectionIdx) {
     C.cacheFailure(type, protocol);
     return nullptr;
   }
 
-  // Really scan conformance records.
+  // Really scan conformance records. Rather than walking every record in
+  // every section, keep the protocol-sorted index up to date and consider
+  // only this protocol's slice of the records.
+  C.updateProtocolIndex();
+
+  // Eagerly pull records for nondependent witnesses into our cache.
+  for (const auto &indexEntry : C.getRecordsForProtocol(protocol)) {
+    const auto &record = *indexEntry.second;
+
+    // If the record applies to a specific type, cache it.
+    if (auto metadata = record.getCanonicalTypeMetadata()) {
+      if (!isRelatedType(type, metadata, /*candidateIsMetadata=*/true))
+        continue;
+
+      // Store the type-protocol pair in the cache.
+      auto witness = record.getWitnessTable(metadata);
+      if (witness) {
+        C.cacheSuccess(metadata, protocol, witness);
+      } else {
+        C.cacheFailure(metadata, protocol);
+      }
+
+    // TODO: "Nondependent witness table" probably deserves its own flag.
+    // An accessor function might still be necessary even if the witness table
+    // can be shared.
+    } else if (record.getTypeKind()
+                 == TypeMetadataRecordKind::UniqueNominalTypeDescriptor) {
+
+      auto R = record.getNominalTypeDescriptor();
+
+      if (!isRelatedType(type, R, /*candidateIsMetadata=*/false))
+        continue;
+
+      // Store the type-protocol pair in the cache.
+      switch (record.getConformanceKind()) {
+      case ProtocolConformanceReferenceKind::WitnessTable:
+        // If the record provides a nondependent witness table for all
+        // instances of a generic type, cache it for the generic pattern.
+        C.cacheSuccess(R, protocol, record.getStaticWitnessTable());
+        break;
+
+      case ProtocolConformanceReferenceKind::WitnessTableAccessor:
+        // If the record provides a dependent witness table accessor,
+        // cache the result for the instantiated type metadata.
+        C.cacheSuccess(type, protocol, record.getWitnessTable(type));
+        break;
 
-  for (unsigned sectionIdx = startSectionIdx;
-       sectionIdx < endSectionIdx;
-       ++sectionIdx) {
-    auto &section = C.SectionsToScan[sectionIdx];
-    // Eagerly pull records for nondependent witnesses into our cache.
-    for (const auto &record : section) {
-      // If the record applies to a specific type, cache it.
-      if (auto metadata = record.getCanonicalTypeMetadata()) {
-        auto P = record.getProtocol();
-
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
-
-        if (!isRelatedType(type, metadata, /*candidateIsMetadata=*/true))
-          continue;
-
-        // Store the type-protocol pair in the cache.
-        auto witness = record.getWitnessTable(metadata);
-        if (witness) {
-          C.cacheSuccess(metadata, P, witness);
-        } else {
-          C.cacheFailure(metadata, P);
-        }
-
-      // TODO: "Nondependent witness table" probably deserves its own flag.
-      // An accessor function might still be necessary even if the witness table
-      // can be shared.
-      } else if (record.getTypeKind()
-                   == TypeMetadataRecordKind::UniqueNominalTypeDescriptor) {
-
-        auto R = record.getNominalTypeDescriptor();
-        auto P = record.getProtocol();
-
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
-
-        if (!isRelatedType(type, R, /*candidateIsMetadata=*/false))
-          continue;
-
-        // Store the type-protocol pair in the cache.
-        switch (record.getConformanceKind()) {
-        case ProtocolConformanceReferenceKind::WitnessTable:
-          // If the record provides a nondependent witness table for all
-          // instances of a generic type, cache it for the generic pattern.
-          C.cacheSuccess(R, P, record.getStaticWitnessTable());
-          break;
-
-        case ProtocolConformanceReferenceKind::WitnessTableAccessor:
-          // If the record provides a dependent witness table accessor,
-          // cache the result for the instantiated type metadata.
-          C.cacheSuccess(type, P, record.getWitnessTable(type));
-          break;
-
-        }
       }
     }
   }
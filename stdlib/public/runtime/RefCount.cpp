@@ -10,7 +10,83 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "swift/Runtime/Debug.h"
 #include "swift/Runtime/HeapObject.h"
+#include <cstdlib>
+
+// Pick whether the per-thread side table entry pool is available; without
+// thread_local support the entries come straight from malloc.
+#if defined(__clang__) && !__has_feature(cxx_thread_local)
+#define SWIFT_HAS_SIDE_TABLE_POOL 0
+#else
+#define SWIFT_HAS_SIDE_TABLE_POOL 1
+#endif
+
+#if SWIFT_HAS_SIDE_TABLE_POOL
+namespace {
+
+/// A per-thread free list of side table entry allocations.
+///
+/// Weak-heavy code allocates and frees side table entries constantly;
+/// recycling them within a thread avoids both the malloc round trip and
+/// its lock. Entries can be freed by a different thread than the one that
+/// allocated them (the last weak reference can die anywhere); that only
+/// moves a block from one thread's pool to another's, which is harmless
+/// because all blocks come from malloc. The pool is capped so that a
+/// burst of churn doesn't permanently pin memory to one thread.
+struct SideTablePool {
+  struct Node {
+    Node *Next;
+  };
+
+  Node *Head = nullptr;
+  unsigned Count = 0;
+
+  enum : unsigned { MaxCount = 64 };
+
+  ~SideTablePool() {
+    while (Head) {
+      Node *next = Head->Next;
+      free(Head);
+      Head = next;
+    }
+  }
+};
+
+} // end anonymous namespace
+
+static thread_local SideTablePool TheSideTablePool;
+#endif
+
+void *swift::HeapObjectSideTableEntry::operator new(size_t size) {
+  assert(size == sizeof(HeapObjectSideTableEntry));
+#if SWIFT_HAS_SIDE_TABLE_POOL
+  auto &pool = TheSideTablePool;
+  if (auto node = pool.Head) {
+    pool.Head = node->Next;
+    pool.Count--;
+    return node;
+  }
+#endif
+  void *p = malloc(size);
+  if (!p)
+    swift::crash("Could not allocate memory.");
+  return p;
+}
+
+void swift::HeapObjectSideTableEntry::operator delete(void *p) {
+#if SWIFT_HAS_SIDE_TABLE_POOL
+  auto &pool = TheSideTablePool;
+  if (pool.Count < SideTablePool::MaxCount) {
+    auto node = static_cast<SideTablePool::Node *>(p);
+    node->Next = pool.Head;
+    pool.Head = node;
+    pool.Count++;
+    return;
+  }
+#endif
+  free(p);
+}
 
 namespace swift {
 
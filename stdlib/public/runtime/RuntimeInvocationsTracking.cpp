@@ -20,6 +20,15 @@
 #include "swift/Basic/Lazy.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Mutex.h"
+#include <atomic>
+
+// Pick whether per-thread sample buffers are available; without thread_local
+// support sampled invocations go straight to the global ring.
+#if defined(__clang__) && !__has_feature(cxx_thread_local)
+#define SWIFT_HAS_SAMPLE_BUFFERS 0
+#else
+#define SWIFT_HAS_SAMPLE_BUFFERS 1
+#endif
 
 // This file is compiled always, even if assertions are disabled and no runtime
 // functions are being tracked. This is done to avoid recompiling Swift clients
@@ -97,11 +106,98 @@ static uint16_t RuntimeFunctionCountersOffsets[] = {
 #include "RuntimeInvocationsTracking.def"
 };
 
+/// The current sampling rate. A non-zero rate N means every Nth tracked
+/// invocation per thread is recorded; zero means sampling is off.
+static std::atomic<uint32_t> RuntimeFunctionSamplingRate(0);
+
+/// The global ring of samples flushed from the per-thread buffers. When the
+/// ring overflows, the oldest samples are overwritten; a poller that falls
+/// behind loses history rather than slowing the mutators down.
+struct RuntimeFunctionSampleRing {
+  /// Must be a power of 2.
+  static const uint64_t Capacity = 4096;
+  RuntimeFunctionInvocationSample Samples[Capacity];
+  /// Monotonically increasing; the slot of sample i is i % Capacity.
+  uint64_t WriteIndex = 0;
+  uint64_t ReadIndex = 0;
+  StaticReadWriteLock Lock;
+};
+static Lazy<RuntimeFunctionSampleRing> RuntimeFunctionSamples;
+
+/// Append a batch of samples to the global ring.
+static void _swift_flushRuntimeFunctionSamples(
+    const RuntimeFunctionInvocationSample *samples, unsigned count) {
+  auto &ring = RuntimeFunctionSamples.get();
+  StaticScopedWriteLock lock(ring.Lock);
+  for (unsigned i = 0; i < count; ++i)
+    ring.Samples[ring.WriteIndex++ % RuntimeFunctionSampleRing::Capacity] =
+        samples[i];
+}
+
+#if SWIFT_HAS_SAMPLE_BUFFERS
+/// A per-thread buffer of pending samples. Batching the flushes keeps the
+/// ring's lock out of the common path; the buffer drains to the ring when it
+/// fills up and when the thread exits.
+struct RuntimeFunctionSampleBuffer {
+  static const unsigned Capacity = 64;
+  RuntimeFunctionInvocationSample Samples[Capacity];
+  unsigned Count = 0;
+  /// Invocations remaining until the next sample is taken.
+  uint32_t Countdown = 0;
+
+  ~RuntimeFunctionSampleBuffer() {
+    if (Count)
+      _swift_flushRuntimeFunctionSamples(Samples, Count);
+  }
+};
+static thread_local RuntimeFunctionSampleBuffer RuntimeFunctionSampleBuf;
+#else
+/// Without thread_local the countdown is shared by all threads and samples
+/// are pushed to the ring one at a time.
+static std::atomic<uint32_t> RuntimeFunctionSampleCountdown(0);
+#endif
+
+/// Record one out of every RuntimeFunctionSamplingRate tracked invocations.
+/// The caller has already checked that sampling is enabled.
+static void _swift_sampleRuntimeFunctionInvocation(HeapObject *object,
+                                                   uint32_t functionID) {
+  auto rate = RuntimeFunctionSamplingRate.load(std::memory_order_relaxed);
+#if SWIFT_HAS_SAMPLE_BUFFERS
+  auto &buffer = RuntimeFunctionSampleBuf;
+  if (buffer.Countdown == 0)
+    buffer.Countdown = rate;
+  if (--buffer.Countdown != 0)
+    return;
+  buffer.Countdown = rate;
+  auto &sample = buffer.Samples[buffer.Count++];
+  sample.TypeMetadata = object ? object->metadata : nullptr;
+  sample.FunctionID = functionID;
+  if (buffer.Count == RuntimeFunctionSampleBuffer::Capacity) {
+    _swift_flushRuntimeFunctionSamples(buffer.Samples, buffer.Count);
+    buffer.Count = 0;
+  }
+#else
+  uint32_t countdown =
+      RuntimeFunctionSampleCountdown.fetch_sub(1, std::memory_order_relaxed);
+  if (countdown > 1)
+    return;
+  RuntimeFunctionSampleCountdown.store(rate, std::memory_order_relaxed);
+  RuntimeFunctionInvocationSample sample = {
+      object ? object->metadata : nullptr, functionID};
+  _swift_flushRuntimeFunctionSamples(&sample, 1);
+#endif
+}
+
 /// Define implementations of tracking functions.
 /// TODO: Track only objects that were registered for tracking?
 /// TODO: Perform atomic increments?
 #define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
   void SWIFT_RT_TRACK_INVOCATION_NAME(RT_FUNCTION)(HeapObject * object) {      \
+    /* Record a sample if sampling is enabled. This works independently */     \
+    /* of the counting modes below. */                                         \
+    if (RuntimeFunctionSamplingRate.load(std::memory_order_relaxed))           \
+      _swift_sampleRuntimeFunctionInvocation(object,                           \
+                                             RT_FUNCTION_ID(RT_FUNCTION));     \
     /* Update global counters. */                                              \
     if (UpdateGlobalRuntimeFunctionCounters) {                                 \
       StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);     \
@@ -235,6 +331,28 @@ _swift_setGlobalRuntimeFunctionCountersUpdateHandler(
   return oldHandler;
 }
 
+/// Set the sampling rate for runtime function invocation sampling.
+/// Return the old sampling rate.
+uint32_t _swift_setRuntimeFunctionCountersSamplingRate(uint32_t rate) {
+  return RuntimeFunctionSamplingRate.exchange(rate, std::memory_order_relaxed);
+}
+
+/// Drain up to maxSamples accumulated samples into the provided buffer,
+/// oldest first. Return the number of samples written.
+uint64_t _swift_readRuntimeFunctionInvocationSamples(
+    RuntimeFunctionInvocationSample *buffer, uint64_t maxSamples) {
+  auto &ring = RuntimeFunctionSamples.get();
+  StaticScopedWriteLock lock(ring.Lock);
+  // If the writers lapped us, the oldest unread samples are gone.
+  if (ring.WriteIndex - ring.ReadIndex > RuntimeFunctionSampleRing::Capacity)
+    ring.ReadIndex = ring.WriteIndex - RuntimeFunctionSampleRing::Capacity;
+  uint64_t numRead = 0;
+  while (numRead < maxSamples && ring.ReadIndex != ring.WriteIndex)
+    buffer[numRead++] =
+        ring.Samples[ring.ReadIndex++ % RuntimeFunctionSampleRing::Capacity];
+  return numRead;
+}
+
 /// TODO: Provide an API to remove any counters releated to a specific object
 /// or all objects.
 /// This is useful if you want to reset the stats for some/all objects.
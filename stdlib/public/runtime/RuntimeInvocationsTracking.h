@@ -59,6 +59,19 @@ struct RuntimeFunctionCountersState;
 
 #endif // NDEBUG
 
+/// A single sampled runtime function invocation, as produced by the
+/// sampling mode (see _swift_setRuntimeFunctionCountersSamplingRate).
+struct RuntimeFunctionInvocationSample {
+  /// The metadata of the object the runtime function was invoked on, or
+  /// null if the invocation was not attributable to an object. The caller
+  /// can map this to a type name.
+  const void *TypeMetadata;
+
+  /// The id of the runtime function. Ids are indices into the array
+  /// returned by _swift_getRuntimeFunctionNames.
+  uint64_t FunctionID;
+};
+
 /// This type defines a callback to be called on any intercepted runtime
 /// function.
 using RuntimeFunctionCountersUpdateHandler =
@@ -118,4 +131,22 @@ SWIFT_RUNTIME_EXPORT RuntimeFunctionCountersUpdateHandler
 _swift_setGlobalRuntimeFunctionCountersUpdateHandler(
     RuntimeFunctionCountersUpdateHandler handler);
 
+/// Set the sampling rate for runtime function invocation sampling.
+/// A rate of N records every Nth tracked invocation per thread into a
+/// global ring of samples; a rate of 0 disables sampling. Unlike the full
+/// counting modes, sampling costs one relaxed load and a thread-local
+/// decrement per invocation and is therefore suitable for always-on use.
+/// Return the old sampling rate.
+SWIFT_RUNTIME_EXPORT uint32_t
+_swift_setRuntimeFunctionCountersSamplingRate(uint32_t rate);
+
+/// Drain up to maxSamples accumulated samples into the provided buffer,
+/// oldest first, and return the number of samples written. If the ring
+/// overflowed since the last poll, the oldest samples are lost. Samples
+/// still sitting in the per-thread buffers of other threads are not
+/// returned until those buffers fill up and flush.
+SWIFT_RUNTIME_EXPORT uint64_t
+_swift_readRuntimeFunctionInvocationSamples(
+    RuntimeFunctionInvocationSample *buffer, uint64_t maxSamples);
+
 #endif
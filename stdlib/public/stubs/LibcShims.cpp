@@ -72,6 +72,51 @@ int swift::_swift_stdlib_memcmp(const void *s1, const void *s2,
   return memcmp(s1, s2, n);
 }
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+SWIFT_RUNTIME_STDLIB_INTERFACE
+__swift_size_t swift::_swift_stdlib_asciiPrefixLength(const void *s,
+                                                      __swift_size_t n) {
+  auto p = static_cast<const unsigned char *>(s);
+  __swift_size_t i = 0;
+
+  // Classify 16 bytes at a time where the target supports it, and fall back
+  // to whole machine words elsewhere; only the sub-word tail is examined
+  // byte by byte. On a non-ASCII chunk, drop to the byte loop to find the
+  // exact boundary.
+#if defined(__SSE2__)
+  while (i + 16 <= n) {
+    auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    if (_mm_movemask_epi8(chunk) != 0)
+      break;
+    i += 16;
+  }
+#elif defined(__aarch64__)
+  while (i + 16 <= n) {
+    uint8x16_t chunk = vld1q_u8(p + i);
+    if (vmaxvq_u8(chunk) > 0x7f)
+      break;
+    i += 16;
+  }
+#else
+  while (i + sizeof(uintptr_t) <= n) {
+    uintptr_t chunk;
+    memcpy(&chunk, p + i, sizeof(uintptr_t));
+    if (chunk & (uintptr_t)0x8080808080808080ull)
+      break;
+    i += sizeof(uintptr_t);
+  }
+#endif
+
+  while (i < n && p[i] < 0x80)
+    ++i;
+  return i;
+}
+
 SWIFT_RUNTIME_STDLIB_INTERFACE
 __swift_ssize_t
 swift::_swift_stdlib_read(int fd, void *buf, __swift_size_t nbyte) {
@@ -176,3 +176,16 @@ func + (lhs: B_28688585, rhs: B_28688585) -> B_28688585 {
 
 let var_28688585 = D_28688585(value: 1)
 _ = var_28688585 + var_28688585 + var_28688585 // Ok
+
+// A unary operator whose single parameter is a tuple is still unary; the
+// arity-based overload pruning must not count the tuple's elements.
+prefix func - (t: (Int, Int)) -> Int { return t.0 - t.1 }
+
+prefix operator %%%
+prefix func %%% (t: (Int, Int, Int)) -> Int { return t.0 }
+
+func useUnaryTupleParameterOperators(x: Int) {
+  let a: Int = -(x, 2)
+  let b: Int = %%%(1, 2, 3)
+  _ = a + b
+}
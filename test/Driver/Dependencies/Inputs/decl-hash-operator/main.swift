@@ -0,0 +1,5 @@
+# Dependencies after an edit to the == operator declaration, which has no
+# decl hash entry:
+provides-top-level: [foo, "=="]
+provides-decl-hashes: [[foo, 1111]]
+interface-hash: "after"
@@ -0,0 +1 @@
+depends-top-level: ["=="]
@@ -0,0 +1,4 @@
+# Dependencies after the edit to the first overload of foo:
+provides-top-level: [foo, bar]
+provides-decl-hashes: [[foo, 3333], [foo, 2222], [bar, 5555]]
+interface-hash: "after"
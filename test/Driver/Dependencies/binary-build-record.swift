@@ -0,0 +1,46 @@
+// main | other
+
+// RUN: rm -rf %t && cp -r %S/Inputs/independent/ %t
+// RUN: touch -t 201401240005 %t/*
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-binary-compilation-record ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-FIRST %s
+// RUN: ls %t/main~buildrecord.swiftdeps
+// RUN: %FileCheck -check-prefix=CHECK-RECORD %s < %t/main~buildrecord.swiftdeps
+
+// CHECK-FIRST-NOT: warning
+// CHECK-FIRST: Handled main.swift
+// CHECK-FIRST: Handled other.swift
+
+// The record is written in the binary format, not YAML.
+// CHECK-RECORD: SWCR
+// CHECK-RECORD-NOT: version:
+
+// The record round-trips: the second build is a null build.
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-binary-compilation-record ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NULL %s
+
+// CHECK-NULL-NOT: Handled
+
+// A touched input is rebuilt.
+// RUN: touch -t 201401240006 %t/other.swift
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-binary-compilation-record ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-TOUCHED %s
+
+// CHECK-TOUCHED: Handled other.swift
+// CHECK-TOUCHED-NOT: Handled main.swift
+
+// The reader sniffs the magic number, so a build without the flag still
+// loads the binary record (and rewrites it as YAML).
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NULL %s
+// RUN: %FileCheck -check-prefix=CHECK-YAML %s < %t/main~buildrecord.swiftdeps
+
+// CHECK-YAML-NOT: SWCR
+// CHECK-YAML: version:
+
+// A truncated binary record disables incremental mode and everything is
+// rebuilt.
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-binary-compilation-record ./main.swift ./other.swift -module-name main -j1 -v 2>&1 > /dev/null
+// RUN: head -c 25 %t/main~buildrecord.swiftdeps > %t/truncated && mv %t/truncated %t/main~buildrecord.swiftdeps
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-show-incremental -driver-binary-compilation-record ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-MALFORMED %s
+
+// CHECK-MALFORMED: Incremental compilation has been disabled due to malformed build record
+// CHECK-MALFORMED-DAG: Handled main.swift
+// CHECK-MALFORMED-DAG: Handled other.swift
@@ -0,0 +1,21 @@
+/// main ==> uses-foo, uses-op
+
+// RUN: rm -rf %t && cp -r %S/Inputs/decl-hash-operator/ %t
+// RUN: touch -t 201401240005 %t/*.swift
+
+// Generate the build record...
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./uses-foo.swift ./uses-op.swift -module-name main -j1 -v
+
+// ...then reset main's .swiftdeps to the pre-edit state.
+// RUN: cp %S/Inputs/decl-hash-operator/main.swiftdeps %t
+
+// The edited == operator declaration has no decl hash entry, so it can
+// never be proven unchanged: its dependent must be rebuilt whenever main's
+// interface changes. foo's hash is unchanged, so its dependent is not.
+// RUN: touch -t 201401240006 %t/main.swift
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./uses-foo.swift ./uses-op.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-EDIT %s
+
+// CHECK-EDIT: Handled main.swift
+// CHECK-EDIT-NOT: Handled uses-foo.swift
+// CHECK-EDIT: Handled uses-op.swift
+// CHECK-EDIT-NOT: Handled
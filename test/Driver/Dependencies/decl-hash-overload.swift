@@ -0,0 +1,25 @@
+/// main ==> uses-foo, uses-bar
+
+// RUN: rm -rf %t && cp -r %S/Inputs/decl-hash-overload/ %t
+// RUN: touch -t 201401240005 %t/*.swift
+
+// Generate the build record...
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./uses-foo.swift ./uses-bar.swift -module-name main -j1 -v
+
+// ...then reset main's .swiftdeps to the pre-edit state.
+// RUN: cp %S/Inputs/decl-hash-overload/main.swiftdeps %t
+
+// Editing the first of two foo overloads changes the aggregate hash for
+// 'foo' even though the second overload's hash is unchanged, so foo's
+// dependent must be rebuilt; bar is untouched and its dependent is not.
+// RUN: touch -t 201401240006 %t/main.swift
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./uses-foo.swift ./uses-bar.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-EDIT %s
+
+// CHECK-EDIT: Handled main.swift
+// CHECK-EDIT-NOT: Handled uses-bar.swift
+// CHECK-EDIT: Handled uses-foo.swift
+// CHECK-EDIT-NOT: Handled
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./uses-foo.swift ./uses-bar.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NULL %s
+
+// CHECK-NULL-NOT: Handled
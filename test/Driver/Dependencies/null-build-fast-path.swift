@@ -0,0 +1,42 @@
+// main | other
+
+// RUN: rm -rf %t && cp -r %S/Inputs/independent/ %t
+// RUN: touch -t 201401240005 %t/*
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-FIRST %s
+
+// CHECK-FIRST-NOT: Skipping job construction
+// CHECK-FIRST: Handled main.swift
+// CHECK-FIRST: Handled other.swift
+
+// With everything up to date, the second build skips job construction
+// entirely.
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NULL %s
+
+// CHECK-NULL: Skipping job construction: all inputs up to date
+// CHECK-NULL-NOT: Handled
+
+// The fast path leaves the build record alone, so it keeps applying.
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NULL %s
+
+// A touched input falls through to the normal incremental path and is
+// rebuilt.
+// RUN: touch -t 201401240006 %t/other.swift
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-TOUCHED %s
+
+// CHECK-TOUCHED-NOT: Skipping job construction
+// CHECK-TOUCHED: Handled other.swift
+
+// A missing object file recorded in the output file map also falls through
+// to normal job construction.
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NULL %s
+// RUN: rm %t/other.o
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NO-OBJECT %s
+
+// CHECK-NO-OBJECT-NOT: Skipping job construction
+
+// Without an output file map there is no object file to verify, so the fast
+// path never applies.
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -incremental -driver-null-build-fast-path -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-NO-OFM %s
+
+// CHECK-NO-OFM-NOT: Skipping job construction
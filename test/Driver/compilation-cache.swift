@@ -0,0 +1,38 @@
+// RUN: %empty-directory(%t)
+// RUN: echo "public func foo() {}" > %t/main.swift
+
+// The first build misses the cache and runs the frontend job.
+// RUN: %target-swiftc_driver -driver-compilation-cache-path %t/cache -driver-show-job-lifecycle -c %t/main.swift -o %t/main.o | %FileCheck -check-prefix=MISS %s
+
+// The second build finds the stored entry and restores the output instead of
+// running the job.
+// RUN: rm %t/main.o
+// RUN: %target-swiftc_driver -driver-compilation-cache-path %t/cache -driver-show-job-lifecycle -c %t/main.swift -o %t/main.o | %FileCheck -check-prefix=HIT %s
+// RUN: ls %t/main.o
+
+// Changing the input contents changes the key, so the build misses again.
+// RUN: echo "public func bar() {}" >> %t/main.swift
+// RUN: %target-swiftc_driver -driver-compilation-cache-path %t/cache -driver-show-job-lifecycle -c %t/main.swift -o %t/main.o | %FileCheck -check-prefix=MISS %s
+
+// A corrupted entry (cached output files missing) fails to restore; the
+// build falls back to running the job and produces the output anyway.
+// RUN: rm %t/cache/*/*
+// RUN: rm %t/main.o
+// RUN: %target-swiftc_driver -driver-compilation-cache-path %t/cache -driver-show-job-lifecycle -c %t/main.swift -o %t/main.o | %FileCheck -check-prefix=MISS %s
+// RUN: ls %t/main.o
+
+// A cache path that cannot be a directory disables the cache entirely; the
+// build still succeeds.
+// RUN: rm -rf %t/cache
+// RUN: echo "poison" > %t/cache
+// RUN: rm %t/main.o
+// RUN: %target-swiftc_driver -driver-compilation-cache-path %t/cache -driver-show-job-lifecycle -c %t/main.swift -o %t/main.o | %FileCheck -check-prefix=MISS %s
+// RUN: ls %t/main.o
+
+// MISS-NOT: Restored from cache
+// MISS: Added to TaskQueue: {{.*}}compile
+// MISS-NOT: Restored from cache
+
+// HIT-NOT: Added to TaskQueue
+// HIT: Restored from cache: {{.*}}compile
+// HIT-NOT: Added to TaskQueue
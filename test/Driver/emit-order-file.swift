@@ -0,0 +1,32 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: %target-build-swift %s -profile-generate -Xfrontend -disable-incremental-llvm-codegen -module-name main -o %t/main
+// RUN: env LLVM_PROFILE_FILE=%t/default.profraw %target-run %t/main
+// RUN: %llvm-profdata merge %t/default.profraw -o %t/default.profdata
+
+// The driver forwards -emit-order-file to the frontend under WMO and warns
+// otherwise.
+// RUN: %target-swiftc_driver -### -whole-module-optimization -profile-use=%t/default.profdata -emit-order-file %s -c 2>&1 | %FileCheck -check-prefix=WMO %s
+// WMO: -emit-order-file-path
+// RUN: %target-swiftc_driver -### -profile-use=%t/default.profdata -emit-order-file %s -c 2>&1 | %FileCheck -check-prefix=NOWMO %s
+// NOWMO: warning: Emission of a linker order file has been disabled
+// NOWMO-NOT: -emit-order-file-path
+
+// The order file lists the executed functions hottest first, with the
+// linker-visible underscore, and leaves unexecuted functions out.
+// RUN: %target-swift-frontend %s -profile-use=%t/default.profdata -module-name main -emit-order-file-path %t/main.order -c -o %t/main.o
+// RUN: %FileCheck %s < %t/main.order
+
+// CHECK: __T04main3hotyyF
+// CHECK-NEXT: _main
+// CHECK-NOT: cold
+
+// REQUIRES: profile_runtime
+// REQUIRES: OS=macosx
+
+func hot() {}
+
+func cold() {}
+
+for _ in 0..<100 {
+  hot()
+}
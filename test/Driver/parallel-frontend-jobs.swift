@@ -0,0 +1,27 @@
+// RUN: %target-swiftc_driver -driver-print-jobs -module-name=ThisModule -driver-parallel-frontend-jobs %S/Inputs/main.swift %s -c | %FileCheck -check-prefix=DEFAULT %s
+// RUN: %target-swiftc_driver -driver-print-jobs -module-name=ThisModule -driver-parallel-frontend-jobs -num-threads 4 %S/Inputs/main.swift %s -c | %FileCheck -check-prefix=EXPLICIT %s
+// RUN: %target-swiftc_driver -driver-print-jobs -module-name=ThisModule -driver-parallel-frontend-jobs -incremental -driver-show-incremental %S/Inputs/main.swift %s -c | %FileCheck -check-prefix=INCREMENTAL %s
+
+// The flag rewrites a standard compile into a single frontend invocation
+// over all inputs: no -primary-file jobs, and -num-threads defaults to the
+// number of hardware threads.
+// DEFAULT: -frontend
+// DEFAULT-NOT: -primary-file
+// DEFAULT-DAG: -num-threads {{[1-9]}}
+// DEFAULT-DAG: {{[^ ]*}}/Inputs/main.swift {{[^ ]*}}/parallel-frontend-jobs.swift
+// DEFAULT-NOT: -primary-file
+
+// An explicit -num-threads value is passed through unchanged.
+// EXPLICIT: -frontend
+// EXPLICIT-NOT: -primary-file
+// EXPLICIT-DAG: -num-threads 4
+// EXPLICIT-DAG: {{[^ ]*}}/Inputs/main.swift {{[^ ]*}}/parallel-frontend-jobs.swift
+// EXPLICIT-NOT: -primary-file
+
+// Compiling the whole module at once leaves nothing for the incremental
+// machinery to schedule, so -incremental is disabled.
+// INCREMENTAL: Incremental compilation has been disabled, because it is not compatible with -driver-parallel-frontend-jobs
+// INCREMENTAL: -frontend
+// INCREMENTAL-NOT: -primary-file
+
+func libraryFunction() {}
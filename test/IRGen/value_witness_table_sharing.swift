@@ -0,0 +1,55 @@
+// RUN: %target-swift-frontend -parse-as-library -module-name=test %s -emit-ir > %t.ll
+// RUN: %FileCheck %s < %t.ll
+// RUN: %FileCheck -check-prefix=NEGATIVE %s < %t.ll
+
+// Types whose layout matches one of the value witness tables exported by the
+// runtime reference that table from their metadata instead of emitting their
+// own; everything else must keep a per-type table.
+
+// A trivial struct matching a builtin integer layout shares its table.
+// CHECK-DAG: @_T04test12TrivialInt32VMf = internal constant {{.*}} @_T0Bi32_WV
+struct TrivialInt32 {
+  var x: Int32
+}
+
+// An empty struct shares the empty tuple's table.
+// CHECK-DAG: @_T04test5EmptyVMf = internal constant {{.*}} @_T0ytWV
+struct Empty {}
+
+// A single native class reference shares Builtin.NativeObject's table.
+// CHECK-DAG: @_T04test3RefVMf = internal constant {{.*}} @_T0BoWV
+class C {}
+struct Ref {
+  var x: C
+}
+
+// Size and alignment must match a builtin integer exactly; 5 bytes with
+// 4-byte alignment does not.
+// CHECK-DAG: @_T04test7OddPairVWV = internal constant
+// CHECK-DAG: @_T04test7OddPairVMf = internal constant {{.*}} @_T04test7OddPairVWV
+struct OddPair {
+  var x: Int32
+  var y: Int8
+}
+
+// An optional reference has extra inhabitants differing from
+// Builtin.NativeObject and is not trivial; it keeps its own table.
+// CHECK-DAG: @_T04test6OptRefVWV = internal constant
+// CHECK-DAG: @_T04test6OptRefVMf = internal constant {{.*}} @_T04test6OptRefVWV
+struct OptRef {
+  var x: C?
+}
+
+// Enums carry additional enum value witnesses and keep their own table,
+// even when the layout matches a builtin integer.
+// CHECK-DAG: @_T04test7PayloadOWV = internal constant
+// CHECK-DAG: @_T04test7PayloadOMf = internal constant {{.*}} @_T04test7PayloadOWV
+enum Payload {
+  case some(Int32)
+  case none
+}
+
+// No per-type tables may be emitted for the shared layouts.
+// NEGATIVE-NOT: @_T04test12TrivialInt32VWV
+// NEGATIVE-NOT: @_T04test5EmptyVWV
+// NEGATIVE-NOT: @_T04test3RefVWV
@@ -581,6 +581,105 @@ bb3:
   ret %swift.bridge* %A
 }
 
+; CHECK-LABEL: define{{( protected)?}} void @swift_contractRetainPair(%swift.refcounted* %A, %swift.refcounted* %B) {
+; CHECK: entry:
+; CHECK-NEXT: tail call void @swift_retain_pair(%swift.refcounted* %A, %swift.refcounted* %B)
+; CHECK-NEXT: ret void
+define void @swift_contractRetainPair(%swift.refcounted* %A, %swift.refcounted* %B) {
+entry:
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %B)
+  ret void
+}
+
+; CHECK-LABEL: define{{( protected)?}} void @swift_contractReleasePair(%swift.refcounted* %A, %swift.refcounted* %B) {
+; CHECK: entry:
+; CHECK-NEXT: tail call void @swift_release_pair(%swift.refcounted* %A, %swift.refcounted* %B)
+; CHECK-NEXT: ret void
+define void @swift_contractReleasePair(%swift.refcounted* %A, %swift.refcounted* %B) {
+entry:
+  tail call void @swift_rt_swift_release(%swift.refcounted* %A)
+  tail call void @swift_rt_swift_release(%swift.refcounted* %B)
+  ret void
+}
+
+; The noread_user call does not observe reference counts, so the pending
+; retain may sink past it.
+; CHECK-LABEL: define{{( protected)?}} void @swift_contractRetainPairInterleaved(%swift.refcounted* %A, %swift.refcounted* %B) {
+; CHECK: entry:
+; CHECK-NEXT: call void @noread_user(%swift.refcounted* %A)
+; CHECK-NEXT: tail call void @swift_retain_pair(%swift.refcounted* %A, %swift.refcounted* %B)
+; CHECK-NEXT: ret void
+define void @swift_contractRetainPairInterleaved(%swift.refcounted* %A, %swift.refcounted* %B) {
+entry:
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  call void @noread_user(%swift.refcounted* %A)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %B)
+  ret void
+}
+
+; An unknown call ends the window, so nothing may be paired across it.
+; CHECK-LABEL: define{{( protected)?}} void @swift_noContractRetainPairAcrossUser(%swift.refcounted* %A, %swift.refcounted* %B) {
+; CHECK: entry:
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+; CHECK-NEXT: call void @user(%swift.refcounted* %A)
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %B)
+; CHECK-NEXT: ret void
+define void @swift_noContractRetainPairAcrossUser(%swift.refcounted* %A, %swift.refcounted* %B) {
+entry:
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  call void @user(%swift.refcounted* %A)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %B)
+  ret void
+}
+
+; A release in between may decrement an aliasing count, so the retain may
+; not sink past it.
+; CHECK-LABEL: define{{( protected)?}} void @swift_noContractRetainPairAcrossRelease(%swift.refcounted* %A, %swift.refcounted* %B, %swift.refcounted* %C) {
+; CHECK: entry:
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+; CHECK-NEXT: call void @swift_rt_swift_release(%swift.refcounted* %B)
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %C)
+; CHECK-NEXT: ret void
+define void @swift_noContractRetainPairAcrossRelease(%swift.refcounted* %A, %swift.refcounted* %B, %swift.refcounted* %C) {
+entry:
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  call void @swift_rt_swift_release(%swift.refcounted* %B)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %C)
+  ret void
+}
+
+; When two releases merge into a release_pair, the pair is still a release
+; and ends the retain window: the retain of %A must not pair with the retain
+; of %B, which would sink it past the releases of possibly-aliasing objects.
+; CHECK-LABEL: define{{( protected)?}} void @swift_noContractRetainPairAcrossReleasePair(%swift.refcounted* %X, %swift.refcounted* %A, %swift.refcounted* %Y, %swift.refcounted* %B) {
+; CHECK: entry:
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+; CHECK-NEXT: tail call void @swift_release_pair(%swift.refcounted* %X, %swift.refcounted* %Y)
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %B)
+; CHECK-NEXT: ret void
+define void @swift_noContractRetainPairAcrossReleasePair(%swift.refcounted* %X, %swift.refcounted* %A, %swift.refcounted* %Y, %swift.refcounted* %B) {
+entry:
+  call void @swift_rt_swift_release(%swift.refcounted* %X)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  call void @swift_rt_swift_release(%swift.refcounted* %Y)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %B)
+  ret void
+}
+
+; Retains on the same object belong to retain_n, not to the pair entry
+; point.
+; CHECK-LABEL: define{{( protected)?}} void @swift_noContractRetainPairSameObject(%swift.refcounted* %A) {
+; CHECK: entry:
+; CHECK-NEXT: tail call %swift.refcounted* @swift_rt_swift_retain_n(%swift.refcounted* %A, i32 2)
+; CHECK-NEXT: ret void
+define void @swift_noContractRetainPairSameObject(%swift.refcounted* %A) {
+entry:
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  tail call %swift.refcounted* @swift_rt_swift_retain(%swift.refcounted* %A)
+  ret void
+}
+
 !llvm.dbg.cu = !{!1}
 !llvm.module.flags = !{!4}
 
@@ -0,0 +1,67 @@
+; RUN: %swift-llvm-opt -swift-merge-functions -swiftmergefunc-threshold=4 -swiftmergefunc-cross-module %s | %FileCheck %s
+
+@g1 = external global i32
+@g2 = external global i32
+@p = private global i32 0
+
+; In cross-module mode the merged function gets a name derived from its
+; content and linkonce_odr linkage, so that the linker can fold identical
+; merged functions created in other modules.
+
+; CHECK-LABEL: define i32 @cross_func1(i32 %x, i32 %y)
+; CHECK: %1 = tail call i32 @__swift_merged_{{[0-9a-f]+}}(i32 %x, i32 %y, i32* @g1)
+; CHECK: ret i32 %1
+define i32 @cross_func1(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %sum2 = add i32 %sum, %y
+  %l = load i32, i32* @g1, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+; CHECK-LABEL: define i32 @cross_func2(i32 %x, i32 %y)
+; CHECK: %1 = tail call i32 @__swift_merged_{{[0-9a-f]+}}(i32 %x, i32 %y, i32* @g2)
+; CHECK: ret i32 %1
+define i32 @cross_func2(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %sum2 = add i32 %sum, %y
+  %l = load i32, i32* @g2, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+; CHECK: define linkonce_odr hidden i32 @__swift_merged_{{[0-9a-f]+}}(i32, i32, i32*) unnamed_addr
+; CHECK: %l = load i32, i32* %2
+; CHECK: ret
+
+
+; A merged function which references a local symbol must not be folded with
+; functions from other modules and keeps its module-private name and linkage.
+
+; CHECK-LABEL: define i32 @local_ref_func1(i32 %x, i32 %y)
+; CHECK: %1 = tail call i32 @local_ref_func1Tm(i32 %x, i32 %y, i32* @g1)
+; CHECK: ret i32 %1
+define i32 @local_ref_func1(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %pv = load i32, i32* @p, align 4
+  %sum2 = add i32 %sum, %pv
+  %l = load i32, i32* @g1, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+; CHECK-LABEL: define i32 @local_ref_func2(i32 %x, i32 %y)
+; CHECK: %1 = tail call i32 @local_ref_func1Tm(i32 %x, i32 %y, i32* @g2)
+; CHECK: ret i32 %1
+define i32 @local_ref_func2(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %pv = load i32, i32* @p, align 4
+  %sum2 = add i32 %sum, %pv
+  %l = load i32, i32* @g2, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+; CHECK-LABEL: define internal i32 @local_ref_func1Tm(i32, i32, i32*)
+; CHECK: %l = load i32, i32* %2
+; CHECK: ret
@@ -0,0 +1,67 @@
+// RUN: %target-swift-frontend -parse-as-library -emit-silgen %s | %FileCheck %s
+
+// A global 'let' initialized from an integer or boolean literal of a
+// standard library type gets a static initializer: no globalinit function,
+// no once token, and the addressor just returns the global's address.
+
+// CHECK: sil_global hidden {{.*}}@_T014static_globals4gIntSivp : $Int = {
+// CHECK:   %0 = integer_literal $Builtin.Int{{32|64}}, 27
+// CHECK:   %initval = struct $Int (%0 : $Builtin.Int{{32|64}})
+// CHECK: }
+let gInt: Int = 27
+
+// CHECK: sil_global hidden {{.*}}@_T014static_globals5gBoolSbvp : $Bool = {
+// CHECK:   %0 = integer_literal $Builtin.Int1, {{1|-1}}
+// CHECK:   %initval = struct $Bool (%0 : $Builtin.Int1)
+// CHECK: }
+let gBool: Bool = true
+
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals4gIntSivau
+// CHECK-NOT: builtin "once"
+// CHECK: [[ADDR:%.*]] = global_addr @_T014static_globals4gIntSivp
+// CHECK: address_to_pointer [[ADDR]]
+// CHECK: return
+
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals5gBoolSbvau
+// CHECK-NOT: builtin "once"
+// CHECK: global_addr @_T014static_globals5gBoolSbvp
+// CHECK: return
+
+// A 'var' can be reassigned and keeps the lazy-token path.
+// CHECK-LABEL: sil private @globalinit_
+// CHECK: alloc_global @_T014static_globals4gVarSivp
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals4gVarSivau
+// CHECK: builtin "once"
+var gVar: Int = 5
+
+// A literal needing the stdlib's checked truncation keeps the lazy path.
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals4gMaxs5UInt8Vvau
+// CHECK: builtin "once"
+let gMax: UInt8 = 255
+
+// A non-literal initializer expression keeps the lazy path.
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals4gSumSivau
+// CHECK: builtin "once"
+let gSum: Int = 1 + 2
+
+struct MyInt: ExpressibleByIntegerLiteral {
+  var value: Int
+  init(integerLiteral value: Int) {
+    self.value = value
+  }
+}
+
+// A user-defined literal initializer can run arbitrary code and keeps the
+// lazy path.
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals3gMy{{.*}}vau
+// CHECK: builtin "once"
+let gMy: MyInt = 27
+
+func sideEffect() -> Int {
+  return 0
+}
+
+// An initializer with side effects keeps the lazy path.
+// CHECK-LABEL: sil hidden [global_init] @_T014static_globals5gSideSivau
+// CHECK: builtin "once"
+let gSide = sideEffect()
@@ -0,0 +1,73 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-build-swift -O %s -o %t/a.out
+// RUN: %target-run %t/a.out
+// REQUIRES: executable_test
+
+// Each racing thread churns reference counts on its own thread-confined
+// objects. Under -O the NonAtomicRC pass lowers these operations to the
+// non-atomic runtime entry points; the trial succeeds if every thread still
+// observes consistent objects and nothing crashes.
+
+import StdlibUnittest
+
+let iterations = 25
+
+class Node {
+  var payload: UInt
+  var next: Node?
+  init(_ payload: UInt, _ next: Node?) {
+    self.payload = payload
+    self.next = next
+  }
+}
+
+struct RaceTest_threadConfinedRC: RaceTestWithPerTrialData {
+  class RaceData {}
+  typealias ThreadLocalData = Void
+  typealias Observation = Observation1UInt
+
+  func makeRaceData() -> RaceData {
+    return RaceData()
+  }
+
+  func makeThreadLocalData() -> Void {
+    return ()
+  }
+
+  func thread1(
+    _ raceData: RaceData,
+    _ threadLocalData: inout Void
+  ) -> Observation1UInt {
+    var sum: UInt = 0
+    for _ in 0..<100 {
+      // Build a list confined to this thread, copy references around and
+      // walk it. All reference counting here is on non-escaping objects.
+      var head: Node? = nil
+      for i in 0..<20 {
+        head = Node(UInt(i), head)
+      }
+      let copy = head
+      var cursor = copy
+      while let node = cursor {
+        sum = sum &+ node.payload
+        cursor = node.next
+      }
+    }
+    return Observation1UInt(sum)
+  }
+
+  func evaluateObservations(
+    _ observations: [Observation1UInt],
+    _ sink: (RaceTestObservationEvaluation) -> Void
+  ) {
+    sink(evaluateObservationsAllEqual(observations))
+  }
+}
+
+let NonAtomicRCTests = TestSuite("NonAtomicRCTests")
+
+NonAtomicRCTests.test("thread-confined reference counting") {
+  runRaceTest(RaceTest_threadConfinedRC.self, trials: iterations)
+}
+
+runAllTests()
@@ -0,0 +1,10 @@
+public func hashedFunction(x: Int) -> Int {
+  return x + 1
+}
+
+public struct HashedStruct {
+  public var value: Int
+  public init(value: Int) {
+    self.value = value
+  }
+}
@@ -0,0 +1,22 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-swift-frontend -emit-module -o %t/def_content_hash.swiftmodule %S/Inputs/def_content_hash.swift
+// RUN: llvm-bcanalyzer -dump %t/def_content_hash.swiftmodule | %FileCheck %s
+
+// The control block carries a content hash record, and every record in the
+// file has a registered name.
+// CHECK: <CONTROL_BLOCK
+// CHECK: <CONTENT_HASH
+// CHECK-NOT: UnknownCode
+
+// Rebuilding the same sources yields the same bytes, hash included.
+// RUN: %target-swift-frontend -emit-module -o %t/second.swiftmodule -module-name def_content_hash %S/Inputs/def_content_hash.swift
+// RUN: cmp %t/def_content_hash.swiftmodule %t/second.swiftmodule
+
+// A module with the hash record still loads normally.
+// RUN: %target-swift-frontend -typecheck -I %t %s
+
+import def_content_hash
+
+func use() -> Int {
+  return HashedStruct(value: hashedFunction(x: 1)).value
+}
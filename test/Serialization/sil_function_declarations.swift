@@ -0,0 +1,33 @@
+// RUN: %target-swift-frontend %s -module-name Test -emit-module -emit-module-path - -o /dev/null -serialize-public-sil-declarations | %target-sil-opt -disable-sil-linking -module-name="Test" | %FileCheck %s
+// RUN: %target-swift-frontend %s -module-name Test -emit-module -emit-module-path - -o /dev/null | %target-sil-opt -disable-sil-linking -module-name="Test" | %FileCheck -check-prefix=NEGATIVE %s
+
+// With -serialize-public-sil-declarations, public functions whose bodies are
+// not serialized get declaration-only records carrying their effects kind,
+// semantics attributes, and inlining strategy: the printed function has
+// attributes but no body.
+
+// CHECK-DAG: sil [_semantics "test.sema"] @_T04Test12pubSemanticsyyF : $@convention(thin) () -> (){{$}}
+@_semantics("test.sema") public func pubSemantics() {}
+
+// CHECK-DAG: sil [readnone] @_T04Test8pureFuncyyF : $@convention(thin) () -> (){{$}}
+@effects(readnone) public func pureFunc() {}
+
+// CHECK-DAG: sil [noinline] @_T04Test11pubNoinlineyyF : $@convention(thin) () -> (){{$}}
+@inline(never) public func pubNoinline() {}
+
+// A function whose body is already serialized keeps its full record.
+// CHECK-DAG: sil [serialized] @_T04Test8inlineMeyyF : $@convention(thin) () -> () {
+@_inlineable public func inlineMe() {}
+
+// Non-public functions never get declaration records.
+// CHECK-NOT: internalOnly
+internal func internalOnly() {}
+
+// Without the flag, only the serialized body is emitted.
+// NEGATIVE-NOT: pubSemantics
+// NEGATIVE-NOT: pureFunc
+// NEGATIVE-NOT: pubNoinline
+// NEGATIVE: sil [serialized] @_T04Test8inlineMeyyF
+// NEGATIVE-NOT: pubSemantics
+// NEGATIVE-NOT: pureFunc
+// NEGATIVE-NOT: pubNoinline
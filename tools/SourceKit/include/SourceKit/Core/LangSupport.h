@@ -123,6 +123,11 @@ public:
 
   virtual void failed(StringRef ErrDescription) = 0;
 
+  /// Reports that the request was abandoned before completing, e.g. because a
+  /// newer request superseded it.  Consumers without a dedicated cancellation
+  /// path report it as a failure.
+  virtual void cancelled() { failed("request cancelled"); }
+
   virtual bool handleResult(const CodeCompletionInfo &Info) = 0;
 };
 
@@ -196,6 +201,14 @@ public:
 
   virtual bool needsSemanticInfo() { return true; }
 
+  /// Whether this consumer is interested in syntax map tokens.  Producers may
+  /// skip computing them when this returns false.
+  virtual bool syntaxMapEnabled() { return true; }
+
+  /// Whether this consumer is interested in document structure.  Producers may
+  /// skip computing it when this returns false.
+  virtual bool documentStructureEnabled() { return true; }
+
   virtual void handleRequestError(const char *Description) = 0;
 
   virtual bool handleSyntaxMap(unsigned Offset, unsigned Length,
@@ -222,7 +222,8 @@ public:
   void addCompletionsWithFilter(ArrayRef<Completion *> completions,
                                 StringRef filterText, Options options,
                                 const FilterRules &rules,
-                                Completion *&exactMatch);
+                                Completion *&exactMatch,
+                                std::vector<Completion *> *matchedCompletions);
 
   void sort(Options options);
 
@@ -297,9 +298,10 @@ void CodeCompletionOrganizer::preSortCompletions(
 
 void CodeCompletionOrganizer::addCompletionsWithFilter(
     ArrayRef<Completion *> completions, StringRef filterText,
-    const FilterRules &rules, Completion *&exactMatch) {
+    const FilterRules &rules, Completion *&exactMatch,
+    std::vector<Completion *> *matchedCompletions) {
   impl.addCompletionsWithFilter(completions, filterText, options, rules,
-                                exactMatch);
+                                exactMatch, matchedCompletions);
 }
 
 void CodeCompletionOrganizer::groupAndSort(const Options &options) {
@@ -524,7 +526,8 @@ bool FilterRules::hideCompletion(SwiftResult *completion, StringRef filterName,
 
 void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
     ArrayRef<Completion *> completions, StringRef filterText, Options options,
-    const FilterRules &rules, Completion *&exactMatch) {
+    const FilterRules &rules, Completion *&exactMatch,
+    std::vector<Completion *> *matchedCompletions) {
   assert(rootGroup);
 
   auto &contents = rootGroup->contents;
@@ -592,6 +595,21 @@ void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
   FuzzyStringMatcher pattern(filterText);
   pattern.normalize = true;
   for (Completion *completion : completions) {
+    bool match = false;
+    if (options.fuzzyMatching && filterText.size() >= options.minFuzzyLength) {
+      match = pattern.matchesCandidate(completion->getName());
+    } else {
+      match = completion->getName().startswith_lower(filterText);
+    }
+
+    if (!match)
+      continue;
+
+    // Record the match before applying any hiding rules, since the rules may
+    // be different on the next update request.
+    if (matchedCompletions)
+      matchedCompletions->push_back(completion);
+
     if (rules.hideCompletion(completion))
       continue;
 
@@ -605,14 +623,7 @@ void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
         completion->getLiteralKind() != CodeCompletionLiteralKind::NilLiteral)
       continue;
 
-    bool match = false;
-    if (options.fuzzyMatching && filterText.size() >= options.minFuzzyLength) {
-      match = pattern.matchesCandidate(completion->getName());
-    } else {
-      match = completion->getName().startswith_lower(filterText);
-    }
-
-    bool isExactMatch = match && completion->getName().equals_lower(filterText);
+    bool isExactMatch = completion->getName().equals_lower(filterText);
 
     if (isExactMatch) {
       if (!exactMatch) { // first match
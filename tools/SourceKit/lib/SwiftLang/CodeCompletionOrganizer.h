@@ -83,10 +83,17 @@ public:
   /// Add \p completions to the organizer, removing any results that don't match
   /// \p filterText and returning \p exactMatch if there is an exact match.
   ///
+  /// If \p matchedCompletions is non-null, it is filled with the completions
+  /// whose names matched \p filterText, before any hiding rules are applied.
+  /// Since both prefix and fuzzy matching only get stricter as the pattern
+  /// grows, this set is a sound candidate set for a later call whose filter
+  /// text extends \p filterText in the same matching mode.
+  ///
   /// Precondition: \p completions should be sorted with preSortCompletions().
-  void addCompletionsWithFilter(ArrayRef<Completion *> completions,
-                                StringRef filterText, const FilterRules &rules,
-                                Completion *&exactMatch);
+  void addCompletionsWithFilter(
+      ArrayRef<Completion *> completions, StringRef filterText,
+      const FilterRules &rules, Completion *&exactMatch,
+      std::vector<Completion *> *matchedCompletions = nullptr);
 
   void groupAndSort(const Options &options);
 
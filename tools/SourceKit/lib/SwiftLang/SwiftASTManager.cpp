@@ -348,6 +348,10 @@ SwiftASTManager::getMemoryBuffer(StringRef Filename, std::string &Error) {
   return Impl.getMemoryBuffer(Filename, Error);
 }
 
+void SwiftASTManager::setASTMemoryBudget(size_t Bytes) {
+  Impl.ASTCache.setCostLimit(Bytes);
+}
+
 static void setModuleName(CompilerInvocation &Invocation) {
   if (!Invocation.getModuleName().empty())
     return;
@@ -120,6 +120,12 @@ public:
 
   void removeCachedAST(SwiftInvocationRef Invok);
 
+  /// Set a soft bound, in bytes, on the memory retained by cached ASTs
+  /// across all sessions; least recently used ASTs are evicted when it is
+  /// exceeded.  Zero means unbounded.  The cost of each AST is its
+  /// ASTContext memory usage, matching what getMemoryCost() reports.
+  void setASTMemoryBudget(size_t Bytes);
+
   struct Implementation;
 
 private:
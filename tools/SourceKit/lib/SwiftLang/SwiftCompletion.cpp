@@ -21,6 +21,7 @@
 #include "swift/Frontend/PrintingDiagnosticConsumer.h"
 #include "swift/IDE/CodeCompletionCache.h"
 
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/MemoryBuffer.h"
 
@@ -713,6 +714,21 @@ ArrayRef<Completion *> CodeCompletion::SessionCache::getSortedCompletions() {
   llvm::sys::ScopedLock L(mtx);
   return sortedCompletions;
 }
+void CodeCompletion::SessionCache::setLastFilterState(
+    StringRef filterText, std::vector<Completion *> &&matchedCompletions) {
+  llvm::sys::ScopedLock L(mtx);
+  lastFilterText = filterText;
+  lastMatchedCompletions = std::move(matchedCompletions);
+}
+std::string CodeCompletion::SessionCache::getLastFilterText() {
+  llvm::sys::ScopedLock L(mtx);
+  return lastFilterText;
+}
+std::vector<Completion *>
+CodeCompletion::SessionCache::getLastMatchedCompletions() {
+  llvm::sys::ScopedLock L(mtx);
+  return lastMatchedCompletions;
+}
 llvm::MemoryBuffer *CodeCompletion::SessionCache::getBuffer() {
   llvm::sys::ScopedLock L(mtx);
   return buffer.get();
@@ -989,12 +1005,17 @@ filterInnerResults(ArrayRef<Result *> results, bool includeInner,
   return topResults;
 }
 
+/// \param isSuperseded checked between the expensive phases; when it returns
+/// true the request is abandoned and \p consumer is told it was cancelled, so
+/// a newer keystroke preempts an obsolete update instead of queueing behind
+/// its remaining work.
 static void transformAndForwardResults(
     GroupedCodeCompletionConsumer &consumer, SwiftLangSupport &lang,
     CodeCompletion::SessionCacheRef session,
     const NameToPopularityMap *nameToPopularity,
     CodeCompletion::Options options, unsigned offset, StringRef filterText,
-    unsigned resultOffset, unsigned maxResults) {
+    unsigned resultOffset, unsigned maxResults,
+    llvm::function_ref<bool()> isSuperseded) {
 
   CodeCompletion::CompletionSink innerSink;
   Completion *exactMatch = nullptr;
@@ -1040,8 +1061,28 @@ static void transformAndForwardResults(
       session->getCompletionKind() == CompletionKind::PostfixExpr;
 
   if (!hasEarlyInnerResults) {
-    organizer.addCompletionsWithFilter(session->getSortedCompletions(),
-                                       filterText, rules, exactMatch);
+    // If the new filter text extends the one from the previous update, only
+    // its matches can match again, so rescore just those instead of the whole
+    // result set.  Crossing from prefix matching into fuzzy matching can admit
+    // results the prefix match rejected, so in that case start over.
+    auto usesFuzzyMatching = [&options](StringRef filter) {
+      return options.fuzzyMatching && filter.size() >= options.minFuzzyLength;
+    };
+    std::string lastFilterText = session->getLastFilterText();
+    std::vector<Completion *> candidates;
+    ArrayRef<Completion *> completions;
+    if (!lastFilterText.empty() && filterText.startswith(lastFilterText) &&
+        usesFuzzyMatching(filterText) == usesFuzzyMatching(lastFilterText)) {
+      candidates = session->getLastMatchedCompletions();
+      completions = candidates;
+    } else {
+      completions = session->getSortedCompletions();
+    }
+
+    std::vector<Completion *> matchedCompletions;
+    organizer.addCompletionsWithFilter(completions, filterText, rules,
+                                       exactMatch, &matchedCompletions);
+    session->setLastFilterState(filterText, std::move(matchedCompletions));
     // Add leading dot?
     if (options.addInnerOperators && !rules.hideFilterName(".") &&
         session->getCompletionMayUseImplicitMemberExpr()) {
@@ -1073,10 +1114,19 @@ static void transformAndForwardResults(
                                        CodeCompletion::FilterRules(), exactMatch);
   }
 
+  if (isSuperseded()) {
+    consumer.cancelled();
+    return;
+  }
+
   organizer.groupAndSort(options);
 
   if ((options.addInnerResults || options.addInnerOperators) &&
       exactMatch && exactMatch->getKind() == Completion::Declaration) {
+    if (isSuperseded()) {
+      consumer.cancelled();
+      return;
+    }
     std::vector<Completion *> innerResults;
     bool hasDot = false;
     bool hasQDot = false;
@@ -1138,6 +1188,11 @@ static void transformAndForwardResults(
     organizer.groupAndSort(noGroupOpts);
   }
 
+  if (isSuperseded()) {
+    consumer.cancelled();
+    return;
+  }
+
   // Build the final results view.
   auto view = organizer.takeResultsView();
   CodeCompletion::LimitedResultView limitedResults(*view, resultOffset,
@@ -1231,8 +1286,10 @@ void SwiftLangSupport::codeCompleteOpen(
     consumer.failed(OS.str());
   }
 
+  // The open request created the session, so nothing can supersede it.
   transformAndForwardResults(consumer, *this, session, nameToPopularity, CCOpts,
-                             offset, filterText, resultOffset, maxResults);
+                             offset, filterText, resultOffset, maxResults,
+                             [] { return false; });
 }
 
 void SwiftLangSupport::codeCompleteClose(
@@ -1259,6 +1316,8 @@ void SwiftLangSupport::codeCompleteUpdate(
     return;
   }
 
+  uint64_t updateGeneration = session->startUpdate();
+
   StringRef filterText;
   unsigned resultOffset = 0;
   unsigned maxResults = 0;
@@ -1277,7 +1336,11 @@ void SwiftLangSupport::codeCompleteUpdate(
   }
 
   transformAndForwardResults(consumer, *this, session, nameToPopularity, CCOpts,
-                             offset, filterText, resultOffset, maxResults);
+                             offset, filterText, resultOffset, maxResults,
+                             [&] {
+                               return session->isUpdateSuperseded(
+                                   updateGeneration);
+                             });
 }
 
 swift::ide::CodeCompletionCache &SwiftCompletionCache::getCache() {
@@ -1152,14 +1152,22 @@ class SwiftDocumentStructureWalker: public ide::SyntaxModelWalker {
   SourceManager &SrcManager;
   EditorConsumer &Consumer;
   unsigned BufferID;
+  /// Whether the consumer wants document structure at all. When it doesn't,
+  /// skip computing the per-node information (display names, access levels,
+  /// attribute ranges, etc.) it would only throw away.
+  bool StructureEnabled;
 
 public:
   SwiftDocumentStructureWalker(SourceManager &SrcManager,
                                unsigned BufferID,
                                EditorConsumer &Consumer)
-    : SrcManager(SrcManager), Consumer(Consumer), BufferID(BufferID) { }
+    : SrcManager(SrcManager), Consumer(Consumer), BufferID(BufferID),
+      StructureEnabled(Consumer.documentStructureEnabled()) { }
 
   bool walkToSubStructurePre(SyntaxStructureNode Node) override {
+    if (!StructureEnabled)
+      return true;
+
     unsigned StartOffset = SrcManager.getLocOffsetInBuffer(Node.Range.getStart(),
                                                            BufferID);
     unsigned EndOffset = SrcManager.getLocOffsetInBuffer(Node.Range.getEnd(),
@@ -1328,6 +1336,9 @@ public:
   }
 
   bool walkToSubStructurePost(SyntaxStructureNode Node) override {
+    if (!StructureEnabled)
+      return true;
+
     Consumer.endDocumentSubStructure();
     return true;
   }
@@ -1335,6 +1346,8 @@ public:
   bool walkToNodePre(SyntaxNode Node) override {
     if (Node.Kind != SyntaxNodeKind::CommentMarker)
       return false;
+    if (!StructureEnabled)
+      return true;
 
     unsigned StartOffset = SrcManager.getLocOffsetInBuffer(Node.Range.getStart(),
                                                            BufferID);
@@ -1352,7 +1365,7 @@ public:
   }
 
   bool walkToNodePost(SyntaxNode Node) override {
-    if (Node.Kind != SyntaxNodeKind::CommentMarker)
+    if (Node.Kind != SyntaxNodeKind::CommentMarker || !StructureEnabled)
       return true;
 
     Consumer.endDocumentSubStructure();
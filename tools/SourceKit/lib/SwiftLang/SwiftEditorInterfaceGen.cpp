@@ -24,8 +24,12 @@
 #include "swift/IDE/Utils.h"
 #include "swift/Strings.h"
 
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/ConvertUTF.h"
+#include "llvm/Support/Path.h"
 
 using namespace SourceKit;
 using namespace swift;
@@ -43,11 +47,21 @@ public:
     const ValueDecl *Dcl = nullptr;
     const ModuleEntity Mod;
     TextRange Range;
+    /// For entries restored from the on-disk interface cache: the USR used
+    /// to resolve the declaration lazily, plus the annotation info that
+    /// normally derives from the resolved declaration.
+    std::string USR;
+    UIdent CachedKind;
+    bool IsSystem = false;
 
     TextReference(const ValueDecl *D, unsigned Offset, unsigned Length)
       : Dcl(D), Mod(), Range{Offset, Length} {}
     TextReference(const ModuleEntity Mod, unsigned Offset, unsigned Length)
     : Mod(Mod), Range{Offset, Length} {}
+    TextReference(StringRef USR, UIdent Kind, bool IsSystem, unsigned Offset,
+                  unsigned Length)
+      : Mod(), Range{Offset, Length}, USR(USR), CachedKind(Kind),
+        IsSystem(IsSystem) {}
   };
 
   struct TextDecl {
@@ -55,9 +69,13 @@ public:
     const Decl *Dcl = nullptr;
     /// The range in the interface source.
     TextRange Range;
+    /// For entries restored from the on-disk interface cache.
+    std::string USR;
 
     TextDecl(const Decl *D, TextRange Range)
       : Dcl(D), Range(Range) {}
+    TextDecl(StringRef USR, TextRange Range)
+      : Range(Range), USR(USR) {}
     TextDecl() = default;
   };
 
@@ -267,6 +285,10 @@ static void reportSemanticAnnotations(const SourceTextInfo &IFaceInfo,
     } else if (Ref.Dcl) {
       Kind = SwiftLangSupport::getUIDForDecl(Ref.Dcl, /*IsRef=*/true);
       IsSystem = Ref.Dcl->getModuleContext()->isSystemModule();
+    } else if (Ref.CachedKind.isValid()) {
+      // Restored from the on-disk interface cache.
+      Kind = Ref.CachedKind;
+      IsSystem = Ref.IsSystem;
     }
     if (Kind.isInvalid())
       continue;
@@ -276,6 +298,189 @@ static void reportSemanticAnnotations(const SourceTextInfo &IFaceInfo,
   }
 }
 
+/// Returns the path of the on-disk cache file for the given module's printed
+/// interface, or \c None if caching is disabled or the module's file cannot
+/// be stat'ed.  Caching is enabled by pointing SOURCEKIT_INTERFACEGEN_CACHE_PATH
+/// at a writable directory.  The file name incorporates a hash of the module
+/// file's path, size and modification time together with the invocation state
+/// that affects the printed output, so a rebuilt module misses the cache
+/// naturally instead of serving stale text.
+static Optional<std::string>
+getInterfaceCacheFilePath(StringRef FullModuleName, ModuleDecl *Mod,
+                          const CompilerInvocation &Invok) {
+  const char *CacheDir = ::getenv("SOURCEKIT_INTERFACEGEN_CACHE_PATH");
+  if (!CacheDir)
+    return None;
+  StringRef ModuleFilename = Mod->getModuleFilename();
+  if (ModuleFilename.empty())
+    return None;
+  llvm::sys::fs::file_status Status;
+  if (llvm::sys::fs::status(ModuleFilename, Status))
+    return None;
+  auto Hash = llvm::hash_combine(
+      FullModuleName, ModuleFilename, Status.getSize(),
+      Status.getLastModificationTime().time_since_epoch().count(),
+      Invok.getTargetTriple(), Invok.getSDKPath(),
+      swift::version::getSwiftFullVersion());
+  llvm::SmallString<128> Path(CacheDir);
+  llvm::sys::path::append(Path, llvm::Twine(FullModuleName) + "-" +
+                                    llvm::utohexstr(Hash) + ".interface");
+  return Path.str().str();
+}
+
+/// Writes the printed interface text and its location tables to \p Path.
+/// Declarations and references are recorded by USR so a later session can
+/// restore the tables without re-printing the module; failures are silent
+/// since the cache is purely an optimization.
+static void writeInterfaceInfoCache(StringRef Path,
+                                    const SourceTextInfo &Info) {
+  llvm::SmallString<128> TmpModel(Path);
+  TmpModel += "-%%%%%%%%";
+  int TmpFD;
+  llvm::SmallString<128> TmpFile;
+  if (llvm::sys::fs::createUniqueFile(TmpModel, TmpFD, TmpFile))
+    return;
+  {
+    llvm::raw_fd_ostream OS(TmpFD, /*shouldClose=*/true);
+    OS << "skinterface-v1\n";
+    OS << Info.Text.size() << '\n' << Info.Text;
+    OS << Info.Decls.size() << '\n';
+    for (auto &D : Info.Decls) {
+      llvm::SmallString<64> USR;
+      if (auto *VD = dyn_cast_or_null<ValueDecl>(D.Dcl)) {
+        llvm::raw_svector_ostream UOS(USR);
+        SwiftLangSupport::printUSR(VD, UOS);
+      }
+      OS << D.Range.Offset << ' ' << D.Range.Length << ' ' << USR << '\n';
+    }
+    OS << Info.References.size() << '\n';
+    for (auto &Ref : Info.References) {
+      if (Ref.Mod) {
+        OS << "M " << Ref.Range.Offset << ' ' << Ref.Range.Length << ' '
+           << (Ref.Mod.isSystemModule() ? 1 : 0) << ' '
+           << Ref.Mod.getFullName() << '\n';
+        continue;
+      }
+      llvm::SmallString<64> USR;
+      UIdent Kind;
+      bool IsSystem = false;
+      if (Ref.Dcl) {
+        Kind = SwiftLangSupport::getUIDForDecl(Ref.Dcl, /*IsRef=*/true);
+        IsSystem = Ref.Dcl->getModuleContext()->isSystemModule();
+        llvm::raw_svector_ostream UOS(USR);
+        SwiftLangSupport::printUSR(Ref.Dcl, UOS);
+      }
+      OS << "D " << Ref.Range.Offset << ' ' << Ref.Range.Length << ' '
+         << (IsSystem ? 1 : 0) << ' '
+         << (Kind.isValid() ? Kind.getName() : StringRef("-")) << ' ' << USR
+         << '\n';
+    }
+    OS << Info.USRMap.size() << '\n';
+    for (auto &Entry : Info.USRMap)
+      OS << Entry.getValue().Range.Offset << ' '
+         << Entry.getValue().Range.Length << ' ' << Entry.getKey() << '\n';
+  }
+  // Publish the finished file atomically so a concurrent reader never sees a
+  // half-written cache entry.
+  if (llvm::sys::fs::rename(TmpFile, Path))
+    llvm::sys::fs::remove(TmpFile);
+}
+
+/// Restores the printed interface text and location tables from \p Path.
+/// Module references are resolved eagerly (there are only a handful per
+/// interface); declarations keep their USRs and resolve lazily when cursor
+/// info asks for them.  Returns true on any parse failure, in which case the
+/// caller regenerates the interface.
+static bool readInterfaceInfoCache(StringRef Path, ASTContext &Ctx,
+                                   SourceTextInfo &Info) {
+  auto FileOrErr = llvm::MemoryBuffer::getFile(Path);
+  if (!FileOrErr)
+    return true;
+  SourceTextInfo Result;
+  StringRef Data = FileOrErr.get()->getBuffer();
+  auto readLine = [&]() -> StringRef {
+    auto Split = Data.split('\n');
+    Data = Split.second;
+    return Split.first;
+  };
+  auto readCount = [&](unsigned &N) -> bool {
+    return readLine().getAsInteger(10, N);
+  };
+  if (readLine() != "skinterface-v1")
+    return true;
+  unsigned TextSize;
+  if (readCount(TextSize) || Data.size() < TextSize)
+    return true;
+  Result.Text = Data.substr(0, TextSize).str();
+  Data = Data.drop_front(TextSize);
+
+  unsigned NumDecls;
+  if (readCount(NumDecls))
+    return true;
+  for (unsigned i = 0; i < NumDecls; ++i) {
+    StringRef Line = readLine();
+    StringRef OffStr, LenStr;
+    std::tie(OffStr, Line) = Line.split(' ');
+    std::tie(LenStr, Line) = Line.split(' ');
+    unsigned Offset, Length;
+    if (OffStr.getAsInteger(10, Offset) || LenStr.getAsInteger(10, Length))
+      return true;
+    Result.Decls.push_back(TextDecl(Line, TextRange{Offset, Length}));
+  }
+
+  unsigned NumRefs;
+  if (readCount(NumRefs))
+    return true;
+  for (unsigned i = 0; i < NumRefs; ++i) {
+    StringRef Line = readLine();
+    StringRef KindStr, OffStr, LenStr, SysStr;
+    std::tie(KindStr, Line) = Line.split(' ');
+    std::tie(OffStr, Line) = Line.split(' ');
+    std::tie(LenStr, Line) = Line.split(' ');
+    std::tie(SysStr, Line) = Line.split(' ');
+    unsigned Offset, Length, IsSystem;
+    if (OffStr.getAsInteger(10, Offset) || LenStr.getAsInteger(10, Length) ||
+        SysStr.getAsInteger(10, IsSystem))
+      return true;
+    if (KindStr == "M") {
+      if (ModuleDecl *M = getModuleByFullName(Ctx, Line))
+        Result.References.push_back(
+            TextReference(ModuleEntity(M), Offset, Length));
+      else
+        Result.References.push_back(
+            TextReference(/*USR=*/StringRef(),
+                          SwiftLangSupport::getUIDForModuleRef(), IsSystem,
+                          Offset, Length));
+      continue;
+    }
+    if (KindStr != "D")
+      return true;
+    StringRef UIDStr;
+    std::tie(UIDStr, Line) = Line.split(' ');
+    UIdent Kind;
+    if (UIDStr != "-")
+      Kind = UIdent(UIDStr);
+    Result.References.push_back(
+        TextReference(Line, Kind, IsSystem, Offset, Length));
+  }
+
+  unsigned NumUSRs;
+  if (readCount(NumUSRs))
+    return true;
+  for (unsigned i = 0; i < NumUSRs; ++i) {
+    StringRef Line = readLine();
+    StringRef OffStr, LenStr;
+    std::tie(OffStr, Line) = Line.split(' ');
+    std::tie(LenStr, Line) = Line.split(' ');
+    unsigned Offset, Length;
+    if (OffStr.getAsInteger(10, Offset) || LenStr.getAsInteger(10, Length))
+      return true;
+    Result.USRMap[Line] = TextDecl(Line, TextRange{Offset, Length});
+  }
+  Info = std::move(Result);
+  return false;
+}
+
 static bool getModuleInterfaceInfo(ASTContext &Ctx,
                                    StringRef ModuleName,
                                    Optional<StringRef> Group,
@@ -285,6 +490,7 @@ static bool getModuleInterfaceInfo(ASTContext &Ctx,
                                    Optional<StringRef> InterestedUSR) {
   ModuleDecl *&Mod = Impl.Mod;
   SourceTextInfo &Info = Impl.Info;
+  std::string FullModuleName = ModuleName.str();
 
   if (ModuleName.empty()) {
     ErrMsg = "Module name is empty";
@@ -318,6 +524,16 @@ static bool getModuleInterfaceInfo(ASTContext &Ctx,
     }
   }
 
+  // Try the on-disk interface cache for the common whole-module case.
+  // Grouped, synthesized-extension and USR-targeted prints produce composite
+  // entries that do not round-trip through USRs, so they always regenerate.
+  Optional<std::string> CachePath;
+  if (!Group && !InterestedUSR && !SynthesizedExtensions)
+    CachePath = getInterfaceCacheFilePath(FullModuleName, Mod,
+                                          Impl.Invocation);
+  if (CachePath && !readInterfaceInfoCache(*CachePath, Ctx, Info))
+    return false;
+
   PrintOptions Options = PrintOptions::printModuleInterface();
   ModuleTraversalOptions TraversalOptions = None; // Don't print submodules.
   SmallString<128> Text;
@@ -333,6 +549,8 @@ static bool getModuleInterfaceInfo(ASTContext &Ctx,
                           Group.hasValue() && SynthesizedExtensions);
 
   Info.Text = OS.str();
+  if (CachePath)
+    writeInterfaceInfoCache(*CachePath, Info);
   return false;
 }
 
@@ -563,6 +781,20 @@ void SwiftInterfaceGenContext::accessASTAsync(std::function<void()> Fn) {
   }
 }
 
+/// Resolves an entity restored from the on-disk interface cache by its
+/// recorded USR.
+static SwiftInterfaceGenContext::ResolvedEntity
+resolveCachedEntity(ASTContext &Ctx, StringRef USR, bool IsRef) {
+  if (USR.empty())
+    return SwiftInterfaceGenContext::ResolvedEntity();
+  std::string Error;
+  Decl *D = ide::getDeclFromUSR(Ctx, USR, Error);
+  if (!D)
+    return SwiftInterfaceGenContext::ResolvedEntity();
+  return SwiftInterfaceGenContext::ResolvedEntity(dyn_cast<ValueDecl>(D),
+                                                  IsRef);
+}
+
 SwiftInterfaceGenContext::ResolvedEntity
 SwiftInterfaceGenContext::resolveEntityForOffset(unsigned Offset) const {
   // Search among the references.
@@ -576,8 +808,11 @@ SwiftInterfaceGenContext::resolveEntityForOffset(unsigned Offset) const {
     if (Pos != Impl.Info.References.end() && Pos->Range.Offset <= Offset) {
       if (Pos->Mod)
         return ResolvedEntity(Pos->Mod, true);
-      else
+      else if (Pos->Dcl)
         return ResolvedEntity(Pos->Dcl, true);
+      else
+        return resolveCachedEntity(Impl.Instance.getASTContext(), Pos->USR,
+                                   true);
     }
   }
 
@@ -595,8 +830,12 @@ SwiftInterfaceGenContext::resolveEntityForOffset(unsigned Offset) const {
       [&](const TextDecl &LHS, unsigned Offset) -> bool {
         return LHS.Range.Offset < Offset;
       });
-    if (Pos != Impl.Info.Decls.end() && Pos->Range.Offset == Offset)
-      return ResolvedEntity(dyn_cast<ValueDecl>(Pos->Dcl), false);
+    if (Pos != Impl.Info.Decls.end() && Pos->Range.Offset == Offset) {
+      if (Pos->Dcl)
+        return ResolvedEntity(dyn_cast<ValueDecl>(Pos->Dcl), false);
+      return resolveCachedEntity(Impl.Instance.getASTContext(), Pos->USR,
+                                 false);
+    }
   }
 
   return ResolvedEntity();
@@ -31,6 +31,7 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/raw_ostream.h"
 
 #if !defined(_WIN32)
@@ -178,6 +179,15 @@ SwiftLangSupport::SwiftLangSupport(SourceKit::Context &SKCtx)
   RuntimeResourcePath = LibPath.str();
 
   ASTMgr.reset(new SwiftASTManager(*this));
+  // Bound the memory retained by cached ASTs if requested.  The sessions
+  // for open documents stay warm (most recently used ASTs are kept), while
+  // long-running services stop accumulating ASTs for documents that are no
+  // longer touched.
+  if (auto Budget = llvm::sys::Process::GetEnv("SOURCEKIT_AST_MEMORY_BUDGET_MB")) {
+    size_t MBytes;
+    if (!StringRef(*Budget).getAsInteger(10, MBytes))
+      ASTMgr->setASTMemoryBudget(MBytes * 1024 * 1024);
+  }
   // By default, just use the in-memory cache.
   CCCache->inMemory = llvm::make_unique<ide::CodeCompletionCache>();
 }
@@ -27,6 +27,7 @@
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Mutex.h"
+#include <atomic>
 #include <map>
 #include <string>
 
@@ -146,6 +147,16 @@ class SessionCache : public ThreadSafeRefCountedBase<SessionCache> {
   bool completionHasExpectedTypes;
   bool completionMayUseImplicitMemberExpr;
   FilterRules filterRules;
+  /// The filter text used by the most recent update request and the
+  /// completions that matched it, used to refine the candidate set
+  /// incrementally when the next filter text extends this one.
+  std::string lastFilterText;
+  std::vector<Completion *> lastMatchedCompletions;
+  /// Incremented at the start of each update request for this session.  An
+  /// in-flight update that observes a newer generation has been superseded
+  /// by a later keystroke and aborts instead of finishing work the client
+  /// will discard.
+  std::atomic<uint64_t> updateGeneration{0};
   llvm::sys::Mutex mtx;
 
 public:
@@ -161,6 +172,16 @@ public:
         filterRules(std::move(filterRules)) {}
   void setSortedCompletions(std::vector<Completion *> &&completions);
   ArrayRef<Completion *> getSortedCompletions();
+  void setLastFilterState(StringRef filterText,
+                          std::vector<Completion *> &&matchedCompletions);
+  std::string getLastFilterText();
+  std::vector<Completion *> getLastMatchedCompletions();
+  /// Marks the start of a new update request and returns its generation.
+  uint64_t startUpdate() { return ++updateGeneration; }
+  /// Whether a newer update request has started since \p generation.
+  bool isUpdateSuperseded(uint64_t generation) {
+    return updateGeneration.load(std::memory_order_relaxed) != generation;
+  }
   llvm::MemoryBuffer *getBuffer();
   ArrayRef<std::string> getCompilerArgs();
   const FilterRules &getFilterRules();
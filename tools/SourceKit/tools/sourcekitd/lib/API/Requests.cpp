@@ -376,17 +376,6 @@ void handleRequestImpl(sourcekitd_object_t ReqObj, ResponseReceiver Rec) {
         "'key.compilerargs' not an array of strings"));
   }
 
-  if (ReqUID == RequestDocInfo) {
-    std::unique_ptr<llvm::MemoryBuffer>
-      InputBuf = getInputBufForRequest(SourceFile, SourceText, ErrBuf);
-    if (!InputBuf)
-      return Rec(createErrorRequestFailed(ErrBuf.c_str()));
-    StringRef ModuleName;
-    Optional<StringRef> ModuleNameOpt = Req.getString(KeyModuleName);
-    if (ModuleNameOpt.hasValue()) ModuleName = *ModuleNameOpt;
-    return Rec(reportDocInfo(InputBuf.get(), ModuleName, Args));
-  }
-
   if (ReqUID == RequestEditorOpen) {
     Optional<StringRef> Name = Req.getString(KeyName);
     if (!Name.hasValue())
@@ -688,7 +677,7 @@ void handleRequestImpl(sourcekitd_object_t ReqObj, ResponseReceiver Rec) {
   }
 
   if (!SourceFile.hasValue() && !SourceText.hasValue() &&
-      ReqUID != RequestCodeCompleteUpdate)
+      ReqUID != RequestCodeCompleteUpdate && ReqUID != RequestDocInfo)
     return Rec(createErrorRequestInvalid(
         "missing 'key.sourcefile' or 'key.sourcetext'"));
 
@@ -698,10 +687,19 @@ void handleRequestImpl(sourcekitd_object_t ReqObj, ResponseReceiver Rec) {
   // Run them under a malloc'ed stack.
 
   static WorkQueue SemaQueue{ WorkQueue::Dequeuing::Concurrent,
-                              "sourcekit.request.semantic" };
+                              "sourcekit.request.semantic",
+                              WorkQueue::Priority::High };
+  // Whole-file work that no keystroke is waiting on runs at low priority so
+  // it does not contend with the interactive requests above.
+  static WorkQueue BackgroundSemaQueue{
+      WorkQueue::Dequeuing::Concurrent,
+      "sourcekit.request.semantic.background", WorkQueue::Priority::Low };
+  WorkQueue &Queue = (ReqUID == RequestIndex || ReqUID == RequestDocInfo)
+                         ? BackgroundSemaQueue
+                         : SemaQueue;
   sourcekitd_request_retain(ReqObj);
   ++numSemaRequests;
-  SemaQueue.dispatch(
+  Queue.dispatch(
     [ReqObj, Rec, ReqUID, SourceFile, SourceText, Args] {
       RequestDict Req(ReqObj);
       handleSemanticRequest(Req, Rec, ReqUID, SourceFile, SourceText, Args);
@@ -757,6 +755,17 @@ handleSemanticRequest(RequestDict Req,
     return Rec(codeCompleteUpdate(*Name, Offset, options));
   }
 
+  if (ReqUID == RequestDocInfo) {
+    std::unique_ptr<llvm::MemoryBuffer>
+      InputBuf = getInputBufForRequest(SourceFile, SourceText, ErrBuf);
+    if (!InputBuf)
+      return Rec(createErrorRequestFailed(ErrBuf.c_str()));
+    StringRef ModuleName;
+    Optional<StringRef> ModuleNameOpt = Req.getString(KeyModuleName);
+    if (ModuleNameOpt.hasValue()) ModuleName = *ModuleNameOpt;
+    return Rec(reportDocInfo(InputBuf.get(), ModuleName, Args));
+  }
+
   if (!SourceFile.hasValue())
     return Rec(createErrorRequestInvalid("missing 'key.sourcefile'"));
 
@@ -1717,12 +1726,15 @@ class SKGroupedCodeCompletionConsumer : public GroupedCodeCompletionConsumer {
   ResponseBuilder::Dictionary Response;
   SmallVector<ResponseBuilder::Array, 3> GroupContentsStack;
   std::string ErrorDescription;
+  bool WasCancelled = false;
 
 public:
   explicit SKGroupedCodeCompletionConsumer(ResponseBuilder &RespBuilder)
       : RespBuilder(RespBuilder) {}
 
   sourcekitd_response_t createResponse() {
+    if (WasCancelled)
+      return createErrorRequestCancelled();
     if (!ErrorDescription.empty())
       return createErrorRequestFailed(ErrorDescription.c_str());
     assert(GroupContentsStack.empty() && "mismatched start/endGroup");
@@ -1730,6 +1742,7 @@ public:
   }
 
   void failed(StringRef ErrDescription) override;
+  void cancelled() override { WasCancelled = true; }
   bool handleResult(const CodeCompletionInfo &Info) override;
   void startGroup(UIdent kind, StringRef name) override;
   void endGroup() override;
@@ -2007,6 +2020,10 @@ public:
     return !SyntacticOnly && !isSemanticEditorDisabled();
   }
 
+  bool syntaxMapEnabled() override { return EnableSyntaxMap; }
+
+  bool documentStructureEnabled() override { return EnableStructure; }
+
   void handleRequestError(const char *Description) override;
 
   bool handleSyntaxMap(unsigned Offset, unsigned Length, UIdent Kind) override;
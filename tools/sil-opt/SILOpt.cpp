@@ -127,6 +127,12 @@ static llvm::cl::opt<OptGroup> OptimizationGroup(
         clEnumValN(OptGroup::Lowering, "lowering", "Run lowering passes")),
     llvm::cl::init(OptGroup::Unknown));
 
+static llvm::cl::opt<std::string> ExternalPassPipelineFilename(
+    "external-pass-pipeline-filename",
+    llvm::cl::desc("Filename for a pass pipeline plan, e.g. one dumped by "
+                   "sil-passpipeline-dumper and edited"),
+    llvm::cl::value_desc("filename"));
+
 static llvm::cl::list<PassKind>
 Passes(llvm::cl::desc("Passes:"),
        llvm::cl::values(
@@ -415,6 +421,9 @@ int main(int argc, char **argv) {
     runSILOptimizationPasses(*CI.getSILModule());
   } else if (OptimizationGroup == OptGroup::Lowering) {
     runSILLoweringPasses(*CI.getSILModule());
+  } else if (!ExternalPassPipelineFilename.empty()) {
+    runSILOptimizationPassesWithFileSpecification(
+        *CI.getSILModule(), ExternalPassPipelineFilename);
   } else {
     auto *SILMod = CI.getSILModule();
     {
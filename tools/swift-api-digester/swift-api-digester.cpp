@@ -846,12 +846,14 @@ public:
 
 SDKNode* SDKNode::constructSDKNode(SDKContext &Ctx,
                                    llvm::yaml::MappingNode *Node) {
-  static auto GetScalarString = [&](llvm::yaml::Node *N) -> StringRef {
+  auto GetScalarString = [&](llvm::yaml::Node *N) -> StringRef {
     auto WithQuote = cast<llvm::yaml::ScalarNode>(N)->getRawValue();
-    return WithQuote.substr(1, WithQuote.size() - 2);
+    // Copy the text into the context so the deserialized forest does not
+    // alias the transient file buffer.
+    return Ctx.buffer(WithQuote.substr(1, WithQuote.size() - 2));
   };
 
-  static auto getAsInt = [&](llvm::yaml::Node *N) -> int {
+  auto getAsInt = [](llvm::yaml::Node *N) -> int {
     return std::stoi(cast<llvm::yaml::ScalarNode>(N)->getRawValue());
   };
   SDKNodeKind Kind;
@@ -1360,12 +1362,10 @@ static void addMembersToRoot(SDKContext &Ctx, SDKNode *Root,
 
 static void emitSDKNodeRoot(raw_ostream&, SDKNode *&);
 
-static std::pair<std::unique_ptr<llvm::MemoryBuffer>, SDKNode *>
-parseJsonEmit(SDKContext &Ctx, StringRef);
+static SDKNode *parseJsonEmit(SDKContext &Ctx, StringRef);
 
 class SwiftDeclCollector : public VisibleDeclConsumer {
   SDKContext &Ctx;
-  std::vector<std::unique_ptr<llvm::MemoryBuffer>> OwnedBuffers;
   SDKNode *RootNode;
   llvm::DenseSet<ValueDecl*> KnownDecls;
   // Collected and sorted after we get all of them.
@@ -1381,9 +1381,7 @@ public:
   // Construct all roots vector from a given file where a forest was
   // previously dumped.
   void deSerialize(StringRef Filename) {
-    auto Pair = parseJsonEmit(Ctx, Filename);
-    OwnedBuffers.push_back(std::move(Pair.first));
-    RootNode = std::move(Pair.second);
+    RootNode = parseJsonEmit(Ctx, Filename);
   }
 
   // Serialize the content of all roots to a given file using JSON format.
@@ -1604,9 +1602,10 @@ static void emitSDKNodeRoot(llvm::raw_ostream &os, SDKNode *&Root) {
   yout << Root;
 }
 
-// Deserialize an SDKNode tree.
-std::pair<std::unique_ptr<llvm::MemoryBuffer>, SDKNode*>
-parseJsonEmit(SDKContext &Ctx, StringRef FileName) {
+// Deserialize an SDKNode tree.  All text is copied into the SDKContext
+// during construction, so the file buffer and the YAML parse tree are freed
+// here instead of staying resident for the whole comparison.
+SDKNode *parseJsonEmit(SDKContext &Ctx, StringRef FileName) {
   namespace yaml = llvm::yaml;
 
   // Load the input file.
@@ -1625,7 +1624,7 @@ parseJsonEmit(SDKContext &Ctx, StringRef FileName) {
     assert(N && "Failed to find a root");
     Result = SDKNode::constructSDKNode(Ctx, cast<yaml::MappingNode>(N));
   }
-  return {std::move(FileBufOrErr.get()), Result};
+  return Result;
 }
 
 // Given two NodeVector, this matches SDKNode by the order of their appearance
@@ -0,0 +1,328 @@
+//===--- swift-module-bench.cpp - Module serialization benchmark ----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This is a host-side tool that round-trips a corpus of Swift modules
+// through the serializer. Each input file is type checked once, then
+// serialized and deserialized repeatedly (with unmeasured warmup iterations
+// first) and the per-sample wall times are summarized in the same log
+// format the standard library benchmark drivers emit, so runs from two
+// compilers can be diffed with benchmark/scripts/compare_perf_tests.py.
+// Serializer throughput in MB/s and per-decl materialization latency are
+// reported as comment lines, which that script ignores.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/AST/ASTContext.h"
+#include "swift/AST/Decl.h"
+#include "swift/AST/Module.h"
+#include "swift/Frontend/Frontend.h"
+#include "swift/Frontend/PrintingDiagnosticConsumer.h"
+#include "swift/Serialization/SerializationOptions.h"
+#include "swift/Serialization/SerializedModuleLoader.h"
+#include "swift/Subsystems.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace swift;
+using llvm::StringRef;
+
+namespace options {
+static llvm::cl::OptionCategory Category("swift-module-bench Options");
+
+static llvm::cl::list<std::string>
+InputFilenames(llvm::cl::Positional, llvm::cl::desc("<input files>"),
+               llvm::cl::OneOrMore, llvm::cl::cat(Category));
+
+static llvm::cl::opt<unsigned>
+NumSamples("num-samples",
+           llvm::cl::desc("Number of measured round trips per module"),
+           llvm::cl::cat(Category),
+           llvm::cl::init(10));
+
+static llvm::cl::opt<unsigned>
+NumWarmupIterations("warmup",
+                    llvm::cl::desc("Number of unmeasured round trips per "
+                                   "module before sampling begins"),
+                    llvm::cl::cat(Category),
+                    llvm::cl::init(1));
+
+static llvm::cl::opt<std::string>
+SDK("sdk", llvm::cl::desc("Path to the SDK to build against"),
+    llvm::cl::cat(Category));
+} // end namespace options
+
+static void anchorForGetMainExecutable() {}
+
+namespace {
+
+/// Summary statistics over the measured samples, in microseconds.
+struct SampleStats {
+  uint64_t Min;
+  uint64_t Max;
+  uint64_t Mean;
+  uint64_t SD;
+  uint64_t Median;
+};
+
+SampleStats computeStats(std::vector<uint64_t> Samples) {
+  std::sort(Samples.begin(), Samples.end());
+
+  SampleStats Stats;
+  Stats.Min = Samples.front();
+  Stats.Max = Samples.back();
+  Stats.Median = Samples[Samples.size() / 2];
+
+  double Sum = 0;
+  for (auto Sample : Samples)
+    Sum += Sample;
+  double Mean = Sum / Samples.size();
+  Stats.Mean = static_cast<uint64_t>(Mean + 0.5);
+
+  double SumSquares = 0;
+  for (auto Sample : Samples)
+    SumSquares += (Sample - Mean) * (Sample - Mean);
+  double Variance = Samples.size() < 2 ? 0 : SumSquares / (Samples.size() - 1);
+  Stats.SD = static_cast<uint64_t>(std::sqrt(Variance) + 0.5);
+  return Stats;
+}
+
+uint64_t microsecondsSince(std::chrono::steady_clock::time_point Start) {
+  auto End = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(End - Start)
+      .count();
+}
+
+/// Derive a legal module name from a corpus file name.
+std::string moduleNameForInput(StringRef InputFilename) {
+  auto isIdentifierChar = [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+  };
+  std::string Name = llvm::sys::path::stem(InputFilename).str();
+  for (char &c : Name)
+    if (!isIdentifierChar(c))
+      c = '_';
+  if (Name.empty() || (Name.front() >= '0' && Name.front() <= '9'))
+    Name.insert(Name.begin(), '_');
+  return Name;
+}
+
+void printStatsLine(unsigned Ordinal, StringRef Prefix, StringRef TestName,
+                    const SampleStats &Stats) {
+  llvm::outs() << Ordinal << "," << Prefix << "." << TestName << ","
+               << options::NumSamples << "," << Stats.Min << "," << Stats.Max
+               << "," << Stats.Mean << "," << Stats.SD << "," << Stats.Median
+               << "\n";
+}
+
+/// Type checks one corpus file so that it can be serialized. The returned
+/// instance stays alive for the whole measurement.
+std::unique_ptr<CompilerInstance>
+compileCorpusFile(const char *MainExecutablePath, StringRef InputFilename,
+                  StringRef ModuleName, PrintingDiagnosticConsumer &DiagPrinter) {
+  CompilerInvocation Invocation;
+  Invocation.addInputFilename(InputFilename);
+  Invocation.setModuleName(ModuleName);
+  Invocation.setSDKPath(options::SDK);
+  Invocation.setMainExecutablePath(llvm::sys::fs::getMainExecutable(
+      MainExecutablePath,
+      reinterpret_cast<void *>(&anchorForGetMainExecutable)));
+
+  auto Instance = llvm::make_unique<CompilerInstance>();
+  Instance->addDiagnosticConsumer(&DiagPrinter);
+  if (Instance->setup(Invocation))
+    return nullptr;
+  Instance->performSema();
+  if (Instance->getASTContext().hadError())
+    return nullptr;
+  return Instance;
+}
+
+/// Serialize the instance's main module to \p OutputPath and return the
+/// wall time spent, in microseconds.
+uint64_t serializeOnce(CompilerInstance &Instance, StringRef OutputPath) {
+  std::string Path = OutputPath.str();
+  SerializationOptions SerOpts;
+  SerOpts.OutputPath = Path.c_str();
+
+  auto Start = std::chrono::steady_clock::now();
+  serialize(Instance.getMainModule(), SerOpts, /*SILMod=*/nullptr);
+  return microsecondsSince(Start);
+}
+
+/// One measured deserialization of a module, split into the initial load
+/// and the materialization of every top-level decl and type member.
+struct DeserializeSample {
+  uint64_t LoadMicros;
+  uint64_t MaterializeMicros;
+  uint64_t NumDecls;
+};
+
+/// Load the serialized module at \p ModulePath into a fresh ASTContext and
+/// force all of its decls, timing both phases. Instance setup and reading
+/// the file into memory are excluded from the timed regions.
+llvm::Optional<DeserializeSample>
+deserializeOnce(const char *MainExecutablePath, StringRef ModuleName,
+                StringRef ModulePath, PrintingDiagnosticConsumer &DiagPrinter) {
+  CompilerInvocation Invocation;
+  Invocation.setModuleName("ModuleBench");
+  Invocation.setSDKPath(options::SDK);
+  Invocation.setMainExecutablePath(llvm::sys::fs::getMainExecutable(
+      MainExecutablePath,
+      reinterpret_cast<void *>(&anchorForGetMainExecutable)));
+
+  CompilerInstance Instance;
+  Instance.addDiagnosticConsumer(&DiagPrinter);
+  if (Instance.setup(Invocation))
+    return llvm::None;
+
+  auto Buffer = llvm::MemoryBuffer::getFile(ModulePath);
+  if (!Buffer)
+    return llvm::None;
+  Instance.getSerializedModuleLoader()->registerMemoryBuffer(
+      ModuleName, std::move(Buffer.get()));
+
+  auto &Context = Instance.getASTContext();
+  DeserializeSample Sample;
+
+  auto LoadStart = std::chrono::steady_clock::now();
+  auto *Module =
+      Context.getModule({{Context.getIdentifier(ModuleName), SourceLoc()}});
+  Sample.LoadMicros = microsecondsSince(LoadStart);
+  if (!Module || Module->failedToLoad())
+    return llvm::None;
+
+  auto MaterializeStart = std::chrono::steady_clock::now();
+  SmallVector<Decl *, 64> TopLevelDecls;
+  Module->getTopLevelDecls(TopLevelDecls);
+  Sample.NumDecls = TopLevelDecls.size();
+  for (Decl *D : TopLevelDecls) {
+    if (auto *NTD = dyn_cast<NominalTypeDecl>(D)) {
+      for (Decl *Member : NTD->getMembers()) {
+        (void)Member;
+        ++Sample.NumDecls;
+      }
+    }
+  }
+  Sample.MaterializeMicros = microsecondsSince(MaterializeStart);
+  return Sample;
+}
+
+int benchmarkModule(const char *MainExecutablePath, StringRef InputFilename,
+                    unsigned &Ordinal) {
+  std::string ModuleName = moduleNameForInput(InputFilename);
+
+  PrintingDiagnosticConsumer DiagPrinter;
+  auto Instance = compileCorpusFile(MainExecutablePath, InputFilename,
+                                    ModuleName, DiagPrinter);
+  if (!Instance) {
+    llvm::errs() << "swift-module-bench: cannot compile '" << InputFilename
+                 << "'\n";
+    return EXIT_FAILURE;
+  }
+
+  llvm::SmallString<128> ModulePath;
+  if (llvm::sys::fs::createTemporaryFile(ModuleName, "swiftmodule",
+                                         ModulePath)) {
+    llvm::errs() << "swift-module-bench: cannot create temporary file\n";
+    return EXIT_FAILURE;
+  }
+  llvm::FileRemover ModuleRemover(ModulePath);
+
+  for (unsigned i = 0; i < options::NumWarmupIterations; ++i) {
+    (void)serializeOnce(*Instance, ModulePath);
+    if (!deserializeOnce(MainExecutablePath, ModuleName, ModulePath,
+                         DiagPrinter)) {
+      llvm::errs() << "swift-module-bench: cannot reload '" << InputFilename
+                   << "'\n";
+      return EXIT_FAILURE;
+    }
+  }
+  // Make sure at least one serialized copy exists even with -warmup=0.
+  if (options::NumWarmupIterations == 0)
+    (void)serializeOnce(*Instance, ModulePath);
+
+  uint64_t ModuleSize = 0;
+  (void)llvm::sys::fs::file_size(ModulePath, ModuleSize);
+
+  std::vector<uint64_t> SerializeSamples;
+  std::vector<uint64_t> DeserializeSamples;
+  SerializeSamples.reserve(options::NumSamples);
+  DeserializeSamples.reserve(options::NumSamples);
+  uint64_t NumDecls = 0;
+
+  for (unsigned i = 0; i < options::NumSamples; ++i) {
+    SerializeSamples.push_back(serializeOnce(*Instance, ModulePath));
+
+    auto Sample = deserializeOnce(MainExecutablePath, ModuleName, ModulePath,
+                                  DiagPrinter);
+    if (!Sample) {
+      llvm::errs() << "swift-module-bench: cannot reload '" << InputFilename
+                   << "'\n";
+      return EXIT_FAILURE;
+    }
+    DeserializeSamples.push_back(Sample->LoadMicros +
+                                 Sample->MaterializeMicros);
+    NumDecls = Sample->NumDecls;
+  }
+
+  auto SerializeStats = computeStats(std::move(SerializeSamples));
+  auto DeserializeStats = computeStats(std::move(DeserializeSamples));
+  printStatsLine(Ordinal++, "SerializeModule", ModuleName, SerializeStats);
+  printStatsLine(Ordinal++, "DeserializeModule", ModuleName, DeserializeStats);
+
+  // Throughput figures, based on the median samples. The leading '#' keeps
+  // compare_perf_tests.py from treating these lines as results.
+  double SerializeSeconds = SerializeStats.Median / 1e6;
+  llvm::outs() << llvm::format(
+      "# SerializeModule.%s: %llu bytes, %.2f MB/sec\n", ModuleName.c_str(),
+      ModuleSize, ModuleSize / SerializeSeconds / (1024.0 * 1024.0));
+  llvm::outs() << llvm::format(
+      "# DeserializeModule.%s: %llu decls materialized, %.2f us/decl\n",
+      ModuleName.c_str(), NumDecls,
+      NumDecls ? double(DeserializeStats.Median) / NumDecls : 0.0);
+  return EXIT_SUCCESS;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[]) {
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "Swift Module Serialization Benchmark\n");
+
+  if (options::NumSamples == 0) {
+    llvm::errs() << "swift-module-bench: -num-samples must be nonzero\n";
+    return EXIT_FAILURE;
+  }
+
+  llvm::outs() << "#,TEST,SAMPLES,MIN(us),MAX(us),MEAN(us),SD(us),MEDIAN(us)\n";
+
+  unsigned Ordinal = 1;
+  for (const auto &InputFilename : options::InputFilenames) {
+    if (benchmarkModule(argv[0], InputFilename, Ordinal) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
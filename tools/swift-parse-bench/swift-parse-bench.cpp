@@ -0,0 +1,211 @@
+//===--- swift-parse-bench.cpp - Parser throughput benchmark --------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This is a host-side tool that measures isolated parser throughput over a
+// corpus of Swift files. Each file is parsed repeatedly (with unmeasured
+// warmup iterations first) and the per-sample wall times are summarized in
+// the same log format the standard library benchmark drivers emit, so runs
+// from two compilers can be diffed with
+// benchmark/scripts/compare_perf_tests.py. Tokens/second and bytes/second
+// figures are reported as comment lines, which that script ignores.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/LangOptions.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Frontend/Frontend.h"
+#include "swift/Frontend/PrintingDiagnosticConsumer.h"
+#include "swift/Parse/Token.h"
+#include "swift/Subsystems.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace swift;
+using llvm::StringRef;
+
+namespace options {
+static llvm::cl::OptionCategory Category("swift-parse-bench Options");
+
+static llvm::cl::list<std::string>
+InputFilenames(llvm::cl::Positional, llvm::cl::desc("<input files>"),
+               llvm::cl::OneOrMore, llvm::cl::cat(Category));
+
+static llvm::cl::opt<unsigned>
+NumSamples("num-samples",
+           llvm::cl::desc("Number of measured parses per file"),
+           llvm::cl::cat(Category),
+           llvm::cl::init(10));
+
+static llvm::cl::opt<unsigned>
+NumWarmupIterations("warmup",
+                    llvm::cl::desc("Number of unmeasured parses per file "
+                                   "before sampling begins"),
+                    llvm::cl::cat(Category),
+                    llvm::cl::init(1));
+} // end namespace options
+
+static void anchorForGetMainExecutable() {}
+
+namespace {
+
+/// The size of one corpus file, in the units the throughput figures are
+/// reported in.
+struct CorpusFileSize {
+  uint64_t NumTokens;
+  uint64_t NumBytes;
+};
+
+/// Summary statistics over the measured samples, in microseconds.
+struct SampleStats {
+  uint64_t Min;
+  uint64_t Max;
+  uint64_t Mean;
+  uint64_t SD;
+  uint64_t Median;
+};
+
+/// Lex \p InputFilename outside of the timed region to find out how many
+/// tokens and bytes each measured parse covers.
+llvm::Optional<CorpusFileSize> measureCorpusFile(StringRef InputFilename) {
+  auto Buffer = llvm::MemoryBuffer::getFile(InputFilename);
+  if (!Buffer)
+    return llvm::None;
+
+  LangOptions LangOpts;
+  SourceManager SourceMgr;
+  CorpusFileSize Size;
+  Size.NumBytes = Buffer.get()->getBufferSize();
+  unsigned BufferID = SourceMgr.addNewSourceBuffer(std::move(Buffer.get()));
+  Size.NumTokens = tokenize(LangOpts, SourceMgr, BufferID).size();
+  return Size;
+}
+
+/// Parse \p InputFilename once with a fresh CompilerInstance and return the
+/// wall time spent in the parse itself, in microseconds. Instance setup is
+/// excluded from the timed region.
+llvm::Optional<uint64_t> parseOnce(const char *MainExecutablePath,
+                                   StringRef InputFilename) {
+  CompilerInvocation Invocation;
+  Invocation.addInputFilename(InputFilename);
+  Invocation.setModuleName("ParseBench");
+  Invocation.setMainExecutablePath(llvm::sys::fs::getMainExecutable(
+      MainExecutablePath,
+      reinterpret_cast<void *>(&anchorForGetMainExecutable)));
+
+  CompilerInstance Instance;
+  PrintingDiagnosticConsumer DiagPrinter;
+  Instance.addDiagnosticConsumer(&DiagPrinter);
+  if (Instance.setup(Invocation))
+    return llvm::None;
+
+  auto Start = std::chrono::steady_clock::now();
+  Instance.performParseOnly();
+  auto End = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(End - Start)
+      .count();
+}
+
+SampleStats computeStats(std::vector<uint64_t> Samples) {
+  std::sort(Samples.begin(), Samples.end());
+
+  SampleStats Stats;
+  Stats.Min = Samples.front();
+  Stats.Max = Samples.back();
+  Stats.Median = Samples[Samples.size() / 2];
+
+  double Sum = 0;
+  for (auto Sample : Samples)
+    Sum += Sample;
+  double Mean = Sum / Samples.size();
+  Stats.Mean = static_cast<uint64_t>(Mean + 0.5);
+
+  double SumSquares = 0;
+  for (auto Sample : Samples)
+    SumSquares += (Sample - Mean) * (Sample - Mean);
+  double Variance = Samples.size() < 2 ? 0 : SumSquares / (Samples.size() - 1);
+  Stats.SD = static_cast<uint64_t>(std::sqrt(Variance) + 0.5);
+  return Stats;
+}
+
+int benchmarkFile(const char *MainExecutablePath, StringRef InputFilename,
+                  unsigned Ordinal) {
+  auto Size = measureCorpusFile(InputFilename);
+  if (!Size) {
+    llvm::errs() << "swift-parse-bench: cannot open '" << InputFilename
+                 << "'\n";
+    return EXIT_FAILURE;
+  }
+
+  for (unsigned i = 0; i < options::NumWarmupIterations; ++i) {
+    if (!parseOnce(MainExecutablePath, InputFilename))
+      return EXIT_FAILURE;
+  }
+
+  std::vector<uint64_t> Samples;
+  Samples.reserve(options::NumSamples);
+  for (unsigned i = 0; i < options::NumSamples; ++i) {
+    auto Sample = parseOnce(MainExecutablePath, InputFilename);
+    if (!Sample)
+      return EXIT_FAILURE;
+    Samples.push_back(*Sample);
+  }
+
+  auto Stats = computeStats(std::move(Samples));
+  StringRef TestName = llvm::sys::path::stem(InputFilename);
+
+  llvm::outs() << Ordinal << ",Parse." << TestName << ","
+               << options::NumSamples << "," << Stats.Min << "," << Stats.Max
+               << "," << Stats.Mean << "," << Stats.SD << "," << Stats.Median
+               << "\n";
+
+  // Throughput figures, based on the median sample. The leading '#' keeps
+  // compare_perf_tests.py from treating these lines as results.
+  double MedianSeconds = Stats.Median / 1e6;
+  llvm::outs() << llvm::format(
+      "# Parse.%s: %llu tokens, %llu bytes, %.0f tokens/sec, %.2f MB/sec\n",
+      TestName.str().c_str(), Size->NumTokens, Size->NumBytes,
+      Size->NumTokens / MedianSeconds,
+      Size->NumBytes / MedianSeconds / (1024.0 * 1024.0));
+  return EXIT_SUCCESS;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[]) {
+  llvm::cl::ParseCommandLineOptions(argc, argv, "Swift Parser Benchmark\n");
+
+  if (options::NumSamples == 0) {
+    llvm::errs() << "swift-parse-bench: -num-samples must be nonzero\n";
+    return EXIT_FAILURE;
+  }
+
+  llvm::outs() << "#,TEST,SAMPLES,MIN(us),MAX(us),MEAN(us),SD(us),MEDIAN(us)\n";
+
+  unsigned Ordinal = 1;
+  for (const auto &InputFilename : options::InputFilenames) {
+    if (benchmarkFile(argv[0], InputFilename, Ordinal) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+    ++Ordinal;
+  }
+  return EXIT_SUCCESS;
+}
@@ -31,8 +31,12 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <csignal>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using llvm::dyn_cast;
 using llvm::StringRef;
@@ -68,6 +72,13 @@ BinaryFilename("binary-filename", llvm::cl::desc("Filenames of the binary files"
 static llvm::cl::opt<std::string>
 Architecture("arch", llvm::cl::desc("Architecture to inspect in the binary"),
              llvm::cl::Required);
+
+static llvm::cl::opt<bool>
+Parallel("parallel",
+         llvm::cl::desc("Dump binary images on parallel threads, one "
+                        "TypeRefBuilder per image, concatenating the dumps "
+                        "in input order (dump-reflection-sections only)"),
+         llvm::cl::init(false));
 } // end namespace options
 
 template<typename T>
@@ -135,6 +146,43 @@ static ReflectionInfo findReflectionInfo(const ObjectFile *objectFile) {
   };
 }
 
+/// Dump each image's reflection sections with its own TypeRefBuilder on a
+/// pool of threads, concatenating the per-image dumps in input order. The
+/// section memory is read-only once the images are loaded, and a dump never
+/// needs typerefs from another image, so the builders are fully independent.
+static void dumpReflectionInfosInParallel(ArrayRef<ReflectionInfo> infos,
+                                          std::ostream &OS) {
+  std::vector<std::string> outputs(infos.size());
+  std::atomic<size_t> nextImage(0);
+
+  auto worker = [&] {
+    for (;;) {
+      size_t i = nextImage.fetch_add(1);
+      if (i >= infos.size())
+        return;
+      TypeRefBuilder builder;
+      builder.addReflectionInfo(infos[i]);
+      std::ostringstream SS;
+      builder.dumpAllSections(SS);
+      outputs[i] = SS.str();
+    }
+  };
+
+  size_t numThreads = std::thread::hardware_concurrency();
+  if (numThreads == 0)
+    numThreads = 1;
+  numThreads = std::min(numThreads, infos.size());
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i != numThreads; ++i)
+    threads.emplace_back(worker);
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto &output : outputs)
+    OS << output;
+}
+
 static int doDumpReflectionSections(ArrayRef<std::string> binaryFilenames,
                                     StringRef arch,
                                     ActionType action,
@@ -143,6 +191,7 @@ static int doDumpReflectionSections(ArrayRef<std::string> binaryFilenames,
   // once they go out of scope, we can no longer do anything.
   std::vector<OwningBinary<Binary>> binaryOwners;
   std::vector<std::unique_ptr<ObjectFile>> objectOwners;
+  std::vector<ReflectionInfo> reflectionInfos;
 
   // Construct the TypeRefBuilder
   TypeRefBuilder builder;
@@ -164,7 +213,9 @@ static int doDumpReflectionSections(ArrayRef<std::string> binaryFilenames,
       objectFile = objectOwner.get();
     }
 
-    builder.addReflectionInfo(findReflectionInfo(objectFile));
+    auto reflectionInfo = findReflectionInfo(objectFile);
+    reflectionInfos.push_back(reflectionInfo);
+    builder.addReflectionInfo(reflectionInfo);
 
     // Retain the objects that own section memory
     binaryOwners.push_back(std::move(binaryOwner));
@@ -174,7 +225,10 @@ static int doDumpReflectionSections(ArrayRef<std::string> binaryFilenames,
   switch (action) {
   case ActionType::DumpReflectionSections:
     // Dump everything
-    builder.dumpAllSections(OS);
+    if (options::Parallel && reflectionInfos.size() > 1)
+      dumpReflectionInfosInParallel(reflectionInfos, OS);
+    else
+      builder.dumpAllSections(OS);
     break;
   case ActionType::DumpTypeLowering: {
     for (std::string line; std::getline(std::cin, line); ) {
@@ -79,21 +79,12 @@ TEST(Cache, sameValue) {
   EXPECT_EQ(0, c.exit);
 
   cache.set("b", c);
-#if USES_LIBCACHE
   EXPECT_EQ(1, c.enter); // value is shared.
-#else
-  EXPECT_EQ(2, c.enter);
-#endif
   EXPECT_EQ(0, c.exit);
 
   cache.remove("a");
-#if USES_LIBCACHE
   EXPECT_EQ(1, c.enter); // value is shared.
   EXPECT_EQ(0, c.exit);
-#else
-  EXPECT_EQ(2, c.enter);
-  EXPECT_EQ(1, c.exit);
-#endif
 
   cache.remove("b");
   EXPECT_EQ(c.enter, c.exit);
@@ -166,6 +157,64 @@ TEST(Cache, sameKeyValueIntrusiveRefCountPter) {
   EXPECT_TRUE(freed);
 }
 
+namespace {
+struct CostlyValue {
+  int ident;
+};
+
+/// Forces every key into the same shard so LRU eviction order is
+/// deterministic across the sharded default implementation.
+struct SameShardKeyInfo : swift::sys::CacheKeyInfo<int> {
+  static uintptr_t getHashValue(const int &value) { return 0; }
+};
+}
+
+namespace swift {
+namespace sys {
+template <>
+struct CacheValueCostInfo<CostlyValue> {
+  static size_t getCost(const CostlyValue &value) { return 100; }
+};
+}
+}
+
+#if !USES_LIBCACHE
+// The libcache backend evicts based on memory pressure notifications and
+// ignores the cost limit, so only the default implementation has
+// deterministic eviction behavior to test.
+
+TEST(Cache, costLimitEvictsLeastRecentlyUsed) {
+  swift::sys::Cache<int, CostlyValue, SameShardKeyInfo> cache(__func__);
+  // Room for two 100-cost entries in the shard.
+  cache.setCostLimit(8 * 250);
+  cache.set(1, {1});
+  cache.set(2, {2});
+  EXPECT_TRUE(cache.get(1).hasValue());
+  EXPECT_TRUE(cache.get(2).hasValue());
+
+  // Touch 1 so that 2 becomes the least recently used entry, then push the
+  // shard over budget.
+  EXPECT_EQ(1, cache.get(1)->ident);
+  cache.set(3, {3});
+  EXPECT_TRUE(cache.get(1).hasValue());
+  EXPECT_FALSE(cache.get(2).hasValue());
+  EXPECT_TRUE(cache.get(3).hasValue());
+}
+
+TEST(Cache, costLimitKeepsNewestEntry) {
+  swift::sys::Cache<int, CostlyValue, SameShardKeyInfo> cache(__func__);
+  // Below the cost of any single entry; the most recently added entry must
+  // still be cached.
+  cache.setCostLimit(8);
+  cache.set(1, {1});
+  EXPECT_TRUE(cache.get(1).hasValue());
+
+  cache.set(2, {2});
+  EXPECT_FALSE(cache.get(1).hasValue());
+  EXPECT_TRUE(cache.get(2).hasValue());
+}
+#endif
+
 TEST(Cache, copyValue) {
   struct S {
     int ident, copy;
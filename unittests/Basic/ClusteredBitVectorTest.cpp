@@ -208,3 +208,82 @@ TEST(ClusteredBitVector, FlipAllBig) {
   EXPECT_EQ(true, vec[7]);
   EXPECT_EQ(1u, vec.count());
 }
+
+TEST(ClusteredBitVector, AndNot) {
+  ClusteredBitVector vec;
+  vec.add(16, 0xFFFF);
+  vec.appendSetBits(100);
+
+  ClusteredBitVector mask;
+  mask.add(16, 0x00FF);
+  mask.appendClearBits(36);
+  mask.appendSetBits(64);
+
+  vec.andNot(mask);
+  EXPECT_EQ(116u, vec.size());
+  EXPECT_EQ(false, vec[0]);
+  EXPECT_EQ(false, vec[7]);
+  EXPECT_EQ(true, vec[8]);
+  EXPECT_EQ(true, vec[51]);
+  EXPECT_EQ(false, vec[52]);
+  EXPECT_EQ(false, vec[115]);
+  EXPECT_EQ(44u, vec.count());
+
+  // Against an all-clear vector, it's a no-op.
+  ClusteredBitVector allClear;
+  allClear.appendClearBits(116);
+  vec.andNot(allClear);
+  EXPECT_EQ(44u, vec.count());
+
+  // On an all-clear vector, it's a no-op.
+  allClear.andNot(vec);
+  EXPECT_EQ(0u, allClear.count());
+}
+
+TEST(ClusteredBitVector, CountRange) {
+  ClusteredBitVector vec;
+  vec.appendClearBits(200);
+  EXPECT_EQ(0u, vec.count(0, 200));
+
+  vec.setBit(3);
+  vec.setBit(63);
+  vec.setBit(64);
+  vec.setBit(100);
+  vec.setBit(199);
+  EXPECT_EQ(5u, vec.count());
+  EXPECT_EQ(5u, vec.count(0, 200));
+  EXPECT_EQ(0u, vec.count(4, 63));
+  EXPECT_EQ(2u, vec.count(63, 65));
+  EXPECT_EQ(1u, vec.count(64, 100));
+  EXPECT_EQ(2u, vec.count(64, 101));
+  EXPECT_EQ(1u, vec.count(101, 200));
+  EXPECT_EQ(0u, vec.count(100, 100));
+
+  // Within a single chunk.
+  EXPECT_EQ(1u, vec.count(0, 10));
+  EXPECT_EQ(0u, vec.count(4, 10));
+}
+
+TEST(ClusteredBitVector, AppendChunks) {
+  ClusteredBitVector vec;
+  vec.add(5, 0x15);
+
+  const uint64_t chunks[] = { 0x8000000000000001ULL, 0x5ULL };
+  vec.append(67, chunks);
+  EXPECT_EQ(72u, vec.size());
+  EXPECT_EQ(true, vec[0]);
+  EXPECT_EQ(true, vec[5]);
+  EXPECT_EQ(false, vec[6]);
+  EXPECT_EQ(true, vec[68]);
+  EXPECT_EQ(true, vec[69]);
+  EXPECT_EQ(false, vec[70]);
+  EXPECT_EQ(true, vec[71]);
+  EXPECT_EQ(7u, vec.count());
+
+  // Appending all-zero chunks to an all-clear vector stays inline.
+  ClusteredBitVector zeros;
+  const uint64_t zeroChunks[] = { 0, 0, 0 };
+  zeros.append(190, zeroChunks);
+  EXPECT_EQ(190u, zeros.size());
+  EXPECT_EQ(0u, zeros.count());
+}
@@ -0,0 +1,93 @@
+//===--- JSONSerializationTest.cpp ----------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/JSONSerialization.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+#include <limits>
+
+using namespace swift;
+
+namespace {
+struct Scalars {
+  bool Flag = true;
+  uint8_t U8 = 255;
+  uint32_t U32 = 4000000000U;
+  uint64_t U64 = std::numeric_limits<uint64_t>::max();
+  int32_t Negative = -42;
+  int64_t Minimum = std::numeric_limits<int64_t>::min();
+  int64_t Zero = 0;
+  double Real = 0.5;
+  std::string Text = "line1\nline\"2\"\x01";
+};
+} // end anonymous namespace
+
+namespace swift {
+namespace json {
+template <>
+struct ObjectTraits<Scalars> {
+  static void mapping(Output &out, Scalars &value) {
+    out.mapRequired("flag", value.Flag);
+    out.mapRequired("u8", value.U8);
+    out.mapRequired("u32", value.U32);
+    out.mapRequired("u64", value.U64);
+    out.mapRequired("negative", value.Negative);
+    out.mapRequired("minimum", value.Minimum);
+    out.mapRequired("zero", value.Zero);
+    out.mapRequired("real", value.Real);
+    out.mapRequired("text", value.Text);
+  }
+};
+} // end namespace json
+} // end namespace swift
+
+TEST(JSONSerialization, scalarFastPaths) {
+  Scalars s;
+  std::string Storage;
+  llvm::raw_string_ostream OS(Storage);
+  swift::json::Output out(OS, /*PrettyPrint=*/false);
+  out << s;
+  EXPECT_EQ("{\"flag\":true,"
+            "\"u8\":255,"
+            "\"u32\":4000000000,"
+            "\"u64\":18446744073709551615,"
+            "\"negative\":-42,"
+            "\"minimum\":-9223372036854775808,"
+            "\"zero\":0,"
+            "\"real\":0.5,"
+            "\"text\":\"line1\\nline\\\"2\\\"\\u0001\"}",
+            OS.str());
+}
+
+TEST(JSONSerialization, bufferOutputMatchesStream) {
+  Scalars s;
+
+  std::string Storage;
+  llvm::raw_string_ostream OS(Storage);
+  swift::json::Output streamOut(OS);
+  streamOut << s;
+
+  llvm::SmallString<256> Buffer;
+  swift::json::Output bufferOut(Buffer);
+  bufferOut << s;
+
+  EXPECT_EQ(OS.str(), Buffer.str().str());
+}
+
+TEST(JSONSerialization, bufferOutputAppends) {
+  Scalars s;
+  llvm::SmallString<256> Buffer("prefix:");
+  swift::json::Output out(Buffer, /*PrettyPrint=*/false);
+  out << s;
+  EXPECT_TRUE(Buffer.str().startswith("prefix:{\"flag\":true,"));
+}
@@ -15,8 +15,11 @@
 
 #include "llvm/ADT/SmallString.h"
 
+#include <chrono>
+#include <cstdio>
 #include <string>
 #include <map>
+#include <vector>
 
 using namespace swift;
 
@@ -194,3 +197,130 @@ TEST(PrefixMapTest, Test4) {
   tester.validate();
   tester.find("zguowwnctgmkg");
 }
+
+// Generate a path-like key set with heavily shared prefixes, in sorted
+// order (std::map iteration order is lexicographic for these keys).
+static std::map<std::string, int> makeBulkKeySet() {
+  static const char *const Dirs[] = {"usr", "usr/local", "opt", "home"};
+  static const char *const Subdirs[] = {"include", "lib", "share", "bin"};
+  static const char *const Names[] = {"alpha", "beta", "gamma", "delta",
+                                      "epsilon", "zeta", "eta", "theta"};
+  std::map<std::string, int> keys;
+  int nextValue = 0;
+  for (auto dir : Dirs)
+    for (auto subdir : Subdirs)
+      for (auto name : Names)
+        keys[std::string(dir) + "/" + subdir + "/" + name] = nextValue++;
+  return keys;
+}
+
+TEST(PrefixMapTest, BulkLoad) {
+  auto keys = makeBulkKeySet();
+
+  std::vector<std::pair<ArrayRef<char>, int>> entries;
+  for (auto &entry : keys)
+    entries.push_back({asArray(entry.first), entry.second});
+
+  PrefixMap<char, int> bulkMap(entries);
+  PrefixMap<char, int> insertMap;
+  for (auto &entry : keys)
+    insertMap.insert(asArray(entry.first), entry.second);
+
+  EXPECT_EQ(insertMap.size(), bulkMap.size());
+
+  // Exact probes, extension probes, and misses all agree with the
+  // insertion-built map.
+  for (auto &entry : keys) {
+    for (auto probe : {entry.first, entry.first + "/more", entry.first + "x",
+                       "zz" + entry.first}) {
+      auto bulkResult = bulkMap.findPrefix(asArray(probe));
+      auto insertResult = insertMap.findPrefix(asArray(probe));
+      EXPECT_EQ(bool(insertResult.first), bool(bulkResult.first));
+      if (insertResult.first) {
+        EXPECT_EQ(*insertResult.first, *bulkResult.first);
+        EXPECT_EQ(insertResult.second - probe.data(),
+                  bulkResult.second - probe.data());
+      }
+    }
+  }
+
+  // Iteration visits the same entries in the same order.
+  auto bi = bulkMap.begin(), be = bulkMap.end();
+  for (auto &entry : keys) {
+    ASSERT_TRUE(bi != be);
+    EXPECT_EQ(entry.second, (*bi).getValue());
+    llvm::SmallString<128> buffer;
+    EXPECT_EQ(StringRef(entry.first), asString((*bi).getKey(buffer)));
+    ++bi;
+  }
+  EXPECT_TRUE(bi == be);
+
+  // The map stays mutable after a bulk load, including insertions which
+  // split bulk-loaded nodes.
+  auto inserted = bulkMap.insert(asArray("usr/inc"), 424242);
+  EXPECT_TRUE(inserted.second);
+  EXPECT_EQ(424242, *bulkMap.findPrefix(asArray("usr/inc/x")).first);
+  EXPECT_EQ(keys.at("usr/include/alpha"),
+            *bulkMap.findPrefix(asArray("usr/include/alpha")).first);
+}
+
+TEST(PrefixMapTest, BulkLoadEmptyAndSingle) {
+  ArrayRef<std::pair<ArrayRef<char>, int>> noEntries;
+  PrefixMap<char, int> emptyMap(noEntries);
+  EXPECT_EQ(0U, emptyMap.size());
+
+  // A bulk load containing the empty key.
+  std::vector<std::pair<ArrayRef<char>, int>> entries;
+  entries.push_back({asArray(""), 1});
+  entries.push_back({asArray("ab"), 2});
+  entries.push_back({asArray("abcdefghijklmnop"), 3});
+  PrefixMap<char, int> map(entries);
+  EXPECT_EQ(3U, map.size());
+  EXPECT_EQ(1, *map.findPrefix(asArray("zzz")).first);
+  EXPECT_EQ(2, *map.findPrefix(asArray("abc")).first);
+  EXPECT_EQ(3, *map.findPrefix(asArray("abcdefghijklmnopq")).first);
+}
+
+// Not really a test: compares probe latency of a bulk-loaded map against
+// an insertion-built one over the same key set.
+TEST(PrefixMapTest, BulkLoadProbeBenchmark) {
+  auto keys = makeBulkKeySet();
+
+  std::vector<std::pair<ArrayRef<char>, int>> entries;
+  std::vector<std::string> probes;
+  for (auto &entry : keys) {
+    entries.push_back({asArray(entry.first), entry.second});
+    probes.push_back(entry.first + "/suffix");
+  }
+
+  PrefixMap<char, int> bulkMap(entries);
+  PrefixMap<char, int> insertMap;
+  for (auto &entry : entries)
+    insertMap.insert(entry.first, entry.second);
+
+  const unsigned NumRounds = 200;
+  auto measure = [&](const PrefixMap<char, int> &map) {
+    unsigned hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != NumRounds; ++i) {
+      for (auto &probe : probes) {
+        if (map.findPrefix(asArray(probe)).first)
+          ++hits;
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(NumRounds * probes.size(), hits);
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+        .count();
+  };
+
+  // Warm up both maps, then measure.
+  measure(insertMap);
+  measure(bulkMap);
+  auto insertTime = measure(insertMap);
+  auto bulkTime = measure(bulkMap);
+  printf("PrefixMap probe benchmark: %u probes, insertion-built %lld us, "
+         "bulk-loaded %lld us\n",
+         NumRounds * unsigned(probes.size()), (long long)insertTime,
+         (long long)bulkTime);
+}
@@ -97,3 +97,54 @@ TEST(SourceManager, RangeContains) {
   EXPECT_TRUE(SM.rangeContains(R_ad, R_bc));
 }
 
+TEST(SourceManager, GetLineAndColumn) {
+  SourceManager SM;
+  StringRef Source = "aaa\nbb b\n\nccc ddd\n";
+  unsigned ID = SM.addMemBufferCopy(Source);
+  SourceLoc Begin = SM.getLocForBufferStart(ID);
+
+  // First character.
+  EXPECT_EQ(std::make_pair(1u, 1u), SM.getLineAndColumn(Begin));
+  // Last character of the first line, and its newline.
+  EXPECT_EQ(std::make_pair(1u, 3u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(2), ID));
+  EXPECT_EQ(std::make_pair(1u, 4u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(3), ID));
+  // Second and third lines.
+  EXPECT_EQ(std::make_pair(2u, 1u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(4), ID));
+  EXPECT_EQ(std::make_pair(2u, 4u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(7), ID));
+  EXPECT_EQ(std::make_pair(3u, 1u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(9), ID));
+  // Fourth line, with and without an explicit buffer ID.
+  EXPECT_EQ(std::make_pair(4u, 5u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(14), ID));
+  EXPECT_EQ(std::make_pair(4u, 5u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(14)));
+  EXPECT_EQ(4u, SM.getLineNumber(Begin.getAdvancedLoc(14), ID));
+  // One past the last newline is line 5.
+  EXPECT_EQ(std::make_pair(5u, 1u),
+            SM.getLineAndColumn(Begin.getAdvancedLoc(18), ID));
+}
+
+TEST(SourceManager, ResolveFromLineCol) {
+  SourceManager SM;
+  StringRef Source = "aaa\nbb b\n\nccc ddd";
+  unsigned ID = SM.addMemBufferCopy(Source);
+
+  EXPECT_EQ(0u, *SM.resolveFromLineCol(ID, 1, 1));
+  EXPECT_EQ(2u, *SM.resolveFromLineCol(ID, 1, 3));
+  // The newline itself is addressable.
+  EXPECT_EQ(3u, *SM.resolveFromLineCol(ID, 1, 4));
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 1, 5).hasValue());
+  EXPECT_EQ(4u, *SM.resolveFromLineCol(ID, 2, 1));
+  EXPECT_EQ(9u, *SM.resolveFromLineCol(ID, 3, 1));
+  // A line or column of zero never resolves.
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 0, 1).hasValue());
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 1, 0).hasValue());
+  // The final line is unterminated, so it cannot be resolved (this
+  // matches the behavior of the old buffer scan).
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 4, 1).hasValue());
+  EXPECT_FALSE(SM.resolveFromLineCol(ID, 5, 1).hasValue());
+}
@@ -101,6 +101,36 @@ TEST(TreeScopedHashTableTest, T2) {
   delete S1;
 }
 
+TEST(TreeScopedHashTableTest, DetachAndReenterScope) {
+  using HashtableTy = TreeScopedHashTable<unsigned, unsigned>;
+  using ScopeTy = HashtableTy::ScopeTy;
+  HashtableTy HT;
+
+  auto S1 = new ScopeTy(HT, 0);
+  HT.insertIntoScope(*S1, 1, 1001);
+
+  auto S2 = new ScopeTy(HT, S1);
+  HT.insertIntoScope(*S2, 1, 2001);
+  HT.insertIntoScope(*S2, 2, 2002);
+
+  auto Saved = S2->detach();
+  delete S2;
+
+  // The detached scope keeps its bindings alive and can be re-entered.
+  auto S2a = new ScopeTy(std::move(Saved));
+  EXPECT_EQ(2001U, HT.lookup(*S2a, 1));
+  EXPECT_EQ(2002U, HT.lookup(*S2a, 2));
+  HT.insertIntoScope(*S2a, 3, 2003);
+  EXPECT_EQ(2003U, HT.lookup(*S2a, 3));
+
+  delete S2a;
+
+  EXPECT_EQ(1001U, HT.lookup(*S1, 1));
+  EXPECT_EQ(0U,    HT.lookup(*S1, 2));
+  EXPECT_EQ(0U,    HT.lookup(*S1, 3));
+  delete S1;
+}
+
 TEST(TreeScopedHashTableTest, IteratorTest) {
   using HashtableTy = TreeScopedHashTable<unsigned, int>;
   using ScopeTy = HashtableTy::ScopeTy;
@@ -790,3 +790,108 @@ TEST(DependencyGraph, ChainedExternalPreMarked) {
   EXPECT_TRUE(graph.isMarked(0));
   EXPECT_FALSE(graph.isMarked(1));
 }
+
+TEST(DependencyGraph, DeclHashesLimitCascading) {
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a, b]\n"
+                                 "provides-decl-hashes: [[a, 1111], [b, 2222]]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-top-level: [a]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(2, "depends-top-level: [b]"),
+            LoadResult::UpToDate);
+
+  // Only 'b' changed, so only its dependent should be marked.
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a, b]\n"
+                                 "provides-decl-hashes: [[a, 1111], [b, 3333]]"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(2u, marked.front());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_FALSE(graph.isMarked(1));
+  EXPECT_TRUE(graph.isMarked(2));
+}
+
+TEST(DependencyGraph, DeclHashesConsumedAfterMarking) {
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a]\n"
+                                 "provides-decl-hashes: [[a, 1111]]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-top-level: [a]"),
+            LoadResult::UpToDate);
+
+  // Nothing changed, so the initial cascade is suppressed...
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a]\n"
+                                 "provides-decl-hashes: [[a, 1111]]"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(0u, marked.size());
+  EXPECT_FALSE(graph.isMarked(1));
+
+  // ...but a second mark for an unrelated reason cascades in full.
+  marked.clear();
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_TRUE(graph.isMarked(1));
+}
+
+TEST(DependencyGraph, DeclHashesUnhashedNamesAlwaysCascade) {
+  DependencyGraph<uintptr_t> graph;
+
+  // 'op' has no hash entry (operator declarations and precedence groups
+  // never get one), so it can never be proven unchanged.
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a, op]\n"
+                                 "provides-decl-hashes: [[a, 1111]]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-top-level: [a]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(2, "depends-top-level: [op]"),
+            LoadResult::UpToDate);
+
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a, op]\n"
+                                 "provides-decl-hashes: [[a, 1111]]"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(2u, marked.front());
+  EXPECT_FALSE(graph.isMarked(1));
+  EXPECT_TRUE(graph.isMarked(2));
+}
+
+TEST(DependencyGraph, DeclHashesAggregateOverloads) {
+  DependencyGraph<uintptr_t> graph;
+
+  // Multiple entries for one name (overloads) combine; a change to any one
+  // of them must dirty the name even when the last entry is unchanged.
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a]\n"
+                                 "provides-decl-hashes: [[a, 1111], [a, 2222]]"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, "depends-top-level: [a]"),
+            LoadResult::UpToDate);
+
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level: [a]\n"
+                                 "provides-decl-hashes: [[a, 3333], [a, 2222]]"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_TRUE(graph.isMarked(1));
+}
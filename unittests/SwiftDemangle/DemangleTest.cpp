@@ -60,3 +60,36 @@ TEST(FunctionNameDemangleTests, IgnoresNonMangledInputs) {
   EXPECT_STREQ("0123456789abcdef", OutputBuffer);
 }
 
+TEST(FunctionNameDemangleTests, FastPathMatchesFullDemangler) {
+  char OutputBuffer[128];
+
+  // Shapes covered by the print-only fast path.
+  const char *NoArgs = "_T04main3fooyyF";
+  const char *NoArgsDemangled = "main.foo() -> ()";
+  size_t Result = swift_demangle_getDemangledName(NoArgs, OutputBuffer,
+                                                  sizeof(OutputBuffer));
+  EXPECT_STREQ(NoArgsDemangled, OutputBuffer);
+  EXPECT_EQ(Result, strlen(NoArgsDemangled));
+
+  const char *OneArg = "_T03abc6testitySiF";
+  const char *OneArgDemangled = "abc.testit(Swift.Int) -> ()";
+  Result = swift_demangle_getDemangledName(OneArg, OutputBuffer,
+                                           sizeof(OutputBuffer));
+  EXPECT_STREQ(OneArgDemangled, OutputBuffer);
+  EXPECT_EQ(Result, strlen(OneArgDemangled));
+
+  const char *Returning = "_T04main3barSSyF";
+  const char *ReturningDemangled = "main.bar() -> Swift.String";
+  Result = swift_demangle_getDemangledName(Returning, OutputBuffer,
+                                           sizeof(OutputBuffer));
+  EXPECT_STREQ(ReturningDemangled, OutputBuffer);
+  EXPECT_EQ(Result, strlen(ReturningDemangled));
+
+  // Truncation keeps the strlcpy-like semantics of the regular path.
+  char SmallBuffer[8];
+  Result = swift_demangle_getDemangledName(NoArgs, SmallBuffer,
+                                           sizeof(SmallBuffer));
+  EXPECT_EQ(Result, strlen(NoArgsDemangled));
+  EXPECT_STREQ("main.fo", SmallBuffer);
+}
+
@@ -1,5 +1,7 @@
 #include "swift/Parse/Token.h"
 #include "swift/Syntax/RawSyntax.h"
+#include "swift/Syntax/RawTokenSyntax.h"
+#include "swift/Syntax/SyntaxArena.h"
 #include "swift/Syntax/SyntaxFactory.h"
 #include "llvm/ADT/SmallString.h"
 #include "gtest/gtest.h"
@@ -7,4 +9,30 @@
 using namespace swift;
 using namespace swift::syntax;
 
-// TODO
+TEST(RawSyntaxTests, ArenaAllocatedNodesSkipRefCounting) {
+  auto Arena = SyntaxArena::make();
+  RC<RawSyntax> Node;
+  {
+    auto Tok = RawTokenSyntax::make(tok::identifier, "foo",
+                                    SourcePresence::Present, {}, {}, Arena);
+    Node = RawSyntax::make(SyntaxKind::UnknownExpr, {Tok},
+                           SourcePresence::Present, Arena);
+  }
+  ASSERT_TRUE(Node->isArenaAllocated());
+
+  // Handles may be copied and dropped freely without affecting the nodes'
+  // lifetime; the tree stays alive as long as the arena does.
+  {
+    RC<RawSyntax> Copy = Node;
+    ASSERT_EQ(Copy.get(), Node.get());
+  }
+  auto Tok = llvm::cast<RawTokenSyntax>(Node->Layout.front());
+  ASSERT_TRUE(Tok->isArenaAllocated());
+  ASSERT_EQ(Tok->getText(), "foo");
+}
+
+TEST(RawSyntaxTests, HeapAllocatedNodesRemainRefCounted) {
+  auto Node = RawSyntax::make(SyntaxKind::UnknownExpr, {},
+                              SourcePresence::Present);
+  ASSERT_FALSE(Node->isArenaAllocated());
+}
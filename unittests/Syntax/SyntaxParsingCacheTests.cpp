@@ -0,0 +1,71 @@
+#include "swift/Syntax/SyntaxParsingCache.h"
+#include "swift/Syntax/SyntaxFactory.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+/// Builds the syntax tree for a source file containing two top-level
+/// fallthrough statements, each covering the 12 bytes "fallthrough\n".
+static SourceFileSyntax makeTwoStmtSourceFile() {
+  auto FallthroughKW =
+      SyntaxFactory::makeFallthroughKeyword({}, Trivia::newlines(1));
+  auto Fallthrough = SyntaxFactory::makeFallthroughStmt(FallthroughKW,
+                                                        llvm::None);
+  auto StmtList = SyntaxFactory::makeStmtList({Fallthrough});
+  auto TopLevel = SyntaxFactory::makeTopLevelCodeDecl(StmtList);
+  auto Decls = SyntaxFactory::makeDeclList({TopLevel, TopLevel});
+  return SyntaxFactory::makeSourceFile(Decls,
+                                       TokenSyntax::missingToken(tok::eof,
+                                                                 ""));
+}
+
+TEST(SyntaxParsingCacheTests, ReuseWithoutEdits) {
+  SyntaxParsingCache Cache(makeTwoStmtSourceFile());
+
+  auto First = Cache.lookUp(0, SyntaxKind::TopLevelCodeDecl);
+  ASSERT_NE(First, nullptr);
+  ASSERT_EQ(First->Kind, SyntaxKind::TopLevelCodeDecl);
+
+  auto Second = Cache.lookUp(12, SyntaxKind::TopLevelCodeDecl);
+  ASSERT_NE(Second, nullptr);
+
+  // No node starts at offset 1.
+  ASSERT_EQ(Cache.lookUp(1, SyntaxKind::TopLevelCodeDecl), nullptr);
+
+  ASSERT_EQ(Cache.getReuseHits(), 2u);
+  ASSERT_EQ(Cache.getReuseMisses(), 1u);
+}
+
+TEST(SyntaxParsingCacheTests, EditedNodeIsNotReused) {
+  SyntaxParsingCache Cache(makeTwoStmtSourceFile());
+
+  // Replace the first statement by a same-length identifier.
+  Cache.addEdit(/*Start=*/0, /*End=*/11, /*ReplacementLength=*/11);
+
+  // The first top-level decl is damaged, the second one is untouched.
+  ASSERT_EQ(Cache.lookUp(0, SyntaxKind::TopLevelCodeDecl), nullptr);
+  ASSERT_NE(Cache.lookUp(12, SyntaxKind::TopLevelCodeDecl), nullptr);
+}
+
+TEST(SyntaxParsingCacheTests, PositionsTranslateAcrossInsertion) {
+  SyntaxParsingCache Cache(makeTwoStmtSourceFile());
+
+  // Insert two characters at the very beginning of the file.
+  Cache.addEdit(/*Start=*/0, /*End=*/0, /*ReplacementLength=*/2);
+
+  // The insertion touches the first top-level decl, so it cannot be reused.
+  ASSERT_EQ(Cache.lookUp(2, SyntaxKind::TopLevelCodeDecl), nullptr);
+
+  // The second decl now starts at offset 14 in the edited file and is still
+  // reusable at its translated position.
+  ASSERT_NE(Cache.lookUp(14, SyntaxKind::TopLevelCodeDecl), nullptr);
+
+  // Positions inside the inserted text have no pre-edit counterpart.
+  ASSERT_EQ(Cache.lookUp(1, SyntaxKind::TopLevelCodeDecl), nullptr);
+}
+
+TEST(SyntaxParsingCacheTests, NodeTextLengthIncludesTrivia) {
+  auto File = makeTwoStmtSourceFile();
+  ASSERT_EQ(SyntaxParsingCache::getNodeTextLength(File.getRaw()), 24u);
+}
@@ -0,0 +1,136 @@
+//===--- Arena.cpp - Allocation arena tests for the Swift runtime --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/Metadata.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <vector>
+
+using namespace swift;
+
+struct TestObject : HeapObject {
+  size_t *Addr;
+  size_t Value;
+};
+
+static SWIFT_CC(swift) void destroyTestObject(SWIFT_CONTEXT HeapObject *_object) {
+  auto object = static_cast<TestObject*>(_object);
+  assert(object->Addr && "object already deallocated");
+  *object->Addr = object->Value;
+  object->Addr = nullptr;
+  swift_deallocObject(object, sizeof(TestObject), alignof(TestObject) - 1);
+}
+
+static const FullMetadata<ClassMetadata> TestClassObjectMetadata = {
+  { { &destroyTestObject }, { &VALUE_WITNESS_SYM(Bo) } },
+  { { { MetadataKind::Class } }, 0, /*rodata*/ 1,
+  ClassFlags::UsesSwift1Refcounting, nullptr, 0, 0, 0, 0, 0 }
+};
+
+/// Create an object in \p arena that, when deinitialized, stores the given
+/// value to the given pointer.
+static TestObject *allocTestObjectInArena(SwiftArena *arena, size_t *addr,
+                                          size_t value) {
+  auto result = static_cast<TestObject *>(
+      swift_allocObjectInArena(arena, &TestClassObjectMetadata,
+                               sizeof(TestObject),
+                               alignof(TestObject) - 1));
+  result->Addr = addr;
+  result->Value = value;
+  return result;
+}
+
+/// Create an ordinary heap object with the same deinit behavior.
+static TestObject *allocTestObject(size_t *addr, size_t value) {
+  auto result =
+    static_cast<TestObject *>(swift_allocObject(&TestClassObjectMetadata,
+                                                sizeof(TestObject),
+                                                alignof(TestObject) - 1));
+  result->Addr = addr;
+  result->Value = value;
+  return result;
+}
+
+TEST(ArenaTest, release_all_then_destroy) {
+  auto arena = swift_arenaCreate(0);
+  size_t values[3] = {0, 0, 0};
+  TestObject *objects[3];
+  for (size_t i = 0; i < 3; ++i)
+    objects[i] = allocTestObjectInArena(arena, &values[i], i + 1);
+
+  // Arena objects are reference counted and deinitialized exactly like
+  // ordinary objects; only the reclamation of their memory is deferred.
+  swift_retain(objects[0]);
+  swift_release(objects[0]);
+  EXPECT_EQ(0u, values[0]);
+
+  for (auto object : objects)
+    swift_release(object);
+  EXPECT_EQ(1u, values[0]);
+  EXPECT_EQ(2u, values[1]);
+  EXPECT_EQ(3u, values[2]);
+
+  swift_arenaDestroy(arena);
+}
+
+TEST(ArenaTest, allocation_crosses_chunk_boundary) {
+  // A chunk size this small forces a new chunk every few objects.
+  auto arena = swift_arenaCreate(256);
+  const size_t count = 100;
+  std::vector<size_t> values(count, 0);
+  std::vector<TestObject *> objects;
+  for (size_t i = 0; i < count; ++i) {
+    auto object = allocTestObjectInArena(arena, &values[i], i + 1);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(object)
+                      & (alignof(TestObject) - 1));
+    objects.push_back(object);
+  }
+
+  // No two allocations may coincide, within or across chunks, and the
+  // contents of earlier objects must survive later chunks being started.
+  std::set<TestObject *> distinct(objects.begin(), objects.end());
+  EXPECT_EQ(count, distinct.size());
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(&values[i], objects[i]->Addr);
+    EXPECT_EQ(i + 1, objects[i]->Value);
+  }
+
+  for (auto object : objects)
+    swift_release(object);
+  for (size_t i = 0; i < count; ++i)
+    EXPECT_EQ(i + 1, values[i]);
+
+  swift_arenaDestroy(arena);
+}
+
+TEST(ArenaTest, ordinary_deallocations_unaffected) {
+  auto arena = swift_arenaCreate(0);
+  size_t arenaValue = 0;
+  auto arenaObject = allocTestObjectInArena(arena, &arenaValue, 1);
+
+  // While an arena is live, releasing an ordinary object must still run its
+  // deinit and free its memory through swift_slowDealloc as usual.
+  size_t heapValue = 0;
+  auto heapObject = allocTestObject(&heapValue, 2);
+  swift_release(heapObject);
+  EXPECT_EQ(2u, heapValue);
+
+  // Nor may plain slowAlloc/slowDealloc traffic be swallowed.
+  void *memory = swift_slowAlloc(128, alignof(void *) - 1);
+  EXPECT_NE(nullptr, memory);
+  swift_slowDealloc(memory, 128, alignof(void *) - 1);
+
+  swift_release(arenaObject);
+  EXPECT_EQ(1u, arenaValue);
+  swift_arenaDestroy(arena);
+}
@@ -0,0 +1,342 @@
+//===--- RuntimeBenchmarks.cpp - Micro-benchmarks for the runtime ---------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Micro-benchmarks for hot runtime entry points: retain/release pairs,
+// class dynamic casts, generic metadata instantiation, and protocol
+// conformance lookups.
+//
+// Each benchmark times a fixed number of iterations over several samples
+// and reports the per-sample runtimes as a CSV row in the format consumed
+// by benchmark/scripts/compare_perf_tests.py:
+//
+//   <ordinal>,<name>,<samples>,MIN,MAX,MEAN,SD,MEDIAN   (times in us)
+//
+// Rows are written to the file named by the SWIFT_RUNTIME_BENCH_OUTPUT
+// environment variable when it is set, so the CSV is not interleaved with
+// gtest's own output; otherwise they go to stdout.
+//
+// In asserts builds, benchmarks also cross-check the global runtime
+// function counters to make sure they exercise the entry points they
+// claim to measure.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/Casting.h"
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/Metadata.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace swift;
+
+#ifndef NDEBUG
+// Declarations from stdlib/public/runtime/RuntimeInvocationsTracking.h,
+// which is not an installed header. The counters state is one uint32_t
+// per tracked function, in the same order as the names array.
+namespace swift {
+struct RuntimeFunctionCountersState;
+}
+SWIFT_RUNTIME_EXPORT void _swift_getGlobalRuntimeFunctionCounters(
+    RuntimeFunctionCountersState *result);
+SWIFT_RUNTIME_EXPORT const char **_swift_getRuntimeFunctionNames();
+SWIFT_RUNTIME_EXPORT uint64_t _swift_getNumRuntimeFunctionCounters();
+SWIFT_RUNTIME_EXPORT int _swift_setGlobalRuntimeFunctionCountersMode(int mode);
+
+/// Read the global invocation counter for the runtime function \p name,
+/// or 0 if the function is not tracked.
+static uint64_t readGlobalCounter(const char *name) {
+  auto numCounters = _swift_getNumRuntimeFunctionCounters();
+  std::vector<uint32_t> state(numCounters);
+  _swift_getGlobalRuntimeFunctionCounters(
+      reinterpret_cast<RuntimeFunctionCountersState *>(state.data()));
+  auto names = _swift_getRuntimeFunctionNames();
+  for (uint64_t i = 0; i != numCounters; ++i)
+    if (!strcmp(names[i], name))
+      return state[i];
+  return 0;
+}
+#endif
+
+/// The number of timed samples taken per benchmark.
+static const unsigned NumSamples = 10;
+
+/// The number of iterations of the measured operation per sample.
+static const uint64_t NumIterations = 100000;
+
+static uint64_t nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Emit one CSV row for a benchmark's samples, in microseconds.
+static void reportBenchmark(const char *name, std::vector<uint64_t> samples) {
+  static FILE *out = nullptr;
+  static unsigned ordinal = 0;
+  if (!out) {
+    if (const char *path = getenv("SWIFT_RUNTIME_BENCH_OUTPUT"))
+      out = fopen(path, "a");
+    if (!out)
+      out = stdout;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  uint64_t min = samples.front(), max = samples.back();
+  uint64_t median = samples[samples.size() / 2];
+  double mean = 0;
+  for (auto sample : samples)
+    mean += sample;
+  mean /= samples.size();
+  double variance = 0;
+  for (auto sample : samples)
+    variance += (sample - mean) * (sample - mean);
+  variance /= samples.size();
+
+  fprintf(out, "%u,%s,%zu,%llu,%llu,%llu,%llu,%llu\n", ++ordinal, name,
+          samples.size(), (unsigned long long)min, (unsigned long long)max,
+          (unsigned long long)(mean + 0.5),
+          (unsigned long long)(std::sqrt(variance) + 0.5),
+          (unsigned long long)median);
+  fflush(out);
+}
+
+/// Run \p body once untimed to warm up caches, then \p NumSamples times
+/// under the timer, and report the samples.
+template <class Body>
+static void runBenchmark(const char *name, const Body &body) {
+  std::vector<uint64_t> samples;
+  samples.reserve(NumSamples);
+  body();
+  for (unsigned i = 0; i != NumSamples; ++i) {
+    auto start = nowMicros();
+    body();
+    samples.push_back(nowMicros() - start);
+  }
+  reportBenchmark(name, std::move(samples));
+}
+
+//===----------------------------------------------------------------------===//
+// Retain/release pairs
+//===----------------------------------------------------------------------===//
+
+struct TestObject : HeapObject {
+  size_t *Addr;
+  size_t Value;
+};
+
+static SWIFT_CC(swift) void destroyTestObject(SWIFT_CONTEXT HeapObject *_object) {
+  auto object = static_cast<TestObject*>(_object);
+  assert(object->Addr && "object already deallocated");
+  *object->Addr = object->Value;
+  object->Addr = nullptr;
+  swift_deallocObject(object, sizeof(TestObject), alignof(TestObject) - 1);
+}
+
+static const FullMetadata<ClassMetadata> TestClassObjectMetadata = {
+  { { &destroyTestObject }, { &VALUE_WITNESS_SYM(Bo) } },
+  { { { MetadataKind::Class } }, 0, /*rodata*/ 1,
+  ClassFlags::UsesSwift1Refcounting, nullptr, 0, 0, 0, 0, 0 }
+};
+
+/// A second, unrelated class for the failing side of the cast matrix.
+static const FullMetadata<ClassMetadata> OtherClassObjectMetadata = {
+  { { &destroyTestObject }, { &VALUE_WITNESS_SYM(Bo) } },
+  { { { MetadataKind::Class } }, 0, /*rodata*/ 1,
+  ClassFlags::UsesSwift1Refcounting, nullptr, 0, 0, 0, 0, 0 }
+};
+
+static TestObject *allocTestObject(size_t *addr, size_t value) {
+  auto result =
+    static_cast<TestObject *>(swift_allocObject(&TestClassObjectMetadata,
+                                                sizeof(TestObject),
+                                                alignof(TestObject) - 1));
+  result->Addr = addr;
+  result->Value = value;
+  return result;
+}
+
+TEST(RuntimeBench, RetainRelease) {
+  size_t value = 0;
+  auto object = allocTestObject(&value, 1);
+
+  runBenchmark("RuntimeBench.RetainRelease", [&] {
+    for (uint64_t i = 0; i != NumIterations; ++i) {
+      swift_retain(object);
+      swift_release(object);
+    }
+  });
+
+#ifndef NDEBUG
+  // Cross-check that the loop above exercises the entry points it claims
+  // to. Counters are only enabled for this untimed pass.
+  auto oldMode = _swift_setGlobalRuntimeFunctionCountersMode(1);
+  auto retainsBefore = readGlobalCounter("swift_retain");
+  auto releasesBefore = readGlobalCounter("swift_release");
+  const uint64_t checkedIterations = 1000;
+  for (uint64_t i = 0; i != checkedIterations; ++i) {
+    swift_retain(object);
+    swift_release(object);
+  }
+  EXPECT_EQ(retainsBefore + checkedIterations,
+            readGlobalCounter("swift_retain"));
+  EXPECT_EQ(releasesBefore + checkedIterations,
+            readGlobalCounter("swift_release"));
+  _swift_setGlobalRuntimeFunctionCountersMode(oldMode);
+#endif
+
+  EXPECT_EQ(0u, value);
+  swift_release(object);
+  EXPECT_EQ(1u, value);
+}
+
+//===----------------------------------------------------------------------===//
+// Class dynamic casts
+//===----------------------------------------------------------------------===//
+
+TEST(RuntimeBench, DynamicCastClass) {
+  size_t value = 0;
+  auto object = allocTestObject(&value, 1);
+
+  // Failures are only counted inside the timed loops; asserting on each
+  // iteration would measure gtest instead of the runtime.
+  uint64_t failures = 0;
+
+  runBenchmark("RuntimeBench.DynamicCastClassHit", [&] {
+    for (uint64_t i = 0; i != NumIterations; ++i)
+      if (swift_dynamicCastClass(object, &TestClassObjectMetadata) != object)
+        ++failures;
+  });
+  EXPECT_EQ(0u, failures);
+
+  runBenchmark("RuntimeBench.DynamicCastClassMiss", [&] {
+    for (uint64_t i = 0; i != NumIterations; ++i)
+      if (swift_dynamicCastClass(object, &OtherClassObjectMetadata) != nullptr)
+        ++failures;
+  });
+  EXPECT_EQ(0u, failures);
+
+  swift_release(object);
+  EXPECT_EQ(1u, value);
+}
+
+//===----------------------------------------------------------------------===//
+// Generic metadata instantiation
+//===----------------------------------------------------------------------===//
+
+/// Unique global pointers used as generic arguments.
+static uint32_t BenchGlobal1 = 0;
+static uint32_t BenchGlobal2 = 0;
+
+/// The general structure of a generic metadata, as laid out in
+/// unittests/runtime/Metadata.cpp.
+template <typename Instance, unsigned NumArguments>
+struct GenericMetadataTest {
+  GenericMetadata Header;
+  Instance Template;
+  void *Storage[NumArguments];
+};
+
+static GenericMetadataTest<StructMetadata, 1> BenchMetadataPattern = {
+  // Header
+  {
+    // allocation function
+    [](GenericMetadata *pattern, const void *args) -> Metadata * {
+      auto metadata = swift_allocateGenericValueMetadata(pattern, args);
+      auto metadataWords = reinterpret_cast<const void**>(metadata);
+      auto argsWords = reinterpret_cast<const void* const*>(args);
+      metadataWords[2] = argsWords[0];
+      return metadata;
+    },
+    3 * sizeof(void*), // metadata size
+    1, // num arguments
+    0, // address point
+    {} // private data
+  },
+
+  // Fields
+  {
+    MetadataKind::Struct,
+    reinterpret_cast<const NominalTypeDescriptor*>(&BenchGlobal1)
+  },
+
+  // Arguments
+  {nullptr}
+};
+
+TEST(RuntimeBench, GetGenericMetadataHit) {
+  auto pattern = (GenericMetadata *)&BenchMetadataPattern;
+  void *args[] = { &BenchGlobal2 };
+
+  auto expected = swift_getGenericMetadata(pattern, args);
+  uint64_t failures = 0;
+  runBenchmark("RuntimeBench.GetGenericMetadataHit", [&] {
+    for (uint64_t i = 0; i != NumIterations; ++i)
+      if (swift_getGenericMetadata(pattern, args) != expected)
+        ++failures;
+  });
+  EXPECT_EQ(0u, failures);
+}
+
+TEST(RuntimeBench, GetGenericMetadataMiss) {
+  auto pattern = (GenericMetadata *)&BenchMetadataPattern;
+
+  // Every instantiation stays in the pattern's cache, so the miss
+  // benchmark uses fewer iterations and draws a fresh key from this
+  // arena for each one.
+  const uint64_t missIterations = 2048;
+  static char missKeys[(NumSamples + 1) * missIterations];
+  char *nextKey = missKeys;
+
+  uint64_t failures = 0;
+  runBenchmark("RuntimeBench.GetGenericMetadataMiss", [&] {
+    for (uint64_t i = 0; i != missIterations; ++i) {
+      void *args[] = { nextKey++ };
+      if (swift_getGenericMetadata(pattern, args) == nullptr)
+        ++failures;
+    }
+  });
+  EXPECT_EQ(0u, failures);
+}
+
+//===----------------------------------------------------------------------===//
+// Protocol conformance lookup
+//===----------------------------------------------------------------------===//
+
+static ProtocolDescriptor BenchProtocol{
+  "_TMp17RuntimeBenchmarks13BenchProtocol",
+  nullptr,
+  ProtocolDescriptorFlags()
+    .withSwift(true)
+    .withClassConstraint(ProtocolClassConstraint::Any)
+    .withDispatchStrategy(ProtocolDispatchStrategy::Swift)
+};
+
+TEST(RuntimeBench, ConformsToProtocol) {
+  // No conformance to BenchProtocol is registered anywhere, so after the
+  // warm-up run this measures the negative-entry hit path of the
+  // conformance cache.
+  uint64_t failures = 0;
+  runBenchmark("RuntimeBench.ConformsToProtocolCachedMiss", [&] {
+    for (uint64_t i = 0; i != NumIterations; ++i)
+      if (swift_conformsToProtocol(&TestClassObjectMetadata,
+                                   &BenchProtocol) != nullptr)
+        ++failures;
+  });
+  EXPECT_EQ(0u, failures);
+}
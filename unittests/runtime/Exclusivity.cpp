@@ -85,3 +85,51 @@ TEST(TestExclusivity, testNonNested) {
   end(1); end(4); end(0); end(2); end(3);
   accessAll();
 }
+
+// Exercise the overflow table behind the inline entries of the access set:
+// enough simultaneous accesses to distinct variables to spill out of the
+// inline array several times over, ended in an order that interleaves inline
+// and overflow entries.
+TEST(TestExclusivity, testManySimultaneous) {
+  const int N = 100;
+  ValueBuffer scratches[N];
+  long vars[N];
+
+  auto begin = [&](unsigned i) {
+    assert(i < N);
+    swift_beginAccess(&vars[i], &scratches[i], ExclusivityFlags::Modify, 0);
+  };
+  auto end = [&](unsigned i) {
+    assert(i < N);
+    swift_endAccess(&scratches[i]);
+    memset(&scratches[i], /*gibberish*/ 0x99, sizeof(ValueBuffer));
+  };
+
+  // Grow to the full population and unwind, several times, ending from
+  // either side as well as from the middle outwards.
+  for (unsigned round = 0; round != 3; ++round) {
+    for (unsigned i = 0; i != N; ++i) begin(i);
+    switch (round) {
+    case 0:
+      for (unsigned i = 0; i != N; ++i) end(i);
+      break;
+    case 1:
+      for (unsigned i = N; i != 0; --i) end(i - 1);
+      break;
+    case 2:
+      for (unsigned i = 0; i != N; i += 2) end(i);
+      for (unsigned i = 1; i != N; i += 2) end(i);
+      break;
+    }
+  }
+
+  // Stacked reads on the same variable mixed with modifies of others.
+  ValueBuffer readScratches[8];
+  for (unsigned i = 0; i != 8; ++i)
+    swift_beginAccess(&vars[0], &readScratches[i], ExclusivityFlags::Read, 0);
+  for (unsigned i = 1; i != 32; ++i) begin(i);
+  for (unsigned i = 1; i != 32; ++i) end(i);
+  // Unlink the reads from the middle of their chain first.
+  for (unsigned i : {3, 5, 1, 7, 0, 6, 2, 4})
+    swift_endAccess(&readScratches[i]);
+}
@@ -17,9 +17,12 @@
 #include "swift/Runtime/Metadata.h"
 #include "swift/Runtime/Once.h"
 #include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
 #include <iterator>
 #include <functional>
 #include <sys/mman.h>
+#include <thread>
 #include <vector>
 #include <pthread.h>
 
@@ -327,6 +330,86 @@ TEST(MetadataTest, getGenericMetadata) {
     });
 }
 
+// Support for the getGenericMetadataStorm test: the microsecond timestamp at
+// which the (deliberately slow) instantiation function finished, stored
+// before the metadata is published to the waiting threads.
+static std::atomic<uint64_t> StormInstantiationDone(0);
+
+static uint64_t stormNowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+GenericMetadataTest<StructMetadata, 1> StormMetadataTest = {
+  // Header
+  {
+    // allocation function
+    [](GenericMetadata *pattern, const void *args) -> Metadata * {
+      // Keep the entry uninitialized long enough for the other threads to
+      // arrive and go to sleep waiting for it.
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      auto metadata = swift_allocateGenericValueMetadata(pattern, args);
+      auto metadataWords = reinterpret_cast<const void**>(metadata);
+      auto argsWords = reinterpret_cast<const void* const*>(args);
+      metadataWords[2] = argsWords[0];
+      StormInstantiationDone.store(stormNowMicros(),
+                                   std::memory_order_release);
+      return metadata;
+    },
+    3 * sizeof(void*), // metadata size
+    1, // num arguments
+    0, // address point
+    {} // private data
+  },
+
+  // Fields
+  {
+    MetadataKind::Struct,
+    reinterpret_cast<const NominalTypeDescriptor*>(&Global1)
+  },
+
+  // Arguments
+  {nullptr}
+};
+
+/// Fan out the full RaceTest thread count against a single uninstantiated
+/// generic metadata: one thread runs the instantiation function while all
+/// others sleep on the cache entry. Checks that every waiter observes the
+/// same instance and that nobody misses the wakeup, and measures how long
+/// after the end of instantiation the slowest waiter got going again.
+TEST(MetadataTest, getGenericMetadataStorm) {
+  auto metadataTemplate = (GenericMetadata *)&StormMetadataTest;
+
+  static uint32_t StormArg = 0;
+  void *args[] = { &StormArg };
+
+  std::atomic<uint64_t> maxWakeupLatency(0);
+
+  RaceTest_ExpectEqual<const Metadata *>(
+    [&]() -> const Metadata * {
+      auto inst = static_cast<const StructMetadata*>
+        (swift_getGenericMetadata(metadataTemplate, args));
+
+      // The timestamp is always stored before the metadata can be observed.
+      uint64_t latency = stormNowMicros() -
+          StormInstantiationDone.load(std::memory_order_acquire);
+      uint64_t prev = maxWakeupLatency.load(std::memory_order_relaxed);
+      while (prev < latency &&
+             !maxWakeupLatency.compare_exchange_weak(prev, latency)) {
+      }
+
+      EXPECT_EQ(MetadataKind::Struct, inst->getKind());
+      return inst;
+    });
+
+  // Wakeup latency is scheduling-dependent, so only fail if a waiter took
+  // absurdly long, which indicates a missed wakeup rather than an unlucky
+  // schedule. The measured value itself is the interesting number when the
+  // test is run by hand.
+  EXPECT_LT(maxWakeupLatency.load(), 10u * 1000 * 1000);
+}
+
 FullMetadata<ClassMetadata> MetadataTest2 = {
   { { nullptr }, { &VALUE_WITNESS_SYM(Bo) } },
   { { { MetadataKind::Class } }, nullptr, /*rodata*/ 1,
@@ -13,9 +13,18 @@
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
 #include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace swift;
 
+// A fake definition of Swift runtime's WeakReference.
+// This has the proper size and alignment which is all we need.
+namespace swift {
+class WeakReference { void *value __attribute__((unused)); };
+}
+
 struct TestObject : HeapObject {
   size_t *Addr;
   size_t Value;
@@ -307,3 +316,54 @@ TEST(RefcountingTest, nonatomic_unknown_retain_release_n) {
   EXPECT_EQ(0u, value);
   EXPECT_EQ(1u, swift_retainCount(object));
 }
+
+/////////////////////////////////////////
+// Multithreaded weak reference churn  //
+/////////////////////////////////////////
+
+// One writer thread churns through objects, repointing a shared weak
+// reference at each new one, while reader threads hammer the weak
+// reference with loads. This exercises the side table entry pool from
+// multiple threads (entries are allocated on the writer and can be freed
+// by whichever thread drops the last weak reference) and checks that no
+// object and no side table entry is leaked or double-freed.
+TEST(RefcountingTest, weak_churn_multithreaded) {
+  const unsigned NumReaders = 4;
+  const unsigned NumObjects = 2000;
+
+  WeakReference ref;
+  swift_weakInit(&ref, nullptr);
+
+  std::vector<size_t> values(NumObjects, 0);
+  std::atomic<bool> done(false);
+
+  auto reader = [&]() {
+    while (!done.load(std::memory_order_acquire)) {
+      if (auto strong = swift_weakLoadStrong(&ref))
+        swift_release(strong);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i != NumReaders; ++i)
+    threads.emplace_back(reader);
+
+  for (unsigned i = 0; i != NumObjects; ++i) {
+    auto object = allocTestObject(&values[i], i + 1);
+    swift_weakAssign(&ref, object);
+    swift_release(object);
+  }
+  done.store(true, std::memory_order_release);
+
+  for (auto &thread : threads)
+    thread.join();
+
+  // Everything the readers held has been released, and weak references do
+  // not keep their referent alive, so every object has run its deinit.
+  for (unsigned i = 0; i != NumObjects; ++i)
+    EXPECT_EQ(size_t(i + 1), values[i]);
+
+  // The weak reference must have gone stale along with its referent.
+  EXPECT_EQ(nullptr, swift_weakLoadStrong(&ref));
+  swift_weakDestroy(&ref);
+}
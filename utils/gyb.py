@@ -4,6 +4,7 @@
 
 from __future__ import print_function
 
+import hashlib
 import os
 import re
 try:
@@ -1104,6 +1105,66 @@ def execute_template(
     return ''.join(execution_context.result_text)
 
 
+def template_cache_key(template_name, template_text, line_directive,
+                       bindings, dep_files):
+    """Return a stable digest identifying one expansion of a template.
+
+    The digest covers everything that can influence the output: the gyb
+    implementation itself, the template path (which the line directives
+    embed in the output) and text, the line-directive format, the
+    variable bindings, and the content of any support files the template
+    reads while executing.
+    """
+    digest = hashlib.sha1()
+
+    def feed(tag, data):
+        if not isinstance(data, bytes):
+            data = data.encode('utf-8')
+        digest.update(('%s:%d:' % (tag, len(data))).encode('utf-8'))
+        digest.update(data)
+
+    with open(os.path.realpath(__file__).replace('.pyc', '.py'), 'rb') as f:
+        feed('gyb', f.read())
+    feed('template-name', template_name)
+    feed('template', template_text)
+    feed('line-directive', line_directive)
+    for name in sorted(bindings):
+        feed('binding', '%s=%s' % (name, bindings[name]))
+    for path in sorted(dep_files):
+        with open(path, 'rb') as f:
+            feed(os.path.basename(path), f.read())
+    return digest.hexdigest()
+
+
+def expand_cached(cache_dir, key, expand):
+    """Return the expansion stored under key in cache_dir, calling expand()
+    and populating the cache on a miss.
+
+    Entries are written to a temporary name and renamed into place, so
+    concurrent gyb processes sharing one cache never observe a
+    partially-written entry; losing the rename race is harmless because
+    both processes wrote the same content.
+    """
+    cached = os.path.join(cache_dir, key)
+    try:
+        with open(cached) as f:
+            return f.read()
+    except IOError:
+        pass
+    result = expand()
+    try:
+        if not os.path.isdir(cache_dir):
+            os.makedirs(cache_dir)
+        tmp = '%s.tmp.%d' % (cached, os.getpid())
+        with open(tmp, 'w') as f:
+            f.write(result)
+        os.rename(tmp, cached)
+    except (IOError, OSError):
+        # A cache that cannot be written is just a cache that never hits.
+        pass
+    return result
+
+
 def main():
     """
     Lint this file.
@@ -1205,6 +1266,16 @@ def main():
     parser.add_argument(
         '--line-directive', default='// ###sourceLocation',
         help='Line directive prefix; empty => no line markers')
+    parser.add_argument(
+        '--cache-dir', default=None,
+        help='''Directory for memoizing expansions; a template whose text,
+             bindings and support files are unchanged is copied out of the
+             cache instead of being re-executed''')
+    parser.add_argument(
+        '--cache-dep', action='append', dest='cache_deps', metavar='FILE',
+        default=[],
+        help='''File whose content contributes to the cache key; pass one
+             for each support file the template reads while executing''')
 
     args = parser.parse_args(sys.argv[1:])
 
@@ -1215,7 +1286,18 @@ def main():
             sys.exit(1)
 
     bindings = dict(x.split('=', 1) for x in args.defines)
-    ast = parse_template(args.file.name, args.file.read())
+    template_text = args.file.read()
+
+    # Compute the cache key (and make the cache directory chdir-proof)
+    # before changing into the template's own directory below.
+    cache_key = None
+    if args.cache_dir:
+        cache_key = template_cache_key(
+            args.file.name, template_text, args.line_directive, bindings,
+            args.cache_deps)
+        args.cache_dir = os.path.abspath(args.cache_dir)
+
+    ast = parse_template(args.file.name, template_text)
     if args.dump:
         print(ast)
     # Allow the template to open files and import .py files relative to its own
@@ -1223,7 +1305,14 @@ def main():
     os.chdir(os.path.dirname(os.path.abspath(args.file.name)))
     sys.path = ['.'] + sys.path
 
-    args.target.write(execute_template(ast, args.line_directive, **bindings))
+    def expand_now():
+        return execute_template(ast, args.line_directive, **bindings)
+
+    if cache_key is not None:
+        result = expand_cached(args.cache_dir, cache_key, expand_now)
+    else:
+        result = expand_now()
+    args.target.write(result)
 
 
 if __name__ == '__main__':
@@ -51,7 +51,8 @@ class OptStatsDB(object):
                         "Old INT, "
                         "New INT, "
                         "Duration INT, "
-                        "Symbol TEXT NOT NULL DEFAULT '')")
+                        "Symbol TEXT NOT NULL DEFAULT '', "
+                        "Session TEXT NOT NULL DEFAULT '')")
             cur.execute('CREATE INDEX IF NOT EXISTS StageIndex '
                         'ON Counters(Stage)')
             cur.execute('CREATE INDEX IF NOT EXISTS TransformIndex '
@@ -62,6 +63,8 @@ class OptStatsDB(object):
                         'ON Counters(Counter)')
             cur.execute('CREATE INDEX IF NOT EXISTS SymbolIndex '
                         'ON Counters(Symbol)')
+            cur.execute('CREATE INDEX IF NOT EXISTS SessionIndex '
+                        'ON Counters(Session)')
         except lite.Error as e:
             print('Error {}' .format(e.args[0]))
             sys.exit(1)
@@ -77,12 +80,13 @@ class OptStatsDB(object):
 
     # Store a single statistics record into a DB.
     def addRecord(self, stage, transform, kind,
-                  counter, passnum, delta, old, new, duration, symbol):
+                  counter, passnum, delta, old, new, duration, symbol,
+                  session):
         values = [(stage, transform, kind, counter, passnum,
-                   delta, old, new, duration, symbol,), ]
+                   delta, old, new, duration, symbol, session,), ]
         self.cur.executemany(
             'INSERT INTO Counters VALUES '
-            '(NULL, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)',
+            '(NULL, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)',
             values)
 
 
@@ -98,16 +102,21 @@ def addStatsFromInput(inputFile, db):
             continue
         # Trim all values
         segments = map(str.strip, segments)
+        # The trailing Session column joins these counters with the other
+        # stats written during the same build; files produced by older
+        # compilers do not have it.
         if segments[0] == 'function_history':
             # Process history records
             delta = 0.0
             (kind, counter, stage, transform, passnum,
-             old, duration, symbol) = segments
+             old, duration, symbol) = segments[:8]
             new = old
+            session = segments[8] if len(segments) > 8 else ''
         else:
             # Process stats records
             (kind, counter, stage, transform, passnum, delta,
-             old, new, duration, symbol) = segments
+             old, new, duration, symbol) = segments[:10]
+            session = segments[10] if len(segments) > 10 else ''
 
         db.addRecord(
             stage,
@@ -119,7 +128,8 @@ def addStatsFromInput(inputFile, db):
             old,
             new,
             duration,
-            symbol)
+            symbol,
+            session)
 
 
 def processStatsFile(filename, dbname):
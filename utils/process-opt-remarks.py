@@ -0,0 +1,172 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# ===--- process-opt-remarks.py ------------------------------------------===//
+#
+#  This source file is part of the Swift.org open source project
+#
+#  Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+#  Licensed under Apache License v2.0 with Runtime Library Exception
+#
+#  See https://swift.org/LICENSE.txt for license information
+#  See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ===---------------------------------------------------------------------===//
+#
+# Aggregates the YAML optimization-record files written by
+# -save-optimization-record-path across a whole build, so questions like
+# "which functions failed inlining and why" can be answered without
+# grepping per-remark stderr diagnostics.
+#
+# Examples:
+#
+#   Count remarks by pass and kind over a build directory:
+#     process-opt-remarks.py build/**/*.opt.yaml
+#
+#   Why did inlining fail, grouped by function:
+#     process-opt-remarks.py --only missed --pass-name inline \
+#         --group-by function build/*.opt.yaml
+#
+#   List every individual remark for one function:
+#     process-opt-remarks.py --function 'Foo.bar' --list build/*.opt.yaml
+#
+# ===---------------------------------------------------------------------===//
+
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import sys
+from collections import Counter
+
+import yaml
+
+
+class Remark(object):
+    """One optimization remark parsed from an opt-record file."""
+
+    def __init__(self, kind, mapping):
+        self.kind = kind                          # 'passed' or 'missed'
+        self.pass_name = mapping.get('Pass', '')
+        self.name = mapping.get('Name', '')
+        self.function = mapping.get('Function', '')
+        loc = mapping.get('DebugLoc', {})
+        self.file = loc.get('File', '')
+        self.line = loc.get('Line', 0)
+        self.column = loc.get('Column', 0)
+        # Args is a sequence of single-key mappings; their values
+        # concatenate into the rendered message.
+        self.message = ''.join(
+            str(value)
+            for arg in mapping.get('Args', [])
+            for key, value in arg.items()
+            if key != 'DebugLoc')
+
+    @property
+    def location(self):
+        if not self.file:
+            return '<unknown>'
+        return '%s:%d:%d' % (self.file, self.line, self.column)
+
+
+def remark_constructor(kind):
+    def construct(loader, node):
+        return Remark(kind, loader.construct_mapping(node, deep=True))
+    return construct
+
+
+yaml.SafeLoader.add_constructor('!Passed', remark_constructor('passed'))
+yaml.SafeLoader.add_constructor('!Missed', remark_constructor('missed'))
+
+
+def load_remarks(paths):
+    for path in paths:
+        with open(path) as f:
+            for remark in yaml.safe_load_all(f):
+                if isinstance(remark, Remark):
+                    yield remark
+
+
+def matches(remark, args):
+    if args.only and remark.kind != args.only:
+        return False
+    if args.pass_name and args.pass_name not in remark.pass_name:
+        return False
+    if args.remark_name and args.remark_name != remark.name:
+        return False
+    if args.function and not args.function.search(remark.function):
+        return False
+    return True
+
+
+GROUP_KEYS = {
+    'pass': lambda r: '%s %s (%s)' % (r.pass_name, r.name, r.kind),
+    'function': lambda r: '%s: %s %s (%s)' % (r.function, r.pass_name,
+                                              r.name, r.kind),
+    'file': lambda r: '%s: %s %s (%s)' % (r.file, r.pass_name, r.name,
+                                          r.kind),
+}
+
+
+def print_summary(remarks, group_by):
+    key = GROUP_KEYS[group_by]
+    counts = Counter(key(r) for r in remarks)
+    if not counts:
+        print('No matching remarks.')
+        return
+    width = len(str(counts.most_common(1)[0][1]))
+    for group, count in counts.most_common():
+        print('%*d  %s' % (width, count, group))
+
+
+def print_list(remarks):
+    for r in remarks:
+        print('%s: %s: [%s:%s] %s: %s' % (r.location, r.kind, r.pass_name,
+                                          r.name, r.function, r.message))
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Summarize Swift optimization-record YAML files')
+    parser.add_argument(
+        'remarks', nargs='+', metavar='FILE',
+        help='opt-record files written by -save-optimization-record-path')
+    parser.add_argument(
+        '--only', choices=['passed', 'missed'],
+        help='restrict to remarks of this kind')
+    parser.add_argument(
+        '--pass-name',
+        help='restrict to passes whose name contains this substring')
+    parser.add_argument(
+        '--remark-name',
+        help='restrict to remarks with this identifier '
+             '(e.g. sil.Inlined, sil.memcopy)')
+    parser.add_argument(
+        '--function', type=re.compile, metavar='REGEX',
+        help='restrict to functions matching this regular expression')
+    parser.add_argument(
+        '--group-by', choices=sorted(GROUP_KEYS.keys()), default='pass',
+        help='summary grouping (default: pass)')
+    parser.add_argument(
+        '--list', action='store_true',
+        help='print each matching remark instead of a summary')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    for path in args.remarks:
+        if not os.path.isfile(path):
+            print('No such file: %s' % path, file=sys.stderr)
+            return 1
+    remarks = (r for r in load_remarks(args.remarks) if matches(r, args))
+    if args.list:
+        print_list(remarks)
+    else:
+        print_summary(remarks, args.group_by)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -115,6 +115,49 @@ def write_lnt_values(args):
                 sys.exit(1)
 
 
+# Version of the build-record schema written by write_build_records; bump
+# when the shape of the record changes, so downstream consumers can detect
+# records they do not understand.
+BUILD_RECORD_VERSION = 1
+
+
+def build_session_of(j):
+    """Return the build-session identifier recorded in a job's stats, or 0
+    for jobs predating session support (or frontends invoked directly)."""
+    return (j.stats.get("Driver.BuildSessionId", 0) or
+            j.stats.get("Frontend.BuildSessionId", 0))
+
+
+def write_build_records(args):
+    """Write one versioned, queryable record per build session found in the
+    given stats-dirs, joining each driver job with the frontend jobs that
+    share its BuildSessionId."""
+    vargs = vars_of_args(args)
+    jobs = []
+    for path in args.remainder:
+        jobs += load_stats_dir(path, **vargs)
+    jobs.sort(key=build_session_of)
+    records = []
+    for (session, group) in itertools.groupby(jobs, build_session_of):
+        group = list(group)
+        start = min(j.start_usec for j in group)
+        end = max(j.start_usec + j.dur_usec for j in group)
+        records.append({
+            "version": BUILD_RECORD_VERSION,
+            "session": session,
+            "start_usec": start,
+            "dur_usec": end - start,
+            "jobs": [{"kind": j.jobkind,
+                      "module": j.module,
+                      "start_usec": j.start_usec,
+                      "dur_usec": j.dur_usec,
+                      "args": j.jobargs,
+                      "stats": j.stats}
+                     for j in group]
+        })
+    json.dump(records, args.output, indent=2)
+
+
 def show_paired_incrementality(args):
     fieldnames = ["old_pct", "old_skip",
                   "new_pct", "new_skip",
@@ -589,6 +632,8 @@ def main():
                        help="Compare two stats dirs directly")
     modes.add_argument("--lnt", action="store_true",
                        help="Emit an LNT-compatible test summary")
+    modes.add_argument("--build-records", action="store_true",
+                       help="emit one queryable JSON record per build session")
     modes.add_argument("--evaluate", type=str, default=None,
                        help="evaluate an expression of stat-names")
     modes.add_argument("--evaluate-delta", type=str, default=None,
@@ -615,6 +660,8 @@ def main():
             show_incrementality(args)
     elif args.lnt:
         write_lnt_values(args)
+    elif args.build_records:
+        write_build_records(args)
     elif args.evaluate:
         return evaluate(args)
     elif args.evaluate_delta: